@@ -0,0 +1,400 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/IDataArray.h"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+/**
+ * @brief The CellReindexer class applies one new index to old index map to every cell array
+ * of an AttributeMatrix. The map is analyzed once: each z slab of the destination is split into
+ * runs of consecutive source tuples, which are copied with memcpy. Slabs whose map is too
+ * scattered for runs to pay off are copied with a gather typed on the element width. Slabs are
+ * processed in parallel and the same analysis is reused for every array.
+ *
+ * Map entries that are negative mark destination tuples without a source; those are zero
+ * filled. Arrays that are not plain numeric DataArrays (strings, neighbor lists) fall back to
+ * a serial IDataArray::copyFromArray per tuple. The class is header only so that filters in
+ * any plugin can use it.
+ */
+class CellReindexer
+{
+public:
+  /**
+   * @brief CellReindexer
+   * @param newToOld Source tuple of every destination tuple, negative to zero fill
+   * @param slabSize Number of destination tuples in one z slab, usually xDim * yDim
+   */
+  CellReindexer(std::vector<int64_t> newToOld, size_t slabSize)
+  : m_NewToOld(std::move(newToOld))
+  , m_SlabSize(std::max(slabSize, size_t(1)))
+  {
+    size_t numTuples = m_NewToOld.size();
+    size_t numSlabs = (numTuples + m_SlabSize - 1) / m_SlabSize;
+    m_SlabRunOffsets.assign(numSlabs + 1, 0);
+    m_SlabIsStrided.assign(numSlabs, 0);
+
+    // Runs never cross slab boundaries so that every slab can be copied on its own
+    std::vector<Run> runs;
+    for(size_t s = 0; s < numSlabs; s++)
+    {
+      size_t first = s * m_SlabSize;
+      size_t last = std::min(first + m_SlabSize, numTuples);
+      size_t slabRunStart = runs.size();
+      size_t t = first;
+      while(t < last)
+      {
+        Run run = {static_cast<int64_t>(t), m_NewToOld[t] < 0 ? -1 : m_NewToOld[t], 1};
+        t++;
+        if(run.src < 0)
+        {
+          while(t < last && m_NewToOld[t] < 0)
+          {
+            run.length++;
+            t++;
+          }
+        }
+        else
+        {
+          while(t < last && m_NewToOld[t] == run.src + run.length)
+          {
+            run.length++;
+            t++;
+          }
+        }
+        runs.push_back(run);
+      }
+      // With short runs the plain gather over the map is cheaper than walking the runs
+      if((runs.size() - slabRunStart) * k_MinAverageRunLength > last - first)
+      {
+        runs.resize(slabRunStart);
+        m_SlabIsStrided[s] = 1;
+      }
+      m_SlabRunOffsets[s + 1] = runs.size();
+    }
+    m_Runs.swap(runs);
+  }
+
+  virtual ~CellReindexer() = default;
+
+  /**
+   * @brief getNumberOfTuples Returns the number of destination tuples
+   */
+  size_t getNumberOfTuples() const
+  {
+    return m_NewToOld.size();
+  }
+
+  /**
+   * @brief reindexArray Creates a new array with the name, type and components of source and
+   * fills it through the map
+   * @param source Array to read from; it is not modified
+   * @return The new array, or a nullptr if a non numeric array could not be copied
+   */
+  IDataArray::Pointer reindexArray(const IDataArray::Pointer& source) const
+  {
+    size_t numTuples = m_NewToOld.size();
+    IDataArray::Pointer dest = source->createNewArray(numTuples, source->getComponentDimensions(), source->getName(), true);
+    if(numTuples == 0)
+    {
+      return dest;
+    }
+
+    if(!isNumericArray(source))
+    {
+      for(size_t t = 0; t < numTuples; t++)
+      {
+        if(m_NewToOld[t] >= 0 && !dest->copyFromArray(t, source, static_cast<size_t>(m_NewToOld[t]), 1))
+        {
+          return IDataArray::NullPointer();
+        }
+      }
+      return dest;
+    }
+
+    size_t numComps = static_cast<size_t>(source->getNumberOfComponents());
+    const void* src = source->getVoidPointer(0);
+    void* dst = dest->getVoidPointer(0);
+    switch(source->getTypeSize())
+    {
+    case 1:
+      gather<uint8_t>(src, dst, numComps);
+      break;
+    case 2:
+      gather<uint16_t>(src, dst, numComps);
+      break;
+    case 4:
+      gather<uint32_t>(src, dst, numComps);
+      break;
+    case 8:
+      gather<uint64_t>(src, dst, numComps);
+      break;
+    default:
+      gatherBytes(src, dst, numComps * source->getTypeSize());
+      break;
+    }
+    return dest;
+  }
+
+  /**
+   * @brief reindexAttributeMatrix Builds a new AttributeMatrix with the given tuple dimensions
+   * holding a reindexed copy of every array of source. Unless asked to keep them, each source
+   * array is removed as soon as it has been copied so that at most one extra array is alive at
+   * any time.
+   * @param filter Filter whose cancel flag is checked between arrays and that receives errors
+   * @param source AttributeMatrix to read from
+   * @param tDims Tuple dimensions of the new AttributeMatrix; their product must equal getNumberOfTuples()
+   * @param removeSourceArrays Whether to remove each array from source once it is copied
+   * @return The new AttributeMatrix, or a nullptr if the filter was canceled or a copy failed
+   */
+  AttributeMatrix::Pointer reindexAttributeMatrix(AbstractFilter* filter, const AttributeMatrix::Pointer& source, const QVector<size_t>& tDims, bool removeSourceArrays = true) const
+  {
+    return reindexAttributeMatrix(filter, source, source->getAttributeArrayNames(), tDims, removeSourceArrays);
+  }
+
+  /**
+   * @brief reindexAttributeMatrix Same as above, but only the named arrays of source are copied
+   * into the new AttributeMatrix; the other arrays of source are left untouched.
+   * @param filter Filter whose cancel flag is checked between arrays and that receives errors
+   * @param source AttributeMatrix to read from
+   * @param arrayNames Names of the arrays of source to copy
+   * @param tDims Tuple dimensions of the new AttributeMatrix; their product must equal getNumberOfTuples()
+   * @param removeSourceArrays Whether to remove each array from source once it is copied
+   * @return The new AttributeMatrix, or a nullptr if the filter was canceled, a named array does not
+   * exist in source or a copy failed
+   */
+  AttributeMatrix::Pointer reindexAttributeMatrix(AbstractFilter* filter, const AttributeMatrix::Pointer& source, const QList<QString>& arrayNames, const QVector<size_t>& tDims,
+                                                  bool removeSourceArrays) const
+  {
+    AttributeMatrix::Pointer dest = AttributeMatrix::New(tDims, source->getName(), source->getType());
+    for(const auto& arrayName : arrayNames)
+    {
+      if(filter->getCancel())
+      {
+        return AttributeMatrix::NullPointer();
+      }
+      IDataArray::Pointer sourceArray = source->getAttributeArray(arrayName);
+      if(nullptr == sourceArray.get())
+      {
+        QString ss = QObject::tr("The array '%1' does not exist in the Attribute Matrix '%2'").arg(arrayName).arg(source->getName());
+        filter->setErrorCondition(-11003, ss);
+        return AttributeMatrix::NullPointer();
+      }
+      IDataArray::Pointer data = reindexArray(sourceArray);
+      if(nullptr == data.get())
+      {
+        QString ss = QObject::tr("The array '%1' could not be copied to its new tuple positions").arg(arrayName);
+        filter->setErrorCondition(-11004, ss);
+        return AttributeMatrix::NullPointer();
+      }
+      if(removeSourceArrays)
+      {
+        source->removeAttributeArray(arrayName);
+      }
+      dest->insertOrAssign(data);
+    }
+    return dest;
+  }
+
+protected:
+  /**
+   * @brief isNumericArray Returns true if the array stores plain numeric values that can be
+   * copied as raw bytes
+   */
+  static bool isNumericArray(const IDataArray::Pointer& p)
+  {
+    return nullptr != std::dynamic_pointer_cast<DataArray<int8_t>>(p) || nullptr != std::dynamic_pointer_cast<DataArray<uint8_t>>(p) ||
+           nullptr != std::dynamic_pointer_cast<DataArray<int16_t>>(p) || nullptr != std::dynamic_pointer_cast<DataArray<uint16_t>>(p) ||
+           nullptr != std::dynamic_pointer_cast<DataArray<int32_t>>(p) || nullptr != std::dynamic_pointer_cast<DataArray<uint32_t>>(p) ||
+           nullptr != std::dynamic_pointer_cast<DataArray<int64_t>>(p) || nullptr != std::dynamic_pointer_cast<DataArray<uint64_t>>(p) ||
+           nullptr != std::dynamic_pointer_cast<DataArray<float>>(p) || nullptr != std::dynamic_pointer_cast<DataArray<double>>(p) ||
+           nullptr != std::dynamic_pointer_cast<DataArray<bool>>(p) || nullptr != std::dynamic_pointer_cast<DataArray<size_t>>(p);
+  }
+
+  /**
+   * @brief gather Copies every slab of an array whose elements are sizeof(T) bytes wide
+   */
+  template <typename T> void gather(const void* src, void* dst, size_t numComps) const
+  {
+    SlabImpl<T> body(this, static_cast<const T*>(src), static_cast<T*>(dst), numComps);
+    run(body);
+  }
+
+  /**
+   * @brief gatherBytes Copies every slab of an array with an unusual element width, one tuple of
+   * tupleBytes bytes at a time
+   */
+  void gatherBytes(const void* src, void* dst, size_t tupleBytes) const
+  {
+    SlabImpl<uint8_t> body(this, static_cast<const uint8_t*>(src), static_cast<uint8_t*>(dst), tupleBytes);
+    run(body);
+  }
+
+private:
+  static const size_t k_MinAverageRunLength = 8;
+
+  struct Run
+  {
+    int64_t dst;
+    int64_t src; //!< Negative for a zero filled run
+    int64_t length;
+  };
+
+  /**
+   * @brief The SlabImpl class copies a range of destination slabs of one array
+   */
+  template <typename T> class SlabImpl
+  {
+  public:
+    SlabImpl(const CellReindexer* reindexer, const T* src, T* dst, size_t numComps)
+    : m_Reindexer(reindexer)
+    , m_Src(src)
+    , m_Dst(dst)
+    , m_NumComps(numComps)
+    {
+    }
+    virtual ~SlabImpl() = default;
+
+    void convert(size_t start, size_t end) const
+    {
+      const std::vector<int64_t>& newToOld = m_Reindexer->m_NewToOld;
+      const size_t numComps = m_NumComps;
+      for(size_t s = start; s < end; s++)
+      {
+        if(m_Reindexer->m_SlabIsStrided[s] != 0)
+        {
+          size_t first = s * m_Reindexer->m_SlabSize;
+          size_t last = std::min(first + m_Reindexer->m_SlabSize, newToOld.size());
+          if(numComps == 1)
+          {
+            for(size_t t = first; t < last; t++)
+            {
+              m_Dst[t] = newToOld[t] < 0 ? T(0) : m_Src[newToOld[t]];
+            }
+            continue;
+          }
+          for(size_t t = first; t < last; t++)
+          {
+            T* dst = m_Dst + t * numComps;
+            if(newToOld[t] < 0)
+            {
+              std::fill(dst, dst + numComps, T(0));
+              continue;
+            }
+            const T* src = m_Src + static_cast<size_t>(newToOld[t]) * numComps;
+            for(size_t c = 0; c < numComps; c++)
+            {
+              dst[c] = src[c];
+            }
+          }
+          continue;
+        }
+
+        for(size_t r = m_Reindexer->m_SlabRunOffsets[s]; r < m_Reindexer->m_SlabRunOffsets[s + 1]; r++)
+        {
+          const Run& run = m_Reindexer->m_Runs[r];
+          T* dst = m_Dst + static_cast<size_t>(run.dst) * numComps;
+          size_t count = static_cast<size_t>(run.length) * numComps;
+          if(run.src < 0)
+          {
+            std::fill(dst, dst + count, T(0));
+          }
+          else
+          {
+            ::memcpy(dst, m_Src + static_cast<size_t>(run.src) * numComps, count * sizeof(T));
+          }
+        }
+      }
+    }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    const CellReindexer* m_Reindexer;
+    const T* m_Src;
+    T* m_Dst;
+    size_t m_NumComps;
+  };
+
+  template <typename Body> void run(const Body& body) const
+  {
+    size_t numSlabs = m_SlabIsStrided.size();
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    tbb::task_scheduler_init init;
+    bool doParallel = true;
+    if(doParallel && numSlabs > 1)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlabs), body, tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      body.convert(0, numSlabs);
+    }
+  }
+
+  std::vector<int64_t> m_NewToOld;
+  size_t m_SlabSize;
+  std::vector<Run> m_Runs;
+  std::vector<size_t> m_SlabRunOffsets;
+  std::vector<uint8_t> m_SlabIsStrided;
+
+public:
+  CellReindexer(const CellReindexer&) = delete;            // Copy Constructor Not Implemented
+  CellReindexer(CellReindexer&&) = delete;                 // Move Constructor Not Implemented
+  CellReindexer& operator=(const CellReindexer&) = delete; // Copy Assignment Not Implemented
+  CellReindexer& operator=(CellReindexer&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,454 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+/**
+ * @brief The FeatureMoments class accumulates, in a single pass over an image, the number of
+ * cells, the centroid, the centered second moments and the cell bounding box of every Feature.
+ * Means and second moments use centered (Welford) updates, so no second pass over the volume is
+ * needed and large coordinates do not cancel out the result.
+ *
+ * The volume is split into slabs of rows that are accumulated in parallel, each into its own
+ * accumulators, and the slabs are then merged in order with the pairwise formula of Chan et al.
+ * While one accumulator per Feature and slab fits in a fixed budget every slab gets dense arrays
+ * indexed by Feature Id; beyond that every slab only keeps accumulators for the Features it
+ * contains, which adds up to about one accumulator per Feature plus the Features cut by slab
+ * boundaries. Either way every cell is read once. The slab split does not depend on the number of
+ * threads, and both kinds of slab merge the same partial sums in the same order, so the results
+ * are reproducible.
+ *
+ * Cell coordinates are taken as origin + index * spacing, where the origin is the coordinate
+ * of cell (0, 0, 0).
+ */
+class FeatureMoments
+{
+public:
+  /**
+   * @brief The Order enum selects how much is accumulated per cell
+   */
+  enum class Order : int32_t
+  {
+    Counts = 0,       //!< Cell counts only
+    FirstMoments = 1, //!< Cell counts, centroids and bounding boxes
+    SecondMoments = 2 //!< Everything, including the centered second moments
+  };
+
+  /**
+   * @brief The Accumulator struct holds the running statistics of one Feature. The second
+   * moments are the xx, yy, zz, xy, yz, xz sums of products of deviations from the mean.
+   */
+  struct Accumulator
+  {
+    uint64_t count = 0;
+    double mean[3] = {0.0, 0.0, 0.0};
+    double m2[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    size_t min[3] = {std::numeric_limits<size_t>::max(), std::numeric_limits<size_t>::max(), std::numeric_limits<size_t>::max()};
+    size_t max[3] = {0, 0, 0};
+
+    void add(size_t i, size_t j, size_t k, const double coords[3])
+    {
+      count++;
+      double invCount = 1.0 / static_cast<double>(count);
+      double delta[3] = {coords[0] - mean[0], coords[1] - mean[1], coords[2] - mean[2]};
+      mean[0] += delta[0] * invCount;
+      mean[1] += delta[1] * invCount;
+      mean[2] += delta[2] * invCount;
+      double delta2[3] = {coords[0] - mean[0], coords[1] - mean[1], coords[2] - mean[2]};
+      m2[0] += delta[0] * delta2[0];
+      m2[1] += delta[1] * delta2[1];
+      m2[2] += delta[2] * delta2[2];
+      m2[3] += delta[0] * delta2[1];
+      m2[4] += delta[1] * delta2[2];
+      m2[5] += delta[0] * delta2[2];
+      updateBounds(i, j, k);
+    }
+
+    void addFirst(size_t i, size_t j, size_t k, const double coords[3])
+    {
+      count++;
+      double invCount = 1.0 / static_cast<double>(count);
+      mean[0] += (coords[0] - mean[0]) * invCount;
+      mean[1] += (coords[1] - mean[1]) * invCount;
+      mean[2] += (coords[2] - mean[2]) * invCount;
+      updateBounds(i, j, k);
+    }
+
+    void updateBounds(size_t i, size_t j, size_t k)
+    {
+      min[0] = std::min(min[0], i);
+      min[1] = std::min(min[1], j);
+      min[2] = std::min(min[2], k);
+      max[0] = std::max(max[0], i);
+      max[1] = std::max(max[1], j);
+      max[2] = std::max(max[2], k);
+    }
+
+    void merge(const Accumulator& other)
+    {
+      if(other.count == 0)
+      {
+        return;
+      }
+      if(count == 0)
+      {
+        *this = other;
+        return;
+      }
+      double nA = static_cast<double>(count);
+      double nB = static_cast<double>(other.count);
+      double n = nA + nB;
+      double delta[3] = {other.mean[0] - mean[0], other.mean[1] - mean[1], other.mean[2] - mean[2]};
+      double w = nA * nB / n;
+      m2[0] += other.m2[0] + delta[0] * delta[0] * w;
+      m2[1] += other.m2[1] + delta[1] * delta[1] * w;
+      m2[2] += other.m2[2] + delta[2] * delta[2] * w;
+      m2[3] += other.m2[3] + delta[0] * delta[1] * w;
+      m2[4] += other.m2[4] + delta[1] * delta[2] * w;
+      m2[5] += other.m2[5] + delta[0] * delta[2] * w;
+      mean[0] += delta[0] * nB / n;
+      mean[1] += delta[1] * nB / n;
+      mean[2] += delta[2] * nB / n;
+      count += other.count;
+      for(size_t d = 0; d < 3; d++)
+      {
+        min[d] = std::min(min[d], other.min[d]);
+        max[d] = std::max(max[d], other.max[d]);
+      }
+    }
+  };
+
+  FeatureMoments() = default;
+  virtual ~FeatureMoments() = default;
+
+  /**
+   * @brief compute Accumulates the statistics of every Feature
+   * @param featureIds Feature Id of every cell, x fastest
+   * @param numFeatures Number of Features; every Feature Id must be less than this value
+   * @param dims Number of cells along x, y and z
+   * @param origin Coordinate of cell (0, 0, 0)
+   * @param spacing Cell spacing along x, y and z
+   * @param order How much to accumulate per cell
+   */
+  void compute(const int32_t* featureIds, size_t numFeatures, const size_t dims[3], const double origin[3], const double spacing[3], Order order)
+  {
+    size_t numRows = dims[1] * dims[2];
+    size_t numCells = numRows * dims[0];
+
+    m_Counts.assign(numFeatures, 0);
+    m_Features.clear();
+    if(order != Order::Counts)
+    {
+      m_Features.assign(numFeatures, Accumulator());
+    }
+
+    size_t numSlabs = std::max(size_t(1), std::min(std::min(numRows, numCells / k_MinCellsPerSlab), k_MaxSlabs));
+    bool dense = (numSlabs == 1 || numFeatures <= k_MaxSlabAccumulators / numSlabs);
+    std::vector<Block> blocks(numSlabs);
+    std::vector<std::vector<Accumulator>> slabs;
+    std::vector<std::vector<uint64_t>> slabCounts;
+    if(numSlabs > 1 && dense)
+    {
+      slabs.resize(order == Order::Counts ? 0 : numSlabs);
+      slabCounts.resize(order == Order::Counts ? numSlabs : 0);
+    }
+    std::vector<SparseSlab> sparseSlabs(dense ? 0 : numSlabs);
+    for(size_t s = 0; s < numSlabs; s++)
+    {
+      Block& block = blocks[s];
+      block.firstRow = numRows * s / numSlabs;
+      block.lastRow = numRows * (s + 1) / numSlabs;
+      if(numSlabs == 1)
+      {
+        // A single slab accumulates straight into the results
+        block.counts = m_Counts.data();
+        block.features = m_Features.data();
+      }
+      else if(!dense)
+      {
+        block.sparse = &(sparseSlabs[s]);
+      }
+      else if(order == Order::Counts)
+      {
+        slabCounts[s].assign(numFeatures, 0);
+        block.counts = slabCounts[s].data();
+      }
+      else
+      {
+        slabs[s].assign(numFeatures, Accumulator());
+        block.features = slabs[s].data();
+      }
+    }
+
+    BlockImpl body(featureIds, numFeatures, dims, origin, spacing, order, blocks);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    tbb::task_scheduler_init init;
+    bool doParallel = true;
+    if(doParallel && blocks.size() > 1)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, blocks.size(), 1), body, tbb::simple_partitioner());
+    }
+    else
+#endif
+    {
+      body.convert(0, blocks.size());
+    }
+
+    for(size_t s = 0; s < slabCounts.size(); s++)
+    {
+      for(size_t f = 0; f < numFeatures; f++)
+      {
+        m_Counts[f] += slabCounts[s][f];
+      }
+    }
+    for(size_t s = 0; s < slabs.size(); s++)
+    {
+      for(size_t f = 0; f < numFeatures; f++)
+      {
+        m_Features[f].merge(slabs[s][f]);
+      }
+    }
+    for(SparseSlab& slab : sparseSlabs)
+    {
+      for(size_t e = 0; e < slab.featureIds.size(); e++)
+      {
+        if(order == Order::Counts)
+        {
+          m_Counts[slab.featureIds[e]] += slab.counts[e];
+        }
+        else
+        {
+          m_Features[slab.featureIds[e]].merge(slab.features[e]);
+        }
+      }
+      slab = SparseSlab();
+    }
+    if(order != Order::Counts)
+    {
+      for(size_t f = 0; f < numFeatures; f++)
+      {
+        m_Counts[f] = m_Features[f].count;
+      }
+    }
+  }
+
+  /**
+   * @brief getNumberOfFeatures Returns the number of Features accumulated
+   */
+  size_t getNumberOfFeatures() const
+  {
+    return m_Counts.size();
+  }
+
+  /**
+   * @brief getCount Returns the number of cells of a Feature
+   */
+  uint64_t getCount(size_t featureId) const
+  {
+    return m_Counts[featureId];
+  }
+
+  /**
+   * @brief getFeature Returns the full statistics of a Feature; only valid if compute() was
+   * asked for more than Order::Counts
+   */
+  const Accumulator& getFeature(size_t featureId) const
+  {
+    return m_Features[featureId];
+  }
+
+private:
+  // Smallest number of cells worth giving a slab of its own
+  static const size_t k_MinCellsPerSlab = 16384;
+  // Largest number of slabs the volume is split into
+  static const size_t k_MaxSlabs = 64;
+  // Largest number of accumulators, summed over all slabs, for which the slabs get dense arrays
+  static const size_t k_MaxSlabAccumulators = 1 << 18;
+
+  /**
+   * @brief The SparseSlab struct holds the accumulators of the Features found in one slab, in the
+   * order they were first found
+   */
+  struct SparseSlab
+  {
+    std::vector<size_t> featureIds;
+    std::vector<uint64_t> counts;
+    std::vector<Accumulator> features;
+  };
+
+  /**
+   * @brief The Block struct is one unit of parallel work: the cells of rows [firstRow, lastRow),
+   * accumulated either into arrays indexed by Feature Id or into a sparse slab
+   */
+  struct Block
+  {
+    size_t firstRow = 0;
+    size_t lastRow = 0;
+    uint64_t* counts = nullptr;
+    Accumulator* features = nullptr;
+    SparseSlab* sparse = nullptr;
+  };
+
+  /**
+   * @brief The BlockImpl class accumulates a set of blocks
+   */
+  class BlockImpl
+  {
+  public:
+    BlockImpl(const int32_t* featureIds, size_t numFeatures, const size_t dims[3], const double origin[3], const double spacing[3], Order order, const std::vector<Block>& blocks)
+    : m_FeatureIds(featureIds)
+    , m_NumFeatures(numFeatures)
+    , m_Dims(dims)
+    , m_Origin(origin)
+    , m_Spacing(spacing)
+    , m_Order(order)
+    , m_Blocks(blocks)
+    {
+    }
+    virtual ~BlockImpl() = default;
+
+    void convert(size_t start, size_t end) const
+    {
+      for(size_t b = start; b < end; b++)
+      {
+        const Block& block = m_Blocks[b];
+        // Cells of a sparse slab are resolved to their local accumulator through a map, which is
+        // only consulted when the Feature Id changes along a row
+        std::unordered_map<size_t, size_t> localIndex;
+        size_t lastFeatureId = std::numeric_limits<size_t>::max();
+        size_t local = 0;
+        double coords[3] = {0.0, 0.0, 0.0};
+        for(size_t row = block.firstRow; row < block.lastRow; row++)
+        {
+          size_t j = row % m_Dims[1];
+          size_t k = row / m_Dims[1];
+          coords[1] = m_Origin[1] + static_cast<double>(j) * m_Spacing[1];
+          coords[2] = m_Origin[2] + static_cast<double>(k) * m_Spacing[2];
+          const int32_t* ids = m_FeatureIds + row * m_Dims[0];
+          for(size_t i = 0; i < m_Dims[0]; i++)
+          {
+            size_t featureId = static_cast<size_t>(ids[i]);
+            if(featureId >= m_NumFeatures)
+            {
+              continue;
+            }
+            uint64_t* counts = block.counts;
+            Accumulator* features = block.features;
+            size_t index = featureId;
+            if(nullptr != block.sparse)
+            {
+              if(featureId != lastFeatureId)
+              {
+                std::pair<std::unordered_map<size_t, size_t>::iterator, bool> inserted = localIndex.insert(std::make_pair(featureId, block.sparse->featureIds.size()));
+                if(inserted.second)
+                {
+                  block.sparse->featureIds.push_back(featureId);
+                  if(m_Order == Order::Counts)
+                  {
+                    block.sparse->counts.push_back(0);
+                  }
+                  else
+                  {
+                    block.sparse->features.push_back(Accumulator());
+                  }
+                }
+                lastFeatureId = featureId;
+                local = inserted.first->second;
+              }
+              counts = block.sparse->counts.data();
+              features = block.sparse->features.data();
+              index = local;
+            }
+
+            if(m_Order == Order::Counts)
+            {
+              counts[index]++;
+              continue;
+            }
+            coords[0] = m_Origin[0] + static_cast<double>(i) * m_Spacing[0];
+            if(m_Order == Order::SecondMoments)
+            {
+              features[index].add(i, j, k, coords);
+            }
+            else
+            {
+              features[index].addFirst(i, j, k, coords);
+            }
+          }
+        }
+      }
+    }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    const int32_t* m_FeatureIds;
+    size_t m_NumFeatures;
+    const size_t* m_Dims;
+    const double* m_Origin;
+    const double* m_Spacing;
+    Order m_Order;
+    const std::vector<Block>& m_Blocks;
+  };
+
+  std::vector<uint64_t> m_Counts;
+  std::vector<Accumulator> m_Features;
+
+public:
+  FeatureMoments(const FeatureMoments&) = delete;            // Copy Constructor Not Implemented
+  FeatureMoments(FeatureMoments&&) = delete;                 // Move Constructor Not Implemented
+  FeatureMoments& operator=(const FeatureMoments&) = delete; // Copy Assignment Not Implemented
+  FeatureMoments& operator=(FeatureMoments&&) = delete;      // Move Assignment Not Implemented
+};
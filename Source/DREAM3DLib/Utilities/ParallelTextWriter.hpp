@@ -0,0 +1,327 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#pragma once
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+/**
+ * @brief The TextBuffer class appends formatted values to a growing character buffer. Integers
+ * and fixed point values are formatted by hand, without going through the C locale, and produce
+ * exactly the same characters as the printf conversions named on each method.
+ */
+class TextBuffer
+{
+public:
+  TextBuffer() = default;
+  virtual ~TextBuffer() = default;
+
+  TextBuffer& append(const char* text)
+  {
+    m_Data.append(text);
+    return *this;
+  }
+
+  TextBuffer& append(char c)
+  {
+    m_Data.push_back(c);
+    return *this;
+  }
+
+  /**
+   * @brief appendUInt Same output as printf("%llu")
+   */
+  TextBuffer& appendUInt(uint64_t value)
+  {
+    char digits[20];
+    size_t count = 0;
+    do
+    {
+      digits[count++] = static_cast<char>('0' + value % 10);
+      value /= 10;
+    } while(value != 0);
+    while(count > 0)
+    {
+      m_Data.push_back(digits[--count]);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief appendInt Same output as printf("%lld")
+   */
+  TextBuffer& appendInt(int64_t value)
+  {
+    if(value < 0)
+    {
+      m_Data.push_back('-');
+      return appendUInt(0 - static_cast<uint64_t>(value));
+    }
+    return appendUInt(static_cast<uint64_t>(value));
+  }
+
+  /**
+   * @brief appendFixed Same output as printf("%f") of the float promoted to double. The float is
+   * split into its integer mantissa and binary exponent and scaled by 10^6 with exact integer
+   * arithmetic, rounding half to even like printf does. Values that are too large for that, and
+   * infinities and NaNs, go through snprintf.
+   */
+  TextBuffer& appendFixed(float value)
+  {
+    uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    bool negative = (bits >> 31) != 0;
+    uint32_t exponentBits = (bits >> 23) & 0xFF;
+    uint64_t mantissa = bits & 0x7FFFFF;
+    int32_t exponent = -149;
+    if(exponentBits == 0xFF)
+    {
+      return appendPrintf(value);
+    }
+    if(exponentBits != 0)
+    {
+      mantissa |= 0x800000;
+      exponent = static_cast<int32_t>(exponentBits) - 150;
+    }
+
+    // value = mantissa * 2^exponent, scaled = round(value * 10^6)
+    uint64_t scaled = 0;
+    if(exponent >= 0)
+    {
+      if(exponent > 15)
+      {
+        return appendPrintf(value);
+      }
+      scaled = (mantissa << exponent) * 1000000ULL;
+    }
+    else
+    {
+      // mantissa * 10^6 < 2^44, so anything shifted by 46 or more bits is below one half
+      uint64_t numerator = mantissa * 1000000ULL;
+      uint32_t shift = static_cast<uint32_t>(-exponent);
+      if(shift < 46)
+      {
+        scaled = numerator >> shift;
+        uint64_t remainder = numerator & ((uint64_t(1) << shift) - 1);
+        uint64_t half = uint64_t(1) << (shift - 1);
+        if(remainder > half || (remainder == half && (scaled & 1) != 0))
+        {
+          scaled++;
+        }
+      }
+    }
+
+    if(negative)
+    {
+      m_Data.push_back('-');
+    }
+    appendUInt(scaled / 1000000);
+    m_Data.push_back('.');
+    uint64_t fraction = scaled % 1000000;
+    char digits[6];
+    for(size_t i = 6; i > 0; i--)
+    {
+      digits[i - 1] = static_cast<char>('0' + fraction % 10);
+      fraction /= 10;
+    }
+    m_Data.append(digits, 6);
+    return *this;
+  }
+
+  void clear()
+  {
+    m_Data.clear();
+  }
+
+  const char* data() const
+  {
+    return m_Data.data();
+  }
+
+  size_t size() const
+  {
+    return m_Data.size();
+  }
+
+private:
+  std::string m_Data;
+
+  TextBuffer& appendPrintf(float value)
+  {
+    char text[64];
+    int count = snprintf(text, sizeof(text), "%f", static_cast<double>(value));
+    if(count > 0)
+    {
+      m_Data.append(text, static_cast<size_t>(count) < sizeof(text) ? static_cast<size_t>(count) : sizeof(text) - 1);
+    }
+    return *this;
+  }
+};
+
+/**
+ * @brief The ParallelTextWriter class writes the lines of large ASCII files. Rows are grouped
+ * into chunks that are formatted in parallel, each into its own TextBuffer, and the chunks are
+ * then handed to a sink strictly in row order. Only one batch of chunks is held in memory at a
+ * time, so the memory used does not depend on the size of the file.
+ *
+ * The row formatter is called as formatRow(row, buffer) and must only read shared data. The
+ * sink is called as sink(buffer, rowsDone) on the calling thread; it writes the buffer and may
+ * report progress, and returning false stops the writing (on an I/O error or a cancel).
+ */
+class ParallelTextWriter
+{
+public:
+  static const size_t k_DefaultRowsPerChunk = 4096;
+
+  /**
+   * @brief WriteRows Formats and writes rows [0, numRows)
+   * @param numRows Number of rows
+   * @param formatRow Appends the text of one row to a TextBuffer
+   * @param sink Writes one formatted chunk
+   * @param rowsPerChunk Number of rows formatted into each chunk
+   * @return false if the sink stopped the writing
+   */
+  template <typename RowFormatter, typename Sink> static bool WriteRows(size_t numRows, const RowFormatter& formatRow, Sink sink, size_t rowsPerChunk = k_DefaultRowsPerChunk)
+  {
+    rowsPerChunk = std::max(rowsPerChunk, size_t(1));
+    size_t chunksPerBatch = 1;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    tbb::task_scheduler_init init;
+    bool doParallel = true;
+    chunksPerBatch = 4 * static_cast<size_t>(tbb::task_scheduler_init::default_num_threads());
+#endif
+    std::vector<TextBuffer> buffers(chunksPerBatch);
+    size_t rowsPerBatch = rowsPerChunk * chunksPerBatch;
+    for(size_t batchStart = 0; batchStart < numRows; batchStart += rowsPerBatch)
+    {
+      size_t batchEnd = std::min(numRows, batchStart + rowsPerBatch);
+      size_t numChunks = (batchEnd - batchStart + rowsPerChunk - 1) / rowsPerChunk;
+      FormatChunksImpl<RowFormatter> body(formatRow, batchStart, batchEnd, rowsPerChunk, buffers);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+      if(doParallel && numChunks > 1)
+      {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, numChunks, 1), body, tbb::simple_partitioner());
+      }
+      else
+#endif
+      {
+        body.convert(0, numChunks);
+      }
+
+      for(size_t c = 0; c < numChunks; c++)
+      {
+        size_t rowsDone = std::min(batchEnd, batchStart + (c + 1) * rowsPerChunk);
+        if(!sink(buffers[c], rowsDone))
+        {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief WriteToFile Writes one formatted chunk to a "C" FILE*
+   * @return true if every byte was written
+   */
+  static bool WriteToFile(FILE* f, const TextBuffer& buffer)
+  {
+    return fwrite(buffer.data(), 1, buffer.size(), f) == buffer.size();
+  }
+
+protected:
+  ParallelTextWriter() = default;
+
+private:
+  /**
+   * @brief The FormatChunksImpl class formats a range of chunks of one batch
+   */
+  template <typename RowFormatter> class FormatChunksImpl
+  {
+  public:
+    FormatChunksImpl(const RowFormatter& formatRow, size_t firstRow, size_t endRow, size_t rowsPerChunk, std::vector<TextBuffer>& buffers)
+    : m_FormatRow(formatRow)
+    , m_FirstRow(firstRow)
+    , m_EndRow(endRow)
+    , m_RowsPerChunk(rowsPerChunk)
+    , m_Buffers(buffers)
+    {
+    }
+    virtual ~FormatChunksImpl() = default;
+
+    void convert(size_t start, size_t end) const
+    {
+      for(size_t c = start; c < end; c++)
+      {
+        TextBuffer& buffer = m_Buffers[c];
+        buffer.clear();
+        size_t first = m_FirstRow + c * m_RowsPerChunk;
+        size_t last = std::min(m_EndRow, first + m_RowsPerChunk);
+        for(size_t row = first; row < last; row++)
+        {
+          m_FormatRow(row, buffer);
+        }
+      }
+    }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    const RowFormatter& m_FormatRow;
+    size_t m_FirstRow;
+    size_t m_EndRow;
+    size_t m_RowsPerChunk;
+    std::vector<TextBuffer>& m_Buffers;
+  };
+};
@@ -39,9 +39,13 @@
 
 #include "hdf5.h"
 
+#include <algorithm>
+#include <memory>
+
 #include <QtCore/QtDebug>
 
 #include "EbsdLib/EbsdLib.h"
+#include "EbsdLib/EbsdReader.h"
 #include "EbsdLib/EbsdSetGetMacros.h"
 
 /**
@@ -75,6 +79,16 @@ class EbsdLib_EXPORT EbsdImporter
      */
     EBSD_VIRTUAL_INSTANCE_PROPERTY(bool, Cancel)
 
+    /**
+     * @brief Deflate level (1 to 9) used for the slice data arrays. 0 writes them without compression
+     */
+    EBSD_VIRTUAL_INSTANCE_PROPERTY(int, CompressionLevel)
+
+    /**
+     * @brief Apply the HDF5 shuffle filter to the slice data arrays
+     */
+    EBSD_VIRTUAL_INSTANCE_PROPERTY(bool, UseShuffle)
+
     /**
      * @brief Either prints a message or sends the message to the User Interface
      * @param message The message to print
@@ -105,6 +119,25 @@ class EbsdLib_EXPORT EbsdImporter
      */
     virtual int importFile(hid_t fileId, int64_t index, const QString& ebsd) = 0;
 
+    /**
+     * @brief Parses an EBSD file without touching any HDF5 file. Every call uses its own reader,
+     * so several files can be parsed concurrently and then handed to writeFile() in slice order.
+     * @param ebsdFile The raw data file from the manufacturer (.ang, .ctf)
+     * @param reader The reader holding the parsed data (out)
+     * @param message Description of the error, if any (out)
+     * @return Negative value on error
+     */
+    virtual int parseFile(const QString& ebsdFile, std::shared_ptr<EbsdReader>& reader, QString& message) const = 0;
+
+    /**
+     * @brief Writes an EBSD file that was parsed by parseFile() into the HDF5 file
+     * @param fileId HDF5 fileId of an open HDF5 file that the data will be stored into
+     * @param index The integer index value of this EBSD data file
+     * @param reader The reader returned by parseFile()
+     * @return Negative value on error
+     */
+    virtual int writeFile(hid_t fileId, int64_t index, EbsdReader& reader) = 0;
+
     /**
      * @brief Returns the dimensions for the EBSD Data set
      * @param x Number of X Voxels (out)
@@ -136,10 +169,84 @@ class EbsdLib_EXPORT EbsdImporter
     EbsdImporter()
     : m_ErrorCode(0)
     , m_Cancel(false)
+    , m_CompressionLevel(0)
+    , m_UseShuffle(false)
     {
       m_PipelineMessage = "";
     }
 
+    /**
+     * @brief Writes a 1D slice data array. The dataset is contiguous unless compression or
+     * shuffling is enabled, in which case it is chunked and filtered.
+     * @param gid HDF5 group that will hold the dataset
+     * @param name Name of the dataset
+     * @param dataType HDF5 type of the values
+     * @param numElements Number of values
+     * @param data The values
+     * @return Negative value on error
+     */
+    herr_t writeDataArray(hid_t gid, const QString& name, hid_t dataType, hsize_t numElements, const void* data)
+    {
+      hsize_t dims[1] = {numElements};
+      hid_t dataspaceId = H5Screate_simple(1, dims, nullptr);
+      if(dataspaceId < 0)
+      {
+        return -1;
+      }
+      hid_t propertyId = H5Pcreate(H5P_DATASET_CREATE);
+      herr_t err = propertyId < 0 ? -1 : 0;
+      if(err >= 0 && numElements > 0 && (m_CompressionLevel > 0 || m_UseShuffle))
+      {
+        // Chunks of at most 1 MB for 4 byte values keep the deflate working set small
+        hsize_t maxChunkElements = 262144;
+        hsize_t chunkDims[1] = {std::min(numElements, maxChunkElements)};
+        err = H5Pset_chunk(propertyId, 1, chunkDims);
+        if(err >= 0 && m_UseShuffle)
+        {
+          err = H5Pset_shuffle(propertyId);
+        }
+        if(err >= 0 && m_CompressionLevel > 0)
+        {
+          err = H5Pset_deflate(propertyId, static_cast<unsigned>(std::min(m_CompressionLevel, 9)));
+        }
+      }
+      if(err >= 0)
+      {
+        hid_t datasetId = H5Dcreate2(gid, name.toLatin1().data(), dataType, dataspaceId, H5P_DEFAULT, propertyId, H5P_DEFAULT);
+        if(datasetId < 0)
+        {
+          err = -1;
+        }
+        else
+        {
+          err = H5Dwrite(datasetId, dataType, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
+          H5Dclose(datasetId);
+        }
+      }
+      if(propertyId >= 0)
+      {
+        H5Pclose(propertyId);
+      }
+      H5Sclose(dataspaceId);
+      return err;
+    }
+
+    /**
+     * @brief Writes a 1D slice data array of floats
+     */
+    herr_t writeDataArray(hid_t gid, const QString& name, hsize_t numElements, const float* data)
+    {
+      return writeDataArray(gid, name, H5T_NATIVE_FLOAT, numElements, data);
+    }
+
+    /**
+     * @brief Writes a 1D slice data array of 32 bit integers
+     */
+    herr_t writeDataArray(hid_t gid, const QString& name, hsize_t numElements, const int32_t* data)
+    {
+      return writeDataArray(gid, name, H5T_NATIVE_INT32, numElements, data);
+    }
+
   public:
     EbsdImporter(const EbsdImporter&) = delete;   // Copy Constructor Not Implemented
     EbsdImporter(EbsdImporter&&) = delete;        // Move Constructor Not Implemented
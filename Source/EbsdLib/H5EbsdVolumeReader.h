@@ -36,6 +36,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include <QtCore/QString>
 #include <QtCore/QVector>
 #include <QtCore/QSet>
@@ -102,6 +104,20 @@ class EbsdLib_EXPORT H5EbsdVolumeReader : public H5EbsdVolumeInfo
     /** @brief Will this class be responsible for deallocating the memory for the data arrays */
     EBSD_INSTANCE_PROPERTY(bool, ManageMemory)
 
+    /**
+     * @brief Receives the volume one slice at a time. The argument is the z index of the slice
+     * in the volume; a negative return value stops loadData, which then returns that value.
+     */
+    using SliceConsumer = std::function<int(int64_t)>;
+
+    /**
+     * @brief When a SliceConsumer is set, loadData only allocates its arrays for a single slice and
+     * calls the consumer after each slice has been copied into them, so the whole volume is never
+     * held in memory. The arrays are only valid for the duration of the call and cells outside the
+     * slice's own extent are zero.
+     */
+    EBSD_INSTANCE_PROPERTY(SliceConsumer, SliceConsumer)
+
     /** @brief The number of elements in a column of data. This should be rows * columns */
     EBSD_INSTANCE_PROPERTY(size_t, NumberOfElements)
 
@@ -85,7 +85,7 @@ using namespace H5Support_NAMESPACE;
   {                                                                                                                                                                                                    \
     if(nullptr != dataPtr)                                                                                                                                                                             \
     {                                                                                                                                                                                                  \
-      err = QH5Lite::writePointerDataset(gid, key, rank, dims, dataPtr);                                                                                                                               \
+      err = writeDataArray(gid, key, dims[0], dataPtr);                                                                                                                                                \
       if(err < 0)                                                                                                                                                                                      \
       {                                                                                                                                                                                                \
         QString ss = QObject::tr("H5CtfImporter Error: Could not write Ctf Data array for '%1' to the HDF5 file with data set name '%2'\n").arg(key, key);                                             \
@@ -138,50 +138,87 @@ int H5CtfImporter::numberOfSlicesImported()
 // -----------------------------------------------------------------------------
 int H5CtfImporter::importFile(hid_t fileId, int64_t z, const QString& ctfFile)
 {
-  herr_t err = -1;
   setCancel(false);
   setErrorCode(0);
   setPipelineMessage("");
 
+  std::shared_ptr<EbsdReader> reader;
+  QString message;
+  int err = parseFile(ctfFile, reader, message);
+  if(err < 0)
+  {
+    setPipelineMessage(message);
+    setErrorCode(err);
+    progressMessage(message, 100);
+    return -1;
+  }
+
+  return writeFile(fileId, z, *reader);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5CtfImporter::parseFile(const QString& ctfFile, std::shared_ptr<EbsdReader>& ebsdReader, QString& message) const
+{
   //  std::cout << "H5CtfImporter: Importing " << ctfFile << std::endl;
-  CtfReader reader;
+  std::shared_ptr<CtfReader> ctfReader(new CtfReader);
+  CtfReader& reader = *ctfReader;
   reader.setFileName(ctfFile);
 
   // Now actually read the file
-  err = reader.readFile();
+  int err = reader.readFile();
 
   // Check for errors
   if (err < 0)
   {
-
-    QString ss;
     if (err == -200)
     {
-      ss = "H5CtfImporter Error: There was no data in the file.";
+      message = "H5CtfImporter Error: There was no data in the file.";
     }
     else if (err == -100)
     {
-      ss = "H5CtfImporter Error: The Ctf file could not be opened.";
+      message = "H5CtfImporter Error: The Ctf file could not be opened.";
     }
     else if (reader.getXStep() == 0.0f)
     {
-      ss = "H5CtfImporter Error: X Step value equals 0.0. This is bad. Please check the validity of the CTF file.";
+      message = "H5CtfImporter Error: X Step value equals 0.0. This is bad. Please check the validity of the CTF file.";
     }
     else if(reader.getYStep() == 0.0f)
     {
-      ss = "H5CtfImporter Error: Y Step value equals 0.0. This is bad. Please check the validity of the CTF file.";
+      message = "H5CtfImporter Error: Y Step value equals 0.0. This is bad. Please check the validity of the CTF file.";
     }
     else
     {
-      ss = reader.getErrorMessage();
+      message = reader.getErrorMessage();
     }
-    setPipelineMessage(ss);
-    setErrorCode(err);
-    progressMessage(ss, 100);
+    ebsdReader.reset();
+    return err;
+  }
 
+  message.clear();
+  ebsdReader = ctfReader;
+  return err;
+}
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5CtfImporter::writeFile(hid_t fileId, int64_t z, EbsdReader& ebsdReader)
+{
+  herr_t err = -1;
+  setErrorCode(0);
+  setPipelineMessage("");
+
+  CtfReader* ctfReader = dynamic_cast<CtfReader*>(&ebsdReader);
+  if(nullptr == ctfReader)
+  {
+    QString ss = QObject::tr("H5CtfImporter Error: The reader for Z index %1 does not hold .ctf data.").arg(z);
+    setPipelineMessage(ss);
+    setErrorCode(-800);
     return -1;
   }
+  CtfReader& reader = *ctfReader;
 
   // Write the fileversion attribute if it does not exist
   {
@@ -324,7 +361,6 @@ int H5CtfImporter::writeSliceData(hid_t fileId, CtfReader& reader, int z, int ac
     return -1;
   }
 
-  int32_t rank = 1;
   hsize_t dims[1] =
   { static_cast<hsize_t> (reader.getXCells() * reader.getYCells()) };
 
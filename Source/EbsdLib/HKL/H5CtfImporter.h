@@ -73,6 +73,22 @@ class EbsdLib_EXPORT H5CtfImporter : public EbsdImporter
      */
     int importFile(hid_t fileId, int64_t index, const QString& angFile) override;
 
+    /**
+     * @brief Parses a .ctf file into its own reader without touching any HDF5 file
+     * @param ebsdFile The absolute path to the input .ctf file
+     * @param reader The reader holding the parsed data (out)
+     * @param message Description of the error, if any (out)
+     */
+    int parseFile(const QString& ebsdFile, std::shared_ptr<EbsdReader>& reader, QString& message) const override;
+
+    /**
+     * @brief Writes a .ctf file that was parsed by parseFile() into the HDF5 file
+     * @param fileId The valid HDF5 file Id for an already open HDF5 file
+     * @param index The slice index for the file
+     * @param reader The reader returned by parseFile()
+     */
+    int writeFile(hid_t fileId, int64_t index, EbsdReader& reader) override;
+
     /**
      * @brief Writes the phase data into the HDF5 file
      * @param reader Valid AngReader instance
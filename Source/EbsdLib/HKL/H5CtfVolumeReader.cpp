@@ -198,7 +198,10 @@ int H5CtfVolumeReader::loadData(int64_t xpoints,
   int index = 0;
   int err = -1;
 // Initialize all the pointers
-  initPointers(xpoints * ypoints * zpoints);
+  // Only a single slice is held at a time when the slices are handed to a consumer
+  bool sliceBySlice = static_cast<bool>(getSliceConsumer());
+  int64_t numSlicePoints = xpoints * ypoints;
+  initPointers(sliceBySlice ? numSlicePoints : numSlicePoints * zpoints);
 
   int readerIndex = 0;
   int64_t xpointsslice = 0;
@@ -215,6 +218,11 @@ int H5CtfVolumeReader::loadData(int64_t xpoints,
 
   for (int slice = 0; slice < zpoints; ++slice)
   {
+    if(sliceBySlice && slice > 0)
+    {
+      // Slices may be smaller than the volume, so every slice starts from zeroed arrays
+      initPointers(numSlicePoints);
+    }
     H5CtfReader::Pointer reader = H5CtfReader::New();
     reader->setFileName(getFileName());
     reader->setHDF5Path(QString::number(slice + getSliceStart()));
@@ -259,13 +267,14 @@ int H5CtfVolumeReader::loadData(int64_t xpoints,
     }
     if (ZDir == 0) { zval = slice; }
     if (ZDir == 1) { zval = static_cast<int>( (zpoints - 1) - slice ); }
+    int sliceIndex = sliceBySlice ? 0 : zval;
 
     // Copy the data from the current storage into the Storage Location
     for (int j = 0; j < ypointsslice; j++)
     {
       for (int i = 0; i < xpointsslice; i++)
       {
-        index = static_cast<int>( (zval * xpointstemp * ypointstemp) + ((j + ystartspot) * xpointstemp) + (i + xstartspot) );
+        index = static_cast<int>( (sliceIndex * xpointstemp * ypointstemp) + ((j + ystartspot) * xpointstemp) + (i + xstartspot) );
         if (nullptr != phasePtr) {m_Phase[index] = phasePtr[readerIndex];}
         if (nullptr != xPtr) {m_X[index] = xPtr[readerIndex];}
         if (nullptr != yPtr) {m_Y[index] = yPtr[readerIndex];}
@@ -295,6 +304,15 @@ int H5CtfVolumeReader::loadData(int64_t xpoints,
         ++readerIndex;
       }
     }
+
+    if(sliceBySlice)
+    {
+      err = getSliceConsumer()(zval);
+      if(err < 0)
+      {
+        return err;
+      }
+    }
   }
   return err;
 
@@ -100,7 +100,7 @@ H5AngImporter::~H5AngImporter() = default;
   {\
     m_msgType* dataPtr = reader.get##prpty##Pointer();\
     if (nullptr != dataPtr) {\
-      err = QH5Lite::writePointerDataset(gid, key, rank, dims, dataPtr);\
+      err = writeDataArray(gid, key, numElements, dataPtr);\
       if (err < 0) {\
         ss.string()->clear();\
         ss << "H5AngImporter Error: Could not write Ang Data array for '" << key\
@@ -143,19 +143,39 @@ int H5AngImporter::numberOfSlicesImported()
 // -----------------------------------------------------------------------------
 int H5AngImporter::importFile(hid_t fileId, int64_t z, const QString& angFile)
 {
-  herr_t err = -1;
   setCancel(false);
   setErrorCode(0);
   setPipelineMessage("");
+
+  std::shared_ptr<EbsdReader> reader;
+  QString message;
+  int err = parseFile(angFile, reader, message);
+  if(err < 0)
+  {
+    setPipelineMessage(message);
+    setErrorCode(err);
+    progressMessage(message, 100);
+    return -1;
+  }
+
+  return writeFile(fileId, z, *reader);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5AngImporter::parseFile(const QString& angFile, std::shared_ptr<EbsdReader>& ebsdReader, QString& message) const
+{
   QString streamBuf;
   QTextStream ss(&streamBuf);
 
   //  std::cout << "H5AngImporter: Importing " << angFile;
-  AngReader reader;
+  std::shared_ptr<AngReader> angReader(new AngReader);
+  AngReader& reader = *angReader;
   reader.setFileName(angFile);
 
   // Now actually read the file
-  err = reader.readFile();
+  int err = reader.readFile();
 
   // Check for errors
   if (err < 0)
@@ -188,12 +208,37 @@ int H5AngImporter::importFile(hid_t fileId, int64_t z, const QString& angFile)
     {
       ss << "H5AngImporter Error: Unknown error [" << err << "]";
     }
-    setPipelineMessage( *(ss.string()));
+    message = *(ss.string());
+    ebsdReader.reset();
+    return err;
+  }
 
-    setErrorCode(err);
-    progressMessage(*(ss.string()), 100);
+  message.clear();
+  ebsdReader = angReader;
+  return err;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5AngImporter::writeFile(hid_t fileId, int64_t z, EbsdReader& ebsdReader)
+{
+  herr_t err = -1;
+  setErrorCode(0);
+  setPipelineMessage("");
+  QString streamBuf;
+  QTextStream ss(&streamBuf);
+
+  AngReader* angReader = dynamic_cast<AngReader*>(&ebsdReader);
+  if(nullptr == angReader)
+  {
+    ss << "H5AngImporter Error: The reader for Z index " << z << " does not hold .ang data.";
+    setPipelineMessage(*(ss.string()));
+    setErrorCode(-800);
     return -1;
   }
+  AngReader& reader = *angReader;
+  QString angFile = reader.getFileName();
 
   // Write the file Version number to the file
   {
@@ -296,8 +341,7 @@ int H5AngImporter::importFile(hid_t fileId, int64_t z, const QString& angFile)
     return -1;
   }
 
-  int32_t rank = 1;
-  hsize_t dims[1] = { static_cast<hsize_t>(reader.getNumEvenCols() * reader.getNumRows() ) };
+  hsize_t numElements = static_cast<hsize_t>(reader.getNumEvenCols() * reader.getNumRows());
 
   WRITE_ANG_DATA_ARRAY(reader, float, gid, Phi1, Ebsd::Ang::Phi1);
   WRITE_ANG_DATA_ARRAY(reader, float, gid, Phi, Ebsd::Ang::Phi);
@@ -214,7 +214,10 @@ int H5AngVolumeReader::loadData(int64_t xpoints,
   int index = 0;
   int err = -1;
   // Initialize all the pointers
-  initPointers(xpoints * ypoints * zpoints);
+  // Only a single slice is held at a time when the slices are handed to a consumer
+  bool sliceBySlice = static_cast<bool>(getSliceConsumer());
+  int64_t numSlicePoints = xpoints * ypoints;
+  initPointers(sliceBySlice ? numSlicePoints : numSlicePoints * zpoints);
 
 
   int readerIndex = 0;
@@ -232,6 +235,11 @@ int H5AngVolumeReader::loadData(int64_t xpoints,
   err = readVolumeInfo();
   for (int slice = 0; slice < zpoints; ++slice)
   {
+    if(sliceBySlice && slice > 0)
+    {
+      // Slices may be smaller than the volume, so every slice starts from zeroed arrays
+      initPointers(numSlicePoints);
+    }
     H5AngReader::Pointer reader = H5AngReader::New();
     reader->setFileName(getFileName());
     reader->setHDF5Path(QString::number(slice + getSliceStart()));
@@ -278,13 +286,14 @@ int H5AngVolumeReader::loadData(int64_t xpoints,
     }
     if(ZDir == SIMPL::RefFrameZDir::LowtoHigh) { zval = slice; }
     if(ZDir == SIMPL::RefFrameZDir::HightoLow) { zval = static_cast<int>( (zpoints - 1) - slice ); }
+    int sliceIndex = sliceBySlice ? 0 : zval;
 
     // Copy the data from the current storage into the new memory Location
     for (int j = 0; j < ystop; j++)
     {
       for (int i = 0; i < xstop; i++)
       {
-        index = (zval * xpointstemp * ypointstemp) + ((j + ystartspot) * xpointstemp) + (i + xstartspot);
+        index = (sliceIndex * xpointstemp * ypointstemp) + ((j + ystartspot) * xpointstemp) + (i + xstartspot);
         if (nullptr != euler1Ptr) {m_Phi1[index] = euler1Ptr[readerIndex];}
         if (nullptr != euler2Ptr) {m_Phi[index] = euler2Ptr[readerIndex];}
         if (nullptr != euler3Ptr) {m_Phi2[index] = euler3Ptr[readerIndex];}
@@ -311,6 +320,15 @@ int H5AngVolumeReader::loadData(int64_t xpoints,
         ++readerIndex;
       }
     }
+
+    if(sliceBySlice)
+    {
+      err = getSliceConsumer()(zval);
+      if(err < 0)
+      {
+        return err;
+      }
+    }
   }
   return err;
 }
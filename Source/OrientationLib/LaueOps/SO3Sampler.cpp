@@ -33,9 +33,20 @@
 
 
 #include "SIMPLib/Math/SIMPLibMath.h"
+#include <algorithm>
+#include <unordered_set>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Math/ArrayHelpers.hpp"
 
 #include "OrientationLib/OrientationLibConstants.h"
+#include "OrientationLib/OrientationMath/OrientationBatchTransforms.hpp"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 
 
@@ -103,6 +114,71 @@ static const int FZoarray[32] = { NoAxisOrder,NoAxisOrder,TwoFoldAxisOrder,TwoFo
                                   SixFoldAxisOrder,SixFoldAxisOrder,NoAxisOrder,NoAxisOrder,NoAxisOrder,NoAxisOrder,NoAxisOrder};
 
 
+namespace
+{
+// Upper bound of the rotation angle, in radians, swept per unit of length in the cubochoric cube;
+// the largest value measured over the cube is about 4.8
+const double k_MaxCubochoricStretch = 6.0;
+
+/**
+ * @brief The SampleRFZImpl class tests the cubochoric grid points of a range of slabs of constant x
+ * against a fundamental zone. Each slab collects its points into its own buffer.
+ */
+class SampleRFZImpl
+{
+public:
+  SampleRFZImpl(SO3Sampler* sampler, int nsteps, int FZtype, int FZorder, std::vector<std::vector<DOrientArrayType>>& slabs)
+  : m_Sampler(sampler)
+  , m_NSteps(nsteps)
+  , m_FZtype(FZtype)
+  , m_FZorder(FZorder)
+  , m_Slabs(slabs)
+  {
+  }
+  virtual ~SampleRFZImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    typedef OrientationTransforms<OrientationTuple<double>, double> OrientationTransformsType;
+    double delta = (0.50 * LPs::ap) / static_cast<double>(m_NSteps);
+    OrientationTuple<double> cu(3, 0.0);
+    OrientationTuple<double> rod(4, 0.0);
+    for(size_t slab = start; slab < end; slab++)
+    {
+      std::vector<DOrientArrayType>& points = m_Slabs[slab];
+      cu[0] = static_cast<double>(static_cast<int>(slab) - m_NSteps) * delta;
+      for(int j = -m_NSteps; j < m_NSteps; j++)
+      {
+        cu[1] = static_cast<double>(j) * delta;
+        for(int k = -m_NSteps; k < m_NSteps; k++)
+        {
+          cu[2] = static_cast<double>(k) * delta;
+          OrientationTransformsType::cu2ro(cu, rod);
+          if(m_Sampler->IsinsideFZ(rod.data(), m_FZtype, m_FZorder))
+          {
+            points.push_back(DOrientArrayType(rod[0], rod[1], rod[2], rod[3]));
+          }
+        }
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  SO3Sampler* m_Sampler = nullptr;
+  int m_NSteps = 0;
+  int m_FZtype = 0;
+  int m_FZorder = 0;
+  std::vector<std::vector<DOrientArrayType>>& m_Slabs;
+};
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -423,49 +499,149 @@ bool SO3Sampler::insideCubicFZ(double* rod, int ot)
 //--------------------------------------------------------------------------
 SO3Sampler::OrientationListArrayType SO3Sampler::SampleRFZ(int nsteps,int pgnum)
 {
-
-  double                        x, y, z, delta;
-  OrientationListArrayType              FZlist;
-  int32_t                 FZtype, FZorder;
-
-  // step size for sampling of grid; total number of samples = (2*nsteps+1)**3
-  delta = ( 0.50 * LPs::ap)/static_cast<double>(nsteps);
+  OrientationListArrayType FZlist;
 
   // determine which function we should call for this point group symmetry
-  FZtype = FZtarray[pgnum-1];
-  FZorder = FZoarray[pgnum-1];
-  typedef OrientationTransforms<DOrientArrayType, double> OrientationTransformsType;
+  int32_t FZtype = FZtarray[pgnum - 1];
+  int32_t FZorder = FZoarray[pgnum - 1];
 
   // loop over the cube of volume pi^2; note that we do not want to include
   // the opposite edges/facets of the cube, to avoid double counting rotations
   // with a rotation angle of 180 degrees.  This only affects the cyclic groups.
-  for(int i = -nsteps; i < nsteps; i++)
+  // Slab s holds the points with x index s - nsteps.
+  size_t numSlabs = static_cast<size_t>(2 * nsteps);
+  std::vector<std::vector<DOrientArrayType>> slabs(numSlabs);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  if(doParallel)
   {
-    x = static_cast<double>(i) * delta;
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlabs, 1), SampleRFZImpl(this, nsteps, FZtype, FZorder, slabs), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    SampleRFZImpl serial(this, nsteps, FZtype, FZorder, slabs);
+    serial.convert(0, numSlabs);
+  }
 
-    for(int j = -nsteps; j < nsteps; j++)
-    {
-      y = static_cast<double>(j) * delta;
+  for(std::vector<DOrientArrayType>& points : slabs)
+  {
+    FZlist.insert(FZlist.end(), points.begin(), points.end());
+    std::vector<DOrientArrayType>().swap(points);
+  }
 
-      for (int k = -nsteps; k < nsteps; k++)
-      {
-        z = static_cast<double>(k) * delta;
+  return FZlist;
+}
+
+//--------------------------------------------------------------------------
+//
+//--------------------------------------------------------------------------
+SO3Sampler::OrientationListArrayType SO3Sampler::SampleRFZNeighborhood(int nsteps, int pgnum, const DOrientArrayType& referenceRod, double maxAngle)
+{
+  typedef OrientationTransforms<OrientationTuple<double>, double> OrientationTransformsType;
+  OrientationListArrayType FZlist;
+
+  int32_t FZtype = FZtarray[pgnum - 1];
+  int32_t FZorder = FZoarray[pgnum - 1];
+  double delta = (0.50 * LPs::ap) / static_cast<double>(nsteps);
+
+  // The flood fill runs over the closed grid, indices -nsteps to nsteps, and walks through grid points
+  // up to one cell diagonal further than maxAngle so that no part of the neighborhood is cut off from
+  // the start point. Points on opposite faces of the cube are the same 180 degree rotations, so a
+  // point on a face also leads to its antipode. Only the points of the half-open SampleRFZ grid,
+  // indices -nsteps to nsteps - 1, are returned.
+  double walkAngle = maxAngle + k_MaxCubochoricStretch * std::sqrt(3.0) * delta;
+  double minCosWalk = walkAngle < SIMPLib::Constants::k_Pi ? std::cos(0.5 * walkAngle) : -1.0;
+  double minCosKeep = std::cos(0.5 * std::min(maxAngle, SIMPLib::Constants::k_Pi));
+
+  OrientationTuple<double> rod(4, 0.0);
+  OrientationTuple<double> refQu(4, 0.0);
+  OrientationTuple<double> refCu(3, 0.0);
+  OrientationTuple<double> cu(3, 0.0);
+  OrientationTuple<double> qu(4, 0.0);
+  for(size_t c = 0; c < 4; c++)
+  {
+    rod[c] = referenceRod[c];
+  }
+  OrientationTransformsType::ro2qu(rod, refQu);
+  OrientationTransformsType::qu2cu(refQu, refCu);
 
-        // convert to Rodrigues representation
-        DOrientArrayType cu(x, y, z);
-        DOrientArrayType rod(4);
-        OrientationTransformsType::cu2ro(cu, rod);
+  int64_t side = 2 * static_cast<int64_t>(nsteps) + 1;
+  auto toIndex = [&](int64_t i, int64_t j, int64_t k) { return ((i + nsteps) * side + (j + nsteps)) * side + (k + nsteps); };
 
-        // If insideFZ=true, then add this point to the linked list FZlist and keep
-        // track of how many points there are on this list
-        bool b = IsinsideFZ(rod.data(), FZtype, FZorder);
-        if (b)
+  std::vector<int64_t> stack;
+  std::unordered_set<int64_t> visited;
+  std::vector<int64_t> found;
+  auto visit = [&](int64_t i, int64_t j, int64_t k) {
+    if(i < -nsteps || i > nsteps || j < -nsteps || j > nsteps || k < -nsteps || k > nsteps)
+    {
+      return;
+    }
+    int64_t index = toIndex(i, j, k);
+    if(visited.insert(index).second)
+    {
+      stack.push_back(index);
+    }
+  };
+
+  int64_t start[3] = {0, 0, 0};
+  for(size_t c = 0; c < 3; c++)
+  {
+    start[c] = static_cast<int64_t>(std::lround(refCu[c] / delta));
+  }
+  visit(start[0], start[1], start[2]);
+  while(!stack.empty())
+  {
+    int64_t index = stack.back();
+    stack.pop_back();
+    int64_t k = index % side - nsteps;
+    int64_t j = (index / side) % side - nsteps;
+    int64_t i = index / (side * side) - nsteps;
+
+    cu[0] = static_cast<double>(i) * delta;
+    cu[1] = static_cast<double>(j) * delta;
+    cu[2] = static_cast<double>(k) * delta;
+    OrientationTransformsType::cu2qu(cu, qu);
+    double cosHalfAngle = std::fabs(qu[0] * refQu[0] + qu[1] * refQu[1] + qu[2] * refQu[2] + qu[3] * refQu[3]);
+    if(cosHalfAngle < minCosWalk)
+    {
+      continue;
+    }
+    if(cosHalfAngle >= minCosKeep && i < nsteps && j < nsteps && k < nsteps)
+    {
+      found.push_back(index);
+    }
+
+    for(int64_t di = -1; di <= 1; di++)
+    {
+      for(int64_t dj = -1; dj <= 1; dj++)
+      {
+        for(int64_t dk = -1; dk <= 1; dk++)
         {
-          FZlist.push_back(rod);
+          visit(i + di, j + dj, k + dk);
         }
-
       }
     }
+    if(std::abs(i) == nsteps || std::abs(j) == nsteps || std::abs(k) == nsteps)
+    {
+      visit(-i, -j, -k);
+    }
+  }
+
+  // Grid index order is the x, y, z loop order of SampleRFZ
+  std::sort(found.begin(), found.end());
+  for(int64_t index : found)
+  {
+    cu[0] = static_cast<double>(index / (side * side) - nsteps) * delta;
+    cu[1] = static_cast<double>((index / side) % side - nsteps) * delta;
+    cu[2] = static_cast<double>(index % side - nsteps) * delta;
+    OrientationTransformsType::cu2ro(cu, rod);
+    if(IsinsideFZ(rod.data(), FZtype, FZorder))
+    {
+      FZlist.push_back(DOrientArrayType(rod[0], rod[1], rod[2], rod[3]));
+    }
   }
 
   return FZlist;
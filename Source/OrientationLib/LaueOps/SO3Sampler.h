@@ -58,9 +58,30 @@ class OrientationLib_EXPORT SO3Sampler
      */
     typedef std::list<DOrientArrayType> OrientationListArrayType;
 
-    // sampler routine
+    /**
+     * @brief SampleRFZ Samples the Rodrigues fundamental zone of a point group on a cubochoric grid.
+     * The grid is split into slabs of constant x that are tested in parallel, each into its own buffer,
+     * so the points come out in the same order as a serial sweep.
+     * @param nsteps Number of grid steps along the cube semi-edge
+     * @param pgnum Point group number (1 to 32)
+     * @return Rodrigues vectors of the grid points inside the fundamental zone
+     */
     OrientationListArrayType SampleRFZ(int nsteps,int pgnum);
 
+    /**
+     * @brief SampleRFZNeighborhood Returns the points of the SampleRFZ grid that lie within a given
+     * misorientation angle of a reference orientation, in the same order as SampleRFZ. Only the grid
+     * points around the reference are visited (by a flood fill through neighboring grid points), so
+     * the cost scales with the size of the neighborhood instead of the size of the grid. The
+     * misorientation is the rotation angle between the two orientations; crystal symmetry is not applied.
+     * @param nsteps Number of grid steps along the cube semi-edge
+     * @param pgnum Point group number (1 to 32)
+     * @param referenceRod Reference orientation as a 4 component Rodrigues vector
+     * @param maxAngle Misorientation angle in radians
+     * @return Rodrigues vectors of the grid points inside the fundamental zone and the neighborhood
+     */
+    OrientationListArrayType SampleRFZNeighborhood(int nsteps, int pgnum, const DOrientArrayType& referenceRod, double maxAngle);
+
     /**
      * @brief IsinsideFZ
      * @param rod
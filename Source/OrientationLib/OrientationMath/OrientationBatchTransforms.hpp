@@ -0,0 +1,383 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+
+#include "SIMPLib/SIMPLib.h"
+
+#include "OrientationLib/OrientationLib.h"
+#include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+/**
+ * @brief The OrientationTuple class holds a single orientation on the stack. It provides the
+ * part of the OrientationArray interface that the OrientationTransforms and
+ * ModifiedLambertProjection3D templates use, so the transforms and all of their temporaries
+ * can run without any heap allocation. The capacity is that of the largest representation,
+ * the 3x3 orientation matrix.
+ */
+template <typename T>
+class OrientationTuple
+{
+public:
+  static const size_t k_Capacity = 9;
+
+  /**
+   * @brief OrientationTuple Constructor
+   * @param size The number of elements
+   * @param init Initialization value to be assigned to each element
+   */
+  explicit OrientationTuple(size_t size, T init = static_cast<T>(0))
+  : m_Size(size)
+  {
+    for(size_t i = 0; i < k_Capacity; i++)
+    {
+      m_Values[i] = init;
+    }
+  }
+
+  OrientationTuple(const OrientationTuple&) = default;
+  OrientationTuple& operator=(const OrientationTuple&) = default;
+  ~OrientationTuple() = default;
+
+  /**
+   * @brief Returns the number of elements
+   */
+  size_t size() const
+  {
+    return m_Size;
+  }
+
+  T& operator[](size_t i)
+  {
+    return m_Values[i];
+  }
+
+  const T& operator[](size_t i) const
+  {
+    return m_Values[i];
+  }
+
+  /**
+   * @brief data Returns a pointer to the elements
+   */
+  T* data()
+  {
+    return m_Values;
+  }
+
+private:
+  T m_Values[k_Capacity];
+  size_t m_Size = 0;
+};
+
+/**
+ * @brief The OrientationMemoryLayout struct describes where the components of each orientation
+ * live in a flat array: component c of tuple i is at i * tupleStride + c * componentStride.
+ * DataArrays are interleaved (AoS); planar (SoA) buffers keep each component contiguous.
+ */
+struct OrientationMemoryLayout
+{
+  size_t tupleStride = 0;
+  size_t componentStride = 0;
+
+  /**
+   * @brief AoS Returns the layout of interleaved tuples, as stored by a DataArray
+   * @param numComponents Number of components of each tuple
+   */
+  static OrientationMemoryLayout AoS(size_t numComponents)
+  {
+    OrientationMemoryLayout layout;
+    layout.tupleStride = numComponents;
+    layout.componentStride = 1;
+    return layout;
+  }
+
+  /**
+   * @brief SoA Returns the layout of planar tuples, one contiguous block per component
+   * @param numTuples Number of tuples in the array
+   */
+  static OrientationMemoryLayout SoA(size_t numTuples)
+  {
+    OrientationMemoryLayout layout;
+    layout.tupleStride = 1;
+    layout.componentStride = numTuples;
+    return layout;
+  }
+};
+
+/**
+ * @brief This macro is used to create a functor that wraps a paricular conversion
+ * method of OrientationTransforms so it can be run by the batch conversion kernel
+ */
+#define OC_CONVERTOR_FUNCTOR(CLASSNAME, INSTRIDE, OUTSTRIDE, CONVERSION_METHOD)\
+  template<typename T>\
+  class CLASSNAME {\
+  public:\
+  static const size_t k_InComponents = INSTRIDE;\
+  static const size_t k_OutComponents = OUTSTRIDE;\
+  void operator()(const OrientationTuple<T>& in, OrientationTuple<T>& out) const { \
+  OrientationTransforms<OrientationTuple<T>, T>::CONVERSION_METHOD(in, out); \
+  }\
+  };
+
+/**
+ * @brief This contains all the functors that represent all possible conversion routines
+ * between orientation representations
+ */
+namespace Convertors
+{
+/* Euler Functors  */
+OC_CONVERTOR_FUNCTOR(Eu2Om, 3, 9, eu2om)
+OC_CONVERTOR_FUNCTOR(Eu2Qu, 3, 4, eu2qu)
+OC_CONVERTOR_FUNCTOR(Eu2Ax, 3, 4, eu2ax)
+OC_CONVERTOR_FUNCTOR(Eu2Ro, 3, 4, eu2ro)
+OC_CONVERTOR_FUNCTOR(Eu2Ho, 3, 3, eu2ho)
+OC_CONVERTOR_FUNCTOR(Eu2Cu, 3, 3, eu2cu)
+
+/* OrientationMatrix Functors */
+OC_CONVERTOR_FUNCTOR(Om2Eu, 9, 3, om2eu)
+OC_CONVERTOR_FUNCTOR(Om2Qu, 9, 4, om2qu)
+OC_CONVERTOR_FUNCTOR(Om2Ax, 9, 4, om2ax)
+OC_CONVERTOR_FUNCTOR(Om2Ro, 9, 4, om2ro)
+OC_CONVERTOR_FUNCTOR(Om2Ho, 9, 3, om2ho)
+OC_CONVERTOR_FUNCTOR(Om2Cu, 9, 3, om2cu)
+
+/* Quaterion Functors */
+OC_CONVERTOR_FUNCTOR(Qu2Eu, 4, 3, qu2eu)
+OC_CONVERTOR_FUNCTOR(Qu2Om, 4, 9, qu2om)
+OC_CONVERTOR_FUNCTOR(Qu2Ax, 4, 4, qu2ax)
+OC_CONVERTOR_FUNCTOR(Qu2Ro, 4, 4, qu2ro)
+OC_CONVERTOR_FUNCTOR(Qu2Ho, 4, 3, qu2ho)
+OC_CONVERTOR_FUNCTOR(Qu2Cu, 4, 3, qu2cu)
+
+/* AxisAngles Functors */
+OC_CONVERTOR_FUNCTOR(Ax2Eu, 4, 3, ax2eu)
+OC_CONVERTOR_FUNCTOR(Ax2Om, 4, 9, ax2om)
+OC_CONVERTOR_FUNCTOR(Ax2Qu, 4, 4, ax2qu)
+OC_CONVERTOR_FUNCTOR(Ax2Ro, 4, 4, ax2ro)
+OC_CONVERTOR_FUNCTOR(Ax2Ho, 4, 3, ax2ho)
+OC_CONVERTOR_FUNCTOR(Ax2Cu, 4, 3, ax2cu)
+
+/* Rodrigues Functors */
+OC_CONVERTOR_FUNCTOR(Ro2Eu, 4, 3, ro2eu)
+OC_CONVERTOR_FUNCTOR(Ro2Om, 4, 9, ro2om)
+OC_CONVERTOR_FUNCTOR(Ro2Qu, 4, 4, ro2qu)
+OC_CONVERTOR_FUNCTOR(Ro2Ax, 4, 4, ro2ax)
+OC_CONVERTOR_FUNCTOR(Ro2Ho, 4, 3, ro2ho)
+OC_CONVERTOR_FUNCTOR(Ro2Cu, 4, 3, ro2cu)
+
+/* Homochoric Functors */
+OC_CONVERTOR_FUNCTOR(Ho2Eu, 3, 3, ho2eu)
+OC_CONVERTOR_FUNCTOR(Ho2Om, 3, 9, ho2om)
+OC_CONVERTOR_FUNCTOR(Ho2Qu, 3, 4, ho2qu)
+OC_CONVERTOR_FUNCTOR(Ho2Ax, 3, 4, ho2ax)
+OC_CONVERTOR_FUNCTOR(Ho2Ro, 3, 4, ho2ro)
+OC_CONVERTOR_FUNCTOR(Ho2Cu, 3, 3, ho2cu)
+
+/* Cubochoric Functors */
+OC_CONVERTOR_FUNCTOR(Cu2Eu, 3, 3, cu2eu)
+OC_CONVERTOR_FUNCTOR(Cu2Om, 3, 9, cu2om)
+OC_CONVERTOR_FUNCTOR(Cu2Qu, 3, 4, cu2qu)
+OC_CONVERTOR_FUNCTOR(Cu2Ax, 3, 4, cu2ax)
+OC_CONVERTOR_FUNCTOR(Cu2Ro, 3, 4, cu2ro)
+OC_CONVERTOR_FUNCTOR(Cu2Ho, 3, 3, cu2ho)
+
+/**
+ * @brief Reorders quaternions from <x,y,z> w to w <x,y,z>
+ */
+template <typename T>
+class QuVectorScalar2ScalarVector
+{
+public:
+  static const size_t k_InComponents = 4;
+  static const size_t k_OutComponents = 4;
+  void operator()(const OrientationTuple<T>& in, OrientationTuple<T>& out) const
+  {
+    out[0] = in[3];
+    out[1] = in[0];
+    out[2] = in[1];
+    out[3] = in[2];
+  }
+};
+
+/**
+ * @brief Reorders quaternions from w <x,y,z> to <x,y,z> w
+ */
+template <typename T>
+class QuScalarVector2VectorScalar
+{
+public:
+  static const size_t k_InComponents = 4;
+  static const size_t k_OutComponents = 4;
+  void operator()(const OrientationTuple<T>& in, OrientationTuple<T>& out) const
+  {
+    out[0] = in[1];
+    out[1] = in[2];
+    out[2] = in[3];
+    out[3] = in[0];
+  }
+};
+
+/**
+ * @brief Converts 3 component Rodrigues vectors, whose length is tan(w/2), into the 4 component
+ * <unit axis> length representation
+ */
+template <typename T>
+class Rv2Ro
+{
+public:
+  static const size_t k_InComponents = 3;
+  static const size_t k_OutComponents = 4;
+  void operator()(const OrientationTuple<T>& in, OrientationTuple<T>& out) const
+  {
+    T length = std::sqrt(in[0] * in[0] + in[1] * in[1] + in[2] * in[2]);
+    out[0] = in[0] / length;
+    out[1] = in[1] / length;
+    out[2] = in[2] / length;
+    out[3] = length;
+  }
+};
+} // namespace Convertors
+
+/**
+ * @brief This templated class is a functor class that is used for
+ * the TBB classes to use to parallelize the conversion of orientation
+ * representations. Each tuple is gathered from the input layout into an OrientationTuple,
+ * converted and scattered into the output layout, so the input and output may be the same
+ * array as long as both use the same layout and tuple stride.
+ */
+template <typename T, class Converter>
+class ConvertRepresentation
+{
+public:
+  ConvertRepresentation(const T* inPtr, const OrientationMemoryLayout& inLayout, T* outPtr, const OrientationMemoryLayout& outLayout)
+  : m_InPtr(inPtr)
+  , m_OutPtr(outPtr)
+  , m_InLayout(inLayout)
+  , m_OutLayout(outLayout)
+  {
+  }
+  ~ConvertRepresentation() = default;
+
+  /**
+   * @brief This is the main conversion routine
+   * @param start Starting index
+   * @param end Ending index
+   */
+  void convert(size_t start, size_t end) const
+  {
+    Converter conv;
+    for(size_t i = start; i < end; ++i)
+    {
+      OrientationTuple<T> input(Converter::k_InComponents);
+      OrientationTuple<T> output(Converter::k_OutComponents);
+      const T* inTuple = m_InPtr + i * m_InLayout.tupleStride;
+      for(size_t c = 0; c < Converter::k_InComponents; c++)
+      {
+        input[c] = inTuple[c * m_InLayout.componentStride];
+      }
+      conv(input, output);
+      T* outTuple = m_OutPtr + i * m_OutLayout.tupleStride;
+      for(size_t c = 0; c < Converter::k_OutComponents; c++)
+      {
+        outTuple[c * m_OutLayout.componentStride] = output[c];
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const T* m_InPtr = nullptr;
+  T* m_OutPtr = nullptr;
+  OrientationMemoryLayout m_InLayout;
+  OrientationMemoryLayout m_OutLayout;
+};
+
+/**
+ * @brief ConvertOrientationBatch Converts a batch of orientations with one of the Convertors
+ * functors, in parallel when available. The results are identical to calling the scalar
+ * OrientationTransforms method on each tuple.
+ * @param input Input orientations
+ * @param inLayout Layout of the input orientations
+ * @param output Output orientations; may be the input array, see ConvertRepresentation
+ * @param outLayout Layout of the output orientations
+ * @param numTuples Number of orientations
+ */
+template <typename T, class Converter>
+void ConvertOrientationBatch(const T* input, const OrientationMemoryLayout& inLayout, T* output, const OrientationMemoryLayout& outLayout, size_t numTuples)
+{
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  ConvertRepresentation<T, Converter> body(input, inLayout, output, outLayout);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numTuples), body, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    body.convert(0, numTuples);
+  }
+}
+
+/**
+ * @brief ConvertOrientationBatch Converts a batch of interleaved (AoS) orientations
+ */
+template <typename T, class Converter>
+void ConvertOrientationBatch(const T* input, T* output, size_t numTuples)
+{
+  ConvertOrientationBatch<T, Converter>(input, OrientationMemoryLayout::AoS(Converter::k_InComponents), output, OrientationMemoryLayout::AoS(Converter::k_OutComponents), numTuples);
+}
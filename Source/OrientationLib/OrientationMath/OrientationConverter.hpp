@@ -47,6 +47,7 @@
 
 #include "OrientationLib/OrientationLib.h"
 #include "OrientationLib/OrientationMath/OrientationArray.hpp"
+#include "OrientationLib/OrientationMath/OrientationBatchTransforms.hpp"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 
 
@@ -175,6 +176,13 @@ class OrientationConverter
     * @brief Sets/Gets the output orientations
     */
     SIMPL_INSTANCE_PROPERTY(typename DataArray<T>::Pointer, OutputData)
+
+    /**
+    * @brief Sets/Gets an optional array that the conversions write into instead of
+    * allocating a new output array. It is only used when its tuple and component counts
+    * match the conversion, and it may be the input array itself.
+    */
+    SIMPL_INSTANCE_PROPERTY(typename DataArray<T>::Pointer, DestinationData)
     
     /**
      * @brief GetOrientationTypeStrings
@@ -241,148 +249,37 @@ class OrientationConverter
     
   protected:
     OrientationConverter() {}
-    
-  private:
-    OrientationConverter(const OrientationConverter&) = delete; // Copy Constructor Not Implemented
-    void operator=(const OrientationConverter&) = delete;       // Move assignment Not Implemented
-};
-
 
-/**
- * @brief This macro is used to create a functor that wraps a paricular conversion
- * method with a functor class so it can be passed to the parallel algorithms
- */
-#define OC_CONVERTOR_FUNCTOR(CLASSNAME, INSTRIDE, OUTSTRIDE, CONVERSION_METHOD)\
-  template<typename T>\
-  class CLASSNAME {\
-  public:\
-  CLASSNAME()  { }\
-  void operator()(T* eu, T* om) { \
-  using OrientationArray_t = OrientationArray<T>;\
-  OrientationArray_t rot(eu, INSTRIDE); \
-  OrientationArray_t res(om, OUTSTRIDE); \
-  OrientationTransforms<OrientationArray_t, T>::CONVERSION_METHOD(rot, res); \
-  }\
-  private:\
-  };
-
-/**
- * @brief This contains all the functors that represent all possible conversion routines
- * between orientation representations
- */
-namespace Convertors {
-/* Euler Functors  */
-OC_CONVERTOR_FUNCTOR(Eu2Om, 3, 9, eu2om)
-OC_CONVERTOR_FUNCTOR(Eu2Qu, 3, 4, eu2qu)
-OC_CONVERTOR_FUNCTOR(Eu2Ax, 3, 4, eu2ax)
-OC_CONVERTOR_FUNCTOR(Eu2Ro, 3, 4, eu2ro)
-OC_CONVERTOR_FUNCTOR(Eu2Ho, 3, 3, eu2ho)
-OC_CONVERTOR_FUNCTOR(Eu2Cu, 3, 3, eu2cu)
-
-/* OrientationMatrix Functors */
-OC_CONVERTOR_FUNCTOR(Om2Eu, 9, 3, om2eu)
-OC_CONVERTOR_FUNCTOR(Om2Qu, 9, 4, om2qu)
-OC_CONVERTOR_FUNCTOR(Om2Ax, 9, 4, om2ax)
-OC_CONVERTOR_FUNCTOR(Om2Ro, 9, 4, om2ro)
-OC_CONVERTOR_FUNCTOR(Om2Ho, 9, 3, om2ho)
-OC_CONVERTOR_FUNCTOR(Om2Cu, 9, 3, om2cu)
-
-/* Quaterion Functors */
-OC_CONVERTOR_FUNCTOR(Qu2Eu, 4, 3, qu2eu)
-OC_CONVERTOR_FUNCTOR(Qu2Om, 4, 9, qu2om)
-OC_CONVERTOR_FUNCTOR(Qu2Ax, 4, 4, qu2ax)
-OC_CONVERTOR_FUNCTOR(Qu2Ro, 4, 4, qu2ro)
-OC_CONVERTOR_FUNCTOR(Qu2Ho, 4, 3, qu2ho)
-OC_CONVERTOR_FUNCTOR(Qu2Cu, 4, 3, qu2cu) 
-
-/* AxisAngles Functors */
-OC_CONVERTOR_FUNCTOR(Ax2Eu, 4, 3, ax2eu)
-OC_CONVERTOR_FUNCTOR(Ax2Om, 4, 9, ax2om)
-OC_CONVERTOR_FUNCTOR(Ax2Qu, 4, 4, ax2qu)
-OC_CONVERTOR_FUNCTOR(Ax2Ro, 4, 4, ax2ro)
-OC_CONVERTOR_FUNCTOR(Ax2Ho, 4, 3, ax2ho)
-OC_CONVERTOR_FUNCTOR(Ax2Cu, 4, 3, ax2cu)
-
-/* Rodrigues Functors */
-OC_CONVERTOR_FUNCTOR(Ro2Eu, 4, 3, ro2eu)
-OC_CONVERTOR_FUNCTOR(Ro2Om, 4, 9, ro2om)
-OC_CONVERTOR_FUNCTOR(Ro2Qu, 4, 4, ro2qu)
-OC_CONVERTOR_FUNCTOR(Ro2Ax, 4, 4, ro2ax)
-OC_CONVERTOR_FUNCTOR(Ro2Ho, 4, 3, ro2ho)
-OC_CONVERTOR_FUNCTOR(Ro2Cu, 4, 3, ro2cu)  
-
-/* Rodrigues Functors */
-OC_CONVERTOR_FUNCTOR(Ho2Eu, 3, 3, ho2eu)
-OC_CONVERTOR_FUNCTOR(Ho2Om, 3, 9, ho2om)
-OC_CONVERTOR_FUNCTOR(Ho2Qu, 3, 4, ho2qu)
-OC_CONVERTOR_FUNCTOR(Ho2Ax, 3, 4, ho2ax)
-OC_CONVERTOR_FUNCTOR(Ho2Ro, 3, 4, ho2ro)
-OC_CONVERTOR_FUNCTOR(Ho2Cu, 3, 3, ho2cu)      
-
-/* Rodrigues Functors */
-OC_CONVERTOR_FUNCTOR(Cu2Eu, 3, 3, cu2eu)
-OC_CONVERTOR_FUNCTOR(Cu2Om, 3, 9, cu2om)
-OC_CONVERTOR_FUNCTOR(Cu2Qu, 3, 4, cu2qu)
-OC_CONVERTOR_FUNCTOR(Cu2Ax, 3, 4, cu2ax)
-OC_CONVERTOR_FUNCTOR(Cu2Ro, 3, 4, cu2ro)
-OC_CONVERTOR_FUNCTOR(Cu2Ho, 3, 3, cu2ho)   
-
-}
-
-/**
- * @brief This templated class is a functor class that is used for 
- * the TBB classes to use to parallelize the conversion of orientation
- * representations
- */
-template <typename T, class Converter>
-class ConvertRepresentation
-{
-  public:
-    ConvertRepresentation(T* inPtr, T* outPtr, size_t inStride, size_t outStride) :
-      m_InPtr(inPtr)
-    , m_OutPtr(outPtr)
-    , m_InStride(inStride)
-    , m_OutStride(outStride)
-    {}
-    ~ConvertRepresentation() = default;
-    
     /**
-     * @brief This is the main conversion routine
-     * @param start Starting index
-     * @param end Ending index
+     * @brief createOutputData Returns the array a conversion writes into: the DestinationData
+     * array if it has the right shape, otherwise a newly allocated array
+     * @param numTuples Number of tuples
+     * @param numComponents Number of components of the output representation
+     * @param name Name of a newly allocated array
+     * @return
      */
-    void convert(size_t start, size_t end) const
-    {
-      Converter conv;
-      T* input = m_InPtr + (start * m_InStride);
-      T* output = m_OutPtr + (start * m_OutStride);
-      for (size_t i = start; i < end; ++i) { 
-        conv(input, output);
-        input = input + m_InStride; /* Increment input pointer */ 
-        output = output + m_OutStride; /* Increment output pointer*/ 
-      }
-    } 
-    
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    void operator()(const tbb::blocked_range<size_t>& r) const
+    typename DataArray<T>::Pointer createOutputData(size_t numTuples, size_t numComponents, const QString& name)
     {
-      convert(r.begin(), r.end());
+      typename DataArray<T>::Pointer output = getDestinationData();
+      if(nullptr != output.get() && output->getNumberOfTuples() == numTuples && static_cast<size_t>(output->getNumberOfComponents()) == numComponents)
+      {
+        return output;
+      }
+      QVector<size_t> cDims = {numComponents};
+      output = DataArray<T>::CreateArray(numTuples, cDims, name);
+      output->initializeWithZeros(); /* Intialize the array with Zeros */
+      return output;
     }
-#endif
     
   private:
-    T* m_InPtr = nullptr;
-    T* m_OutPtr = nullptr;
-    size_t m_InStride = 0;
-    size_t m_OutStride = 0;
+    OrientationConverter(const OrientationConverter&) = delete; // Copy Constructor Not Implemented
+    void operator=(const OrientationConverter&) = delete;       // Move assignment Not Implemented
 };
 
 
 /**
  * @brief OC_CONVERT_BODY Generates the body of method that will perform the conversion
  */
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-
 #define OC_CONVERT_BODY(OUTSTRIDE, OUT_ARRAY_NAME, CONVERSION_METHOD, FUNCTOR)\
   sanityCheckInputData();\
   typename DataArray<T>::Pointer input = this->getInputData();\
@@ -390,34 +287,11 @@ class ConvertRepresentation
   size_t nTuples = this->getInputData()->getNumberOfTuples();\
   int inStride = input->getNumberOfComponents();\
   size_t outStride = OUTSTRIDE;\
-  QVector<size_t> cDims = {outStride};\
-  typename DataArray<T>::Pointer output = DataArray<T>::CreateArray(nTuples, cDims, #OUT_ARRAY_NAME);\
-  output->initializeWithZeros(); /* Intialize the array with Zeros */\
+  typename DataArray<T>::Pointer output = this->createOutputData(nTuples, outStride, #OUT_ARRAY_NAME);\
   T* outPtr = output->getPointer(0);\
-  tbb::task_scheduler_init init;\
-  tbb::parallel_for(tbb::blocked_range<size_t>(0, nTuples),\
-  ConvertRepresentation<T, Convertors::FUNCTOR<T>>(inPtr, outPtr, inStride, outStride), tbb::auto_partitioner());\
+  ConvertOrientationBatch<T, Convertors::FUNCTOR<T>>(inPtr, OrientationMemoryLayout::AoS(inStride), outPtr, OrientationMemoryLayout::AoS(outStride), nTuples);\
   this->setOutputData(output);
 
-#else
-
-#define OC_CONVERT_BODY(OUTSTRIDE, OUT_ARRAY_NAME, CONVERSION_METHOD, FUNCTOR)\
-  sanityCheckInputData();\
-  typename DataArray<T>::Pointer input = this->getInputData();\
-  T* inPtr = input->getPointer(0);\
-  size_t nTuples = this->getInputData()->getNumberOfTuples();\
-  int inStride = input->getNumberOfComponents();\
-  size_t outStride = OUTSTRIDE;\
-  QVector<size_t> cDims = {outStride}; /* Create the n component (nx1) based array.*/\
-  typename DataArray<T>::Pointer output = DataArray<T>::CreateArray(nTuples, cDims, #OUT_ARRAY_NAME);\
-  output->initializeWithZeros(); /* Intialize the array with Zeros */\
-  T* outPtr = output->getPointer(0);\
-  ConvertRepresentation<T, Convertors::FUNCTOR <T>> serial(inPtr, outPtr, inStride, outStride);\
-  serial.convert(0, nTuples);\
-  this->setOutputData(output);
-
-#endif
-
 
 /* =============================================================================
  *
@@ -0,0 +1,285 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <cstring>
+#include <vector>
+
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "OrientationLib/OrientationMath/OrientationArray.hpp"
+#include "OrientationLib/OrientationMath/OrientationBatchTransforms.hpp"
+#include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+
+/**
+ * @brief Runs every batch conversion kernel and requires the results to be bit for bit
+ * identical to the scalar OrientationTransforms methods called on OrientationArray wrappers
+ */
+class OrientationBatchTransformsTest
+{
+public:
+  OrientationBatchTransformsTest()
+  {
+  }
+  virtual ~OrientationBatchTransformsTest()
+  {
+  }
+
+  enum RepresentationIndex
+  {
+    Eu = 0,
+    Om,
+    Qu,
+    Ax,
+    Ro,
+    Ho,
+    Cu
+  };
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+// QFile::remove();
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T, typename ScalarConversion> std::vector<T> ScalarConvert(const std::vector<T>& input, size_t inComps, size_t outComps, ScalarConversion scalar)
+  {
+    typedef OrientationArray<T> OrientationArrayType;
+    size_t numTuples = input.size() / inComps;
+    std::vector<T> output(numTuples * outComps, static_cast<T>(0));
+    std::vector<T> inCopy(input);
+    for(size_t i = 0; i < numTuples; i++)
+    {
+      OrientationArrayType in(inCopy.data() + i * inComps, inComps);
+      OrientationArrayType out(output.data() + i * outComps, outComps);
+      scalar(in, out);
+    }
+    return output;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T> std::vector<T> ToSoA(const std::vector<T>& aos, size_t numComps)
+  {
+    size_t numTuples = aos.size() / numComps;
+    std::vector<T> soa(aos.size());
+    for(size_t i = 0; i < numTuples; i++)
+    {
+      for(size_t c = 0; c < numComps; c++)
+      {
+        soa[c * numTuples + i] = aos[i * numComps + c];
+      }
+    }
+    return soa;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T> bool BitwiseEqual(const std::vector<T>& a, const std::vector<T>& b)
+  {
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), sizeof(T) * a.size()) == 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T, class Converter, typename ScalarConversion> void TestConversion(const std::vector<T>& input, ScalarConversion scalar)
+  {
+    const size_t inComps = Converter::k_InComponents;
+    const size_t outComps = Converter::k_OutComponents;
+    size_t numTuples = input.size() / inComps;
+    std::vector<T> expected = ScalarConvert<T>(input, inComps, outComps, scalar);
+
+    // Interleaved
+    std::vector<T> aos(numTuples * outComps, static_cast<T>(0));
+    ConvertOrientationBatch<T, Converter>(input.data(), aos.data(), numTuples);
+    DREAM3D_REQUIRE(BitwiseEqual(expected, aos))
+
+    // Planar
+    std::vector<T> soaInput = ToSoA(input, inComps);
+    std::vector<T> soa(numTuples * outComps, static_cast<T>(0));
+    ConvertOrientationBatch<T, Converter>(soaInput.data(), OrientationMemoryLayout::SoA(numTuples), soa.data(), OrientationMemoryLayout::SoA(numTuples), numTuples);
+    DREAM3D_REQUIRE(BitwiseEqual(ToSoA(expected, outComps), soa))
+
+    // Interleaved input into a planar output
+    std::vector<T> mixed(numTuples * outComps, static_cast<T>(0));
+    ConvertOrientationBatch<T, Converter>(input.data(), OrientationMemoryLayout::AoS(inComps), mixed.data(), OrientationMemoryLayout::SoA(numTuples), numTuples);
+    DREAM3D_REQUIRE(BitwiseEqual(soa, mixed))
+
+    // In place when both representations have the same number of components
+    if(inComps == outComps)
+    {
+      std::vector<T> inPlace(input);
+      ConvertOrientationBatch<T, Converter>(inPlace.data(), inPlace.data(), numTuples);
+      DREAM3D_REQUIRE(BitwiseEqual(expected, inPlace))
+    }
+  }
+
+/**
+ * @brief Tests one Convertors functor against the OrientationTransforms method it wraps
+ */
+#define OC_TEST_CONVERSION(FUNCTOR, INPUT, CONVERSION_METHOD)                                                                                                                                         \
+  TestConversion<T, Convertors::FUNCTOR<T>>(inputs[INPUT], [](OrientationArrayType& in, OrientationArrayType& out) { OrientationTransformsType::CONVERSION_METHOD(in, out); });
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T> void TestBatchConversions()
+  {
+    typedef OrientationArray<T> OrientationArrayType;
+    typedef OrientationTransforms<OrientationArrayType, T> OrientationTransformsType;
+
+    // A grid of Euler angles that includes the degenerate Phi = 0 and Phi = Pi cases
+    size_t nSteps = 12;
+    std::vector<T> eulers;
+    for(size_t k = 0; k <= nSteps; k++)
+    {
+      for(size_t j = 0; j <= nSteps; j++)
+      {
+        for(size_t i = 0; i <= nSteps; i++)
+        {
+          eulers.push_back(static_cast<T>(SIMPLib::Constants::k_2Pi * i / nSteps));
+          eulers.push_back(static_cast<T>(SIMPLib::Constants::k_Pi * j / nSteps));
+          eulers.push_back(static_cast<T>(SIMPLib::Constants::k_2Pi * k / nSteps));
+        }
+      }
+    }
+
+    std::vector<std::vector<T>> inputs(7);
+    inputs[Eu] = eulers;
+    inputs[Om] = ScalarConvert<T>(eulers, 3, 9, [](OrientationArrayType& in, OrientationArrayType& out) { OrientationTransformsType::eu2om(in, out); });
+    inputs[Qu] = ScalarConvert<T>(eulers, 3, 4, [](OrientationArrayType& in, OrientationArrayType& out) { OrientationTransformsType::eu2qu(in, out); });
+    inputs[Ax] = ScalarConvert<T>(eulers, 3, 4, [](OrientationArrayType& in, OrientationArrayType& out) { OrientationTransformsType::eu2ax(in, out); });
+    inputs[Ro] = ScalarConvert<T>(eulers, 3, 4, [](OrientationArrayType& in, OrientationArrayType& out) { OrientationTransformsType::eu2ro(in, out); });
+    inputs[Ho] = ScalarConvert<T>(eulers, 3, 3, [](OrientationArrayType& in, OrientationArrayType& out) { OrientationTransformsType::eu2ho(in, out); });
+    inputs[Cu] = ScalarConvert<T>(eulers, 3, 3, [](OrientationArrayType& in, OrientationArrayType& out) { OrientationTransformsType::eu2cu(in, out); });
+
+    OC_TEST_CONVERSION(Eu2Om, Eu, eu2om)
+    OC_TEST_CONVERSION(Eu2Qu, Eu, eu2qu)
+    OC_TEST_CONVERSION(Eu2Ax, Eu, eu2ax)
+    OC_TEST_CONVERSION(Eu2Ro, Eu, eu2ro)
+    OC_TEST_CONVERSION(Eu2Ho, Eu, eu2ho)
+    OC_TEST_CONVERSION(Eu2Cu, Eu, eu2cu)
+
+    OC_TEST_CONVERSION(Om2Eu, Om, om2eu)
+    OC_TEST_CONVERSION(Om2Qu, Om, om2qu)
+    OC_TEST_CONVERSION(Om2Ax, Om, om2ax)
+    OC_TEST_CONVERSION(Om2Ro, Om, om2ro)
+    OC_TEST_CONVERSION(Om2Ho, Om, om2ho)
+    OC_TEST_CONVERSION(Om2Cu, Om, om2cu)
+
+    OC_TEST_CONVERSION(Qu2Eu, Qu, qu2eu)
+    OC_TEST_CONVERSION(Qu2Om, Qu, qu2om)
+    OC_TEST_CONVERSION(Qu2Ax, Qu, qu2ax)
+    OC_TEST_CONVERSION(Qu2Ro, Qu, qu2ro)
+    OC_TEST_CONVERSION(Qu2Ho, Qu, qu2ho)
+    OC_TEST_CONVERSION(Qu2Cu, Qu, qu2cu)
+
+    OC_TEST_CONVERSION(Ax2Eu, Ax, ax2eu)
+    OC_TEST_CONVERSION(Ax2Om, Ax, ax2om)
+    OC_TEST_CONVERSION(Ax2Qu, Ax, ax2qu)
+    OC_TEST_CONVERSION(Ax2Ro, Ax, ax2ro)
+    OC_TEST_CONVERSION(Ax2Ho, Ax, ax2ho)
+    OC_TEST_CONVERSION(Ax2Cu, Ax, ax2cu)
+
+    OC_TEST_CONVERSION(Ro2Eu, Ro, ro2eu)
+    OC_TEST_CONVERSION(Ro2Om, Ro, ro2om)
+    OC_TEST_CONVERSION(Ro2Qu, Ro, ro2qu)
+    OC_TEST_CONVERSION(Ro2Ax, Ro, ro2ax)
+    OC_TEST_CONVERSION(Ro2Ho, Ro, ro2ho)
+    OC_TEST_CONVERSION(Ro2Cu, Ro, ro2cu)
+
+    OC_TEST_CONVERSION(Ho2Eu, Ho, ho2eu)
+    OC_TEST_CONVERSION(Ho2Om, Ho, ho2om)
+    OC_TEST_CONVERSION(Ho2Qu, Ho, ho2qu)
+    OC_TEST_CONVERSION(Ho2Ax, Ho, ho2ax)
+    OC_TEST_CONVERSION(Ho2Ro, Ho, ho2ro)
+    OC_TEST_CONVERSION(Ho2Cu, Ho, ho2cu)
+
+    OC_TEST_CONVERSION(Cu2Eu, Cu, cu2eu)
+    OC_TEST_CONVERSION(Cu2Om, Cu, cu2om)
+    OC_TEST_CONVERSION(Cu2Qu, Cu, cu2qu)
+    OC_TEST_CONVERSION(Cu2Ax, Cu, cu2ax)
+    OC_TEST_CONVERSION(Cu2Ro, Cu, cu2ro)
+    OC_TEST_CONVERSION(Cu2Ho, Cu, cu2ho)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestLayoutConversions()
+  {
+    std::vector<float> quats = {0.1f, 0.2f, 0.3f, 0.9f, -0.5f, 0.5f, -0.5f, 0.5f};
+    std::vector<float> reordered(quats.size());
+    ConvertOrientationBatch<float, Convertors::QuVectorScalar2ScalarVector<float>>(quats.data(), reordered.data(), 2);
+    DREAM3D_REQUIRE_EQUAL(reordered[0], 0.9f)
+    DREAM3D_REQUIRE_EQUAL(reordered[1], 0.1f)
+    DREAM3D_REQUIRE_EQUAL(reordered[7], -0.5f)
+    ConvertOrientationBatch<float, Convertors::QuScalarVector2VectorScalar<float>>(reordered.data(), reordered.data(), 2);
+    DREAM3D_REQUIRE(BitwiseEqual(quats, reordered))
+
+    std::vector<float> rodrigues = {0.0f, 3.0f, 4.0f};
+    std::vector<float> ro(4);
+    ConvertOrientationBatch<float, Convertors::Rv2Ro<float>>(rodrigues.data(), ro.data(), 1);
+    DREAM3D_REQUIRE_EQUAL(ro[0], 0.0f)
+    DREAM3D_REQUIRE_EQUAL(ro[1], 0.6f)
+    DREAM3D_REQUIRE_EQUAL(ro[2], 0.8f)
+    DREAM3D_REQUIRE_EQUAL(ro[3], 5.0f)
+  }
+
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestBatchConversions<float>())
+    DREAM3D_REGISTER_TEST(TestBatchConversions<double>())
+    DREAM3D_REGISTER_TEST(TestLayoutConversions())
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+private:
+  OrientationBatchTransformsTest(const OrientationBatchTransformsTest&); // Copy Constructor Not Implemented
+  void operator=(const OrientationBatchTransformsTest&);                 // Move assignment Not Implemented
+};
@@ -75,6 +75,72 @@ public:
     DREAM3D_REQUIRE_EQUAL(333227, orientations.size());
   }
 
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void SO3NeighborhoodTest()
+  {
+    SO3Sampler::Pointer sampler = SO3Sampler::New();
+
+    // Point group 1 keeps every grid point; for m-3m (32) the reference lies inside the cubic
+    // fundamental zone and the larger angle reaches well past its boundary, so the fundamental zone
+    // filter of the neighborhood has points to remove
+    struct NeighborhoodCase
+    {
+      int pgnum;
+      double eulers[3];
+      double angles[2];
+    };
+    const NeighborhoodCase cases[2] = {{1, {0.3, 0.6, 1.1}, {10.0, 160.0}}, {32, {0.1, 0.2, 0.15}, {10.0, 60.0}}};
+
+    for(const NeighborhoodCase& neighborhoodCase : cases)
+    {
+      DOrientArrayType eu(neighborhoodCase.eulers[0], neighborhoodCase.eulers[1], neighborhoodCase.eulers[2]);
+      DOrientArrayType rod(4);
+      DOrientArrayType qu(4);
+      OrientationTransformsType::eu2ro(eu, rod);
+      OrientationTransformsType::eu2qu(eu, qu);
+
+      // The neighborhood must be exactly the points of the full sampling within the angle, in the same order
+      SO3Sampler::OrientationListArrayType all = sampler->SampleRFZ(20, neighborhoodCase.pgnum);
+      for(double angleDeg : neighborhoodCase.angles)
+      {
+        double angle = angleDeg * SIMPLib::Constants::k_PiOver180;
+        SO3Sampler::OrientationListArrayType expected;
+        for(DOrientArrayType& point : all)
+        {
+          DOrientArrayType pointQu(4);
+          OrientationTransformsType::ro2qu(point, pointQu);
+          double cosHalfAngle = std::fabs(pointQu[0] * qu[0] + pointQu[1] * qu[1] + pointQu[2] * qu[2] + pointQu[3] * qu[3]);
+          if(cosHalfAngle >= std::cos(0.5 * angle))
+          {
+            expected.push_back(point);
+          }
+        }
+        DREAM3D_REQUIRE(!expected.empty())
+
+        SO3Sampler::OrientationListArrayType neighborhood = sampler->SampleRFZNeighborhood(20, neighborhoodCase.pgnum, rod, angle);
+        DREAM3D_REQUIRE_EQUAL(expected.size(), neighborhood.size());
+        SO3Sampler::OrientationListArrayType::iterator expectedIter = expected.begin();
+        for(DOrientArrayType& point : neighborhood)
+        {
+          for(size_t c = 0; c < 4; c++)
+          {
+            DREAM3D_REQUIRE_EQUAL(point[c], (*expectedIter)[c]);
+          }
+          ++expectedIter;
+        }
+      }
+    }
+
+    // Without the fundamental zone filter the m-3m neighborhood with the larger angle is larger
+    DOrientArrayType eu(0.1, 0.2, 0.15);
+    DOrientArrayType rod(4);
+    OrientationTransformsType::eu2ro(eu, rod);
+    double angle = 60.0 * SIMPLib::Constants::k_PiOver180;
+    DREAM3D_REQUIRED(sampler->SampleRFZNeighborhood(20, 32, rod, angle).size(), <, sampler->SampleRFZNeighborhood(20, 1, rod, angle).size())
+  }
+
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
@@ -133,6 +199,7 @@ public:
     DREAM3D_REGISTER_TEST(InsideCubicFZTest())
     DREAM3D_REGISTER_TEST(TestPyramid())
     DREAM3D_REGISTER_TEST(SO3CountTest())
+    DREAM3D_REGISTER_TEST(SO3NeighborhoodTest())
     DREAM3D_REGISTER_TEST(RemoveTestFiles())
   }
 
@@ -44,6 +44,8 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "DREAM3DLib/Utilities/FeatureMoments.hpp"
+
 #include "Generic/GenericConstants.h"
 #include "Generic/GenericVersion.h"
 
@@ -154,50 +156,27 @@ void FindFeatureCentroids::find_centroids()
 
   size_t totalFeatures = m_CentroidsPtr.lock()->getNumberOfTuples();
 
-  QVector<size_t> dims(1, 4);
-  FloatArrayType::Pointer m_FeatureCentersPtr = FloatArrayType::CreateArray(totalFeatures, dims, "_INTERNAL_USE_ONLY_Centroids");
-  m_FeatureCentersPtr->initializeWithZeros();
-  float* featurecenters = m_FeatureCentersPtr->getPointer(0);
-
-  size_t xPoints = imageGeom->getXPoints();
-  size_t yPoints = imageGeom->getYPoints();
-  size_t zPoints = imageGeom->getZPoints();
-
+  size_t dims[3] = {imageGeom->getXPoints(), imageGeom->getYPoints(), imageGeom->getZPoints()};
   FloatVec3Type spacing(0.0f, 0.0f, 0.0f);
   imageGeom->getSpacing(spacing);
-  FloatVec3Type origin(0.0f, 0.0f, 0.0f);
-  imageGeom->getOrigin(origin);
 
-  size_t zStride = 0;
-  size_t yStride = 0;
-  for(size_t i = 0; i < zPoints; i++)
-  {
-    zStride = i * xPoints * yPoints;
-    for(size_t j = 0; j < yPoints; j++)
-    {
-      yStride = j * xPoints;
-      for(size_t k = 0; k < xPoints; k++)
-      {
-        int32_t gnum = m_FeatureIds[zStride + yStride + k];
-        featurecenters[gnum * 4 + 0]++;
-        std::array<float, 3> coords = {{0.0f, 0.0f, 0.0f}};
-        imageGeom->getCoords(k, j, i, coords.data());
-        featurecenters[gnum * 4 + 1] = featurecenters[gnum * 4 + 1] + coords[0];
-        featurecenters[gnum * 4 + 2] = featurecenters[gnum * 4 + 2] + coords[1];
-        featurecenters[gnum * 4 + 3] = featurecenters[gnum * 4 + 3] + coords[2];
-      }
-    }
-  }
+  // The centroid is the mean of the cell coordinates, measured from the coordinate of cell (0, 0, 0)
+  std::array<float, 3> firstCoords = {{0.0f, 0.0f, 0.0f}};
+  imageGeom->getCoords(0, 0, 0, firstCoords.data());
+  double origin[3] = {firstCoords[0], firstCoords[1], firstCoords[2]};
+  double cellSpacing[3] = {spacing[0], spacing[1], spacing[2]};
+
+  FeatureMoments moments;
+  moments.compute(m_FeatureIds, totalFeatures, dims, origin, cellSpacing, FeatureMoments::Order::FirstMoments);
+
   for(size_t i = 0; i < totalFeatures; i++)
   {
-    if(featurecenters[i * 4 + 0] > 0.0f)
+    const FeatureMoments::Accumulator& feature = moments.getFeature(i);
+    if(feature.count > 0)
     {
-      featurecenters[i * 4 + 1] = featurecenters[i * 4 + 1] / featurecenters[i * 4 + 0];
-      featurecenters[i * 4 + 2] = featurecenters[i * 4 + 2] / featurecenters[i * 4 + 0];
-      featurecenters[i * 4 + 3] = featurecenters[i * 4 + 3] / featurecenters[i * 4 + 0];
-      m_Centroids[3 * i] = featurecenters[i * 4 + 1];
-      m_Centroids[3 * i + 1] = featurecenters[i * 4 + 2];
-      m_Centroids[3 * i + 2] = featurecenters[i * 4 + 3];
+      m_Centroids[3 * i] = static_cast<float>(feature.mean[0]);
+      m_Centroids[3 * i + 1] = static_cast<float>(feature.mean[1]);
+      m_Centroids[3 * i + 2] = static_cast<float>(feature.mean[2]);
     }
   }
 }
@@ -48,6 +48,8 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Utilities/TimeUtilities.h"
 
+#include "DREAM3DLib/Utilities/ParallelTextWriter.hpp"
+
 #include "ImportExport/ImportExportConstants.h"
 #include "ImportExport/ImportExportVersion.h"
 
@@ -293,11 +295,6 @@ int32_t AbaqusHexahedronWriter::writeNodes(const QList<QString>& fileNames, size
   size_t pDims[3] = {cDims[0] + 1, cDims[1] + 1, cDims[2] + 1};
   size_t nodeIndex = 1;
   size_t totalPoints = pDims[0] * pDims[1] * pDims[2];
-  size_t increment = static_cast<size_t>(totalPoints * 0.01f);
-  if(increment == 0) // check to prevent divide by 0
-  {
-    increment = 1;
-  }
 
   int32_t err = 0;
   FILE* f = nullptr;
@@ -310,38 +307,45 @@ int32_t AbaqusHexahedronWriter::writeNodes(const QList<QString>& fileNames, size
   fprintf(f, "** Generated by : %s\n", ImportExport::Version::PackageComplete().toLatin1().data());
   fprintf(f, "** ----------------------------------------------------------------\n**\n*Node\n");
 
-  for(size_t z = 0; z < pDims[2]; z++)
-  {
-    for(size_t y = 0; y < pDims[1]; y++)
+  // Each row is one line of nodes along x
+  auto formatRow = [&](size_t row, TextBuffer& out) {
+    size_t y = row % pDims[1];
+    size_t z = row / pDims[1];
+    size_t index = row * pDims[0] + 1;
+    for(size_t x = 0; x < pDims[0]; x++)
     {
-      for(size_t x = 0; x < pDims[0]; x++)
-      {
-        float xCoord = origin[0] + (x * spacing[0]);
-        float yCoord = origin[1] + (y * spacing[1]);
-        float zCoord = origin[2] + (z * spacing[2]);
-        fprintf(f, "%llu, %f, %f, %f\n", static_cast<unsigned long long int>(nodeIndex), xCoord, yCoord, zCoord);
-        if(nodeIndex % increment == 0)
-        {
-          currentMillis = QDateTime::currentMSecsSinceEpoch();
-          if(currentMillis - millis > 1000)
-          {
-            buf.clear();
-            ss << "Writing Nodes (File 1/5) " << static_cast<int>((float)(nodeIndex) / (float)(totalPoints)*100) << "% Completed ";
-            timeDiff = ((float)nodeIndex / (float)(currentMillis - startMillis));
-            estimatedTime = (float)(totalPoints - nodeIndex) / timeDiff;
-            ss << " || Est. Time Remain: " << DREAM3D::convertMillisToHrsMinSecs(estimatedTime);
-            notifyStatusMessage(buf);
-            millis = QDateTime::currentMSecsSinceEpoch();
-            if(getCancel()) // Filter has been cancelled
-            {
-              fclose(f);
-              return 1;
-            }
-          }
-        }
-        ++nodeIndex;
-      }
+      float xCoord = origin[0] + (x * spacing[0]);
+      float yCoord = origin[1] + (y * spacing[1]);
+      float zCoord = origin[2] + (z * spacing[2]);
+      out.appendUInt(index + x).append(", ").appendFixed(xCoord).append(", ").appendFixed(yCoord).append(", ").appendFixed(zCoord).append('\n');
+    }
+  };
+  bool canceled = false;
+  auto sink = [&](const TextBuffer& buffer, size_t rowsDone) {
+    if(!ParallelTextWriter::WriteToFile(f, buffer))
+    {
+      err = -1;
+      return false;
+    }
+    nodeIndex = rowsDone * pDims[0];
+    currentMillis = QDateTime::currentMSecsSinceEpoch();
+    if(currentMillis - millis > 1000)
+    {
+      buf.clear();
+      ss << "Writing Nodes (File 1/5) " << static_cast<int>((float)(nodeIndex) / (float)(totalPoints)*100) << "% Completed ";
+      timeDiff = ((float)nodeIndex / (float)(currentMillis - startMillis));
+      estimatedTime = (float)(totalPoints - nodeIndex) / timeDiff;
+      ss << " || Est. Time Remain: " << DREAM3D::convertMillisToHrsMinSecs(estimatedTime);
+      notifyStatusMessage(buf);
+      millis = QDateTime::currentMSecsSinceEpoch();
+      canceled = getCancel();
     }
+    return !canceled;
+  };
+  if(!ParallelTextWriter::WriteRows(pDims[1] * pDims[2], formatRow, sink))
+  {
+    fclose(f);
+    return canceled ? 1 : err;
   }
 
   // Write the last node, which is a dummy node used for stress - strain curves.
@@ -367,11 +371,6 @@ int32_t AbaqusHexahedronWriter::writeElems(const QList<QString>& fileNames, size
   QString buf;
   QTextStream ss(&buf);
   size_t totalPoints = cDims[0] * cDims[1] * cDims[2];
-  size_t increment = static_cast<size_t>(totalPoints * 0.01f);
-  if(increment == 0) // check to prevent divide by 0
-  {
-    increment = 1;
-  }
 
   int32_t err = 0;
   FILE* f = nullptr;
@@ -381,43 +380,52 @@ int32_t AbaqusHexahedronWriter::writeElems(const QList<QString>& fileNames, size
     return -1;
   }
 
-  // Get a typedef to shorten up the printf codes
-  typedef long long int _lli_t_;
-
   size_t index = 1;
   fprintf(f, "** Generated by : %s\n", ImportExport::Version::PackageComplete().toLatin1().data());
   fprintf(f, "** ----------------------------------------------------------------\n**\n*Element, type=C3D8\n");
-  for(size_t z = 0; z < cDims[2]; z++)
-  {
-    for(size_t y = 0; y < cDims[1]; y++)
+  // Each row is one line of elements along x
+  auto formatRow = [&](size_t row, TextBuffer& out) {
+    size_t y = row % cDims[1];
+    size_t z = row / cDims[1];
+    size_t elementIndex = row * cDims[0] + 1;
+    int64_t nodeId[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    for(size_t x = 0; x < cDims[0]; x++)
     {
-      for(size_t x = 0; x < cDims[0]; x++)
+      getNodeIds(x, y, z, pDims, nodeId);
+      out.appendUInt(elementIndex + x);
+      for(size_t n : {5, 1, 0, 4, 7, 3, 2, 6})
       {
-        std::vector<int64_t> nodeId = getNodeIds(x, y, z, pDims);
-        fprintf(f, "%llu, %lld, %lld, %lld, %lld, %lld, %lld, %lld, %lld\n", (_lli_t_)index, (_lli_t_)nodeId[5], (_lli_t_)nodeId[1], (_lli_t_)nodeId[0], (_lli_t_)nodeId[4], (_lli_t_)nodeId[7],
-                (_lli_t_)nodeId[3], (_lli_t_)nodeId[2], (_lli_t_)nodeId[6]);
-        if(index % increment == 0)
-        {
-          currentMillis = QDateTime::currentMSecsSinceEpoch();
-          if(currentMillis - millis > 1000)
-          {
-            buf.clear();
-            ss << "Writing Elements (File 2/5) " << static_cast<int>((float)(index) / (float)(totalPoints)*100) << "% Completed ";
-            timeDiff = ((float)index / (float)(currentMillis - startMillis));
-            estimatedTime = (float)(totalPoints - index) / timeDiff;
-            ss << " || Est. Time Remain: " << DREAM3D::convertMillisToHrsMinSecs(estimatedTime);
-            notifyStatusMessage(buf);
-            millis = QDateTime::currentMSecsSinceEpoch();
-            if(getCancel()) // Filter has been cancelled
-            {
-              fclose(f);
-              return 1;
-            }
-          }
-        }
-        ++index;
+        out.append(", ").appendInt(nodeId[n]);
       }
+      out.append('\n');
+    }
+  };
+  bool canceled = false;
+  auto sink = [&](const TextBuffer& buffer, size_t rowsDone) {
+    if(!ParallelTextWriter::WriteToFile(f, buffer))
+    {
+      err = -1;
+      return false;
     }
+    index = rowsDone * cDims[0];
+    currentMillis = QDateTime::currentMSecsSinceEpoch();
+    if(currentMillis - millis > 1000)
+    {
+      buf.clear();
+      ss << "Writing Elements (File 2/5) " << static_cast<int>((float)(index) / (float)(totalPoints)*100) << "% Completed ";
+      timeDiff = ((float)index / (float)(currentMillis - startMillis));
+      estimatedTime = (float)(totalPoints - index) / timeDiff;
+      ss << " || Est. Time Remain: " << DREAM3D::convertMillisToHrsMinSecs(estimatedTime);
+      notifyStatusMessage(buf);
+      millis = QDateTime::currentMSecsSinceEpoch();
+      canceled = getCancel();
+    }
+    return !canceled;
+  };
+  if(!ParallelTextWriter::WriteRows(cDims[1] * cDims[2], formatRow, sink))
+  {
+    fclose(f);
+    return canceled ? 1 : err;
   }
 
   fprintf(f, "**\n** ----------------------------------------------------------------\n**\n");
@@ -466,57 +474,72 @@ int32_t AbaqusHexahedronWriter::writeElset(const QList<QString>& fileNames, size
     }
   }
 
-  int32_t increment = static_cast<int32_t>(maxGrainId * 0.1f);
-  if(increment == 0) // check to prevent divide by 0
+  // Bucket the elements of every Grain once, in increasing element order, instead of scanning
+  // the whole volume for each Grain
+  std::vector<size_t> grainStart(static_cast<size_t>(maxGrainId) + 2, 0);
+  for(size_t i = 0; i < totalPoints; i++)
   {
-    increment = 1;
+    if(m_FeatureIds[i] > 0)
+    {
+      grainStart[m_FeatureIds[i] + 1]++;
+    }
   }
-
-  int32_t voxelId = 1;
-  while(voxelId <= maxGrainId)
+  for(size_t g = 1; g < grainStart.size(); g++)
   {
-    size_t elementPerLine = 0;
-    fprintf(f, "\n*Elset, elset=Grain%d_set\n", voxelId);
-
-    for(size_t i = 0; i < totalPoints + 1; i++)
+    grainStart[g] += grainStart[g - 1];
+  }
+  std::vector<size_t> grainElements(grainStart.back());
+  {
+    std::vector<size_t> fill(grainStart.begin(), grainStart.end() - 1);
+    for(size_t i = 0; i < totalPoints; i++)
     {
-      if(m_FeatureIds[i] == voxelId)
+      if(m_FeatureIds[i] > 0)
       {
-        if(elementPerLine != 0) // no comma at start
-        {
-          if((elementPerLine % 16) != 0u) // 16 per line
-          {
-            fprintf(f, ", ");
-          }
-          else
-          {
-            fprintf(f, ",\n");
-          }
-        }
-        fprintf(f, "%llu", static_cast<unsigned long long int>(i + 1));
-        elementPerLine++;
+        grainElements[fill[m_FeatureIds[i]]++] = i;
       }
     }
-    if(voxelId % increment == 0)
+  }
+
+  // Each row is the element set of Grain row + 1
+  auto formatRow = [&](size_t row, TextBuffer& out) {
+    size_t grain = row + 1;
+    out.append("\n*Elset, elset=Grain").appendInt(static_cast<int32_t>(grain)).append("_set\n");
+    for(size_t e = grainStart[grain]; e < grainStart[grain + 1]; e++)
     {
-      currentMillis = QDateTime::currentMSecsSinceEpoch();
-      if(currentMillis - millis > 1000)
+      size_t elementPerLine = e - grainStart[grain];
+      if(elementPerLine != 0) // no comma at start
       {
-        buf.clear();
-        ss << "Writing Element Sets (File 4/5) " << static_cast<int>((float)(voxelId) / (float)(maxGrainId)*100) << "% Completed ";
-        timeDiff = ((float)voxelId / (float)(currentMillis - startMillis));
-        estimatedTime = (float)(maxGrainId - voxelId) / timeDiff;
-        ss << " || Est. Time Remain: " << DREAM3D::convertMillisToHrsMinSecs(estimatedTime);
-        notifyStatusMessage(buf);
-        millis = QDateTime::currentMSecsSinceEpoch();
-        if(getCancel()) // Filter has been cancelled
-        {
-          fclose(f);
-          return 1;
-        }
+        out.append((elementPerLine % 16) != 0u ? ", " : ",\n"); // 16 per line
       }
+      out.appendUInt(grainElements[e] + 1);
+    }
+  };
+  bool canceled = false;
+  auto sink = [&](const TextBuffer& buffer, size_t rowsDone) {
+    if(!ParallelTextWriter::WriteToFile(f, buffer))
+    {
+      err = -1;
+      return false;
     }
-    voxelId++;
+    int32_t voxelId = static_cast<int32_t>(rowsDone);
+    currentMillis = QDateTime::currentMSecsSinceEpoch();
+    if(currentMillis - millis > 1000)
+    {
+      buf.clear();
+      ss << "Writing Element Sets (File 4/5) " << static_cast<int>((float)(voxelId) / (float)(maxGrainId)*100) << "% Completed ";
+      timeDiff = ((float)voxelId / (float)(currentMillis - startMillis));
+      estimatedTime = (float)(maxGrainId - voxelId) / timeDiff;
+      ss << " || Est. Time Remain: " << DREAM3D::convertMillisToHrsMinSecs(estimatedTime);
+      notifyStatusMessage(buf);
+      millis = QDateTime::currentMSecsSinceEpoch();
+      canceled = getCancel();
+    }
+    return !canceled;
+  };
+  if(!ParallelTextWriter::WriteRows(static_cast<size_t>(maxGrainId), formatRow, sink, 64))
+  {
+    fclose(f);
+    return canceled ? 1 : err;
   }
   fprintf(f, "\n**\n** ----------------------------------------------------------------\n**\n");
 
@@ -603,10 +626,8 @@ int32_t AbaqusHexahedronWriter::writeSects(const QString& file, size_t totalPoin
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-std::vector<int64_t> AbaqusHexahedronWriter::getNodeIds(size_t x, size_t y, size_t z, size_t* pDims)
+void AbaqusHexahedronWriter::getNodeIds(size_t x, size_t y, size_t z, const size_t* pDims, int64_t* nodeId) const
 {
-  std::vector<int64_t> nodeId(8, 0);
-
   nodeId[0] = static_cast<int64_t>(1 + (pDims[0] * pDims[1] * z) + (pDims[0] * y) + x);
   nodeId[1] = static_cast<int64_t>(1 + (pDims[0] * pDims[1] * z) + (pDims[0] * y) + (x + 1));
   nodeId[2] = static_cast<int64_t>(1 + (pDims[0] * pDims[1] * z) + (pDims[0] * (y + 1)) + x);
@@ -630,7 +651,6 @@ std::vector<int64_t> AbaqusHexahedronWriter::getNodeIds(size_t x, size_t y, size
     printf("         | /        |/     \n");
     printf("        %lld--------%lld     \n", static_cast<long long int>(nodeId[2]), static_cast<long long int>(nodeId[3]));
   }
-  return nodeId;
 }
 
 // -----------------------------------------------------------------------------
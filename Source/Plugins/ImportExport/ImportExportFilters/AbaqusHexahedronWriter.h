@@ -223,15 +223,15 @@ private:
   int32_t writeMaster(const QString& file);
 
   /**
-   * @brief getNodeIds Returns a vector of node Ids for a given
+   * @brief getNodeIds Computes the 8 node Ids for a given
    * set of dimensional indices
    * @param x X coordinate
    * @param y Y coordinate
    * @param z Z coordinate
    * @param pDims Dimensions of incoming volume
-   * @return  Vector of node Ids
+   * @param nodeId Receives the 8 node Ids
    */
-  std::vector<int64_t> getNodeIds(size_t x, size_t y, size_t z, size_t* pDims);
+  void getNodeIds(size_t x, size_t y, size_t z, const size_t* pDims, int64_t* nodeId) const;
 
   /**
    * @brief deleteFile Removes written files
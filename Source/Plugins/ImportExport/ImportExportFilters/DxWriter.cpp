@@ -46,6 +46,8 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Utilities/FileSystemPathHelper.h"
 
+#include "DREAM3DLib/Utilities/ParallelTextWriter.hpp"
+
 #include "ImportExport/ImportExportConstants.h"
 #include "ImportExport/ImportExportVersion.h"
 
@@ -270,55 +272,57 @@ int32_t DxWriter::writeFile()
     }
   }
 
-  int64_t index = 0;
-  for(int64_t x = 0; x < dims[0]; ++x)
-  {
+  // Each row is one line of voxels along z, for one (x, y) pair
+  auto formatRow = [&](size_t row, TextBuffer& buffer) {
+    int64_t x = static_cast<int64_t>(row) / dims[1];
+    int64_t y = static_cast<int64_t>(row) % dims[1];
     // Add a leading surface Row for this plane if needed
-    if(m_AddSurfaceLayer)
+    if(m_AddSurfaceLayer && y == 0)
     {
       for(int64_t i = 0; i < fileXDim; ++i)
       {
-        out << "-4 ";
+        buffer.append("-4 ");
       }
-      out << "\n";
+      buffer.append('\n');
     }
-    for(int64_t y = 0; y < dims[1]; ++y)
+    // write leading surface voxel for this row
+    if(m_AddSurfaceLayer)
     {
-      // write leading surface voxel for this row
-      if(m_AddSurfaceLayer)
-      {
-        out << "-5 ";
-      }
-      // Write the actual voxel data
-      for(int64_t z = 0; z < dims[2]; ++z)
-      {
-        index = (z * dims[0] * dims[1]) + (dims[0] * y) + x;
-        if(m_FeatureIds[index] == 0)
-        {
-          out << "0"
-              << " ";
-        }
-        else
-        {
-          out << m_FeatureIds[index] << " ";
-        }
-      }
-      // write trailing surface voxel for this row
-      if(m_AddSurfaceLayer)
-      {
-        out << "-6 ";
-      }
-      out << "\n";
+      buffer.append("-5 ");
     }
-    // Add a trailing surface Row for this plane if needed
+    // Write the actual voxel data
+    for(int64_t z = 0; z < dims[2]; ++z)
+    {
+      int64_t index = (z * dims[0] * dims[1]) + (dims[0] * y) + x;
+      buffer.appendInt(m_FeatureIds[index]).append(' ');
+    }
+    // write trailing surface voxel for this row
     if(m_AddSurfaceLayer)
+    {
+      buffer.append("-6 ");
+    }
+    buffer.append('\n');
+    // Add a trailing surface Row for this plane if needed
+    if(m_AddSurfaceLayer && y == dims[1] - 1)
     {
       for(int64_t i = 0; i < fileXDim; ++i)
       {
-        out << "-7 ";
+        buffer.append("-7 ");
       }
-      out << "\n";
+      buffer.append('\n');
     }
+  };
+  out.flush();
+  auto sink = [&](const TextBuffer& buffer, size_t) { return file.write(buffer.data(), static_cast<qint64>(buffer.size())) == static_cast<qint64>(buffer.size()) && !getCancel(); };
+  if(!ParallelTextWriter::WriteRows(static_cast<size_t>(dims[0] * dims[1]), formatRow, sink))
+  {
+    file.close();
+    if(!getCancel())
+    {
+      QString ss = QObject::tr("Error writing output file '%1'").arg(getOutputFile());
+      setErrorCondition(-101, ss);
+    }
+    return getErrorCode();
   }
 
   // Add a complete layer of surface voxels
@@ -46,6 +46,8 @@
 #include "SIMPLib/Utilities/FileSystemPathHelper.h"
 #include "SIMPLib/Utilities/SIMPLibEndian.h"
 
+#include "DREAM3DLib/Utilities/ParallelTextWriter.hpp"
+
 #include "ImportExport/ImportExportConstants.h"
 #include "ImportExport/ImportExportVersion.h"
 
@@ -226,10 +228,22 @@ void LammpsFileWriter::execute()
   fprintf(lammpsFile, "\n");
 
   // Write the Atom positions (Vertices)
-  for(int64_t i = 0; i < numAtoms; i++)
+  auto formatRow = [&](size_t i, TextBuffer& buffer) {
+    float* coords = vertices->getVertexPointer(static_cast<int64_t>(i));
+    buffer.appendInt(static_cast<int64_t>(i)).append(' ').appendInt(atomType).append(' ');
+    buffer.appendFixed(coords[0]).append(' ').appendFixed(coords[1]).append(' ').appendFixed(coords[2]).append(' ');
+    buffer.appendInt(dummy).append(' ').appendInt(dummy).append(' ').appendInt(dummy).append('\n');
+  };
+  auto sink = [&](const TextBuffer& buffer, size_t) { return ParallelTextWriter::WriteToFile(lammpsFile, buffer) && !getCancel(); };
+  if(!ParallelTextWriter::WriteRows(static_cast<size_t>(numAtoms), formatRow, sink, 65536))
   {
-    vertices->getCoords(i, pos);
-    fprintf(lammpsFile, "%lld %d %f %f %f %d %d %d\n", (long long int)(i), atomType, pos[0], pos[1], pos[2], dummy, dummy, dummy); // Write the positions to the output file
+    fclose(lammpsFile);
+    if(!getCancel())
+    {
+      QString ss = QObject::tr(": Error writing LAMMPS output file '%1'").arg(getLammpsFile());
+      setErrorCondition(-11001, ss);
+    }
+    return;
   }
 
   fprintf(lammpsFile, "\n");
@@ -46,6 +46,8 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Utilities/FileSystemPathHelper.h"
 
+#include "DREAM3DLib/Utilities/ParallelTextWriter.hpp"
+
 #include "ImportExport/ImportExportConstants.h"
 #include "ImportExport/ImportExportVersion.h"
 
@@ -222,11 +224,19 @@ int32_t PhWriter::writeFile()
   outfile << "\'DREAM3\'              52.00  1.000  1.0       " << features << "\n";
   outfile << " 0.000 0.000 0.000          0        \n"; // << features << endl;
 
-  for(size_t k = 0; k < totalpoints; k++)
+  auto formatRow = [&](size_t k, TextBuffer& text) { text.appendInt(m_FeatureIds[k]).append('\n'); };
+  auto sink = [&](const TextBuffer& text, size_t) {
+    outfile.write(text.data(), static_cast<std::streamsize>(text.size()));
+    return outfile.good() && !getCancel();
+  };
+  bool written = ParallelTextWriter::WriteRows(totalpoints, formatRow, sink, 65536);
+  outfile.close();
+  if(!written && !getCancel())
   {
-    outfile << m_FeatureIds[k] << '\n';
+    QString ss = QObject::tr("Error writing output file '%1'").arg(getOutputFile());
+    setErrorCondition(-101, ss);
+    return getErrorCode();
   }
-  outfile.close();
 
   // If there is an error set this to something negative and also set a message
   notifyStatusMessage("Writing Ph File Complete");
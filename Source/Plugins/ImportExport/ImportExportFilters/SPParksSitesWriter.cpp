@@ -48,6 +48,8 @@
 #include "SIMPLib/Utilities/FileSystemPathHelper.h"
 #include "SIMPLib/Utilities/TimeUtilities.h"
 
+#include "DREAM3DLib/Utilities/ParallelTextWriter.hpp"
+
 #include "ImportExport/ImportExportConstants.h"
 #include "ImportExport/ImportExportVersion.h"
 
@@ -218,39 +220,31 @@ int32_t SPParksSitesWriter::writeFile()
   qint64 estimatedTime = 0;
   float timeDiff = 0.0f;
 
-  int64_t increment = static_cast<int64_t>(totalpoints * 0.01f);
-  size_t count = 0;
   QString buf;
   QTextStream ss(&buf);
-  // Buffer the output with 4096 Bytes which is typically the size of a "Block" on a
-  // modern Hard Drive. This should speed up the writes considerably
-  char buffer[4096];
-  outfile.rdbuf()->pubsetbuf(buffer, 4096);
-  for(size_t k = 0; k < totalpoints; k++)
-  {
-    if(count % increment == 0)
+  auto formatRow = [&](size_t k, TextBuffer& buffer) { buffer.appendUInt(k + 1).append(' ').appendInt(m_FeatureIds[k]).append('\n'); };
+  auto sink = [&](const TextBuffer& buffer, size_t k) {
+    outfile.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    currentMillis = QDateTime::currentMSecsSinceEpoch();
+    if(currentMillis - millis > 1000)
     {
-      currentMillis = QDateTime::currentMSecsSinceEpoch();
-      if(currentMillis - millis > 1000)
-      {
-        buf.clear();
-        ss << static_cast<int>((float)(k) / (float)(totalpoints)*100) << " % Completed ";
-        timeDiff = ((float)k / (float)(currentMillis - startMillis));
-        estimatedTime = (float)(totalpoints - k) / timeDiff;
-        ss << " || Est. Time Remain: " << DREAM3D::convertMillisToHrsMinSecs(estimatedTime);
-        notifyStatusMessage(buf);
-        millis = QDateTime::currentMSecsSinceEpoch();
-      }
+      buf.clear();
+      ss << static_cast<int>((float)(k) / (float)(totalpoints)*100) << " % Completed ";
+      timeDiff = ((float)k / (float)(currentMillis - startMillis));
+      estimatedTime = (float)(totalpoints - k) / timeDiff;
+      ss << " || Est. Time Remain: " << DREAM3D::convertMillisToHrsMinSecs(estimatedTime);
+      notifyStatusMessage(buf);
+      millis = QDateTime::currentMSecsSinceEpoch();
     }
-    count++;
-    //    double temp0 = 0.0;
-    //    double temp1 = 0.0;
-    outfile << k + 1 << " "
-            << m_FeatureIds[k]
-            /* << " " << temp0 << " " << temp1 */
-            << "\n";
-  }
+    return outfile.good() && !getCancel();
+  };
+  bool written = ParallelTextWriter::WriteRows(totalpoints, formatRow, sink, 65536);
   outfile.close();
+  if(!written && !getCancel())
+  {
+    setErrorCondition(-101, QObject::tr("Error writing output file '%1'").arg(getOutputFile()));
+    return getErrorCode();
+  }
 
 
   return 0;
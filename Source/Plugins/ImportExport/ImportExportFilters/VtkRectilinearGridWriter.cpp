@@ -44,6 +44,7 @@
 #include "SIMPLib/Common/TemplateHelpers.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
+#include "SIMPLib/FilterParameters/ChoiceFilterParameter.h"
 #include "SIMPLib/FilterParameters/MultiDataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/OutputFileFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
@@ -52,6 +53,7 @@
 
 #include "ImportExport/ImportExportConstants.h"
 #include "ImportExport/ImportExportVersion.h"
+#include "ImportExport/ImportExportFilters/util/ChunkedBinaryWriter.hpp"
 
 #define LD_CAST(arg) static_cast<long int>(arg)
 namespace Detail
@@ -170,19 +172,16 @@ template <typename T> void WriteDataArray(AbstractFilter* filter, FILE* f, IData
     fprintf(f, "LOOKUP_TABLE default\n");
     if(writeBinary)
     {
-      if(BIGENDIAN == 0)
-      {
-        array->byteSwapElements();
-      }
-      size_t totalWritten = fwrite(val, array->getTypeSize(), totalElements, f);
-      if(totalWritten != totalElements)
+      // Legacy VTK files are big endian. The values are swapped chunk by chunk into a staging
+      // buffer, so the array itself is never modified while it is written.
+      ChunkedBinaryWriter writer(f);
+      if(!writer.writeBigEndian(val, totalElements))
       {
+        QString ss = QObject::tr("Error writing the binary values of array '%1'").arg(array->getName());
+        filter->setErrorCondition(-2031003, ss);
+        return;
       }
       fprintf(f, "\n");
-      if(BIGENDIAN == 0)
-      {
-        array->byteSwapElements();
-      }
     }
     else
     {
@@ -207,6 +206,175 @@ template <typename T> void WriteDataArray(AbstractFilter* filter, FILE* f, IData
     }
   }
 }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString XmlTypeForArray(const IDataArray::Pointer& array)
+{
+  QString type = array->getTypeAsString();
+  if(type == SIMPL::TypeNames::Int8)
+  {
+    return "Int8";
+  }
+  if(type == SIMPL::TypeNames::UInt8 || type == SIMPL::TypeNames::Bool)
+  {
+    return "UInt8";
+  }
+  if(type == SIMPL::TypeNames::Int16)
+  {
+    return "Int16";
+  }
+  if(type == SIMPL::TypeNames::UInt16)
+  {
+    return "UInt16";
+  }
+  if(type == SIMPL::TypeNames::Int32)
+  {
+    return "Int32";
+  }
+  if(type == SIMPL::TypeNames::UInt32)
+  {
+    return "UInt32";
+  }
+  if(type == SIMPL::TypeNames::Int64)
+  {
+    return "Int64";
+  }
+  if(type == SIMPL::TypeNames::UInt64)
+  {
+    return "UInt64";
+  }
+  if(type == SIMPL::TypeNames::Float)
+  {
+    return "Float32";
+  }
+  if(type == SIMPL::TypeNames::Double)
+  {
+    return "Float64";
+  }
+  return QString();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString XmlEscape(const QString& value)
+{
+  QString escaped = value;
+  escaped.replace("&", "&amp;");
+  escaped.replace("<", "&lt;");
+  escaped.replace(">", "&gt;");
+  escaped.replace("\"", "&quot;");
+  return escaped;
+}
+
+/**
+ * @brief WriteVTKXmlFile Writes the arrays as Cell data of a VTK XML Image Data (.vti) or
+ * Rectilinear Grid (.vtr) file. All values are stored as raw appended data in the byte order of
+ * this machine, which the header announces, so nothing has to be swapped or encoded.
+ * @param filter Filter that receives errors
+ * @param f The "C" FILE* pointer to the file being written to.
+ * @param arrays Cell arrays to write
+ * @param dims Number of Cells along x, y and z
+ * @param coordOrigin Coordinate of the first grid point
+ * @param res Cell spacing
+ * @param rectilinear Whether to write a Rectilinear Grid instead of Image Data
+ * @return 0 on success, a negative value on error
+ */
+int WriteVTKXmlFile(AbstractFilter* filter, FILE* f, const QVector<IDataArray::Pointer>& arrays, const size_t dims[3], const float coordOrigin[3], const FloatVec3Type& res, bool rectilinear)
+{
+  using OffsetType = uint64_t;
+  const char* gridType = rectilinear ? "RectilinearGrid" : "ImageData";
+  QString extent = QString("0 %1 0 %2 0 %3").arg(dims[0]).arg(dims[1]).arg(dims[2]);
+
+  fprintf(f, "<?xml version=\"1.0\"?>\n");
+  fprintf(f, "<!-- Data set from %s -->\n", ImportExport::Version::PackageComplete().toLatin1().constData());
+  fprintf(f, "<VTKFile type=\"%s\" version=\"1.0\" byte_order=\"%s\" header_type=\"UInt64\">\n", gridType, (BIGENDIAN == 0) ? "LittleEndian" : "BigEndian");
+  if(rectilinear)
+  {
+    fprintf(f, "  <RectilinearGrid WholeExtent=\"%s\">\n", extent.toLatin1().constData());
+  }
+  else
+  {
+    fprintf(f, "  <ImageData WholeExtent=\"%s\" Origin=\"%.9g %.9g %.9g\" Spacing=\"%.9g %.9g %.9g\">\n", extent.toLatin1().constData(), coordOrigin[0], coordOrigin[1], coordOrigin[2], res[0],
+            res[1], res[2]);
+  }
+  fprintf(f, "    <Piece Extent=\"%s\">\n", extent.toLatin1().constData());
+
+  // Each appended block is its byte count followed by the raw values
+  OffsetType offset = 0;
+  fprintf(f, "      <CellData>\n");
+  for(const auto& array : arrays)
+  {
+    QString xmlType = XmlTypeForArray(array);
+    if(xmlType.isEmpty())
+    {
+      QString ss = QObject::tr("The array '%1' of type '%2' can not be written to a VTK XML file").arg(array->getName()).arg(array->getTypeAsString());
+      filter->setErrorCondition(-2031004, ss);
+      return -1;
+    }
+    fprintf(f, "        <DataArray type=\"%s\" Name=\"%s\" NumberOfComponents=\"%d\" format=\"appended\" offset=\"%llu\"/>\n", xmlType.toLatin1().constData(),
+            XmlEscape(array->getName()).toUtf8().constData(), array->getNumberOfComponents(), static_cast<unsigned long long>(offset));
+    offset += sizeof(OffsetType) + static_cast<OffsetType>(array->getSize()) * array->getTypeSize();
+  }
+  fprintf(f, "      </CellData>\n");
+
+  std::vector<float> coords[3];
+  if(rectilinear)
+  {
+    const char* names[3] = {"x_coordinates", "y_coordinates", "z_coordinates"};
+    fprintf(f, "      <Coordinates>\n");
+    for(size_t d = 0; d < 3; d++)
+    {
+      coords[d].resize(dims[d] + 1);
+      for(size_t idx = 0; idx <= dims[d]; idx++)
+      {
+        coords[d][idx] = coordOrigin[d] + idx * res[d];
+      }
+      fprintf(f, "        <DataArray type=\"Float32\" Name=\"%s\" NumberOfComponents=\"1\" format=\"appended\" offset=\"%llu\"/>\n", names[d], static_cast<unsigned long long>(offset));
+      offset += sizeof(OffsetType) + coords[d].size() * sizeof(float);
+    }
+    fprintf(f, "      </Coordinates>\n");
+  }
+  fprintf(f, "    </Piece>\n");
+  fprintf(f, "  </%s>\n", gridType);
+  fprintf(f, "  <AppendedData encoding=\"raw\">\n   _");
+
+  ChunkedBinaryWriter writer(f);
+  for(const auto& array : arrays)
+  {
+    if(filter->getCancel())
+    {
+      return 0;
+    }
+    QString ss = QObject::tr("Writing Cell Data %1").arg(array->getName());
+    filter->notifyStatusMessage(ss);
+    OffsetType numBytes = static_cast<OffsetType>(array->getSize()) * array->getTypeSize();
+    if(!writer.writeNative(&numBytes, 1) || !writer.writeNative(static_cast<const uint8_t*>(array->getVoidPointer(0)), static_cast<size_t>(numBytes)))
+    {
+      ss = QObject::tr("Error writing the values of array '%1'").arg(array->getName());
+      filter->setErrorCondition(-2031003, ss);
+      return -1;
+    }
+  }
+  for(const auto& coord : coords)
+  {
+    if(coord.empty())
+    {
+      continue;
+    }
+    OffsetType numBytes = coord.size() * sizeof(float);
+    if(!writer.writeNative(&numBytes, 1) || !writer.writeNative(coord.data(), coord.size()))
+    {
+      filter->setErrorCondition(-2031002, "Error writing the grid coordinates");
+      return -1;
+    }
+  }
+  fprintf(f, "\n  </AppendedData>\n");
+  fprintf(f, "</VTKFile>\n");
+  return 0;
+}
 } // namespace Detail
 
 // -----------------------------------------------------------------------------
@@ -215,6 +383,7 @@ template <typename T> void WriteDataArray(AbstractFilter* filter, FILE* f, IData
 VtkRectilinearGridWriter::VtkRectilinearGridWriter()
 : m_OutputFile("")
 , m_WriteBinaryFile(false)
+, m_OutputFormat(0)
 {
 }
 
@@ -230,7 +399,14 @@ void VtkRectilinearGridWriter::setupFilterParameters()
 {
   FilterParameterVectorType parameters;
 
-  parameters.push_back(SIMPL_NEW_OUTPUT_FILE_FP("Output File", OutputFile, FilterParameter::Parameter, VtkRectilinearGridWriter, "*.vtk", "VTK Rectilinear Grid"));
+  parameters.push_back(SIMPL_NEW_OUTPUT_FILE_FP("Output File", OutputFile, FilterParameter::Parameter, VtkRectilinearGridWriter, "*.vtk *.vti *.vtr", "VTK Rectilinear Grid"));
+  {
+    QVector<QString> choices;
+    choices.push_back("Legacy VTK (.vtk)");
+    choices.push_back("VTK XML Image Data (.vti)");
+    choices.push_back("VTK XML Rectilinear Grid (.vtr)");
+    parameters.push_back(SIMPL_NEW_CHOICE_FP("Output Format", OutputFormat, FilterParameter::Parameter, VtkRectilinearGridWriter, choices, false));
+  }
   parameters.push_back(SIMPL_NEW_BOOL_FP("Write Binary File", WriteBinaryFile, FilterParameter::Parameter, VtkRectilinearGridWriter));
 
   {
@@ -248,6 +424,7 @@ void VtkRectilinearGridWriter::readFilterParameters(AbstractFilterParametersRead
   setOutputFile(reader->readString("OutputFile", getOutputFile()));
   setSelectedDataArrayPaths(reader->readDataArrayPathVector("SelectedDataArrayPaths", getSelectedDataArrayPaths()));
   setWriteBinaryFile(reader->readValue("WriteBinaryFile", false));
+  setOutputFormat(reader->readValue("OutputFormat", getOutputFormat()));
   reader->closeFilterGroup();
 }
 
@@ -278,6 +455,12 @@ void VtkRectilinearGridWriter::dataCheck()
     setErrorCondition(-1012, ss);
   }
 
+  if(getOutputFormat() < 0 || getOutputFormat() > 2)
+  {
+    QString ss = QObject::tr("The selected output format is not valid");
+    setErrorCondition(-1013, ss);
+  }
+
   if(m_SelectedDataArrayPaths.isEmpty())
   {
     QString ss = QObject::tr("At least one Attribute Array must be selected");
@@ -371,6 +554,18 @@ void VtkRectilinearGridWriter::execute()
     return;
   }
 
+  if(getOutputFormat() != 0)
+  {
+    QVector<IDataArray::Pointer> arrays;
+    foreach(const DataArrayPath arrayPath, getSelectedDataArrayPaths())
+    {
+      arrays.push_back(getDataContainerArray()->getPrereqIDataArrayFromPath<IDataArray, AbstractFilter>(this, arrayPath));
+    }
+    float coordOrigin[3] = {origin[0] - res[0] * 0.5f, origin[1] - res[1] * 0.5f, origin[2] - res[2] * 0.5f};
+    Detail::WriteVTKXmlFile(this, f, arrays, dims, coordOrigin, res, getOutputFormat() == 2);
+    return;
+  }
+
   // write the header
   Detail::WriteVTKHeader<ImageGeom>(f, m, getWriteBinaryFile());
 
@@ -389,7 +584,7 @@ void VtkRectilinearGridWriter::execute()
     setErrorCondition(-2031002, ss);
     return;
   }
-  err = Detail::WriteCoords<float>(f, "Z_COORDINATES", "float", dims[2] + 1, origin[0] - res[2] * 0.5f, (float)(dims[2] + 1 * res[2]), res[2], m_WriteBinaryFile);
+  err = Detail::WriteCoords<float>(f, "Z_COORDINATES", "float", dims[2] + 1, origin[2] - res[2] * 0.5f, (float)(dims[2] + 1 * res[2]), res[2], m_WriteBinaryFile);
   if(err < 0)
   {
     QString ss = QObject::tr("Error writing Z Coordinates in vtk file %s'\n ").arg(m_OutputFile);
@@ -406,6 +601,10 @@ void VtkRectilinearGridWriter::execute()
     IDataArray::Pointer iDataPtr = getDataContainerArray()->getPrereqIDataArrayFromPath<IDataArray, AbstractFilter>(this, arrayPath);
 
     EXECUTE_FUNCTION_TEMPLATE(this, Detail::WriteDataArray, iDataPtr, this, f, iDataPtr, m_WriteBinaryFile);
+    if(getErrorCode() < 0)
+    {
+      return;
+    }
 
 #if 0
     QString className = iDataPtr->getNameOfClass();
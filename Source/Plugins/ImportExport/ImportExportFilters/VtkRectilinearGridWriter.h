@@ -65,6 +65,7 @@ class ImportExport_EXPORT VtkRectilinearGridWriter : public AbstractFilter
   PYB11_CREATE_BINDINGS(VtkRectilinearGridWriter SUPERCLASS AbstractFilter)
   PYB11_PROPERTY(QString OutputFile READ getOutputFile WRITE setOutputFile)
   PYB11_PROPERTY(bool WriteBinaryFile READ getWriteBinaryFile WRITE setWriteBinaryFile)
+  PYB11_PROPERTY(int OutputFormat READ getOutputFormat WRITE setOutputFormat)
   PYB11_PROPERTY(QVector<DataArrayPath> SelectedDataArrayPaths READ getSelectedDataArrayPaths WRITE setSelectedDataArrayPaths)
 public:
   SIMPL_SHARED_POINTERS(VtkRectilinearGridWriter)
@@ -79,6 +80,9 @@ public:
   SIMPL_FILTER_PARAMETER(bool, WriteBinaryFile)
   Q_PROPERTY(bool WriteBinaryFile READ getWriteBinaryFile WRITE setWriteBinaryFile)
 
+  SIMPL_FILTER_PARAMETER(int, OutputFormat)
+  Q_PROPERTY(int OutputFormat READ getOutputFormat WRITE setOutputFormat)
+
   SIMPL_FILTER_PARAMETER(QVector<DataArrayPath>, SelectedDataArrayPaths)
   Q_PROPERTY(QVector<DataArrayPath> SelectedDataArrayPaths READ getSelectedDataArrayPaths WRITE setSelectedDataArrayPaths)
 
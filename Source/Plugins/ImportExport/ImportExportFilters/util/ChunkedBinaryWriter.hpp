@@ -0,0 +1,184 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+
+/**
+ * @brief The ChunkedBinaryWriter class writes large arrays to an open FILE* through two fixed
+ * size staging buffers. The calling thread converts the next chunk into one buffer while a
+ * writer thread hands the other one to fwrite, so the conversion overlaps with the I/O. The
+ * source array is only read, and the memory used is bounded by two chunks whatever the size of
+ * the array. Every write call returns only once all of its bytes have been handed to the
+ * FILE*, so the caller is free to fprintf to the same file in between calls.
+ */
+class ChunkedBinaryWriter
+{
+public:
+  static const size_t k_DefaultChunkBytes = 4 * 1024 * 1024;
+
+  explicit ChunkedBinaryWriter(FILE* f, size_t chunkBytes = k_DefaultChunkBytes)
+  : m_File(f)
+  , m_ChunkBytes(std::max(chunkBytes, size_t(1)))
+  {
+  }
+  virtual ~ChunkedBinaryWriter() = default;
+
+  /**
+   * @brief writeBigEndian Writes count values in big endian byte order
+   * @param data Values to write
+   * @param count Number of values
+   * @return true if every byte was written
+   */
+  template <typename T> bool writeBigEndian(const T* data, size_t count)
+  {
+    if(BIGENDIAN != 0 || sizeof(T) == 1)
+    {
+      return writeNative(data, count);
+    }
+    return writeConverted(data, count, [](const T* src, size_t n, T* dst) {
+      for(size_t i = 0; i < n; i++)
+      {
+        T value = src[i];
+        SIMPLib::Endian::FromSystemToBig::convert(value);
+        dst[i] = value;
+      }
+    });
+  }
+
+  /**
+   * @brief writeNative Writes count values in the byte order of this machine. No staging is
+   * needed, so the values are written straight from the source array.
+   * @param data Values to write
+   * @param count Number of values
+   * @return true if every byte was written
+   */
+  template <typename T> bool writeNative(const T* data, size_t count)
+  {
+    return fwrite(data, sizeof(T), count, m_File) == count;
+  }
+
+protected:
+  /**
+   * @brief writeConverted Runs convert(src, n, dst) over consecutive chunks of data and writes
+   * the converted chunks on a writer thread, double buffered
+   */
+  template <typename T, typename Convert> bool writeConverted(const T* data, size_t count, Convert convert)
+  {
+    size_t chunkSize = std::max(m_ChunkBytes / sizeof(T), size_t(1));
+    if(count <= chunkSize)
+    {
+      // A single chunk has nothing to overlap with
+      std::vector<T> buffer(count);
+      convert(data, count, buffer.data());
+      return writeNative(buffer.data(), count);
+    }
+
+    std::vector<T> buffers[2] = {std::vector<T>(chunkSize), std::vector<T>(chunkSize)};
+    size_t pending[2] = {0, 0};
+    bool done = false;
+    bool failed = false;
+    std::mutex mutex;
+    std::condition_variable cv;
+
+    std::thread writer([&]() {
+      size_t b = 0;
+      std::unique_lock<std::mutex> lock(mutex);
+      while(true)
+      {
+        cv.wait(lock, [&]() { return pending[b] > 0 || done; });
+        if(pending[b] == 0)
+        {
+          break;
+        }
+        size_t n = pending[b];
+        lock.unlock();
+        bool ok = fwrite(buffers[b].data(), sizeof(T), n, m_File) == n;
+        lock.lock();
+        failed = failed || !ok;
+        pending[b] = 0;
+        cv.notify_all();
+        b ^= 1;
+      }
+    });
+
+    size_t b = 0;
+    for(size_t start = 0; start < count; start += chunkSize)
+    {
+      size_t n = std::min(chunkSize, count - start);
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&]() { return pending[b] == 0; });
+        if(failed)
+        {
+          break;
+        }
+      }
+      convert(data + start, n, buffers[b].data());
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending[b] = n;
+      }
+      cv.notify_all();
+      b ^= 1;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      done = true;
+    }
+    cv.notify_all();
+    writer.join();
+    return !failed;
+  }
+
+private:
+  FILE* m_File;
+  size_t m_ChunkBytes;
+
+public:
+  ChunkedBinaryWriter(const ChunkedBinaryWriter&) = delete;            // Copy Constructor Not Implemented
+  ChunkedBinaryWriter(ChunkedBinaryWriter&&) = delete;                 // Move Constructor Not Implemented
+  ChunkedBinaryWriter& operator=(const ChunkedBinaryWriter&) = delete; // Copy Assignment Not Implemented
+  ChunkedBinaryWriter& operator=(ChunkedBinaryWriter&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,171 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cstdio>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "ImportExport/ImportExportFilters/util/ChunkedBinaryWriter.hpp"
+
+#include "ImportExportTestFileLocations.h"
+
+class ChunkedBinaryWriterTest
+{
+public:
+  ChunkedBinaryWriterTest() = default;
+  ~ChunkedBinaryWriterTest() = default;
+
+  SIMPL_TYPE_MACRO(ChunkedBinaryWriterTest)
+  ChunkedBinaryWriterTest(const ChunkedBinaryWriterTest&) = delete;            // Copy Constructor Not Implemented
+  ChunkedBinaryWriterTest(ChunkedBinaryWriterTest&&) = delete;                 // Move Constructor Not Implemented
+  ChunkedBinaryWriterTest& operator=(const ChunkedBinaryWriterTest&) = delete; // Copy Assignment Not Implemented
+  ChunkedBinaryWriterTest& operator=(ChunkedBinaryWriterTest&&) = delete;      // Move Assignment Not Implemented
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+    QFile::remove(UnitTest::ChunkedBinaryWriterTest::ReferenceFile);
+    QFile::remove(UnitTest::ChunkedBinaryWriterTest::ChunkedFile);
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  QByteArray readFile(const QString& filePath)
+  {
+    QFile file(filePath);
+    if(!file.open(QIODevice::ReadOnly))
+    {
+      return QByteArray();
+    }
+    return file.readAll();
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T> typename DataArray<T>::Pointer createArray(size_t numTuples, int numComps)
+  {
+    QVector<size_t> cDims(1, static_cast<size_t>(numComps));
+    typename DataArray<T>::Pointer data = DataArray<T>::CreateArray(numTuples, cDims, "Data");
+    for(size_t i = 0; i < data->getSize(); i++)
+    {
+      data->setValue(i, static_cast<T>(i * 2654435761u + 12345u));
+    }
+    return data;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Writes the array the way VtkRectilinearGridWriter did before it streamed its output:
+  // byte swap the whole array in place, write it with one fwrite and swap it back. The
+  // chunked writer must produce the same file without modifying the array.
+  // -----------------------------------------------------------------------------
+  template <typename T> int TestMatchesInPlaceSwap(size_t numTuples, int numComps, size_t chunkBytes)
+  {
+    typename DataArray<T>::Pointer data = createArray<T>(numTuples, numComps);
+    typename DataArray<T>::Pointer original = std::dynamic_pointer_cast<DataArray<T>>(data->deepCopy());
+    size_t totalElements = data->getSize();
+
+    FILE* f = fopen(UnitTest::ChunkedBinaryWriterTest::ReferenceFile.toLatin1().data(), "wb");
+    DREAM3D_REQUIRE_VALID_POINTER(f)
+    fprintf(f, "LOOKUP_TABLE default\n");
+    if(BIGENDIAN == 0)
+    {
+      data->byteSwapElements();
+    }
+    size_t totalWritten = fwrite(data->getPointer(0), data->getTypeSize(), totalElements, f);
+    DREAM3D_REQUIRE_EQUAL(totalWritten, totalElements)
+    fprintf(f, "\n");
+    if(BIGENDIAN == 0)
+    {
+      data->byteSwapElements();
+    }
+    fclose(f);
+
+    f = fopen(UnitTest::ChunkedBinaryWriterTest::ChunkedFile.toLatin1().data(), "wb");
+    DREAM3D_REQUIRE_VALID_POINTER(f)
+    fprintf(f, "LOOKUP_TABLE default\n");
+    ChunkedBinaryWriter writer(f, chunkBytes);
+    bool written = writer.writeBigEndian(data->getPointer(0), totalElements);
+    DREAM3D_REQUIRE_EQUAL(written, true)
+    fprintf(f, "\n");
+    fclose(f);
+
+    QByteArray reference = readFile(UnitTest::ChunkedBinaryWriterTest::ReferenceFile);
+    QByteArray chunked = readFile(UnitTest::ChunkedBinaryWriterTest::ChunkedFile);
+    DREAM3D_REQUIRE_EQUAL(reference.size(), chunked.size())
+    DREAM3D_REQUIRE(reference == chunked)
+
+    // The source array is only read
+    for(size_t i = 0; i < totalElements; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(data->getValue(i), original->getValue(i))
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "---- " << getNameOfClass().toStdString() << " ----" << std::endl;
+
+    // Chunks smaller than the array exercise the double buffered writer thread, the default
+    // chunk size exercises the single chunk path
+    DREAM3D_REGISTER_TEST(TestMatchesInPlaceSwap<float>(100003, 1, 4096))
+    DREAM3D_REGISTER_TEST(TestMatchesInPlaceSwap<float>(100003, 3, ChunkedBinaryWriter::k_DefaultChunkBytes))
+    DREAM3D_REGISTER_TEST(TestMatchesInPlaceSwap<double>(50001, 2, 1000))
+    DREAM3D_REGISTER_TEST(TestMatchesInPlaceSwap<int32_t>(70001, 1, 12))
+    DREAM3D_REGISTER_TEST(TestMatchesInPlaceSwap<int16_t>(9, 1, 4))
+    DREAM3D_REGISTER_TEST(TestMatchesInPlaceSwap<uint8_t>(30011, 4, 1024))
+    DREAM3D_REGISTER_TEST(TestMatchesInPlaceSwap<int64_t>(1, 1, 8))
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+};
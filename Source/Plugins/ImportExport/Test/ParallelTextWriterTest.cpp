@@ -0,0 +1,312 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "DREAM3DLib/Utilities/ParallelTextWriter.hpp"
+
+#include "ImportExportTestFileLocations.h"
+
+/**
+ * @brief The CompareFixedImpl class formats a range of blocks of test floats with
+ * TextBuffer::appendFixed and with snprintf("%f") and counts the mismatches of each block.
+ * Odd samples are arbitrary bit patterns, so every exponent (and subnormals, infinities and
+ * NaNs) is covered; even samples are uniform in [-1000, 1000), where exported values live.
+ */
+class CompareFixedImpl
+{
+public:
+  CompareFixedImpl(size_t samplesPerBlock, std::vector<size_t>& mismatches)
+  : m_SamplesPerBlock(samplesPerBlock)
+  , m_Mismatches(mismatches)
+  {
+  }
+  virtual ~CompareFixedImpl() = default;
+
+  static float Sample(size_t i)
+  {
+    uint64_t x = (i + 1) * 0x9E3779B97F4A7C15ULL;
+    x ^= x >> 29;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 32;
+    uint32_t bits = static_cast<uint32_t>(x);
+    float value = 0.0f;
+    if(i % 2 == 1)
+    {
+      std::memcpy(&value, &bits, sizeof(value));
+    }
+    else
+    {
+      value = static_cast<float>((static_cast<double>(bits) / 4294967296.0 - 0.5) * 2000.0);
+    }
+    return value;
+  }
+
+  void convert(size_t start, size_t end) const
+  {
+    TextBuffer buffer;
+    char text[64];
+    for(size_t b = start; b < end; b++)
+    {
+      size_t mismatches = 0;
+      for(size_t i = b * m_SamplesPerBlock; i < (b + 1) * m_SamplesPerBlock; i++)
+      {
+        float value = Sample(i);
+        buffer.clear();
+        buffer.appendFixed(value);
+        int count = snprintf(text, sizeof(text), "%f", static_cast<double>(value));
+        if(count < 0 || buffer.size() != static_cast<size_t>(count) || std::memcmp(buffer.data(), text, buffer.size()) != 0)
+        {
+          mismatches++;
+        }
+      }
+      m_Mismatches[b] = mismatches;
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  size_t m_SamplesPerBlock;
+  std::vector<size_t>& m_Mismatches;
+};
+
+class ParallelTextWriterTest
+{
+public:
+  ParallelTextWriterTest() = default;
+  ~ParallelTextWriterTest() = default;
+
+  SIMPL_TYPE_MACRO(ParallelTextWriterTest)
+  ParallelTextWriterTest(const ParallelTextWriterTest&) = delete;            // Copy Constructor Not Implemented
+  ParallelTextWriterTest(ParallelTextWriterTest&&) = delete;                 // Move Constructor Not Implemented
+  ParallelTextWriterTest& operator=(const ParallelTextWriterTest&) = delete; // Copy Assignment Not Implemented
+  ParallelTextWriterTest& operator=(ParallelTextWriterTest&&) = delete;      // Move Assignment Not Implemented
+
+  // -----------------------------------------------------------------------------
+  // The ASCII writers must keep producing byte identical files, so appendFixed has to
+  // reproduce "%f" exactly. This compares the two on half a million random floats and on
+  // a list of edge cases.
+  // -----------------------------------------------------------------------------
+  int TestAppendFixedMatchesPrintf()
+  {
+    const size_t numBlocks = 100;
+    const size_t samplesPerBlock = 5000;
+    std::vector<size_t> mismatches(numBlocks, 0);
+    CompareFixedImpl body(samplesPerBlock, mismatches);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    tbb::task_scheduler_init init;
+    bool doParallel = true;
+    if(doParallel)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numBlocks), body, tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      body.convert(0, numBlocks);
+    }
+
+    size_t totalMismatches = 0;
+    for(size_t count : mismatches)
+    {
+      totalMismatches += count;
+    }
+    DREAM3D_REQUIRE_EQUAL(totalMismatches, 0)
+
+    // Values that sit on rounding boundaries and at the ends of the fast path. The multiples of
+    // 2^-7 are exact ties at the sixth decimal, which round half to even.
+    const float specials[] = {0.0f,
+                              -0.0f,
+                              0.5f,
+                              1.0e-6f,
+                              5.0e-7f,
+                              4.9999999e-7f,
+                              -2.5e-7f,
+                              0.0000015f,
+                              0.0000025f,
+                              0.0078125f,
+                              -0.0078125f,
+                              0.0234375f,
+                              1.0078125f,
+                              1000.0078125f,
+                              9.9999999e-7f,
+                              0.99999994f,
+                              0.9999995f,
+                              9.9999995f,
+                              99999.99f,
+                              999999.94f,
+                              1.0e6f,
+                              1.0e7f,
+                              123456.789f,
+                              65535.99f,
+                              65536.0f,
+                              8388608.5f,
+                              16777216.0f,
+                              2147483648.0f,
+                              4.2949673e9f,
+                              1.0e10f,
+                              -1.0e10f,
+                              3.4028235e38f,
+                              1.17549435e-38f,
+                              1.0e-40f,
+                              1.4e-45f,
+                              -std::numeric_limits<float>::denorm_min(),
+                              std::numeric_limits<float>::infinity(),
+                              -std::numeric_limits<float>::infinity(),
+                              std::numeric_limits<float>::quiet_NaN(),
+                              -std::numeric_limits<float>::quiet_NaN()};
+    TextBuffer buffer;
+    char text[64];
+    for(float value : specials)
+    {
+      buffer.clear();
+      buffer.appendFixed(value);
+      int count = snprintf(text, sizeof(text), "%f", static_cast<double>(value));
+      DREAM3D_REQUIRE_EQUAL(buffer.size(), static_cast<size_t>(count))
+      DREAM3D_REQUIRE(std::memcmp(buffer.data(), text, buffer.size()) == 0)
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestAppendIntMatchesPrintf()
+  {
+    const int64_t values[] = {0, 1, -1, 9, 10, -10, 99999, 2147483647LL, -2147483647LL - 1, std::numeric_limits<int64_t>::max(), std::numeric_limits<int64_t>::min()};
+    TextBuffer buffer;
+    char text[64];
+    for(int64_t value : values)
+    {
+      buffer.clear();
+      buffer.appendInt(value);
+      int count = snprintf(text, sizeof(text), "%lld", static_cast<long long>(value));
+      DREAM3D_REQUIRE_EQUAL(buffer.size(), static_cast<size_t>(count))
+      DREAM3D_REQUIRE(std::memcmp(buffer.data(), text, buffer.size()) == 0)
+    }
+
+    buffer.clear();
+    buffer.appendUInt(std::numeric_limits<uint64_t>::max());
+    int count = snprintf(text, sizeof(text), "%llu", static_cast<unsigned long long>(std::numeric_limits<uint64_t>::max()));
+    DREAM3D_REQUIRE_EQUAL(buffer.size(), static_cast<size_t>(count))
+    DREAM3D_REQUIRE(std::memcmp(buffer.data(), text, buffer.size()) == 0)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Rows formatted in parallel chunks must reach the sink in row order, and a sink that
+  // returns false must stop the writing
+  // -----------------------------------------------------------------------------
+  int TestWriteRowsOrder()
+  {
+    const size_t numRows = 100003;
+    auto formatRow = [](size_t row, TextBuffer& buffer) {
+      buffer.appendUInt(row).append(' ').appendFixed(static_cast<float>(row) * 0.25f).append('\n');
+    };
+
+    std::string expected;
+    {
+      TextBuffer buffer;
+      for(size_t row = 0; row < numRows; row++)
+      {
+        formatRow(row, buffer);
+      }
+      expected.assign(buffer.data(), buffer.size());
+    }
+
+    for(size_t rowsPerChunk : {size_t(1), size_t(7), size_t(4096), numRows + 1})
+    {
+      std::string written;
+      size_t lastRowsDone = 0;
+      bool inOrder = true;
+      bool completed = ParallelTextWriter::WriteRows(numRows, formatRow,
+                                                     [&](const TextBuffer& buffer, size_t rowsDone) {
+                                                       inOrder = inOrder && rowsDone > lastRowsDone;
+                                                       lastRowsDone = rowsDone;
+                                                       written.append(buffer.data(), buffer.size());
+                                                       return true;
+                                                     },
+                                                     rowsPerChunk);
+      DREAM3D_REQUIRE_EQUAL(completed, true)
+      DREAM3D_REQUIRE_EQUAL(inOrder, true)
+      DREAM3D_REQUIRE_EQUAL(lastRowsDone, numRows)
+      DREAM3D_REQUIRE(written == expected)
+    }
+
+    size_t numSinkCalls = 0;
+    bool completed = ParallelTextWriter::WriteRows(numRows, formatRow,
+                                                   [&](const TextBuffer&, size_t) {
+                                                     numSinkCalls++;
+                                                     return numSinkCalls < 3;
+                                                   },
+                                                   100);
+    DREAM3D_REQUIRE_EQUAL(completed, false)
+    DREAM3D_REQUIRE_EQUAL(numSinkCalls, 3)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "---- " << getNameOfClass().toStdString() << " ----" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestAppendIntMatchesPrintf())
+    DREAM3D_REGISTER_TEST(TestAppendFixedMatchesPrintf())
+    DREAM3D_REGISTER_TEST(TestWriteRowsOrder())
+  }
+};
@@ -0,0 +1,292 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cstring>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+#include <QtCore/QRegularExpression>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "ImportExportTestFileLocations.h"
+
+class VtkRectilinearGridWriterTest
+{
+public:
+  VtkRectilinearGridWriterTest() = default;
+  ~VtkRectilinearGridWriterTest() = default;
+
+  SIMPL_TYPE_MACRO(VtkRectilinearGridWriterTest)
+  VtkRectilinearGridWriterTest(const VtkRectilinearGridWriterTest&) = delete;            // Copy Constructor Not Implemented
+  VtkRectilinearGridWriterTest(VtkRectilinearGridWriterTest&&) = delete;                 // Move Constructor Not Implemented
+  VtkRectilinearGridWriterTest& operator=(const VtkRectilinearGridWriterTest&) = delete; // Copy Assignment Not Implemented
+  VtkRectilinearGridWriterTest& operator=(VtkRectilinearGridWriterTest&&) = delete;      // Move Assignment Not Implemented
+
+  const size_t k_Dims[3] = {3, 4, 2};
+  const float k_Origin[3] = {1.0f, 2.0f, 3.0f};
+  const float k_Spacing[3] = {0.5f, 1.0f, 2.0f};
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+    QFile::remove(UnitTest::VtkRectilinearGridWriterTest::ImageDataFile);
+    QFile::remove(UnitTest::VtkRectilinearGridWriterTest::RectilinearGridFile);
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the VtkRectilinearGridWriter Filter from the FilterManager
+    QString filtName = "VtkRectilinearGridWriter";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The VtkRectilinearGridWriterTest Requires the use of the " << filtName.toStdString() << " filter which is found in the ImportExport Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createDataContainerArray()
+  {
+    size_t totalPoints = k_Dims[0] * k_Dims[1] * k_Dims[2];
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+    QVector<size_t> tDims = {k_Dims[0], k_Dims[1], k_Dims[2]};
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image->setDimensions(tDims.data());
+    image->setOrigin(FloatVec3Type(k_Origin[0], k_Origin[1], k_Origin[2]));
+    image->setSpacing(FloatVec3Type(k_Spacing[0], k_Spacing[1], k_Spacing[2]));
+    dc->setGeometry(image);
+
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAttrMat);
+
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(totalPoints, QVector<size_t>(1, 1), SIMPL::CellData::FeatureIds);
+    FloatArrayType::Pointer vectors = FloatArrayType::CreateArray(totalPoints, QVector<size_t>(1, 3), "Vectors<3>");
+    BoolArrayType::Pointer mask = BoolArrayType::CreateArray(totalPoints, QVector<size_t>(1, 1), SIMPL::CellData::Mask);
+    for(size_t i = 0; i < totalPoints; i++)
+    {
+      featureIds->setValue(i, static_cast<int32_t>(i * 7919 % 101) - 50);
+      vectors->setComponent(i, 0, static_cast<float>(i) * 0.25f);
+      vectors->setComponent(i, 1, -static_cast<float>(i) / 3.0f);
+      vectors->setComponent(i, 2, 1.0e6f + static_cast<float>(i));
+      mask->setValue(i, i % 3 == 0);
+    }
+    cellAttrMat->insertOrAssign(featureIds);
+    cellAttrMat->insertOrAssign(vectors);
+    cellAttrMat->insertOrAssign(mask);
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  QByteArray readFile(const QString& filePath)
+  {
+    QFile file(filePath);
+    if(!file.open(QIODevice::ReadOnly))
+    {
+      return QByteArray();
+    }
+    return file.readAll();
+  }
+
+  // -----------------------------------------------------------------------------
+  // Appends one block of appended data: the byte count as a UInt64 followed by the raw values
+  // -----------------------------------------------------------------------------
+  void appendBlock(QByteArray& payload, QVector<uint64_t>& offsets, const void* data, uint64_t numBytes)
+  {
+    offsets.push_back(static_cast<uint64_t>(payload.size()));
+    payload.append(reinterpret_cast<const char*>(&numBytes), sizeof(numBytes));
+    payload.append(static_cast<const char*>(data), static_cast<int>(numBytes));
+  }
+
+  // -----------------------------------------------------------------------------
+  // Writes the cell arrays in the given format (1 = Image Data, 2 = Rectilinear Grid) and checks
+  // the XML header, the offset of every appended block and every payload byte
+  // -----------------------------------------------------------------------------
+  int TestWriteVTKXml(int outputFormat, const QString& outputFile)
+  {
+    DataContainerArray::Pointer dca = createDataContainerArray();
+    AttributeMatrix::Pointer cellAttrMat = dca->getDataContainer(SIMPL::Defaults::ImageDataContainerName)->getAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName);
+    QVector<IDataArray::Pointer> arrays = {cellAttrMat->getAttributeArray(SIMPL::CellData::FeatureIds), cellAttrMat->getAttributeArray("Vectors<3>"),
+                                           cellAttrMat->getAttributeArray(SIMPL::CellData::Mask)};
+
+    QString filtName = "VtkRectilinearGridWriter";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    DREAM3D_REQUIRE(filterFactory.get() != nullptr)
+    AbstractFilter::Pointer filter = filterFactory->create();
+    filter->setDataContainerArray(dca);
+
+    QVariant var;
+    var.setValue(outputFile);
+    bool propWasSet = filter->setProperty("OutputFile", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(outputFormat);
+    propWasSet = filter->setProperty("OutputFormat", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    QVector<DataArrayPath> paths;
+    for(const auto& array : arrays)
+    {
+      paths.push_back(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, array->getName()));
+    }
+    var.setValue(paths);
+    propWasSet = filter->setProperty("SelectedDataArrayPaths", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0)
+
+    // Build the expected appended data; the grid points sit half a cell below the cell centers
+    bool rectilinear = (outputFormat == 2);
+    QByteArray payload;
+    QVector<uint64_t> offsets;
+    for(const auto& array : arrays)
+    {
+      appendBlock(payload, offsets, array->getVoidPointer(0), static_cast<uint64_t>(array->getSize()) * array->getTypeSize());
+    }
+    float coordOrigin[3] = {k_Origin[0] - k_Spacing[0] * 0.5f, k_Origin[1] - k_Spacing[1] * 0.5f, k_Origin[2] - k_Spacing[2] * 0.5f};
+    if(rectilinear)
+    {
+      for(size_t d = 0; d < 3; d++)
+      {
+        std::vector<float> coords(k_Dims[d] + 1);
+        for(size_t idx = 0; idx <= k_Dims[d]; idx++)
+        {
+          coords[idx] = coordOrigin[d] + idx * k_Spacing[d];
+        }
+        appendBlock(payload, offsets, coords.data(), coords.size() * sizeof(float));
+      }
+    }
+
+    QString gridType = rectilinear ? "RectilinearGrid" : "ImageData";
+    QString extent = QString("0 %1 0 %2 0 %3").arg(k_Dims[0]).arg(k_Dims[1]).arg(k_Dims[2]);
+    QString header;
+    header += QString("<VTKFile type=\"%1\" version=\"1.0\" byte_order=\"%2\" header_type=\"UInt64\">\n").arg(gridType).arg((BIGENDIAN == 0) ? "LittleEndian" : "BigEndian");
+    if(rectilinear)
+    {
+      header += QString("  <RectilinearGrid WholeExtent=\"%1\">\n").arg(extent);
+    }
+    else
+    {
+      header += QString("  <ImageData WholeExtent=\"%1\" Origin=\"0.75 1.5 2\" Spacing=\"0.5 1 2\">\n").arg(extent);
+    }
+    header += QString("    <Piece Extent=\"%1\">\n").arg(extent);
+    header += "      <CellData>\n";
+    header += QString("        <DataArray type=\"Int32\" Name=\"FeatureIds\" NumberOfComponents=\"1\" format=\"appended\" offset=\"%1\"/>\n").arg(offsets[0]);
+    header += QString("        <DataArray type=\"Float32\" Name=\"Vectors&lt;3&gt;\" NumberOfComponents=\"3\" format=\"appended\" offset=\"%1\"/>\n").arg(offsets[1]);
+    header += QString("        <DataArray type=\"UInt8\" Name=\"Mask\" NumberOfComponents=\"1\" format=\"appended\" offset=\"%1\"/>\n").arg(offsets[2]);
+    header += "      </CellData>\n";
+    if(rectilinear)
+    {
+      header += "      <Coordinates>\n";
+      header += QString("        <DataArray type=\"Float32\" Name=\"x_coordinates\" NumberOfComponents=\"1\" format=\"appended\" offset=\"%1\"/>\n").arg(offsets[3]);
+      header += QString("        <DataArray type=\"Float32\" Name=\"y_coordinates\" NumberOfComponents=\"1\" format=\"appended\" offset=\"%1\"/>\n").arg(offsets[4]);
+      header += QString("        <DataArray type=\"Float32\" Name=\"z_coordinates\" NumberOfComponents=\"1\" format=\"appended\" offset=\"%1\"/>\n").arg(offsets[5]);
+      header += "      </Coordinates>\n";
+    }
+    header += "    </Piece>\n";
+    header += QString("  </%1>\n").arg(gridType);
+    header += "  <AppendedData encoding=\"raw\">\n   _";
+
+    QByteArray contents = readFile(outputFile);
+    DREAM3D_REQUIRE(contents.startsWith("<?xml version=\"1.0\"?>\n<!-- Data set from "))
+    int headerStart = contents.indexOf("<VTKFile ");
+    DREAM3D_REQUIRE(headerStart > 0)
+    QByteArray expectedHeader = header.toLatin1();
+    DREAM3D_REQUIRE(contents.mid(headerStart, expectedHeader.size()) == expectedHeader)
+
+    // Every offset in the header must point at a block whose byte count matches its array
+    int dataStart = headerStart + expectedHeader.size();
+    QRegularExpression offsetExpr("offset=\"(\\d+)\"");
+    QRegularExpressionMatchIterator iter = offsetExpr.globalMatch(QString::fromLatin1(expectedHeader));
+    int numOffsets = 0;
+    while(iter.hasNext())
+    {
+      uint64_t offset = iter.next().captured(1).toULongLong();
+      uint64_t numBytes = 0;
+      DREAM3D_REQUIRE(dataStart + offset + sizeof(numBytes) <= static_cast<uint64_t>(contents.size()))
+      std::memcpy(&numBytes, contents.constData() + dataStart + offset, sizeof(numBytes));
+      uint64_t expectedBytes = 0;
+      std::memcpy(&expectedBytes, payload.constData() + offsets[numOffsets], sizeof(expectedBytes));
+      DREAM3D_REQUIRE_EQUAL(numBytes, expectedBytes)
+      numOffsets++;
+    }
+    DREAM3D_REQUIRE_EQUAL(numOffsets, offsets.size())
+
+    DREAM3D_REQUIRE(contents.mid(dataStart, payload.size()) == payload)
+    DREAM3D_REQUIRE(contents.mid(dataStart + payload.size()) == QByteArray("\n  </AppendedData>\n</VTKFile>\n"))
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "---- " << getNameOfClass().toStdString() << " ----" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestWriteVTKXml(1, UnitTest::VtkRectilinearGridWriterTest::ImageDataFile))
+    DREAM3D_REGISTER_TEST(TestWriteVTKXml(2, UnitTest::VtkRectilinearGridWriterTest::RectilinearGridFile))
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+};
@@ -35,6 +35,9 @@
 
 #include "BadDataNeighborOrientationCheck.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
@@ -46,6 +49,224 @@
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+namespace BadDataNeighborOrientationCheckUtils
+{
+const uint8_t k_SimilarXFace = 1;
+const uint8_t k_SimilarYFace = 2;
+const uint8_t k_SimilarZFace = 4;
+
+/**
+ * @brief forEachSimilarNeighbor Calls func(neighbor) for every face neighbor of a cell that shares
+ * a similar face with it, as recorded in the face mask
+ */
+template <typename Func>
+void forEachSimilarNeighbor(int64_t cell, const int64_t dims[3], const uint8_t* faceMask, Func func)
+{
+  int64_t planeStride = dims[0] * dims[1];
+  int64_t column = cell % dims[0];
+  int64_t row = (cell / dims[0]) % dims[1];
+  int64_t plane = cell / planeStride;
+  if(plane > 0 && (faceMask[cell - planeStride] & k_SimilarZFace) != 0)
+  {
+    func(cell - planeStride);
+  }
+  if(row > 0 && (faceMask[cell - dims[0]] & k_SimilarYFace) != 0)
+  {
+    func(cell - dims[0]);
+  }
+  if(column > 0 && (faceMask[cell - 1] & k_SimilarXFace) != 0)
+  {
+    func(cell - 1);
+  }
+  if(column < dims[0] - 1 && (faceMask[cell] & k_SimilarXFace) != 0)
+  {
+    func(cell + 1);
+  }
+  if(row < dims[1] - 1 && (faceMask[cell] & k_SimilarYFace) != 0)
+  {
+    func(cell + dims[0]);
+  }
+  if(plane < dims[2] - 1 && (faceMask[cell] & k_SimilarZFace) != 0)
+  {
+    func(cell + planeStride);
+  }
+}
+
+/**
+ * @brief The FindSimilarFacesImpl class flags, for every cell, which of its +x, +y and +z faces join
+ * two cells of the same (non zero) phase whose misorientation is below the tolerance. Only faces
+ * that touch a bad cell are tested, since faces between two good cells are never looked at.
+ */
+class FindSimilarFacesImpl
+{
+public:
+  FindSimilarFacesImpl(const int64_t dims[3], const bool* goodVoxels, const int32_t* cellPhases, const uint32_t* crystalStructures, const float* quats, const QVector<LaueOps::Pointer>& orientationOps,
+                       float misorientationTolerance, uint8_t* faceMask)
+  : m_Dims(dims)
+  , m_GoodVoxels(goodVoxels)
+  , m_CellPhases(cellPhases)
+  , m_CrystalStructures(crystalStructures)
+  , m_Quats(quats)
+  , m_OrientationOps(orientationOps)
+  , m_MisorientationTolerance(misorientationTolerance)
+  , m_FaceMask(faceMask)
+  {
+  }
+  virtual ~FindSimilarFacesImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    int64_t strides[3] = {1, m_Dims[0], m_Dims[0] * m_Dims[1]};
+    uint8_t bits[3] = {k_SimilarXFace, k_SimilarYFace, k_SimilarZFace};
+    QuatF q1 = QuaternionMathF::New();
+    QuatF q2 = QuaternionMathF::New();
+    float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+    for(size_t i = start; i < end; i++)
+    {
+      int64_t cell = static_cast<int64_t>(i);
+      int64_t coords[3] = {cell % m_Dims[0], (cell / m_Dims[0]) % m_Dims[1], cell / strides[2]};
+      uint8_t mask = 0;
+      for(size_t d = 0; d < 3; d++)
+      {
+        if(coords[d] == m_Dims[d] - 1)
+        {
+          continue;
+        }
+        int64_t neighbor = cell + strides[d];
+        if(m_GoodVoxels[cell] && m_GoodVoxels[neighbor])
+        {
+          continue;
+        }
+        if(m_CellPhases[cell] != m_CellPhases[neighbor] || m_CellPhases[cell] <= 0)
+        {
+          continue;
+        }
+        uint32_t phase = m_CrystalStructures[m_CellPhases[cell]];
+        QuaternionMathF::Copy(reinterpret_cast<const QuatF*>(m_Quats)[cell], q1);
+        QuaternionMathF::Copy(reinterpret_cast<const QuatF*>(m_Quats)[neighbor], q2);
+        float w = m_OrientationOps[phase]->getMisoQuat(q1, q2, n1, n2, n3);
+        if(w < m_MisorientationTolerance)
+        {
+          mask |= bits[d];
+        }
+      }
+      m_FaceMask[cell] = mask;
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const int64_t* m_Dims;
+  const bool* m_GoodVoxels;
+  const int32_t* m_CellPhases;
+  const uint32_t* m_CrystalStructures;
+  const float* m_Quats;
+  const QVector<LaueOps::Pointer>& m_OrientationOps;
+  float m_MisorientationTolerance;
+  uint8_t* m_FaceMask;
+};
+
+/**
+ * @brief The WaveImpl class processes one wave of the cleanup in slabs. In Select mode it keeps the
+ * bad cells of a list that have at least the required number of similar good neighbors; in Expand
+ * mode it gathers the bad similar neighbors of a list of cells that just turned good. Every slab
+ * writes its own list, and the lists are concatenated in slab order.
+ */
+class WaveImpl
+{
+public:
+  enum class Mode
+  {
+    Select,
+    Expand
+  };
+
+  WaveImpl(Mode mode, const std::vector<int64_t>& cells, const int64_t dims[3], const bool* goodVoxels, const uint8_t* faceMask, int32_t level, size_t numSlabs,
+           std::vector<std::vector<int64_t>>& slabCells)
+  : m_Mode(mode)
+  , m_Cells(cells)
+  , m_Dims(dims)
+  , m_GoodVoxels(goodVoxels)
+  , m_FaceMask(faceMask)
+  , m_Level(level)
+  , m_NumSlabs(numSlabs)
+  , m_SlabCells(slabCells)
+  {
+  }
+  virtual ~WaveImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    size_t numCells = m_Cells.size();
+    for(size_t s = start; s < end; s++)
+    {
+      std::vector<int64_t>& out = m_SlabCells[s];
+      out.clear();
+      size_t last = numCells * (s + 1) / m_NumSlabs;
+      for(size_t c = numCells * s / m_NumSlabs; c < last; c++)
+      {
+        int64_t cell = m_Cells[c];
+        if(m_Mode == Mode::Expand)
+        {
+          forEachSimilarNeighbor(cell, m_Dims, m_FaceMask, [&](int64_t neighbor) {
+            if(!m_GoodVoxels[neighbor])
+            {
+              out.push_back(neighbor);
+            }
+          });
+          continue;
+        }
+        if(m_GoodVoxels[cell])
+        {
+          continue;
+        }
+        int32_t count = 0;
+        forEachSimilarNeighbor(cell, m_Dims, m_FaceMask, [&](int64_t neighbor) {
+          if(m_GoodVoxels[neighbor])
+          {
+            count++;
+          }
+        });
+        if(count >= m_Level)
+        {
+          out.push_back(cell);
+        }
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  Mode m_Mode;
+  const std::vector<int64_t>& m_Cells;
+  const int64_t* m_Dims;
+  const bool* m_GoodVoxels;
+  const uint8_t* m_FaceMask;
+  int32_t m_Level;
+  size_t m_NumSlabs;
+  std::vector<std::vector<int64_t>>& m_SlabCells;
+};
+} // namespace BadDataNeighborOrientationCheckUtils
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -216,153 +437,85 @@ void BadDataNeighborOrientationCheck::execute()
       static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2]),
   };
 
-  int32_t good = 1;
-  int64_t neighbor = 0;
-  int64_t column = 0, row = 0, plane = 0;
-
-  int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
-  neighpoints[0] = static_cast<int64_t>(-dims[0] * dims[1]);
-  neighpoints[1] = static_cast<int64_t>(-dims[0]);
-  neighpoints[2] = static_cast<int64_t>(-1);
-  neighpoints[3] = static_cast<int64_t>(1);
-  neighpoints[4] = static_cast<int64_t>(dims[0]);
-  neighpoints[5] = static_cast<int64_t>(dims[0] * dims[1]);
-
-  float w = 10000.0f;
-  QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
-  QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
-  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  uint32_t phase1 = 0, phase2 = 0;
-
-  QVector<int32_t> neighborCount(totalPoints, 0);
+  size_t numSlabs = 1;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  numSlabs = static_cast<size_t>(tbb::task_scheduler_init::default_num_threads());
+#endif
+
+  // The misorientation across every face that touches a bad cell is computed exactly once
+  std::vector<uint8_t> faceMask(totalPoints, 0);
+  BadDataNeighborOrientationCheckUtils::FindSimilarFacesImpl facesBody(dims, m_GoodVoxels, m_CellPhases, m_CrystalStructures, m_Quats, m_OrientationOps, misorientationTolerance, faceMask.data());
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints), facesBody, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    facesBody.convert(0, totalPoints);
+  }
 
+  std::vector<int64_t> badCells;
   for(size_t i = 0; i < totalPoints; i++)
   {
     if(!m_GoodVoxels[i])
     {
-      column = i % dims[0];
-      row = (i / dims[0]) % dims[1];
-      plane = i / (dims[0] * dims[1]);
-      for(int32_t j = 0; j < 6; j++)
-      {
-        good = 1;
-        neighbor = i + neighpoints[j];
-        if(j == 0 && plane == 0)
-        {
-          good = 0;
-        }
-        if(j == 5 && plane == (dims[2] - 1))
-        {
-          good = 0;
-        }
-        if(j == 1 && row == 0)
-        {
-          good = 0;
-        }
-        if(j == 4 && row == (dims[1] - 1))
-        {
-          good = 0;
-        }
-        if(j == 2 && column == 0)
-        {
-          good = 0;
-        }
-        if(j == 3 && column == (dims[0] - 1))
-        {
-          good = 0;
-        }
-        if(good == 1 && m_GoodVoxels[neighbor])
-        {
-          phase1 = m_CrystalStructures[m_CellPhases[i]];
-          QuaternionMathF::Copy(quats[i], q1);
-
-          phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-          QuaternionMathF::Copy(quats[neighbor], q2);
-
-          if(m_CellPhases[i] == m_CellPhases[neighbor] && m_CellPhases[i] > 0)
-          {
-            w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
-          }
-          if(w < misorientationTolerance)
-          {
-            neighborCount[i]++;
-          }
-        }
-      }
+      badCells.push_back(static_cast<int64_t>(i));
     }
   }
 
-  int32_t currentLevel = 6;
-  int32_t counter = 0;
+  std::vector<std::vector<int64_t>> slabCells(numSlabs);
+  auto runWave = [&](BadDataNeighborOrientationCheckUtils::WaveImpl::Mode mode, const std::vector<int64_t>& cells, int32_t level, std::vector<int64_t>& result) {
+    BadDataNeighborOrientationCheckUtils::WaveImpl body(mode, cells, dims, m_GoodVoxels, faceMask.data(), level, numSlabs, slabCells);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel && numSlabs > 1)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlabs, 1), body, tbb::simple_partitioner());
+    }
+    else
+#endif
+    {
+      body.convert(0, numSlabs);
+    }
+    result.clear();
+    for(const std::vector<int64_t>& cellsOfSlab : slabCells)
+    {
+      result.insert(result.end(), cellsOfSlab.begin(), cellsOfSlab.end());
+    }
+  };
 
-  while(currentLevel > m_NumberOfNeighbors)
+  // A bad cell turns good once enough of its similar neighbors are good. Cells only ever turn
+  // good, so each level converges to the same set of cells whatever order they are visited in.
+  // Each wave only revisits the bad neighbors of the cells that turned good in the previous one.
+  std::vector<int64_t> wave;
+  std::vector<int64_t> candidates;
+  for(int32_t currentLevel = 6; currentLevel > m_NumberOfNeighbors; currentLevel--)
   {
-    counter = 1;
-    while(counter > 0)
+    if(getCancel())
     {
-      counter = 0;
-      for(size_t i = 0; i < totalPoints; i++)
+      return;
+    }
+    QString ss = QObject::tr("Level %1 of %2").arg(7 - currentLevel).arg(6 - m_NumberOfNeighbors);
+    notifyStatusMessage(ss);
+
+    runWave(BadDataNeighborOrientationCheckUtils::WaveImpl::Mode::Select, badCells, currentLevel, wave);
+    while(!wave.empty())
+    {
+      for(int64_t cell : wave)
       {
-        if(neighborCount[i] >= currentLevel && !m_GoodVoxels[i])
-        {
-          m_GoodVoxels[i] = true;
-          counter++;
-          column = i % dims[0];
-          row = (i / dims[0]) % dims[1];
-          plane = i / (dims[0] * dims[1]);
-          for(int64_t j = 0; j < 6; j++)
-          {
-            good = 1;
-            neighbor = i + neighpoints[j];
-            if(j == 0 && plane == 0)
-            {
-              good = 0;
-            }
-            if(j == 5 && plane == (dims[2] - 1))
-            {
-              good = 0;
-            }
-            if(j == 1 && row == 0)
-            {
-              good = 0;
-            }
-            if(j == 4 && row == (dims[1] - 1))
-            {
-              good = 0;
-            }
-            if(j == 2 && column == 0)
-            {
-              good = 0;
-            }
-            if(j == 3 && column == (dims[0] - 1))
-            {
-              good = 0;
-            }
-            if(good == 1 && !m_GoodVoxels[neighbor])
-            {
-              phase1 = m_CrystalStructures[m_CellPhases[i]];
-              QuaternionMathF::Copy(quats[i], q1);
-
-              phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-              QuaternionMathF::Copy(quats[neighbor], q2);
-
-              if(m_CellPhases[i] == m_CellPhases[neighbor] && m_CellPhases[i] > 0)
-              {
-                w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
-              }
-              if(w < misorientationTolerance)
-              {
-                neighborCount[neighbor]++;
-              }
-            }
-          }
-        }
+        m_GoodVoxels[cell] = true;
       }
+      runWave(BadDataNeighborOrientationCheckUtils::WaveImpl::Mode::Expand, wave, currentLevel, candidates);
+      std::sort(candidates.begin(), candidates.end());
+      candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+      runWave(BadDataNeighborOrientationCheckUtils::WaveImpl::Mode::Select, candidates, currentLevel, wave);
     }
-    currentLevel = currentLevel - 1;
-  }
 
+    badCells.erase(std::remove_if(badCells.begin(), badCells.end(), [&](int64_t cell) { return m_GoodVoxels[cell]; }), badCells.end());
+  }
 
 }
 
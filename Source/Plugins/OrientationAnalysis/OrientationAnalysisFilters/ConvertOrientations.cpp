@@ -242,7 +242,9 @@ template <typename T> void generateRepresentation(ConvertOrientations* filter, t
 
   QVector<typename OCType::OrientationType> ocTypes = OCType::GetOrientationTypes();
 
+  // Convert straight into the output array instead of a temporary copy of it
   converters[filter->getInputType()]->setInputData(inputOrientations);
+  converters[filter->getInputType()]->setDestinationData(outputOrientations);
   converters[filter->getInputType()]->convertRepresentationTo(ocTypes[filter->getOutputType()]);
 
   ArrayType output = converters[filter->getInputType()]->getOutputData();
@@ -253,7 +255,7 @@ template <typename T> void generateRepresentation(ConvertOrientations* filter, t
     return;
   }
 
-  if(!output->copyIntoArray(outputOrientations))
+  if(output != outputOrientations && !output->copyIntoArray(outputOrientations))
   {
     QString ss = QObject::tr("There was an error copying the final results into the output array.");
     filter->setErrorCondition(-1003, ss);
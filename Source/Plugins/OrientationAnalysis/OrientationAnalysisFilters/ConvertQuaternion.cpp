@@ -4,19 +4,14 @@
 
 #include "ConvertQuaternion.h"
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-#include <tbb/blocked_range.h>
-#include <tbb/parallel_for.h>
-#include <tbb/partitioner.h>
-#include <tbb/task_scheduler_init.h>
-#endif
-
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/ChoiceFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArrayCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 
+#include "OrientationLib/OrientationMath/OrientationBatchTransforms.hpp"
+
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
@@ -27,66 +22,6 @@ enum createdPathID : RenameDataPath::DataID_t
   DataArrayID31 = 31,
 };
 
-class ConvertQuaternionImpl
-{
-public:
-  ConvertQuaternionImpl(ConvertQuaternion* filter, float* inputQuat, float* outputQuat)
-  : m_Filter(filter)
-  , m_Input(inputQuat)
-  , m_Output(outputQuat)
-  {
-  }
-  ConvertQuaternionImpl(const ConvertQuaternionImpl&) = default;           // Copy Constructor
-  ConvertQuaternionImpl(ConvertQuaternionImpl&&) = delete;                 // Move Constructor Not Implemented
-  ConvertQuaternionImpl& operator=(const ConvertQuaternionImpl&) = delete; // Copy Assignment Not Implemented
-  ConvertQuaternionImpl& operator=(ConvertQuaternionImpl&&) = delete;      // Move Assignment Not Implemented
-
-  virtual ~ConvertQuaternionImpl() = default;
-
-  void convert(size_t start, size_t end) const
-  {
-    // Let's assume k_ToScalarVector which means the incoming quaternions are Vector-Scalar
-    // <x,y,z> w  ---> w <x,y,z>
-    std::array<size_t, 4> mapping = {{1, 2, 3, 0}};
-
-    if(m_Filter->getConversionType() == ConvertQuaternion::k_ToVectorScalar)
-    {
-      // w <x,y,z>  ---> <x,y,z> w
-      mapping = {{3, 0, 1, 2}};
-    }
-
-    std::array<float, 4> temp = {0.0f, 0.0f, 0.0f, 0.0f};
-    for(size_t i = start; i < end; i++)
-    {
-      if(m_Filter->getCancel())
-      {
-        return;
-      }
-
-      temp[mapping[0]] = m_Input[i * 4];
-      temp[mapping[1]] = m_Input[i * 4 + 1];
-      temp[mapping[2]] = m_Input[i * 4 + 2];
-      temp[mapping[3]] = m_Input[i * 4 + 3];
-
-      m_Output[i * 4] = temp[0];
-      m_Output[i * 4 + 1] = temp[1];
-      m_Output[i * 4 + 2] = temp[2];
-      m_Output[i * 4 + 3] = temp[3];
-    }
-  }
-
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  void operator()(const tbb::blocked_range<size_t>& r) const
-  {
-    convert(r.begin(), r.end());
-  }
-#endif
-private:
-  ConvertQuaternion* m_Filter = nullptr;
-  float* m_Input;
-  float* m_Output;
-};
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -202,21 +137,15 @@ void ConvertQuaternion::execute()
 
   size_t totalPoints = m_QuaternionsPtr.lock()->getNumberOfTuples();
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
-  bool doParallel = true;
-#endif
-
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  if(doParallel)
+  if(getConversionType() == k_ToVectorScalar)
   {
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints), ConvertQuaternionImpl(this, m_Quaternions, m_OutputQuaternions), tbb::auto_partitioner());
+    // w <x,y,z>  ---> <x,y,z> w
+    ConvertOrientationBatch<float, Convertors::QuScalarVector2VectorScalar<float>>(m_Quaternions, m_OutputQuaternions, totalPoints);
   }
   else
-#endif
   {
-    ConvertQuaternionImpl serial(this, m_Quaternions, m_OutputQuaternions);
-    serial.convert(0, totalPoints);
+    // <x,y,z> w  ---> w <x,y,z>
+    ConvertOrientationBatch<float, Convertors::QuVectorScalar2ScalarVector<float>>(m_Quaternions, m_OutputQuaternions, totalPoints);
   }
 
   /* Do not forget to remove the original array if requested */
@@ -30,6 +30,15 @@
 
 #include "EMsoftSO3Sampler.h"
 
+#include <algorithm>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include <cmath>
 
 #include "SIMPLib/Common/Constants.h"
@@ -42,7 +51,9 @@
 #include "SIMPLib/Math/SIMPLibMath.h"
 #include "SIMPLib/SIMPLibVersion.h"
 
+#include "OrientationLib/LaueOps/SO3Sampler.h"
 #include "OrientationLib/OrientationLibConstants.h"
+#include "OrientationLib/OrientationMath/OrientationBatchTransforms.hpp"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
@@ -58,6 +69,137 @@ enum createdPathID : RenameDataPath::DataID_t
   DataContainerID = 1
 };
 
+/**
+ * @brief The SampleCubochoricGridImpl class samples a range of slabs of constant x of a cubochoric
+ * grid, either testing the grid points against a Rodrigues fundamental zone or composing them with a
+ * reference orientation. Each slab collects the 4 component Rodrigues vectors of its points into its
+ * own buffer, so the points come out in the same order as a serial sweep.
+ */
+class SampleCubochoricGridImpl
+{
+public:
+  enum class Mode
+  {
+    FundamentalZone,
+    MisorientationBall
+  };
+
+  SampleCubochoricGridImpl(EMsoftSO3Sampler* filter, Mode mode, int numsp, double delta, double gridShift, int FZtype, int FZorder, const double* sigma,
+                           std::vector<std::vector<double>>& slabs)
+  : m_Filter(filter)
+  , m_Mode(mode)
+  , m_Numsp(numsp)
+  , m_Delta(delta)
+  , m_GridShift(gridShift)
+  , m_FZtype(FZtype)
+  , m_FZorder(FZorder)
+  , m_Slabs(slabs)
+  {
+    m_Sigma[0] = sigma[0];
+    m_Sigma[1] = sigma[1];
+    m_Sigma[2] = sigma[2];
+  }
+  virtual ~SampleCubochoricGridImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t slab = start; slab < end; slab++)
+    {
+      if(m_Mode == Mode::FundamentalZone)
+      {
+        sampleFundamentalZone(slab);
+      }
+      else
+      {
+        sampleMisorientationBall(slab);
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  /**
+   * @brief sampleFundamentalZone Slab s holds the grid points with x index s - Numsp + 1
+   */
+  void sampleFundamentalZone(size_t slab) const
+  {
+    typedef OrientationTransforms<OrientationTuple<double>, double> OrientationTransformsType;
+    // eliminate points for which any of the coordinates lies outside the cube with semi-edge length "edge"
+    double edge = 0.5 * LPs::ap;
+    OrientationTuple<double> cu(3, 0.0);
+    OrientationTuple<double> rod(4, 0.0);
+    std::vector<double>& points = m_Slabs[slab];
+
+    cu[0] = (static_cast<double>(static_cast<int>(slab) - m_Numsp + 1) + m_GridShift) * m_Delta;
+    if(fabs(cu[0]) > edge)
+    {
+      return;
+    }
+    for(int j = -m_Numsp + 1; j < m_Numsp + 1; j++)
+    {
+      cu[1] = (static_cast<double>(j) + m_GridShift) * m_Delta;
+      if(fabs(cu[1]) > edge)
+      {
+        continue;
+      }
+      for(int k = -m_Numsp + 1; k < m_Numsp + 1; k++)
+      {
+        cu[2] = (static_cast<double>(k) + m_GridShift) * m_Delta;
+        if(fabs(cu[2]) > edge)
+        {
+          continue;
+        }
+        // convert to Rodrigues representation and keep the point if it is inside the FZ
+        OrientationTransformsType::cu2ro(cu, rod);
+        if(m_Filter->IsinsideFZ(rod.data(), m_FZtype, m_FZorder))
+        {
+          points.insert(points.end(), rod.data(), rod.data() + 4);
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief sampleMisorientationBall Slab s holds the grid points with x index s - Numsp
+   */
+  void sampleMisorientationBall(size_t slab) const
+  {
+    typedef OrientationTransforms<OrientationTuple<double>, double> OrientationTransformsType;
+    OrientationTuple<double> cu(3, 0.0);
+    OrientationTuple<double> rod(4, 0.0);
+    std::vector<double>& points = m_Slabs[slab];
+    cu[0] = -static_cast<double>(static_cast<int>(slab) - m_Numsp) * m_Delta;
+    for(int j = -m_Numsp; j <= m_Numsp; j++)
+    {
+      cu[1] = -static_cast<double>(j) * m_Delta;
+      for(int k = -m_Numsp; k <= m_Numsp; k++)
+      {
+        cu[2] = -static_cast<double>(k) * m_Delta;
+        // convert to Rodrigues representation and apply Rodrigues composition formula
+        OrientationTransformsType::cu2ro(cu, rod);
+        m_Filter->RodriguesComposition(m_Sigma, rod.data());
+        points.insert(points.end(), rod.data(), rod.data() + 4);
+      }
+    }
+  }
+
+  EMsoftSO3Sampler* m_Filter = nullptr;
+  Mode m_Mode = Mode::FundamentalZone;
+  int m_Numsp = 0;
+  double m_Delta = 0.0;
+  double m_GridShift = 0.0;
+  int m_FZtype = 0;
+  int m_FZorder = 0;
+  double m_Sigma[3] = {0.0, 0.0, 0.0};
+  std::vector<std::vector<double>>& m_Slabs;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -67,6 +209,8 @@ EMsoftSO3Sampler::EMsoftSO3Sampler()
 , m_Numsp(5)
 , m_MisOr(3.0)
 , m_MisOrFull(3.0)
+, m_PointGroupNeighborhood(32)
+, m_MisOrNeighborhood(3.0)
 , m_OffsetGrid(false)
 , m_DataContainerName(SIMPL::Defaults::ImageDataContainerName)
 , m_EMsoftAttributeMatrixName(SIMPL::Defaults::CellAttributeMatrixName)
@@ -78,6 +222,10 @@ EMsoftSO3Sampler::EMsoftSO3Sampler()
   m_RefOrFull[0] = 0.0;
   m_RefOrFull[1] = 0.0;
   m_RefOrFull[2] = 0.0;
+
+  m_RefOrNeighborhood[0] = 0.0;
+  m_RefOrNeighborhood[1] = 0.0;
+  m_RefOrNeighborhood[2] = 0.0;
 }
 
 // -----------------------------------------------------------------------------
@@ -103,6 +251,7 @@ void EMsoftSO3Sampler::setupFilterParameters()
     choices.push_back("- Rodrigues fundamental zone    ");
     choices.push_back("- Constant misorientation       ");
     choices.push_back("- Less than given misorientation");
+    choices.push_back("- Rodrigues fundamental zone near orientation");
     parameter->setChoices(choices);
     parameter->setChoices(choices);
     QStringList linkedProps;
@@ -111,7 +260,10 @@ void EMsoftSO3Sampler::setupFilterParameters()
                 << "MisOr"
                 << "RefOr"
                 << "MisOrFull"
-                << "RefOrFull";
+                << "RefOrFull"
+                << "PointGroupNeighborhood"
+                << "MisOrNeighborhood"
+                << "RefOrNeighborhood";
 
     parameter->setLinkedProperties(linkedProps);
     parameter->setEditable(false);
@@ -132,6 +284,12 @@ void EMsoftSO3Sampler::setupFilterParameters()
     parameters.push_back(SIMPL_NEW_DOUBLE_FP("Misorientation angle (degree)", MisOrFull, FilterParameter::Parameter, EMsoftSO3Sampler, 2));
     parameters.push_back(FloatVec3FilterParameter::New("Reference orientation (Euler, °)", "RefOrFull", getRefOrFull(), FilterParameter::Parameter,
                                                        SIMPL_BIND_SETTER(EMsoftSO3Sampler, this, RefOrFull), SIMPL_BIND_GETTER(EMsoftSO3Sampler, this, RefOrFull), 2));
+
+    /* fundamental zone sampling near a reference orientation */
+    parameters.push_back(SIMPL_NEW_INTEGER_FP("Point group number (see documentation for list)", PointGroupNeighborhood, FilterParameter::Parameter, EMsoftSO3Sampler, 3));
+    parameters.push_back(SIMPL_NEW_DOUBLE_FP("Misorientation angle (degree)", MisOrNeighborhood, FilterParameter::Parameter, EMsoftSO3Sampler, 3));
+    parameters.push_back(FloatVec3FilterParameter::New("Reference orientation (Euler, °)", "RefOrNeighborhood", getRefOrNeighborhood(), FilterParameter::Parameter,
+                                                       SIMPL_BIND_SETTER(EMsoftSO3Sampler, this, RefOrNeighborhood), SIMPL_BIND_GETTER(EMsoftSO3Sampler, this, RefOrNeighborhood), 3));
   }
   parameters.push_back(SIMPL_NEW_INTEGER_FP("Number of sampling points along cube semi-axis", Numsp, FilterParameter::Parameter, EMsoftSO3Sampler));
 
@@ -227,6 +385,26 @@ void EMsoftSO3Sampler::dataCheck()
     }
   }
 
+  if(getsampleModeSelector() == 3)
+  {
+    if((getPointGroupNeighborhood() < 1) || (getPointGroupNeighborhood() > 32))
+    {
+      QString ss = QObject::tr("Point group number must fall in interval [1,32]");
+      setWarningCondition(-70006, ss);
+    }
+    if((getMisOrNeighborhood() < 0.0) || (getMisOrNeighborhood() > 180.0))
+    {
+      QString ss = QObject::tr("Misorientation angle must fall in interval [0,180]");
+      setWarningCondition(-70007, ss);
+    }
+    if((getRefOrNeighborhood()[0] < 0.0f) || (getRefOrNeighborhood()[0] > 360.0f) || (getRefOrNeighborhood()[1] < 0.0f) || (getRefOrNeighborhood()[1] > 180.0f) ||
+       (getRefOrNeighborhood()[2] < 0.0f) || (getRefOrNeighborhood()[2] > 360.0f))
+    {
+      QString ss = QObject::tr("Euler angles must be positive and less than [360°,180°,360°]");
+      setWarningCondition(-70008, ss);
+    }
+  }
+
   // check on the number of sampling intervals (>1)
   if(getNumsp() < 1)
   {
@@ -285,15 +463,54 @@ void EMsoftSO3Sampler::execute()
   OrientationListArrayType FZlist;
   typedef OrientationTransforms<DOrientArrayType, double> OrientationTransformsType;
 
+  // The full grid modes sample the grid in slabs of constant x, in parallel, a tenth of the slabs at
+  // a time so that progress can be reported; each slab keeps its own buffer of Rodrigues vectors
+  std::vector<std::vector<double>> slabs;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+  auto sampleSlabs = [&](const SampleCubochoricGridImpl& body, int totalPoints, const QString& label) {
+    size_t numSlabs = slabs.size();
+    size_t chunkSize = std::max(numSlabs / 10, static_cast<size_t>(1));
+    size_t numFound = 0;
+    for(size_t first = 0; first < numSlabs; first += chunkSize)
+    {
+      size_t last = std::min(first + chunkSize, numSlabs);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+      if(doParallel)
+      {
+        tbb::parallel_for(tbb::blocked_range<size_t>(first, last, 1), body, tbb::auto_partitioner());
+      }
+      else
+#endif
+      {
+        body.convert(first, last);
+      }
+
+      // report on status of computation
+      for(size_t slab = first; slab < last; slab++)
+      {
+        numFound += slabs[slab].size() / 4;
+      }
+      QString ss = QString("Euler Angles | Slabs: %1 of %2 | %3: %4 of at most %5")
+                       .arg(QString::number(last), QString::number(numSlabs), label, QString::number(numFound), QString::number(totalPoints));
+      notifyStatusMessage(ss);
+      if(getCancel())
+      {
+        break;
+      }
+    }
+  };
+
   if(getsampleModeSelector() == 0)
   {
-    // here we perform the actual calculation; once we have the FZlist,
+    // here we perform the actual calculation; once we have the Rodrigues vectors,
     // we can allocate the data array and copy all entries
-    double x, y, z, delta;
     int32_t FZtype, FZorder;
 
     // step size for sampling of grid; maximum total number of samples = pow(2*getNumsp()+1,3)
-    delta = (0.50 * LPs::ap) / static_cast<double>(getNumsp());
+    double delta = (0.50 * LPs::ap) / static_cast<double>(getNumsp());
 
     // do we need to shift this array away from the origin?
     double gridShift = 0.0;
@@ -311,70 +528,14 @@ void EMsoftSO3Sampler::execute()
     // with a rotation angle of 180 degrees.  This only affects the cyclic groups.
     int Np = getNumsp();
     int Totp = (2 * Np + 1) * (2 * Np + 1) * (2 * Np + 1);
-    int Dn = Totp / 10;
-    int Dc = Dn;
-    int Di = 0;
-    int Dg = 0;
-
-    // eliminate points for which any of the coordinates lies outside the cube with semi-edge length "edge"
-    double edge = 0.5 * LPs::ap;
-
-    for(int i = -Np + 1; i < Np + 1; i++)
-    {
-      x = (static_cast<double>(i) + gridShift) * delta;
-
-      if(fabs(x) <= edge)
-      {
-
-        for(int j = -Np + 1; j < Np + 1; j++)
-        {
-          y = (static_cast<double>(j) + gridShift) * delta;
-
-          if(fabs(y) <= edge)
-          {
-
-            for(int k = -Np + 1; k < Np + 1; k++)
-            {
-              z = (static_cast<double>(k) + gridShift) * delta;
-
-              if(fabs(z) <= edge)
-              {
-
-                // convert to Rodrigues representation
-                DOrientArrayType cu(x, y, z);
-                DOrientArrayType rod(4);
-                OrientationTransformsType::cu2ro(cu, rod);
-
-                // If insideFZ=true, then add this point to FZlist
-                bool b = IsinsideFZ(rod.data(), FZtype, FZorder);
-                if(b)
-                {
-                  FZlist.push_back(rod);
-                  Dg += 1;
-                }
-                Di += 1;
-              }
-            }
-          }
-        }
-      }
-
-      // report on status of computation
-      if(Di > Dc)
-      {
-        QString ss = QString("Euler Angles | Tested: %1 of %2 | Inside RFZ: %3 ").arg(QString::number(Di), QString::number(Totp), QString::number(Dg));
-        notifyStatusMessage(ss);
-        Dc += Dn;
-      }
-      if(getCancel())
-      {
-        break;
-      }
-    }
+    slabs.resize(static_cast<size_t>(2 * Np));
+    double sigma[3] = {0.0, 0.0, 0.0};
+    SampleCubochoricGridImpl body(this, SampleCubochoricGridImpl::Mode::FundamentalZone, Np, delta, gridShift, FZtype, FZorder, sigma, slabs);
+    sampleSlabs(body, Totp, "Inside RFZ");
   }
 
   // here are the misorientation sampling cases:
-  if(getsampleModeSelector() != 0)
+  if(getsampleModeSelector() == 1 || getsampleModeSelector() == 2)
   {
     // here we perform the actual calculation; once we have the FZlist,
     // we can allocate the data array and copy all entries
@@ -416,7 +577,7 @@ void EMsoftSO3Sampler::execute()
             DOrientArrayType cu(-x, -y, -semi);
             DOrientArrayType rod(4);
             OrientationTransformsType::cu2ro(cu, rod);
-            RodriguesComposition(sigma, rod);
+            RodriguesComposition(sigma.data(), rod.data());
             FZlist.push_back(rod);
             Dg += 1;
           }
@@ -424,7 +585,7 @@ void EMsoftSO3Sampler::execute()
             DOrientArrayType cu(-x, -y, semi);
             DOrientArrayType rod(4);
             OrientationTransformsType::cu2ro(cu, rod);
-            RodriguesComposition(sigma, rod);
+            RodriguesComposition(sigma.data(), rod.data());
             FZlist.push_back(rod);
             Dg += 1;
           }
@@ -446,7 +607,7 @@ void EMsoftSO3Sampler::execute()
             DOrientArrayType cu(-semi, -y, -z);
             DOrientArrayType rod(4);
             OrientationTransformsType::cu2ro(cu, rod);
-            RodriguesComposition(sigma, rod);
+            RodriguesComposition(sigma.data(), rod.data());
             FZlist.push_back(rod);
             Dg += 1;
           }
@@ -454,7 +615,7 @@ void EMsoftSO3Sampler::execute()
             DOrientArrayType cu(semi, -y, -z);
             DOrientArrayType rod(4);
             OrientationTransformsType::cu2ro(cu, rod);
-            RodriguesComposition(sigma, rod);
+            RodriguesComposition(sigma.data(), rod.data());
             FZlist.push_back(rod);
             Dg += 1;
           }
@@ -476,7 +637,7 @@ void EMsoftSO3Sampler::execute()
             DOrientArrayType cu(-x, -semi, -z);
             DOrientArrayType rod(4);
             OrientationTransformsType::cu2ro(cu, rod);
-            RodriguesComposition(sigma, rod);
+            RodriguesComposition(sigma.data(), rod.data());
             FZlist.push_back(rod);
             Dg += 1;
           }
@@ -484,7 +645,7 @@ void EMsoftSO3Sampler::execute()
             DOrientArrayType cu(-x, semi, -z);
             DOrientArrayType rod(4);
             OrientationTransformsType::cu2ro(cu, rod);
-            RodriguesComposition(sigma, rod);
+            RodriguesComposition(sigma.data(), rod.data());
             FZlist.push_back(rod);
             Dg += 1;
           }
@@ -503,73 +664,78 @@ void EMsoftSO3Sampler::execute()
         Dc += Dn;
       }
     }
-    else
+    else if(getsampleModeSelector() == 2)
     {
-      // set counter parameters for the loop over the sub-cube surface
       int Np = getNumsp();
       int Totp = (2 * Np + 1) * (2 * Np + 1) * (2 * Np + 1); // see misorientation sampling paper for this expression
-      int Dn = Totp / 20;
-      int Dc = Dn;
-      int Dg = 0;
-
-      for(int i = -Np; i <= Np; i++)
-      {
-        x = static_cast<double>(i) * delta;
-        for(int j = -Np; j <= Np; j++)
-        {
-          y = static_cast<double>(j) * delta;
-          for(int k = -Np; k <= Np; k++)
-          {
-            z = static_cast<double>(k) * delta;
-            // convert to Rodrigues representation and apply Rodrigues composition formula
-            {
-              DOrientArrayType cu(-x, -y, -z);
-              DOrientArrayType rod(4);
-              OrientationTransformsType::cu2ro(cu, rod);
-              RodriguesComposition(sigma, rod);
-              FZlist.push_back(rod);
-              Dg += 1;
-            }
-          }
-        }
-        // report on status of computation
-        if(Dg > Dc)
-        {
-          QString ss = QString("Euler Angles | Generated: %1 / %2").arg(QString::number(Dg), QString::number(Totp));
-          notifyStatusMessage(ss);
-          Dc += Dn;
-        }
-      }
+      slabs.resize(static_cast<size_t>(2 * Np + 1));
+      SampleCubochoricGridImpl body(this, SampleCubochoricGridImpl::Mode::MisorientationBall, Np, delta, 0.0, 0, 0, sigma.data(), slabs);
+      sampleSlabs(body, Totp, "Generated");
     }
   }
 
+  // grid points of the Rodrigues FZ near a reference orientation; only the grid points around the
+  // reference orientation are visited
+  if(getsampleModeSelector() == 3)
+  {
+    DOrientArrayType referenceOrientation(3), referenceRod(4);
+    referenceOrientation[0] = static_cast<double>(getRefOrNeighborhood()[0] * SIMPLib::Constants::k_PiOver180);
+    referenceOrientation[1] = static_cast<double>(getRefOrNeighborhood()[1] * SIMPLib::Constants::k_PiOver180);
+    referenceOrientation[2] = static_cast<double>(getRefOrNeighborhood()[2] * SIMPLib::Constants::k_PiOver180);
+    OrientationTransformsType::eu2ro(referenceOrientation, referenceRod);
+
+    SO3Sampler::Pointer sampler = SO3Sampler::New();
+    FZlist = sampler->SampleRFZNeighborhood(getNumsp(), getPointGroupNeighborhood(), referenceRod, getMisOrNeighborhood() * SIMPLib::Constants::k_PiOver180);
+    QString ss = QString("Euler Angles | Inside RFZ neighborhood: %1").arg(QString::number(FZlist.size()));
+    notifyStatusMessage(ss);
+  }
+
+  if(getCancel())
+  {
+    return;
+  }
+
   // resize the EulerAngles array to the number of items in FZlist; don't forget to redefine the hard pointer
   AttributeMatrix::Pointer am = getDataContainerArray()->getAttributeMatrix(DataArrayPath(getDataContainerName().getDataContainerName(), getEMsoftAttributeMatrixName(), ""));
-  QVector<size_t> tDims(1, FZlist.size());
+  size_t numPoints = FZlist.size();
+  for(const std::vector<double>& points : slabs)
+  {
+    numPoints += points.size() / 4;
+  }
+  QVector<size_t> tDims(1, numPoints);
   am->resizeAttributeArrays(tDims);
   m_EulerAngles = m_EulerAnglesPtr.lock()->getPointer(0);
 
-  // copy the Rodrigues vectors as Euler angles into the m_EulerAngles array; convert doubles to floats along the way
-  int j = -1;
-  for(DOrientArrayType rod : FZlist)
+  // gather the Rodrigues vectors into one buffer, convert them in place to Euler angles with the batch
+  // kernel and copy the Euler angles into the m_EulerAngles array; convert doubles to floats along the way
+  std::vector<double> points;
+  points.reserve(numPoints * 4);
+  for(DOrientArrayType& rod : FZlist)
   {
-    j += 1;
-    DOrientArrayType eu(3, 0.0);
-    OrientationTransformsType::ro2eu(rod, eu);
-
-    m_EulerAngles[j * 3 + 0] = static_cast<float>(eu[0]);
-    m_EulerAngles[j * 3 + 1] = static_cast<float>(eu[1]);
-    m_EulerAngles[j * 3 + 2] = static_cast<float>(eu[2]);
+    points.insert(points.end(), rod.data(), rod.data() + 4);
+  }
+  FZlist.clear();
+  for(std::vector<double>& slab : slabs)
+  {
+    points.insert(points.end(), slab.begin(), slab.end());
+    std::vector<double>().swap(slab);
+  }
+  ConvertOrientationBatch<double, Convertors::Ro2Eu<double>>(points.data(), OrientationMemoryLayout::AoS(4), points.data(), OrientationMemoryLayout::AoS(4), numPoints);
+  for(size_t p = 0; p < numPoints; p++)
+  {
+    m_EulerAngles[p * 3 + 0] = static_cast<float>(points[p * 4 + 0]);
+    m_EulerAngles[p * 3 + 1] = static_cast<float>(points[p * 4 + 1]);
+    m_EulerAngles[p * 3 + 2] = static_cast<float>(points[p * 4 + 2]);
   }
-
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void EMsoftSO3Sampler::RodriguesComposition(DOrientArrayType sigma, DOrientArrayType& rod)
+void EMsoftSO3Sampler::RodriguesComposition(const double* sigma, double* rod)
 {
-  DOrientArrayType rho(3), rhomis(3);
+  double rho[3] = {0.0, 0.0, 0.0};
+  double rhomis[3] = {0.0, 0.0, 0.0};
   rho[0] = -rod[0] * rod[3];
   rho[1] = -rod[1] * rod[3];
   rho[2] = -rod[2] * rod[3];
@@ -55,6 +55,9 @@ class OrientationAnalysis_EXPORT EMsoftSO3Sampler : public AbstractFilter
     PYB11_PROPERTY(FloatVec3Type RefOr READ getRefOr WRITE setRefOr)
     PYB11_PROPERTY(double MisOrFull READ getMisOrFull WRITE setMisOrFull)
     PYB11_PROPERTY(FloatVec3Type RefOrFull READ getRefOrFull WRITE setRefOrFull)
+    PYB11_PROPERTY(int PointGroupNeighborhood READ getPointGroupNeighborhood WRITE setPointGroupNeighborhood)
+    PYB11_PROPERTY(double MisOrNeighborhood READ getMisOrNeighborhood WRITE setMisOrNeighborhood)
+    PYB11_PROPERTY(FloatVec3Type RefOrNeighborhood READ getRefOrNeighborhood WRITE setRefOrNeighborhood)
     PYB11_PROPERTY(bool OffsetGrid READ getOffsetGrid WRITE setOffsetGrid)
     PYB11_PROPERTY(QString EulerAnglesArrayName READ getEulerAnglesArrayName WRITE setEulerAnglesArrayName)
     PYB11_PROPERTY(DataArrayPath DataContainerName READ getDataContainerName WRITE setDataContainerName)
@@ -92,6 +95,15 @@ public:
   SIMPL_FILTER_PARAMETER(FloatVec3Type, RefOrFull)
   Q_PROPERTY(FloatVec3Type RefOrFull READ getRefOrFull WRITE setRefOrFull)
 
+  SIMPL_FILTER_PARAMETER(int, PointGroupNeighborhood)
+  Q_PROPERTY(int PointGroupNeighborhood READ getPointGroupNeighborhood WRITE setPointGroupNeighborhood)
+
+  SIMPL_FILTER_PARAMETER(double, MisOrNeighborhood)
+  Q_PROPERTY(double MisOrNeighborhood READ getMisOrNeighborhood WRITE setMisOrNeighborhood)
+
+  SIMPL_FILTER_PARAMETER(FloatVec3Type, RefOrNeighborhood)
+  Q_PROPERTY(FloatVec3Type RefOrNeighborhood READ getRefOrNeighborhood WRITE setRefOrNeighborhood)
+
   SIMPL_FILTER_PARAMETER(bool, OffsetGrid)
   Q_PROPERTY(bool OffsetGrid READ getOffsetGrid WRITE setOffsetGrid)
 
@@ -166,10 +178,10 @@ public:
 
   /**
    * @brief RodriguesComposition
-   * @param sigma
-   * @param rod
+   * @param sigma 3 component Rodrigues vector of the reference orientation
+   * @param rod [in/out] 4 component Rodrigues vector
    */
-  void RodriguesComposition(DOrientArrayType sigma, DOrientArrayType& rod);
+  void RodriguesComposition(const double* sigma, double* rod);
 
   /**
    * @brief OrientationListArrayType
@@ -35,6 +35,9 @@
 
 #include "EbsdToH5Ebsd.h"
 
+#include <memory>
+#include <vector>
+
 #include <QtCore/QDir>
 
 #include "H5Support/QH5Utilities.h"
@@ -42,6 +45,8 @@
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
+#include "SIMPLib/FilterParameters/IntFilterParameter.h"
 #include "SIMPLib/Utilities/FilePathGenerator.h"
 
 #include "EbsdLib/HKL/H5CtfImporter.h"
@@ -51,6 +56,74 @@
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_group.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+/**
+ * @brief The ParsedEbsdFile struct holds one parsed EBSD file until it is written to the HDF5 file
+ */
+struct ParsedEbsdFile
+{
+  std::shared_ptr<EbsdReader> reader;
+  int error = 0;
+  QString message;
+};
+
+/**
+ * @brief The ParseEbsdFilesImpl class parses a range of EBSD files, each into its own reader.
+ * Run through a task_group it parses the next batch of files while the current batch is written.
+ */
+class ParseEbsdFilesImpl
+{
+public:
+  ParseEbsdFilesImpl(const EbsdImporter* importer, const QVector<QString>& fileList, std::vector<ParsedEbsdFile>& parsedFiles, size_t start, size_t end)
+  : m_Importer(importer)
+  , m_FileList(fileList)
+  , m_ParsedFiles(parsedFiles)
+  , m_Start(start)
+  , m_End(end)
+  {
+  }
+  virtual ~ParseEbsdFilesImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      ParsedEbsdFile& parsed = m_ParsedFiles[i];
+      parsed.error = m_Importer->parseFile(m_FileList[static_cast<int>(i)], parsed.reader, parsed.message);
+    }
+  }
+
+  void operator()() const
+  {
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    tbb::parallel_for(tbb::blocked_range<size_t>(m_Start, m_End, 1), *this, tbb::simple_partitioner());
+#else
+    convert(m_Start, m_End);
+#endif
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const EbsdImporter* m_Importer;
+  const QVector<QString>& m_FileList;
+  std::vector<ParsedEbsdFile>& m_ParsedFiles;
+  size_t m_Start;
+  size_t m_End;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -65,6 +138,8 @@ EbsdToH5Ebsd::EbsdToH5Ebsd()
 , m_FileSuffix("")
 , m_FileExtension("ang")
 , m_PaddingDigits(4)
+, m_CompressionLevel(0)
+, m_UseShuffle(false)
 {
   m_SampleTransformation.angle = 0.0f;
   m_SampleTransformation.h = 0.0f;
@@ -91,6 +166,8 @@ void EbsdToH5Ebsd::setupFilterParameters()
   FilterParameterVectorType parameters;
 
   parameters.push_back(EbsdToH5EbsdFilterParameter::New("Import Orientation Data", "OrientationData", getOutputFile(), FilterParameter::Parameter, this));
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Compression Level (0-9)", CompressionLevel, FilterParameter::Parameter, EbsdToH5Ebsd));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Shuffle Data Before Compression", UseShuffle, FilterParameter::Parameter, EbsdToH5Ebsd));
 
   setFilterParameters(parameters);
 }
@@ -113,6 +190,8 @@ void EbsdToH5Ebsd::readFilterParameters(AbstractFilterParametersReader* reader,
   setPaddingDigits(reader->readValue("PaddingDigits", getPaddingDigits()));
   setSampleTransformation(reader->readAxisAngle("SampleTransformation", getSampleTransformation(), -1));
   setEulerTransformation(reader->readAxisAngle("EulerTransformation", getEulerTransformation(), -1));
+  setCompressionLevel(reader->readValue("CompressionLevel", getCompressionLevel()));
+  setUseShuffle(reader->readValue("UseShuffle", getUseShuffle()));
   reader->closeFilterGroup();
 }
 
@@ -144,6 +223,12 @@ void EbsdToH5Ebsd::dataCheck()
     setErrorCondition(-13, ss);
   }
 
+  if(m_CompressionLevel < 0 || m_CompressionLevel > 9)
+  {
+    ss = QObject::tr("The Compression Level must be between 0 and 9");
+    setErrorCondition(-14, ss);
+  }
+
   bool hasMissingFiles = false;
   const bool stackLowToHigh = true;
   int increment = 1;
@@ -363,6 +448,9 @@ void EbsdToH5Ebsd::execute()
     return;
   }
 
+  fileImporter->setCompressionLevel(m_CompressionLevel);
+  fileImporter->setUseShuffle(m_UseShuffle);
+
   QVector<int32_t> indices;
   // Loop on Each EBSD File
   float total = static_cast<float>(m_ZEndIndex - m_ZStartIndex);
@@ -396,46 +484,100 @@ void EbsdToH5Ebsd::execute()
   int64_t biggestxDim = 0;
   int64_t biggestyDim = 0;
   int32_t totalSlicesImported = 0;
-  for(QVector<QString>::iterator filepath = fileList.begin(); filepath != fileList.end(); ++filepath)
-  {
-    QString ebsdFName = *filepath;
-    progress = static_cast<int32_t>(z - m_ZStartIndex);
-    progress = (int32_t)(100.0f * (float)(progress) / total);
-    QString msg = "Converting File: " + ebsdFName;
-
-    notifyStatusMessage(msg.toLatin1().data());
-    err = fileImporter->importFile(fileId, z, ebsdFName);
-    if(err < 0)
-    {
-      setErrorCondition(err, fileImporter->getPipelineMessage());
-      return;
-    }
-    totalSlicesImported = totalSlicesImported + fileImporter->numberOfSlicesImported();
 
-    fileImporter->getDims(xDim, yDim);
-    fileImporter->getSpacing(xRes, yRes);
-    if(xDim > biggestxDim)
-    {
-      biggestxDim = xDim;
-    }
-    if(yDim > biggestyDim)
+  // The files are parsed in batches. While one batch is written to the HDF5 file, in slice
+  // order and from this thread only, the next batch is already being parsed in parallel.
+  size_t numFiles = static_cast<size_t>(fileList.size());
+  std::vector<ParsedEbsdFile> parsedFiles(numFiles);
+  size_t batchSize = 1;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  std::shared_ptr<tbb::task_group> parsers(new tbb::task_group);
+  batchSize = static_cast<size_t>(tbb::task_scheduler_init::default_num_threads());
+#endif
+
+  ParseEbsdFilesImpl firstBatch(fileImporter.get(), fileList, parsedFiles, 0, std::min(batchSize, numFiles));
+  firstBatch();
+
+  bool stopped = false;
+  for(size_t batchStart = 0; batchStart < numFiles && !stopped; batchStart += batchSize)
+  {
+    size_t batchEnd = std::min(batchStart + batchSize, numFiles);
+    ParseEbsdFilesImpl nextBatch(fileImporter.get(), fileList, parsedFiles, batchEnd, std::min(batchEnd + batchSize, numFiles));
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel && batchEnd < numFiles)
     {
-      biggestyDim = yDim;
+      parsers->run(nextBatch);
     }
+#endif
 
-    if(err < 0)
+    for(size_t fileIdx = batchStart; fileIdx < batchEnd; fileIdx++)
     {
-      QString ss = QObject::tr("Could not write dataset for slice to HDF5 file");
-      setErrorCondition(-1, ss);
+      QString ebsdFName = fileList[static_cast<int>(fileIdx)];
+      progress = static_cast<int32_t>(z - m_ZStartIndex);
+      progress = (int32_t)(100.0f * (float)(progress) / total);
+      QString msg = "Converting File: " + ebsdFName;
+
+      notifyStatusMessage(msg.toLatin1().data());
+      ParsedEbsdFile& parsed = parsedFiles[fileIdx];
+      if(parsed.error < 0)
+      {
+        setErrorCondition(-1, parsed.message);
+        stopped = true;
+        break;
+      }
+      err = fileImporter->writeFile(fileId, z, *(parsed.reader));
+      // Release the parsed data as soon as it is written
+      parsed.reader.reset();
+      if(err < 0)
+      {
+        setErrorCondition(err, fileImporter->getPipelineMessage());
+        stopped = true;
+        break;
+      }
+      totalSlicesImported = totalSlicesImported + fileImporter->numberOfSlicesImported();
+
+      fileImporter->getDims(xDim, yDim);
+      fileImporter->getSpacing(xRes, yRes);
+      if(xDim > biggestxDim)
+      {
+        biggestxDim = xDim;
+      }
+      if(yDim > biggestyDim)
+      {
+        biggestyDim = yDim;
+      }
+
+      indices.push_back(static_cast<int32_t>(z));
+      ++z;
+      if(getCancel())
+      {
+        stopped = true;
+        break;
+      }
     }
 
-    indices.push_back(static_cast<int32_t>(z));
-    ++z;
-    if(getCancel())
+    if(batchEnd < numFiles)
     {
-      return;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+      if(doParallel)
+      {
+        // The parsers reference the file list and the parsed files, so always wait for them
+        parsers->wait();
+      }
+      else
+#endif
+      if(!stopped)
+      {
+        nextBatch();
+      }
     }
   }
+  if(stopped)
+  {
+    return;
+  }
 
   // Write Z index start, Z index end and Z Spacing to the HDF5 file
   err = QH5Lite::writeScalarDataset(fileId, Ebsd::H5Ebsd::ZStartIndex, m_ZStartIndex);
@@ -62,6 +62,8 @@ class OrientationAnalysis_EXPORT EbsdToH5Ebsd : public AbstractFilter
   PYB11_PROPERTY(int64_t ZEndIndex READ getZEndIndex WRITE setZEndIndex)
   PYB11_PROPERTY(AxisAngleInput_t SampleTransformation READ getSampleTransformation WRITE setSampleTransformation)
   PYB11_PROPERTY(AxisAngleInput_t EulerTransformation READ getEulerTransformation WRITE setEulerTransformation)
+  PYB11_PROPERTY(int CompressionLevel READ getCompressionLevel WRITE setCompressionLevel)
+  PYB11_PROPERTY(bool UseShuffle READ getUseShuffle WRITE setUseShuffle)
 public:
   SIMPL_SHARED_POINTERS(EbsdToH5Ebsd)
   SIMPL_FILTER_NEW_MACRO(EbsdToH5Ebsd)
@@ -93,6 +95,10 @@ public:
 
   SIMPL_FILTER_PARAMETER(AxisAngleInput_t, EulerTransformation)
 
+  SIMPL_FILTER_PARAMETER(int, CompressionLevel)
+
+  SIMPL_FILTER_PARAMETER(bool, UseShuffle)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -37,20 +37,24 @@
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArrayCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/util/FeatureOrientationAverager.h"
 
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
 enum createdPathID : RenameDataPath::DataID_t
 {
   DataArrayID30 = 30,
   DataArrayID31 = 31,
+  DataArrayID32 = 32,
 };
 
 // -----------------------------------------------------------------------------
@@ -63,9 +67,10 @@ FindAvgOrientations::FindAvgOrientations()
 , m_CrystalStructuresArrayPath("", "", "")
 , m_AvgQuatsArrayPath("", "", "")
 , m_AvgEulerAnglesArrayPath("", "", "")
+, m_RefineAverage(false)
+, m_ComputeOrientationSpread(false)
+, m_OrientationSpreadArrayPath("", "", "")
 {
-  m_OrientationOps = LaueOps::getOrientationOpsQVector();
-
 }
 
 // -----------------------------------------------------------------------------
@@ -79,6 +84,9 @@ FindAvgOrientations::~FindAvgOrientations() = default;
 void FindAvgOrientations::setupFilterParameters()
 {
   FilterParameterVectorType parameters;
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Refine Average Against First Average", RefineAverage, FilterParameter::Parameter, FindAvgOrientations));
+  QStringList linkedProps("OrientationSpreadArrayPath");
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Compute Orientation Spread (GOS)", ComputeOrientationSpread, FilterParameter::Parameter, FindAvgOrientations, linkedProps));
   parameters.push_back(SeparatorFilterParameter::New("Element Data", FilterParameter::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateCategoryRequirement(SIMPL::TypeNames::Int32, 1, AttributeMatrix::Category::Element);
@@ -107,6 +115,10 @@ void FindAvgOrientations::setupFilterParameters()
     DataArrayCreationFilterParameter::RequirementType req = DataArrayCreationFilterParameter::CreateRequirement(AttributeMatrix::Category::Feature);
     parameters.push_back(SIMPL_NEW_DA_CREATION_FP("Average Euler Angles", AvgEulerAnglesArrayPath, FilterParameter::CreatedArray, FindAvgOrientations, req));
   }
+  {
+    DataArrayCreationFilterParameter::RequirementType req = DataArrayCreationFilterParameter::CreateRequirement(AttributeMatrix::Category::Feature);
+    parameters.push_back(SIMPL_NEW_DA_CREATION_FP("Orientation Spread", OrientationSpreadArrayPath, FilterParameter::CreatedArray, FindAvgOrientations, req));
+  }
   setFilterParameters(parameters);
 }
 
@@ -122,6 +134,9 @@ void FindAvgOrientations::readFilterParameters(AbstractFilterParametersReader* r
   setQuatsArrayPath(reader->readDataArrayPath("QuatsArrayPath", getQuatsArrayPath()));
   setCellPhasesArrayPath(reader->readDataArrayPath("CellPhasesArrayPath", getCellPhasesArrayPath()));
   setFeatureIdsArrayPath(reader->readDataArrayPath("FeatureIdsArrayPath", getFeatureIdsArrayPath()));
+  setRefineAverage(reader->readValue("RefineAverage", getRefineAverage()));
+  setComputeOrientationSpread(reader->readValue("ComputeOrientationSpread", getComputeOrientationSpread()));
+  setOrientationSpreadArrayPath(reader->readDataArrayPath("OrientationSpreadArrayPath", getOrientationSpreadArrayPath()));
   reader->closeFilterGroup();
 }
 
@@ -192,6 +207,15 @@ void FindAvgOrientations::dataCheck()
   } /* Now assign the raw pointer to data from the DataArray<T> object */
 
   cDims[0] = 1;
+  if(getComputeOrientationSpread())
+  {
+    m_OrientationSpreadPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>, AbstractFilter, float>(this, getOrientationSpreadArrayPath(), 0, cDims, "", DataArrayID32);
+    if(nullptr != m_OrientationSpreadPtr.lock()) /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
+    {
+      m_OrientationSpread = m_OrientationSpreadPtr.lock()->getPointer(0);
+    } /* Now assign the raw pointer to data from the DataArray<T> object */
+  }
+
   m_CrystalStructuresPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<uint32_t>, AbstractFilter>(this, getCrystalStructuresArrayPath(),
                                                                                                                 cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
   if(nullptr != m_CrystalStructuresPtr.lock()) /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
@@ -231,46 +255,18 @@ void FindAvgOrientations::execute()
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   size_t totalFeatures = m_AvgQuatsPtr.lock()->getNumberOfTuples();
 
-  std::vector<float> counts(totalFeatures, 0.0f);
+  // Every cell is reduced against a fixed reference per Feature, so the cells can be summed in parallel
+  FeatureOrientationAverager averager;
+  averager.compute(m_FeatureIds, m_CellPhases, m_Quats, m_CrystalStructures, totalPoints, totalFeatures, getRefineAverage(), getComputeOrientationSpread());
 
-  int32_t phase = 0;
-  QuatF voxquat = QuaternionMathF::New();
-  QuatF curavgquat = QuaternionMathF::New();
   QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
-  QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
-
-  for(size_t i = 1; i < totalFeatures; i++)
-  {
-    QuaternionMathF::ElementWiseAssign(avgQuats[i], 0.0);
-  }
-
-  for(size_t i = 0; i < totalPoints; i++)
-  {
-    if(m_FeatureIds[i] > 0 && m_CellPhases[i] > 0)
-    {
-      counts[m_FeatureIds[i]] += 1.0f;
-      phase = m_CellPhases[i];
-      QuaternionMathF::Copy(quats[i], voxquat);
-      QuaternionMathF::Copy(avgQuats[m_FeatureIds[i]], curavgquat);
-      QuaternionMathF::ScalarDivide(curavgquat, counts[m_FeatureIds[i]]);
-
-      if(counts[m_FeatureIds[i]] == 1.0f)
-      {
-        QuaternionMathF::Identity(curavgquat);
-      }
-      m_OrientationOps[m_CrystalStructures[phase]]->getNearestQuat(curavgquat, voxquat);
-      QuaternionMathF::Add(avgQuats[m_FeatureIds[i]], voxquat, avgQuats[m_FeatureIds[i]]);
-    }
-  }
-
   for(size_t i = 1; i < totalFeatures; i++)
   {
-    if(counts[i] == 0.0f)
+    averager.getAverage(i, avgQuats[i]);
+    if(getComputeOrientationSpread())
     {
-      QuaternionMathF::Identity(avgQuats[i]);
+      m_OrientationSpread[i] = averager.getSpread(i);
     }
-    QuaternionMathF::ScalarDivide(avgQuats[i], counts[i]);
-    QuaternionMathF::UnitQuaternion(avgQuats[i]);
 
     FOrientArrayType eu(m_FeatureEulerAngles + (3 * i), 3);
     FOrientTransformsType::qu2eu(FOrientArrayType(avgQuats[i]), eu);
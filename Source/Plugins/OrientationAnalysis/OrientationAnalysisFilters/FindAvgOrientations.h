@@ -39,8 +39,6 @@
 #include "SIMPLib/Filtering/AbstractFilter.h"
 #include "SIMPLib/SIMPLib.h"
 
-#include "OrientationLib/LaueOps/LaueOps.h"
-
 #include "OrientationAnalysis/OrientationAnalysisDLLExport.h"
 
 /**
@@ -56,6 +54,9 @@ class OrientationAnalysis_EXPORT FindAvgOrientations : public AbstractFilter
     PYB11_PROPERTY(DataArrayPath CrystalStructuresArrayPath READ getCrystalStructuresArrayPath WRITE setCrystalStructuresArrayPath)
     PYB11_PROPERTY(DataArrayPath AvgQuatsArrayPath READ getAvgQuatsArrayPath WRITE setAvgQuatsArrayPath)
     PYB11_PROPERTY(DataArrayPath AvgEulerAnglesArrayPath READ getAvgEulerAnglesArrayPath WRITE setAvgEulerAnglesArrayPath)
+    PYB11_PROPERTY(bool RefineAverage READ getRefineAverage WRITE setRefineAverage)
+    PYB11_PROPERTY(bool ComputeOrientationSpread READ getComputeOrientationSpread WRITE setComputeOrientationSpread)
+    PYB11_PROPERTY(DataArrayPath OrientationSpreadArrayPath READ getOrientationSpreadArrayPath WRITE setOrientationSpreadArrayPath)
 public:
   SIMPL_SHARED_POINTERS(FindAvgOrientations)
   SIMPL_FILTER_NEW_MACRO(FindAvgOrientations)
@@ -81,6 +82,15 @@ public:
   SIMPL_FILTER_PARAMETER(DataArrayPath, AvgEulerAnglesArrayPath)
   Q_PROPERTY(DataArrayPath AvgEulerAnglesArrayPath READ getAvgEulerAnglesArrayPath WRITE setAvgEulerAnglesArrayPath)
 
+  SIMPL_FILTER_PARAMETER(bool, RefineAverage)
+  Q_PROPERTY(bool RefineAverage READ getRefineAverage WRITE setRefineAverage)
+
+  SIMPL_FILTER_PARAMETER(bool, ComputeOrientationSpread)
+  Q_PROPERTY(bool ComputeOrientationSpread READ getComputeOrientationSpread WRITE setComputeOrientationSpread)
+
+  SIMPL_FILTER_PARAMETER(DataArrayPath, OrientationSpreadArrayPath)
+  Q_PROPERTY(DataArrayPath OrientationSpreadArrayPath READ getOrientationSpreadArrayPath WRITE setOrientationSpreadArrayPath)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -182,8 +192,6 @@ protected:
   void initialize();
 
 private:
-  QVector<LaueOps::Pointer> m_OrientationOps;
-
   DEFINE_DATAARRAY_VARIABLE(int32_t, FeatureIds)
   DEFINE_DATAARRAY_VARIABLE(int32_t, CellPhases)
   DEFINE_DATAARRAY_VARIABLE(float, Quats)
@@ -191,6 +199,7 @@ private:
 
   DEFINE_DATAARRAY_VARIABLE(float, FeatureEulerAngles)
   DEFINE_DATAARRAY_VARIABLE(float, AvgQuats)
+  DEFINE_DATAARRAY_VARIABLE(float, OrientationSpread)
 
 public:
   FindAvgOrientations(const FindAvgOrientations&) = delete; // Copy Constructor Not Implemented
@@ -43,8 +43,10 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
+#include "SIMPLib/Math/MatrixMath.h"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/util/FeaturePairMetrics.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
 // -----------------------------------------------------------------------------
@@ -60,8 +62,6 @@ FindBoundaryStrengths::FindBoundaryStrengths()
 , m_SurfaceMeshF7sArrayName(SIMPL::FaceData::SurfaceMeshF7s)
 , m_SurfaceMeshmPrimesArrayName(SIMPL::FaceData::SurfaceMeshmPrimes)
 {
-  m_OrientationOps = LaueOps::getOrientationOpsQVector();
-
   m_Loading[0] = 1.0f;
   m_Loading[1] = 1.0f;
   m_Loading[2] = 1.0f;
@@ -275,12 +275,6 @@ void FindBoundaryStrengths::execute()
 
   size_t numTriangles = m_SurfaceMeshFaceLabelsPtr.lock()->getNumberOfTuples();
 
-  float mPrime_1 = 0.0f, mPrime_2 = 0.0f, F1_1 = 0.0f, F1_2 = 0.0f, F1spt_1 = 0.0f, F1spt_2 = 0.0f, F7_1 = 0.0f, F7_2 = 0.0f;
-  int32_t gname1 = 0, gname2 = 0;
-  QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
-  QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
-
   float LD[3] = {0.0f, 0.0f, 0.0f};
 
   LD[0] = m_Loading[0];
@@ -288,58 +282,24 @@ void FindBoundaryStrengths::execute()
   LD[2] = m_Loading[2];
   MatrixMath::Normalize3x1(LD);
 
+  // Many faces share the same pair of Features, so evaluate each unique pair once, in both
+  // directions, and scatter the values back to the faces
+  FeaturePairMetrics pairMetrics;
+  pairMetrics.buildFromFaceLabels(m_SurfaceMeshFaceLabels, numTriangles);
+  pairMetrics.evaluate(m_AvgQuats, m_FeaturePhases, m_CrystalStructures, LD,
+                       FeaturePairMetrics::MPrime | FeaturePairMetrics::F1 | FeaturePairMetrics::F1spt | FeaturePairMetrics::F7);
+
   for(size_t i = 0; i < numTriangles; i++)
   {
-    gname1 = m_SurfaceMeshFaceLabels[i * 2];
-    gname2 = m_SurfaceMeshFaceLabels[i * 2 + 1];
-    if(gname1 > 0 && gname2 > 0)
-    {
-      QuaternionMathF::Copy(avgQuats[gname1], q1);
-      QuaternionMathF::Copy(avgQuats[gname2], q2);
-      if(m_CrystalStructures[m_FeaturePhases[gname1]] == m_CrystalStructures[m_FeaturePhases[gname2]] && m_FeaturePhases[gname1] > 0)
-      {
-        m_OrientationOps[m_CrystalStructures[m_FeaturePhases[gname1]]]->getmPrime(q1, q2, LD, mPrime_1);
-        m_OrientationOps[m_CrystalStructures[m_FeaturePhases[gname1]]]->getmPrime(q2, q1, LD, mPrime_2);
-        m_OrientationOps[m_CrystalStructures[m_FeaturePhases[gname1]]]->getF1(q1, q2, LD, true, F1_1);
-        m_OrientationOps[m_CrystalStructures[m_FeaturePhases[gname1]]]->getF1(q2, q1, LD, true, F1_2);
-        m_OrientationOps[m_CrystalStructures[m_FeaturePhases[gname1]]]->getF1spt(q1, q2, LD, true, F1spt_1);
-        m_OrientationOps[m_CrystalStructures[m_FeaturePhases[gname1]]]->getF1spt(q2, q1, LD, true, F1spt_2);
-        m_OrientationOps[m_CrystalStructures[m_FeaturePhases[gname1]]]->getF7(q1, q2, LD, true, F7_1);
-        m_OrientationOps[m_CrystalStructures[m_FeaturePhases[gname1]]]->getF7(q2, q1, LD, true, F7_2);
-      }
-      else
-      {
-        mPrime_1 = 0.0f;
-        F1_1 = 0.0f;
-        F1spt_1 = 0.0f;
-        F7_1 = 0.0f;
-        mPrime_2 = 0.0f;
-        F1_2 = 0.0f;
-        F1spt_2 = 0.0f;
-        F7_2 = 0.0f;
-      }
-    }
-    else
-    {
-      mPrime_1 = 0.0f;
-      F1_1 = 0.0f;
-      F1spt_1 = 0.0f;
-      F7_1 = 0.0f;
-      mPrime_2 = 0.0f;
-      F1_2 = 0.0f;
-      F1spt_2 = 0.0f;
-      F7_2 = 0.0f;
-    }
-    m_SurfaceMeshmPrimes[2 * i] = mPrime_1;
-    m_SurfaceMeshmPrimes[2 * i + 1] = mPrime_2;
-    m_SurfaceMeshF1s[2 * i] = F1_1;
-    m_SurfaceMeshF1s[2 * i + 1] = F1_2;
-    m_SurfaceMeshF1spts[2 * i] = F1spt_1;
-    m_SurfaceMeshF1spts[2 * i + 1] = F1spt_2;
-    m_SurfaceMeshF7s[2 * i] = F7_1;
-    m_SurfaceMeshF7s[2 * i + 1] = F7_2;
+    m_SurfaceMeshmPrimes[2 * i] = pairMetrics.getValue(FeaturePairMetrics::MPrime, i);
+    m_SurfaceMeshmPrimes[2 * i + 1] = pairMetrics.getValue(FeaturePairMetrics::MPrime, i, true);
+    m_SurfaceMeshF1s[2 * i] = pairMetrics.getValue(FeaturePairMetrics::F1, i);
+    m_SurfaceMeshF1s[2 * i + 1] = pairMetrics.getValue(FeaturePairMetrics::F1, i, true);
+    m_SurfaceMeshF1spts[2 * i] = pairMetrics.getValue(FeaturePairMetrics::F1spt, i);
+    m_SurfaceMeshF1spts[2 * i + 1] = pairMetrics.getValue(FeaturePairMetrics::F1spt, i, true);
+    m_SurfaceMeshF7s[2 * i] = pairMetrics.getValue(FeaturePairMetrics::F7, i);
+    m_SurfaceMeshF7s[2 * i + 1] = pairMetrics.getValue(FeaturePairMetrics::F7, i, true);
   }
-
 }
 
 // -----------------------------------------------------------------------------
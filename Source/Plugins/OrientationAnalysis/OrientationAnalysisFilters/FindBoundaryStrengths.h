@@ -40,8 +40,6 @@
 #include "SIMPLib/Filtering/AbstractFilter.h"
 #include "SIMPLib/SIMPLib.h"
 
-#include "OrientationLib/LaueOps/LaueOps.h"
-
 #include "OrientationAnalysis/OrientationAnalysisDLLExport.h"
 
 /**
@@ -186,8 +184,6 @@ protected:
   FindBoundaryStrengths();
 
 private:
-  QVector<LaueOps::Pointer> m_OrientationOps;
-
   DEFINE_DATAARRAY_VARIABLE(int32_t, FeaturePhases)
   DEFINE_DATAARRAY_VARIABLE(float, AvgQuats)
   DEFINE_DATAARRAY_VARIABLE(unsigned int, CrystalStructures)
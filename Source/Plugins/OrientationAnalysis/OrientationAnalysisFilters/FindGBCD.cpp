@@ -34,7 +34,10 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
 #include "FindGBCD.h"
-#include <utility>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
 #include <tbb/blocked_range.h>
@@ -70,213 +73,238 @@ enum createdPathID : RenameDataPath::DataID_t
   DataArrayID31 = 31,
 };
 
+namespace
+{
+/**
+ * @brief The SymOpMatrix struct holds one symmetry operator as a rotation matrix
+ */
+struct SymOpMatrix
+{
+  float m[3][3];
+};
+
+/**
+ * @brief The GBCDSlab struct holds the private GBCD histograms of one slab of faces. The
+ * histogram of a phase is only allocated once a face of that phase is found.
+ */
+struct GBCDSlab
+{
+  std::vector<std::vector<double>> gbcd;
+  std::vector<double> faceArea;
+};
+
+// Number of slabs the faces are split into. This is fixed rather than taken from the thread
+// count so the order in which face areas are summed, and so the GBCD, is the same on every machine
+static const size_t k_NumSlabs = 16;
+
+// Upper bound on the memory held by the private histograms of all slabs
+static const size_t k_MaxSlabHistogramBytes = size_t(1) << 30;
+} // namespace
+
 /**
  * @brief The CalculateGBCDImpl class implements a threaded algorithm that calculates the
- * grain boundary character distribution (GBCD) for a surface mesh
+ * grain boundary character distribution (GBCD) for a surface mesh. A range of faces is split
+ * into slabs, and each slab adds the face areas directly into its own GBCD histograms
  */
 class CalculateGBCDImpl
 {
-  size_t startOffset;
-  size_t numEntriesPerTri;
-  Int32ArrayType::Pointer m_LabelsArray;
-  DoubleArrayType::Pointer m_NormalsArray;
-  Int32ArrayType::Pointer m_PhasesArray;
-  FloatArrayType::Pointer m_EulersArray;
-
-  FloatArrayType::Pointer m_GbcdDeltasArray;
-  FloatArrayType::Pointer m_GbcdLimitsArray;
-  Int32ArrayType::Pointer m_GbcdSizesArray;
-  Int32ArrayType::Pointer m_GbcdBinsArray;
-  BoolArrayType::Pointer m_GbcdHemiCheckArray;
-
-  UInt32ArrayType::Pointer m_CrystalStructuresArray;
-  QVector<LaueOps::Pointer> m_OrientationOps;
-
 public:
-  CalculateGBCDImpl(size_t i,
-                    size_t numMisoReps,
-                    Int32ArrayType::Pointer labels,
-                    DoubleArrayType::Pointer normals,
-                    FloatArrayType::Pointer eulers,
-                    Int32ArrayType::Pointer phases,
-                    UInt32ArrayType::Pointer crystalStructures,
-                    Int32ArrayType::Pointer bins,
-                    BoolArrayType::Pointer hemiCheck,
-                    FloatArrayType::Pointer gbcdDeltas,
-                    Int32ArrayType::Pointer gbcdSizes,
-                    FloatArrayType::Pointer gbcdLimits)
-  : startOffset(i)
-  , numEntriesPerTri(numMisoReps)
-  , m_LabelsArray(std::move(labels))
-  , m_NormalsArray(std::move(normals))
-  , m_PhasesArray(std::move(phases))
-  , m_EulersArray(std::move(eulers))
-  , m_GbcdDeltasArray(std::move(gbcdDeltas))
-  , m_GbcdLimitsArray(std::move(gbcdLimits))
-  , m_GbcdSizesArray(std::move(gbcdSizes))
-  , m_GbcdBinsArray(std::move(bins))
-  , m_GbcdHemiCheckArray(std::move(hemiCheck))
-  , m_CrystalStructuresArray(std::move(crystalStructures))
-  {
-    m_OrientationOps = LaueOps::getOrientationOpsQVector();
+  CalculateGBCDImpl(size_t firstFace, size_t lastFace, size_t numSlabs, const int32_t* labels, const double* normals, const double* areas, const float* eulers, const int32_t* phases,
+                    const uint32_t* crystalStructures, const std::vector<std::vector<SymOpMatrix>>& symOps, const float* gbcdDeltas, const int32_t* gbcdSizes, const float* gbcdLimits,
+                    size_t totalGBCDBins, std::vector<GBCDSlab>& slabs)
+  : m_FirstFace(firstFace)
+  , m_LastFace(lastFace)
+  , m_NumSlabs(numSlabs)
+  , m_Labels(labels)
+  , m_Normals(normals)
+  , m_Areas(areas)
+  , m_Eulers(eulers)
+  , m_Phases(phases)
+  , m_CrystalStructures(crystalStructures)
+  , m_SymOps(symOps)
+  , m_GbcdDeltas(gbcdDeltas)
+  , m_GbcdSizes(gbcdSizes)
+  , m_GbcdLimits(gbcdLimits)
+  , m_TotalGBCDBins(totalGBCDBins)
+  , m_Slabs(slabs)
+  {
   }
   virtual ~CalculateGBCDImpl() = default;
 
   void generate(size_t start, size_t end) const
   {
+    size_t numFaces = m_LastFace - m_FirstFace;
+    for(size_t s = start; s < end; s++)
+    {
+      accumulate(m_Slabs[s], m_FirstFace + numFaces * s / m_NumSlabs, m_FirstFace + numFaces * (s + 1) / m_NumSlabs);
+    }
+  }
 
-    // We want to work with the raw pointers for speed so get those pointers.
-    float* gbcdDeltas = m_GbcdDeltasArray->getPointer(0);
-    float* gbcdLimits = m_GbcdLimitsArray->getPointer(0);
-    int* gbcdSizes = m_GbcdSizesArray->getPointer(0);
-    int32_t* bins = m_GbcdBinsArray->getPointer(0);
-    bool* hemiCheck = m_GbcdHemiCheckArray->getPointer(0);
-
-    int32_t* labels = m_LabelsArray->getPointer(0);
-    double* normals = m_NormalsArray->getPointer(0);
-    int32_t* phases = m_PhasesArray->getPointer(0);
-    float* eulers = m_EulersArray->getPointer(0);
-    uint32_t* crystalStructures = m_CrystalStructuresArray->getPointer(0);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
 
-    int32_t j = 0; //, j4;
-    int32_t k = 0; //, k4;
+private:
+  size_t m_FirstFace;
+  size_t m_LastFace;
+  size_t m_NumSlabs;
+  const int32_t* m_Labels;
+  const double* m_Normals;
+  const double* m_Areas;
+  const float* m_Eulers;
+  const int32_t* m_Phases;
+  const uint32_t* m_CrystalStructures;
+  const std::vector<std::vector<SymOpMatrix>>& m_SymOps;
+  const float* m_GbcdDeltas;
+  const int32_t* m_GbcdSizes;
+  const float* m_GbcdLimits;
+  size_t m_TotalGBCDBins;
+  std::vector<GBCDSlab>& m_Slabs;
+
+  void accumulate(GBCDSlab& slab, size_t start, size_t end) const
+  {
+    int32_t j = 0;
+    int32_t k = 0;
     int32_t m = 0;
     int32_t temp = 0;
-    // bool gbcd_indices_good;
     int32_t feature1 = 0, feature2 = 0;
     int32_t inversion = 1;
     float g1ea[3] = {0.0f, 0.0f, 0.0f}, g2ea[3] = {0.0f, 0.0f, 0.0f};
     float g1[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}}, g2[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
     float g1s[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}}, g2s[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
     float sym1[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}}, sym2[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
-    float g2t[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}}, dg[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    float dg[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
     float euler_mis[3] = {0.0f, 0.0f, 0.0f};
     float normal[3] = {0.0f, 0.0f, 0.0f};
     float xstl1_norm1[3] = {0.0f, 0.0f, 0.0f};
     int32_t gbcd_index = 0;
     float sqCoord[2] = {0.0f, 0.0f}, sqCoordInv[2] = {0.0f, 0.0f};
     bool nhCheck = false, nhCheckInv = true;
-    int32_t SYMcounter = 0;
-    auto TRIcounter = static_cast<int64_t>(start - startOffset);
-    int64_t TRIcounterShift = 0;
+    std::vector<SymOpMatrix> g2t;
 
     for(size_t i = start; i < end; i++)
     {
-      SYMcounter = 0;
-      feature1 = labels[2 * i];
-      feature2 = labels[2 * i + 1];
-      normal[0] = normals[3 * i];
-      normal[1] = normals[3 * i + 1];
-      normal[2] = normals[3 * i + 2];
+      feature1 = m_Labels[2 * i];
+      feature2 = m_Labels[2 * i + 1];
+      normal[0] = m_Normals[3 * i];
+      normal[1] = m_Normals[3 * i + 1];
+      normal[2] = m_Normals[3 * i + 2];
 
       if(feature1 < 0 || feature2 < 0)
       {
         continue;
       }
+      int32_t phase = m_Phases[feature1];
+      if(phase != m_Phases[feature2] || phase <= 0)
+      {
+        continue;
+      }
+      uint32_t cryst = m_CrystalStructures[phase];
+      if(cryst >= m_SymOps.size())
+      {
+        continue;
+      }
+
+      std::vector<double>& gbcd = slab.gbcd[phase];
+      if(gbcd.empty())
+      {
+        gbcd.assign(m_TotalGBCDBins, 0.0);
+      }
+      double area = m_Areas[i];
+      double faceArea = 0.0;
 
-      if(phases[feature1] == phases[feature2] && phases[feature1] > 0)
+      const std::vector<SymOpMatrix>& symOps = m_SymOps[cryst];
+      int32_t nsym = static_cast<int32_t>(symOps.size());
+      g2t.resize(symOps.size());
+      for(int32_t q = 0; q < 2; q++)
       {
-        TRIcounterShift = (TRIcounter * numEntriesPerTri);
-        uint32_t cryst = crystalStructures[phases[feature1]];
-        for(int32_t q = 0; q < 2; q++)
+        if(q == 1)
         {
-          if(q == 1)
-          {
-            temp = feature1;
-            feature1 = feature2;
-            feature2 = temp;
-            normal[0] = -normal[0];
-            normal[1] = -normal[1];
-            normal[2] = -normal[2];
-          }
-          for(m = 0; m < 3; m++)
-          {
-            g1ea[m] = eulers[3 * feature1 + m];
-            g2ea[m] = eulers[3 * feature2 + m];
-          }
+          temp = feature1;
+          feature1 = feature2;
+          feature2 = temp;
+          normal[0] = -normal[0];
+          normal[1] = -normal[1];
+          normal[2] = -normal[2];
+        }
+        for(m = 0; m < 3; m++)
+        {
+          g1ea[m] = m_Eulers[3 * feature1 + m];
+          g2ea[m] = m_Eulers[3 * feature2 + m];
+        }
 
-          FOrientArrayType om(9, 0.0f);
-          FOrientTransformsType::eu2om(FOrientArrayType(g1ea, 3), om);
-          om.toGMatrix(g1);
+        FOrientArrayType om(9, 0.0f);
+        FOrientTransformsType::eu2om(FOrientArrayType(g1ea, 3), om);
+        om.toGMatrix(g1);
+
+        FOrientTransformsType::eu2om(FOrientArrayType(g2ea, 3), om);
+        om.toGMatrix(g2);
+
+        // The rotated and transposed g2 only depends on the second symmetry operator
+        for(k = 0; k < nsym; k++)
+        {
+          std::memcpy(sym2, symOps[k].m, sizeof(sym2));
+          MatrixMath::Multiply3x3with3x3(sym2, g2, g2s);
+          MatrixMath::Transpose3x3(g2s, g2t[k].m);
+        }
 
-          FOrientTransformsType::eu2om(FOrientArrayType(g2ea, 3), om);
-          om.toGMatrix(g2);
+        for(j = 0; j < nsym; j++)
+        {
+          // rotate g1 by symOp
+          std::memcpy(sym1, symOps[j].m, sizeof(sym1));
+          MatrixMath::Multiply3x3with3x3(sym1, g1, g1s);
+          // get the crystal directions along the triangle normals
+          MatrixMath::Multiply3x3with3x1(g1s, normal, xstl1_norm1);
+          // get coordinates in square projection of crystal normal parallel to boundary normal
+          nhCheck = getSquareCoord(xstl1_norm1, sqCoord);
+          if(inversion == 1)
+          {
+            sqCoordInv[0] = -sqCoord[0];
+            sqCoordInv[1] = -sqCoord[1];
+            nhCheckInv = !nhCheck;
+          }
 
-          int32_t nsym = m_OrientationOps[cryst]->getNumSymOps();
-          for(j = 0; j < nsym; j++)
+          for(k = 0; k < nsym; k++)
           {
-            // rotate g1 by symOp
-            m_OrientationOps[cryst]->getMatSymOp(j, sym1);
-            MatrixMath::Multiply3x3with3x3(sym1, g1, g1s);
-            // get the crystal directions along the triangle normals
-            MatrixMath::Multiply3x3with3x1(g1s, normal, xstl1_norm1);
-            // get coordinates in square projection of crystal normal parallel to boundary normal
-            nhCheck = getSquareCoord(xstl1_norm1, sqCoord);
-            if(inversion == 1)
-            {
-              sqCoordInv[0] = -sqCoord[0];
-              sqCoordInv[1] = -sqCoord[1];
-              nhCheckInv = !nhCheck;
-            }
+            // calculate delta g
+            MatrixMath::Multiply3x3with3x3(g1s, g2t[k].m, dg);
+            // translate matrix to euler angles
+            FOrientArrayType om(dg);
 
-            for(k = 0; k < nsym; k++)
+            FOrientArrayType eu(euler_mis, 3);
+            FOrientTransformsType::om2eu(om, eu);
+
+            if(euler_mis[0] < SIMPLib::Constants::k_PiOver2 && euler_mis[1] < SIMPLib::Constants::k_PiOver2 && euler_mis[2] < SIMPLib::Constants::k_PiOver2)
             {
-              // calculate the symmetric misorienation
-              m_OrientationOps[cryst]->getMatSymOp(k, sym2);
-              // rotate g2 by symOp
-              MatrixMath::Multiply3x3with3x3(sym2, g2, g2s);
-              // transpose rotated g2
-              MatrixMath::Transpose3x3(g2s, g2t);
-              // calculate delta g
-              MatrixMath::Multiply3x3with3x3(g1s, g2t, dg);
-              // translate matrix to euler angles
-              FOrientArrayType om(dg);
-
-              FOrientArrayType eu(euler_mis, 3);
-              FOrientTransformsType::om2eu(om, eu);
-
-              if(euler_mis[0] < SIMPLib::Constants::k_PiOver2 && euler_mis[1] < SIMPLib::Constants::k_PiOver2 && euler_mis[2] < SIMPLib::Constants::k_PiOver2)
+              // PHI euler angle is stored in GBCD as cos(PHI)
+              euler_mis[1] = cosf(euler_mis[1]);
+              // get the indexes that this point would be in the GBCD histogram
+              gbcd_index = GBCDIndex(m_GbcdDeltas, m_GbcdSizes, m_GbcdLimits, euler_mis, sqCoord);
+              if(gbcd_index != -1)
               {
-                // PHI euler angle is stored in GBCD as cos(PHI)
-                euler_mis[1] = cosf(euler_mis[1]);
-                // get the indexes that this point would be in the GBCD histogram
-                gbcd_index = GBCDIndex(gbcdDeltas, gbcdSizes, gbcdLimits, euler_mis, sqCoord);
+                gbcd[2 * gbcd_index + (nhCheck ? 0 : 1)] += area;
+                faceArea += area;
+              }
+              if(inversion == 1)
+              {
+                gbcd_index = GBCDIndex(m_GbcdDeltas, m_GbcdSizes, m_GbcdLimits, euler_mis, sqCoordInv);
                 if(gbcd_index != -1)
                 {
-                  hemiCheck[TRIcounterShift + SYMcounter] = nhCheck;
-                  bins[TRIcounterShift + SYMcounter] = gbcd_index;
-                }
-                SYMcounter++;
-                if(inversion == 1)
-                {
-                  gbcd_index = GBCDIndex(gbcdDeltas, gbcdSizes, gbcdLimits, euler_mis, sqCoordInv);
-                  if(gbcd_index != -1)
-                  {
-                    hemiCheck[TRIcounterShift + SYMcounter] = nhCheckInv;
-                    bins[TRIcounterShift + SYMcounter] = gbcd_index;
-                  }
-                  SYMcounter++;
+                  gbcd[2 * gbcd_index + (nhCheckInv ? 0 : 1)] += area;
+                  faceArea += area;
                 }
               }
-              else
-              {
-                SYMcounter += 2;
-              }
             }
           }
         }
       }
-      TRIcounter++;
+      slab.faceArea[phase] += faceArea;
     }
   }
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  void operator()(const tbb::blocked_range<size_t>& r) const
-  {
-    generate(r.begin(), r.end());
-  }
-#endif
-
   int32_t GBCDIndex(const float* gbcddelta, const int32_t* gbcdsz, const float* gbcdlimits, const float* eulerN, const float* sqCoord) const
   {
     int32_t gbcd_index;
@@ -360,6 +388,54 @@ public:
   }
 };
 
+/**
+ * @brief The MergeGBCDImpl class sums the slab histograms of one phase into the GBCD and scales
+ * the sums to multiples of random distribution. Slabs are summed in order so that the result
+ * does not depend on the thread scheduling
+ */
+class MergeGBCDImpl
+{
+public:
+  MergeGBCDImpl(const std::vector<GBCDSlab>& slabs, size_t phase, double mrdFactor, double* gbcd)
+  : m_Slabs(slabs)
+  , m_Phase(phase)
+  , m_MRDFactor(mrdFactor)
+  , m_GBCD(gbcd)
+  {
+  }
+  virtual ~MergeGBCDImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t b = start; b < end; b++)
+    {
+      double sum = 0.0;
+      for(const GBCDSlab& slab : m_Slabs)
+      {
+        const std::vector<double>& gbcd = slab.gbcd[m_Phase];
+        if(!gbcd.empty())
+        {
+          sum += gbcd[b];
+        }
+      }
+      m_GBCD[b] = sum * m_MRDFactor;
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const std::vector<GBCDSlab>& m_Slabs;
+  size_t m_Phase;
+  double m_MRDFactor;
+  double* m_GBCD;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -377,8 +453,6 @@ FindGBCD::FindGBCD()
   m_GbcdDeltasArray = FloatArrayType::NullPointer();
   m_GbcdSizesArray = Int32ArrayType::NullPointer();
   m_GbcdLimitsArray = FloatArrayType::NullPointer();
-  m_GbcdBinsArray = Int32ArrayType::NullPointer();
-  m_GbcdHemiCheckArray = BoolArrayType::NullPointer();
 }
 
 // -----------------------------------------------------------------------------
@@ -458,14 +532,10 @@ void FindGBCD::initialize()
   m_GbcdDeltasArray = FloatArrayType::NullPointer();
   m_GbcdSizesArray = Int32ArrayType::NullPointer();
   m_GbcdLimitsArray = FloatArrayType::NullPointer();
-  m_GbcdBinsArray = Int32ArrayType::NullPointer();
-  m_GbcdHemiCheckArray = BoolArrayType::NullPointer();
 
   m_GbcdDeltas = nullptr;
   m_GbcdSizes = nullptr;
   m_GbcdLimits = nullptr;
-  m_GbcdBins = nullptr;
-  m_HemiCheck = nullptr;
 }
 
 // -----------------------------------------------------------------------------
@@ -514,8 +584,8 @@ void FindGBCD::dataCheckSurfaceMesh()
     m_SurfaceMeshFaceAreas = m_SurfaceMeshFaceAreasPtr.lock()->getPointer(0);
   } /* Now assign the raw pointer to data from the DataArray<T> object */
 
-  // call the sizeGBCD function to get the GBCD ranges, dimensions, etc.  Note that the input parameters do not affect the size and can be dummy values here;
-  sizeGBCD(0, 0);
+  // call the sizeGBCD function to get the GBCD ranges, dimensions, etc.
+  sizeGBCD();
   cDims.resize(6);
   cDims[0] = m_GbcdSizes[0];
   cDims[1] = m_GbcdSizes[1];
@@ -611,14 +681,32 @@ void FindGBCD::execute()
   size_t totalPhases = m_CrystalStructuresPtr.lock()->getNumberOfTuples();
   size_t totalFaces = m_SurfaceMeshFaceLabelsPtr.lock()->getNumberOfTuples();
   size_t faceChunkSize = 50000;
-  size_t numMisoReps = 576 * 4;
-  if(totalFaces < faceChunkSize)
+  // call the sizeGBCD function to get the GBCD ranges and dimensions
+  sizeGBCD();
+  size_t totalGBCDBins = static_cast<size_t>(m_GbcdSizes[0]) * m_GbcdSizes[1] * m_GbcdSizes[2] * m_GbcdSizes[3] * m_GbcdSizes[4] * 2;
+
+  // Cache the symmetry operators of every crystal structure as matrices
+  QVector<LaueOps::Pointer> orientationOps = LaueOps::getOrientationOpsQVector();
+  std::vector<std::vector<SymOpMatrix>> symOps(orientationOps.size());
+  for(int32_t c = 0; c < orientationOps.size(); c++)
+  {
+    symOps[c].resize(orientationOps[c]->getNumSymOps());
+    for(size_t j = 0; j < symOps[c].size(); j++)
+    {
+      orientationOps[c]->getMatSymOp(static_cast<int32_t>(j), symOps[c][j].m);
+    }
+  }
+
+  // Each slab of faces accumulates into private histograms, one per phase, which are merged
+  // at the end. Limit the number of slabs so those histograms stay within a memory budget
+  size_t slabBytes = (totalPhases > 1 ? totalPhases - 1 : 1) * std::max(totalGBCDBins, size_t(1)) * sizeof(double);
+  size_t numSlabs = std::max(size_t(1), std::min(k_NumSlabs, k_MaxSlabHistogramBytes / slabBytes));
+  std::vector<GBCDSlab> slabs(numSlabs);
+  for(GBCDSlab& slab : slabs)
   {
-    faceChunkSize = totalFaces;
+    slab.gbcd.resize(totalPhases);
+    slab.faceArea.assign(totalPhases, 0.0);
   }
-  // call the sizeGBCD function with proper chunkSize and numMisoReps to get Bins array set up properly
-  sizeGBCD(faceChunkSize, numMisoReps);
-  int32_t totalGBCDBins = m_GbcdSizes[0] * m_GbcdSizes[1] * m_GbcdSizes[2] * m_GbcdSizes[3] * m_GbcdSizes[4] * 2;
 
   uint64_t millis = QDateTime::currentMSecsSinceEpoch();
   uint64_t currentMillis = millis;
@@ -626,12 +714,6 @@ void FindGBCD::execute()
   uint64_t estimatedTime = 0;
   float timeDiff = 0.0f;
   startMillis = QDateTime::currentMSecsSinceEpoch();
-  int32_t hemisphere = 0;
-
-  // create an array to hold the total face area for each phase and initialize the array to 0.0
-  DoubleArrayType::Pointer totalFaceAreaPtr = DoubleArrayType::CreateArray(totalPhases, "totalFaceArea");
-  totalFaceAreaPtr->initializeWithValue(0.0);
-  double* totalFaceArea = totalFaceAreaPtr->getPointer(0);
 
   QString ss = QObject::tr("Calculating GBCD || 0/%1 Completed").arg(totalFaces);
   for(size_t i = 0; i < totalFaces; i = i + faceChunkSize)
@@ -644,21 +726,17 @@ void FindGBCD::execute()
     {
       faceChunkSize = totalFaces - i;
     }
-    m_GbcdBinsArray->initializeWithValue(-1);
+    CalculateGBCDImpl body(i, i + faceChunkSize, numSlabs, m_SurfaceMeshFaceLabels, m_SurfaceMeshFaceNormals, m_SurfaceMeshFaceAreas, m_FeatureEulerAngles, m_FeaturePhases, m_CrystalStructures,
+                           symOps, m_GbcdDeltas, m_GbcdSizes, m_GbcdLimits, totalGBCDBins, slabs);
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    if(doParallel)
+    if(doParallel && numSlabs > 1)
     {
-      tbb::parallel_for(tbb::blocked_range<size_t>(i, i + faceChunkSize),
-                        CalculateGBCDImpl(i, numMisoReps, m_SurfaceMeshFaceLabelsPtr.lock(), m_SurfaceMeshFaceNormalsPtr.lock(), m_FeatureEulerAnglesPtr.lock(), m_FeaturePhasesPtr.lock(),
-                                          m_CrystalStructuresPtr.lock(), m_GbcdBinsArray, m_GbcdHemiCheckArray, m_GbcdDeltasArray, m_GbcdSizesArray, m_GbcdLimitsArray),
-                        tbb::auto_partitioner());
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlabs, 1), body, tbb::simple_partitioner());
     }
     else
 #endif
     {
-      CalculateGBCDImpl serial(i, numMisoReps, m_SurfaceMeshFaceLabelsPtr.lock(), m_SurfaceMeshFaceNormalsPtr.lock(), m_FeatureEulerAnglesPtr.lock(), m_FeaturePhasesPtr.lock(),
-                               m_CrystalStructuresPtr.lock(), m_GbcdBinsArray, m_GbcdHemiCheckArray, m_GbcdDeltasArray, m_GbcdSizesArray, m_GbcdLimitsArray);
-      serial.generate(i, i + faceChunkSize);
+      body.generate(0, numSlabs);
     }
 
     currentMillis = QDateTime::currentMSecsSinceEpoch();
@@ -671,59 +749,42 @@ void FindGBCD::execute()
       millis = QDateTime::currentMSecsSinceEpoch();
       notifyStatusMessage(ss);
     }
+  }
 
-    if(getCancel())
-    {
-      return;
-    }
-
-    int32_t phase = 0;
-    int32_t feature = 0;
-    double area = 0.0;
-    for(size_t j = 0; j < faceChunkSize; j++)
-    {
-      area = m_SurfaceMeshFaceAreas[i + j];
-      feature = m_SurfaceMeshFaceLabels[2 * (i + j)];
-      if(feature < 0) { continue; }
-      phase = m_FeaturePhases[feature];
-      for(size_t k = 0; k < numMisoReps; k++)
-      {
-        if(m_GbcdBins[(j * numMisoReps) + (k)] >= 0)
-        {
-          hemisphere = 0;
-          if(!m_HemiCheck[(j * numMisoReps) + k])
-          {
-            hemisphere = 1;
-          }
-          size_t gbcdBinIdx = (j * numMisoReps) + k;
-          size_t gbcdIdx = (phase * totalGBCDBins) + (2 * m_GbcdBins[gbcdBinIdx] + hemisphere);
-          m_GBCD[gbcdIdx] += area;
-          totalFaceArea[phase] += area;
-        }
-      }
-    }
+  if(getCancel())
+  {
+    return;
   }
 
   ss = QObject::tr("Starting GBCD Normalization");
   notifyStatusMessage(ss);
 
-  for(int32_t i = 0; i < totalPhases; i++)
+  for(size_t i = 0; i < totalPhases; i++)
   {
-    size_t phaseShift = i * totalGBCDBins;
-    double MRDfactor = double(totalGBCDBins) / totalFaceArea[i];
-    for(int32_t j = 0; j < totalGBCDBins; j++)
+    double totalFaceArea = 0.0;
+    for(const GBCDSlab& slab : slabs)
     {
-      m_GBCD[phaseShift + j] *= MRDfactor;
+      totalFaceArea += slab.faceArea[i];
+    }
+    double MRDfactor = double(totalGBCDBins) / totalFaceArea;
+    MergeGBCDImpl merge(slabs, i, MRDfactor, m_GBCD + i * totalGBCDBins);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel && numSlabs > 1)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, totalGBCDBins), merge, tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      merge.convert(0, totalGBCDBins);
     }
   }
-
-
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void FindGBCD::sizeGBCD(size_t faceChunkSize, size_t numMisoReps)
+void FindGBCD::sizeGBCD()
 {
   m_GbcdDeltasArray = FloatArrayType::CreateArray(5, "GBCDDeltas");
   m_GbcdDeltasArray->initializeWithZeros();
@@ -731,17 +792,10 @@ void FindGBCD::sizeGBCD(size_t faceChunkSize, size_t numMisoReps)
   m_GbcdLimitsArray->initializeWithZeros();
   m_GbcdSizesArray = Int32ArrayType::CreateArray(5, "GBCDSizes");
   m_GbcdSizesArray->initializeWithZeros();
-  QVector<size_t> cDims(1, numMisoReps);
-  m_GbcdBinsArray = Int32ArrayType::CreateArray(faceChunkSize, cDims, "GBCDBins");
-  m_GbcdBinsArray->initializeWithZeros();
-  m_GbcdHemiCheckArray = BoolArrayType::CreateArray(faceChunkSize, cDims, "GBCDHemiCheck");
-  m_GbcdHemiCheckArray->initializeWithValue(false);
 
   m_GbcdDeltas = m_GbcdDeltasArray->getPointer(0);
   m_GbcdSizes = m_GbcdSizesArray->getPointer(0);
   m_GbcdLimits = m_GbcdLimitsArray->getPointer(0);
-  m_GbcdBins = m_GbcdBinsArray->getPointer(0);
-  m_HemiCheck = m_GbcdHemiCheckArray->getPointer(0);
 
   // Original Ranges from Dave R.
   // m_GBCDlimits[0] = 0.0f;
@@ -45,6 +45,9 @@
 
 #include "FindGBCDMetricBased.h"
 
+#include <cstring>
+#include <vector>
+
 #include <QtCore/QDir>
 
 #include "SIMPLib/Common/Constants.h"
@@ -63,6 +66,7 @@
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/util/SphericalPointIndex.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
@@ -81,6 +85,22 @@ const double FindGBCDMetricBased::k_BallVolumesM3M[FindGBCDMetricBased::k_Number
 namespace GBCDMetricBased
 {
 
+/**
+ * @brief The Matrix3x3 struct wraps a 3x3 matrix so that it can be stored in a vector
+ */
+struct Matrix3x3
+{
+  float m[3][3];
+};
+
+/**
+ * @brief The Vector3 struct wraps a 3 component vector so that it can be stored in a vector
+ */
+struct Vector3
+{
+  float v[3];
+};
+
 /**
  * @brief The TriAreaAndNormals class defines a container that stores the area of a given triangle
  * and the two normals for grains on either side of the triangle
@@ -133,8 +153,7 @@ class TrisSelector
   int32_t m_PhaseOfInterest;
   float (&gFixedT)[3][3];
 
-  QVector<LaueOps::Pointer> m_OrientationOps;
-  uint32_t cryst;
+  std::vector<Matrix3x3> m_SymOps;
   int32_t nsym;
 
   float* m_Eulers;
@@ -167,9 +186,14 @@ public:
   , m_FaceNormals(__m_FaceNormals)
   , m_FaceAreas(__m_FaceAreas)
   {
-    m_OrientationOps = LaueOps::getOrientationOpsQVector();
-    cryst = __m_CrystalStructures[__m_PhaseOfInterest];
-    nsym = m_OrientationOps[cryst]->getNumSymOps();
+    QVector<LaueOps::Pointer> orientationOps = LaueOps::getOrientationOpsQVector();
+    uint32_t cryst = __m_CrystalStructures[__m_PhaseOfInterest];
+    nsym = orientationOps[cryst]->getNumSymOps();
+    m_SymOps.resize(nsym);
+    for(int j = 0; j < nsym; j++)
+    {
+      orientationOps[cryst]->getMatSymOp(j, m_SymOps[j].m);
+    }
   }
 
   virtual ~TrisSelector() = default;
@@ -182,13 +206,13 @@ public:
     float g1[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
     float g2[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
 
-    float g1s[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
     float g2s[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
 
-    float sym1[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
-    float sym2[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    float sym[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
 
-    float g2sT[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    std::vector<Matrix3x3> g1Sym(nsym);
+    std::vector<Matrix3x3> g2SymT(nsym);
+    std::vector<Vector3> normalsGrain1(nsym);
 
     float dg[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
     float dgT[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
@@ -196,7 +220,6 @@ public:
     float diffFromFixed[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
 
     float normal_lab[3] = {0.0f, 0.0f, 0.0f};
-    float normal_grain1[3] = {0.0f, 0.0f, 0.0f};
     float normal_grain2[3] = {0.0f, 0.0f, 0.0f};
 
     for(size_t triIdx = start; triIdx < end; triIdx++)
@@ -248,24 +271,29 @@ public:
       FOrientTransformsType::eu2om(FOrientArrayType(g2ea, 3), om);
       om.toGMatrix(g2);
 
+      // The symmetric equivalents of g1 and the transposed symmetric equivalents of g2 only
+      // depend on one symmetry operator each, so compute them once per triangle
       for(int j = 0; j < nsym; j++)
       {
+        std::memcpy(sym, m_SymOps[j].m, sizeof(sym));
         // rotate g1 by symOp
-        m_OrientationOps[cryst]->getMatSymOp(j, sym1);
-        MatrixMath::Multiply3x3with3x3(sym1, g1, g1s);
+        MatrixMath::Multiply3x3with3x3(sym, g1, g1Sym[j].m);
         // get the crystal directions along the triangle normals
-        MatrixMath::Multiply3x3with3x1(g1s, normal_lab, normal_grain1);
+        MatrixMath::Multiply3x3with3x1(g1Sym[j].m, normal_lab, normalsGrain1[j].v);
+        // rotate g2 by symOp
+        MatrixMath::Multiply3x3with3x3(sym, g2, g2s);
+        // transpose rotated g2
+        MatrixMath::Transpose3x3(g2s, g2SymT[j].m);
+      }
+
+      for(int j = 0; j < nsym; j++)
+      {
+        float* normal_grain1 = normalsGrain1[j].v;
 
         for(int k = 0; k < nsym; k++)
         {
-          // calculate the symmetric misorienation
-          m_OrientationOps[cryst]->getMatSymOp(k, sym2);
-          // rotate g2 by symOp
-          MatrixMath::Multiply3x3with3x3(sym2, g2, g2s);
-          // transpose rotated g2
-          MatrixMath::Transpose3x3(g2s, g2sT);
           // calculate delta g
-          MatrixMath::Multiply3x3with3x3(g1s, g2sT, dg); // dg -- the misorientation between adjacent grains
+          MatrixMath::Multiply3x3with3x3(g1Sym[j].m, g2SymT[k].m, dg); // dg -- the misorientation between adjacent grains
           MatrixMath::Transpose3x3(dg, dgT);
 
           for(int transpose = 0; transpose <= 1; transpose++)
@@ -311,45 +339,43 @@ public:
 
 /**
  * @brief The ProbeDistrib class implements a threaded algorithm that determines the distribution values
- * for the GBCD
+ * for the GBCD. A range of selected triangles is split into slabs; each triangle only tests the
+ * sampling points near its normal, and each slab adds the triangle areas into its own sums
  */
 class ProbeDistrib
 {
-  QVector<double>* distribValues = nullptr;
-  QVector<double>* errorValues = nullptr;
-  QVector<float> samplPtsX;
-  QVector<float> samplPtsY;
-  QVector<float> samplPtsZ;
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::concurrent_vector<TriAreaAndNormals> selectedTris;
+  const tbb::concurrent_vector<TriAreaAndNormals>& selectedTris;
 #else
-  QVector<TriAreaAndNormals> selectedTris;
+  const QVector<TriAreaAndNormals>& selectedTris;
 #endif
+  size_t firstTri;
+  size_t lastTri;
+  size_t numSlabs;
+  const SphericalPointIndex& samplPtsIndex;
+  const float* fixedNormals1;
+  const float* fixedNormals2;
   float planeResolSq;
-  double totalFaceArea;
-  int numDistinctGBs;
-  double ballVolume;
-  float (&gFixedT)[3][3];
+  std::vector<std::vector<double>>& slabValues;
 
 public:
-  ProbeDistrib(QVector<double>* __distribValues, QVector<double>* __errorValues, QVector<float> __samplPtsX, QVector<float> __samplPtsY, QVector<float> __samplPtsZ,
+  ProbeDistrib(
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-               tbb::concurrent_vector<TriAreaAndNormals> __selectedTris,
+      const tbb::concurrent_vector<TriAreaAndNormals>& __selectedTris,
 #else
-               QVector<TriAreaAndNormals> __selectedTris,
+      const QVector<TriAreaAndNormals>& __selectedTris,
 #endif
-               float __planeResolSq, double __totalFaceArea, int __numDistinctGBs, double __ballVolume, float (&__gFixedT)[3][3])
-  : distribValues(__distribValues)
-  , errorValues(__errorValues)
-  , samplPtsX(__samplPtsX)
-  , samplPtsY(__samplPtsY)
-  , samplPtsZ(__samplPtsZ)
-  , selectedTris(__selectedTris)
+      size_t __firstTri, size_t __lastTri, size_t __numSlabs, const SphericalPointIndex& __samplPtsIndex, const float* __fixedNormals1, const float* __fixedNormals2, float __planeResolSq,
+      std::vector<std::vector<double>>& __slabValues)
+  : selectedTris(__selectedTris)
+  , firstTri(__firstTri)
+  , lastTri(__lastTri)
+  , numSlabs(__numSlabs)
+  , samplPtsIndex(__samplPtsIndex)
+  , fixedNormals1(__fixedNormals1)
+  , fixedNormals2(__fixedNormals2)
   , planeResolSq(__planeResolSq)
-  , totalFaceArea(__totalFaceArea)
-  , numDistinctGBs(__numDistinctGBs)
-  , ballVolume(__ballVolume)
-  , gFixedT(__gFixedT)
+  , slabValues(__slabValues)
   {
   }
 
@@ -357,14 +383,15 @@ public:
 
   void probe(size_t start, size_t end) const
   {
-    for(size_t ptIdx = start; ptIdx < end; ptIdx++)
+    std::vector<int32_t> candidates;
+    size_t numTris = lastTri - firstTri;
+    for(size_t slab = start; slab < end; slab++)
     {
-      float fixedNormal1[3] = {samplPtsX.at(ptIdx), samplPtsY.at(ptIdx), samplPtsZ.at(ptIdx)};
-      float fixedNormal2[3] = {0.0f, 0.0f, 0.0f};
-      MatrixMath::Multiply3x3with3x1(gFixedT, fixedNormal1, fixedNormal2);
-
-      for(int triRepresIdx = 0; triRepresIdx < static_cast<int>(selectedTris.size()); triRepresIdx++)
+      std::vector<double>& distribValues = slabValues[slab];
+      size_t slabEnd = firstTri + numTris * (slab + 1) / numSlabs;
+      for(size_t triRepresIdx = firstTri + numTris * slab / numSlabs; triRepresIdx < slabEnd; triRepresIdx++)
       {
+        const TriAreaAndNormals& tri = selectedTris[triRepresIdx];
         for(int inversion = 0; inversion <= 1; inversion++)
         {
           float sign = 1.0f;
@@ -373,24 +400,28 @@ public:
             sign = -1.0f;
           }
 
-          float theta1 = acosf(sign * (selectedTris[triRepresIdx].normal_grain1_x * fixedNormal1[0] + selectedTris[triRepresIdx].normal_grain1_y * fixedNormal1[1] +
-                                       selectedTris[triRepresIdx].normal_grain1_z * fixedNormal1[2]));
+          // theta1 alone must be within sqrt(2) * the plane resolution, so only nearby points can match
+          float searchNormal[3] = {sign * tri.normal_grain1_x, sign * tri.normal_grain1_y, sign * tri.normal_grain1_z};
+          samplPtsIndex.findCandidates(searchNormal, candidates);
 
-          float theta2 = acosf(-sign * (selectedTris[triRepresIdx].normal_grain2_x * fixedNormal2[0] + selectedTris[triRepresIdx].normal_grain2_y * fixedNormal2[1] +
-                                        selectedTris[triRepresIdx].normal_grain2_z * fixedNormal2[2]));
+          for(int32_t ptIdx : candidates)
+          {
+            const float* fixedNormal1 = fixedNormals1 + 3 * ptIdx;
+            const float* fixedNormal2 = fixedNormals2 + 3 * ptIdx;
 
-          float distSq = 0.5f * (theta1 * theta1 + theta2 * theta2);
+            float theta1 = acosf(sign * (tri.normal_grain1_x * fixedNormal1[0] + tri.normal_grain1_y * fixedNormal1[1] + tri.normal_grain1_z * fixedNormal1[2]));
 
-          if(distSq < planeResolSq)
-          {
-            (*distribValues)[ptIdx] += selectedTris[triRepresIdx].area;
+            float theta2 = acosf(-sign * (tri.normal_grain2_x * fixedNormal2[0] + tri.normal_grain2_y * fixedNormal2[1] + tri.normal_grain2_z * fixedNormal2[2]));
+
+            float distSq = 0.5f * (theta1 * theta1 + theta2 * theta2);
+
+            if(distSq < planeResolSq)
+            {
+              distribValues[ptIdx] += tri.area;
+            }
           }
         }
       }
-      (*errorValues)[ptIdx] = sqrt((*distribValues)[ptIdx] / totalFaceArea / double(numDistinctGBs)) / ballVolume;
-
-      (*distribValues)[ptIdx] /= totalFaceArea;
-      (*distribValues)[ptIdx] /= ballVolume;
     }
   }
 
@@ -974,38 +1005,67 @@ void FindGBCDMetricBased::execute()
   QVector<double> distribValues(samplPtsX.size(), 0.0);
   QVector<double> errorValues(samplPtsX.size(), 0.0);
 
-  int32_t pointsChunkSize = 100;
-  if(samplPtsX.size() < pointsChunkSize)
+  // Index the sampling points so that each triangle only tests the points near its normal
+  int32_t numSamplPts = samplPtsX.size();
+  SphericalPointIndex samplPtsIndex;
+  samplPtsIndex.build(samplPtsX.data(), samplPtsY.data(), samplPtsZ.data(), numSamplPts, sqrtf(2.0f * m_PlaneResolSq));
+
+  std::vector<float> fixedNormals1(3 * numSamplPts, 0.0f);
+  std::vector<float> fixedNormals2(3 * numSamplPts, 0.0f);
+  for(int32_t ptIdx = 0; ptIdx < numSamplPts; ptIdx++)
   {
-    pointsChunkSize = samplPtsX.size();
+    float* fixedNormal1 = fixedNormals1.data() + 3 * ptIdx;
+    fixedNormal1[0] = samplPtsX.at(ptIdx);
+    fixedNormal1[1] = samplPtsY.at(ptIdx);
+    fixedNormal1[2] = samplPtsZ.at(ptIdx);
+    MatrixMath::Multiply3x3with3x1(gFixedT, fixedNormal1, fixedNormals2.data() + 3 * ptIdx);
   }
 
-  for(int32_t i = 0; i < samplPtsX.size(); i = i + pointsChunkSize)
+  // Each slab of triangles accumulates into its own distribution values, merged in slab order below
+  size_t numSlabs = 1;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  numSlabs = static_cast<size_t>(tbb::task_scheduler_init::default_num_threads());
+#endif
+  std::vector<std::vector<double>> slabValues(numSlabs, std::vector<double>(numSamplPts, 0.0));
+
+  size_t numSelectedTris = selectedTris.size();
+  trisChunkSize = 50000;
+  for(size_t i = 0; i < numSelectedTris; i = i + trisChunkSize)
   {
     if(getCancel())
     {
       return;
     }
-    ss = QObject::tr("|| Step 2/2: Computing Distribution Values at the Section of Interest (%1% completed)").arg(int(100.0 * float(i) / float(samplPtsX.size())));
+    ss = QObject::tr("|| Step 2/2: Computing Distribution Values at the Section of Interest (%1% completed)").arg(int(100.0 * float(i) / float(numSelectedTris)));
     notifyStatusMessage(ss);
-    if(i + pointsChunkSize >= samplPtsX.size())
+    if(i + trisChunkSize >= numSelectedTris)
     {
-      pointsChunkSize = samplPtsX.size() - i;
+      trisChunkSize = numSelectedTris - i;
     }
 
+    GBCDMetricBased::ProbeDistrib body(selectedTris, i, i + trisChunkSize, numSlabs, samplPtsIndex, fixedNormals1.data(), fixedNormals2.data(), m_PlaneResolSq, slabValues);
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    if(doParallel)
+    if(doParallel && numSlabs > 1)
     {
-      tbb::parallel_for(tbb::blocked_range<size_t>(i, i + pointsChunkSize),
-                        GBCDMetricBased::ProbeDistrib(&distribValues, &errorValues, samplPtsX, samplPtsY, samplPtsZ, selectedTris, m_PlaneResolSq, totalFaceArea, numDistinctGBs, ballVolume, gFixedT),
-                        tbb::auto_partitioner());
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlabs, 1), body, tbb::simple_partitioner());
     }
     else
 #endif
     {
-      GBCDMetricBased::ProbeDistrib serial(&distribValues, &errorValues, samplPtsX, samplPtsY, samplPtsZ, selectedTris, m_PlaneResolSq, totalFaceArea, numDistinctGBs, ballVolume, gFixedT);
-      serial.probe(i, i + pointsChunkSize);
+      body.probe(0, numSlabs);
+    }
+  }
+
+  for(int32_t ptIdx = 0; ptIdx < numSamplPts; ptIdx++)
+  {
+    for(size_t slab = 0; slab < numSlabs; slab++)
+    {
+      distribValues[ptIdx] += slabValues[slab][ptIdx];
     }
+    errorValues[ptIdx] = sqrt(distribValues[ptIdx] / totalFaceArea / double(numDistinctGBs)) / ballVolume;
+
+    distribValues[ptIdx] /= totalFaceArea;
+    distribValues[ptIdx] /= ballVolume;
   }
 
   // ------------------------------------------- writing the output --------------------------------
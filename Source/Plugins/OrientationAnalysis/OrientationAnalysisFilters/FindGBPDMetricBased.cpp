@@ -45,6 +45,9 @@
 
 #include "FindGBPDMetricBased.h"
 
+#include <cstring>
+#include <vector>
+
 #include <QtCore/QDir>
 
 #include "SIMPLib/Common/Constants.h"
@@ -63,6 +66,7 @@
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/util/SphericalPointIndex.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
@@ -76,6 +80,14 @@
 namespace GBPDMetricBased
 {
 
+/**
+ * @brief The Matrix3x3 struct wraps a 3x3 matrix so that it can be stored in a vector
+ */
+struct Matrix3x3
+{
+  float m[3][3];
+};
+
 /**
  * @brief The TriAreaAndNormals class defines a container that stores the area of a given triangle
  * and the two normals for grains on either side of the triangle
@@ -240,73 +252,100 @@ public:
 
 /**
  * @brief The ProbeDistrib class implements a threaded algorithm that determines the distribution values
- * for the GBPD
+ * for the GBPD. A range of selected triangles is split into slabs; each symmetric equivalent of a
+ * triangle normal only tests the sampling points near it, and each slab adds the triangle areas
+ * into its own (Kahan compensated) sums
  */
 class ProbeDistrib
 {
-  QVector<double>* distribValues;
-  QVector<double>* errorValues;
-  QVector<float>* samplPtsX;
-  QVector<float>* samplPtsY;
-  QVector<float>* samplPtsZ;
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::concurrent_vector<TriAreaAndNormals> selectedTris;
+  const tbb::concurrent_vector<TriAreaAndNormals>& selectedTris;
 #else
-  QVector<TriAreaAndNormals> selectedTris;
+  const QVector<TriAreaAndNormals>& selectedTris;
 #endif
+  size_t firstTri;
+  size_t lastTri;
+  size_t numSlabs;
+  const SphericalPointIndex& samplPtsIndex;
+  const float* samplPts;
+  const std::vector<Matrix3x3>& symOps;
   float limitDist;
-  double totalFaceArea;
-  int numDistinctGBs;
-  double ballVolume;
-  QVector<LaueOps::Pointer> m_OrientationOps;
-  uint32_t cryst;
-  int32_t nsym;
+  std::vector<std::vector<double>>& slabValues;
+  std::vector<std::vector<double>>& slabCompensations;
 
 public:
-  ProbeDistrib(QVector<double>* __distribValues, QVector<double>* __errorValues, QVector<float>* __samplPtsX, QVector<float>* __samplPtsY, QVector<float>* __samplPtsZ,
+  ProbeDistrib(
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-               tbb::concurrent_vector<TriAreaAndNormals> __selectedTris,
+      const tbb::concurrent_vector<TriAreaAndNormals>& __selectedTris,
 #else
-               QVector<TriAreaAndNormals> __selectedTris,
+      const QVector<TriAreaAndNormals>& __selectedTris,
 #endif
-               float __limitDist, double __totalFaceArea, int __numDistinctGBs, double __ballVolume, int32_t __cryst)
-  : distribValues(__distribValues)
-  , errorValues(__errorValues)
-  , samplPtsX(__samplPtsX)
-  , samplPtsY(__samplPtsY)
-  , samplPtsZ(__samplPtsZ)
-  , selectedTris(__selectedTris)
+      size_t __firstTri, size_t __lastTri, size_t __numSlabs, const SphericalPointIndex& __samplPtsIndex, const float* __samplPts, const std::vector<Matrix3x3>& __symOps, float __limitDist,
+      std::vector<std::vector<double>>& __slabValues, std::vector<std::vector<double>>& __slabCompensations)
+  : selectedTris(__selectedTris)
+  , firstTri(__firstTri)
+  , lastTri(__lastTri)
+  , numSlabs(__numSlabs)
+  , samplPtsIndex(__samplPtsIndex)
+  , samplPts(__samplPts)
+  , symOps(__symOps)
   , limitDist(__limitDist)
-  , totalFaceArea(__totalFaceArea)
-  , numDistinctGBs(__numDistinctGBs)
-  , ballVolume(__ballVolume)
-  , cryst(__cryst)
+  , slabValues(__slabValues)
+  , slabCompensations(__slabCompensations)
   {
-    m_OrientationOps = LaueOps::getOrientationOpsQVector();
-    nsym = m_OrientationOps[__cryst]->getNumSymOps();
   }
 
   virtual ~ProbeDistrib() = default;
 
-  void probe(size_t start, size_t end) const
+  /**
+   * @brief addArea Adds a triangle area to the distribution value of one sampling point (Kahan summation algorithm)
+   */
+  static void addArea(double area, double& value, double& compensation)
   {
-    for(size_t ptIdx = start; ptIdx < end; ptIdx++)
-    {
-      double __c = 0.0;
-
-      float probeNormal[3] = {(*samplPtsX).at(ptIdx), (*samplPtsY).at(ptIdx), (*samplPtsZ).at(ptIdx)};
+    double __y = area - compensation;
+    double __t = value + __y;
+    compensation = (__t - value);
+    compensation -= __y;
+    value = __t;
+  }
 
-      for(int triRepresIdx = 0; triRepresIdx < static_cast<int>(selectedTris.size()); triRepresIdx++)
+  /**
+   * @brief accumulate Adds a triangle area to every sampling point within the limiting distance of a symmetric normal
+   */
+  void accumulate(const float symNormal[3], float sign, double area, std::vector<int32_t>& candidates, std::vector<double>& distribValues, std::vector<double>& compensations) const
+  {
+    float searchNormal[3] = {sign * symNormal[0], sign * symNormal[1], sign * symNormal[2]};
+    samplPtsIndex.findCandidates(searchNormal, candidates);
+    for(int32_t ptIdx : candidates)
+    {
+      const float* probeNormal = samplPts + 3 * ptIdx;
+      float gamma = acosf(sign * (probeNormal[0] * symNormal[0] + probeNormal[1] * symNormal[1] + probeNormal[2] * symNormal[2]));
+      if(gamma < limitDist)
       {
-        float normal1[3] = {selectedTris[triRepresIdx].normal_grain1_x, selectedTris[triRepresIdx].normal_grain1_y, selectedTris[triRepresIdx].normal_grain1_z};
-
-        float normal2[3] = {selectedTris[triRepresIdx].normal_grain2_x, selectedTris[triRepresIdx].normal_grain2_y, selectedTris[triRepresIdx].normal_grain2_z};
+        addArea(area, distribValues[ptIdx], compensations[ptIdx]);
+      }
+    }
+  }
 
-        float sym[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+  void probe(size_t start, size_t end) const
+  {
+    std::vector<int32_t> candidates;
+    float sym[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    size_t numTris = lastTri - firstTri;
+    for(size_t slab = start; slab < end; slab++)
+    {
+      std::vector<double>& distribValues = slabValues[slab];
+      std::vector<double>& compensations = slabCompensations[slab];
+      size_t slabEnd = firstTri + numTris * (slab + 1) / numSlabs;
+      for(size_t triRepresIdx = firstTri + numTris * slab / numSlabs; triRepresIdx < slabEnd; triRepresIdx++)
+      {
+        const TriAreaAndNormals& tri = selectedTris[triRepresIdx];
+        float normal1[3] = {tri.normal_grain1_x, tri.normal_grain1_y, tri.normal_grain1_z};
+        float normal2[3] = {tri.normal_grain2_x, tri.normal_grain2_y, tri.normal_grain2_z};
 
-        for(int j = 0; j < nsym; j++)
+        for(const Matrix3x3& symOp : symOps)
         {
-          m_OrientationOps[cryst]->getMatSymOp(j, sym);
+          std::memcpy(sym, symOp.m, sizeof(sym));
 
           float sym_normal1[3] = {0.0f, 0.0f, 0.0f};
           float sym_normal2[3] = {0.0f, 0.0f, 0.0f};
@@ -322,33 +361,11 @@ public:
               sign = -1.0f;
             }
 
-            float gamma1 = acosf(sign * (probeNormal[0] * sym_normal1[0] + probeNormal[1] * sym_normal1[1] + probeNormal[2] * sym_normal1[2]));
-
-            float gamma2 = acosf(sign * (probeNormal[0] * sym_normal2[0] + probeNormal[1] * sym_normal2[1] + probeNormal[2] * sym_normal2[2]));
-
-            if(gamma1 < limitDist)
-            {
-              // Kahan summation algorithm
-              double __y = selectedTris[triRepresIdx].area - __c;
-              double __t = (*distribValues)[ptIdx] + __y;
-              __c = (__t - (*distribValues)[ptIdx]);
-              __c -= __y;
-              (*distribValues)[ptIdx] = __t;
-            }
-            if(gamma2 < limitDist)
-            {
-              double __y = selectedTris[triRepresIdx].area - __c;
-              double __t = (*distribValues)[ptIdx] + __y;
-              __c = (__t - (*distribValues)[ptIdx]);
-              __c -= __y;
-              (*distribValues)[ptIdx] = __t;
-            }
+            accumulate(sym_normal1, sign, tri.area, candidates, distribValues, compensations);
+            accumulate(sym_normal2, sign, tri.area, candidates, distribValues, compensations);
           }
         }
       }
-      (*errorValues)[ptIdx] = sqrt((*distribValues)[ptIdx] / totalFaceArea / double(numDistinctGBs)) / ballVolume;
-      (*distribValues)[ptIdx] /= totalFaceArea;
-      (*distribValues)[ptIdx] /= ballVolume;
     }
   }
 
@@ -1054,38 +1071,71 @@ void FindGBPDMetricBased::execute()
   QVector<double> distribValues(samplPtsX.size(), 0.0);
   QVector<double> errorValues(samplPtsX.size(), 0.0);
 
-  int32_t pointsChunkSize = 20;
-  if(samplPtsX.size() < pointsChunkSize)
+  // Index the sampling points so that each symmetric normal only tests the points near it
+  int32_t numSamplPts = samplPtsX.size();
+  SphericalPointIndex samplPtsIndex;
+  samplPtsIndex.build(samplPtsX.data(), samplPtsY.data(), samplPtsZ.data(), numSamplPts, m_LimitDist);
+
+  std::vector<float> samplPts(3 * numSamplPts, 0.0f);
+  for(int32_t ptIdx = 0; ptIdx < numSamplPts; ptIdx++)
   {
-    pointsChunkSize = samplPtsX.size();
+    samplPts[3 * ptIdx] = samplPtsX.at(ptIdx);
+    samplPts[3 * ptIdx + 1] = samplPtsY.at(ptIdx);
+    samplPts[3 * ptIdx + 2] = samplPtsZ.at(ptIdx);
   }
 
-  for(int32_t i = 0; i < samplPtsX.size(); i = i + pointsChunkSize)
+  std::vector<GBPDMetricBased::Matrix3x3> symOps(nsym);
+  for(int j = 0; j < nsym; j++)
+  {
+    m_OrientationOps[cryst]->getMatSymOp(j, symOps[j].m);
+  }
+
+  // Each slab of triangles accumulates into its own distribution values, merged in slab order below
+  size_t numSlabs = 1;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  numSlabs = static_cast<size_t>(tbb::task_scheduler_init::default_num_threads());
+#endif
+  std::vector<std::vector<double>> slabValues(numSlabs, std::vector<double>(numSamplPts, 0.0));
+  std::vector<std::vector<double>> slabCompensations(numSlabs, std::vector<double>(numSamplPts, 0.0));
+
+  size_t numSelectedTris = selectedTris.size();
+  trisChunkSize = 50000;
+  for(size_t i = 0; i < numSelectedTris; i = i + trisChunkSize)
   {
     if(getCancel())
     {
       return;
     }
-    ss = QObject::tr("--> Determining GBPD values (%1%)").arg(int(100.0 * float(i) / float(samplPtsX.size())));
+    ss = QObject::tr("--> Determining GBPD values (%1%)").arg(int(100.0 * float(i) / float(numSelectedTris)));
     notifyStatusMessage(ss);
-    if(i + pointsChunkSize >= samplPtsX.size())
+    if(i + trisChunkSize >= numSelectedTris)
     {
-      pointsChunkSize = samplPtsX.size() - i;
+      trisChunkSize = numSelectedTris - i;
     }
 
+    GBPDMetricBased::ProbeDistrib body(selectedTris, i, i + trisChunkSize, numSlabs, samplPtsIndex, samplPts.data(), symOps, m_LimitDist, slabValues, slabCompensations);
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    if(doParallel)
+    if(doParallel && numSlabs > 1)
     {
-      tbb::parallel_for(tbb::blocked_range<size_t>(i, i + pointsChunkSize),
-                        GBPDMetricBased::ProbeDistrib(&distribValues, &errorValues, &samplPtsX, &samplPtsY, &samplPtsZ, selectedTris, m_LimitDist, totalFaceArea, numDistinctGBs, ballVolume, cryst),
-                        tbb::auto_partitioner());
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlabs, 1), body, tbb::simple_partitioner());
     }
     else
 #endif
     {
-      GBPDMetricBased::ProbeDistrib serial(&distribValues, &errorValues, &samplPtsX, &samplPtsY, &samplPtsZ, selectedTris, m_LimitDist, totalFaceArea, numDistinctGBs, ballVolume, cryst);
-      serial.probe(i, i + pointsChunkSize);
+      body.probe(0, numSlabs);
+    }
+  }
+
+  for(int32_t ptIdx = 0; ptIdx < numSamplPts; ptIdx++)
+  {
+    double compensation = 0.0;
+    for(size_t slab = 0; slab < numSlabs; slab++)
+    {
+      GBPDMetricBased::ProbeDistrib::addArea(slabValues[slab][ptIdx], distribValues[ptIdx], compensation);
     }
+    errorValues[ptIdx] = sqrt(distribValues[ptIdx] / totalFaceArea / double(numDistinctGBs)) / ballVolume;
+    distribValues[ptIdx] /= totalFaceArea;
+    distribValues[ptIdx] /= ballVolume;
   }
 
   // ------------------------------------------- writing the output --------------------------------
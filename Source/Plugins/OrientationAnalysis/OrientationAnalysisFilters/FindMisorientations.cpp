@@ -45,6 +45,7 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/util/FeaturePairMetrics.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
@@ -66,8 +67,6 @@ FindMisorientations::FindMisorientations()
 , m_AvgMisorientationsArrayName(SIMPL::FeatureData::AvgMisorientations)
 , m_FindAvgMisors(false)
 {
-  m_OrientationOps = LaueOps::getOrientationOpsQVector();
-
   m_NeighborList = NeighborList<int32_t>::NullPointer();
   m_MisorientationList = NeighborList<float>::NullPointer();
 
@@ -239,71 +238,36 @@ void FindMisorientations::execute()
   // us to use the same syntax as the "vector of vectors"
   NeighborList<int32_t>& neighborlist = *(m_NeighborList.lock());
 
-  std::vector<std::vector<float>> misorientationlists;
-
-  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  float w = 0.0f;
-  size_t tempMisoList = 0;
-  QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
-  QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
+  // Every boundary appears in the neighbor lists of both of its Features, so evaluate each
+  // unique pair once and read the values back per neighbor list entry
+  FeaturePairMetrics pairMetrics;
+  pairMetrics.buildFromNeighborLists(neighborlist, totalFeatures);
+  pairMetrics.evaluate(m_AvgQuats, m_FeaturePhases, m_CrystalStructures, nullptr, FeaturePairMetrics::Misorientation);
 
-  uint32_t xtalType1 = 0, xtalType2 = 0;
-  int32_t nname = 0;
-
-  misorientationlists.resize(totalFeatures);
   for(size_t i = 1; i < totalFeatures; i++)
   {
-    QuaternionMathF::Copy(avgQuats[i], q1);
-    xtalType1 = m_CrystalStructures[m_FeaturePhases[i]];
-    NeighborList<int32_t>::VectorType& featureNeighborList = neighborlist[i];
-
-    misorientationlists[i].assign(featureNeighborList.size(), -1.0);
+    size_t firstSlot = pairMetrics.getSlotOffset(i);
+    size_t lastSlot = pairMetrics.getSlotOffset(i + 1);
 
-    for(size_t j = 0; j < featureNeighborList.size(); j++)
+    NeighborList<float>::SharedVectorType misoL(new std::vector<float>(lastSlot - firstSlot));
+    float sum = 0.0f;
+    size_t numValid = 0;
+    for(size_t slot = firstSlot; slot < lastSlot; slot++)
     {
-      w = std::numeric_limits<float>::max();
-      nname = featureNeighborList[j];
-      QuaternionMathF::Copy(avgQuats[nname], q2);
-      xtalType2 = m_CrystalStructures[m_FeaturePhases[nname]];
-      tempMisoList = featureNeighborList.size();
-      if(xtalType1 == xtalType2 && static_cast<int64_t>(xtalType1) < static_cast<int64_t>(m_OrientationOps.size()))
+      float w = pairMetrics.getValue(FeaturePairMetrics::Misorientation, slot);
+      (*misoL)[slot - firstSlot] = w;
+      if(!std::isnan(w))
       {
-        w = m_OrientationOps[xtalType1]->getMisoQuat(q1, q2, n1, n2, n3);
-        misorientationlists[i][j] = w * SIMPLib::Constants::k_180OverPi;
-        if(m_FindAvgMisors)
-        {
-          m_AvgMisorientations[i] += misorientationlists[i][j];
-        }
-      }
-      else
-      {
-        if(m_FindAvgMisors)
-        {
-          tempMisoList--;
-        }
-        misorientationlists[i][j] = NAN;
+        sum += w;
+        numValid++;
       }
     }
     if(m_FindAvgMisors)
     {
-      if(tempMisoList != 0)
-      {
-        m_AvgMisorientations[i] /= tempMisoList;
-      }
-      else
-      {
-        m_AvgMisorientations[i] = NAN;
-      }
-      tempMisoList = 0;
+      m_AvgMisorientations[i] = (numValid != 0) ? sum / static_cast<float>(numValid) : NAN;
     }
-  }
 
-  for(size_t i = 1; i < totalFeatures; i++)
-  {
     // Set the vector for each list into the NeighborList Object
-    NeighborList<float>::SharedVectorType misoL(new std::vector<float>);
-    misoL->assign(misorientationlists[i].begin(), misorientationlists[i].end());
     m_MisorientationList.lock()->setList(static_cast<int32_t>(i), misoL);
   }
 }
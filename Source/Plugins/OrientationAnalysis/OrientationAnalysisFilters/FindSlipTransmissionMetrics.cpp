@@ -42,6 +42,7 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/util/FeaturePairMetrics.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
@@ -67,8 +68,6 @@ FindSlipTransmissionMetrics::FindSlipTransmissionMetrics()
 , m_FeaturePhasesArrayPath("", "", "")
 , m_CrystalStructuresArrayPath("", "", "")
 {
-  m_OrientationOps = LaueOps::getOrientationOpsQVector();
-
   m_F1List = NeighborList<float>::NullPointer();
   m_F1sptList = NeighborList<float>::NullPointer();
   m_F7List = NeighborList<float>::NullPointer();
@@ -242,79 +241,38 @@ void FindSlipTransmissionMetrics::execute()
   // us to use the same syntax as the "vector of vectors"
   NeighborList<int32_t>& neighborlist = *(m_NeighborList.lock());
 
-  std::vector<std::vector<float>> F1lists;
-  std::vector<std::vector<float>> F1sptlists;
-  std::vector<std::vector<float>> F7lists;
-  std::vector<std::vector<float>> mPrimelists;
-
-  float mprime = 0.0f, F1 = 0.0f, F1spt = 0.0f, F7 = 0.0f;
-  int32_t nname;
-  QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
-  QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
-
   float LD[3] = {0.0f, 0.0f, 1.0f};
 
-  F1lists.resize(totalFeatures);
-  F1sptlists.resize(totalFeatures);
-  F7lists.resize(totalFeatures);
-  mPrimelists.resize(totalFeatures);
+  // Evaluate every unique boundary once; F1, F1spt and F7 depend on which Feature the slip
+  // comes from, so they are evaluated in both directions and read back per neighbor list entry
+  FeaturePairMetrics pairMetrics;
+  pairMetrics.buildFromNeighborLists(neighborlist, totalFeatures);
+  pairMetrics.evaluate(m_AvgQuats, m_FeaturePhases, m_CrystalStructures, LD,
+                       FeaturePairMetrics::MPrime | FeaturePairMetrics::F1 | FeaturePairMetrics::F1spt | FeaturePairMetrics::F7);
 
   for(size_t i = 1; i < totalFeatures; i++)
   {
-    F1lists[i].assign(neighborlist[i].size(), 0.0f);
-    F1sptlists[i].assign(neighborlist[i].size(), 0.0f);
-    F7lists[i].assign(neighborlist[i].size(), 0.0f);
-    mPrimelists[i].assign(neighborlist[i].size(), 0.0f);
-    for(size_t j = 0; j < neighborlist[i].size(); j++)
+    size_t firstSlot = pairMetrics.getSlotOffset(i);
+    size_t numNeighbors = pairMetrics.getSlotOffset(i + 1) - firstSlot;
+
+    NeighborList<float>::SharedVectorType f1L(new std::vector<float>(numNeighbors));
+    NeighborList<float>::SharedVectorType f1sptL(new std::vector<float>(numNeighbors));
+    NeighborList<float>::SharedVectorType f7L(new std::vector<float>(numNeighbors));
+    NeighborList<float>::SharedVectorType mPrimeL(new std::vector<float>(numNeighbors));
+    for(size_t j = 0; j < numNeighbors; j++)
     {
-      nname = neighborlist[i][j];
-      QuaternionMathF::Copy(avgQuats[i], q1);
-      QuaternionMathF::Copy(avgQuats[nname], q1);
-      if(m_CrystalStructures[m_FeaturePhases[i]] == m_CrystalStructures[m_FeaturePhases[nname]] && m_FeaturePhases[i] > 0)
-      {
-        m_OrientationOps[m_CrystalStructures[m_FeaturePhases[i]]]->getmPrime(q1, q2, LD, mprime);
-        m_OrientationOps[m_CrystalStructures[m_FeaturePhases[i]]]->getF1(q1, q2, LD, true, F1);
-        m_OrientationOps[m_CrystalStructures[m_FeaturePhases[i]]]->getF1spt(q1, q2, LD, true, F1spt);
-        m_OrientationOps[m_CrystalStructures[m_FeaturePhases[i]]]->getF7(q1, q2, LD, true, F7);
-      }
-      else
-      {
-        mprime = 0.0f;
-        F1 = 0.0f;
-        F1spt = 0.0f;
-        F7 = 0.0f;
-      }
-      mPrimelists[i][j] = mprime;
-      F1lists[i][j] = F1;
-      F1sptlists[i][j] = F1spt;
-      F7lists[i][j] = F7;
+      (*f1L)[j] = pairMetrics.getValue(FeaturePairMetrics::F1, firstSlot + j);
+      (*f1sptL)[j] = pairMetrics.getValue(FeaturePairMetrics::F1spt, firstSlot + j);
+      (*f7L)[j] = pairMetrics.getValue(FeaturePairMetrics::F7, firstSlot + j);
+      (*mPrimeL)[j] = pairMetrics.getValue(FeaturePairMetrics::MPrime, firstSlot + j);
     }
-  }
 
-  for(size_t i = 1; i < totalFeatures; i++)
-  {
     // Set the vector for each list into the NeighborList Object
-    NeighborList<float>::SharedVectorType f1L(new std::vector<float>);
-    f1L->assign(F1lists[i].begin(), F1lists[i].end());
     m_F1List.lock()->setList(static_cast<int32_t>(i), f1L);
-
-    // Set the vector for each list into the NeighborList Object
-    NeighborList<float>::SharedVectorType f1sptL(new std::vector<float>);
-    f1sptL->assign(F1sptlists[i].begin(), F1sptlists[i].end());
     m_F1sptList.lock()->setList(static_cast<int32_t>(i), f1sptL);
-
-    // Set the vector for each list into the NeighborList Object
-    NeighborList<float>::SharedVectorType f7L(new std::vector<float>);
-    f7L->assign(F7lists[i].begin(), F7lists[i].end());
     m_F7List.lock()->setList(static_cast<int32_t>(i), f7L);
-
-    // Set the vector for each list into the NeighborList Object
-    NeighborList<float>::SharedVectorType mPrimeL(new std::vector<float>);
-    mPrimeL->assign(mPrimelists[i].begin(), mPrimelists[i].end());
     m_mPrimeList.lock()->setList(static_cast<int32_t>(i), mPrimeL);
   }
-
 }
 
 // -----------------------------------------------------------------------------
@@ -42,6 +42,7 @@
 #endif
 
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
@@ -65,10 +66,11 @@
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/util/IPFColorLookupTable.h"
 
 /**
  * @brief The CalculateNormalsImpl class implements a threaded algorithm that computes the IPF colors for the given list of
- * surface mesh labels
+ * surface mesh labels, either exactly or from the IPF color lookup tables of the Laue classes when they are given
  */
 class CalculateFaceIPFColorsImpl
 {
@@ -78,15 +80,18 @@ class CalculateFaceIPFColorsImpl
   float* m_Eulers;
   uint8_t* m_Colors;
   uint32_t* m_CrystalStructures;
+  const std::vector<IPFColorLookupTable::Pointer>* m_LookupTables;
 
 public:
-  CalculateFaceIPFColorsImpl(int32_t* labels, int32_t* phases, double* normals, float* eulers, uint8_t* colors, uint32_t* crystalStructures)
+  CalculateFaceIPFColorsImpl(int32_t* labels, int32_t* phases, double* normals, float* eulers, uint8_t* colors, uint32_t* crystalStructures,
+                             const std::vector<IPFColorLookupTable::Pointer>* lookupTables = nullptr)
   : m_Labels(labels)
   , m_Phases(phases)
   , m_Normals(normals)
   , m_Eulers(eulers)
   , m_Colors(colors)
   , m_CrystalStructures(crystalStructures)
+  , m_LookupTables(lookupTables)
   {
   }
   virtual ~CalculateFaceIPFColorsImpl() = default;
@@ -137,7 +142,12 @@ public:
       if(phase1 > 0)
       {
         // Make sure we are using a valid Euler Angles with valid crystal symmetry
-        if(m_CrystalStructures[phase1] < Ebsd::CrystalStructure::LaueGroupEnd)
+        if(m_CrystalStructures[phase1] < Ebsd::CrystalStructure::LaueGroupEnd && nullptr != m_LookupTables)
+        {
+          float normal[3] = {static_cast<float>(m_Normals[3 * i + 0]), static_cast<float>(m_Normals[3 * i + 1]), static_cast<float>(m_Normals[3 * i + 2])};
+          (*m_LookupTables)[m_CrystalStructures[phase1]]->getColor(m_Eulers + 3 * feature1, normal, m_Colors + 6 * i);
+        }
+        else if(m_CrystalStructures[phase1] < Ebsd::CrystalStructure::LaueGroupEnd)
         {
           dEuler[0] = m_Eulers[3 * feature1 + 0];
           dEuler[1] = m_Eulers[3 * feature1 + 1];
@@ -163,7 +173,12 @@ public:
       if(phase2 > 0)
       {
         // Make sure we are using a valid Euler Angles with valid crystal symmetry
-        if(m_CrystalStructures[phase1] < Ebsd::CrystalStructure::LaueGroupEnd)
+        if(m_CrystalStructures[phase1] < Ebsd::CrystalStructure::LaueGroupEnd && nullptr != m_LookupTables)
+        {
+          float normal[3] = {static_cast<float>(-m_Normals[3 * i + 0]), static_cast<float>(-m_Normals[3 * i + 1]), static_cast<float>(-m_Normals[3 * i + 2])};
+          (*m_LookupTables)[m_CrystalStructures[phase1]]->getColor(m_Eulers + 3 * feature2, normal, m_Colors + 6 * i + 3);
+        }
+        else if(m_CrystalStructures[phase1] < Ebsd::CrystalStructure::LaueGroupEnd)
         {
           dEuler[0] = m_Eulers[3 * feature2 + 0];
           dEuler[1] = m_Eulers[3 * feature2 + 1];
@@ -209,6 +224,7 @@ GenerateFaceIPFColoring::GenerateFaceIPFColoring()
 , m_FeaturePhasesArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::Phases)
 , m_CrystalStructuresArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellEnsembleAttributeMatrixName, SIMPL::EnsembleData::CrystalStructures)
 , m_SurfaceMeshFaceIPFColorsArrayName(SIMPL::FaceData::SurfaceMeshFaceIPFColors)
+, m_UseLookupTable(false)
 {
 }
 
@@ -223,6 +239,7 @@ GenerateFaceIPFColoring::~GenerateFaceIPFColoring() = default;
 void GenerateFaceIPFColoring::setupFilterParameters()
 {
   FilterParameterVectorType parameters;
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Use IPF Color Lookup Table", UseLookupTable, FilterParameter::Parameter, GenerateFaceIPFColoring));
   parameters.push_back(SeparatorFilterParameter::New("Face Data", FilterParameter::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Int32, 2, AttributeMatrix::Type::Face, IGeometry::Type::Triangle);
@@ -263,6 +280,7 @@ void GenerateFaceIPFColoring::setupFilterParameters()
 void GenerateFaceIPFColoring::readFilterParameters(AbstractFilterParametersReader* reader, int index)
 {
   reader->openFilterGroup(this, index);
+  setUseLookupTable(reader->readValue("UseLookupTable", getUseLookupTable()));
   setSurfaceMeshFaceIPFColorsArrayName(reader->readString("SurfaceMeshFaceIPFColorsArrayName", getSurfaceMeshFaceIPFColorsArrayName()));
   setCrystalStructuresArrayPath(reader->readDataArrayPath("CrystalStructuresArrayPath", getCrystalStructuresArrayPath()));
   setFeaturePhasesArrayPath(reader->readDataArrayPath("FeaturePhasesArrayPath", getFeaturePhasesArrayPath()));
@@ -407,6 +425,14 @@ void GenerateFaceIPFColoring::execute()
 
   int64_t numTriangles = m_SurfaceMeshFaceLabelsPtr.lock()->getNumberOfTuples();
 
+  // The lookup tables are only built for the Laue classes the ensembles use
+  std::vector<IPFColorLookupTable::Pointer> lookupTables;
+  if(getUseLookupTable())
+  {
+    lookupTables = IPFColorLookupTable::CreateTables(m_CrystalStructures, m_CrystalStructuresPtr.lock()->getNumberOfTuples());
+  }
+  const std::vector<IPFColorLookupTable::Pointer>* lookupTablesPtr = getUseLookupTable() ? &lookupTables : nullptr;
+
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
   bool doParallel = true;
 #endif
@@ -415,13 +441,13 @@ void GenerateFaceIPFColoring::execute()
   if(doParallel)
   {
     tbb::parallel_for(tbb::blocked_range<size_t>(0, numTriangles),
-                      CalculateFaceIPFColorsImpl(m_SurfaceMeshFaceLabels, m_FeaturePhases, m_SurfaceMeshFaceNormals, m_FeatureEulerAngles, m_SurfaceMeshFaceIPFColors, m_CrystalStructures),
+                      CalculateFaceIPFColorsImpl(m_SurfaceMeshFaceLabels, m_FeaturePhases, m_SurfaceMeshFaceNormals, m_FeatureEulerAngles, m_SurfaceMeshFaceIPFColors, m_CrystalStructures, lookupTablesPtr),
                       tbb::auto_partitioner());
   }
   else
 #endif
   {
-    CalculateFaceIPFColorsImpl serial(m_SurfaceMeshFaceLabels, m_FeaturePhases, m_SurfaceMeshFaceNormals, m_FeatureEulerAngles, m_SurfaceMeshFaceIPFColors, m_CrystalStructures);
+    CalculateFaceIPFColorsImpl serial(m_SurfaceMeshFaceLabels, m_FeaturePhases, m_SurfaceMeshFaceNormals, m_FeatureEulerAngles, m_SurfaceMeshFaceIPFColors, m_CrystalStructures, lookupTablesPtr);
     serial.generate(0, numTriangles);
   }
 
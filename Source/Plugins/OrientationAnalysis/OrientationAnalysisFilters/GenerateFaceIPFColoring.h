@@ -54,6 +54,7 @@ class OrientationAnalysis_EXPORT GenerateFaceIPFColoring : public AbstractFilter
   PYB11_PROPERTY(DataArrayPath FeaturePhasesArrayPath READ getFeaturePhasesArrayPath WRITE setFeaturePhasesArrayPath)
   PYB11_PROPERTY(DataArrayPath CrystalStructuresArrayPath READ getCrystalStructuresArrayPath WRITE setCrystalStructuresArrayPath)
   PYB11_PROPERTY(QString SurfaceMeshFaceIPFColorsArrayName READ getSurfaceMeshFaceIPFColorsArrayName WRITE setSurfaceMeshFaceIPFColorsArrayName)
+  PYB11_PROPERTY(bool UseLookupTable READ getUseLookupTable WRITE setUseLookupTable)
 public:
   SIMPL_SHARED_POINTERS(GenerateFaceIPFColoring)
   SIMPL_FILTER_NEW_MACRO(GenerateFaceIPFColoring)
@@ -79,6 +80,9 @@ public:
   SIMPL_FILTER_PARAMETER(QString, SurfaceMeshFaceIPFColorsArrayName)
   Q_PROPERTY(QString SurfaceMeshFaceIPFColorsArrayName READ getSurfaceMeshFaceIPFColorsArrayName WRITE setSurfaceMeshFaceIPFColorsArrayName)
 
+  SIMPL_FILTER_PARAMETER(bool, UseLookupTable)
+  Q_PROPERTY(bool UseLookupTable READ getUseLookupTable WRITE setUseLookupTable)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
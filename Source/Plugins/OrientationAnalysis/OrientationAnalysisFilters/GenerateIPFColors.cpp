@@ -44,6 +44,7 @@
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/FloatVec3FilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
@@ -55,17 +56,20 @@
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/util/IPFColorLookupTable.h"
 
 #include "EbsdLib/EbsdConstants.h"
 
 /**
  * @brief The GenerateIPFColorsImpl class implements a threaded algorithm that computes the IPF
- * colors for each element in a geometry
+ * colors for each element in a geometry, either exactly or from the IPF color lookup tables of
+ * the Laue classes when they are given
  */
 class GenerateIPFColorsImpl
 {
 public:
-  GenerateIPFColorsImpl(GenerateIPFColors* filter, FloatVec3Type referenceDir, float* eulers, int32_t* phases, uint32_t* crystalStructures, int32_t numPhases, bool* goodVoxels, uint8_t* colors)
+  GenerateIPFColorsImpl(GenerateIPFColors* filter, FloatVec3Type referenceDir, float* eulers, int32_t* phases, uint32_t* crystalStructures, int32_t numPhases, bool* goodVoxels, uint8_t* colors,
+                        const std::vector<IPFColorLookupTable::Pointer>* lookupTables = nullptr)
   : m_Filter(filter)
   , m_ReferenceDir(referenceDir)
   , m_CellEulerAngles(eulers)
@@ -74,6 +78,7 @@ public:
   , m_NumPhases(numPhases)
   , m_GoodVoxels(goodVoxels)
   , m_CellIPFColors(colors)
+  , m_LookupTables(lookupTables)
   {
   }
 
@@ -83,6 +88,7 @@ public:
   {
     QVector<LaueOps::Pointer> ops = LaueOps::getOrientationOpsQVector();
     double refDir[3] = {m_ReferenceDir[0], m_ReferenceDir[1], m_ReferenceDir[2]};
+    float fRefDir[3] = {m_ReferenceDir[0], m_ReferenceDir[1], m_ReferenceDir[2]};
     double dEuler[3] = {0.0, 0.0, 0.0};
     SIMPL::Rgb argb = 0x00000000;
     int32_t phase = 0;
@@ -113,6 +119,11 @@ public:
 
       if(phase < m_NumPhases && calcIPF && m_CrystalStructures[phase] < Ebsd::CrystalStructure::LaueGroupEnd)
       {
+        if(nullptr != m_LookupTables)
+        {
+          (*m_LookupTables)[m_CrystalStructures[phase]]->getColor(m_CellEulerAngles + index, fRefDir, m_CellIPFColors + index);
+          continue;
+        }
         argb = ops[m_CrystalStructures[phase]]->generateIPFColor(dEuler, refDir, false);
         m_CellIPFColors[index] = static_cast<uint8_t>(RgbColor::dRed(argb));
         m_CellIPFColors[index + 1] = static_cast<uint8_t>(RgbColor::dGreen(argb));
@@ -136,6 +147,7 @@ private:
   int32_t m_NumPhases = 0;
   bool* m_GoodVoxels;
   uint8_t* m_CellIPFColors;
+  const std::vector<IPFColorLookupTable::Pointer>* m_LookupTables = nullptr;
 };
 
 // -----------------------------------------------------------------------------
@@ -146,6 +158,7 @@ GenerateIPFColors::GenerateIPFColors()
 , m_CellEulerAnglesArrayPath("", "", "")
 , m_CrystalStructuresArrayPath("", "", "")
 , m_UseGoodVoxels(false)
+, m_UseLookupTable(false)
 , m_GoodVoxelsArrayPath("", "", "")
 , m_CellIPFColorsArrayName(SIMPL::CellData::IPFColor)
 {
@@ -169,6 +182,7 @@ void GenerateIPFColors::setupFilterParameters()
 
   QStringList linkedProps("GoodVoxelsArrayPath");
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Apply to Good Elements Only (Bad Elements Will Be Black)", UseGoodVoxels, FilterParameter::Parameter, GenerateIPFColors, linkedProps));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Use IPF Color Lookup Table", UseLookupTable, FilterParameter::Parameter, GenerateIPFColors));
   parameters.push_back(SeparatorFilterParameter::New("Element Data", FilterParameter::RequiredArray));
   DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateCategoryRequirement(SIMPL::TypeNames::Float, 3, AttributeMatrix::Category::Any);
   parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Euler Angles", CellEulerAnglesArrayPath, FilterParameter::RequiredArray, GenerateIPFColors, req));
@@ -194,6 +208,7 @@ void GenerateIPFColors::readFilterParameters(AbstractFilterParametersReader* rea
 {
   reader->openFilterGroup(this, index);
   setUseGoodVoxels(reader->readValue("UseGoodVoxels", getUseGoodVoxels()));
+  setUseLookupTable(reader->readValue("UseLookupTable", getUseLookupTable()));
   setGoodVoxelsArrayPath(reader->readDataArrayPath("GoodVoxelsArrayPath", getGoodVoxelsArrayPath()));
   setCrystalStructuresArrayPath(reader->readDataArrayPath("CrystalStructuresArrayPath", getCrystalStructuresArrayPath()));
   setCellEulerAnglesArrayPath(reader->readDataArrayPath("CellEulerAnglesArrayPath", getCellEulerAnglesArrayPath()));
@@ -322,6 +337,14 @@ void GenerateIPFColors::execute()
   FloatVec3Type normRefDir = m_ReferenceDir; // Make a copy of the reference Direction
   MatrixMath::Normalize3x1(normRefDir[0], normRefDir[1], normRefDir[2]);
 
+  // The lookup tables are only built for the Laue classes the ensembles use
+  std::vector<IPFColorLookupTable::Pointer> lookupTables;
+  if(getUseLookupTable())
+  {
+    lookupTables = IPFColorLookupTable::CreateTables(m_CrystalStructures, static_cast<size_t>(numPhases));
+  }
+  const std::vector<IPFColorLookupTable::Pointer>* lookupTablesPtr = getUseLookupTable() ? &lookupTables : nullptr;
+
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
   tbb::task_scheduler_init init;
   bool doParallel = true;
@@ -331,12 +354,12 @@ void GenerateIPFColors::execute()
   if(doParallel)
   {
     tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints),
-                      GenerateIPFColorsImpl(this, normRefDir, m_CellEulerAngles, m_CellPhases, m_CrystalStructures, numPhases, m_GoodVoxels, m_CellIPFColors), tbb::auto_partitioner());
+                      GenerateIPFColorsImpl(this, normRefDir, m_CellEulerAngles, m_CellPhases, m_CrystalStructures, numPhases, m_GoodVoxels, m_CellIPFColors, lookupTablesPtr), tbb::auto_partitioner());
   }
   else
 #endif
   {
-    GenerateIPFColorsImpl serial(this, normRefDir, m_CellEulerAngles, m_CellPhases, m_CrystalStructures, numPhases, m_GoodVoxels, m_CellIPFColors);
+    GenerateIPFColorsImpl serial(this, normRefDir, m_CellEulerAngles, m_CellPhases, m_CrystalStructures, numPhases, m_GoodVoxels, m_CellIPFColors, lookupTablesPtr);
     serial.convert(0, totalPoints);
   }
 
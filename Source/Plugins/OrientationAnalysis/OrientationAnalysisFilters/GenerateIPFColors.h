@@ -54,6 +54,7 @@ class OrientationAnalysis_EXPORT GenerateIPFColors : public AbstractFilter
     PYB11_PROPERTY(DataArrayPath CellEulerAnglesArrayPath READ getCellEulerAnglesArrayPath WRITE setCellEulerAnglesArrayPath)
     PYB11_PROPERTY(DataArrayPath CrystalStructuresArrayPath READ getCrystalStructuresArrayPath WRITE setCrystalStructuresArrayPath)
     PYB11_PROPERTY(bool UseGoodVoxels READ getUseGoodVoxels WRITE setUseGoodVoxels)
+    PYB11_PROPERTY(bool UseLookupTable READ getUseLookupTable WRITE setUseLookupTable)
     PYB11_PROPERTY(DataArrayPath GoodVoxelsArrayPath READ getGoodVoxelsArrayPath WRITE setGoodVoxelsArrayPath)
     PYB11_PROPERTY(QString CellIPFColorsArrayName READ getCellIPFColorsArrayName WRITE setCellIPFColorsArrayName)
 public:
@@ -78,6 +79,9 @@ public:
   SIMPL_FILTER_PARAMETER(bool, UseGoodVoxels)
   Q_PROPERTY(bool UseGoodVoxels READ getUseGoodVoxels WRITE setUseGoodVoxels)
 
+  SIMPL_FILTER_PARAMETER(bool, UseLookupTable)
+  Q_PROPERTY(bool UseLookupTable READ getUseLookupTable WRITE setUseLookupTable)
+
   SIMPL_FILTER_PARAMETER(DataArrayPath, GoodVoxelsArrayPath)
   Q_PROPERTY(DataArrayPath GoodVoxelsArrayPath READ getGoodVoxelsArrayPath WRITE setGoodVoxelsArrayPath)
 
@@ -49,6 +49,8 @@
 #include "EbsdLib/EbsdConstants.h"
 #include "EbsdLib/TSL/AngConstants.h"
 
+#include "DREAM3DLib/Utilities/ParallelTextWriter.hpp"
+
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
@@ -390,51 +392,42 @@ int32_t INLWriter::writeFile()
 
   fprintf(f, "# phi1 PHI phi2 x y z FeatureId PhaseId Symmetry\r\n");
 
-  float phi1 = 0.0f, phi = 0.0f, phi2 = 0.0f;
-  float xPos = 0.0f, yPos = 0.0f, zPos = 0.0f;
-  int32_t featureId = 0;
-  int32_t phaseId = 0;
-
-  size_t index = 0;
-  for(size_t z = 0; z < dims[2]; ++z)
-  {
-    for(size_t y = 0; y < dims[1]; ++y)
+  // Each row is one line of Cells along x
+  auto formatRow = [&](size_t row, TextBuffer& out) {
+    size_t y = row % dims[1];
+    size_t z = row / dims[1];
+    for(size_t x = 0; x < dims[0]; ++x)
     {
-      for(size_t x = 0; x < dims[0]; ++x)
+      size_t index = (z * dims[0] * dims[1]) + (dims[0] * y) + x;
+      float xPos = origin[0] + (x * res[0]);
+      float yPos = origin[1] + (y * res[1]);
+      float zPos = origin[2] + (z * res[2]);
+      int32_t featureId = m_FeatureIds[index];
+      int32_t phaseId = m_CellPhases[index];
+      uint32_t cellSymmetry = Ebsd::Ang::PhaseSymmetry::UnknownSymmetry;
+      if(phaseId > 0)
       {
-        index = (z * dims[0] * dims[1]) + (dims[0] * y) + x;
-        phi1 = m_CellEulerAngles[index * 3];
-        phi = m_CellEulerAngles[index * 3 + 1];
-        phi2 = m_CellEulerAngles[index * 3 + 2];
-        xPos = origin[0] + (x * res[0]);
-        yPos = origin[1] + (y * res[1]);
-        zPos = origin[2] + (z * res[2]);
-        featureId = m_FeatureIds[index];
-        phaseId = m_CellPhases[index];
-        symmetry = m_CrystalStructures[phaseId];
-        if(phaseId > 0)
+        if(m_CrystalStructures[phaseId] == Ebsd::CrystalStructure::Cubic_High)
         {
-          if(symmetry == Ebsd::CrystalStructure::Cubic_High)
-          {
-            symmetry = Ebsd::Ang::PhaseSymmetry::Cubic;
-          }
-          else if(symmetry == Ebsd::CrystalStructure::Hexagonal_High)
-          {
-            symmetry = Ebsd::Ang::PhaseSymmetry::DiHexagonal;
-          }
-          else
-          {
-            symmetry = Ebsd::Ang::PhaseSymmetry::UnknownSymmetry;
-          }
+          cellSymmetry = Ebsd::Ang::PhaseSymmetry::Cubic;
         }
-        else
+        else if(m_CrystalStructures[phaseId] == Ebsd::CrystalStructure::Hexagonal_High)
         {
-          symmetry = Ebsd::Ang::PhaseSymmetry::UnknownSymmetry;
+          cellSymmetry = Ebsd::Ang::PhaseSymmetry::DiHexagonal;
         }
-
-        fprintf(f, "%f %f %f %f %f %f %d %d %d\r\n", phi1, phi, phi2, xPos, yPos, zPos, featureId, phaseId, symmetry);
       }
+
+      out.appendFixed(m_CellEulerAngles[index * 3]).append(' ').appendFixed(m_CellEulerAngles[index * 3 + 1]).append(' ').appendFixed(m_CellEulerAngles[index * 3 + 2]).append(' ');
+      out.appendFixed(xPos).append(' ').appendFixed(yPos).append(' ').appendFixed(zPos).append(' ');
+      out.appendInt(featureId).append(' ').appendInt(phaseId).append(' ').appendInt(static_cast<int32_t>(cellSymmetry)).append("\r\n");
     }
+  };
+  auto sink = [&](const TextBuffer& buffer, size_t) { return ParallelTextWriter::WriteToFile(f, buffer) && !getCancel(); };
+  if(!ParallelTextWriter::WriteRows(dims[1] * dims[2], formatRow, sink) && !getCancel())
+  {
+    QString ss = QObject::tr("Error writing output file '%1'").arg(getOutputFile());
+    setErrorCondition(-2, ss);
+    err = -2;
   }
 
   fclose(f);
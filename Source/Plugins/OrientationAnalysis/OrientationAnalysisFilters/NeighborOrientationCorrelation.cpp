@@ -58,15 +58,112 @@
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
+/**
+ * @brief The NeighborOrientationCorrelationFindBestNeighborImpl class picks, for every low confidence
+ * cell of a list, the face neighbor it should be replaced with: every pair of its face neighbors that
+ * share a (non zero) phase and are misoriented by less than the tolerance counts once for both
+ * members of the pair, and the last neighbor with a non zero count wins. Cells without any similar
+ * pair keep the neighbor found on an earlier level. Only the cell's own entry of the best neighbor
+ * array is written, so the list can be split freely between threads.
+ */
+class NeighborOrientationCorrelationFindBestNeighborImpl
+{
+public:
+  NeighborOrientationCorrelationFindBestNeighborImpl(const std::vector<int64_t>& cells, const int64_t dims[3], const int32_t* cellPhases, const uint32_t* crystalStructures, const float* quats,
+                                                     const QVector<LaueOps::Pointer>& orientationOps, float misorientationTolerance, int64_t* bestNeighbor)
+  : m_Cells(cells)
+  , m_Dims(dims)
+  , m_CellPhases(cellPhases)
+  , m_CrystalStructures(crystalStructures)
+  , m_Quats(quats)
+  , m_OrientationOps(orientationOps)
+  , m_MisorientationTolerance(misorientationTolerance)
+  , m_BestNeighbor(bestNeighbor)
+  {
+  }
+  virtual ~NeighborOrientationCorrelationFindBestNeighborImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    int64_t planeStride = m_Dims[0] * m_Dims[1];
+    const QuatF* quats = reinterpret_cast<const QuatF*>(m_Quats);
+    QuatF q1 = QuaternionMathF::New();
+    QuatF q2 = QuaternionMathF::New();
+    float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+    for(size_t c = start; c < end; c++)
+    {
+      int64_t i = m_Cells[c];
+      int64_t column = i % m_Dims[0];
+      int64_t row = (i / m_Dims[0]) % m_Dims[1];
+      int64_t plane = i / planeStride;
+
+      // Face neighbors in the order -z, -y, -x, +x, +y, +z; -1 marks a neighbor outside the volume
+      int64_t neighbors[6] = {plane > 0 ? i - planeStride : -1,         row > 0 ? i - m_Dims[0] : -1,
+                              column > 0 ? i - 1 : -1,                  column < m_Dims[0] - 1 ? i + 1 : -1,
+                              row < m_Dims[1] - 1 ? i + m_Dims[0] : -1, plane < m_Dims[2] - 1 ? i + planeStride : -1};
+      int32_t neighborSimCount[6] = {0, 0, 0, 0, 0, 0};
+      for(size_t j = 0; j < 6; j++)
+      {
+        int64_t neighbor = neighbors[j];
+        if(neighbor < 0 || m_CellPhases[neighbor] <= 0)
+        {
+          continue;
+        }
+        uint32_t phase = m_CrystalStructures[m_CellPhases[neighbor]];
+        for(size_t k = j + 1; k < 6; k++)
+        {
+          int64_t neighbor2 = neighbors[k];
+          if(neighbor2 < 0 || m_CellPhases[neighbor2] != m_CellPhases[neighbor])
+          {
+            continue;
+          }
+          QuaternionMathF::Copy(quats[neighbor2], q1);
+          QuaternionMathF::Copy(quats[neighbor], q2);
+          float w = m_OrientationOps[phase]->getMisoQuat(q1, q2, n1, n2, n3);
+          if(w < m_MisorientationTolerance)
+          {
+            neighborSimCount[j]++;
+            neighborSimCount[k]++;
+          }
+        }
+      }
+      for(size_t j = 0; j < 6; j++)
+      {
+        if(neighborSimCount[j] > 0)
+        {
+          m_BestNeighbor[i] = neighbors[j];
+        }
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const std::vector<int64_t>& m_Cells;
+  const int64_t* m_Dims;
+  const int32_t* m_CellPhases;
+  const uint32_t* m_CrystalStructures;
+  const float* m_Quats;
+  const QVector<LaueOps::Pointer>& m_OrientationOps;
+  float m_MisorientationTolerance;
+  int64_t* m_BestNeighbor;
+};
+
 class NeighborOrientationCorrelationTransferDataImpl
 {
 public:
   NeighborOrientationCorrelationTransferDataImpl() = delete;
   NeighborOrientationCorrelationTransferDataImpl(const NeighborOrientationCorrelationTransferDataImpl&) = default;
 
-  NeighborOrientationCorrelationTransferDataImpl(NeighborOrientationCorrelation* filter, size_t totalPoints, const std::vector<int64_t>& bestNeighbor, IDataArray::Pointer dataArrayPtr)
+  NeighborOrientationCorrelationTransferDataImpl(NeighborOrientationCorrelation* filter, const std::vector<int64_t>& cells, const std::vector<int64_t>& bestNeighbor, IDataArray::Pointer dataArrayPtr)
   : m_Filter(filter)
-  , m_TotalPoints(totalPoints)
+  , m_Cells(cells)
   , m_BestNeighbor(bestNeighbor)
   , m_DataArrayPtr(dataArrayPtr)
   {
@@ -79,28 +176,27 @@ public:
 
   void operator()() const
   {
-    size_t progIncrement = static_cast<size_t>(m_TotalPoints / 50);
+    // The cells are visited in increasing index order, so a replacement can chain through a
+    // neighbor that was itself replaced earlier in the same pass, exactly as a serial sweep would
+    size_t numCells = m_Cells.size();
+    size_t progIncrement = numCells / 50;
     size_t prog = 1;
-    for(size_t i = 0; i < m_TotalPoints; i++)
+    for(size_t c = 0; c < numCells; c++)
     {
-      if(i > prog)
+      if(c > prog)
       {
         prog = prog + progIncrement;
         m_Filter->updateProgress(progIncrement);
       }
-      int64_t neighbor = m_BestNeighbor[i];
-      if(neighbor != -1)
-      {
-        // IDataArray::Pointer p = m_AttrMat->getAttributeArray(m_VoxelArrayNames[m_VoxelArrayIndex]);
-        m_DataArrayPtr->copyTuple(neighbor, i);
-      }
+      int64_t i = m_Cells[c];
+      m_DataArrayPtr->copyTuple(m_BestNeighbor[i], i);
     }
   }
 
 private:
   NeighborOrientationCorrelation* m_Filter = nullptr;
-  size_t m_TotalPoints = 0;
-  std::vector<int64_t> m_BestNeighbor;
+  const std::vector<int64_t>& m_Cells;
+  const std::vector<int64_t>& m_BestNeighbor;
   IDataArray::Pointer m_DataArrayPtr;
 };
 
@@ -285,32 +381,35 @@ void NeighborOrientationCorrelation::execute()
       static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2]),
   };
 
-  size_t count = 1;
-  int32_t best = 0;
-  bool good = true;
-  bool good2 = true;
-  int64_t neighbor = 0;
-  int64_t neighbor2 = 0;
-  int64_t column = 0, row = 0, plane = 0;
-
-  int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
-  neighpoints[0] = static_cast<int64_t>(-dims[0] * dims[1]);
-  neighpoints[1] = static_cast<int64_t>(-dims[0]);
-  neighpoints[2] = static_cast<int64_t>(-1);
-  neighpoints[3] = static_cast<int64_t>(1);
-  neighpoints[4] = static_cast<int64_t>(dims[0]);
-  neighpoints[5] = static_cast<int64_t>(dims[0] * dims[1]);
-
-  float w = std::numeric_limits<float>::max();
-  QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
-  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  uint32_t phase1 = 0, phase2 = 0;
-
-  std::vector<int32_t> neighborDiffCount(totalPoints, 0);
-  std::vector<int32_t> neighborSimCount(6, 0);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  // Only cells that start out below the minimum confidence can ever be given a best neighbor, and a
+  // cell that is at or above it never changes, so the cells worth visiting on any level are a subset
+  // of this list. It is kept in increasing index order so the copies below chain as a serial sweep.
+  std::vector<int64_t> lowConfidenceCells;
+  for(size_t i = 0; i < totalPoints; i++)
+  {
+    if(m_ConfidenceIndex[i] < m_MinConfidence)
+    {
+      lowConfidenceCells.push_back(static_cast<int64_t>(i));
+    }
+  }
+
   std::vector<int64_t> bestNeighbor(totalPoints, -1);
-  QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
+  std::vector<int64_t> currentCells;
+  std::vector<int64_t> copyCells;
+  currentCells.reserve(lowConfidenceCells.size());
+  copyCells.reserve(lowConfidenceCells.size());
+
+  QString attrMatName = m_ConfidenceIndexArrayPath.getAttributeMatrixName();
+  QList<QString> voxelArrayNames = m->getAttributeMatrix(attrMatName)->getAttributeArrayNames();
+  for(const auto& dataArrayPath : m_IgnoredDataArrayPaths)
+  {
+    voxelArrayNames.removeAll(dataArrayPath.getDataArrayName());
+  }
 
   const int32_t startLevel = 6;
   for(int32_t currentLevel = startLevel; currentLevel > m_Level; currentLevel--)
@@ -320,173 +419,46 @@ void NeighborOrientationCorrelation::execute()
       break;
     }
 
-    int64_t progIncrement = static_cast<int64_t>(totalPoints / 100);
-    int64_t prog = 1;
-    int64_t progressInt = 0;
-    for(size_t i = 0; i < totalPoints; i++)
+    QString ss = QObject::tr("Level %1 of %2 || Processing Data").arg((startLevel - currentLevel) + 1).arg(startLevel - m_Level);
+    notifyStatusMessage(ss);
+
+    // The confidence index is itself copied unless it is ignored, so refilter the list every level
+    currentCells.clear();
+    for(const auto& cell : lowConfidenceCells)
     {
-      if(int64_t(i) > prog)
+      if(m_ConfidenceIndex[cell] < m_MinConfidence)
       {
-        progressInt = static_cast<int64_t>((static_cast<float>(i) / totalPoints) * 100.0f);
-        QString ss = QObject::tr("Level %1 of %2 || Processing Data %3%").arg((startLevel - currentLevel) + 1).arg(startLevel - m_Level).arg(progressInt);
-        notifyStatusMessage(ss);
-        prog = prog + progIncrement;
+        currentCells.push_back(cell);
       }
+    }
 
-      if(m_ConfidenceIndex[i] < m_MinConfidence)
-      {
-        count = 0;
-        column = static_cast<int64_t>(i % dims[0]);
-        row = (i / dims[0]) % dims[1];
-        plane = i / (dims[0] * dims[1]);
-        for(size_t j = 0; j < 6; j++)
-        {
-          good = true;
-          neighbor = int64_t(i) + neighpoints[j];
-          if(j == 0 && plane == 0)
-          {
-            good = false;
-          }
-          if(j == 5 && plane == (dims[2] - 1))
-          {
-            good = false;
-          }
-          if(j == 1 && row == 0)
-          {
-            good = false;
-          }
-          if(j == 4 && row == (dims[1] - 1))
-          {
-            good = false;
-          }
-          if(j == 2 && column == 0)
-          {
-            good = false;
-          }
-          if(j == 3 && column == (dims[0] - 1))
-          {
-            good = false;
-          }
-          if(good)
-          {
-            phase1 = m_CrystalStructures[m_CellPhases[i]];
-            QuaternionMathF::Copy(quats[i], q1);
-
-            phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-            QuaternionMathF::Copy(quats[neighbor], q2);
-
-            if(m_CellPhases[i] == m_CellPhases[neighbor] && m_CellPhases[i] > 0)
-            {
-              w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
-            }
-            if(w > misorientationToleranceR)
-            {
-              neighborDiffCount[i]++;
-            }
-            for(size_t k = j + 1; k < 6; k++)
-            {
-              good2 = true;
-              neighbor2 = int64_t(i) + neighpoints[k];
-              if(k == 0 && plane == 0)
-              {
-                good2 = false;
-              }
-              if(k == 5 && plane == (dims[2] - 1))
-              {
-                good2 = false;
-              }
-              if(k == 1 && row == 0)
-              {
-                good2 = false;
-              }
-              if(k == 4 && row == (dims[1] - 1))
-              {
-                good2 = false;
-              }
-              if(k == 2 && column == 0)
-              {
-                good2 = false;
-              }
-              if(k == 3 && column == (dims[0] - 1))
-              {
-                good2 = false;
-              }
-              if(good2)
-              {
-                phase1 = m_CrystalStructures[m_CellPhases[neighbor2]];
-                QuaternionMathF::Copy(quats[neighbor2], q1);
-
-                phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-                QuaternionMathF::Copy(quats[neighbor], q2);
-                if(m_CellPhases[neighbor2] == m_CellPhases[neighbor] && m_CellPhases[neighbor2] > 0)
-                {
-                  w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
-                }
-                if(w < misorientationToleranceR)
-                {
-                  neighborSimCount[j]++;
-                  neighborSimCount[k]++;
-                }
-              }
-            }
-          }
-        }
-        for(size_t j = 0; j < 6; j++)
-        {
-          best = 0;
-          good = true;
-          neighbor = int64_t(i) + neighpoints[j];
-          if(j == 0 && plane == 0)
-          {
-            good = false;
-          }
-          if(j == 5 && plane == (dims[2] - 1))
-          {
-            good = false;
-          }
-          if(j == 1 && row == 0)
-          {
-            good = false;
-          }
-          if(j == 4 && row == (dims[1] - 1))
-          {
-            good = false;
-          }
-          if(j == 2 && column == 0)
-          {
-            good = false;
-          }
-          if(j == 3 && column == (dims[0] - 1))
-          {
-            good = false;
-          }
-          if(good)
-          {
-            if(neighborSimCount[j] > best)
-            {
-              best = neighborSimCount[j];
-              bestNeighbor[i] = neighbor;
-            }
-            neighborSimCount[j] = 0;
-          }
-        }
-      }
+    NeighborOrientationCorrelationFindBestNeighborImpl findBestNeighbor(currentCells, dims, m_CellPhases, m_CrystalStructures, m_Quats, m_OrientationOps, misorientationToleranceR,
+                                                                        bestNeighbor.data());
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, currentCells.size()), findBestNeighbor);
+    }
+    else
+#endif
+    {
+      findBestNeighbor.convert(0, currentCells.size());
     }
-    QString attrMatName = m_ConfidenceIndexArrayPath.getAttributeMatrixName();
 
     if(getCancel())
     {
       return;
     }
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    tbb::task_scheduler_init init;
-    bool doParallel = true;
-#endif
 
-    QList<QString> voxelArrayNames = m->getAttributeMatrix(attrMatName)->getAttributeArrayNames();
-    for(const auto& dataArrayPath : m_IgnoredDataArrayPaths)
+    // Best neighbors found on earlier levels are kept, so cells that have since been replaced
+    // are copied again from the same neighbor
+    copyCells.clear();
+    for(const auto& cell : lowConfidenceCells)
     {
-      voxelArrayNames.removeAll(dataArrayPath.getDataArrayName());
+      if(bestNeighbor[cell] != -1)
+      {
+        copyCells.push_back(cell);
+      }
     }
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
@@ -499,12 +471,12 @@ void NeighborOrientationCorrelation::execute()
     {
       std::shared_ptr<tbb::task_group> taskGroup(new tbb::task_group);
       AttributeMatrix* attrMat = m->getAttributeMatrix(attrMatName).get();
-      m_TotalProgress = voxelArrayNames.size() * totalPoints; // Total number of points to update
+      m_TotalProgress = voxelArrayNames.size() * copyCells.size(); // Total number of points to update
       // Create and run all the tasks
       for(const auto& arrayName : voxelArrayNames)
       {
         IDataArray::Pointer dataArrayPtr = attrMat->getAttributeArray(arrayName);
-        taskGroup->run(NeighborOrientationCorrelationTransferDataImpl(this, totalPoints, bestNeighbor, dataArrayPtr));
+        taskGroup->run(NeighborOrientationCorrelationTransferDataImpl(this, copyCells, bestNeighbor, dataArrayPtr));
       }
       // Wait for them to complete.
       taskGroup->wait();
@@ -512,26 +484,15 @@ void NeighborOrientationCorrelation::execute()
     else
 #endif
     {
-      progIncrement = static_cast<int64_t>(totalPoints / 100);
-      prog = 1;
-      progressInt = 0;
-      for(size_t i = 0; i < totalPoints; i++)
+      ss = QObject::tr("Level %1 of %2 || Copying Data").arg((startLevel - currentLevel) + 2).arg(startLevel - m_Level);
+      notifyStatusMessage(ss);
+      AttributeMatrix::Pointer attrMat = m->getAttributeMatrix(attrMatName);
+      for(const auto& arrayName : voxelArrayNames)
       {
-        if(int64_t(i) > prog)
-        {
-          progressInt = static_cast<int64_t>(((float)i / totalPoints) * 100.0f);
-          QString ss = QObject::tr("Level %1 of %2 || Copying Data %3%").arg((startLevel - currentLevel) + 2).arg(startLevel - m_Level).arg(progressInt);
-          notifyStatusMessage(ss);
-          prog = prog + progIncrement;
-        }
-        neighbor = bestNeighbor[i];
-        if(neighbor != -1)
+        IDataArray::Pointer p = attrMat->getAttributeArray(arrayName);
+        for(const auto& cell : copyCells)
         {
-          for(const auto& iter : voxelArrayNames)
-          {
-            IDataArray::Pointer p = m->getAttributeMatrix(attrMatName)->getAttributeArray(iter);
-            p->copyTuple(neighbor, i);
-          }
+          p->copyTuple(bestNeighbor[cell], cell);
         }
       }
     }
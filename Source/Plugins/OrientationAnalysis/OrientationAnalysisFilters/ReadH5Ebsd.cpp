@@ -35,6 +35,8 @@
 
 #include "ReadH5Ebsd.h"
 
+#include <vector>
+
 #include <QtCore/QFileInfo>
 
 #include "SIMPLib/Common/Constants.h"
@@ -42,7 +44,6 @@
 #include "SIMPLib/FilterParameters/DataContainerCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
-#include "SIMPLib/Filtering/FilterManager.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
 
@@ -55,6 +56,7 @@
 #include "OrientationAnalysis/FilterParameters/ReadH5EbsdFilterParameter.h"
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/util/EbsdRefFrameTransform.h"
 
 enum createdPathID : RenameDataPath::DataID_t
 {
@@ -64,6 +66,50 @@ enum createdPathID : RenameDataPath::DataID_t
   DataContainerID = 1
 };
 
+namespace
+{
+/**
+ * @brief CopySliceValues Writes one slice of a single component array, taking every cell from its
+ * source cell in the loaded slice; cells without a source, or without loaded data, are zeroed
+ */
+template <typename T>
+void CopySliceValues(const T* source, T* dest, const std::vector<int64_t>& sources)
+{
+  for(size_t i = 0; i < sources.size(); i++)
+  {
+    dest[i] = (nullptr == source || sources[i] < 0) ? static_cast<T>(0) : source[sources[i]];
+  }
+}
+
+/**
+ * @brief CopySliceArrays Writes one slice of every selected single component array of the reader
+ * into the array of the same name
+ */
+void CopySliceArrays(H5EbsdVolumeReader* ebsdReader, const AttributeMatrix::Pointer& cellAttrMatrix, const QVector<QString>& names, const QSet<QString>& selectedArrayNames, size_t offset,
+                     const std::vector<int64_t>& sources)
+{
+  for(const auto& name : names)
+  {
+    if(!selectedArrayNames.contains(name))
+    {
+      continue;
+    }
+    IDataArray::Pointer dest = cellAttrMatrix->getAttributeArray(name);
+    const void* source = (nullptr != ebsdReader) ? ebsdReader->getPointerByName(name) : nullptr;
+    Int32ArrayType::Pointer iArray = std::dynamic_pointer_cast<Int32ArrayType>(dest);
+    FloatArrayType::Pointer fArray = std::dynamic_pointer_cast<FloatArrayType>(dest);
+    if(nullptr != iArray.get())
+    {
+      CopySliceValues<int32_t>(static_cast<const int32_t*>(source), iArray->getPointer(offset), sources);
+    }
+    else if(nullptr != fArray.get())
+    {
+      CopySliceValues<float>(static_cast<const float*>(source), fArray->getPointer(offset), sources);
+    }
+  }
+}
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -532,181 +578,103 @@ void ReadH5Ebsd::execute()
     return;
   }
 
-  // Initialize all the arrays with some default values
-  {
-    QString ss = QObject::tr("Reading Ebsd Data from file %1").arg(getInputFile());
-    notifyStatusMessage(ss);
-  }
-  ebsdReader->setSliceStart(m_ZStartIndex);
-  ebsdReader->setSliceEnd(m_ZEndIndex);
-  ebsdReader->readAllArrays(false);
-  ebsdReader->setArraysToRead(m_SelectedArrayNames);
-  int err = ebsdReader->loadData(m->getGeometryAs<ImageGeom>()->getXPoints(), m->getGeometryAs<ImageGeom>()->getYPoints(), m->getGeometryAs<ImageGeom>()->getZPoints(), m_RefFrameZDir);
-  if(err < 0)
+  // The reference frame transforms are applied to each slice as it is loaded, so that every value
+  // is written once, straight into its final array, and the whole volume is never held twice
+  ImageGeom::Pointer image = m->getGeometryAs<ImageGeom>();
+  size_t dims[3] = {0, 0, 0};
+  std::tie(dims[0], dims[1], dims[2]) = image->getDimensions();
+  float spacing[3] = {0.0f, 0.0f, 0.0f};
+  std::tie(spacing[0], spacing[1], spacing[2]) = image->getSpacing();
+  float sampleAxis[3] = {m_SampleTransformation.h, m_SampleTransformation.k, m_SampleTransformation.l};
+  float eulerAxis[3] = {m_EulerTransformation.h, m_EulerTransformation.k, m_EulerTransformation.l};
+  EbsdRefFrameTransform transform;
+  transform.setSampleRotation(dims, spacing, sampleAxis, m_UseTransformations ? m_SampleTransformation.angle : 0.0f);
+  transform.setEulerRotation(eulerAxis, m_UseTransformations ? m_EulerTransformation.angle : 0.0f);
+
+  size_t newDims[3] = {0, 0, 0};
+  float newSpacing[3] = {0.0f, 0.0f, 0.0f};
+  float newOrigin[3] = {0.0f, 0.0f, 0.0f};
+  transform.getRotatedGeometry(newDims, newSpacing, newOrigin);
+  if(transform.hasSampleRotation())
   {
-    setErrorCondition(err, ebsdReader->getErrorMessage());
-    setErrorCondition(-1, "Error Loading Data from Ebsd Data file.");
-    return;
+    image->setDimensions(newDims);
+    image->setSpacing(FloatVec3Type(newSpacing[0], newSpacing[1], newSpacing[2]));
+    image->setOrigin(FloatVec3Type(newOrigin[0], newOrigin[1], newOrigin[2]));
   }
 
-  // Copy the data from the pointers embedded in the reader object into our data container (Cell array).
-  if(manufacturer.compare(Ebsd::Ang::Manufacturer) == 0)
+  // Size the arrays created by dataCheck for the final volume
+  QVector<size_t> tDims(3, 0);
+  tDims[0] = newDims[0];
+  tDims[1] = newDims[1];
+  tDims[2] = newDims[2];
+  m->getAttributeMatrix(getCellAttributeMatrixName())->resizeAttributeArrays(tDims);
+  if(nullptr != m_CellPhasesPtr.lock())
   {
-    copyTSLArrays(ebsdReader.get());
+    m_CellPhases = m_CellPhasesPtr.lock()->getPointer(0);
   }
-  else if(manufacturer.compare(Ebsd::Ctf::Manufacturer) == 0)
+  if(nullptr != m_CellEulerAnglesPtr.lock())
   {
-    copyHKLArrays(ebsdReader.get());
+    m_CellEulerAngles = m_CellEulerAnglesPtr.lock()->getPointer(0);
   }
 
-  else
   {
-    QString ss =
-        QObject::tr("Could not determine or match a supported manufacturer from the data file. Supported manufacturer codes are: %1 and %2").arg(Ebsd::Ctf::Manufacturer).arg(Ebsd::Ang::Manufacturer);
-    setErrorCondition(-109875, ss);
-    return;
+    QString ss = QObject::tr("Reading Ebsd Data from file %1").arg(getInputFile());
+    notifyStatusMessage(ss);
   }
-
-  if(m_UseTransformations)
-  {
-
-    if(m_SampleTransformation.angle > 0)
+  bool isTSL = (manufacturer.compare(Ebsd::Ang::Manufacturer) == 0);
+  H5EbsdVolumeReader* reader = ebsdReader.get();
+  size_t slicesLoaded = 0;
+  ebsdReader->setSliceConsumer([&](int64_t zval) -> int {
+    if(getCancel())
     {
-      FloatVec3Type sampleAxis;
-      sampleAxis[0] = m_SampleTransformation.h;
-      sampleAxis[1] = m_SampleTransformation.k;
-      sampleAxis[2] = m_SampleTransformation.l;
-      QString filtName = "RotateSampleRefFrame";
-      FilterManager* fm = FilterManager::Instance();
-      IFilterFactory::Pointer rotSampleFactory = fm->getFactoryFromClassName(filtName);
-      if(nullptr != rotSampleFactory.get())
-      {
-        // If we get this far, the Factory is good so creating the filter should not fail unless something has
-        // horribly gone wrong in which case the system is going to come down quickly after this.
-        AbstractFilter::Pointer rot_Sample = rotSampleFactory->create();
-
-        // Connect up the Error/Warning/Progress object so the filter can report those things
-        connect(rot_Sample.get(), SIGNAL(messageGenerated(const AbstractMessage::Pointer&)), this, SIGNAL(messageGenerated(const AbstractMessage::Pointer&)));
-        rot_Sample->setDataContainerArray(getDataContainerArray()); // AbstractFilter implements this so no problem
-        // Now set the filter parameters for the filter using QProperty System since we can not directly
-        // instantiate the filter since it resides in a plugin. These calls are SLOW. DO NOT EVER do this in a
-        // tight loop. Your filter will slow down by 10X.
-        bool propWasSet = rot_Sample->setProperty("RotationAngle", m_SampleTransformation.angle);
-        if(!propWasSet)
-        {
-          QString ss = QObject::tr("Error Setting Property '%1' into filter '%2' which is a subfilter called by ReadH5Ebsd. The property was not set which could mean the property was not exposed "
-                                   "with a Q_PROPERTY macro. Please notify the developers")
-                           .arg("RotationAngle")
-                           .arg(filtName);
-          setErrorCondition(-109874, ss);
-        }
-        QVariant v;
-        v.setValue(sampleAxis);
-        propWasSet = rot_Sample->setProperty("RotationAxis", v);
-        if(!propWasSet)
-        {
-          QString ss = QObject::tr("Error Setting Property '%1' into filter '%2' which is a subfilter called by ReadH5Ebsd. The property was not set which could mean the property was not exposed "
-                                   "with a Q_PROPERTY macro. Please notify the developers")
-                           .arg("RotationAxis")
-                           .arg(filtName);
-          setErrorCondition(-109873, ss);
-        }
-        v.setValue(true);
-        propWasSet = rot_Sample->setProperty("SliceBySlice", v);
-        if(!propWasSet)
-        {
-          QString ss = QObject::tr("Error Setting Property '%1' into filter '%2' which is a subfilter called by ReadH5Ebsd. The property was not set which could mean the property was not exposed "
-                                   "with a Q_PROPERTY macro. Please notify the developers")
-                           .arg("SliceBySlice")
-                           .arg(filtName);
-          setErrorCondition(-109872, ss);
-        }
-        DataArrayPath tempPath;
-        tempPath.update(getDataContainerName().getDataContainerName(), getCellAttributeMatrixName(), "");
-        v.setValue(tempPath);
-        propWasSet = rot_Sample->setProperty("CellAttributeMatrixPath", v);
-        if(!propWasSet)
-        {
-          QString ss = QObject::tr("Error Setting Property '%1' into filter '%2' which is a subfilter called by ReadH5Ebsd. The property was not set which could mean the property was not exposed "
-                                   "with a Q_PROPERTY macro. Please notify the developers")
-                           .arg("CellAttributeMatrixName")
-                           .arg(filtName);
-          setErrorCondition(-109871, ss);
-        }
-        rot_Sample->execute();
-      }
-      else
-      {
-        QString ss = QObject::tr("Error creating filter '%1' which is a subfilter called by ReadH5Ebsd. Filter was not created/executed. Please notify the developers").arg(filtName);
-        setErrorCondition(-109870, ss);
-      }
+      return -1;
     }
-
-    if(m_EulerTransformation.angle > 0)
+    size_t plane = static_cast<size_t>(zval);
+    if(plane < newDims[2])
     {
-      FloatVec3Type eulerAxis;
-      eulerAxis[0] = m_EulerTransformation.h;
-      eulerAxis[1] = m_EulerTransformation.k;
-      eulerAxis[2] = m_EulerTransformation.l;
-
-      QString filtName = "RotateEulerRefFrame";
-      FilterManager* fm = FilterManager::Instance();
-      IFilterFactory::Pointer rotEulerFactory = fm->getFactoryFromClassName(filtName);
-      if(nullptr != rotEulerFactory.get())
+      if(isTSL)
       {
-        // If we get this far, the Factory is good so creating the filter should not fail unless something has
-        // horribly gone wrong in which case the system is going to come down quickly after this.
-        AbstractFilter::Pointer rot_Euler = rotEulerFactory->create();
-
-        // Connect up the Error/Warning/Progress object so the filter can report those things
-        connect(rot_Euler.get(), SIGNAL(messageGenerated(const AbstractMessage::Pointer&)), this, SIGNAL(messageGenerated(const AbstractMessage::Pointer&)));
-        rot_Euler->setDataContainerArray(getDataContainerArray()); // AbstractFilter implements this so no problem
-        // Now set the filter parameters for the filter using QProperty System since we can not directly
-        // instantiate the filter since it resides in a plugin. These calls are SLOW. DO NOT EVER do this in a
-        // tight loop. Your filter will slow down by 10X.
-        bool propWasSet = rot_Euler->setProperty("RotationAngle", m_EulerTransformation.angle);
-        if(!propWasSet)
-        {
-          QString ss = QObject::tr("ReadH5Ebsd Error Setting Property '%1' into filter '%2' which is a subfilter called by ReadH5Ebsd. The property was not set which could mean the property was not "
-                                   "exposed with a Q_PROPERTY macro. Please notify the developers")
-                           .arg("RotationAngle")
-                           .arg(filtName);
-          setErrorCondition(-109874, ss);
-        }
-        QVariant v;
-        v.setValue(eulerAxis);
-        propWasSet = rot_Euler->setProperty("RotationAxis", v);
-        if(!propWasSet)
-        {
-          QString ss = QObject::tr("ReadH5Ebsd Error Setting Property '%1' into filter '%2' which is a subfilter called by ReadH5Ebsd. The property was not set which could mean the property was not "
-                                   "exposed with a Q_PROPERTY macro. Please notify the developers")
-                           .arg("RotationAxis")
-                           .arg(filtName);
-          setErrorCondition(-109873, ss);
-        }
-        DataArrayPath tempPath;
-        tempPath.update(getDataContainerName().getDataContainerName(), getCellAttributeMatrixName(), getCellEulerAnglesArrayName());
-        v.setValue(tempPath);
-        propWasSet = rot_Euler->setProperty("CellEulerAnglesArrayPath", v);
-        if(!propWasSet)
-        {
-          QString ss = QObject::tr("ReadH5Ebsd Error Setting Property '%1' into filter '%2' which is a subfilter called by ReadH5Ebsd. The property was not set which could mean the property was not "
-                                   "exposed with a Q_PROPERTY macro. Please notify the developers")
-                           .arg("CellEulerAnglesArrayPath")
-                           .arg(filtName);
-          setErrorCondition(-109872, ss);
-        }
-        rot_Euler->execute();
+        copyTSLSlice(reader, plane, transform);
       }
       else
       {
-        QString ss = QObject::tr("ReadH5Ebsd Error creating filter '%1' which is a subfilter called by ReadH5Ebsd. Filter was not created/executed. Please notify the developers").arg(filtName);
-        setErrorCondition(-109870, ss);
+        copyHKLSlice(reader, plane, transform);
       }
     }
+    slicesLoaded++;
+    QString ss = QObject::tr("Loaded Slice %1 of %2").arg(slicesLoaded).arg(dims[2]);
+    notifyStatusMessage(ss);
+    return 0;
+  });
+  ebsdReader->setSliceStart(m_ZStartIndex);
+  ebsdReader->setSliceEnd(m_ZEndIndex);
+  ebsdReader->readAllArrays(false);
+  ebsdReader->setArraysToRead(m_SelectedArrayNames);
+  int err = ebsdReader->loadData(dims[0], dims[1], dims[2], m_RefFrameZDir);
+  ebsdReader->setSliceConsumer(H5EbsdVolumeReader::SliceConsumer());
+  if(getCancel())
+  {
+    return;
+  }
+  if(err < 0)
+  {
+    setErrorCondition(err, ebsdReader->getErrorMessage());
+    setErrorCondition(-1, "Error Loading Data from Ebsd Data file.");
+    return;
   }
 
-
+  // Slices of the rotated volume that lie past the loaded slices have no source cells
+  for(size_t plane = dims[2]; plane < newDims[2]; plane++)
+  {
+    if(isTSL)
+    {
+      copyTSLSlice(nullptr, plane, transform);
+    }
+    else
+    {
+      copyHKLSlice(nullptr, plane, transform);
+    }
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -776,217 +744,119 @@ H5EbsdVolumeReader::Pointer ReadH5Ebsd::initHKLEbsdVolumeReader()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void ReadH5Ebsd::copyTSLArrays(H5EbsdVolumeReader* ebsdReader)
+void ReadH5Ebsd::copyTSLSlice(H5EbsdVolumeReader* ebsdReader, size_t plane, const EbsdRefFrameTransform& transform)
 {
-  float* f1 = nullptr;
-  float* f2 = nullptr;
-  float* f3 = nullptr;
-  int32_t* phasePtr = nullptr;
-
-  FloatArrayType::Pointer fArray = FloatArrayType::NullPointer();
-  Int32ArrayType::Pointer iArray = Int32ArrayType::NullPointer();
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
-
   AttributeMatrix::Pointer cellAttrMatrix = m->getAttributeMatrix(getCellAttributeMatrixName());
-  QVector<size_t> tDims(3, 0);
-  tDims[0] = m->getGeometryAs<ImageGeom>()->getXPoints();
-  tDims[1] = m->getGeometryAs<ImageGeom>()->getYPoints();
-  tDims[2] = m->getGeometryAs<ImageGeom>()->getZPoints();
-  cellAttrMatrix->resizeAttributeArrays(tDims); // Resize the attribute Matrix to the proper dimensions
 
-  size_t totalPoints = m->getGeometryAs<ImageGeom>()->getNumberOfElements();
-  QVector<size_t> cDims(1, 1);
-  if(m_SelectedArrayNames.find(m_CellPhasesArrayName) != m_SelectedArrayNames.end())
+  std::vector<int64_t> sources;
+  transform.findSliceSources(plane, sources);
+  size_t numSliceTuples = sources.size();
+  size_t offset = plane * numSliceTuples;
+
+  if(nullptr != m_CellPhasesPtr.lock())
   {
-    phasePtr = reinterpret_cast<int32_t*>(ebsdReader->getPointerByName(Ebsd::Ang::PhaseData));
-    iArray = Int32ArrayType::CreateArray(tDims, cDims, SIMPL::CellData::Phases);
-    ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
-    cellAttrMatrix->insertOrAssign(iArray);
+    const int32_t* phasePtr = (nullptr != ebsdReader) ? reinterpret_cast<int32_t*>(ebsdReader->getPointerByName(Ebsd::Ang::PhaseData)) : nullptr;
+    CopySliceValues<int32_t>(phasePtr, m_CellPhases + offset, sources);
   }
 
-  if(m_SelectedArrayNames.find(m_CellEulerAnglesArrayName) != m_SelectedArrayNames.end())
+  if(nullptr != m_CellEulerAnglesPtr.lock())
   {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ang::Phi1));
-    f2 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ang::Phi));
-    f3 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ang::Phi2));
-    cDims[0] = 3;
-    fArray = FloatArrayType::CreateArray(tDims, cDims, SIMPL::CellData::EulerAngles);
-    float* cellEulerAngles = fArray->getPointer(0);
+    const float* f1 = nullptr;
+    const float* f2 = nullptr;
+    const float* f3 = nullptr;
+    if(nullptr != ebsdReader)
+    {
+      f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ang::Phi1));
+      f2 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ang::Phi));
+      f3 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ang::Phi2));
+    }
+    float* cellEulerAngles = m_CellEulerAngles + 3 * offset;
     float degToRad = 1.0f;
     if(m_AngleRepresentation != Ebsd::AngleRepresentation::Radians && m_UseTransformations)
     {
       degToRad = SIMPLib::Constants::k_PiOver180;
     }
-    for(size_t i = 0; i < totalPoints; i++)
+    for(size_t i = 0; i < numSliceTuples; i++)
     {
-      cellEulerAngles[3 * i] = f1[i] * degToRad;
-      cellEulerAngles[3 * i + 1] = f2[i] * degToRad;
-      cellEulerAngles[3 * i + 2] = f3[i] * degToRad;
+      int64_t source = sources[i];
+      if(source < 0 || nullptr == f1 || nullptr == f2 || nullptr == f3)
+      {
+        cellEulerAngles[3 * i] = 0.0f;
+        cellEulerAngles[3 * i + 1] = 0.0f;
+        cellEulerAngles[3 * i + 2] = 0.0f;
+        continue;
+      }
+      cellEulerAngles[3 * i] = f1[source] * degToRad;
+      cellEulerAngles[3 * i + 1] = f2[source] * degToRad;
+      cellEulerAngles[3 * i + 2] = f3[source] * degToRad;
     }
-    cellAttrMatrix->insertOrAssign(fArray);
-  }
-
-  // Reset this back to 1 for the rest of the arrays
-  cDims[0] = 1;
-
-  if(m_SelectedArrayNames.find(Ebsd::Ang::ImageQuality) != m_SelectedArrayNames.end())
-  {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ang::ImageQuality));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, Ebsd::Ang::ImageQuality);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->insertOrAssign(fArray);
-  }
-
-  if(m_SelectedArrayNames.find(Ebsd::Ang::ConfidenceIndex) != m_SelectedArrayNames.end())
-  {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ang::ConfidenceIndex));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, Ebsd::Ang::ConfidenceIndex);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->insertOrAssign(fArray);
-  }
-
-  if(m_SelectedArrayNames.find(Ebsd::Ang::SEMSignal) != m_SelectedArrayNames.end())
-  {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ang::SEMSignal));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, Ebsd::Ang::SEMSignal);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->insertOrAssign(fArray);
-  }
-
-  if(m_SelectedArrayNames.find(Ebsd::Ang::Fit) != m_SelectedArrayNames.end())
-  {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ang::Fit));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, Ebsd::Ang::Fit);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->insertOrAssign(fArray);
-  }
-
-  if(m_SelectedArrayNames.find(Ebsd::Ang::XPosition) != m_SelectedArrayNames.end())
-  {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ang::XPosition));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, Ebsd::Ang::XPosition);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->insertOrAssign(fArray);
+    transform.rotateEulers(cellEulerAngles, numSliceTuples);
   }
 
-  if(m_SelectedArrayNames.find(Ebsd::Ang::YPosition) != m_SelectedArrayNames.end())
-  {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ang::YPosition));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, Ebsd::Ang::YPosition);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->insertOrAssign(fArray);
-  }
+  AngFields angFeatures;
+  CopySliceArrays(ebsdReader, cellAttrMatrix, angFeatures.getFilterFeatures<QVector<QString>>(), m_SelectedArrayNames, offset, sources);
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void ReadH5Ebsd::copyHKLArrays(H5EbsdVolumeReader* ebsdReader)
+void ReadH5Ebsd::copyHKLSlice(H5EbsdVolumeReader* ebsdReader, size_t plane, const EbsdRefFrameTransform& transform)
 {
-  float* f1 = nullptr;
-  float* f2 = nullptr;
-  float* f3 = nullptr;
-  int32_t* phasePtr = nullptr;
-
-  FloatArrayType::Pointer fArray = FloatArrayType::NullPointer();
-  Int32ArrayType::Pointer iArray = Int32ArrayType::NullPointer();
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
   AttributeMatrix::Pointer cellAttrMatrix = m->getAttributeMatrix(getCellAttributeMatrixName());
-  QVector<size_t> tDims(3, 0);
-  tDims[0] = m->getGeometryAs<ImageGeom>()->getXPoints();
-  tDims[1] = m->getGeometryAs<ImageGeom>()->getYPoints();
-  tDims[2] = m->getGeometryAs<ImageGeom>()->getZPoints();
-  cellAttrMatrix->resizeAttributeArrays(tDims); // Resize the attribute Matrix to the proper dimensions
 
-  size_t totalPoints = m->getGeometryAs<ImageGeom>()->getNumberOfElements();
-  QVector<size_t> cDims(1, 1);
-  phasePtr = reinterpret_cast<int32_t*>(ebsdReader->getPointerByName(Ebsd::Ctf::Phase));
-  iArray = Int32ArrayType::CreateArray(tDims, cDims, SIMPL::CellData::Phases);
-  ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
-  cellAttrMatrix->insertOrAssign(iArray);
+  std::vector<int64_t> sources;
+  transform.findSliceSources(plane, sources);
+  size_t numSliceTuples = sources.size();
+  size_t offset = plane * numSliceTuples;
 
-  if(m_SelectedArrayNames.find(m_CellEulerAnglesArrayName) != m_SelectedArrayNames.end())
+  const int32_t* phasePtr = (nullptr != ebsdReader) ? reinterpret_cast<int32_t*>(ebsdReader->getPointerByName(Ebsd::Ctf::Phase)) : nullptr;
+  if(nullptr != m_CellPhasesPtr.lock())
   {
-    //  radianconversion = M_PI / 180.0;
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ctf::Euler1));
-    f2 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ctf::Euler2));
-    f3 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ctf::Euler3));
-    cDims[0] = 3;
-    fArray = FloatArrayType::CreateArray(tDims, cDims, SIMPL::CellData::EulerAngles);
-    float* cellEulerAngles = fArray->getPointer(0);
-    int32_t* cellPhases = iArray->getPointer(0);
+    CopySliceValues<int32_t>(phasePtr, m_CellPhases + offset, sources);
+  }
+
+  if(nullptr != m_CellEulerAnglesPtr.lock())
+  {
+    const float* f1 = nullptr;
+    const float* f2 = nullptr;
+    const float* f3 = nullptr;
+    if(nullptr != ebsdReader)
+    {
+      f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ctf::Euler1));
+      f2 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ctf::Euler2));
+      f3 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ctf::Euler3));
+    }
+    float* cellEulerAngles = m_CellEulerAngles + 3 * offset;
     float degToRad = 1.0f;
     if(m_AngleRepresentation != Ebsd::AngleRepresentation::Radians && m_UseTransformations)
     {
       degToRad = SIMPLib::Constants::k_PiOver180;
     }
-    for(size_t i = 0; i < totalPoints; i++)
+    for(size_t i = 0; i < numSliceTuples; i++)
     {
-      cellEulerAngles[3 * i] = f1[i] * degToRad;
-      cellEulerAngles[3 * i + 1] = f2[i] * degToRad;
-      cellEulerAngles[3 * i + 2] = f3[i] * degToRad;
-      if(m_CrystalStructures[cellPhases[i]] == Ebsd::CrystalStructure::Hexagonal_High)
+      int64_t source = sources[i];
+      if(source < 0 || nullptr == f1 || nullptr == f2 || nullptr == f3)
+      {
+        cellEulerAngles[3 * i] = 0.0f;
+        cellEulerAngles[3 * i + 1] = 0.0f;
+        cellEulerAngles[3 * i + 2] = 0.0f;
+        continue;
+      }
+      cellEulerAngles[3 * i] = f1[source] * degToRad;
+      cellEulerAngles[3 * i + 1] = f2[source] * degToRad;
+      cellEulerAngles[3 * i + 2] = f3[source] * degToRad;
+      if(nullptr != phasePtr && m_CrystalStructures[phasePtr[source]] == Ebsd::CrystalStructure::Hexagonal_High)
       {
         cellEulerAngles[3 * i + 2] = cellEulerAngles[3 * i + 2] + (30.0 * degToRad);
       }
     }
-    cellAttrMatrix->insertOrAssign(fArray);
+    transform.rotateEulers(cellEulerAngles, numSliceTuples);
   }
 
-  cDims[0] = 1;
-  if(m_SelectedArrayNames.find(Ebsd::Ctf::Bands) != m_SelectedArrayNames.end())
-  {
-    phasePtr = reinterpret_cast<int32_t*>(ebsdReader->getPointerByName(Ebsd::Ctf::Bands));
-    iArray = Int32ArrayType::CreateArray(tDims, cDims, Ebsd::Ctf::Bands);
-    ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
-    cellAttrMatrix->insertOrAssign(iArray);
-  }
-
-  if(m_SelectedArrayNames.find(Ebsd::Ctf::Error) != m_SelectedArrayNames.end())
-  {
-    phasePtr = reinterpret_cast<int32_t*>(ebsdReader->getPointerByName(Ebsd::Ctf::Error));
-    iArray = Int32ArrayType::CreateArray(tDims, cDims, Ebsd::Ctf::Error);
-    ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
-    cellAttrMatrix->insertOrAssign(iArray);
-  }
-
-  if(m_SelectedArrayNames.find(Ebsd::Ctf::MAD) != m_SelectedArrayNames.end())
-  {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ctf::MAD));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, Ebsd::Ctf::MAD);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->insertOrAssign(fArray);
-  }
-
-  if(m_SelectedArrayNames.find(Ebsd::Ctf::BC) != m_SelectedArrayNames.end())
-  {
-    phasePtr = reinterpret_cast<int32_t*>(ebsdReader->getPointerByName(Ebsd::Ctf::BC));
-    iArray = Int32ArrayType::CreateArray(tDims, cDims, Ebsd::Ctf::BC);
-    ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
-    cellAttrMatrix->insertOrAssign(iArray);
-  }
-
-  if(m_SelectedArrayNames.find(Ebsd::Ctf::BS) != m_SelectedArrayNames.end())
-  {
-    phasePtr = reinterpret_cast<int32_t*>(ebsdReader->getPointerByName(Ebsd::Ctf::BS));
-    iArray = Int32ArrayType::CreateArray(tDims, cDims, Ebsd::Ctf::BS);
-    ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
-    cellAttrMatrix->insertOrAssign(iArray);
-  }
-  if(m_SelectedArrayNames.find(Ebsd::Ctf::X) != m_SelectedArrayNames.end())
-  {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ctf::X));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, Ebsd::Ctf::X);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->insertOrAssign(fArray);
-  }
-  if(m_SelectedArrayNames.find(Ebsd::Ctf::Y) != m_SelectedArrayNames.end())
-  {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ctf::Y));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, Ebsd::Ctf::Y);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->insertOrAssign(fArray);
-  }
+  CtfFields ctfFeatures;
+  CopySliceArrays(ebsdReader, cellAttrMatrix, ctfFeatures.getFilterFeatures<QVector<QString>>(), m_SelectedArrayNames, offset, sources);
 }
 
 // -----------------------------------------------------------------------------
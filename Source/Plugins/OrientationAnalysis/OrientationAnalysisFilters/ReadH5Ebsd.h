@@ -46,6 +46,7 @@
 #include "OrientationAnalysis/OrientationAnalysisDLLExport.h"
 
 class H5EbsdVolumeReader;
+class EbsdRefFrameTransform;
 
 /**
  * @brief The ReadH5Ebsd class. See [Filter documentation](@ref readh5ebsd) for details.
@@ -245,16 +246,22 @@ protected:
   H5EbsdVolumeReader::Pointer initHKLEbsdVolumeReader();
 
   /**
-   * @brief copyTSLArrays Copies the read arrays into the data container structure (TSL variant)
-   * @param ebsdReader H5EbsdVolumeReader instance pointer
+   * @brief copyTSLSlice Writes one slice of the final arrays from the slice currently loaded by the
+   * reader, converting and rotating the values on the way (TSL variant)
+   * @param ebsdReader H5EbsdVolumeReader holding the slice, or nullptr for a slice without data
+   * @param plane z index of the slice in the final volume
+   * @param transform Reference frame transforms to apply
    */
-  void copyTSLArrays(H5EbsdVolumeReader* ebsdReader);
+  void copyTSLSlice(H5EbsdVolumeReader* ebsdReader, size_t plane, const EbsdRefFrameTransform& transform);
 
   /**
-   * @brief copyHKLArrays Copies the read arrays into the data container structure (HKL variant)
-   * @param ebsdReader H5EbsdVolumeReader instance pointer
+   * @brief copyHKLSlice Writes one slice of the final arrays from the slice currently loaded by the
+   * reader, converting and rotating the values on the way (HKL variant)
+   * @param ebsdReader H5EbsdVolumeReader holding the slice, or nullptr for a slice without data
+   * @param plane z index of the slice in the final volume
+   * @param transform Reference frame transforms to apply
    */
-  void copyHKLArrays(H5EbsdVolumeReader* ebsdReader);
+  void copyHKLSlice(H5EbsdVolumeReader* ebsdReader, size_t plane, const EbsdRefFrameTransform& transform);
 
   /**
   * @brief loadInfo Reads the values for the phase type, crystal structure
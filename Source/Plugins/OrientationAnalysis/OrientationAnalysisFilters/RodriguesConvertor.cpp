@@ -39,64 +39,11 @@
 #include "SIMPLib/FilterParameters/DataArrayCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 
+#include "OrientationLib/OrientationMath/OrientationBatchTransforms.hpp"
+
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
-
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-#include <tbb/blocked_range.h>
-#include <tbb/parallel_for.h>
-#include <tbb/partitioner.h>
-#include <tbb/task_scheduler_init.h>
-#endif
-
-class RodriguesConvertorImpl
-{
-public:
-  RodriguesConvertorImpl(RodriguesConvertor* filter, float* inputRod, float* outputRod)
-  : m_Filter(filter)
-  , m_Input(inputRod)
-  , m_Output(outputRod)
-  {
-  }
-  RodriguesConvertorImpl(const RodriguesConvertorImpl&) = default; // Copy Constructor
-  RodriguesConvertorImpl(RodriguesConvertorImpl&&) = delete;      // Move Constructor Not Implemented
-  RodriguesConvertorImpl& operator=(const RodriguesConvertorImpl&) = delete; // Copy Assignment Not Implemented
-  RodriguesConvertorImpl& operator=(RodriguesConvertorImpl&&) = delete;      // Move Assignment Not Implemented
-
-  virtual ~RodriguesConvertorImpl() = default;
-
-  void convert(size_t start, size_t end) const
-  {
-     for(size_t i = start; i < end; i++)
-    {
-      if(m_Filter->getCancel()) { return; }
-      float r0 = m_Input[i*3];
-      float r1 = m_Input[i*3 + 1];
-      float r2 = m_Input[i*3 + 2];
-      float length = sqrtf(r0 * r0 + r1 * r1 + r2 * r2);
-
-      m_Output[i*4] = r0/length;
-      m_Output[i*4+1] = r1/length;
-      m_Output[i*4+2] = r2/length;
-      m_Output[i*4+3] = length;
-    }
-    
-  }
-
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  void operator()(const tbb::blocked_range<size_t>& r) const
-  {
-    convert(r.begin(), r.end());
-  }
-#endif
-private:
-  RodriguesConvertor* m_Filter = nullptr;
-  float* m_Input;
-  float* m_Output;
-};
-
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -204,23 +151,8 @@ void RodriguesConvertor::execute()
   size_t totalPoints = m_RodriguesVectorsPtr.lock()->getNumberOfTuples();
 
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
-  bool doParallel = true;
-#endif
-  
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  if(doParallel)
-  {
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints), RodriguesConvertorImpl(this, m_RodriguesVectors, m_OutputRodriguesVectors), tbb::auto_partitioner());
-  }
-  else
-#endif
-  {
-    RodriguesConvertorImpl serial(this, m_RodriguesVectors, m_OutputRodriguesVectors);
-    serial.convert(0, totalPoints);
-  }
-  
+  ConvertOrientationBatch<float, Convertors::Rv2Ro<float>>(m_RodriguesVectors, m_OutputRodriguesVectors, totalPoints);
+
   /* Do not forget to remove the original array if requested */
   if(getDeleteOriginalData())
   {
@@ -0,0 +1,310 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include "EbsdRefFrameTransform.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Math/GeometryMath.h"
+#include "SIMPLib/Math/MatrixMath.h"
+
+#include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+
+namespace
+{
+/**
+ * @brief The RotateEulersImpl class rotates a run of Euler angle triplets in place
+ */
+class RotateEulersImpl
+{
+public:
+  RotateEulersImpl(float* eulers, const float rotMat[3][3])
+  : m_Eulers(eulers)
+  {
+    for(size_t i = 0; i < 3; i++)
+    {
+      for(size_t j = 0; j < 3; j++)
+      {
+        m_RotMat[i][j] = rotMat[i][j];
+      }
+    }
+  }
+  virtual ~RotateEulersImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    float rotMat[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    for(size_t i = 0; i < 3; i++)
+    {
+      for(size_t j = 0; j < 3; j++)
+      {
+        rotMat[i][j] = m_RotMat[i][j];
+      }
+    }
+    float g[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    float gNew[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    for(size_t i = start; i < end; i++)
+    {
+      FOrientArrayType om(9);
+      FOrientTransformsType::eu2om(FOrientArrayType(m_Eulers[3 * i], m_Eulers[3 * i + 1], m_Eulers[3 * i + 2]), om);
+      om.toGMatrix(g);
+      MatrixMath::Multiply3x3with3x3(g, rotMat, gNew);
+      MatrixMath::Normalize3x3(gNew);
+      // The new Euler angles are written straight back into the array
+      FOrientArrayType eu(m_Eulers + (3 * i), 3);
+      FOrientTransformsType::om2eu(FOrientArrayType(gNew), eu);
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  float* m_Eulers;
+  float m_RotMat[3][3];
+};
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+EbsdRefFrameTransform::EbsdRefFrameTransform() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+EbsdRefFrameTransform::~EbsdRefFrameTransform() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EbsdRefFrameTransform::setSampleRotation(const size_t dims[3], const float spacing[3], const float axis[3], float angle)
+{
+  for(size_t d = 0; d < 3; d++)
+  {
+    m_Dims[d] = static_cast<int64_t>(dims[d]);
+    m_Spacing[d] = spacing[d];
+    m_NewDims[d] = m_Dims[d];
+    m_NewSpacing[d] = spacing[d];
+    m_NewOrigin[d] = 0.0f;
+  }
+  m_HasSampleRotation = angle > 0.0f;
+  if(!m_HasSampleRotation)
+  {
+    return;
+  }
+
+  float rotAngle = angle * SIMPLib::Constants::k_Pi / 180.0;
+  float rotMat[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+  FOrientArrayType om(9);
+  FOrientTransformsType::ax2om(FOrientArrayType(axis[0], axis[1], axis[2], rotAngle), om);
+  om.toGMatrix(rotMat);
+
+  // The rotated volume is the bounding box of the eight rotated corners
+  float mins[3] = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+  float maxs[3] = {-mins[0], -mins[1], -mins[2]};
+  float coords[3] = {0.0f, 0.0f, 0.0f};
+  float newCoords[3] = {0.0f, 0.0f, 0.0f};
+  for(size_t corner = 0; corner < 8; corner++)
+  {
+    size_t col = (corner & 1) != 0 ? dims[0] - 1 : 0;
+    size_t row = (corner & 2) != 0 ? dims[1] - 1 : 0;
+    size_t plane = (corner & 4) != 0 ? dims[2] - 1 : 0;
+    coords[0] = static_cast<float>(col * spacing[0]);
+    coords[1] = static_cast<float>(row * spacing[1]);
+    coords[2] = static_cast<float>(plane * spacing[2]);
+    MatrixMath::Multiply3x3with3x1(rotMat, coords, newCoords);
+    for(size_t d = 0; d < 3; d++)
+    {
+      mins[d] = std::min(mins[d], newCoords[d]);
+      maxs[d] = std::max(maxs[d], newCoords[d]);
+    }
+  }
+
+  // Each rotated axis keeps the spacing of the original axis it lies closest to
+  float axes[3][3] = {{1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}};
+  float newAxis[3] = {0.0f, 0.0f, 0.0f};
+  for(size_t a = 0; a < 3; a++)
+  {
+    MatrixMath::Multiply3x3with3x1(rotMat, axes[a], newAxis);
+    float closestAxis = std::fabs(GeometryMath::CosThetaBetweenVectors(axes[a], newAxis));
+    for(size_t b = 0; b < 3; b++)
+    {
+      float cosTheta = std::fabs(GeometryMath::CosThetaBetweenVectors(axes[b], newAxis));
+      if(b != a && cosTheta > closestAxis)
+      {
+        m_NewSpacing[a] = spacing[b];
+        closestAxis = cosTheta;
+      }
+    }
+    m_NewDims[a] = static_cast<int64_t>(nearbyint((maxs[a] - mins[a]) / m_NewSpacing[a]) + 1);
+    m_NewOrigin[a] = mins[a];
+  }
+
+  for(size_t i = 0; i < 3; i++)
+  {
+    for(size_t j = 0; j < 3; j++)
+    {
+      m_SampleRotMatInv[i][j] = rotMat[j][i];
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EbsdRefFrameTransform::setEulerRotation(const float axis[3], float angle)
+{
+  m_HasEulerRotation = angle > 0.0f;
+  if(!m_HasEulerRotation)
+  {
+    return;
+  }
+  float rotAngle = angle * SIMPLib::Constants::k_Pi / 180.0f;
+  float rotAxis[3] = {axis[0], axis[1], axis[2]};
+  MatrixMath::Normalize3x1(rotAxis);
+  FOrientArrayType om(9, 0.0f);
+  FOrientTransformsType::ax2om(FOrientArrayType(rotAxis[0], rotAxis[1], rotAxis[2], rotAngle), om);
+  om.toGMatrix(m_EulerRotMat);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool EbsdRefFrameTransform::hasSampleRotation() const
+{
+  return m_HasSampleRotation;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool EbsdRefFrameTransform::hasEulerRotation() const
+{
+  return m_HasEulerRotation;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EbsdRefFrameTransform::getRotatedGeometry(size_t dims[3], float spacing[3], float origin[3]) const
+{
+  for(size_t d = 0; d < 3; d++)
+  {
+    dims[d] = static_cast<size_t>(m_NewDims[d]);
+    spacing[d] = m_NewSpacing[d];
+    origin[d] = m_NewOrigin[d];
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EbsdRefFrameTransform::findSliceSources(size_t plane, std::vector<int64_t>& sources) const
+{
+  sources.assign(static_cast<size_t>(m_NewDims[0] * m_NewDims[1]), -1);
+  int64_t k = static_cast<int64_t>(plane);
+  if(k >= m_Dims[2])
+  {
+    return;
+  }
+  if(!m_HasSampleRotation)
+  {
+    for(size_t i = 0; i < sources.size(); i++)
+    {
+      sources[i] = static_cast<int64_t>(i);
+    }
+    return;
+  }
+
+  float coords[3] = {0.0f, 0.0f, 0.0f};
+  float coordsOld[3] = {0.0f, 0.0f, 0.0f};
+  coords[2] = (float(k) * m_NewSpacing[2]) + m_NewOrigin[2];
+  for(int64_t j = 0; j < m_NewDims[1]; j++)
+  {
+    coords[1] = (float(j) * m_NewSpacing[1]) + m_NewOrigin[1];
+    for(int64_t i = 0; i < m_NewDims[0]; i++)
+    {
+      coords[0] = (float(i) * m_NewSpacing[0]) + m_NewOrigin[0];
+      coordsOld[0] = m_SampleRotMatInv[0][0] * coords[0] + m_SampleRotMatInv[0][1] * coords[1] + m_SampleRotMatInv[0][2] * coords[2];
+      coordsOld[1] = m_SampleRotMatInv[1][0] * coords[0] + m_SampleRotMatInv[1][1] * coords[1] + m_SampleRotMatInv[1][2] * coords[2];
+      int64_t colOld = static_cast<int64_t>(nearbyint(coordsOld[0] / m_Spacing[0]));
+      int64_t rowOld = static_cast<int64_t>(nearbyint(coordsOld[1] / m_Spacing[1]));
+      if(colOld >= 0 && colOld < m_Dims[0] && rowOld >= 0 && rowOld < m_Dims[1])
+      {
+        sources[j * m_NewDims[0] + i] = (m_Dims[0] * rowOld) + colOld;
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EbsdRefFrameTransform::rotateEulers(float* eulers, size_t numTuples) const
+{
+  if(!m_HasEulerRotation)
+  {
+    return;
+  }
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numTuples), RotateEulersImpl(eulers, m_EulerRotMat), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    RotateEulersImpl serial(eulers, m_EulerRotMat);
+    serial.convert(0, numTuples);
+  }
+}
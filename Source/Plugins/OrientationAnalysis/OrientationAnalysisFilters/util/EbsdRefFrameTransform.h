@@ -0,0 +1,123 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+
+/**
+ * @brief The EbsdRefFrameTransform class applies the sample and Euler reference frame rotations of
+ * an .h5ebsd file to EBSD data one slice at a time, while the data is being loaded. The sample
+ * rotation remaps the cells of each slice exactly as RotateSampleRefFrame does with its slice by
+ * slice option turned on: every cell of the rotated volume takes the value of the nearest cell in
+ * the slice with the same z index, or zero if there is none. The Euler rotation is the one applied
+ * by RotateEulerRefFrame.
+ */
+class EbsdRefFrameTransform
+{
+public:
+  EbsdRefFrameTransform();
+  virtual ~EbsdRefFrameTransform();
+
+  /**
+   * @brief setSampleRotation Sets the sample rotation and computes the geometry of the rotated volume
+   * @param dims Number of cells of the volume as it is loaded
+   * @param spacing Cell spacing of the volume as it is loaded
+   * @param axis Rotation axis
+   * @param angle Rotation angle in degrees; the cells are left in place unless it is positive
+   */
+  void setSampleRotation(const size_t dims[3], const float spacing[3], const float axis[3], float angle);
+
+  /**
+   * @brief setEulerRotation Sets the rotation applied to the Euler angles
+   * @param axis Rotation axis
+   * @param angle Rotation angle in degrees; the Euler angles are left untouched unless it is positive
+   */
+  void setEulerRotation(const float axis[3], float angle);
+
+  /**
+   * @brief hasSampleRotation Returns whether the cells are remapped
+   */
+  bool hasSampleRotation() const;
+
+  /**
+   * @brief hasEulerRotation Returns whether the Euler angles are rotated
+   */
+  bool hasEulerRotation() const;
+
+  /**
+   * @brief getRotatedGeometry Returns the geometry of the volume after the sample rotation
+   * @param dims [output] Number of cells
+   * @param spacing [output] Cell spacing
+   * @param origin [output] Origin
+   */
+  void getRotatedGeometry(size_t dims[3], float spacing[3], float origin[3]) const;
+
+  /**
+   * @brief findSliceSources Finds, for every cell of one slice of the rotated volume, the cell of
+   * the loaded slice with the same z index that it takes its value from
+   * @param plane z index of the slice
+   * @param sources [output] Index within the loaded slice of the source of every cell, -1 if none
+   */
+  void findSliceSources(size_t plane, std::vector<int64_t>& sources) const;
+
+  /**
+   * @brief rotateEulers Applies the Euler rotation in place
+   * @param eulers Euler angle triplets, in radians
+   * @param numTuples Number of triplets
+   */
+  void rotateEulers(float* eulers, size_t numTuples) const;
+
+private:
+  bool m_HasSampleRotation = false;
+  bool m_HasEulerRotation = false;
+  int64_t m_Dims[3] = {0, 0, 0};
+  float m_Spacing[3] = {0.0f, 0.0f, 0.0f};
+  int64_t m_NewDims[3] = {0, 0, 0};
+  float m_NewSpacing[3] = {0.0f, 0.0f, 0.0f};
+  float m_NewOrigin[3] = {0.0f, 0.0f, 0.0f};
+  float m_SampleRotMatInv[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+  float m_EulerRotMat[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+
+public:
+  EbsdRefFrameTransform(const EbsdRefFrameTransform&) = delete;            // Copy Constructor Not Implemented
+  EbsdRefFrameTransform(EbsdRefFrameTransform&&) = delete;                 // Move Constructor Not Implemented
+  EbsdRefFrameTransform& operator=(const EbsdRefFrameTransform&) = delete; // Copy Assignment Not Implemented
+  EbsdRefFrameTransform& operator=(EbsdRefFrameTransform&&) = delete;      // Move Assignment Not Implemented
+};
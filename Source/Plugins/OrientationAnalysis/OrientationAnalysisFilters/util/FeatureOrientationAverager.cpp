@@ -0,0 +1,434 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include "FeatureOrientationAverager.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include "SIMPLib/Math/SIMPLibMath.h"
+
+namespace
+{
+static const size_t k_MinCellsPerSlab = 16384;
+static const size_t k_NoCell = std::numeric_limits<size_t>::max();
+
+/**
+ * @brief The SlabSums struct holds the private sums of one slab
+ */
+struct SlabSums
+{
+  std::vector<size_t> firstCells;
+  std::vector<uint64_t> counts;
+  std::vector<double> quatSums;
+  std::vector<double> spreadSums;
+};
+
+/**
+ * @brief ReduceToReference Finds the symmetry equivalent of a quaternion closest to a reference,
+ * with the sign that puts it in the same hemisphere as the reference
+ * @param symOps Symmetry operators of the crystal structure
+ * @param reference Reference quaternion
+ * @param quat Quaternion to reduce
+ * @param reduced [output] The reduced quaternion
+ * @param symOpIndex [output] Index of the symmetry operator that gave the reduced quaternion
+ * @return The cosine of half the misorientation angle between the reduced quaternion and the reference
+ */
+float ReduceToReference(const std::vector<QuatF>& symOps, const QuatF& reference, const QuatF& quat, QuatF& reduced, size_t& symOpIndex)
+{
+  float bestDot = -1.0f;
+  QuatF candidate = QuaternionMathF::New();
+  for(size_t j = 0; j < symOps.size(); j++)
+  {
+    QuaternionMathF::Multiply(symOps[j], quat, candidate);
+    float dot = candidate.x * reference.x + candidate.y * reference.y + candidate.z * reference.z + candidate.w * reference.w;
+    if(dot < 0.0f)
+    {
+      QuaternionMathF::Negate(candidate);
+      dot = -dot;
+    }
+    if(dot > bestDot)
+    {
+      bestDot = dot;
+      symOpIndex = j;
+      QuaternionMathF::Copy(candidate, reduced);
+    }
+  }
+  return bestDot;
+}
+
+/**
+ * @brief MisorientationToAverage Returns the cosine of half the misorientation angle between a cell
+ * quaternion and the average of its Feature. The symmetry operator that reduced the cell in the last
+ * averaging sweep is tried first. Two symmetry equivalents of a quaternion are at least the smallest
+ * rotation angle of the group apart, so an equivalent closer than half that angle to the average is
+ * the closest one; only otherwise are all the operators tried again.
+ * @param symOps Symmetry operators of the crystal structure
+ * @param cosQuarterMinAngle Cosine of a quarter of the smallest rotation angle among the operators
+ * @param average Average quaternion of the Feature
+ * @param quat Cell quaternion
+ * @param symOpIndex Index of the operator that reduced the cell in the last averaging sweep
+ */
+float MisorientationToAverage(const std::vector<QuatF>& symOps, float cosQuarterMinAngle, const QuatF& average, const QuatF& quat, size_t symOpIndex)
+{
+  QuatF candidate = QuaternionMathF::New();
+  QuaternionMathF::Multiply(symOps[symOpIndex], quat, candidate);
+  float dot = std::fabs(candidate.x * average.x + candidate.y * average.y + candidate.z * average.z + candidate.w * average.w);
+  if(dot > cosQuarterMinAngle)
+  {
+    return dot;
+  }
+  return ReduceToReference(symOps, average, quat, candidate, symOpIndex);
+}
+
+/**
+ * @brief The AverageOrientationsImpl class runs one sweep over contiguous slabs of cells. Without
+ * references it records the first cell of every Feature. With references it either sums the cell
+ * quaternions reduced against them, recording the symmetry operator of every cell if asked to, or
+ * sums the misorientations of the cells from them starting from the recorded operators.
+ */
+class AverageOrientationsImpl
+{
+public:
+  AverageOrientationsImpl(const int32_t* featureIds, const int32_t* cellPhases, const QuatF* quats, const uint32_t* crystalStructures, size_t numCells, size_t numFeatures,
+                          const std::vector<std::vector<QuatF>>& symOps, const std::vector<float>& cosQuarterMinAngles, const QuatF* references, bool sumSpread, uint8_t* symOpIndices,
+                          size_t numSlabs, std::vector<SlabSums>& slabs)
+  : m_FeatureIds(featureIds)
+  , m_CellPhases(cellPhases)
+  , m_Quats(quats)
+  , m_CrystalStructures(crystalStructures)
+  , m_NumCells(numCells)
+  , m_NumFeatures(numFeatures)
+  , m_SymOps(symOps)
+  , m_CosQuarterMinAngles(cosQuarterMinAngles)
+  , m_References(references)
+  , m_SumSpread(sumSpread)
+  , m_SymOpIndices(symOpIndices)
+  , m_NumSlabs(numSlabs)
+  , m_Slabs(slabs)
+  {
+  }
+  virtual ~AverageOrientationsImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t s = start; s < end; s++)
+    {
+      size_t firstCell = m_NumCells * s / m_NumSlabs;
+      size_t lastCell = m_NumCells * (s + 1) / m_NumSlabs;
+      SlabSums& sums = m_Slabs[s];
+      if(nullptr == m_References)
+      {
+        sums.firstCells.assign(m_NumFeatures, k_NoCell);
+        for(size_t i = firstCell; i < lastCell; i++)
+        {
+          if(m_FeatureIds[i] > 0 && m_CellPhases[i] > 0 && sums.firstCells[m_FeatureIds[i]] == k_NoCell)
+          {
+            sums.firstCells[m_FeatureIds[i]] = i;
+          }
+        }
+        continue;
+      }
+
+      sums.counts.assign(m_NumFeatures, 0);
+      if(m_SumSpread)
+      {
+        sums.spreadSums.assign(m_NumFeatures, 0.0);
+        for(size_t i = firstCell; i < lastCell; i++)
+        {
+          int32_t featureId = m_FeatureIds[i];
+          if(featureId <= 0 || m_CellPhases[i] <= 0)
+          {
+            continue;
+          }
+          uint32_t crystalStructure = m_CrystalStructures[m_CellPhases[i]];
+          float dot = MisorientationToAverage(m_SymOps[crystalStructure], m_CosQuarterMinAngles[crystalStructure], m_References[featureId], m_Quats[i], m_SymOpIndices[i]);
+          sums.counts[featureId]++;
+          sums.spreadSums[featureId] += 2.0 * std::acos(std::min(1.0f, dot));
+        }
+        continue;
+      }
+
+      sums.quatSums.assign(m_NumFeatures * 4, 0.0);
+      QuatF quat = QuaternionMathF::New();
+      size_t symOpIndex = 0;
+      for(size_t i = firstCell; i < lastCell; i++)
+      {
+        int32_t featureId = m_FeatureIds[i];
+        if(featureId <= 0 || m_CellPhases[i] <= 0)
+        {
+          continue;
+        }
+        ReduceToReference(m_SymOps[m_CrystalStructures[m_CellPhases[i]]], m_References[featureId], m_Quats[i], quat, symOpIndex);
+        sums.counts[featureId]++;
+        if(nullptr != m_SymOpIndices)
+        {
+          m_SymOpIndices[i] = static_cast<uint8_t>(symOpIndex);
+        }
+        double* sum = sums.quatSums.data() + featureId * 4;
+        sum[0] += quat.x;
+        sum[1] += quat.y;
+        sum[2] += quat.z;
+        sum[3] += quat.w;
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const int32_t* m_FeatureIds;
+  const int32_t* m_CellPhases;
+  const QuatF* m_Quats;
+  const uint32_t* m_CrystalStructures;
+  size_t m_NumCells;
+  size_t m_NumFeatures;
+  const std::vector<std::vector<QuatF>>& m_SymOps;
+  const std::vector<float>& m_CosQuarterMinAngles;
+  const QuatF* m_References;
+  bool m_SumSpread;
+  uint8_t* m_SymOpIndices;
+  size_t m_NumSlabs;
+  std::vector<SlabSums>& m_Slabs;
+};
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FeatureOrientationAverager::FeatureOrientationAverager()
+{
+  m_OrientationOps = LaueOps::getOrientationOpsQVector();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FeatureOrientationAverager::~FeatureOrientationAverager() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureOrientationAverager::compute(const int32_t* featureIds, const int32_t* cellPhases, const float* quats, const uint32_t* crystalStructures, size_t numCells, size_t numFeatures,
+                                         bool refine, bool computeSpread)
+{
+  size_t numSlabs = 1;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  numSlabs = static_cast<size_t>(tbb::task_scheduler_init::default_num_threads());
+#endif
+  // Each slab carries a full set of per Feature sums, at most a count and a quaternion sum per
+  // Feature. Past the first slab, which any average needs, the number of slabs is capped so that
+  // their sums together take no more memory than the Feature Ids, phases and quaternions of the cells.
+  size_t bytesPerCell = 2 * sizeof(int32_t) + sizeof(QuatF);
+  size_t bytesPerFeature = sizeof(uint64_t) + 4 * sizeof(double);
+  size_t maxSlabs = 1 + numCells * bytesPerCell / std::max(size_t(1), numFeatures * bytesPerFeature);
+  numSlabs = std::max(size_t(1), std::min({numSlabs, numCells / k_MinCellsPerSlab, maxSlabs}));
+
+  // The symmetry operators are copied out once so the sweeps do not go through the LaueOps per
+  // operator, together with a quarter of the smallest rotation angle among them
+  std::vector<std::vector<QuatF>> symOps(static_cast<size_t>(m_OrientationOps.size()));
+  std::vector<float> cosQuarterMinAngles(symOps.size(), -1.0f);
+  for(int32_t c = 0; c < m_OrientationOps.size(); c++)
+  {
+    symOps[c].resize(static_cast<size_t>(m_OrientationOps[c]->getNumSymOps()));
+    for(size_t j = 0; j < symOps[c].size(); j++)
+    {
+      m_OrientationOps[c]->getQuatSymOp(static_cast<int>(j), symOps[c][j]);
+      float halfAngle = std::acos(std::min(1.0f, std::fabs(symOps[c][j].w)));
+      if(halfAngle > 1.0e-3f)
+      {
+        cosQuarterMinAngles[c] = std::max(cosQuarterMinAngles[c], std::cos(0.5f * halfAngle));
+      }
+    }
+  }
+
+  const QuatF* cellQuats = reinterpret_cast<const QuatF*>(quats);
+  std::vector<SlabSums> slabs(numSlabs);
+  auto sweep = [&](const QuatF* references, bool sumSpread, uint8_t* symOpIndices) {
+    AverageOrientationsImpl body(featureIds, cellPhases, cellQuats, crystalStructures, numCells, numFeatures, symOps, cosQuarterMinAngles, references, sumSpread, symOpIndices, numSlabs,
+                                 slabs);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel && numSlabs > 1)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlabs, 1), body, tbb::simple_partitioner());
+    }
+    else
+#endif
+    {
+      body.convert(0, numSlabs);
+    }
+  };
+
+  // The first cell of each Feature in scan order is its first reference
+  sweep(nullptr, false, nullptr);
+  std::vector<QuatF> references(numFeatures);
+  for(size_t f = 0; f < numFeatures; f++)
+  {
+    QuaternionMathF::Identity(references[f]);
+    for(size_t s = 0; s < numSlabs; s++)
+    {
+      if(slabs[s].firstCells[f] != k_NoCell)
+      {
+        QuaternionMathF::Copy(cellQuats[slabs[s].firstCells[f]], references[f]);
+        break;
+      }
+    }
+  }
+
+  for(size_t s = 0; s < numSlabs; s++)
+  {
+    std::vector<size_t>().swap(slabs[s].firstCells);
+  }
+
+  auto mergeCounts = [&]() {
+    m_Counts.swap(slabs[0].counts);
+    for(size_t s = 1; s < numSlabs; s++)
+    {
+      for(size_t f = 0; f < numFeatures; f++)
+      {
+        m_Counts[f] += slabs[s].counts[f];
+      }
+    }
+  };
+
+  // The last averaging sweep records the symmetry operator every cell was reduced with, which the
+  // spread sweep tries first against the average
+  std::vector<uint8_t> symOpIndices(computeSpread ? numCells : 0);
+  m_Averages.assign(numFeatures * 4, 0.0);
+  size_t numAveragingSweeps = refine ? 2 : 1;
+  for(size_t pass = 0; pass < numAveragingSweeps; pass++)
+  {
+    bool lastPass = (pass + 1 == numAveragingSweeps);
+    sweep(references.data(), false, (computeSpread && lastPass) ? symOpIndices.data() : nullptr);
+    mergeCounts();
+    for(size_t f = 0; f < numFeatures; f++)
+    {
+      double* average = m_Averages.data() + f * 4;
+      average[0] = average[1] = average[2] = average[3] = 0.0;
+      for(size_t s = 0; s < numSlabs; s++)
+      {
+        const double* sum = slabs[s].quatSums.data() + f * 4;
+        average[0] += sum[0];
+        average[1] += sum[1];
+        average[2] += sum[2];
+        average[3] += sum[3];
+      }
+      double norm = std::sqrt(average[0] * average[0] + average[1] * average[1] + average[2] * average[2] + average[3] * average[3]);
+      if(m_Counts[f] == 0 || norm == 0.0)
+      {
+        average[0] = average[1] = average[2] = 0.0;
+        average[3] = 1.0;
+        norm = 1.0;
+      }
+      average[0] /= norm;
+      average[1] /= norm;
+      average[2] /= norm;
+      average[3] /= norm;
+      references[f].x = static_cast<float>(average[0]);
+      references[f].y = static_cast<float>(average[1]);
+      references[f].z = static_cast<float>(average[2]);
+      references[f].w = static_cast<float>(average[3]);
+    }
+  }
+
+  m_Spreads.assign(computeSpread ? numFeatures : 0, 0.0);
+  if(!computeSpread)
+  {
+    return;
+  }
+  // The spread is measured against the average that is returned, which is only known once the
+  // averaging sweeps are done, so it takes its own sweep
+  for(size_t s = 0; s < numSlabs; s++)
+  {
+    std::vector<double>().swap(slabs[s].quatSums);
+  }
+  sweep(references.data(), true, symOpIndices.data());
+  mergeCounts();
+  for(size_t s = 0; s < numSlabs; s++)
+  {
+    for(size_t f = 0; f < numFeatures; f++)
+    {
+      m_Spreads[f] += slabs[s].spreadSums[f];
+    }
+  }
+  for(size_t f = 0; f < numFeatures; f++)
+  {
+    m_Spreads[f] = (m_Counts[f] > 0) ? SIMPLib::Constants::k_180OverPi * m_Spreads[f] / static_cast<double>(m_Counts[f]) : 0.0;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+uint64_t FeatureOrientationAverager::getCount(size_t featureId) const
+{
+  return m_Counts[featureId];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureOrientationAverager::getAverage(size_t featureId, QuatF& avgQuat) const
+{
+  const double* average = m_Averages.data() + featureId * 4;
+  avgQuat.x = static_cast<float>(average[0]);
+  avgQuat.y = static_cast<float>(average[1]);
+  avgQuat.z = static_cast<float>(average[2]);
+  avgQuat.w = static_cast<float>(average[3]);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+float FeatureOrientationAverager::getSpread(size_t featureId) const
+{
+  return static_cast<float>(m_Spreads[featureId]);
+}
@@ -0,0 +1,115 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <QtCore/QVector>
+
+#include "SIMPLib/SIMPLib.h"
+
+#include "OrientationLib/LaueOps/LaueOps.h"
+
+/**
+ * @brief The FeatureOrientationAverager class computes the average orientation of every Feature
+ * from the quaternions of its cells. Each cell quaternion is reduced to the symmetry equivalent
+ * nearest a fixed reference before it is summed, so the result does not depend on the order in
+ * which the cells are visited. The reference of a Feature is the orientation of its first cell in
+ * scan order; an optional refinement sweep repeats the reduction against the first average.
+ *
+ * The sweeps split the cells into contiguous slabs that are accumulated in parallel into private
+ * sums, which are then merged in slab order. Beyond the first slab, the number of slabs is capped
+ * so that their sums together take no more memory than the cell arrays. A last sweep can measure
+ * the orientation spread of each Feature, the mean misorientation (in degrees) between its cells and
+ * its final average orientation (GOS). That average is only known once the averaging is done, so
+ * the last averaging sweep records the symmetry operator of every cell (one byte per cell) and the
+ * spread sweep only repeats the full symmetry reduction for cells where that operator is not
+ * guaranteed to give the nearest equivalent.
+ *
+ * Only cells with a Feature Id and a phase greater than 0 take part.
+ */
+class FeatureOrientationAverager
+{
+public:
+  FeatureOrientationAverager();
+  virtual ~FeatureOrientationAverager();
+
+  /**
+   * @brief compute Computes the average orientation of every Feature
+   * @param featureIds Feature Id of every cell
+   * @param cellPhases Phase of every cell
+   * @param quats Quaternion of every cell, stored as x, y, z, w
+   * @param crystalStructures Crystal structure of every phase
+   * @param numCells Number of cells
+   * @param numFeatures Number of Features; every Feature Id must be less than this value
+   * @param refine Whether to repeat the reduction against the first average
+   * @param computeSpread Whether to measure the orientation spread of each Feature against its
+   * final average orientation
+   */
+  void compute(const int32_t* featureIds, const int32_t* cellPhases, const float* quats, const uint32_t* crystalStructures, size_t numCells, size_t numFeatures, bool refine,
+               bool computeSpread);
+
+  /**
+   * @brief getCount Returns the number of cells that took part for a Feature
+   */
+  uint64_t getCount(size_t featureId) const;
+
+  /**
+   * @brief getAverage Copies the unit average quaternion of a Feature; Features without cells get
+   * the identity
+   */
+  void getAverage(size_t featureId, QuatF& avgQuat) const;
+
+  /**
+   * @brief getSpread Returns the mean misorientation in degrees between the cells of a Feature and
+   * its average orientation; only valid if compute() was asked for the spread
+   */
+  float getSpread(size_t featureId) const;
+
+private:
+  QVector<LaueOps::Pointer> m_OrientationOps;
+  std::vector<uint64_t> m_Counts;
+  std::vector<double> m_Averages;
+  std::vector<double> m_Spreads;
+
+public:
+  FeatureOrientationAverager(const FeatureOrientationAverager&) = delete;            // Copy Constructor Not Implemented
+  FeatureOrientationAverager(FeatureOrientationAverager&&) = delete;                 // Move Constructor Not Implemented
+  FeatureOrientationAverager& operator=(const FeatureOrientationAverager&) = delete; // Copy Assignment Not Implemented
+  FeatureOrientationAverager& operator=(FeatureOrientationAverager&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,432 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include "FeaturePairMetrics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include "SIMPLib/Math/SIMPLibMath.h"
+
+namespace
+{
+static const uint64_t k_NoPairKey = std::numeric_limits<uint64_t>::max();
+static const size_t k_NumMetrics = 5;
+
+/**
+ * @brief PairKey Packs a directed Feature pair into one key
+ */
+uint64_t PairKey(int32_t from, int32_t to)
+{
+  return (static_cast<uint64_t>(static_cast<uint32_t>(from)) << 32) | static_cast<uint32_t>(to);
+}
+
+/**
+ * @brief UndirectedKey Returns the key of a pair with the smaller Feature first
+ */
+uint64_t UndirectedKey(uint64_t key)
+{
+  uint64_t from = key >> 32;
+  uint64_t to = key & 0xFFFFFFFFULL;
+  return (from <= to) ? key : ((to << 32) | from);
+}
+
+/**
+ * @brief MetricIndex Returns the storage index of a single Metric flag
+ */
+size_t MetricIndex(uint32_t metric)
+{
+  size_t index = 0;
+  while((metric >> index) != 1)
+  {
+    index++;
+  }
+  return index;
+}
+
+/**
+ * @brief The FindSlotPairsImpl class finds the pair of every slot in the sorted pair list
+ */
+class FindSlotPairsImpl
+{
+public:
+  FindSlotPairsImpl(const std::vector<uint64_t>& slotKeys, const std::vector<uint64_t>& pairs, std::vector<int64_t>& slotPairs, std::vector<uint8_t>& slotReversed)
+  : m_SlotKeys(slotKeys)
+  , m_Pairs(pairs)
+  , m_SlotPairs(slotPairs)
+  , m_SlotReversed(slotReversed)
+  {
+  }
+  virtual ~FindSlotPairsImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t s = start; s < end; s++)
+    {
+      if(m_SlotKeys[s] == k_NoPairKey)
+      {
+        m_SlotPairs[s] = FeaturePairMetrics::k_NoPair;
+        m_SlotReversed[s] = 0;
+        continue;
+      }
+      uint64_t key = UndirectedKey(m_SlotKeys[s]);
+      m_SlotPairs[s] = std::lower_bound(m_Pairs.begin(), m_Pairs.end(), key) - m_Pairs.begin();
+      m_SlotReversed[s] = (key != m_SlotKeys[s]) ? 1 : 0;
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const std::vector<uint64_t>& m_SlotKeys;
+  const std::vector<uint64_t>& m_Pairs;
+  std::vector<int64_t>& m_SlotPairs;
+  std::vector<uint8_t>& m_SlotReversed;
+};
+
+/**
+ * @brief The EvaluatePairsImpl class evaluates the requested metrics for a range of pairs, in
+ * both directions
+ */
+class EvaluatePairsImpl
+{
+public:
+  EvaluatePairsImpl(const std::vector<uint64_t>& pairs, const QuatF* avgQuats, const int32_t* featurePhases, const uint32_t* crystalStructures, const float loadingDirection[3], uint32_t metrics,
+                    const QVector<LaueOps::Pointer>& orientationOps, std::vector<std::vector<float>>& values)
+  : m_Pairs(pairs)
+  , m_AvgQuats(avgQuats)
+  , m_FeaturePhases(featurePhases)
+  , m_CrystalStructures(crystalStructures)
+  , m_LoadingDirection(loadingDirection)
+  , m_Metrics(metrics)
+  , m_OrientationOps(orientationOps)
+  , m_Values(values)
+  {
+  }
+  virtual ~EvaluatePairsImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    QuatF q1 = QuaternionMathF::New();
+    QuatF q2 = QuaternionMathF::New();
+    float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+    float LD[3] = {0.0f, 0.0f, 0.0f};
+    for(size_t p = start; p < end; p++)
+    {
+      int32_t feature1 = static_cast<int32_t>(m_Pairs[p] >> 32);
+      int32_t feature2 = static_cast<int32_t>(m_Pairs[p] & 0xFFFFFFFFULL);
+      uint32_t xtal1 = m_CrystalStructures[m_FeaturePhases[feature1]];
+      uint32_t xtal2 = m_CrystalStructures[m_FeaturePhases[feature2]];
+      bool sameStructure = (xtal1 == xtal2 && static_cast<int64_t>(xtal1) < static_cast<int64_t>(m_OrientationOps.size()));
+      bool slipValid = sameStructure && m_FeaturePhases[feature1] > 0 && m_FeaturePhases[feature2] > 0;
+      LaueOps* ops = sameStructure ? m_OrientationOps[xtal1].get() : nullptr;
+
+      if((m_Metrics & FeaturePairMetrics::Misorientation) != 0)
+      {
+        float w = std::numeric_limits<float>::quiet_NaN();
+        if(sameStructure)
+        {
+          QuaternionMathF::Copy(m_AvgQuats[feature1], q1);
+          QuaternionMathF::Copy(m_AvgQuats[feature2], q2);
+          w = ops->getMisoQuat(q1, q2, n1, n2, n3) * SIMPLib::Constants::k_180OverPi;
+        }
+        store(FeaturePairMetrics::Misorientation, p, w, w);
+      }
+      if((m_Metrics & FeaturePairMetrics::MPrime) != 0)
+      {
+        // m' pairs the most stressed slip system of each Feature, so it does not depend on the direction
+        float mPrime = 0.0f;
+        if(slipValid)
+        {
+          loadPair(feature1, feature2, q1, q2, LD);
+          ops->getmPrime(q1, q2, LD, mPrime);
+        }
+        store(FeaturePairMetrics::MPrime, p, mPrime, mPrime);
+      }
+      evaluateDirectional(FeaturePairMetrics::F1, ops, slipValid, feature1, feature2, p, q1, q2, LD);
+      evaluateDirectional(FeaturePairMetrics::F1spt, ops, slipValid, feature1, feature2, p, q1, q2, LD);
+      evaluateDirectional(FeaturePairMetrics::F7, ops, slipValid, feature1, feature2, p, q1, q2, LD);
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const std::vector<uint64_t>& m_Pairs;
+  const QuatF* m_AvgQuats;
+  const int32_t* m_FeaturePhases;
+  const uint32_t* m_CrystalStructures;
+  const float* m_LoadingDirection;
+  uint32_t m_Metrics;
+  const QVector<LaueOps::Pointer>& m_OrientationOps;
+  std::vector<std::vector<float>>& m_Values;
+
+  void store(FeaturePairMetrics::Metric metric, size_t pair, float forward, float backward) const
+  {
+    std::vector<float>& values = m_Values[MetricIndex(metric)];
+    values[2 * pair] = forward;
+    values[2 * pair + 1] = backward;
+  }
+
+  /**
+   * @brief loadPair Loads fresh copies of the inputs, since the LaueOps slip methods modify them
+   */
+  void loadPair(int32_t from, int32_t to, QuatF& q1, QuatF& q2, float LD[3]) const
+  {
+    QuaternionMathF::Copy(m_AvgQuats[from], q1);
+    QuaternionMathF::Copy(m_AvgQuats[to], q2);
+    LD[0] = m_LoadingDirection[0];
+    LD[1] = m_LoadingDirection[1];
+    LD[2] = m_LoadingDirection[2];
+  }
+
+  void evaluateDirectional(FeaturePairMetrics::Metric metric, LaueOps* ops, bool slipValid, int32_t feature1, int32_t feature2, size_t pair, QuatF& q1, QuatF& q2, float LD[3]) const
+  {
+    if((m_Metrics & metric) == 0)
+    {
+      return;
+    }
+    float values[2] = {0.0f, 0.0f};
+    if(slipValid)
+    {
+      for(size_t direction = 0; direction < 2; direction++)
+      {
+        loadPair(direction == 0 ? feature1 : feature2, direction == 0 ? feature2 : feature1, q1, q2, LD);
+        switch(metric)
+        {
+        case FeaturePairMetrics::F1:
+          ops->getF1(q1, q2, LD, true, values[direction]);
+          break;
+        case FeaturePairMetrics::F1spt:
+          ops->getF1spt(q1, q2, LD, true, values[direction]);
+          break;
+        default:
+          ops->getF7(q1, q2, LD, true, values[direction]);
+          break;
+        }
+      }
+    }
+    store(metric, pair, values[0], values[1]);
+  }
+};
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FeaturePairMetrics::FeaturePairMetrics()
+{
+  m_OrientationOps = LaueOps::getOrientationOpsQVector();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FeaturePairMetrics::~FeaturePairMetrics() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeaturePairMetrics::buildFromNeighborLists(NeighborList<int32_t>& neighborList, size_t numFeatures)
+{
+  m_SlotOffsets.assign(numFeatures + 1, 0);
+  for(size_t i = 0; i < numFeatures; i++)
+  {
+    m_SlotOffsets[i + 1] = m_SlotOffsets[i] + neighborList[static_cast<int32_t>(i)].size();
+  }
+  std::vector<uint64_t> slotKeys(m_SlotOffsets[numFeatures]);
+  for(size_t i = 0; i < numFeatures; i++)
+  {
+    NeighborList<int32_t>::VectorType& neighbors = neighborList[static_cast<int32_t>(i)];
+    for(size_t j = 0; j < neighbors.size(); j++)
+    {
+      slotKeys[m_SlotOffsets[i] + j] = PairKey(static_cast<int32_t>(i), neighbors[j]);
+    }
+  }
+  assignSlots(slotKeys);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeaturePairMetrics::buildFromFaceLabels(const int32_t* faceLabels, size_t numFaces)
+{
+  m_SlotOffsets.clear();
+  std::vector<uint64_t> slotKeys(numFaces);
+  for(size_t i = 0; i < numFaces; i++)
+  {
+    int32_t feature1 = faceLabels[2 * i];
+    int32_t feature2 = faceLabels[2 * i + 1];
+    slotKeys[i] = (feature1 > 0 && feature2 > 0) ? PairKey(feature1, feature2) : k_NoPairKey;
+  }
+  assignSlots(slotKeys);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeaturePairMetrics::assignSlots(const std::vector<uint64_t>& slotKeys)
+{
+  size_t numSlots = slotKeys.size();
+  m_Pairs.clear();
+  m_Pairs.reserve(numSlots);
+  for(uint64_t key : slotKeys)
+  {
+    if(key != k_NoPairKey)
+    {
+      m_Pairs.push_back(UndirectedKey(key));
+    }
+  }
+
+  m_SlotPairs.resize(numSlots);
+  m_SlotReversed.resize(numSlots);
+  FindSlotPairsImpl body(slotKeys, m_Pairs, m_SlotPairs, m_SlotReversed);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  if(doParallel)
+  {
+    tbb::parallel_sort(m_Pairs.begin(), m_Pairs.end());
+    m_Pairs.erase(std::unique(m_Pairs.begin(), m_Pairs.end()), m_Pairs.end());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlots), body, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    std::sort(m_Pairs.begin(), m_Pairs.end());
+    m_Pairs.erase(std::unique(m_Pairs.begin(), m_Pairs.end()), m_Pairs.end());
+    body.convert(0, numSlots);
+  }
+  m_Values.clear();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeaturePairMetrics::evaluate(const float* avgQuats, const int32_t* featurePhases, const uint32_t* crystalStructures, const float loadingDirection[3], uint32_t metrics)
+{
+  m_Values.assign(k_NumMetrics, std::vector<float>());
+  for(size_t m = 0; m < k_NumMetrics; m++)
+  {
+    if((metrics & (1U << m)) != 0)
+    {
+      m_Values[m].resize(2 * m_Pairs.size());
+    }
+  }
+
+  float unitLoading[3] = {0.0f, 0.0f, 1.0f};
+  if(nullptr != loadingDirection)
+  {
+    float length = std::sqrt(loadingDirection[0] * loadingDirection[0] + loadingDirection[1] * loadingDirection[1] + loadingDirection[2] * loadingDirection[2]);
+    if(length > 0.0f)
+    {
+      unitLoading[0] = loadingDirection[0] / length;
+      unitLoading[1] = loadingDirection[1] / length;
+      unitLoading[2] = loadingDirection[2] / length;
+    }
+  }
+
+  EvaluatePairsImpl body(m_Pairs, reinterpret_cast<const QuatF*>(avgQuats), featurePhases, crystalStructures, unitLoading, metrics, m_OrientationOps, m_Values);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, m_Pairs.size()), body, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    body.convert(0, m_Pairs.size());
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t FeaturePairMetrics::getNumberOfPairs() const
+{
+  return m_Pairs.size();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t FeaturePairMetrics::getNumberOfSlots() const
+{
+  return m_SlotPairs.size();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t FeaturePairMetrics::getSlotOffset(size_t featureId) const
+{
+  return m_SlotOffsets[featureId];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+float FeaturePairMetrics::getValue(Metric metric, size_t slot, bool reverse, float noPairValue) const
+{
+  int64_t pair = m_SlotPairs[slot];
+  if(pair == k_NoPair)
+  {
+    return noPairValue;
+  }
+  size_t direction = (m_SlotReversed[slot] != 0) != reverse ? 1 : 0;
+  return m_Values[MetricIndex(metric)][2 * static_cast<size_t>(pair) + direction];
+}
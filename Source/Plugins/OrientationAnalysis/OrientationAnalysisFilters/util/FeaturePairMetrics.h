@@ -0,0 +1,145 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <QtCore/QVector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/NeighborList.hpp"
+
+#include "OrientationLib/LaueOps/LaueOps.h"
+
+/**
+ * @brief The FeaturePairMetrics class evaluates crystallographic metrics between pairs of Features.
+ * The pairs come either from Feature neighbor lists or from the Feature labels of surface mesh
+ * faces; in both cases every unordered pair is evaluated only once, in parallel, no matter how
+ * many neighbor list entries or faces refer to it.
+ *
+ * Each neighbor list entry or face is a slot that refers to one pair, in the direction from the
+ * Feature that owns the neighbor list (or the first face label) to the other one. Symmetric metrics
+ * (misorientation, m') are computed once per pair; the directional slip transmission metrics are
+ * computed in both directions. Slot values are then read with getValue().
+ */
+class FeaturePairMetrics
+{
+public:
+  /**
+   * @brief The Metric enum lists the metrics that can be evaluated; they may be combined as flags
+   */
+  enum Metric : uint32_t
+  {
+    Misorientation = 1, //!< Misorientation angle in degrees, NaN between different crystal structures
+    MPrime = 2,         //!< Luster and Morris m', 0 between different crystal structures
+    F1 = 4,             //!< F1 slip transmission, 0 between different crystal structures
+    F1spt = 8,          //!< F1spt slip transmission, 0 between different crystal structures
+    F7 = 16             //!< F7 slip transmission, 0 between different crystal structures
+  };
+
+  static const int64_t k_NoPair = -1;
+
+  FeaturePairMetrics();
+  virtual ~FeaturePairMetrics();
+
+  /**
+   * @brief buildFromNeighborLists Creates one slot per neighbor list entry, in Feature order
+   * @param neighborList Neighbor list of every Feature
+   * @param numFeatures Number of Features
+   */
+  void buildFromNeighborLists(NeighborList<int32_t>& neighborList, size_t numFeatures);
+
+  /**
+   * @brief buildFromFaceLabels Creates one slot per face, directed from the first label to the
+   * second; faces with a label less than 1 refer to no pair
+   * @param faceLabels Two Feature labels per face
+   * @param numFaces Number of faces
+   */
+  void buildFromFaceLabels(const int32_t* faceLabels, size_t numFaces);
+
+  /**
+   * @brief evaluate Evaluates the requested metrics for every pair
+   * @param avgQuats Average quaternion of every Feature, stored as x, y, z, w
+   * @param featurePhases Phase of every Feature
+   * @param crystalStructures Crystal structure of every phase
+   * @param loadingDirection Loading direction used by the slip transmission metrics; it is normalized here
+   * @param metrics Combination of Metric flags
+   */
+  void evaluate(const float* avgQuats, const int32_t* featurePhases, const uint32_t* crystalStructures, const float loadingDirection[3], uint32_t metrics);
+
+  /**
+   * @brief getNumberOfPairs Returns the number of unique Feature pairs
+   */
+  size_t getNumberOfPairs() const;
+
+  /**
+   * @brief getNumberOfSlots Returns the number of slots
+   */
+  size_t getNumberOfSlots() const;
+
+  /**
+   * @brief getSlotOffset Returns the first slot of a Feature's neighbor list; the slots of the
+   * Feature end at the offset of the next Feature. Only valid after buildFromNeighborLists()
+   */
+  size_t getSlotOffset(size_t featureId) const;
+
+  /**
+   * @brief getValue Returns a metric for a slot
+   * @param metric A single Metric that was evaluated
+   * @param slot Slot index
+   * @param reverse Whether to read the value in the opposite direction of the slot
+   * @param noPairValue Value returned for slots that refer to no pair
+   */
+  float getValue(Metric metric, size_t slot, bool reverse = false, float noPairValue = 0.0f) const;
+
+private:
+  QVector<LaueOps::Pointer> m_OrientationOps;
+  std::vector<uint64_t> m_Pairs;
+  std::vector<int64_t> m_SlotPairs;
+  std::vector<uint8_t> m_SlotReversed;
+  std::vector<size_t> m_SlotOffsets;
+  std::vector<std::vector<float>> m_Values;
+
+  void assignSlots(const std::vector<uint64_t>& slotKeys);
+
+public:
+  FeaturePairMetrics(const FeaturePairMetrics&) = delete;            // Copy Constructor Not Implemented
+  FeaturePairMetrics(FeaturePairMetrics&&) = delete;                 // Move Constructor Not Implemented
+  FeaturePairMetrics& operator=(const FeaturePairMetrics&) = delete; // Copy Assignment Not Implemented
+  FeaturePairMetrics& operator=(FeaturePairMetrics&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,234 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+
+#include "IPFColorLookupTable.h"
+
+#include <cmath>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include "SIMPLib/Utilities/ColorTable.h"
+
+#include "OrientationLib/LaueOps/LaueOps.h"
+
+#include "EbsdLib/EbsdConstants.h"
+
+namespace
+{
+/**
+ * @brief The FillIPFColorTableImpl class computes the exact colors of a run of table rows. Node (i, j)
+ * is the stereographic projection (x, y) = (2 * i / resolution - 1, 2 * j / resolution - 1) of a
+ * direction of the upper hemisphere; nodes outside of the unit circle take the color of the point of
+ * the circle in the same direction.
+ */
+class FillIPFColorTableImpl
+{
+public:
+  FillIPFColorTableImpl(uint32_t crystalStructure, size_t resolution, uint8_t* colors)
+  : m_CrystalStructure(crystalStructure)
+  , m_Resolution(resolution)
+  , m_Colors(colors)
+  {
+  }
+  virtual ~FillIPFColorTableImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    QVector<LaueOps::Pointer> ops = LaueOps::getOrientationOpsQVector();
+    size_t numNodes = m_Resolution + 1;
+    for(size_t j = start; j < end; j++)
+    {
+      double nodeY = 2.0 * static_cast<double>(j) / static_cast<double>(m_Resolution) - 1.0;
+      for(size_t i = 0; i < numNodes; i++)
+      {
+        double x = 2.0 * static_cast<double>(i) / static_cast<double>(m_Resolution) - 1.0;
+        double y = nodeY;
+        double rSq = x * x + y * y;
+        if(rSq > 1.0)
+        {
+          double r = std::sqrt(rSq);
+          x /= r;
+          y /= r;
+          rSq = 1.0;
+        }
+        // Many nodes lie exactly on a mirror plane of the Laue class (x = 0, x = y, ...), where rounding
+        // makes generateIPFColor miss the standard triangle for every symmetry operator and return a
+        // wrong color, so the direction is nudged off these planes by far less than a cell
+        double dir[3] = {2.0 * x / (1.0 + rSq) + 3.0e-6, 2.0 * y / (1.0 + rSq) + 7.0e-6, (1.0 - rSq) / (1.0 + rSq) + 5.0e-6};
+        SIMPL::Rgb argb = ops[m_CrystalStructure]->generateIPFColor(0.0, 0.0, 0.0, dir[0], dir[1], dir[2], false);
+        uint8_t* rgb = m_Colors + (j * numNodes + i) * 3;
+        rgb[0] = static_cast<uint8_t>(RgbColor::dRed(argb));
+        rgb[1] = static_cast<uint8_t>(RgbColor::dGreen(argb));
+        rgb[2] = static_cast<uint8_t>(RgbColor::dBlue(argb));
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  uint32_t m_CrystalStructure = 0;
+  size_t m_Resolution = 0;
+  uint8_t* m_Colors = nullptr;
+};
+
+/**
+ * @brief FillIPFColorTable Computes the exact colors of every node of the upper hemisphere
+ */
+void FillIPFColorTable(uint32_t crystalStructure, size_t resolution, std::vector<uint8_t>& colors)
+{
+  size_t numNodes = resolution + 1;
+  colors.resize(numNodes * numNodes * 3);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numNodes), FillIPFColorTableImpl(crystalStructure, resolution, colors.data()), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    FillIPFColorTableImpl serial(crystalStructure, resolution, colors.data());
+    serial.convert(0, numNodes);
+  }
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+IPFColorLookupTable::IPFColorLookupTable(uint32_t crystalStructure, size_t resolution)
+: m_Resolution(resolution)
+{
+  FillIPFColorTable(crystalStructure, m_Resolution, m_Colors);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+IPFColorLookupTable::~IPFColorLookupTable() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<IPFColorLookupTable::Pointer> IPFColorLookupTable::CreateTables(const uint32_t* crystalStructures, size_t numPhases)
+{
+  std::vector<Pointer> tables(Ebsd::CrystalStructure::LaueGroupEnd);
+  for(size_t phase = 0; phase < numPhases; phase++)
+  {
+    uint32_t crystalStructure = crystalStructures[phase];
+    if(crystalStructure < Ebsd::CrystalStructure::LaueGroupEnd && nullptr == tables[crystalStructure])
+    {
+      tables[crystalStructure] = std::make_shared<IPFColorLookupTable>(crystalStructure);
+    }
+  }
+  return tables;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void IPFColorLookupTable::getColor(const float eulers[3], const float refDir[3], uint8_t rgb[3]) const
+{
+  // Crystal direction g * refDir, with g the orientation matrix of the Bunge Euler angles
+  float c1 = std::cos(eulers[0]);
+  float s1 = std::sin(eulers[0]);
+  float c = std::cos(eulers[1]);
+  float s = std::sin(eulers[1]);
+  float c2 = std::cos(eulers[2]);
+  float s2 = std::sin(eulers[2]);
+  float dir[3] = {(c1 * c2 - s1 * s2 * c) * refDir[0] + (s1 * c2 + c1 * s2 * c) * refDir[1] + (s2 * s) * refDir[2],
+                  (-c1 * s2 - s1 * c2 * c) * refDir[0] + (-s1 * s2 + c1 * c2 * c) * refDir[1] + (c2 * s) * refDir[2], (s1 * s) * refDir[0] + (-c1 * s) * refDir[1] + c * refDir[2]};
+  getCrystalDirectionColor(dir, rgb);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void IPFColorLookupTable::getCrystalDirectionColor(const float dir[3], uint8_t rgb[3]) const
+{
+  float length = std::sqrt(dir[0] * dir[0] + dir[1] * dir[1] + dir[2] * dir[2]);
+  if(length == 0.0f)
+  {
+    rgb[0] = 0;
+    rgb[1] = 0;
+    rgb[2] = 0;
+    return;
+  }
+  float x = dir[0];
+  float y = dir[1];
+  float z = dir[2];
+  if(z < 0.0f)
+  {
+    // Every Laue class contains the inversion, so -dir has the same color as dir
+    x = -x;
+    y = -y;
+    z = -z;
+  }
+
+  // Stereographic projection onto the table, rounded to the nearest node
+  float scale = 0.5f * static_cast<float>(m_Resolution) / (length + z);
+  size_t i = static_cast<size_t>((x + length + z) * scale + 0.5f);
+  size_t j = static_cast<size_t>((y + length + z) * scale + 0.5f);
+  i = (i > m_Resolution) ? m_Resolution : i;
+  j = (j > m_Resolution) ? m_Resolution : j;
+  const uint8_t* color = m_Colors.data() + (j * (m_Resolution + 1) + i) * 3;
+  rgb[0] = color[0];
+  rgb[1] = color[1];
+  rgb[2] = color[2];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+float IPFColorLookupTable::getMaxAngularError() const
+{
+  // The stereographic projection stretches angles by at most 2 (at the pole) and a point is at
+  // most half a cell diagonal, sqrt(2) / resolution, away from its node
+  return 2.0f * std::sqrt(2.0f) / static_cast<float>(m_Resolution);
+}
@@ -0,0 +1,116 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+
+#include "OrientationAnalysis/OrientationAnalysisDLLExport.h"
+
+/**
+ * @brief The IPFColorLookupTable class colors orientations from a precomputed table instead of
+ * running LaueOps::generateIPFColor for every element. The IPF color of an orientation g seen along
+ * a sample direction r only depends on the crystal direction g * r, so the table stores, for one Laue
+ * class, the exact color of a fine grid of crystal directions laid out on the stereographic
+ * projection of the upper hemisphere; directions of the lower hemisphere are folded onto it by the
+ * inversion center, which every Laue class has. Looking up an element costs one orientation matrix,
+ * a stereographic projection and a table read.
+ *
+ * The color returned is the exact color of a crystal direction no more than getMaxAngularError()
+ * away from the true one (0.16 degrees at the default resolution). Next to the edges of the standard
+ * triangle, where the IPF color changes fastest, a channel can be off by up to about 20 (out of 255).
+ * The exact colors of the 6/m, m-3, 4/m and -3 classes jump across the edges of the triangle that are
+ * related by a rotation, so there a few elements take the color of the other side of the edge.
+ */
+class OrientationAnalysis_EXPORT IPFColorLookupTable
+{
+public:
+  using Pointer = std::shared_ptr<IPFColorLookupTable>;
+
+  static const size_t k_DefaultResolution = 1024;
+
+  /**
+   * @brief IPFColorLookupTable Builds the table of one Laue class
+   * @param crystalStructure Index of the Laue class in LaueOps::getOrientationOpsQVector()
+   * @param resolution Number of table cells across the projected hemisphere
+   */
+  IPFColorLookupTable(uint32_t crystalStructure, size_t resolution = k_DefaultResolution);
+  virtual ~IPFColorLookupTable();
+
+  /**
+   * @brief CreateTables Builds a table for every valid Laue class used by an ensemble
+   * @param crystalStructures Laue class of every phase
+   * @param numPhases Number of phases
+   * @return Tables indexed by Laue class; the entries of Laue classes not used are null
+   */
+  static std::vector<Pointer> CreateTables(const uint32_t* crystalStructures, size_t numPhases);
+
+  /**
+   * @brief getColor Writes the IPF color of an orientation seen along a sample direction
+   * @param eulers Bunge Euler angles in radians
+   * @param refDir Sample reference direction, which does not need to be normalized
+   * @param rgb [output] Red, green and blue values
+   */
+  void getColor(const float eulers[3], const float refDir[3], uint8_t rgb[3]) const;
+
+  /**
+   * @brief getCrystalDirectionColor Writes the IPF color of a crystal direction, black for a null direction
+   * @param dir Crystal direction, which does not need to be normalized
+   * @param rgb [output] Red, green and blue values
+   */
+  void getCrystalDirectionColor(const float dir[3], uint8_t rgb[3]) const;
+
+  /**
+   * @brief getMaxAngularError Returns the largest angle, in radians, between a crystal direction
+   * and the direction whose color is returned for it
+   */
+  float getMaxAngularError() const;
+
+private:
+  size_t m_Resolution = 0;
+  std::vector<uint8_t> m_Colors;
+
+public:
+  IPFColorLookupTable(const IPFColorLookupTable&) = delete;            // Copy Constructor Not Implemented
+  IPFColorLookupTable(IPFColorLookupTable&&) = delete;                 // Move Constructor Not Implemented
+  IPFColorLookupTable& operator=(const IPFColorLookupTable&) = delete; // Copy Assignment Not Implemented
+  IPFColorLookupTable& operator=(IPFColorLookupTable&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,157 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include "SphericalPointIndex.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "SIMPLib/Math/SIMPLibMath.h"
+
+namespace
+{
+// Added to the search angle to absorb rounding in the callers' own angle computations
+static const float k_SearchMargin = 1.0E-3f;
+static const int32_t k_MaxPolarBins = 180;
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SphericalPointIndex::SphericalPointIndex() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SphericalPointIndex::~SphericalPointIndex() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SphericalPointIndex::toAngles(float x, float y, float z, float& polar, float& azimuth) const
+{
+  float length = std::sqrt(x * x + y * y + z * z);
+  float cosPolar = (length > 0.0f) ? z / length : 1.0f;
+  polar = std::acos(std::min(1.0f, std::max(-1.0f, cosPolar)));
+  azimuth = std::atan2(y, x);
+  if(azimuth < 0.0f)
+  {
+    azimuth += static_cast<float>(SIMPLib::Constants::k_2Pi);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SphericalPointIndex::build(const float* x, const float* y, const float* z, size_t numPoints, float maxAngle)
+{
+  m_NumPoints = numPoints;
+  m_SearchAngle = maxAngle + k_SearchMargin;
+  // Cells about as wide as the search angle keep the number of cells visited per search small
+  m_NumPolarBins = static_cast<int32_t>(std::ceil(SIMPLib::Constants::k_Pi / m_SearchAngle));
+  m_NumPolarBins = std::max(1, std::min(m_NumPolarBins, k_MaxPolarBins));
+  m_NumAzimuthBins = 2 * m_NumPolarBins;
+
+  float polarBin = static_cast<float>(SIMPLib::Constants::k_Pi) / m_NumPolarBins;
+  float azimuthBin = static_cast<float>(SIMPLib::Constants::k_2Pi) / m_NumAzimuthBins;
+  std::vector<int32_t> pointCells(numPoints);
+  m_CellOffsets.assign(static_cast<size_t>(m_NumPolarBins) * m_NumAzimuthBins + 1, 0);
+  for(size_t i = 0; i < numPoints; i++)
+  {
+    float polar = 0.0f, azimuth = 0.0f;
+    toAngles(x[i], y[i], z[i], polar, azimuth);
+    int32_t row = std::min(static_cast<int32_t>(polar / polarBin), m_NumPolarBins - 1);
+    int32_t col = std::min(static_cast<int32_t>(azimuth / azimuthBin), m_NumAzimuthBins - 1);
+    pointCells[i] = row * m_NumAzimuthBins + col;
+    m_CellOffsets[pointCells[i] + 1]++;
+  }
+  for(size_t c = 1; c < m_CellOffsets.size(); c++)
+  {
+    m_CellOffsets[c] += m_CellOffsets[c - 1];
+  }
+  m_CellPoints.resize(numPoints);
+  std::vector<size_t> cellFill(m_CellOffsets.begin(), m_CellOffsets.end() - 1);
+  for(size_t i = 0; i < numPoints; i++)
+  {
+    m_CellPoints[cellFill[pointCells[i]]++] = static_cast<int32_t>(i);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SphericalPointIndex::findCandidates(const float direction[3], std::vector<int32_t>& candidates) const
+{
+  candidates.clear();
+  float polar = 0.0f, azimuth = 0.0f;
+  toAngles(direction[0], direction[1], direction[2], polar, azimuth);
+
+  float polarBin = static_cast<float>(SIMPLib::Constants::k_Pi) / m_NumPolarBins;
+  float azimuthBin = static_cast<float>(SIMPLib::Constants::k_2Pi) / m_NumAzimuthBins;
+  float minPolar = polar - m_SearchAngle;
+  float maxPolar = polar + m_SearchAngle;
+  int32_t firstRow = std::max(0, static_cast<int32_t>(std::floor(minPolar / polarBin)));
+  int32_t lastRow = std::min(m_NumPolarBins - 1, static_cast<int32_t>(std::floor(maxPolar / polarBin)));
+
+  // A cap that does not contain a pole spans at most asin(sin(r) / sin(polar)) in azimuth
+  int32_t firstCol = 0;
+  int32_t numCols = m_NumAzimuthBins;
+  if(minPolar > 0.0f && maxPolar < static_cast<float>(SIMPLib::Constants::k_Pi))
+  {
+    float halfWidth = std::asin(std::min(1.0f, std::sin(m_SearchAngle) / std::sin(polar)));
+    firstCol = static_cast<int32_t>(std::floor((azimuth - halfWidth) / azimuthBin));
+    int32_t lastCol = static_cast<int32_t>(std::floor((azimuth + halfWidth) / azimuthBin));
+    numCols = std::min(lastCol - firstCol + 1, m_NumAzimuthBins);
+  }
+
+  for(int32_t row = firstRow; row <= lastRow; row++)
+  {
+    for(int32_t c = 0; c < numCols; c++)
+    {
+      int32_t col = ((firstCol + c) % m_NumAzimuthBins + m_NumAzimuthBins) % m_NumAzimuthBins;
+      size_t cell = static_cast<size_t>(row) * m_NumAzimuthBins + col;
+      candidates.insert(candidates.end(), m_CellPoints.begin() + m_CellOffsets[cell], m_CellPoints.begin() + m_CellOffsets[cell + 1]);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t SphericalPointIndex::getNumberOfPoints() const
+{
+  return m_NumPoints;
+}
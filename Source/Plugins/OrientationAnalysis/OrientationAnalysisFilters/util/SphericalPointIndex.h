@@ -0,0 +1,94 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+
+/**
+ * @brief The SphericalPointIndex class bins points on the unit sphere into a grid of polar and
+ * azimuthal angle cells, so that the points lying within a fixed angular distance of a
+ * direction can be found without testing every point. The search is conservative: it may
+ * return some points that are slightly farther away, so callers still apply their own exact
+ * test to each candidate.
+ */
+class SphericalPointIndex
+{
+public:
+  SphericalPointIndex();
+  virtual ~SphericalPointIndex();
+
+  /**
+   * @brief build Bins the points
+   * @param x X component of every point
+   * @param y Y component of every point
+   * @param z Z component of every point
+   * @param numPoints Number of points
+   * @param maxAngle Largest angular distance (in radians) that findCandidates() will search
+   */
+  void build(const float* x, const float* y, const float* z, size_t numPoints, float maxAngle);
+
+  /**
+   * @brief findCandidates Finds every point that may lie within the search angle of a direction
+   * @param direction Direction to search around; it does not need to be normalized
+   * @param candidates Replaced by the indices of the candidate points
+   */
+  void findCandidates(const float direction[3], std::vector<int32_t>& candidates) const;
+
+  /**
+   * @brief getNumberOfPoints Returns the number of points binned
+   */
+  size_t getNumberOfPoints() const;
+
+private:
+  size_t m_NumPoints = 0;
+  float m_SearchAngle = 0.0f;
+  int32_t m_NumPolarBins = 1;
+  int32_t m_NumAzimuthBins = 1;
+  std::vector<size_t> m_CellOffsets;
+  std::vector<int32_t> m_CellPoints;
+
+  void toAngles(float x, float y, float z, float& polar, float& azimuth) const;
+
+public:
+  SphericalPointIndex(const SphericalPointIndex&) = delete;            // Copy Constructor Not Implemented
+  SphericalPointIndex(SphericalPointIndex&&) = delete;                 // Move Constructor Not Implemented
+  SphericalPointIndex& operator=(const SphericalPointIndex&) = delete; // Copy Assignment Not Implemented
+  SphericalPointIndex& operator=(SphericalPointIndex&&) = delete;      // Move Assignment Not Implemented
+};
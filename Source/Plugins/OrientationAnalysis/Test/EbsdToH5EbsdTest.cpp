@@ -0,0 +1,354 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <algorithm>
+#include <cstring>
+#include <list>
+#include <string>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QTextStream>
+
+#include "H5Support/H5ScopedSentinel.h"
+#include "H5Support/H5Utilities.h"
+#include "H5Support/QH5Lite.h"
+#include "H5Support/QH5Utilities.h"
+
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "EbsdLib/EbsdConstants.h"
+#include "EbsdLib/TSL/H5AngImporter.h"
+
+#include "Plugins/OrientationAnalysis/OrientationAnalysisFilters/EbsdToH5Ebsd.h"
+
+#include "OrientationAnalysisTestFileLocations.h"
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_scheduler_init.h>
+#endif
+
+class EbsdToH5EbsdTest
+{
+public:
+  EbsdToH5EbsdTest() = default;
+  ~EbsdToH5EbsdTest() = default;
+
+  SIMPL_TYPE_MACRO(EbsdToH5EbsdTest)
+  EbsdToH5EbsdTest(const EbsdToH5EbsdTest&) = delete;            // Copy Constructor Not Implemented
+  EbsdToH5EbsdTest(EbsdToH5EbsdTest&&) = delete;                 // Move Constructor Not Implemented
+  EbsdToH5EbsdTest& operator=(const EbsdToH5EbsdTest&) = delete; // Copy Assignment Not Implemented
+  EbsdToH5EbsdTest& operator=(EbsdToH5EbsdTest&&) = delete;      // Move Assignment Not Implemented
+
+  const int64_t k_ZStartIndex = 3;
+  const int k_NumCols = 7;
+  const int k_NumRows = 5;
+  const int k_PaddingDigits = 3;
+  const QString k_FilePrefix = "Slice_";
+  const QString k_FileExtension = "ang";
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+    QDir(UnitTest::EbsdToH5EbsdTest::InputDir).removeRecursively();
+    QFile::remove(UnitTest::EbsdToH5EbsdTest::BaselineFile);
+    QFile::remove(UnitTest::EbsdToH5EbsdTest::CompressedFile);
+    QFile::remove(UnitTest::EbsdToH5EbsdTest::ContiguousFile);
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the filter from the FilterManager
+    QString filtName = "EbsdToH5Ebsd";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The EbsdToH5EbsdTest Requires the use of the " << filtName.toStdString() << " filter which is found in the OrientationAnalysis Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // More slices than one parse batch, so the writer overlaps with the parsing of the
+  // next batch at least once
+  // -----------------------------------------------------------------------------
+  int64_t numSlices()
+  {
+    int64_t batchSize = 1;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    batchSize = static_cast<int64_t>(tbb::task_scheduler_init::default_num_threads());
+#endif
+    return std::max(int64_t(9), 2 * batchSize + 3);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  QString slicePath(int64_t z)
+  {
+    return QString("%1/%2%3.%4").arg(UnitTest::EbsdToH5EbsdTest::InputDir).arg(k_FilePrefix).arg(z, k_PaddingDigits, 10, QChar('0')).arg(k_FileExtension);
+  }
+
+  // -----------------------------------------------------------------------------
+  // Writes a small square grid .ang file whose values are different on every slice
+  // -----------------------------------------------------------------------------
+  void writeSlice(int64_t z)
+  {
+    QFile file(slicePath(z));
+    DREAM3D_REQUIRE(file.open(QIODevice::WriteOnly | QIODevice::Text))
+    QTextStream out(&file);
+    out << "# TEM_PIXperUM          1.000000\n";
+    out << "# x-star                0.500000\n";
+    out << "# y-star                0.600000\n";
+    out << "# z-star                0.700000\n";
+    out << "# WorkingDistance       15.000000\n";
+    out << "#\n";
+    out << "# Phase 1\n";
+    out << "# MaterialName  \tNickel\n";
+    out << "# Formula     \tNi\n";
+    out << "# Info \t\t\n";
+    out << "# Symmetry              43\n";
+    out << "# LatticeConstants      3.560 3.560 3.560  90.000  90.000  90.000\n";
+    out << "# NumberFamilies        1\n";
+    out << "# hklFamilies   \t 1  1  1 1 0.000000\n";
+    out << "#\n";
+    out << "# GRID: SqrGrid\n";
+    out << "# XSTEP: 0.250000\n";
+    out << "# YSTEP: 0.250000\n";
+    out << "# NCOLS_ODD: " << k_NumCols << "\n";
+    out << "# NCOLS_EVEN: " << k_NumCols << "\n";
+    out << "# NROWS: " << k_NumRows << "\n";
+    out << "#\n";
+    out << "# OPERATOR: \tTest\n";
+    out << "# SAMPLEID: \tSlice" << z << "\n";
+    out << "# SCANID: \t\n";
+    out << "#\n";
+    for(int row = 0; row < k_NumRows; row++)
+    {
+      for(int col = 0; col < k_NumCols; col++)
+      {
+        int64_t i = (z * k_NumRows + row) * k_NumCols + col;
+        uint32_t h = static_cast<uint32_t>(i * 2654435761u + 12345u);
+        out << QString::number(static_cast<double>(h % 6283) * 0.001, 'f', 5) << " ";
+        out << QString::number(static_cast<double>((h >> 8) % 3141) * 0.001, 'f', 5) << " ";
+        out << QString::number(static_cast<double>((h >> 16) % 6283) * 0.001, 'f', 5) << " ";
+        out << QString::number(col * 0.25, 'f', 5) << " ";
+        out << QString::number(row * 0.25, 'f', 5) << " ";
+        out << QString::number(static_cast<double>(h % 1000) * 0.1, 'f', 1) << " ";
+        out << QString::number(static_cast<double>((h >> 4) % 1000) * 0.001, 'f', 3) << " ";
+        out << (h % 7 == 0 ? 0 : 1) << " ";
+        out << (h >> 20) % 4096 << " ";
+        out << QString::number(static_cast<double>((h >> 12) % 300) * 0.01, 'f', 3) << "\n";
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // The baseline importer: every slice parsed and written one after the other with the
+  // default, contiguous, dataset layout
+  // -----------------------------------------------------------------------------
+  void writeBaseline(int64_t zEnd)
+  {
+    hid_t fileId = QH5Utilities::createFile(UnitTest::EbsdToH5EbsdTest::BaselineFile);
+    DREAM3D_REQUIRED(fileId, >, 0)
+    H5ScopedFileSentinel sentinel(&fileId, true);
+    H5AngImporter::Pointer importer = H5AngImporter::New();
+    for(int64_t z = k_ZStartIndex; z <= zEnd; z++)
+    {
+      int err = importer->importFile(fileId, z, slicePath(z));
+      DREAM3D_REQUIRED(err, >=, 0)
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // The compression settings are left at the filter defaults
+  // -----------------------------------------------------------------------------
+  EbsdToH5Ebsd::Pointer createFilter(const QString& outputFile, int64_t zEnd)
+  {
+    EbsdToH5Ebsd::Pointer filter = EbsdToH5Ebsd::New();
+    filter->setOutputFile(outputFile);
+    filter->setInputPath(UnitTest::EbsdToH5EbsdTest::InputDir);
+    filter->setFilePrefix(k_FilePrefix);
+    filter->setFileSuffix("");
+    filter->setFileExtension(k_FileExtension);
+    filter->setPaddingDigits(k_PaddingDigits);
+    filter->setZStartIndex(k_ZStartIndex);
+    filter->setZEndIndex(zEnd);
+    filter->setZResolution(0.25f);
+    filter->setRefFrameZDir(SIMPL::RefFrameZDir::LowtoHigh);
+    return filter;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  std::vector<char> readDataset(hid_t gid, const std::string& name, H5D_layout_t& layout)
+  {
+    hid_t did = H5Dopen(gid, name.c_str(), H5P_DEFAULT);
+    DREAM3D_REQUIRED(did, >, 0)
+    hid_t fileType = H5Dget_type(did);
+    hid_t memType = H5Tget_native_type(fileType, H5T_DIR_ASCEND);
+    hid_t spaceId = H5Dget_space(did);
+    size_t numBytes = static_cast<size_t>(H5Sget_simple_extent_npoints(spaceId)) * H5Tget_size(memType);
+    hid_t plist = H5Dget_create_plist(did);
+    layout = H5Pget_layout(plist);
+
+    std::vector<char> bytes(numBytes);
+    herr_t err = H5Dread(did, memType, H5S_ALL, H5S_ALL, H5P_DEFAULT, bytes.data());
+    H5Pclose(plist);
+    H5Sclose(spaceId);
+    H5Tclose(memType);
+    H5Tclose(fileType);
+    H5Dclose(did);
+    DREAM3D_REQUIRED(err, >=, 0)
+    return bytes;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Every data array of every slice must hold the same bytes as the baseline, in the
+  // expected layout
+  // -----------------------------------------------------------------------------
+  void compareToBaseline(const QString& outputFile, int64_t zEnd, H5D_layout_t expectedLayout)
+  {
+    hid_t baselineId = QH5Utilities::openFile(UnitTest::EbsdToH5EbsdTest::BaselineFile, true);
+    DREAM3D_REQUIRED(baselineId, >, 0)
+    H5ScopedFileSentinel baselineSentinel(&baselineId, false);
+    hid_t fileId = QH5Utilities::openFile(outputFile, true);
+    DREAM3D_REQUIRED(fileId, >, 0)
+    H5ScopedFileSentinel sentinel(&fileId, false);
+
+    int64_t value = 0;
+    herr_t err = QH5Lite::readScalarDataset(fileId, Ebsd::H5Ebsd::ZEndIndex, value);
+    DREAM3D_REQUIRED(err, >=, 0)
+    DREAM3D_REQUIRE_EQUAL(value, zEnd)
+
+    for(int64_t z = k_ZStartIndex; z <= zEnd; z++)
+    {
+      QString dataPath = QString("%1/%2").arg(z).arg(Ebsd::H5Ebsd::Data);
+      hid_t baselineGid = H5Gopen(baselineId, dataPath.toLatin1().data(), H5P_DEFAULT);
+      DREAM3D_REQUIRED(baselineGid, >, 0)
+      hid_t gid = H5Gopen(fileId, dataPath.toLatin1().data(), H5P_DEFAULT);
+      DREAM3D_REQUIRED(gid, >, 0)
+
+      std::list<std::string> baselineNames;
+      std::list<std::string> names;
+      H5Utilities::getGroupObjects(baselineGid, H5Utilities::H5Support_DATASET, baselineNames);
+      H5Utilities::getGroupObjects(gid, H5Utilities::H5Support_DATASET, names);
+      DREAM3D_REQUIRE_EQUAL(baselineNames.size(), 10)
+      DREAM3D_REQUIRE(baselineNames == names)
+
+      for(const std::string& name : baselineNames)
+      {
+        H5D_layout_t baselineLayout = H5D_LAYOUT_ERROR;
+        H5D_layout_t layout = H5D_LAYOUT_ERROR;
+        std::vector<char> baseline = readDataset(baselineGid, name, baselineLayout);
+        std::vector<char> data = readDataset(gid, name, layout);
+        DREAM3D_REQUIRE_EQUAL(baselineLayout, H5D_CONTIGUOUS)
+        DREAM3D_REQUIRE_EQUAL(layout, expectedLayout)
+        DREAM3D_REQUIRE_EQUAL(baseline.size(), data.size())
+        DREAM3D_REQUIRE(std::memcmp(baseline.data(), data.data(), baseline.size()) == 0)
+      }
+      H5Gclose(gid);
+      H5Gclose(baselineGid);
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // The filter parses the slices in parallel batches and, when asked to, writes chunked,
+  // compressed datasets. The data it writes must not depend on either, and by default the
+  // datasets keep the contiguous layout of the serial import.
+  // -----------------------------------------------------------------------------
+  int TestMatchesSerialImport()
+  {
+    QDir().mkpath(UnitTest::EbsdToH5EbsdTest::InputDir);
+    int64_t zEnd = k_ZStartIndex + numSlices() - 1;
+    for(int64_t z = k_ZStartIndex; z <= zEnd; z++)
+    {
+      writeSlice(z);
+    }
+    writeBaseline(zEnd);
+
+    EbsdToH5Ebsd::Pointer filter = createFilter(UnitTest::EbsdToH5EbsdTest::ContiguousFile, zEnd);
+    DREAM3D_REQUIRE_EQUAL(filter->getCompressionLevel(), 0)
+    DREAM3D_REQUIRE_EQUAL(filter->getUseShuffle(), false)
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0)
+    compareToBaseline(UnitTest::EbsdToH5EbsdTest::ContiguousFile, zEnd, H5D_CONTIGUOUS);
+
+    filter = createFilter(UnitTest::EbsdToH5EbsdTest::CompressedFile, zEnd);
+    filter->setCompressionLevel(1);
+    filter->setUseShuffle(true);
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0)
+    compareToBaseline(UnitTest::EbsdToH5EbsdTest::CompressedFile, zEnd, H5D_CHUNKED);
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "---- " << getNameOfClass().toStdString() << " ----" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability())
+
+    DREAM3D_REGISTER_TEST(TestMatchesSerialImport())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+};
@@ -0,0 +1,503 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/NeighborList.hpp"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+#include "SIMPLib/Math/MatrixMath.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "EbsdLib/EbsdConstants.h"
+
+#include "OrientationLib/LaueOps/LaueOps.h"
+
+#include "OrientationAnalysisTestFileLocations.h"
+
+class FeaturePairMetricsTest
+{
+public:
+  FeaturePairMetricsTest() = default;
+  ~FeaturePairMetricsTest() = default;
+
+  SIMPL_TYPE_MACRO(FeaturePairMetricsTest)
+  FeaturePairMetricsTest(const FeaturePairMetricsTest&) = delete;            // Copy Constructor Not Implemented
+  FeaturePairMetricsTest(FeaturePairMetricsTest&&) = delete;                 // Move Constructor Not Implemented
+  FeaturePairMetricsTest& operator=(const FeaturePairMetricsTest&) = delete; // Copy Assignment Not Implemented
+  FeaturePairMetricsTest& operator=(FeaturePairMetricsTest&&) = delete;      // Move Assignment Not Implemented
+
+  enum SlipMetric
+  {
+    MPrime,
+    F1,
+    F1spt,
+    F7
+  };
+
+  const size_t k_NumFeatures = 60;
+  const size_t k_NumFaces = 5000;
+  const QString k_FaceDataContainerName = "FaceDataContainer";
+
+  // The pair metrics are evaluated once per unordered pair, so a misorientation may be read in
+  // the opposite direction of the baseline, which changes its last bits
+  const float k_MisorientationTolerance = 1.0e-3f;
+  const float k_SlipTolerance = 1.0e-4f;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the filters from the FilterManager
+    QStringList filtNames = {"FindMisorientations", "FindSlipTransmissionMetrics", "FindBoundaryStrengths"};
+    FilterManager* fm = FilterManager::Instance();
+    for(const QString& filtName : filtNames)
+    {
+      IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+      if(nullptr == filterFactory.get())
+      {
+        std::stringstream ss;
+        ss << "The FeaturePairMetricsTest Requires the use of the " << filtName.toStdString() << " filter which is found in the OrientationAnalysis Plugin";
+        DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+      }
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Random Feature orientations and phases: phase 1 is cubic, phase 2 hexagonal and phase 0
+  // unknown. The neighbor lists hold every neighbor of a Feature in random order, and the
+  // face labels refer to random pairs, so most pairs are referenced many times.
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createDataContainerArray()
+  {
+    std::mt19937 generator(11);
+    std::uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+
+    QVector<size_t> tDims(1, k_NumFeatures);
+    AttributeMatrix::Pointer featureAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellFeatureAttributeMatrixName, AttributeMatrix::Type::CellFeature);
+    dc->addOrReplaceAttributeMatrix(featureAttrMat);
+    QVector<size_t> cDims(1, 1);
+    Int32ArrayType::Pointer featurePhases = Int32ArrayType::CreateArray(k_NumFeatures, cDims, SIMPL::FeatureData::Phases);
+    featureAttrMat->insertOrAssign(featurePhases);
+    NeighborList<int32_t>::Pointer neighborList = NeighborList<int32_t>::CreateArray(k_NumFeatures, cDims, SIMPL::FeatureData::NeighborList);
+    featureAttrMat->insertOrAssign(neighborList);
+    cDims[0] = 4;
+    FloatArrayType::Pointer avgQuats = FloatArrayType::CreateArray(k_NumFeatures, cDims, SIMPL::FeatureData::AvgQuats);
+    featureAttrMat->insertOrAssign(avgQuats);
+
+    tDims[0] = 3;
+    AttributeMatrix::Pointer ensembleAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellEnsembleAttributeMatrixName, AttributeMatrix::Type::CellEnsemble);
+    dc->addOrReplaceAttributeMatrix(ensembleAttrMat);
+    cDims[0] = 1;
+    UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(3, cDims, SIMPL::EnsembleData::CrystalStructures);
+    ensembleAttrMat->insertOrAssign(crystalStructures);
+    crystalStructures->setValue(0, Ebsd::CrystalStructure::UnknownCrystalStructure);
+    crystalStructures->setValue(1, Ebsd::CrystalStructure::Cubic_High);
+    crystalStructures->setValue(2, Ebsd::CrystalStructure::Hexagonal_High);
+
+    QuatF* quats = reinterpret_cast<QuatF*>(avgQuats->getPointer(0));
+    for(size_t f = 0; f < k_NumFeatures; f++)
+    {
+      float norm = 0.0f;
+      do
+      {
+        quats[f].x = uniform(generator);
+        quats[f].y = uniform(generator);
+        quats[f].z = uniform(generator);
+        quats[f].w = uniform(generator);
+        norm = std::sqrt(quats[f].x * quats[f].x + quats[f].y * quats[f].y + quats[f].z * quats[f].z + quats[f].w * quats[f].w);
+      } while(norm > 1.0f || norm < 0.1f);
+      QuaternionMathF::ScalarDivide(quats[f], norm);
+      int32_t phase = (f % 7 == 0) ? 0 : ((f % 3 == 0) ? 2 : 1);
+      featurePhases->setValue(f, phase);
+    }
+
+    std::vector<std::vector<int32_t>> neighbors(k_NumFeatures);
+    for(size_t f = 1; f < k_NumFeatures; f++)
+    {
+      for(size_t g = f + 1; g < k_NumFeatures; g++)
+      {
+        if(generator() % 4 == 0)
+        {
+          neighbors[f].push_back(static_cast<int32_t>(g));
+          neighbors[g].push_back(static_cast<int32_t>(f));
+        }
+      }
+    }
+    for(size_t f = 0; f < k_NumFeatures; f++)
+    {
+      std::shuffle(neighbors[f].begin(), neighbors[f].end(), generator);
+      NeighborList<int32_t>::SharedVectorType list(new std::vector<int32_t>(neighbors[f]));
+      neighborList->setList(static_cast<int32_t>(f), list);
+    }
+
+    DataContainer::Pointer faceDC = DataContainer::New(k_FaceDataContainerName);
+    dca->addOrReplaceDataContainer(faceDC);
+    SharedVertexList::Pointer vertex = TriangleGeom::CreateSharedVertexList(3);
+    TriangleGeom::Pointer triangle = TriangleGeom::CreateGeometry(k_NumFaces, vertex, SIMPL::Geometry::TriangleGeometry);
+    faceDC->setGeometry(triangle);
+    std::fill(triangle->getVertexPointer(0), triangle->getVertexPointer(0) + 9, 0.0f);
+    int64_t* tris = triangle->getTriPointer(0);
+    for(size_t t = 0; t < k_NumFaces; t++)
+    {
+      tris[3 * t + 0] = 0;
+      tris[3 * t + 1] = 1;
+      tris[3 * t + 2] = 2;
+    }
+
+    tDims[0] = k_NumFaces;
+    AttributeMatrix::Pointer faceAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::FaceAttributeMatrixName, AttributeMatrix::Type::Face);
+    faceDC->addOrReplaceAttributeMatrix(faceAttrMat);
+    cDims[0] = 2;
+    Int32ArrayType::Pointer faceLabels = Int32ArrayType::CreateArray(k_NumFaces, cDims, SIMPL::FaceData::SurfaceMeshFaceLabels);
+    faceAttrMat->insertOrAssign(faceLabels);
+    for(size_t t = 0; t < k_NumFaces; t++)
+    {
+      // Labels of -1 and 0 are the outside of the mesh
+      int32_t label0 = static_cast<int32_t>(generator() % (k_NumFeatures + 1)) - 1;
+      int32_t label1 = static_cast<int32_t>(generator() % (k_NumFeatures + 1)) - 1;
+      faceLabels->setComponent(t, 0, label0);
+      faceLabels->setComponent(t, 1, label1);
+    }
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The baseline misorientation of a neighbor list entry, evaluated from the owning Feature
+  // -----------------------------------------------------------------------------
+  float referenceMisorientation(const QuatF* quats, const int32_t* phases, const uint32_t* crystalStructures, int32_t feature1, int32_t feature2)
+  {
+    QVector<LaueOps::Pointer> ops = LaueOps::getOrientationOpsQVector();
+    uint32_t xtal1 = crystalStructures[phases[feature1]];
+    uint32_t xtal2 = crystalStructures[phases[feature2]];
+    if(xtal1 != xtal2 || static_cast<int64_t>(xtal1) >= static_cast<int64_t>(ops.size()))
+    {
+      return std::numeric_limits<float>::quiet_NaN();
+    }
+    QuatF q1 = quats[feature1];
+    QuatF q2 = quats[feature2];
+    float n1 = 0.0f;
+    float n2 = 0.0f;
+    float n3 = 0.0f;
+    return ops[xtal1]->getMisoQuat(q1, q2, n1, n2, n3) * SIMPLib::Constants::k_180OverPi;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The baseline slip transmission metric from feature1 into feature2, with the neighbor
+  // orientation actually used and both phases required to be above 0
+  // -----------------------------------------------------------------------------
+  float referenceSlip(SlipMetric metric, const QuatF* quats, const int32_t* phases, const uint32_t* crystalStructures, int32_t feature1, int32_t feature2, const float loading[3])
+  {
+    if(feature1 <= 0 || feature2 <= 0 || phases[feature1] <= 0 || phases[feature2] <= 0)
+    {
+      return 0.0f;
+    }
+    QVector<LaueOps::Pointer> ops = LaueOps::getOrientationOpsQVector();
+    uint32_t xtal1 = crystalStructures[phases[feature1]];
+    uint32_t xtal2 = crystalStructures[phases[feature2]];
+    if(xtal1 != xtal2 || static_cast<int64_t>(xtal1) >= static_cast<int64_t>(ops.size()))
+    {
+      return 0.0f;
+    }
+    QuatF q1 = quats[feature1];
+    QuatF q2 = quats[feature2];
+    float LD[3] = {loading[0], loading[1], loading[2]};
+    float value = 0.0f;
+    switch(metric)
+    {
+    case MPrime:
+      ops[xtal1]->getmPrime(q1, q2, LD, value);
+      break;
+    case F1:
+      ops[xtal1]->getF1(q1, q2, LD, true, value);
+      break;
+    case F1spt:
+      ops[xtal1]->getF1spt(q1, q2, LD, true, value);
+      break;
+    case F7:
+      ops[xtal1]->getF7(q1, q2, LD, true, value);
+      break;
+    }
+    return value;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  AbstractFilter::Pointer createFilter(const QString& filtName, DataContainerArray::Pointer dca)
+  {
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == factory.get())
+    {
+      return AbstractFilter::NullPointer();
+    }
+    AbstractFilter::Pointer filter = factory->create();
+    filter->setDataContainerArray(dca);
+    return filter;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int setFeatureProperties(AbstractFilter::Pointer filter)
+  {
+    const QString dcName = SIMPL::Defaults::ImageDataContainerName;
+    const QString featureAMName = SIMPL::Defaults::CellFeatureAttributeMatrixName;
+    QVariant var;
+    var.setValue(DataArrayPath(dcName, featureAMName, SIMPL::FeatureData::AvgQuats));
+    bool propWasSet = filter->setProperty("AvgQuatsArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(DataArrayPath(dcName, featureAMName, SIMPL::FeatureData::Phases));
+    propWasSet = filter->setProperty("FeaturePhasesArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(DataArrayPath(dcName, SIMPL::Defaults::CellEnsembleAttributeMatrixName, SIMPL::EnsembleData::CrystalStructures));
+    propWasSet = filter->setProperty("CrystalStructuresArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestMisorientations()
+  {
+    DataContainerArray::Pointer dca = createDataContainerArray();
+    AbstractFilter::Pointer filter = createFilter("FindMisorientations", dca);
+    DREAM3D_REQUIRE_VALID_POINTER(filter.get())
+    int err = setFeatureProperties(filter);
+    DREAM3D_REQUIRE_EQUAL(err, EXIT_SUCCESS)
+    QVariant var;
+    var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::NeighborList));
+    bool propWasSet = filter->setProperty("NeighborListArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    propWasSet = filter->setProperty("FindAvgMisors", true);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+
+    AttributeMatrix::Pointer featureAttrMat = dca->getDataContainer(SIMPL::Defaults::ImageDataContainerName)->getAttributeMatrix(SIMPL::Defaults::CellFeatureAttributeMatrixName);
+    const QuatF* quats = reinterpret_cast<const QuatF*>(featureAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::FeatureData::AvgQuats)->getPointer(0));
+    const int32_t* phases = featureAttrMat->getAttributeArrayAs<Int32ArrayType>(SIMPL::FeatureData::Phases)->getPointer(0);
+    const uint32_t* crystalStructures = dca->getDataContainer(SIMPL::Defaults::ImageDataContainerName)
+                                            ->getAttributeMatrix(SIMPL::Defaults::CellEnsembleAttributeMatrixName)
+                                            ->getAttributeArrayAs<UInt32ArrayType>(SIMPL::EnsembleData::CrystalStructures)
+                                            ->getPointer(0);
+    NeighborList<int32_t>::Pointer neighborList = featureAttrMat->getAttributeArrayAs<NeighborList<int32_t>>(SIMPL::FeatureData::NeighborList);
+    NeighborList<float>::Pointer misorientationList = featureAttrMat->getAttributeArrayAs<NeighborList<float>>(SIMPL::FeatureData::MisorientationList);
+    FloatArrayType::Pointer avgMisorientations = featureAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::FeatureData::AvgMisorientations);
+    DREAM3D_REQUIRE_VALID_POINTER(misorientationList.get())
+    DREAM3D_REQUIRE_VALID_POINTER(avgMisorientations.get())
+
+    size_t numNaN = 0;
+    for(size_t f = 1; f < k_NumFeatures; f++)
+    {
+      NeighborList<int32_t>::VectorType& neighbors = (*neighborList)[f];
+      NeighborList<float>::VectorType& misorientations = (*misorientationList)[f];
+      DREAM3D_REQUIRE_EQUAL(misorientations.size(), neighbors.size())
+      float sum = 0.0f;
+      size_t numValid = 0;
+      for(size_t j = 0; j < neighbors.size(); j++)
+      {
+        float expected = referenceMisorientation(quats, phases, crystalStructures, static_cast<int32_t>(f), neighbors[j]);
+        if(std::isnan(expected))
+        {
+          DREAM3D_REQUIRE(std::isnan(misorientations[j]))
+          numNaN++;
+          continue;
+        }
+        DREAM3D_REQUIRE(std::fabs(misorientations[j] - expected) < k_MisorientationTolerance)
+        sum += expected;
+        numValid++;
+      }
+      // The average only counts the neighbors of the same crystal structure
+      if(numValid == 0)
+      {
+        DREAM3D_REQUIRE(std::isnan(avgMisorientations->getValue(f)))
+      }
+      else
+      {
+        DREAM3D_REQUIRE(std::fabs(avgMisorientations->getValue(f) - sum / static_cast<float>(numValid)) < k_MisorientationTolerance)
+      }
+    }
+    DREAM3D_REQUIRE(numNaN > 0)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestSlipTransmissionMetrics()
+  {
+    DataContainerArray::Pointer dca = createDataContainerArray();
+    AbstractFilter::Pointer filter = createFilter("FindSlipTransmissionMetrics", dca);
+    DREAM3D_REQUIRE_VALID_POINTER(filter.get())
+    int err = setFeatureProperties(filter);
+    DREAM3D_REQUIRE_EQUAL(err, EXIT_SUCCESS)
+    QVariant var;
+    var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::NeighborList));
+    bool propWasSet = filter->setProperty("NeighborListArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+
+    AttributeMatrix::Pointer featureAttrMat = dca->getDataContainer(SIMPL::Defaults::ImageDataContainerName)->getAttributeMatrix(SIMPL::Defaults::CellFeatureAttributeMatrixName);
+    const QuatF* quats = reinterpret_cast<const QuatF*>(featureAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::FeatureData::AvgQuats)->getPointer(0));
+    const int32_t* phases = featureAttrMat->getAttributeArrayAs<Int32ArrayType>(SIMPL::FeatureData::Phases)->getPointer(0);
+    const uint32_t* crystalStructures = dca->getDataContainer(SIMPL::Defaults::ImageDataContainerName)
+                                            ->getAttributeMatrix(SIMPL::Defaults::CellEnsembleAttributeMatrixName)
+                                            ->getAttributeArrayAs<UInt32ArrayType>(SIMPL::EnsembleData::CrystalStructures)
+                                            ->getPointer(0);
+    NeighborList<int32_t>::Pointer neighborList = featureAttrMat->getAttributeArrayAs<NeighborList<int32_t>>(SIMPL::FeatureData::NeighborList);
+
+    const float loading[3] = {0.0f, 0.0f, 1.0f};
+    const QString listNames[4] = {SIMPL::FeatureData::mPrimeList, SIMPL::FeatureData::F1List, SIMPL::FeatureData::F1sptList, SIMPL::FeatureData::F7List};
+    for(int32_t m = MPrime; m <= F7; m++)
+    {
+      NeighborList<float>::Pointer metricList = featureAttrMat->getAttributeArrayAs<NeighborList<float>>(listNames[m]);
+      DREAM3D_REQUIRE_VALID_POINTER(metricList.get())
+      size_t numNonZero = 0;
+      for(size_t f = 1; f < k_NumFeatures; f++)
+      {
+        NeighborList<int32_t>::VectorType& neighbors = (*neighborList)[f];
+        NeighborList<float>::VectorType& values = (*metricList)[f];
+        DREAM3D_REQUIRE_EQUAL(values.size(), neighbors.size())
+        for(size_t j = 0; j < neighbors.size(); j++)
+        {
+          float expected = referenceSlip(static_cast<SlipMetric>(m), quats, phases, crystalStructures, static_cast<int32_t>(f), neighbors[j], loading);
+          DREAM3D_REQUIRE(std::fabs(values[j] - expected) < k_SlipTolerance)
+          numNonZero += (expected != 0.0f) ? 1 : 0;
+        }
+      }
+      DREAM3D_REQUIRE(numNonZero > 0)
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestBoundaryStrengths()
+  {
+    DataContainerArray::Pointer dca = createDataContainerArray();
+    AbstractFilter::Pointer filter = createFilter("FindBoundaryStrengths", dca);
+    DREAM3D_REQUIRE_VALID_POINTER(filter.get())
+    int err = setFeatureProperties(filter);
+    DREAM3D_REQUIRE_EQUAL(err, EXIT_SUCCESS)
+    QVariant var;
+    var.setValue(DataArrayPath(k_FaceDataContainerName, SIMPL::Defaults::FaceAttributeMatrixName, SIMPL::FaceData::SurfaceMeshFaceLabels));
+    bool propWasSet = filter->setProperty("SurfaceMeshFaceLabelsArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    FloatVec3Type loading = {0.3f, -0.5f, 0.8f};
+    var.setValue(loading);
+    propWasSet = filter->setProperty("Loading", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+
+    AttributeMatrix::Pointer featureAttrMat = dca->getDataContainer(SIMPL::Defaults::ImageDataContainerName)->getAttributeMatrix(SIMPL::Defaults::CellFeatureAttributeMatrixName);
+    const QuatF* quats = reinterpret_cast<const QuatF*>(featureAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::FeatureData::AvgQuats)->getPointer(0));
+    const int32_t* phases = featureAttrMat->getAttributeArrayAs<Int32ArrayType>(SIMPL::FeatureData::Phases)->getPointer(0);
+    const uint32_t* crystalStructures = dca->getDataContainer(SIMPL::Defaults::ImageDataContainerName)
+                                            ->getAttributeMatrix(SIMPL::Defaults::CellEnsembleAttributeMatrixName)
+                                            ->getAttributeArrayAs<UInt32ArrayType>(SIMPL::EnsembleData::CrystalStructures)
+                                            ->getPointer(0);
+    AttributeMatrix::Pointer faceAttrMat = dca->getDataContainer(k_FaceDataContainerName)->getAttributeMatrix(SIMPL::Defaults::FaceAttributeMatrixName);
+    Int32ArrayType::Pointer faceLabels = faceAttrMat->getAttributeArrayAs<Int32ArrayType>(SIMPL::FaceData::SurfaceMeshFaceLabels);
+
+    float LD[3] = {0.3f, -0.5f, 0.8f};
+    MatrixMath::Normalize3x1(LD);
+    const QString arrayNames[4] = {SIMPL::FaceData::SurfaceMeshmPrimes, SIMPL::FaceData::SurfaceMeshF1s, SIMPL::FaceData::SurfaceMeshF1spts, SIMPL::FaceData::SurfaceMeshF7s};
+    for(int32_t m = MPrime; m <= F7; m++)
+    {
+      FloatArrayType::Pointer metricArray = faceAttrMat->getAttributeArrayAs<FloatArrayType>(arrayNames[m]);
+      DREAM3D_REQUIRE_VALID_POINTER(metricArray.get())
+      size_t numNonZero = 0;
+      for(size_t t = 0; t < k_NumFaces; t++)
+      {
+        int32_t feature1 = faceLabels->getComponent(t, 0);
+        int32_t feature2 = faceLabels->getComponent(t, 1);
+        float forward = referenceSlip(static_cast<SlipMetric>(m), quats, phases, crystalStructures, feature1, feature2, LD);
+        float backward = referenceSlip(static_cast<SlipMetric>(m), quats, phases, crystalStructures, feature2, feature1, LD);
+        DREAM3D_REQUIRE(std::fabs(metricArray->getComponent(t, 0) - forward) < k_SlipTolerance)
+        DREAM3D_REQUIRE(std::fabs(metricArray->getComponent(t, 1) - backward) < k_SlipTolerance)
+        numNonZero += (forward != 0.0f) ? 1 : 0;
+      }
+      DREAM3D_REQUIRE(numNonZero > 0)
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "---- " << getNameOfClass().toStdString() << " ----" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestMisorientations())
+    DREAM3D_REGISTER_TEST(TestSlipTransmissionMetrics())
+    DREAM3D_REGISTER_TEST(TestBoundaryStrengths())
+  }
+};
@@ -0,0 +1,361 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "EbsdLib/EbsdConstants.h"
+
+#include "OrientationLib/LaueOps/LaueOps.h"
+
+#include "OrientationAnalysisTestFileLocations.h"
+
+class FindAvgOrientationsTest
+{
+public:
+  FindAvgOrientationsTest() = default;
+  ~FindAvgOrientationsTest() = default;
+
+  SIMPL_TYPE_MACRO(FindAvgOrientationsTest)
+  FindAvgOrientationsTest(const FindAvgOrientationsTest&) = delete;            // Copy Constructor Not Implemented
+  FindAvgOrientationsTest(FindAvgOrientationsTest&&) = delete;                 // Move Constructor Not Implemented
+  FindAvgOrientationsTest& operator=(const FindAvgOrientationsTest&) = delete; // Copy Assignment Not Implemented
+  FindAvgOrientationsTest& operator=(FindAvgOrientationsTest&&) = delete;      // Move Assignment Not Implemented
+
+  const size_t k_NumCells = 200000;
+  // The last Feature has no cells
+  const size_t k_NumFeatures = 51;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the FindAvgOrientations Filter from the FilterManager
+    QString filtName = "FindAvgOrientations";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The FindAvgOrientationsTest Requires the use of the " << filtName.toStdString() << " filter which is found in the OrientationAnalysis Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Every Feature gets a random orientation; its cells scatter around it and are stored as a
+  // random symmetry equivalent with a random sign. Every fifth Feature is hexagonal, the others
+  // are cubic, and a few cells have phase 0.
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createDataContainerArray(std::vector<QuatF>& truth, float scatter)
+  {
+    QVector<LaueOps::Pointer> ops = LaueOps::getOrientationOpsQVector();
+    std::mt19937 generator(7);
+    std::normal_distribution<float> noise(0.0f, scatter);
+    std::uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+
+    truth.resize(k_NumFeatures);
+    for(QuatF& quat : truth)
+    {
+      float norm = 0.0f;
+      do
+      {
+        quat.x = uniform(generator);
+        quat.y = uniform(generator);
+        quat.z = uniform(generator);
+        quat.w = uniform(generator);
+        norm = std::sqrt(quat.x * quat.x + quat.y * quat.y + quat.z * quat.z + quat.w * quat.w);
+      } while(norm > 1.0f || norm < 0.1f);
+      QuaternionMathF::ScalarDivide(quat, norm);
+    }
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+
+    QVector<size_t> tDims(1, k_NumCells);
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAttrMat);
+    QVector<size_t> cDims(1, 1);
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(k_NumCells, cDims, SIMPL::CellData::FeatureIds);
+    cellAttrMat->insertOrAssign(featureIds);
+    Int32ArrayType::Pointer cellPhases = Int32ArrayType::CreateArray(k_NumCells, cDims, SIMPL::CellData::Phases);
+    cellAttrMat->insertOrAssign(cellPhases);
+    cDims[0] = 4;
+    FloatArrayType::Pointer quats = FloatArrayType::CreateArray(k_NumCells, cDims, SIMPL::CellData::Quats);
+    cellAttrMat->insertOrAssign(quats);
+
+    tDims[0] = k_NumFeatures;
+    AttributeMatrix::Pointer featureAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellFeatureAttributeMatrixName, AttributeMatrix::Type::CellFeature);
+    dc->addOrReplaceAttributeMatrix(featureAttrMat);
+
+    tDims[0] = 3;
+    AttributeMatrix::Pointer ensembleAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellEnsembleAttributeMatrixName, AttributeMatrix::Type::CellEnsemble);
+    dc->addOrReplaceAttributeMatrix(ensembleAttrMat);
+    cDims[0] = 1;
+    UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(3, cDims, SIMPL::EnsembleData::CrystalStructures);
+    ensembleAttrMat->insertOrAssign(crystalStructures);
+    crystalStructures->setValue(0, Ebsd::CrystalStructure::UnknownCrystalStructure);
+    crystalStructures->setValue(1, Ebsd::CrystalStructure::Cubic_High);
+    crystalStructures->setValue(2, Ebsd::CrystalStructure::Hexagonal_High);
+
+    QuatF* cellQuats = reinterpret_cast<QuatF*>(quats->getPointer(0));
+    for(size_t i = 0; i < k_NumCells; i++)
+    {
+      int32_t featureId = static_cast<int32_t>(generator() % (k_NumFeatures - 1));
+      int32_t phase = (featureId % 5 == 0) ? 2 : 1;
+      if(i % 97 == 0)
+      {
+        phase = 0;
+      }
+      featureIds->setValue(i, featureId);
+      cellPhases->setValue(i, phase);
+
+      QuatF delta = QuaternionMathF::New(noise(generator), noise(generator), noise(generator), 1.0f);
+      QuaternionMathF::UnitQuaternion(delta);
+      QuatF quat = QuaternionMathF::New();
+      QuaternionMathF::Multiply(truth[featureId], delta, quat);
+      if(phase > 0)
+      {
+        LaueOps::Pointer op = ops[crystalStructures->getValue(phase)];
+        QuatF symOp = QuaternionMathF::New();
+        op->getQuatSymOp(static_cast<int>(generator() % static_cast<uint32_t>(op->getNumSymOps())), symOp);
+        QuaternionMathF::Multiply(symOp, quat, cellQuats[i]);
+      }
+      else
+      {
+        QuaternionMathF::Copy(quat, cellQuats[i]);
+      }
+      if(generator() & 1)
+      {
+        QuaternionMathF::Negate(cellQuats[i]);
+      }
+    }
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int RunFilter(DataContainerArray::Pointer dca, bool refine)
+  {
+    QString filtName = "FindAvgOrientations";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName(filtName);
+    DREAM3D_REQUIRE(factory.get() != nullptr)
+
+    AbstractFilter::Pointer filter = factory->create();
+    DREAM3D_REQUIRE(filter.get() != nullptr)
+    filter->setDataContainerArray(dca);
+
+    // Refining is opt in
+    DREAM3D_REQUIRE_EQUAL(filter->property("RefineAverage").toBool(), false)
+
+    const QString dcName = SIMPL::Defaults::ImageDataContainerName;
+    const QString cellAMName = SIMPL::Defaults::CellAttributeMatrixName;
+    const QString featureAMName = SIMPL::Defaults::CellFeatureAttributeMatrixName;
+    QVariant var;
+    var.setValue(DataArrayPath(dcName, cellAMName, SIMPL::CellData::FeatureIds));
+    bool propWasSet = filter->setProperty("FeatureIdsArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(DataArrayPath(dcName, cellAMName, SIMPL::CellData::Phases));
+    propWasSet = filter->setProperty("CellPhasesArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(DataArrayPath(dcName, cellAMName, SIMPL::CellData::Quats));
+    propWasSet = filter->setProperty("QuatsArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(DataArrayPath(dcName, SIMPL::Defaults::CellEnsembleAttributeMatrixName, SIMPL::EnsembleData::CrystalStructures));
+    propWasSet = filter->setProperty("CrystalStructuresArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(DataArrayPath(dcName, featureAMName, SIMPL::FeatureData::AvgQuats));
+    propWasSet = filter->setProperty("AvgQuatsArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(DataArrayPath(dcName, featureAMName, SIMPL::FeatureData::AvgEulerAngles));
+    propWasSet = filter->setProperty("AvgEulerAnglesArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(DataArrayPath(dcName, featureAMName, "OrientationSpread"));
+    propWasSet = filter->setProperty("OrientationSpreadArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    propWasSet = filter->setProperty("ComputeOrientationSpread", true);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    propWasSet = filter->setProperty("RefineAverage", refine);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The spread of a Feature must be the mean misorientation of its cells from the average that
+  // was stored, and the Feature without cells gets no spread
+  // -----------------------------------------------------------------------------
+  int CheckSpreads(DataContainerArray::Pointer dca)
+  {
+    DataContainer::Pointer dc = dca->getDataContainer(SIMPL::Defaults::ImageDataContainerName);
+    AttributeMatrix::Pointer cellAttrMat = dc->getAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName);
+    AttributeMatrix::Pointer featureAttrMat = dc->getAttributeMatrix(SIMPL::Defaults::CellFeatureAttributeMatrixName);
+    Int32ArrayType::Pointer featureIds = cellAttrMat->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::FeatureIds);
+    Int32ArrayType::Pointer cellPhases = cellAttrMat->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::Phases);
+    FloatArrayType::Pointer quats = cellAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::CellData::Quats);
+    FloatArrayType::Pointer avgQuats = featureAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::FeatureData::AvgQuats);
+    FloatArrayType::Pointer spreads = featureAttrMat->getAttributeArrayAs<FloatArrayType>("OrientationSpread");
+    DREAM3D_REQUIRE_VALID_POINTER(avgQuats.get())
+    DREAM3D_REQUIRE_VALID_POINTER(spreads.get())
+
+    QVector<LaueOps::Pointer> ops = LaueOps::getOrientationOpsQVector();
+    const uint32_t crystalStructures[3] = {Ebsd::CrystalStructure::UnknownCrystalStructure, Ebsd::CrystalStructure::Cubic_High, Ebsd::CrystalStructure::Hexagonal_High};
+    QuatF* cellQuats = reinterpret_cast<QuatF*>(quats->getPointer(0));
+    QuatF* featureQuats = reinterpret_cast<QuatF*>(avgQuats->getPointer(0));
+    float n1 = 0.0f;
+    float n2 = 0.0f;
+    float n3 = 0.0f;
+
+    std::vector<double> spreadSums(k_NumFeatures, 0.0);
+    std::vector<size_t> counts(k_NumFeatures, 0);
+    for(size_t i = 0; i < k_NumCells; i++)
+    {
+      int32_t featureId = featureIds->getValue(i);
+      int32_t phase = cellPhases->getValue(i);
+      if(featureId <= 0 || phase <= 0)
+      {
+        continue;
+      }
+      spreadSums[featureId] += SIMPLib::Constants::k_180OverPi * ops[crystalStructures[phase]]->getMisoQuat(featureQuats[featureId], cellQuats[i], n1, n2, n3);
+      counts[featureId]++;
+    }
+
+    for(size_t f = 1; f < k_NumFeatures - 1; f++)
+    {
+      DREAM3D_REQUIRE(counts[f] > 0)
+      double expectedSpread = spreadSums[f] / static_cast<double>(counts[f]);
+      DREAM3D_REQUIRE(expectedSpread > 1.0)
+      DREAM3D_REQUIRE(std::fabs(spreads->getValue(f) - expectedSpread) < 1.0e-3)
+    }
+    DREAM3D_REQUIRE_EQUAL(spreads->getValue(k_NumFeatures - 1), 0.0f)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The averages must recover the orientations the cells scatter around by a few degrees
+  // -----------------------------------------------------------------------------
+  int TestAverageAndSpread(bool refine)
+  {
+    std::vector<QuatF> truth;
+    DataContainerArray::Pointer dca = createDataContainerArray(truth, 0.02f);
+    int err = RunFilter(dca, refine);
+    DREAM3D_REQUIRE_EQUAL(err, EXIT_SUCCESS)
+    err = CheckSpreads(dca);
+    DREAM3D_REQUIRE_EQUAL(err, EXIT_SUCCESS)
+
+    DataContainer::Pointer dc = dca->getDataContainer(SIMPL::Defaults::ImageDataContainerName);
+    AttributeMatrix::Pointer featureAttrMat = dc->getAttributeMatrix(SIMPL::Defaults::CellFeatureAttributeMatrixName);
+    FloatArrayType::Pointer avgQuats = featureAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::FeatureData::AvgQuats);
+    DREAM3D_REQUIRE_VALID_POINTER(avgQuats.get())
+
+    QVector<LaueOps::Pointer> ops = LaueOps::getOrientationOpsQVector();
+    const uint32_t crystalStructures[3] = {Ebsd::CrystalStructure::UnknownCrystalStructure, Ebsd::CrystalStructure::Cubic_High, Ebsd::CrystalStructure::Hexagonal_High};
+    QuatF* featureQuats = reinterpret_cast<QuatF*>(avgQuats->getPointer(0));
+    float n1 = 0.0f;
+    float n2 = 0.0f;
+    float n3 = 0.0f;
+    for(size_t f = 1; f < k_NumFeatures - 1; f++)
+    {
+      uint32_t crystalStructure = crystalStructures[(f % 5 == 0) ? 2 : 1];
+      float misorientation = SIMPLib::Constants::k_180OverPi * ops[crystalStructure]->getMisoQuat(truth[f], featureQuats[f], n1, n2, n3);
+      DREAM3D_REQUIRE(misorientation < 0.5f)
+    }
+
+    // The Feature without cells gets the identity
+    size_t empty = k_NumFeatures - 1;
+    DREAM3D_REQUIRE_EQUAL(featureQuats[empty].x, 0.0f)
+    DREAM3D_REQUIRE_EQUAL(featureQuats[empty].y, 0.0f)
+    DREAM3D_REQUIRE_EQUAL(featureQuats[empty].z, 0.0f)
+    DREAM3D_REQUIRE_EQUAL(featureQuats[empty].w, 1.0f)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // With cells scattered by tens of degrees many of them end up far enough from the average that
+  // the spread sweep has to search all the symmetry operators again
+  // -----------------------------------------------------------------------------
+  int TestSpreadOfScatteredFeatures(bool refine)
+  {
+    std::vector<QuatF> truth;
+    DataContainerArray::Pointer dca = createDataContainerArray(truth, 0.15f);
+    int err = RunFilter(dca, refine);
+    DREAM3D_REQUIRE_EQUAL(err, EXIT_SUCCESS)
+    err = CheckSpreads(dca);
+    DREAM3D_REQUIRE_EQUAL(err, EXIT_SUCCESS)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "---- " << getNameOfClass().toStdString() << " ----" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestAverageAndSpread(false))
+    DREAM3D_REGISTER_TEST(TestAverageAndSpread(true))
+    DREAM3D_REGISTER_TEST(TestSpreadOfScatteredFeatures(false))
+    DREAM3D_REGISTER_TEST(TestSpreadOfScatteredFeatures(true))
+  }
+};
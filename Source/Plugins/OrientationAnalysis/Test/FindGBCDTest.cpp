@@ -0,0 +1,531 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include <QtCore/QCoreApplication>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+#include "SIMPLib/Math/MatrixMath.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "EbsdLib/EbsdConstants.h"
+
+#include "OrientationLib/LaueOps/LaueOps.h"
+#include "OrientationLib/OrientationMath/OrientationArray.hpp"
+#include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+
+#include "OrientationAnalysisTestFileLocations.h"
+
+class FindGBCDTest
+{
+public:
+  FindGBCDTest() = default;
+  ~FindGBCDTest() = default;
+
+  SIMPL_TYPE_MACRO(FindGBCDTest)
+  FindGBCDTest(const FindGBCDTest&) = delete;            // Copy Constructor Not Implemented
+  FindGBCDTest(FindGBCDTest&&) = delete;                 // Move Constructor Not Implemented
+  FindGBCDTest& operator=(const FindGBCDTest&) = delete; // Copy Assignment Not Implemented
+  FindGBCDTest& operator=(FindGBCDTest&&) = delete;      // Move Assignment Not Implemented
+
+  const size_t k_NumFeatures = 40;
+  const size_t k_NumPhases = 4;
+
+  // The slabs sum the face areas in a different order than the serial baseline
+  const double k_RelativeTolerance = 1.0e-9;
+
+  /**
+   * @brief The GBCDSpace struct holds the bin layout of the GBCD, computed as FindGBCD::sizeGBCD does
+   */
+  struct GBCDSpace
+  {
+    float deltas[5];
+    int32_t sizes[5];
+    float limits[10];
+    size_t totalBins;
+  };
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the filter from the FilterManager
+    QString filtName = "FindGBCD";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The FindGBCDTest Requires the use of the " << filtName.toStdString() << " filter which is found in the OrientationAnalysis Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Random Feature orientations with phase 1 of an unknown crystal structure and phases 2 and 3
+  // cubic. No Feature belongs to phase 3, so its GBCD is empty. Phase 0 is the outside of the volume. Faces
+  // have random labels (-1 and 0 included), unit normals and areas.
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createDataContainerArray(size_t numFaces)
+  {
+    std::mt19937 generator(5);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    dc->setGeometry(image);
+
+    QVector<size_t> tDims(1, k_NumFeatures);
+    AttributeMatrix::Pointer featureAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellFeatureAttributeMatrixName, AttributeMatrix::Type::CellFeature);
+    dc->addOrReplaceAttributeMatrix(featureAttrMat);
+    QVector<size_t> cDims(1, 1);
+    Int32ArrayType::Pointer featurePhases = Int32ArrayType::CreateArray(k_NumFeatures, cDims, SIMPL::FeatureData::Phases);
+    featureAttrMat->insertOrAssign(featurePhases);
+    cDims[0] = 3;
+    FloatArrayType::Pointer eulers = FloatArrayType::CreateArray(k_NumFeatures, cDims, SIMPL::FeatureData::EulerAngles);
+    featureAttrMat->insertOrAssign(eulers);
+    for(size_t f = 0; f < k_NumFeatures; f++)
+    {
+      eulers->setComponent(f, 0, static_cast<float>(uniform(generator) * SIMPLib::Constants::k_2Pi));
+      eulers->setComponent(f, 1, static_cast<float>(uniform(generator) * SIMPLib::Constants::k_Pi));
+      eulers->setComponent(f, 2, static_cast<float>(uniform(generator) * SIMPLib::Constants::k_2Pi));
+      featurePhases->setValue(f, (f % 5 == 0) ? 1 : 2);
+    }
+
+    tDims[0] = k_NumPhases;
+    AttributeMatrix::Pointer ensembleAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellEnsembleAttributeMatrixName, AttributeMatrix::Type::CellEnsemble);
+    dc->addOrReplaceAttributeMatrix(ensembleAttrMat);
+    cDims[0] = 1;
+    UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(k_NumPhases, cDims, SIMPL::EnsembleData::CrystalStructures);
+    ensembleAttrMat->insertOrAssign(crystalStructures);
+    crystalStructures->setValue(0, Ebsd::CrystalStructure::UnknownCrystalStructure);
+    crystalStructures->setValue(1, Ebsd::CrystalStructure::UnknownCrystalStructure);
+    crystalStructures->setValue(2, Ebsd::CrystalStructure::Cubic_High);
+    crystalStructures->setValue(3, Ebsd::CrystalStructure::Cubic_High);
+
+    DataContainer::Pointer faceDC = DataContainer::New(SIMPL::Defaults::TriangleDataContainerName);
+    dca->addOrReplaceDataContainer(faceDC);
+    SharedVertexList::Pointer vertex = TriangleGeom::CreateSharedVertexList(3);
+    TriangleGeom::Pointer triangle = TriangleGeom::CreateGeometry(numFaces, vertex, SIMPL::Geometry::TriangleGeometry);
+    faceDC->setGeometry(triangle);
+    std::fill(triangle->getVertexPointer(0), triangle->getVertexPointer(0) + 9, 0.0f);
+    int64_t* tris = triangle->getTriPointer(0);
+    for(size_t t = 0; t < numFaces; t++)
+    {
+      tris[3 * t + 0] = 0;
+      tris[3 * t + 1] = 1;
+      tris[3 * t + 2] = 2;
+    }
+
+    tDims[0] = numFaces;
+    AttributeMatrix::Pointer faceAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::FaceAttributeMatrixName, AttributeMatrix::Type::Face);
+    faceDC->addOrReplaceAttributeMatrix(faceAttrMat);
+    cDims[0] = 2;
+    Int32ArrayType::Pointer faceLabels = Int32ArrayType::CreateArray(numFaces, cDims, SIMPL::FaceData::SurfaceMeshFaceLabels);
+    faceAttrMat->insertOrAssign(faceLabels);
+    cDims[0] = 3;
+    DoubleArrayType::Pointer faceNormals = DoubleArrayType::CreateArray(numFaces, cDims, SIMPL::FaceData::SurfaceMeshFaceNormals);
+    faceAttrMat->insertOrAssign(faceNormals);
+    cDims[0] = 1;
+    DoubleArrayType::Pointer faceAreas = DoubleArrayType::CreateArray(numFaces, cDims, SIMPL::FaceData::SurfaceMeshFaceAreas);
+    faceAttrMat->insertOrAssign(faceAreas);
+    for(size_t t = 0; t < numFaces; t++)
+    {
+      faceLabels->setComponent(t, 0, static_cast<int32_t>(generator() % (k_NumFeatures + 1)) - 1);
+      faceLabels->setComponent(t, 1, static_cast<int32_t>(generator() % (k_NumFeatures + 1)) - 1);
+      double normal[3] = {0.0, 0.0, 0.0};
+      double length = 0.0;
+      do
+      {
+        normal[0] = 2.0 * uniform(generator) - 1.0;
+        normal[1] = 2.0 * uniform(generator) - 1.0;
+        normal[2] = 2.0 * uniform(generator) - 1.0;
+        length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+      } while(length > 1.0 || length < 0.1);
+      for(int32_t c = 0; c < 3; c++)
+      {
+        faceNormals->setComponent(t, c, normal[c] / length);
+      }
+      faceAreas->setValue(t, 0.1 + uniform(generator));
+    }
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The bin layout of FindGBCD::sizeGBCD
+  // -----------------------------------------------------------------------------
+  GBCDSpace referenceSpace(float gbcdRes)
+  {
+    GBCDSpace space;
+    space.limits[0] = 0.0f;
+    space.limits[1] = 0.0f;
+    space.limits[2] = 0.0f;
+    space.limits[3] = 0.0f;
+    space.limits[4] = 0.0f;
+    space.limits[5] = SIMPLib::Constants::k_PiOver2;
+    space.limits[6] = 1.0f;
+    space.limits[7] = SIMPLib::Constants::k_PiOver2;
+    space.limits[8] = 1.0f;
+    space.limits[9] = SIMPLib::Constants::k_2Pi;
+
+    float binsize = gbcdRes * SIMPLib::Constants::k_PiOver180;
+    float binsize2 = binsize * (2.0 / SIMPLib::Constants::k_Pi);
+    space.deltas[0] = binsize;
+    space.deltas[1] = binsize2;
+    space.deltas[2] = binsize;
+    space.deltas[3] = binsize2;
+    space.deltas[4] = binsize;
+    for(int32_t i = 0; i < 5; i++)
+    {
+      space.sizes[i] = int32_t(0.5 + (space.limits[i + 5] - space.limits[i]) / space.deltas[i]);
+    }
+
+    float totalNormalBins = space.sizes[3] * space.sizes[4];
+    space.sizes[3] = int32_t(sqrtf(totalNormalBins) + 0.5f);
+    space.sizes[4] = int32_t(sqrtf(totalNormalBins) + 0.5f);
+    space.limits[3] = -sqrtf(SIMPLib::Constants::k_PiOver2);
+    space.limits[4] = -sqrtf(SIMPLib::Constants::k_PiOver2);
+    space.limits[8] = sqrtf(SIMPLib::Constants::k_PiOver2);
+    space.limits[9] = sqrtf(SIMPLib::Constants::k_PiOver2);
+    space.deltas[3] = (space.limits[8] - space.limits[3]) / float(space.sizes[3]);
+    space.deltas[4] = (space.limits[9] - space.limits[4]) / float(space.sizes[4]);
+
+    space.totalBins = static_cast<size_t>(space.sizes[0]) * space.sizes[1] * space.sizes[2] * space.sizes[3] * space.sizes[4] * 2;
+    return space;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The baseline bin of a misorientation and square grid normal, or -1 outside of the GBCD space
+  // -----------------------------------------------------------------------------
+  int32_t referenceIndex(const GBCDSpace& space, const float* eulerN, const float* sqCoord)
+  {
+    float point[5] = {eulerN[0], eulerN[1], eulerN[2], sqCoord[0], sqCoord[1]};
+    for(int32_t i = 0; i < 5; i++)
+    {
+      if(point[i] < space.limits[i] || point[i] > space.limits[i + 5])
+      {
+        return -1;
+      }
+    }
+    int32_t index[5] = {0, 0, 0, 0, 0};
+    for(int32_t i = 0; i < 5; i++)
+    {
+      index[i] = (int32_t)((point[i] - space.limits[i]) / space.deltas[i]);
+      index[i] = std::max(0, std::min(index[i], space.sizes[i] - 1));
+    }
+    int32_t n1 = space.sizes[0];
+    int32_t n1n2 = n1 * space.sizes[1];
+    int32_t n1n2n3 = n1n2 * space.sizes[2];
+    int32_t n1n2n3n4 = n1n2n3 * space.sizes[3];
+    return index[0] + n1 * index[1] + n1n2 * index[2] + n1n2n3 * index[3] + n1n2n3n4 * index[4];
+  }
+
+  // -----------------------------------------------------------------------------
+  // The baseline square grid coordinates of a normal; returns true in the northern hemisphere
+  // -----------------------------------------------------------------------------
+  bool referenceSquareCoord(const float* xstl1_norm1, float* sqCoord)
+  {
+    bool nhCheck = false;
+    float adjust = 1.0;
+    if(xstl1_norm1[2] >= 0.0)
+    {
+      adjust = -1.0;
+      nhCheck = true;
+    }
+    if(fabsf(xstl1_norm1[0]) >= fabsf(xstl1_norm1[1]))
+    {
+      sqCoord[0] = (xstl1_norm1[0] / fabsf(xstl1_norm1[0])) * sqrtf(2.0f * 1.0f * (1.0f + (xstl1_norm1[2] * adjust))) * (SIMPLib::Constants::k_SqrtPi / 2.0f);
+      sqCoord[1] =
+          (xstl1_norm1[0] / fabsf(xstl1_norm1[0])) * sqrtf(2.0f * 1.0f * (1.0f + (xstl1_norm1[2] * adjust))) * ((2.0f / SIMPLib::Constants::k_SqrtPi) * atanf(xstl1_norm1[1] / xstl1_norm1[0]));
+    }
+    else
+    {
+      sqCoord[0] = (xstl1_norm1[1] / fabsf(xstl1_norm1[1])) * sqrtf(2.0 * 1.0 * (1.0 + (xstl1_norm1[2] * adjust))) * ((2.0f / SIMPLib::Constants::k_SqrtPi) * atanf(xstl1_norm1[0] / xstl1_norm1[1]));
+      sqCoord[1] = (xstl1_norm1[1] / fabsf(xstl1_norm1[1])) * sqrtf(2.0 * 1.0 * (1.0 + (xstl1_norm1[2] * adjust))) * (SIMPLib::Constants::k_SqrtPi / 2.0f);
+    }
+    return nhCheck;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The baseline GBCD: every face is binned on its own, serially, for both orderings of its
+  // Features and every pair of symmetry operators, then each phase is normalized to MRD
+  // -----------------------------------------------------------------------------
+  std::vector<double> referenceGBCD(DataContainerArray::Pointer dca, const GBCDSpace& space)
+  {
+    DataContainer::Pointer dc = dca->getDataContainer(SIMPL::Defaults::ImageDataContainerName);
+    AttributeMatrix::Pointer featureAttrMat = dc->getAttributeMatrix(SIMPL::Defaults::CellFeatureAttributeMatrixName);
+    float* eulers = featureAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::FeatureData::EulerAngles)->getPointer(0);
+    int32_t* phases = featureAttrMat->getAttributeArrayAs<Int32ArrayType>(SIMPL::FeatureData::Phases)->getPointer(0);
+    uint32_t* crystalStructures =
+        dc->getAttributeMatrix(SIMPL::Defaults::CellEnsembleAttributeMatrixName)->getAttributeArrayAs<UInt32ArrayType>(SIMPL::EnsembleData::CrystalStructures)->getPointer(0);
+    AttributeMatrix::Pointer faceAttrMat = dca->getDataContainer(SIMPL::Defaults::TriangleDataContainerName)->getAttributeMatrix(SIMPL::Defaults::FaceAttributeMatrixName);
+    Int32ArrayType::Pointer faceLabels = faceAttrMat->getAttributeArrayAs<Int32ArrayType>(SIMPL::FaceData::SurfaceMeshFaceLabels);
+    double* normals = faceAttrMat->getAttributeArrayAs<DoubleArrayType>(SIMPL::FaceData::SurfaceMeshFaceNormals)->getPointer(0);
+    double* areas = faceAttrMat->getAttributeArrayAs<DoubleArrayType>(SIMPL::FaceData::SurfaceMeshFaceAreas)->getPointer(0);
+    size_t numFaces = faceLabels->getNumberOfTuples();
+
+    QVector<LaueOps::Pointer> ops = LaueOps::getOrientationOpsQVector();
+    std::vector<double> gbcd(k_NumPhases * space.totalBins, 0.0);
+    std::vector<double> totalFaceArea(k_NumPhases, 0.0);
+    for(size_t i = 0; i < numFaces; i++)
+    {
+      int32_t feature1 = faceLabels->getComponent(i, 0);
+      int32_t feature2 = faceLabels->getComponent(i, 1);
+      if(feature1 < 0 || feature2 < 0 || phases[feature1] != phases[feature2] || phases[feature1] <= 0)
+      {
+        continue;
+      }
+      int32_t phase = phases[feature1];
+      // The baseline read past the Laue classes for an unknown crystal structure; such faces are skipped
+      if(crystalStructures[phase] >= static_cast<uint32_t>(ops.size()))
+      {
+        continue;
+      }
+      LaueOps::Pointer op = ops[crystalStructures[phase]];
+      int32_t numSym = op->getNumSymOps();
+      float normal[3] = {static_cast<float>(normals[3 * i]), static_cast<float>(normals[3 * i + 1]), static_cast<float>(normals[3 * i + 2])};
+      for(int32_t q = 0; q < 2; q++)
+      {
+        if(q == 1)
+        {
+          std::swap(feature1, feature2);
+          normal[0] = -normal[0];
+          normal[1] = -normal[1];
+          normal[2] = -normal[2];
+        }
+        float g1[3][3] = {{0.0f}};
+        float g2[3][3] = {{0.0f}};
+        FOrientArrayType om(9, 0.0f);
+        FOrientTransformsType::eu2om(FOrientArrayType(eulers + 3 * feature1, 3), om);
+        om.toGMatrix(g1);
+        FOrientTransformsType::eu2om(FOrientArrayType(eulers + 3 * feature2, 3), om);
+        om.toGMatrix(g2);
+        for(int32_t j = 0; j < numSym; j++)
+        {
+          float sym1[3][3] = {{0.0f}};
+          float g1s[3][3] = {{0.0f}};
+          float xstl1_norm1[3] = {0.0f, 0.0f, 0.0f};
+          float sqCoord[2] = {0.0f, 0.0f};
+          op->getMatSymOp(j, sym1);
+          MatrixMath::Multiply3x3with3x3(sym1, g1, g1s);
+          MatrixMath::Multiply3x3with3x1(g1s, normal, xstl1_norm1);
+          bool nhCheck = referenceSquareCoord(xstl1_norm1, sqCoord);
+          float sqCoordInv[2] = {-sqCoord[0], -sqCoord[1]};
+          for(int32_t k = 0; k < numSym; k++)
+          {
+            float sym2[3][3] = {{0.0f}};
+            float g2s[3][3] = {{0.0f}};
+            float g2t[3][3] = {{0.0f}};
+            float dg[3][3] = {{0.0f}};
+            float euler_mis[3] = {0.0f, 0.0f, 0.0f};
+            op->getMatSymOp(k, sym2);
+            MatrixMath::Multiply3x3with3x3(sym2, g2, g2s);
+            MatrixMath::Transpose3x3(g2s, g2t);
+            MatrixMath::Multiply3x3with3x3(g1s, g2t, dg);
+            FOrientArrayType om2(dg);
+            FOrientArrayType eu(euler_mis, 3);
+            FOrientTransformsType::om2eu(om2, eu);
+            if(euler_mis[0] < SIMPLib::Constants::k_PiOver2 && euler_mis[1] < SIMPLib::Constants::k_PiOver2 && euler_mis[2] < SIMPLib::Constants::k_PiOver2)
+            {
+              euler_mis[1] = cosf(euler_mis[1]);
+              int32_t bin = referenceIndex(space, euler_mis, sqCoord);
+              if(bin != -1)
+              {
+                gbcd[phase * space.totalBins + 2 * bin + (nhCheck ? 0 : 1)] += areas[i];
+                totalFaceArea[phase] += areas[i];
+              }
+              bin = referenceIndex(space, euler_mis, sqCoordInv);
+              if(bin != -1)
+              {
+                gbcd[phase * space.totalBins + 2 * bin + (nhCheck ? 1 : 0)] += areas[i];
+                totalFaceArea[phase] += areas[i];
+              }
+            }
+          }
+        }
+      }
+    }
+
+    for(size_t p = 0; p < k_NumPhases; p++)
+    {
+      double MRDfactor = double(space.totalBins) / totalFaceArea[p];
+      for(size_t b = 0; b < space.totalBins; b++)
+      {
+        gbcd[p * space.totalBins + b] *= MRDfactor;
+      }
+    }
+    return gbcd;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  DoubleArrayType::Pointer runFindGBCD(DataContainerArray::Pointer dca, float gbcdRes)
+  {
+    FilterManager* fm = FilterManager::Instance();
+    AbstractFilter::Pointer filter = fm->getFactoryFromClassName("FindGBCD")->create();
+    filter->setDataContainerArray(dca);
+
+    QVariant var;
+    bool propWasSet = filter->setProperty("GBCDRes", gbcdRes);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(DataArrayPath(SIMPL::Defaults::TriangleDataContainerName, SIMPL::Defaults::FaceAttributeMatrixName, SIMPL::FaceData::SurfaceMeshFaceLabels));
+    propWasSet = filter->setProperty("SurfaceMeshFaceLabelsArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(DataArrayPath(SIMPL::Defaults::TriangleDataContainerName, SIMPL::Defaults::FaceAttributeMatrixName, SIMPL::FaceData::SurfaceMeshFaceNormals));
+    propWasSet = filter->setProperty("SurfaceMeshFaceNormalsArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(DataArrayPath(SIMPL::Defaults::TriangleDataContainerName, SIMPL::Defaults::FaceAttributeMatrixName, SIMPL::FaceData::SurfaceMeshFaceAreas));
+    propWasSet = filter->setProperty("SurfaceMeshFaceAreasArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::EulerAngles));
+    propWasSet = filter->setProperty("FeatureEulerAnglesArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::Phases));
+    propWasSet = filter->setProperty("FeaturePhasesArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellEnsembleAttributeMatrixName, SIMPL::EnsembleData::CrystalStructures));
+    propWasSet = filter->setProperty("CrystalStructuresArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    propWasSet = filter->setProperty("FaceEnsembleAttributeMatrixName", SIMPL::Defaults::FaceEnsembleAttributeMatrixName);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    propWasSet = filter->setProperty("GBCDArrayName", SIMPL::EnsembleData::GBCD);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+
+    return dca->getDataContainer(SIMPL::Defaults::TriangleDataContainerName)
+        ->getAttributeMatrix(SIMPL::Defaults::FaceEnsembleAttributeMatrixName)
+        ->getAttributeArrayAs<DoubleArrayType>(SIMPL::EnsembleData::GBCD);
+  }
+
+  // -----------------------------------------------------------------------------
+  // The GBCD must match the serial per face baseline, and must not depend on the number of
+  // threads. Enough faces are used to span more than one chunk of faces.
+  // -----------------------------------------------------------------------------
+  int TestMatchesBaseline(size_t numFaces, float gbcdRes)
+  {
+    GBCDSpace space = referenceSpace(gbcdRes);
+    DataContainerArray::Pointer dca = createDataContainerArray(numFaces);
+    std::vector<double> expected = referenceGBCD(dca, space);
+
+    DoubleArrayType::Pointer gbcd = runFindGBCD(dca, gbcdRes);
+    DREAM3D_REQUIRE_VALID_POINTER(gbcd.get())
+    DREAM3D_REQUIRE_EQUAL(gbcd->getNumberOfTuples(), k_NumPhases)
+    DREAM3D_REQUIRE_EQUAL(gbcd->getNumberOfComponents(), static_cast<int32_t>(space.totalBins))
+
+    // Phase 0 is never binned, phase 1 is of an unknown crystal structure and phase 3 has no
+    // faces, so all three normalize to NaN
+    size_t numNonZero = 0;
+    for(size_t p = 1; p < k_NumPhases; p++)
+    {
+      for(size_t b = 0; b < space.totalBins; b++)
+      {
+        double value = gbcd->getValue(p * space.totalBins + b);
+        double reference = expected[p * space.totalBins + b];
+        if(std::isnan(reference))
+        {
+          DREAM3D_REQUIRE(std::isnan(value))
+          continue;
+        }
+        DREAM3D_REQUIRE(std::fabs(value - reference) <= k_RelativeTolerance * (1.0 + std::fabs(reference)))
+        if(reference > 0.0)
+        {
+          numNonZero++;
+        }
+      }
+    }
+    DREAM3D_REQUIRE(numNonZero > 0)
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    // The faces are split into a fixed number of slabs, so the sums are carried out in the same
+    // order whatever the number of threads, and the result is bit for bit the same
+    for(int32_t numThreads : {1, 3})
+    {
+      tbb::task_scheduler_init init(numThreads);
+      DataContainerArray::Pointer threadedDca = createDataContainerArray(numFaces);
+      DoubleArrayType::Pointer threadedGBCD = runFindGBCD(threadedDca, gbcdRes);
+      DREAM3D_REQUIRE_VALID_POINTER(threadedGBCD.get())
+      for(size_t b = space.totalBins; b < gbcd->getSize(); b++)
+      {
+        double value = gbcd->getValue(b);
+        double threadedValue = threadedGBCD->getValue(b);
+        DREAM3D_REQUIRE((std::isnan(value) && std::isnan(threadedValue)) || value == threadedValue)
+      }
+    }
+#endif
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "---- " << getNameOfClass().toStdString() << " ----" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestMatchesBaseline(2000, 15.0f))
+    DREAM3D_REGISTER_TEST(TestMatchesBaseline(60000, 9.0f))
+  }
+};
@@ -0,0 +1,205 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include <QtCore/QCoreApplication>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Utilities/ColorTable.h"
+#include "UnitTestSupport.hpp"
+
+#include "EbsdLib/EbsdConstants.h"
+
+#include "OrientationLib/LaueOps/LaueOps.h"
+
+#include "Plugins/OrientationAnalysis/OrientationAnalysisFilters/util/IPFColorLookupTable.h"
+
+#include "OrientationAnalysisTestFileLocations.h"
+
+class IPFColorLookupTest
+{
+public:
+  IPFColorLookupTest() = default;
+  ~IPFColorLookupTest() = default;
+
+  SIMPL_TYPE_MACRO(IPFColorLookupTest)
+  IPFColorLookupTest(const IPFColorLookupTest&) = delete;            // Copy Constructor Not Implemented
+  IPFColorLookupTest(IPFColorLookupTest&&) = delete;                 // Move Constructor Not Implemented
+  IPFColorLookupTest& operator=(const IPFColorLookupTest&) = delete; // Copy Assignment Not Implemented
+  IPFColorLookupTest& operator=(IPFColorLookupTest&&) = delete;      // Move Assignment Not Implemented
+
+  const size_t k_NumOrientations = 100000;
+
+  // A channel is counted as far off when it differs from the exact value by more than this
+  const int k_FarOffDifference = 20;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the filters from the FilterManager
+    QStringList filtNames = {"GenerateIPFColors", "GenerateFaceIPFColoring"};
+    FilterManager* fm = FilterManager::Instance();
+    for(const QString& filtName : filtNames)
+    {
+      IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+      if(nullptr == filterFactory.get())
+      {
+        std::stringstream ss;
+        ss << "The IPFColorLookupTest Requires the use of the " << filtName.toStdString() << " filter which is found in the OrientationAnalysis Plugin";
+        DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+      }
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Fraction of the channels allowed to be far off for a Laue class. Most far off channels belong to
+  // directions within the angular error of an edge of the standard triangle across which the exact
+  // color jumps, which only the 6/m, m-3, 4/m and -3 classes have (about 0.1% of the channels). The
+  // other classes are only far off where generateIPFColor itself misses the standard triangle, for
+  // directions within rounding of one of its edges.
+  // -----------------------------------------------------------------------------
+  double maxFarOffFraction(uint32_t crystalStructure)
+  {
+    switch(crystalStructure)
+    {
+    case Ebsd::CrystalStructure::Hexagonal_Low:
+    case Ebsd::CrystalStructure::Cubic_Low:
+    case Ebsd::CrystalStructure::Tetragonal_Low:
+    case Ebsd::CrystalStructure::Trigonal_Low:
+      return 5.0e-3;
+    default:
+      return 1.0e-4;
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // Colors random orientations seen along random sample directions with the table of every Laue
+  // class and compares them with the exact colors of LaueOps::generateIPFColor
+  // -----------------------------------------------------------------------------
+  int TestLookupAgainstExactColors()
+  {
+    QVector<LaueOps::Pointer> ops = LaueOps::getOrientationOpsQVector();
+    for(uint32_t crystalStructure = 0; crystalStructure < Ebsd::CrystalStructure::LaueGroupEnd; crystalStructure++)
+    {
+      IPFColorLookupTable table(crystalStructure);
+      DREAM3D_REQUIRED(table.getMaxAngularError(), <, 0.003f)
+
+      std::mt19937_64 generator(crystalStructure + 1);
+      std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+      const float twoPi = static_cast<float>(SIMPLib::Constants::k_2Pi);
+      double sumDifference = 0.0;
+      size_t numFarOff = 0;
+      for(size_t i = 0; i < k_NumOrientations; i++)
+      {
+        float eulers[3] = {distribution(generator) * twoPi, std::acos(2.0f * distribution(generator) - 1.0f), distribution(generator) * twoPi};
+        float refDir[3] = {2.0f * distribution(generator) - 1.0f, 2.0f * distribution(generator) - 1.0f, 2.0f * distribution(generator) - 1.0f};
+
+        uint8_t rgb[3] = {0, 0, 0};
+        table.getColor(eulers, refDir, rgb);
+        SIMPL::Rgb argb = ops[crystalStructure]->generateIPFColor(eulers[0], eulers[1], eulers[2], refDir[0], refDir[1], refDir[2], false);
+        int exact[3] = {RgbColor::dRed(argb), RgbColor::dGreen(argb), RgbColor::dBlue(argb)};
+        for(int c = 0; c < 3; c++)
+        {
+          int difference = std::abs(static_cast<int>(rgb[c]) - exact[c]);
+          sumDifference += difference;
+          numFarOff += (difference > k_FarOffDifference) ? 1 : 0;
+        }
+      }
+
+      double numChannels = 3.0 * static_cast<double>(k_NumOrientations);
+      DREAM3D_REQUIRED(sumDifference / numChannels, <, 1.0)
+      DREAM3D_REQUIRED(static_cast<double>(numFarOff) / numChannels, <=, maxFarOffFraction(crystalStructure))
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // A direction and its opposite share their color, the null direction is black
+  // -----------------------------------------------------------------------------
+  int TestCrystalDirectionColors()
+  {
+    IPFColorLookupTable table(Ebsd::CrystalStructure::Hexagonal_Low);
+    std::mt19937_64 generator(0);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    for(size_t i = 0; i < 1000; i++)
+    {
+      float dir[3] = {distribution(generator), distribution(generator), distribution(generator)};
+      float opposite[3] = {-dir[0], -dir[1], -dir[2]};
+      uint8_t rgb[3] = {0, 0, 0};
+      uint8_t oppositeRgb[3] = {0, 0, 0};
+      table.getCrystalDirectionColor(dir, rgb);
+      table.getCrystalDirectionColor(opposite, oppositeRgb);
+      if(dir[2] != 0.0f)
+      {
+        DREAM3D_REQUIRE(std::equal(rgb, rgb + 3, oppositeRgb))
+      }
+    }
+
+    float zero[3] = {0.0f, 0.0f, 0.0f};
+    uint8_t rgb[3] = {1, 1, 1};
+    table.getCrystalDirectionColor(zero, rgb);
+    DREAM3D_REQUIRE(rgb[0] == 0 && rgb[1] == 0 && rgb[2] == 0)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "---- " << getNameOfClass().toStdString() << " ----" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestLookupAgainstExactColors())
+    DREAM3D_REGISTER_TEST(TestCrystalDirectionColors())
+  }
+};
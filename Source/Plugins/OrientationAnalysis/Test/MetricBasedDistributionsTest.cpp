@@ -0,0 +1,767 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+#include <QtCore/QTextStream>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/FilterParameters/AxisAngleInput.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+#include "SIMPLib/Math/MatrixMath.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "EbsdLib/EbsdConstants.h"
+
+#include "OrientationLib/LaueOps/LaueOps.h"
+#include "OrientationLib/OrientationMath/OrientationArray.hpp"
+#include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+
+#include "OrientationAnalysisTestFileLocations.h"
+
+class MetricBasedDistributionsTest
+{
+public:
+  MetricBasedDistributionsTest() = default;
+  ~MetricBasedDistributionsTest() = default;
+
+  SIMPL_TYPE_MACRO(MetricBasedDistributionsTest)
+  MetricBasedDistributionsTest(const MetricBasedDistributionsTest&) = delete;            // Copy Constructor Not Implemented
+  MetricBasedDistributionsTest(MetricBasedDistributionsTest&&) = delete;                 // Move Constructor Not Implemented
+  MetricBasedDistributionsTest& operator=(const MetricBasedDistributionsTest&) = delete; // Copy Assignment Not Implemented
+  MetricBasedDistributionsTest& operator=(MetricBasedDistributionsTest&&) = delete;      // Move Assignment Not Implemented
+
+  /**
+   * @brief The SelectedTri struct holds the area of a selected triangle and its two normals
+   */
+  struct SelectedTri
+  {
+    double area;
+    float normal1[3];
+    float normal2[3];
+  };
+
+  const size_t k_NumFeatures = 42;
+  const size_t k_NumFaces = 10000;
+  const int32_t k_NumSamplPts = 2000;
+
+  // Sigma 3 misorientation, with the 5 degree misorientation and 7 degree plane resolutions
+  // (the third resolution choice of FindGBCDMetricBased) and its cubic ball volume
+  const float k_MisorientationAngle = 60.0f;
+  const int32_t k_ChosenLimitDists = 2;
+  const float k_MisorResol = 5.0f;
+  const float k_PlaneResol = 7.0f;
+  const double k_BallVolume = 0.000287439;
+
+  const float k_LimitDist = 7.0f;
+
+  // The distribution values are written with 4 decimals
+  const double k_Tolerance = 1.0e-4;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+    QFile::remove(UnitTest::MetricBasedDistributionsTest::GBCDDistFile);
+    QFile::remove(UnitTest::MetricBasedDistributionsTest::GBCDErrFile);
+    QFile::remove(UnitTest::MetricBasedDistributionsTest::GBPDDistFile);
+    QFile::remove(UnitTest::MetricBasedDistributionsTest::GBPDErrFile);
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the filters from the FilterManager
+    QStringList filtNames = {"FindGBCDMetricBased", "FindGBPDMetricBased"};
+    FilterManager* fm = FilterManager::Instance();
+    for(const QString& filtName : filtNames)
+    {
+      IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+      if(nullptr == filterFactory.get())
+      {
+        std::stringstream ss;
+        ss << "The MetricBasedDistributionsTest Requires the use of the " << filtName.toStdString() << " filter which is found in the OrientationAnalysis Plugin";
+        DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+      }
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void fixedMisorientation(float gFixed[3][3])
+  {
+    float angle = static_cast<float>(k_MisorientationAngle * SIMPLib::Constants::k_PiOver180);
+    float axis[3] = {1.0f, 1.0f, 1.0f};
+    MatrixMath::Normalize3x1(axis);
+    FOrientArrayType om(9);
+    FOrientTransformsType::ax2om(FOrientArrayType(axis[0], axis[1], axis[2], angle), om);
+    om.toGMatrix(gFixed);
+  }
+
+  // -----------------------------------------------------------------------------
+  // Features 1 and 2, 3 and 4, ... are close to the fixed misorientation from each other, up to a
+  // random rotation of at most 6 degrees, so some of their faces are inside the misorientation
+  // resolution and some are not. Phase 1 is cubic; the last Feature is hexagonal. Faces join
+  // random pairs of Features, partners more often than not, and a few touch the outside.
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createDataContainerArray()
+  {
+    std::mt19937 generator(17);
+    std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+
+    QVector<size_t> tDims(1, k_NumFeatures);
+    AttributeMatrix::Pointer featureAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellFeatureAttributeMatrixName, AttributeMatrix::Type::CellFeature);
+    dc->addOrReplaceAttributeMatrix(featureAttrMat);
+    QVector<size_t> cDims(1, 1);
+    Int32ArrayType::Pointer featurePhases = Int32ArrayType::CreateArray(k_NumFeatures, cDims, SIMPL::FeatureData::Phases);
+    featureAttrMat->insertOrAssign(featurePhases);
+    cDims[0] = 3;
+    FloatArrayType::Pointer eulers = FloatArrayType::CreateArray(k_NumFeatures, cDims, SIMPL::FeatureData::AvgEulerAngles);
+    featureAttrMat->insertOrAssign(eulers);
+
+    tDims[0] = 3;
+    AttributeMatrix::Pointer ensembleAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellEnsembleAttributeMatrixName, AttributeMatrix::Type::CellEnsemble);
+    dc->addOrReplaceAttributeMatrix(ensembleAttrMat);
+    cDims[0] = 1;
+    UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(3, cDims, SIMPL::EnsembleData::CrystalStructures);
+    ensembleAttrMat->insertOrAssign(crystalStructures);
+    crystalStructures->setValue(0, Ebsd::CrystalStructure::UnknownCrystalStructure);
+    crystalStructures->setValue(1, Ebsd::CrystalStructure::Cubic_High);
+    crystalStructures->setValue(2, Ebsd::CrystalStructure::Hexagonal_High);
+
+    float gFixed[3][3] = {{0.0f}};
+    fixedMisorientation(gFixed);
+    float gFixedT[3][3] = {{0.0f}};
+    MatrixMath::Transpose3x3(gFixed, gFixedT);
+
+    featurePhases->setValue(0, 0);
+    eulers->initializeWithZeros();
+    for(size_t f = 1; f < k_NumFeatures; f += 2)
+    {
+      float g1[3][3] = {{0.0f}};
+      float* ea1 = eulers->getTuplePointer(f);
+      ea1[0] = uniform(generator) * SIMPLib::Constants::k_2Pi;
+      ea1[1] = std::acos(2.0f * uniform(generator) - 1.0f);
+      ea1[2] = uniform(generator) * SIMPLib::Constants::k_2Pi;
+      FOrientArrayType om(9, 0.0f);
+      FOrientTransformsType::eu2om(FOrientArrayType(ea1, 3), om);
+      om.toGMatrix(g1);
+      featurePhases->setValue(f, 1);
+      if(f + 1 >= k_NumFeatures)
+      {
+        featurePhases->setValue(f, 2);
+        break;
+      }
+
+      // g2 = dR * gFixed^T * g1, so that g1 * g2^T is gFixed up to the small rotation dR
+      float axis[3] = {uniform(generator) - 0.5f, uniform(generator) - 0.5f, uniform(generator) - 0.5f};
+      MatrixMath::Normalize3x1(axis);
+      float angle = uniform(generator) * 6.0f * SIMPLib::Constants::k_PiOver180;
+      float dR[3][3] = {{0.0f}};
+      FOrientArrayType omR(9);
+      FOrientTransformsType::ax2om(FOrientArrayType(axis[0], axis[1], axis[2], angle), omR);
+      omR.toGMatrix(dR);
+      float temp[3][3] = {{0.0f}};
+      float g2[3][3] = {{0.0f}};
+      MatrixMath::Multiply3x3with3x3(gFixedT, g1, temp);
+      MatrixMath::Multiply3x3with3x3(dR, temp, g2);
+      FOrientArrayType om2(g2);
+      FOrientArrayType ea2(eulers->getTuplePointer(f + 1), 3);
+      FOrientTransformsType::om2eu(om2, ea2);
+      featurePhases->setValue(f + 1, 1);
+    }
+
+    DataContainer::Pointer faceDC = DataContainer::New(SIMPL::Defaults::TriangleDataContainerName);
+    dca->addOrReplaceDataContainer(faceDC);
+    SharedVertexList::Pointer vertex = TriangleGeom::CreateSharedVertexList(3);
+    TriangleGeom::Pointer triangle = TriangleGeom::CreateGeometry(k_NumFaces, vertex, SIMPL::Geometry::TriangleGeometry);
+    faceDC->setGeometry(triangle);
+    std::fill(triangle->getVertexPointer(0), triangle->getVertexPointer(0) + 9, 0.0f);
+    int64_t* tris = triangle->getTriPointer(0);
+    for(size_t t = 0; t < k_NumFaces; t++)
+    {
+      tris[3 * t + 0] = 0;
+      tris[3 * t + 1] = 1;
+      tris[3 * t + 2] = 2;
+    }
+
+    tDims[0] = 3;
+    AttributeMatrix::Pointer vertexAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::VertexAttributeMatrixName, AttributeMatrix::Type::Vertex);
+    faceDC->addOrReplaceAttributeMatrix(vertexAttrMat);
+    cDims[0] = 1;
+    Int8ArrayType::Pointer nodeTypes = Int8ArrayType::CreateArray(3, cDims, SIMPL::VertexData::SurfaceMeshNodeType);
+    nodeTypes->initializeWithValue(2);
+    vertexAttrMat->insertOrAssign(nodeTypes);
+
+    tDims[0] = k_NumFaces;
+    AttributeMatrix::Pointer faceAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::FaceAttributeMatrixName, AttributeMatrix::Type::Face);
+    faceDC->addOrReplaceAttributeMatrix(faceAttrMat);
+    cDims[0] = 2;
+    Int32ArrayType::Pointer faceLabels = Int32ArrayType::CreateArray(k_NumFaces, cDims, SIMPL::FaceData::SurfaceMeshFaceLabels);
+    faceAttrMat->insertOrAssign(faceLabels);
+    cDims[0] = 3;
+    DoubleArrayType::Pointer faceNormals = DoubleArrayType::CreateArray(k_NumFaces, cDims, SIMPL::FaceData::SurfaceMeshFaceNormals);
+    faceAttrMat->insertOrAssign(faceNormals);
+    cDims[0] = 1;
+    DoubleArrayType::Pointer faceAreas = DoubleArrayType::CreateArray(k_NumFaces, cDims, SIMPL::FaceData::SurfaceMeshFaceAreas);
+    faceAttrMat->insertOrAssign(faceAreas);
+    for(size_t t = 0; t < k_NumFaces; t++)
+    {
+      int32_t label0 = static_cast<int32_t>(generator() % (k_NumFeatures + 1)) - 1;
+      int32_t label1 = static_cast<int32_t>(generator() % (k_NumFeatures + 1)) - 1;
+      if(generator() % 3 != 0 && label0 > 0)
+      {
+        label1 = (label0 % 2 == 1) ? label0 + 1 : label0 - 1;
+        label1 = std::min(label1, static_cast<int32_t>(k_NumFeatures) - 1);
+      }
+      faceLabels->setComponent(t, 0, label0);
+      faceLabels->setComponent(t, 1, label1);
+      double normal[3] = {0.0, 0.0, 0.0};
+      double length = 0.0;
+      do
+      {
+        normal[0] = 2.0 * uniform(generator) - 1.0;
+        normal[1] = 2.0 * uniform(generator) - 1.0;
+        normal[2] = 2.0 * uniform(generator) - 1.0;
+        length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+      } while(length > 1.0 || length < 0.1);
+      for(int32_t c = 0; c < 3; c++)
+      {
+        faceNormals->setComponent(t, c, normal[c] / length);
+      }
+      faceAreas->setValue(t, 0.1 + uniform(generator));
+    }
+
+    // Every pair of Features is one distinct boundary
+    size_t numFaceFeatures = (k_NumFeatures * (k_NumFeatures - 1)) / 2;
+    tDims[0] = numFaceFeatures;
+    AttributeMatrix::Pointer faceFeatureAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::FaceFeatureAttributeMatrixName, AttributeMatrix::Type::FaceFeature);
+    faceDC->addOrReplaceAttributeMatrix(faceFeatureAttrMat);
+    cDims[0] = 2;
+    Int32ArrayType::Pointer featureFaceLabels = Int32ArrayType::CreateArray(numFaceFeatures, cDims, "FaceLabels");
+    faceFeatureAttrMat->insertOrAssign(featureFaceLabels);
+    size_t featureFaceIdx = 0;
+    for(size_t f = 0; f < k_NumFeatures; f++)
+    {
+      for(size_t g = f + 1; g < k_NumFeatures; g++)
+      {
+        featureFaceLabels->setComponent(featureFaceIdx, 0, static_cast<int32_t>(f));
+        featureFaceLabels->setComponent(featureFaceIdx, 1, static_cast<int32_t>(g));
+        featureFaceIdx++;
+      }
+    }
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  AbstractFilter::Pointer createFilter(const QString& filtName, DataContainerArray::Pointer dca, const QString& distFile, const QString& errFile)
+  {
+    FilterManager* fm = FilterManager::Instance();
+    AbstractFilter::Pointer filter = fm->getFactoryFromClassName(filtName)->create();
+    filter->setDataContainerArray(dca);
+
+    const QString dcName = SIMPL::Defaults::ImageDataContainerName;
+    const QString featureAMName = SIMPL::Defaults::CellFeatureAttributeMatrixName;
+    const QString faceDCName = SIMPL::Defaults::TriangleDataContainerName;
+    QVariant var;
+    bool propWasSet = filter->setProperty("PhaseOfInterest", 1);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    propWasSet = filter->setProperty("NumSamplPts", k_NumSamplPts);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    propWasSet = filter->setProperty("ExcludeTripleLines", false);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    propWasSet = filter->setProperty("SaveRelativeErr", false);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    propWasSet = filter->setProperty("DistOutputFile", distFile);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    propWasSet = filter->setProperty("ErrOutputFile", errFile);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(DataArrayPath(dcName, SIMPL::Defaults::CellEnsembleAttributeMatrixName, SIMPL::EnsembleData::CrystalStructures));
+    propWasSet = filter->setProperty("CrystalStructuresArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(DataArrayPath(dcName, featureAMName, SIMPL::FeatureData::AvgEulerAngles));
+    propWasSet = filter->setProperty("FeatureEulerAnglesArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(DataArrayPath(dcName, featureAMName, SIMPL::FeatureData::Phases));
+    propWasSet = filter->setProperty("FeaturePhasesArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(DataArrayPath(faceDCName, SIMPL::Defaults::FaceAttributeMatrixName, SIMPL::FaceData::SurfaceMeshFaceLabels));
+    propWasSet = filter->setProperty("SurfaceMeshFaceLabelsArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(DataArrayPath(faceDCName, SIMPL::Defaults::FaceAttributeMatrixName, SIMPL::FaceData::SurfaceMeshFaceNormals));
+    propWasSet = filter->setProperty("SurfaceMeshFaceNormalsArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(DataArrayPath(faceDCName, SIMPL::Defaults::FaceAttributeMatrixName, SIMPL::FaceData::SurfaceMeshFaceAreas));
+    propWasSet = filter->setProperty("SurfaceMeshFaceAreasArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(DataArrayPath(faceDCName, SIMPL::Defaults::FaceFeatureAttributeMatrixName, "FaceLabels"));
+    propWasSet = filter->setProperty("SurfaceMeshFeatureFaceLabelsArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(DataArrayPath(faceDCName, SIMPL::Defaults::VertexAttributeMatrixName, SIMPL::VertexData::SurfaceMeshNodeType));
+    propWasSet = filter->setProperty("NodeTypesArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+    return filter;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Reads the distribution values of a distribution file, skipping the header line
+  // -----------------------------------------------------------------------------
+  std::vector<double> readDistributionValues(const QString& filePath)
+  {
+    std::vector<double> values;
+    QFile file(filePath);
+    if(!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+      return values;
+    }
+    QTextStream in(&file);
+    in.readLine();
+    while(!in.atEnd())
+    {
+      QStringList tokens = in.readLine().split(' ', QString::SkipEmptyParts);
+      if(tokens.size() == 3)
+      {
+        values.push_back(tokens[2].toDouble());
+      }
+    }
+    return values;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void appendSamplPtsFixedZenith(std::vector<float>& pts, double theta, double minPhi, double maxPhi, double step)
+  {
+    for(double phi = minPhi; phi <= maxPhi; phi += step)
+    {
+      pts.push_back(sinf(static_cast<float>(theta)) * cosf(static_cast<float>(phi)));
+      pts.push_back(sinf(static_cast<float>(theta)) * sinf(static_cast<float>(phi)));
+      pts.push_back(cosf(static_cast<float>(theta)));
+    }
+    pts.push_back(sinf(static_cast<float>(theta)) * cosf(static_cast<float>(maxPhi)));
+    pts.push_back(sinf(static_cast<float>(theta)) * sinf(static_cast<float>(maxPhi)));
+    pts.push_back(cosf(static_cast<float>(theta)));
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void appendSamplPtsFixedAzimuth(std::vector<float>& pts, double phi, double minTheta, double maxTheta, double step)
+  {
+    for(double theta = minTheta; theta <= maxTheta; theta += step)
+    {
+      pts.push_back(sinf(static_cast<float>(theta)) * cosf(static_cast<float>(phi)));
+      pts.push_back(sinf(static_cast<float>(theta)) * sinf(static_cast<float>(phi)));
+      pts.push_back(cosf(static_cast<float>(theta)));
+    }
+    pts.push_back(sinf(static_cast<float>(maxTheta)) * cosf(static_cast<float>(phi)));
+    pts.push_back(sinf(static_cast<float>(maxTheta)) * sinf(static_cast<float>(phi)));
+    pts.push_back(cosf(static_cast<float>(maxTheta)));
+  }
+
+  // -----------------------------------------------------------------------------
+  // The orientation matrices of the two Features of a face of the phase of interest
+  // -----------------------------------------------------------------------------
+  bool faceOrientations(DataContainerArray::Pointer dca, size_t triIdx, float g1[3][3], float g2[3][3], float normalLab[3], double& area)
+  {
+    AttributeMatrix::Pointer featureAttrMat = dca->getDataContainer(SIMPL::Defaults::ImageDataContainerName)->getAttributeMatrix(SIMPL::Defaults::CellFeatureAttributeMatrixName);
+    FloatArrayType::Pointer eulers = featureAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::FeatureData::AvgEulerAngles);
+    Int32ArrayType::Pointer phases = featureAttrMat->getAttributeArrayAs<Int32ArrayType>(SIMPL::FeatureData::Phases);
+    AttributeMatrix::Pointer faceAttrMat = dca->getDataContainer(SIMPL::Defaults::TriangleDataContainerName)->getAttributeMatrix(SIMPL::Defaults::FaceAttributeMatrixName);
+    Int32ArrayType::Pointer faceLabels = faceAttrMat->getAttributeArrayAs<Int32ArrayType>(SIMPL::FaceData::SurfaceMeshFaceLabels);
+    DoubleArrayType::Pointer faceNormals = faceAttrMat->getAttributeArrayAs<DoubleArrayType>(SIMPL::FaceData::SurfaceMeshFaceNormals);
+    DoubleArrayType::Pointer faceAreas = faceAttrMat->getAttributeArrayAs<DoubleArrayType>(SIMPL::FaceData::SurfaceMeshFaceAreas);
+
+    int32_t feature1 = faceLabels->getComponent(triIdx, 0);
+    int32_t feature2 = faceLabels->getComponent(triIdx, 1);
+    if(feature1 < 1 || feature2 < 1 || phases->getValue(feature1) != 1 || phases->getValue(feature2) != 1)
+    {
+      return false;
+    }
+    for(int32_t c = 0; c < 3; c++)
+    {
+      normalLab[c] = static_cast<float>(faceNormals->getComponent(triIdx, c));
+    }
+    area = faceAreas->getValue(triIdx);
+    FOrientArrayType om(9, 0.0f);
+    FOrientTransformsType::eu2om(FOrientArrayType(eulers->getTuplePointer(feature1), 3), om);
+    om.toGMatrix(g1);
+    FOrientTransformsType::eu2om(FOrientArrayType(eulers->getTuplePointer(feature2), 3), om);
+    om.toGMatrix(g2);
+    return true;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The baseline GBCD section: the symmetric misorientations are recomputed for every pair of
+  // symmetry operators, and every sampling point tests every selected triangle
+  // -----------------------------------------------------------------------------
+  std::vector<double> referenceGBCD(DataContainerArray::Pointer dca)
+  {
+    QVector<LaueOps::Pointer> ops = LaueOps::getOrientationOpsQVector();
+    LaueOps::Pointer op = ops[Ebsd::CrystalStructure::Cubic_High];
+    int32_t nsym = op->getNumSymOps();
+    float misorResol = k_MisorResol * SIMPLib::Constants::k_PiOver180;
+    float planeResol = k_PlaneResol * SIMPLib::Constants::k_PiOver180;
+    float planeResolSq = planeResol * planeResol;
+
+    std::vector<float> samplPts;
+    int32_t numSamplPts_WholeSph = 2 * k_NumSamplPts;
+    float _inc = 2.3999632f;
+    float _off = 2.0f / float(numSamplPts_WholeSph);
+    for(int32_t ptIdx_WholeSph = 0; ptIdx_WholeSph < numSamplPts_WholeSph; ptIdx_WholeSph++)
+    {
+      float _y = (float(ptIdx_WholeSph) * _off) - 1.0f + (0.5f * _off);
+      float _r = sqrtf(fmaxf(1.0f - _y * _y, 0.0f));
+      float _phi = float(ptIdx_WholeSph) * _inc;
+      float z = sinf(_phi) * _r;
+      if(z > 0.0f)
+      {
+        samplPts.push_back(cosf(_phi) * _r);
+        samplPts.push_back(_y);
+        samplPts.push_back(z);
+      }
+    }
+    for(double phi = 0.0; phi <= SIMPLib::Constants::k_2Pi; phi += planeResol)
+    {
+      samplPts.push_back(cosf(static_cast<float>(phi)));
+      samplPts.push_back(sinf(static_cast<float>(phi)));
+      samplPts.push_back(0.0f);
+    }
+
+    float gFixed[3][3] = {{0.0f}};
+    float gFixedT[3][3] = {{0.0f}};
+    fixedMisorientation(gFixed);
+    MatrixMath::Transpose3x3(gFixed, gFixedT);
+
+    std::vector<SelectedTri> selectedTris;
+    double totalFaceArea = 0.0;
+    for(size_t triIdx = 0; triIdx < k_NumFaces; triIdx++)
+    {
+      float g1[3][3] = {{0.0f}};
+      float g2[3][3] = {{0.0f}};
+      float normalLab[3] = {0.0f, 0.0f, 0.0f};
+      double area = 0.0;
+      if(!faceOrientations(dca, triIdx, g1, g2, normalLab, area))
+      {
+        continue;
+      }
+      totalFaceArea += area;
+      for(int32_t j = 0; j < nsym; j++)
+      {
+        float sym[3][3] = {{0.0f}};
+        float g1s[3][3] = {{0.0f}};
+        float normalGrain1[3] = {0.0f, 0.0f, 0.0f};
+        op->getMatSymOp(j, sym);
+        MatrixMath::Multiply3x3with3x3(sym, g1, g1s);
+        MatrixMath::Multiply3x3with3x1(g1s, normalLab, normalGrain1);
+        for(int32_t k = 0; k < nsym; k++)
+        {
+          float g2s[3][3] = {{0.0f}};
+          float g2sT[3][3] = {{0.0f}};
+          float dg[3][3] = {{0.0f}};
+          float dgT[3][3] = {{0.0f}};
+          op->getMatSymOp(k, sym);
+          MatrixMath::Multiply3x3with3x3(sym, g2, g2s);
+          MatrixMath::Transpose3x3(g2s, g2sT);
+          MatrixMath::Multiply3x3with3x3(g1s, g2sT, dg);
+          MatrixMath::Transpose3x3(dg, dgT);
+          for(int32_t transpose = 0; transpose <= 1; transpose++)
+          {
+            float diffFromFixed[3][3] = {{0.0f}};
+            MatrixMath::Multiply3x3with3x3(transpose == 0 ? dg : dgT, gFixedT, diffFromFixed);
+            float diffAngle = acosf((diffFromFixed[0][0] + diffFromFixed[1][1] + diffFromFixed[2][2] - 1.0f) * 0.5f);
+            if(diffAngle < misorResol)
+            {
+              float normalGrain2[3] = {0.0f, 0.0f, 0.0f};
+              MatrixMath::Multiply3x3with3x1(dgT, normalGrain1, normalGrain2);
+              SelectedTri tri;
+              tri.area = area;
+              for(int32_t c = 0; c < 3; c++)
+              {
+                tri.normal1[c] = (transpose == 0) ? normalGrain1[c] : -normalGrain2[c];
+                tri.normal2[c] = (transpose == 0) ? -normalGrain2[c] : normalGrain1[c];
+              }
+              selectedTris.push_back(tri);
+            }
+          }
+        }
+      }
+    }
+
+    size_t numSamplPts = samplPts.size() / 3;
+    std::vector<double> distribValues(numSamplPts, 0.0);
+    for(size_t ptIdx = 0; ptIdx < numSamplPts; ptIdx++)
+    {
+      float* fixedNormal1 = samplPts.data() + 3 * ptIdx;
+      float fixedNormal2[3] = {0.0f, 0.0f, 0.0f};
+      MatrixMath::Multiply3x3with3x1(gFixedT, fixedNormal1, fixedNormal2);
+      for(const SelectedTri& tri : selectedTris)
+      {
+        for(int32_t inversion = 0; inversion <= 1; inversion++)
+        {
+          float sign = (inversion == 1) ? -1.0f : 1.0f;
+          float theta1 = acosf(sign * (tri.normal1[0] * fixedNormal1[0] + tri.normal1[1] * fixedNormal1[1] + tri.normal1[2] * fixedNormal1[2]));
+          float theta2 = acosf(-sign * (tri.normal2[0] * fixedNormal2[0] + tri.normal2[1] * fixedNormal2[1] + tri.normal2[2] * fixedNormal2[2]));
+          float distSq = 0.5f * (theta1 * theta1 + theta2 * theta2);
+          if(distSq < planeResolSq)
+          {
+            distribValues[ptIdx] += tri.area;
+          }
+        }
+      }
+      distribValues[ptIdx] /= totalFaceArea;
+      distribValues[ptIdx] /= k_BallVolume;
+    }
+    return distribValues;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The baseline GBPD of the cubic phase: every sampling point of the standard stereographic
+  // triangle tests every symmetric equivalent of every selected triangle normal
+  // -----------------------------------------------------------------------------
+  std::vector<double> referenceGBPD(DataContainerArray::Pointer dca)
+  {
+    QVector<LaueOps::Pointer> ops = LaueOps::getOrientationOpsQVector();
+    LaueOps::Pointer op = ops[Ebsd::CrystalStructure::Cubic_High];
+    int32_t nsym = op->getNumSymOps();
+    float limitDist = k_LimitDist * SIMPLib::Constants::k_PiOver180;
+    double ballVolume = double(nsym) * 2.0 * (1.0 - cos(limitDist));
+
+    std::vector<float> samplPts;
+    int32_t numSamplPts_WholeSph = 2 * k_NumSamplPts;
+    float _inc = 2.3999632f;
+    float _off = 2.0f / float(numSamplPts_WholeSph);
+    for(int32_t ptIdx_WholeSph = 0; ptIdx_WholeSph < numSamplPts_WholeSph; ptIdx_WholeSph++)
+    {
+      float _y = (float(ptIdx_WholeSph) * _off) - 1.0f + (0.5f * _off);
+      float _r = sqrtf(fmaxf(1.0f - _y * _y, 0.0f));
+      float _phi = float(ptIdx_WholeSph) * _inc;
+      float x = cosf(_phi) * _r;
+      float y = _y;
+      float z = sinf(_phi) * _r;
+      // m-3m standard stereographic triangle
+      if(z >= 0.0f && y >= 0.0f && x >= y && z >= x)
+      {
+        samplPts.push_back(x);
+        samplPts.push_back(y);
+        samplPts.push_back(z);
+      }
+    }
+    const double deg = SIMPLib::Constants::k_PiOver180;
+    const double density = limitDist;
+    appendSamplPtsFixedAzimuth(samplPts, 0.0, 0.0, 45.0 * deg, density);
+    appendSamplPtsFixedAzimuth(samplPts, 45.0 * deg, 0.0, acos(SIMPLib::Constants::k_1OverRoot3), density);
+    for(double phi = 0; phi <= 45.0f * deg; phi += density)
+    {
+      double atan1OverCosPhi = atan(1.0 / cos(phi));
+      samplPts.push_back(static_cast<float>(sin(atan1OverCosPhi) * cos(phi)));
+      samplPts.push_back(static_cast<float>(sin(atan1OverCosPhi) * sin(phi)));
+      samplPts.push_back(static_cast<float>(cos(atan1OverCosPhi)));
+    }
+
+    std::vector<SelectedTri> selectedTris;
+    double totalFaceArea = 0.0;
+    for(size_t triIdx = 0; triIdx < k_NumFaces; triIdx++)
+    {
+      float g1[3][3] = {{0.0f}};
+      float g2[3][3] = {{0.0f}};
+      float normalLab[3] = {0.0f, 0.0f, 0.0f};
+      double area = 0.0;
+      if(!faceOrientations(dca, triIdx, g1, g2, normalLab, area))
+      {
+        continue;
+      }
+      SelectedTri tri;
+      tri.area = area;
+      MatrixMath::Multiply3x3with3x1(g1, normalLab, tri.normal1);
+      MatrixMath::Multiply3x3with3x1(g2, normalLab, tri.normal2);
+      for(float& component : tri.normal2)
+      {
+        component = -component;
+      }
+      selectedTris.push_back(tri);
+      totalFaceArea += area;
+    }
+
+    size_t numSamplPts = samplPts.size() / 3;
+    std::vector<double> distribValues(numSamplPts, 0.0);
+    for(size_t ptIdx = 0; ptIdx < numSamplPts; ptIdx++)
+    {
+      const float* probeNormal = samplPts.data() + 3 * ptIdx;
+      for(const SelectedTri& tri : selectedTris)
+      {
+        for(int32_t j = 0; j < nsym; j++)
+        {
+          float sym[3][3] = {{0.0f}};
+          float symNormal1[3] = {0.0f, 0.0f, 0.0f};
+          float symNormal2[3] = {0.0f, 0.0f, 0.0f};
+          op->getMatSymOp(j, sym);
+          MatrixMath::Multiply3x3with3x1(sym, tri.normal1, symNormal1);
+          MatrixMath::Multiply3x3with3x1(sym, tri.normal2, symNormal2);
+          for(int32_t inversion = 0; inversion <= 1; inversion++)
+          {
+            float sign = (inversion == 1) ? -1.0f : 1.0f;
+            float gamma1 = acosf(sign * (probeNormal[0] * symNormal1[0] + probeNormal[1] * symNormal1[1] + probeNormal[2] * symNormal1[2]));
+            if(gamma1 < limitDist)
+            {
+              distribValues[ptIdx] += tri.area;
+            }
+            float gamma2 = acosf(sign * (probeNormal[0] * symNormal2[0] + probeNormal[1] * symNormal2[1] + probeNormal[2] * symNormal2[2]));
+            if(gamma2 < limitDist)
+            {
+              distribValues[ptIdx] += tri.area;
+            }
+          }
+        }
+      }
+      distribValues[ptIdx] /= totalFaceArea;
+      distribValues[ptIdx] /= ballVolume;
+    }
+    return distribValues;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The indexed sampling points must select exactly the triangles the baseline's test of every
+  // sampling point against every triangle selected
+  // -----------------------------------------------------------------------------
+  int TestGBCDMetricBased()
+  {
+    DataContainerArray::Pointer dca = createDataContainerArray();
+    AbstractFilter::Pointer filter = createFilter("FindGBCDMetricBased", dca, UnitTest::MetricBasedDistributionsTest::GBCDDistFile, UnitTest::MetricBasedDistributionsTest::GBCDErrFile);
+    AxisAngleInput_t misorientation;
+    misorientation.angle = k_MisorientationAngle;
+    misorientation.h = 1.0f;
+    misorientation.k = 1.0f;
+    misorientation.l = 1.0f;
+    QVariant var;
+    var.setValue(misorientation);
+    bool propWasSet = filter->setProperty("MisorientationRotation", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    propWasSet = filter->setProperty("ChosenLimitDists", k_ChosenLimitDists);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+
+    std::vector<double> expected = referenceGBCD(dca);
+    std::vector<double> values = readDistributionValues(UnitTest::MetricBasedDistributionsTest::GBCDDistFile);
+    DREAM3D_REQUIRE_EQUAL(values.size(), expected.size())
+    size_t numNonZero = 0;
+    for(size_t ptIdx = 0; ptIdx < expected.size(); ptIdx++)
+    {
+      DREAM3D_REQUIRE(std::fabs(values[ptIdx] - expected[ptIdx]) <= k_Tolerance)
+      if(expected[ptIdx] > 0.0)
+      {
+        numNonZero++;
+      }
+    }
+    DREAM3D_REQUIRE(numNonZero > 0)
+    DREAM3D_REQUIRE(numNonZero < expected.size())
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Each sampling point is written once per symmetry operator, with the same value
+  // -----------------------------------------------------------------------------
+  int TestGBPDMetricBased()
+  {
+    DataContainerArray::Pointer dca = createDataContainerArray();
+    AbstractFilter::Pointer filter = createFilter("FindGBPDMetricBased", dca, UnitTest::MetricBasedDistributionsTest::GBPDDistFile, UnitTest::MetricBasedDistributionsTest::GBPDErrFile);
+    bool propWasSet = filter->setProperty("LimitDist", k_LimitDist);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+
+    std::vector<double> expected = referenceGBPD(dca);
+    std::vector<double> values = readDistributionValues(UnitTest::MetricBasedDistributionsTest::GBPDDistFile);
+    size_t nsym = static_cast<size_t>(LaueOps::getOrientationOpsQVector()[Ebsd::CrystalStructure::Cubic_High]->getNumSymOps());
+    DREAM3D_REQUIRE_EQUAL(values.size(), expected.size() * nsym)
+    for(size_t ptIdx = 0; ptIdx < expected.size(); ptIdx++)
+    {
+      DREAM3D_REQUIRE(expected[ptIdx] > 0.0)
+      for(size_t j = 0; j < nsym; j++)
+      {
+        DREAM3D_REQUIRE(std::fabs(values[ptIdx * nsym + j] - expected[ptIdx]) <= k_Tolerance)
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "---- " << getNameOfClass().toStdString() << " ----" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestGBCDMetricBased())
+    DREAM3D_REGISTER_TEST(TestGBPDMetricBased())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+};
@@ -0,0 +1,526 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Math/QuaternionMath.hpp"
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "EbsdLib/EbsdConstants.h"
+
+#include "OrientationLib/LaueOps/LaueOps.h"
+
+#include "OrientationAnalysisTestFileLocations.h"
+
+class NeighborOrientationCleanupTest
+{
+public:
+  NeighborOrientationCleanupTest() = default;
+  ~NeighborOrientationCleanupTest() = default;
+
+  SIMPL_TYPE_MACRO(NeighborOrientationCleanupTest)
+  NeighborOrientationCleanupTest(const NeighborOrientationCleanupTest&) = delete;            // Copy Constructor Not Implemented
+  NeighborOrientationCleanupTest(NeighborOrientationCleanupTest&&) = delete;                 // Move Constructor Not Implemented
+  NeighborOrientationCleanupTest& operator=(const NeighborOrientationCleanupTest&) = delete; // Copy Assignment Not Implemented
+  NeighborOrientationCleanupTest& operator=(NeighborOrientationCleanupTest&&) = delete;      // Move Assignment Not Implemented
+
+  const int64_t k_Dims[3] = {23, 19, 11};
+  const int64_t k_BlockSize = 5;
+  const float k_MisorientationTolerance = 5.0f;
+  const float k_MinConfidence = 0.1f;
+  const QString k_CellIdsArrayName = "CellIds";
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the filters from the FilterManager
+    QStringList filtNames = {"BadDataNeighborOrientationCheck", "NeighborOrientationCorrelation"};
+    FilterManager* fm = FilterManager::Instance();
+    for(const QString& filtName : filtNames)
+    {
+      IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+      if(nullptr == filterFactory.get())
+      {
+        std::stringstream ss;
+        ss << "The NeighborOrientationCleanupTest Requires the use of the " << filtName.toStdString() << " filter which is found in the OrientationAnalysis Plugin";
+        DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+      }
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Blocks of similar orientations: phase 2 is hexagonal, phase 1 cubic and a few cells are
+  // phase 0. About a third of the cells are bad (low confidence, not a good voxel); half of
+  // those keep the orientation of their block and half are random.
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createDataContainerArray()
+  {
+    std::mt19937 generator(11);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::normal_distribution<double> noise(0.0, 0.01);
+    auto randomQuat = [&](float* q) {
+      double length = 0.0;
+      do
+      {
+        for(int32_t c = 0; c < 4; c++)
+        {
+          q[c] = static_cast<float>(2.0 * uniform(generator) - 1.0);
+        }
+        length = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+      } while(length > 1.0 || length < 0.1);
+      for(int32_t c = 0; c < 4; c++)
+      {
+        q[c] = static_cast<float>(q[c] / length);
+      }
+    };
+
+    size_t totalPoints = static_cast<size_t>(k_Dims[0] * k_Dims[1] * k_Dims[2]);
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+    QVector<size_t> tDims = {static_cast<size_t>(k_Dims[0]), static_cast<size_t>(k_Dims[1]), static_cast<size_t>(k_Dims[2])};
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image->setDimensions(tDims.data());
+    dc->setGeometry(image);
+
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAttrMat);
+    QVector<size_t> cDims(1, 1);
+    FloatArrayType::Pointer confidence = FloatArrayType::CreateArray(totalPoints, cDims, SIMPL::CellData::ConfidenceIndex);
+    cellAttrMat->insertOrAssign(confidence);
+    Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(totalPoints, cDims, SIMPL::CellData::Phases);
+    cellAttrMat->insertOrAssign(phases);
+    BoolArrayType::Pointer goodVoxels = BoolArrayType::CreateArray(totalPoints, cDims, SIMPL::CellData::Mask);
+    cellAttrMat->insertOrAssign(goodVoxels);
+    Int32ArrayType::Pointer cellIds = Int32ArrayType::CreateArray(totalPoints, cDims, k_CellIdsArrayName);
+    cellAttrMat->insertOrAssign(cellIds);
+    cDims[0] = 4;
+    FloatArrayType::Pointer quats = FloatArrayType::CreateArray(totalPoints, cDims, SIMPL::CellData::Quats);
+    cellAttrMat->insertOrAssign(quats);
+
+    int64_t blocks[3] = {(k_Dims[0] + k_BlockSize - 1) / k_BlockSize, (k_Dims[1] + k_BlockSize - 1) / k_BlockSize, (k_Dims[2] + k_BlockSize - 1) / k_BlockSize};
+    std::vector<float> blockQuats(static_cast<size_t>(4 * blocks[0] * blocks[1] * blocks[2]));
+    for(size_t b = 0; b < blockQuats.size(); b += 4)
+    {
+      randomQuat(blockQuats.data() + b);
+    }
+
+    for(size_t i = 0; i < totalPoints; i++)
+    {
+      int64_t cell = static_cast<int64_t>(i);
+      int64_t column = cell % k_Dims[0];
+      int64_t row = (cell / k_Dims[0]) % k_Dims[1];
+      int64_t plane = cell / (k_Dims[0] * k_Dims[1]);
+      int64_t block = ((plane / k_BlockSize) * blocks[1] + row / k_BlockSize) * blocks[0] + column / k_BlockSize;
+      phases->setValue(i, uniform(generator) < 0.03 ? 0 : (block % 4 == 0 ? 2 : 1));
+      cellIds->setValue(i, static_cast<int32_t>(i));
+
+      float* q = quats->getPointer(4 * i);
+      double r = uniform(generator);
+      bool bad = r < 0.33;
+      if(r < 0.16)
+      {
+        randomQuat(q);
+      }
+      else
+      {
+        double length = 0.0;
+        for(int32_t c = 0; c < 4; c++)
+        {
+          q[c] = static_cast<float>(blockQuats[4 * block + c] + noise(generator));
+          length += q[c] * q[c];
+        }
+        length = std::sqrt(length);
+        for(int32_t c = 0; c < 4; c++)
+        {
+          q[c] = static_cast<float>(q[c] / length);
+        }
+      }
+      goodVoxels->setValue(i, !bad);
+      confidence->setValue(i, static_cast<float>(bad ? uniform(generator) * k_MinConfidence : k_MinConfidence + uniform(generator) * (1.0 - k_MinConfidence)));
+    }
+
+    tDims.resize(1);
+    tDims[0] = 3;
+    AttributeMatrix::Pointer ensembleAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellEnsembleAttributeMatrixName, AttributeMatrix::Type::CellEnsemble);
+    dc->addOrReplaceAttributeMatrix(ensembleAttrMat);
+    cDims[0] = 1;
+    UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(3, cDims, SIMPL::EnsembleData::CrystalStructures);
+    ensembleAttrMat->insertOrAssign(crystalStructures);
+    crystalStructures->setValue(0, Ebsd::CrystalStructure::UnknownCrystalStructure);
+    crystalStructures->setValue(1, Ebsd::CrystalStructure::Cubic_High);
+    crystalStructures->setValue(2, Ebsd::CrystalStructure::Hexagonal_High);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  AttributeMatrix::Pointer getCellAttributeMatrix(DataContainerArray::Pointer dca)
+  {
+    return dca->getDataContainer(SIMPL::Defaults::ImageDataContainerName)->getAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName);
+  }
+
+  // -----------------------------------------------------------------------------
+  // Face neighbors in the order -z, -y, -x, +x, +y, +z; -1 marks a neighbor outside the volume
+  // -----------------------------------------------------------------------------
+  void faceNeighbors(int64_t i, int64_t neighbors[6])
+  {
+    int64_t column = i % k_Dims[0];
+    int64_t row = (i / k_Dims[0]) % k_Dims[1];
+    int64_t plane = i / (k_Dims[0] * k_Dims[1]);
+    neighbors[0] = plane > 0 ? i - k_Dims[0] * k_Dims[1] : -1;
+    neighbors[1] = row > 0 ? i - k_Dims[0] : -1;
+    neighbors[2] = column > 0 ? i - 1 : -1;
+    neighbors[3] = column < k_Dims[0] - 1 ? i + 1 : -1;
+    neighbors[4] = row < k_Dims[1] - 1 ? i + k_Dims[0] : -1;
+    neighbors[5] = plane < k_Dims[2] - 1 ? i + k_Dims[0] * k_Dims[1] : -1;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Two cells are similar when they share a (non zero) phase and their misorientation is below
+  // the tolerance
+  // -----------------------------------------------------------------------------
+  bool similar(int64_t a, int64_t b, const int32_t* cellPhases, const uint32_t* crystalStructures, float* quats, QVector<LaueOps::Pointer>& orientationOps)
+  {
+    if(cellPhases[a] != cellPhases[b] || cellPhases[a] <= 0)
+    {
+      return false;
+    }
+    QuatF* q = reinterpret_cast<QuatF*>(quats);
+    float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+    float w = orientationOps[crystalStructures[cellPhases[a]]]->getMisoQuat(q[a], q[b], n1, n2, n3);
+    return w < k_MisorientationTolerance * SIMPLib::Constants::k_Pif / 180.0f;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The serial full volume sweeps of the original BadDataNeighborOrientationCheck
+  // -----------------------------------------------------------------------------
+  void referenceBadDataCheck(DataContainerArray::Pointer dca, int32_t numberOfNeighbors)
+  {
+    AttributeMatrix::Pointer cellAttrMat = getCellAttributeMatrix(dca);
+    bool* goodVoxels = cellAttrMat->getAttributeArrayAs<BoolArrayType>(SIMPL::CellData::Mask)->getPointer(0);
+    int32_t* cellPhases = cellAttrMat->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::Phases)->getPointer(0);
+    float* quats = cellAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::CellData::Quats)->getPointer(0);
+    uint32_t* crystalStructures = dca->getDataContainer(SIMPL::Defaults::ImageDataContainerName)
+                                      ->getAttributeMatrix(SIMPL::Defaults::CellEnsembleAttributeMatrixName)
+                                      ->getAttributeArrayAs<UInt32ArrayType>(SIMPL::EnsembleData::CrystalStructures)
+                                      ->getPointer(0);
+    QVector<LaueOps::Pointer> orientationOps = LaueOps::getOrientationOpsQVector();
+    int64_t totalPoints = k_Dims[0] * k_Dims[1] * k_Dims[2];
+    int64_t neighbors[6];
+
+    std::vector<int32_t> neighborCount(static_cast<size_t>(totalPoints), 0);
+    for(int64_t i = 0; i < totalPoints; i++)
+    {
+      if(!goodVoxels[i])
+      {
+        faceNeighbors(i, neighbors);
+        for(int64_t neighbor : neighbors)
+        {
+          if(neighbor >= 0 && goodVoxels[neighbor] && similar(i, neighbor, cellPhases, crystalStructures, quats, orientationOps))
+          {
+            neighborCount[i]++;
+          }
+        }
+      }
+    }
+
+    for(int32_t currentLevel = 6; currentLevel > numberOfNeighbors; currentLevel--)
+    {
+      int32_t counter = 1;
+      while(counter > 0)
+      {
+        counter = 0;
+        for(int64_t i = 0; i < totalPoints; i++)
+        {
+          if(neighborCount[i] >= currentLevel && !goodVoxels[i])
+          {
+            goodVoxels[i] = true;
+            counter++;
+            faceNeighbors(i, neighbors);
+            for(int64_t neighbor : neighbors)
+            {
+              if(neighbor >= 0 && !goodVoxels[neighbor] && similar(i, neighbor, cellPhases, crystalStructures, quats, orientationOps))
+              {
+                neighborCount[neighbor]++;
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // The serial full volume sweep of the original NeighborOrientationCorrelation, with every
+  // cell array except the ignored good voxels copied from the best neighbor
+  // -----------------------------------------------------------------------------
+  void referenceNeighborOrientationCorrelation(DataContainerArray::Pointer dca, int32_t level)
+  {
+    AttributeMatrix::Pointer cellAttrMat = getCellAttributeMatrix(dca);
+    float* confidence = cellAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::CellData::ConfidenceIndex)->getPointer(0);
+    int32_t* cellPhases = cellAttrMat->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::Phases)->getPointer(0);
+    float* quats = cellAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::CellData::Quats)->getPointer(0);
+    uint32_t* crystalStructures = dca->getDataContainer(SIMPL::Defaults::ImageDataContainerName)
+                                      ->getAttributeMatrix(SIMPL::Defaults::CellEnsembleAttributeMatrixName)
+                                      ->getAttributeArrayAs<UInt32ArrayType>(SIMPL::EnsembleData::CrystalStructures)
+                                      ->getPointer(0);
+    QVector<LaueOps::Pointer> orientationOps = LaueOps::getOrientationOpsQVector();
+    int64_t totalPoints = k_Dims[0] * k_Dims[1] * k_Dims[2];
+    int64_t neighbors[6];
+
+    QList<QString> voxelArrayNames = cellAttrMat->getAttributeArrayNames();
+    voxelArrayNames.removeAll(SIMPL::CellData::Mask);
+
+    std::vector<int64_t> bestNeighbor(static_cast<size_t>(totalPoints), -1);
+    const int32_t startLevel = 6;
+    for(int32_t currentLevel = startLevel; currentLevel > level; currentLevel--)
+    {
+      for(int64_t i = 0; i < totalPoints; i++)
+      {
+        if(confidence[i] < k_MinConfidence)
+        {
+          faceNeighbors(i, neighbors);
+          int32_t neighborSimCount[6] = {0, 0, 0, 0, 0, 0};
+          for(size_t j = 0; j < 6; j++)
+          {
+            for(size_t k = j + 1; k < 6; k++)
+            {
+              if(neighbors[j] >= 0 && neighbors[k] >= 0 && similar(neighbors[k], neighbors[j], cellPhases, crystalStructures, quats, orientationOps))
+              {
+                neighborSimCount[j]++;
+                neighborSimCount[k]++;
+              }
+            }
+          }
+          for(size_t j = 0; j < 6; j++)
+          {
+            if(neighbors[j] >= 0 && neighborSimCount[j] > 0)
+            {
+              bestNeighbor[i] = neighbors[j];
+            }
+          }
+        }
+      }
+
+      for(int64_t i = 0; i < totalPoints; i++)
+      {
+        if(bestNeighbor[i] != -1)
+        {
+          for(const QString& name : voxelArrayNames)
+          {
+            cellAttrMat->getAttributeArray(name)->copyTuple(bestNeighbor[i], i);
+          }
+        }
+      }
+
+      currentLevel = currentLevel - 1;
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void runBadDataCheck(DataContainerArray::Pointer dca, int32_t numberOfNeighbors)
+  {
+    FilterManager* fm = FilterManager::Instance();
+    AbstractFilter::Pointer filter = fm->getFactoryFromClassName("BadDataNeighborOrientationCheck")->create();
+    filter->setDataContainerArray(dca);
+
+    QVariant var;
+    bool propWasSet = filter->setProperty("MisorientationTolerance", k_MisorientationTolerance);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    propWasSet = filter->setProperty("NumberOfNeighbors", numberOfNeighbors);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Mask));
+    propWasSet = filter->setProperty("GoodVoxelsArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Phases));
+    propWasSet = filter->setProperty("CellPhasesArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellEnsembleAttributeMatrixName, SIMPL::EnsembleData::CrystalStructures));
+    propWasSet = filter->setProperty("CrystalStructuresArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Quats));
+    propWasSet = filter->setProperty("QuatsArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void runNeighborOrientationCorrelation(DataContainerArray::Pointer dca, int32_t level)
+  {
+    FilterManager* fm = FilterManager::Instance();
+    AbstractFilter::Pointer filter = fm->getFactoryFromClassName("NeighborOrientationCorrelation")->create();
+    filter->setDataContainerArray(dca);
+
+    QVariant var;
+    bool propWasSet = filter->setProperty("MisorientationTolerance", k_MisorientationTolerance);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    propWasSet = filter->setProperty("MinConfidence", k_MinConfidence);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    propWasSet = filter->setProperty("Level", level);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::ConfidenceIndex));
+    propWasSet = filter->setProperty("ConfidenceIndexArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Phases));
+    propWasSet = filter->setProperty("CellPhasesArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellEnsembleAttributeMatrixName, SIMPL::EnsembleData::CrystalStructures));
+    propWasSet = filter->setProperty("CrystalStructuresArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Quats));
+    propWasSet = filter->setProperty("QuatsArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    QVector<DataArrayPath> ignoredPaths = {DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Mask)};
+    var.setValue(ignoredPaths);
+    propWasSet = filter->setProperty("IgnoredDataArrayPaths", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+  }
+
+  // -----------------------------------------------------------------------------
+  // Every cell array must hold the same bytes in both data container arrays
+  // -----------------------------------------------------------------------------
+  void compareCellArrays(DataContainerArray::Pointer expected, DataContainerArray::Pointer actual)
+  {
+    AttributeMatrix::Pointer expectedAttrMat = getCellAttributeMatrix(expected);
+    AttributeMatrix::Pointer actualAttrMat = getCellAttributeMatrix(actual);
+    for(const QString& name : expectedAttrMat->getAttributeArrayNames())
+    {
+      IDataArray::Pointer expectedArray = expectedAttrMat->getAttributeArray(name);
+      IDataArray::Pointer actualArray = actualAttrMat->getAttributeArray(name);
+      DREAM3D_REQUIRE_VALID_POINTER(actualArray.get())
+      size_t numBytes = expectedArray->getSize() * expectedArray->getTypeSize();
+      DREAM3D_REQUIRE_EQUAL(numBytes, actualArray->getSize() * actualArray->getTypeSize())
+      DREAM3D_REQUIRE(std::memcmp(expectedArray->getVoidPointer(0), actualArray->getVoidPointer(0), numBytes) == 0)
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // The worklist implementation must flag the same cells as the full volume sweeps
+  // -----------------------------------------------------------------------------
+  int TestBadDataCheckMatchesSweeps(int32_t numberOfNeighbors)
+  {
+    DataContainerArray::Pointer expected = createDataContainerArray();
+    DataContainerArray::Pointer actual = createDataContainerArray();
+    bool* mask = getCellAttributeMatrix(expected)->getAttributeArrayAs<BoolArrayType>(SIMPL::CellData::Mask)->getPointer(0);
+    size_t totalPoints = static_cast<size_t>(k_Dims[0] * k_Dims[1] * k_Dims[2]);
+    size_t numBadCells = static_cast<size_t>(std::count(mask, mask + totalPoints, false));
+
+    referenceBadDataCheck(expected, numberOfNeighbors);
+    runBadDataCheck(actual, numberOfNeighbors);
+    compareCellArrays(expected, actual);
+
+    // Some, but not all, of the bad cells were turned good
+    size_t numRemaining = static_cast<size_t>(std::count(mask, mask + totalPoints, false));
+    DREAM3D_REQUIRED(numRemaining, <, numBadCells)
+    DREAM3D_REQUIRED(numRemaining, >, 0)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The worklist implementation must copy the same tuples, in the same order, as the full
+  // volume sweep
+  // -----------------------------------------------------------------------------
+  int TestNeighborOrientationCorrelationMatchesSweep(int32_t level)
+  {
+    DataContainerArray::Pointer expected = createDataContainerArray();
+    DataContainerArray::Pointer actual = createDataContainerArray();
+
+    referenceNeighborOrientationCorrelation(expected, level);
+    runNeighborOrientationCorrelation(actual, level);
+    compareCellArrays(expected, actual);
+
+    Int32ArrayType::Pointer cellIds = getCellAttributeMatrix(actual)->getAttributeArrayAs<Int32ArrayType>(k_CellIdsArrayName);
+    size_t numCopied = 0;
+    for(size_t i = 0; i < cellIds->getNumberOfTuples(); i++)
+    {
+      numCopied += (cellIds->getValue(i) != static_cast<int32_t>(i)) ? 1 : 0;
+    }
+    DREAM3D_REQUIRED(numCopied, >, 0)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "---- " << getNameOfClass().toStdString() << " ----" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability())
+
+    DREAM3D_REGISTER_TEST(TestBadDataCheckMatchesSweeps(4))
+    DREAM3D_REGISTER_TEST(TestBadDataCheckMatchesSweeps(2))
+    DREAM3D_REGISTER_TEST(TestBadDataCheckMatchesSweeps(0))
+    DREAM3D_REGISTER_TEST(TestNeighborOrientationCorrelationMatchesSweep(5))
+    DREAM3D_REGISTER_TEST(TestNeighborOrientationCorrelationMatchesSweep(2))
+    DREAM3D_REGISTER_TEST(TestNeighborOrientationCorrelationMatchesSweep(0))
+  }
+};
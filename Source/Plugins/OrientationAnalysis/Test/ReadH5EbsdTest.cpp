@@ -0,0 +1,454 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <tuple>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QTextStream>
+
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/FilterParameters/AxisAngleInput.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "EbsdLib/EbsdConstants.h"
+#include "EbsdLib/TSL/AngConstants.h"
+#include "EbsdLib/TSL/H5AngVolumeReader.h"
+
+#include "Plugins/OrientationAnalysis/OrientationAnalysisFilters/EbsdToH5Ebsd.h"
+#include "Plugins/OrientationAnalysis/OrientationAnalysisFilters/ReadH5Ebsd.h"
+
+#include "OrientationAnalysisTestFileLocations.h"
+
+class ReadH5EbsdTest
+{
+public:
+  ReadH5EbsdTest() = default;
+  ~ReadH5EbsdTest() = default;
+
+  SIMPL_TYPE_MACRO(ReadH5EbsdTest)
+  ReadH5EbsdTest(const ReadH5EbsdTest&) = delete;            // Copy Constructor Not Implemented
+  ReadH5EbsdTest(ReadH5EbsdTest&&) = delete;                 // Move Constructor Not Implemented
+  ReadH5EbsdTest& operator=(const ReadH5EbsdTest&) = delete; // Copy Assignment Not Implemented
+  ReadH5EbsdTest& operator=(ReadH5EbsdTest&&) = delete;      // Move Assignment Not Implemented
+
+  const int64_t k_ZStartIndex = 1;
+  const int64_t k_ZEndIndex = 6;
+  const int k_PaddingDigits = 2;
+  const QString k_FilePrefix = "Slice_";
+  const QString k_FileExtension = "ang";
+  const float k_EulerTolerance = 1.0e-5f;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+    QDir(UnitTest::ReadH5EbsdTest::InputDir).removeRecursively();
+    QFile::remove(UnitTest::ReadH5EbsdTest::TSLFile);
+    QFile::remove(UnitTest::ReadH5EbsdTest::RotatedFile);
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the filters from the FilterManager. The sample rotation filter is
+    // found in the Sampling Plugin.
+    QStringList filtNames = {"EbsdToH5Ebsd", "ReadH5Ebsd", "RotateEulerRefFrame", "RotateSampleRefFrame"};
+    FilterManager* fm = FilterManager::Instance();
+    for(const QString& filtName : filtNames)
+    {
+      IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+      if(nullptr == filterFactory.get())
+      {
+        std::stringstream ss;
+        ss << "The ReadH5EbsdTest Requires the use of the " << filtName.toStdString() << " filter";
+        DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+      }
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  QString slicePath(int64_t z)
+  {
+    return QString("%1/%2%3.%4").arg(UnitTest::ReadH5EbsdTest::InputDir).arg(k_FilePrefix).arg(z, k_PaddingDigits, 10, QChar('0')).arg(k_FileExtension);
+  }
+
+  // -----------------------------------------------------------------------------
+  // Writes a small square grid .ang file. Odd slices are smaller than even ones, so they are
+  // centered in the volume with a border of empty cells.
+  // -----------------------------------------------------------------------------
+  void writeSlice(int64_t z)
+  {
+    int numCols = (z % 2 == 0) ? 9 : 7;
+    int numRows = (z % 2 == 0) ? 6 : 5;
+    QFile file(slicePath(z));
+    DREAM3D_REQUIRE(file.open(QIODevice::WriteOnly | QIODevice::Text))
+    QTextStream out(&file);
+    out << "# TEM_PIXperUM          1.000000\n";
+    out << "# x-star                0.500000\n";
+    out << "# y-star                0.600000\n";
+    out << "# z-star                0.700000\n";
+    out << "# WorkingDistance       15.000000\n";
+    out << "#\n";
+    out << "# Phase 1\n";
+    out << "# MaterialName  \tNickel\n";
+    out << "# Formula     \tNi\n";
+    out << "# Info \t\t\n";
+    out << "# Symmetry              43\n";
+    out << "# LatticeConstants      3.560 3.560 3.560  90.000  90.000  90.000\n";
+    out << "# NumberFamilies        1\n";
+    out << "# hklFamilies   \t 1  1  1 1 0.000000\n";
+    out << "#\n";
+    out << "# GRID: SqrGrid\n";
+    out << "# XSTEP: 0.250000\n";
+    out << "# YSTEP: 0.500000\n";
+    out << "# NCOLS_ODD: " << numCols << "\n";
+    out << "# NCOLS_EVEN: " << numCols << "\n";
+    out << "# NROWS: " << numRows << "\n";
+    out << "#\n";
+    out << "# OPERATOR: \tTest\n";
+    out << "# SAMPLEID: \tSlice" << z << "\n";
+    out << "# SCANID: \t\n";
+    out << "#\n";
+    for(int row = 0; row < numRows; row++)
+    {
+      for(int col = 0; col < numCols; col++)
+      {
+        int64_t i = (z * 16 + row) * 16 + col;
+        uint32_t h = static_cast<uint32_t>(i * 2654435761u + 12345u);
+        out << QString::number(0.05 + static_cast<double>(h % 6180) * 0.001, 'f', 5) << " ";
+        out << QString::number(0.05 + static_cast<double>((h >> 8) % 3040) * 0.001, 'f', 5) << " ";
+        out << QString::number(0.05 + static_cast<double>((h >> 16) % 6180) * 0.001, 'f', 5) << " ";
+        out << QString::number(col * 0.25, 'f', 5) << " ";
+        out << QString::number(row * 0.5, 'f', 5) << " ";
+        out << QString::number(static_cast<double>(h % 1000) * 0.1, 'f', 1) << " ";
+        out << QString::number(static_cast<double>((h >> 4) % 1000) * 0.001, 'f', 3) << " ";
+        out << (h % 7 == 0 ? 0 : 1) << " ";
+        out << (h >> 20) % 4096 << " ";
+        out << QString::number(static_cast<double>((h >> 12) % 300) * 0.01, 'f', 3) << "\n";
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void writeH5Ebsd(const QString& outputFile, const AxisAngleInput_t& sampleTransformation, const AxisAngleInput_t& eulerTransformation)
+  {
+    EbsdToH5Ebsd::Pointer filter = EbsdToH5Ebsd::New();
+    filter->setOutputFile(outputFile);
+    filter->setInputPath(UnitTest::ReadH5EbsdTest::InputDir);
+    filter->setFilePrefix(k_FilePrefix);
+    filter->setFileSuffix("");
+    filter->setFileExtension(k_FileExtension);
+    filter->setPaddingDigits(k_PaddingDigits);
+    filter->setZStartIndex(k_ZStartIndex);
+    filter->setZEndIndex(k_ZEndIndex);
+    filter->setZResolution(0.75f);
+    filter->setRefFrameZDir(SIMPL::RefFrameZDir::LowtoHigh);
+    filter->setSampleTransformation(sampleTransformation);
+    filter->setEulerTransformation(eulerTransformation);
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  QSet<QString> selectedArrayNames()
+  {
+    QSet<QString> names;
+    names << SIMPL::CellData::Phases << SIMPL::CellData::EulerAngles << Ebsd::Ang::ImageQuality << Ebsd::Ang::ConfidenceIndex << Ebsd::Ang::SEMSignal << Ebsd::Ang::Fit << Ebsd::Ang::XPosition
+          << Ebsd::Ang::YPosition;
+    return names;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer runReadH5Ebsd(const QString& inputFile, bool useTransformations)
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    ReadH5Ebsd::Pointer filter = ReadH5Ebsd::New();
+    filter->setDataContainerArray(dca);
+    filter->setInputFile(inputFile);
+    filter->setZStartIndex(static_cast<int>(k_ZStartIndex));
+    filter->setZEndIndex(static_cast<int>(k_ZEndIndex));
+    filter->setUseTransformations(useTransformations);
+    filter->setSelectedArrayNames(selectedArrayNames());
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0)
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The volume as the original ReadH5Ebsd built it before any rotation: the whole volume is
+  // loaded by the volume reader and then copied into the cell arrays
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer loadBaseline(const QString& inputFile)
+  {
+    H5AngVolumeReader::Pointer reader = H5AngVolumeReader::New();
+    reader->setFileName(inputFile);
+    int err = reader->readVolumeInfo();
+    DREAM3D_REQUIRED(err, >=, 0)
+    int64_t dims[3] = {0, 0, 0};
+    float res[3] = {0.0f, 0.0f, 0.0f};
+    reader->getDimsAndResolution(dims[0], dims[1], dims[2], res[0], res[1], res[2]);
+    dims[2] = k_ZEndIndex - k_ZStartIndex + 1;
+
+    QSet<QString> arrayNames;
+    arrayNames << Ebsd::Ang::Phi1 << Ebsd::Ang::Phi << Ebsd::Ang::Phi2 << Ebsd::Ang::PhaseData << Ebsd::Ang::ImageQuality << Ebsd::Ang::ConfidenceIndex << Ebsd::Ang::SEMSignal << Ebsd::Ang::Fit
+               << Ebsd::Ang::XPosition << Ebsd::Ang::YPosition;
+    reader->setSliceStart(k_ZStartIndex);
+    reader->setSliceEnd(k_ZEndIndex);
+    reader->readAllArrays(false);
+    reader->setArraysToRead(arrayNames);
+    err = reader->loadData(dims[0], dims[1], dims[2], SIMPL::RefFrameZDir::LowtoHigh);
+    DREAM3D_REQUIRED(err, >=, 0)
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+    QVector<size_t> tDims = {static_cast<size_t>(dims[0]), static_cast<size_t>(dims[1]), static_cast<size_t>(dims[2])};
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image->setDimensions(tDims.data());
+    image->setSpacing(FloatVec3Type(res[0], res[1], res[2]));
+    dc->setGeometry(image);
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAttrMat);
+
+    size_t totalPoints = static_cast<size_t>(dims[0] * dims[1] * dims[2]);
+    QVector<size_t> cDims(1, 1);
+    Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(tDims, cDims, SIMPL::CellData::Phases);
+    ::memcpy(phases->getPointer(0), reader->getPointerByName(Ebsd::Ang::PhaseData), sizeof(int32_t) * totalPoints);
+    cellAttrMat->insertOrAssign(phases);
+
+    cDims[0] = 3;
+    FloatArrayType::Pointer eulers = FloatArrayType::CreateArray(tDims, cDims, SIMPL::CellData::EulerAngles);
+    float* f1 = reinterpret_cast<float*>(reader->getPointerByName(Ebsd::Ang::Phi1));
+    float* f2 = reinterpret_cast<float*>(reader->getPointerByName(Ebsd::Ang::Phi));
+    float* f3 = reinterpret_cast<float*>(reader->getPointerByName(Ebsd::Ang::Phi2));
+    for(size_t i = 0; i < totalPoints; i++)
+    {
+      eulers->setComponent(i, 0, f1[i]);
+      eulers->setComponent(i, 1, f2[i]);
+      eulers->setComponent(i, 2, f3[i]);
+    }
+    cellAttrMat->insertOrAssign(eulers);
+
+    cDims[0] = 1;
+    QStringList scalarNames = {Ebsd::Ang::ImageQuality, Ebsd::Ang::ConfidenceIndex, Ebsd::Ang::SEMSignal, Ebsd::Ang::Fit, Ebsd::Ang::XPosition, Ebsd::Ang::YPosition};
+    for(const QString& name : scalarNames)
+    {
+      FloatArrayType::Pointer data = FloatArrayType::CreateArray(tDims, cDims, name);
+      ::memcpy(data->getPointer(0), reader->getPointerByName(name), sizeof(float) * totalPoints);
+      cellAttrMat->insertOrAssign(data);
+    }
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The original ReadH5Ebsd rotated the loaded volume with these two filters
+  // -----------------------------------------------------------------------------
+  void rotateBaseline(DataContainerArray::Pointer dca, const AxisAngleInput_t& sampleTransformation, const AxisAngleInput_t& eulerTransformation)
+  {
+    FilterManager* fm = FilterManager::Instance();
+    QVariant var;
+    if(sampleTransformation.angle > 0)
+    {
+      AbstractFilter::Pointer filter = fm->getFactoryFromClassName("RotateSampleRefFrame")->create();
+      filter->setDataContainerArray(dca);
+      bool propWasSet = filter->setProperty("RotationAngle", sampleTransformation.angle);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(FloatVec3Type(sampleTransformation.h, sampleTransformation.k, sampleTransformation.l));
+      propWasSet = filter->setProperty("RotationAxis", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      propWasSet = filter->setProperty("SliceBySlice", true);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, ""));
+      propWasSet = filter->setProperty("CellAttributeMatrixPath", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      filter->execute();
+      DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0)
+    }
+
+    if(eulerTransformation.angle > 0)
+    {
+      AbstractFilter::Pointer filter = fm->getFactoryFromClassName("RotateEulerRefFrame")->create();
+      filter->setDataContainerArray(dca);
+      bool propWasSet = filter->setProperty("RotationAngle", eulerTransformation.angle);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(FloatVec3Type(eulerTransformation.h, eulerTransformation.k, eulerTransformation.l));
+      propWasSet = filter->setProperty("RotationAxis", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::EulerAngles));
+      propWasSet = filter->setProperty("CellEulerAnglesArrayPath", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      filter->execute();
+      DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0)
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // The geometry and every baseline cell array must match; the Euler angles within a small
+  // tolerance, everything else exactly
+  // -----------------------------------------------------------------------------
+  void compareVolumes(DataContainerArray::Pointer expected, DataContainerArray::Pointer actual)
+  {
+    ImageGeom::Pointer expectedImage = expected->getDataContainer(SIMPL::Defaults::ImageDataContainerName)->getGeometryAs<ImageGeom>();
+    ImageGeom::Pointer actualImage = actual->getDataContainer(SIMPL::Defaults::ImageDataContainerName)->getGeometryAs<ImageGeom>();
+    size_t expectedDims[3] = {0, 0, 0};
+    size_t actualDims[3] = {0, 0, 0};
+    std::tie(expectedDims[0], expectedDims[1], expectedDims[2]) = expectedImage->getDimensions();
+    std::tie(actualDims[0], actualDims[1], actualDims[2]) = actualImage->getDimensions();
+    FloatVec3Type expectedSpacing = expectedImage->getSpacing();
+    FloatVec3Type actualSpacing = actualImage->getSpacing();
+    FloatVec3Type expectedOrigin = expectedImage->getOrigin();
+    FloatVec3Type actualOrigin = actualImage->getOrigin();
+    for(size_t d = 0; d < 3; d++)
+    {
+      DREAM3D_REQUIRE_EQUAL(expectedDims[d], actualDims[d])
+      DREAM3D_REQUIRE(std::fabs(expectedSpacing[d] - actualSpacing[d]) < 1.0e-5f)
+      DREAM3D_REQUIRE(std::fabs(expectedOrigin[d] - actualOrigin[d]) < 1.0e-5f)
+    }
+
+    AttributeMatrix::Pointer expectedAttrMat = expected->getDataContainer(SIMPL::Defaults::ImageDataContainerName)->getAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName);
+    AttributeMatrix::Pointer actualAttrMat = actual->getDataContainer(SIMPL::Defaults::ImageDataContainerName)->getAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName);
+    for(const QString& name : expectedAttrMat->getAttributeArrayNames())
+    {
+      IDataArray::Pointer expectedArray = expectedAttrMat->getAttributeArray(name);
+      IDataArray::Pointer actualArray = actualAttrMat->getAttributeArray(name);
+      DREAM3D_REQUIRE_VALID_POINTER(actualArray.get())
+      DREAM3D_REQUIRE_EQUAL(expectedArray->getNumberOfTuples(), actualArray->getNumberOfTuples())
+      DREAM3D_REQUIRE_EQUAL(expectedArray->getNumberOfComponents(), actualArray->getNumberOfComponents())
+      DREAM3D_REQUIRE_EQUAL(expectedArray->getTypeAsString(), actualArray->getTypeAsString())
+      if(name == SIMPL::CellData::EulerAngles)
+      {
+        float* expectedEulers = std::dynamic_pointer_cast<FloatArrayType>(expectedArray)->getPointer(0);
+        float* actualEulers = std::dynamic_pointer_cast<FloatArrayType>(actualArray)->getPointer(0);
+        for(size_t i = 0; i < expectedArray->getSize(); i++)
+        {
+          float diff = std::fabs(expectedEulers[i] - actualEulers[i]);
+          diff = std::min(diff, std::fabs(diff - SIMPLib::Constants::k_2Pi));
+          DREAM3D_REQUIRED(diff, <, k_EulerTolerance)
+        }
+      }
+      else
+      {
+        size_t numBytes = expectedArray->getSize() * expectedArray->getTypeSize();
+        DREAM3D_REQUIRE(std::memcmp(expectedArray->getVoidPointer(0), actualArray->getVoidPointer(0), numBytes) == 0)
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // ReadH5Ebsd applies the reference frame transforms while the slices are loaded. The result
+  // must be what loading the whole volume and then running RotateSampleRefFrame (slice by
+  // slice) and RotateEulerRefFrame gives.
+  // -----------------------------------------------------------------------------
+  int TestMatchesRotateFilters(const QString& inputFile, float sampleAngle, const float sampleAxis[3], float eulerAngle, const float eulerAxis[3])
+  {
+    AxisAngleInput_t sampleTransformation;
+    sampleTransformation.angle = sampleAngle;
+    sampleTransformation.h = sampleAxis[0];
+    sampleTransformation.k = sampleAxis[1];
+    sampleTransformation.l = sampleAxis[2];
+    AxisAngleInput_t eulerTransformation;
+    eulerTransformation.angle = eulerAngle;
+    eulerTransformation.h = eulerAxis[0];
+    eulerTransformation.k = eulerAxis[1];
+    eulerTransformation.l = eulerAxis[2];
+    writeH5Ebsd(inputFile, sampleTransformation, eulerTransformation);
+
+    DataContainerArray::Pointer expected = loadBaseline(inputFile);
+    DataContainerArray::Pointer untransformed = runReadH5Ebsd(inputFile, false);
+    compareVolumes(expected, untransformed);
+
+    rotateBaseline(expected, sampleTransformation, eulerTransformation);
+    DataContainerArray::Pointer transformed = runReadH5Ebsd(inputFile, true);
+    compareVolumes(expected, transformed);
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "---- " << getNameOfClass().toStdString() << " ----" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability())
+
+    QDir().mkpath(UnitTest::ReadH5EbsdTest::InputDir);
+    for(int64_t z = k_ZStartIndex; z <= k_ZEndIndex; z++)
+    {
+      writeSlice(z);
+    }
+
+    // The usual TSL transforms, and a sample rotation that swaps the x and y dimensions
+    const float yAxis[3] = {0.0f, 1.0f, 0.0f};
+    const float zAxis[3] = {0.0f, 0.0f, 1.0f};
+    const float xAxis[3] = {1.0f, 0.0f, 0.0f};
+    DREAM3D_REGISTER_TEST(TestMatchesRotateFilters(UnitTest::ReadH5EbsdTest::TSLFile, 180.0f, yAxis, 90.0f, zAxis))
+    DREAM3D_REGISTER_TEST(TestMatchesRotateFilters(UnitTest::ReadH5EbsdTest::RotatedFile, 90.0f, zAxis, 60.0f, xAxis))
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+};
@@ -35,19 +35,9 @@
 
 #include "AlignSections.h"
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-#include <tbb/atomic.h>
-#include <tbb/blocked_range.h>
-#include <tbb/parallel_for.h>
-#include <tbb/task_group.h>
-#include <tbb/task_scheduler_init.h>
-#include <tbb/tick_count.h>
-#endif
-
 #include "Reconstruction/ReconstructionConstants.h"
 #include "Reconstruction/ReconstructionVersion.h"
 #include "SIMPLib/Common/Constants.h"
-#include "SIMPLib/Common/TemplateHelpers.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
@@ -55,105 +45,7 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Utilities/FileSystemPathHelper.h"
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-template <typename T> void initializeArrayValues(IDataArray::Pointer p, size_t index)
-{
-
-  typename DataArray<T>::Pointer ptr = std::dynamic_pointer_cast<DataArray<T>>(p);
-  T var = static_cast<T>(0);
-  ptr->initializeTuple(index, &var);
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-class AlignSectionsTransferDataImpl
-{
-public:
-  AlignSectionsTransferDataImpl() = delete;
-  AlignSectionsTransferDataImpl(const AlignSectionsTransferDataImpl&) = default; // Copy Constructor Default Implemented
-  AlignSectionsTransferDataImpl(AlignSectionsTransferDataImpl&&) = default;      // Move Constructor Default Implemented
-
-  AlignSectionsTransferDataImpl(AlignSections* filter, size_t* dims, const std::vector<int64_t>& xshifts, const std::vector<int64_t>& yshifts, IDataArray::Pointer dataArrayPtr)
-  : m_Filter(filter)
-  , m_Dims(dims)
-  , m_xshifts(xshifts)
-  , m_yshifts(yshifts)
-  , m_DataArrayPtr(dataArrayPtr)
-  {
-  }
-
-  ~AlignSectionsTransferDataImpl() = default;
-
-  AlignSectionsTransferDataImpl& operator=(const AlignSectionsTransferDataImpl&) = delete; // Copy Assignment Not Implemented
-  AlignSectionsTransferDataImpl& operator=(AlignSectionsTransferDataImpl&&) = delete;      // Move Assignment Not Implemented
-
-  void operator()() const
-  {
-    size_t progIncrement = m_Dims[2] / 50;
-    size_t prog = 1;
-    size_t slice = 0;
-
-    for(size_t i = 1; i < m_Dims[2]; i++)
-    {
-      if(i > prog)
-      {
-        prog = prog + progIncrement;
-        m_Filter->updateProgress(progIncrement);
-      }
-      if(m_Filter->getCancel())
-      {
-        return;
-      }
-      slice = (m_Dims[2] - 1) - i;
-      for(size_t l = 0; l < m_Dims[1]; l++)
-      {
-        for(size_t n = 0; n < m_Dims[0]; n++)
-        {
-          int64_t xspot = 0, yspot = 0;
-          int64_t newPosition = 0;
-          int64_t currentPosition = 0;
-          if(m_yshifts[i] >= 0)
-          {
-            yspot = static_cast<int64_t>(l);
-          }
-          else if(m_yshifts[i] < 0)
-          {
-            yspot = static_cast<int64_t>(m_Dims[1]) - 1 - static_cast<int64_t>(l);
-          }
-          if(m_xshifts[i] >= 0)
-          {
-            xspot = static_cast<int64_t>(n);
-          }
-          else if(m_xshifts[i] < 0)
-          {
-            xspot = static_cast<int64_t>(m_Dims[0]) - 1 - static_cast<int64_t>(n);
-          }
-          newPosition = (slice * m_Dims[0] * m_Dims[1]) + (yspot * m_Dims[0]) + xspot;
-          currentPosition = (slice * m_Dims[0] * m_Dims[1]) + ((yspot + m_yshifts[i]) * m_Dims[0]) + (xspot + m_xshifts[i]);
-          if((yspot + m_yshifts[i]) >= 0 && (yspot + m_yshifts[i]) <= static_cast<int64_t>(m_Dims[1]) - 1 && (xspot + m_xshifts[i]) >= 0 &&
-             (xspot + m_xshifts[i]) <= static_cast<int64_t>(m_Dims[0]) - 1)
-          {
-            m_DataArrayPtr->copyTuple(static_cast<size_t>(currentPosition), static_cast<size_t>(newPosition));
-          }
-          if((yspot + m_yshifts[i]) < 0 || (yspot + m_yshifts[i]) > static_cast<int64_t>(m_Dims[1] - 1) || (xspot + m_xshifts[i]) < 0 || (xspot + m_xshifts[i]) > static_cast<int64_t>(m_Dims[0]) - 1)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(m_Filter, initializeArrayValues, m_DataArrayPtr, m_DataArrayPtr, newPosition)
-          }
-        }
-      }
-    }
-  }
-
-private:
-  AlignSections* m_Filter = nullptr;
-  size_t* m_Dims = nullptr;
-  std::vector<int64_t> m_xshifts;
-  std::vector<int64_t> m_yshifts;
-  IDataArray::Pointer m_DataArrayPtr;
-};
+#include "DREAM3DLib/Utilities/CellReindexer.hpp"
 
 // -----------------------------------------------------------------------------
 //
@@ -289,103 +181,59 @@ void AlignSections::execute()
 
   find_shifts(xshifts, yshifts);
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
-  bool doParallel = true;
-#endif
-
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  // The idea for this parallel section is to parallelize over each Data Array that
-  // will need it's data adjusted. This should go faster than before by about 2x.
-  // Better speed up could be achieved if we had better data locality.
-  if(doParallel)
+  // Slice dims[2] - 1 - i is shifted by (xshifts[i], yshifts[i]); cells shifted in from outside
+  // of the slice have no source and are zero filled. The top slice is never moved.
+  std::vector<int64_t> newToOld(dims[0] * dims[1] * dims[2]);
+  for(size_t i = 0; i < dims[2]; i++)
   {
-    std::shared_ptr<tbb::task_group> taskGroup(new tbb::task_group);
-    QList<QString> voxelArrayNames = m->getAttributeMatrix(getCellAttributeMatrixName())->getAttributeArrayNames();
-    for(const auto& dataArrayPath : m_IgnoredDataArrayPaths)
-    {
-      voxelArrayNames.removeAll(dataArrayPath.getDataArrayName());
-    }
-    m_TotalProgress = voxelArrayNames.size() * dims[2]; // Total number of slices to update
-    // Create all the tasks
-    for(const auto& arrayName : voxelArrayNames)
+    size_t slice = (dims[2] - 1) - i;
+    int64_t xshift = (i == 0) ? 0 : xshifts[i];
+    int64_t yshift = (i == 0) ? 0 : yshifts[i];
+    for(size_t l = 0; l < dims[1]; l++)
     {
-      IDataArray::Pointer dataArrayPtr = m->getAttributeMatrix(getCellAttributeMatrixName())->getAttributeArray(arrayName);
-      taskGroup->run(AlignSectionsTransferDataImpl(this, dims, xshifts, yshifts, dataArrayPtr));
-    }
-    // Wait for them to complete.
-    taskGroup->wait();
-  }
-  else
-#endif
-  {
-    QList<QString> voxelArrayNames = m->getAttributeMatrix(getCellAttributeMatrixName())->getAttributeArrayNames();
-    size_t progIncrement = dims[2] / 100;
-    size_t prog = 1;
-    size_t progressInt = 0;
-    size_t slice = 0;
-
-    for(size_t i = 1; i < dims[2]; i++)
-    {
-      if(i > prog)
-      {
-        progressInt = static_cast<int>((static_cast<float>(i) / static_cast<float>(dims[2])) * 100.0f);
-        QString ss = QObject::tr("Transferring Cell Data %1%").arg(progressInt);
-        notifyStatusMessage(ss);
-        prog = prog + progIncrement;
-      }
-      if(getCancel())
-      {
-        return;
-      }
-      slice = (dims[2] - 1) - i;
-      for(size_t l = 0; l < dims[1]; l++)
+      int64_t yold = static_cast<int64_t>(l) + yshift;
+      for(size_t n = 0; n < dims[0]; n++)
       {
-        for(size_t n = 0; n < dims[0]; n++)
+        int64_t xold = static_cast<int64_t>(n) + xshift;
+        size_t newPosition = (slice * dims[0] * dims[1]) + (l * dims[0]) + n;
+        if(yold >= 0 && yold < static_cast<int64_t>(dims[1]) && xold >= 0 && xold < static_cast<int64_t>(dims[0]))
         {
-          int64_t xspot = 0, yspot = 0;
-          int64_t newPosition = 0;
-          int64_t currentPosition = 0;
-          if(yshifts[i] >= 0)
-          {
-            yspot = static_cast<int64_t>(l);
-          }
-          else if(yshifts[i] < 0)
-          {
-            yspot = static_cast<int64_t>(dims[1]) - 1 - static_cast<int64_t>(l);
-          }
-          if(xshifts[i] >= 0)
-          {
-            xspot = static_cast<int64_t>(n);
-          }
-          else if(xshifts[i] < 0)
-          {
-            xspot = static_cast<int64_t>(dims[0]) - 1 - static_cast<int64_t>(n);
-          }
-          newPosition = (slice * dims[0] * dims[1]) + (yspot * dims[0]) + xspot;
-          currentPosition = (slice * dims[0] * dims[1]) + ((yspot + yshifts[i]) * dims[0]) + (xspot + xshifts[i]);
-          if((yspot + yshifts[i]) >= 0 && (yspot + yshifts[i]) <= static_cast<int64_t>(dims[1]) - 1 && (xspot + xshifts[i]) >= 0 && (xspot + xshifts[i]) <= static_cast<int64_t>(dims[0]) - 1)
-          {
-            for(const auto& arrayName : voxelArrayNames)
-            {
-              IDataArray::Pointer p = m->getAttributeMatrix(getCellAttributeMatrixName())->getAttributeArray(arrayName);
-              p->copyTuple(static_cast<size_t>(currentPosition), static_cast<size_t>(newPosition));
-            }
-          }
-          if((yspot + yshifts[i]) < 0 || (yspot + yshifts[i]) > static_cast<int64_t>(dims[1] - 1) || (xspot + xshifts[i]) < 0 || (xspot + xshifts[i]) > static_cast<int64_t>(dims[0]) - 1)
-          {
-            for(const auto& arrayName : voxelArrayNames)
-            {
-              IDataArray::Pointer p = m->getAttributeMatrix(getCellAttributeMatrixName())->getAttributeArray(arrayName);
-              EXECUTE_FUNCTION_TEMPLATE(this, initializeArrayValues, p, p, newPosition)
-            }
-          }
+          newToOld[newPosition] = static_cast<int64_t>((slice * dims[0] * dims[1]) + (yold * dims[0]) + xold);
+        }
+        else
+        {
+          newToOld[newPosition] = -1;
         }
       }
     }
   }
 
+  AttributeMatrix::Pointer cellAttrMat = m->getAttributeMatrix(getCellAttributeMatrixName());
+  QList<QString> voxelArrayNames = cellAttrMat->getAttributeArrayNames();
+  for(const auto& dataArrayPath : m_IgnoredDataArrayPaths)
+  {
+    voxelArrayNames.removeAll(dataArrayPath.getDataArrayName());
+  }
+  m_TotalProgress = voxelArrayNames.size();
 
+  // The same map is applied to every array; each array is replaced by its shifted copy
+  CellReindexer reindexer(std::move(newToOld), dims[0] * dims[1]);
+  for(const auto& arrayName : voxelArrayNames)
+  {
+    if(getCancel())
+    {
+      return;
+    }
+    IDataArray::Pointer data = reindexer.reindexArray(cellAttrMat->getAttributeArray(arrayName));
+    if(nullptr == data.get())
+    {
+      QString ss = QObject::tr("The array '%1' could not be shifted").arg(arrayName);
+      setErrorCondition(-3540, ss);
+      return;
+    }
+    cellAttrMat->insertOrAssign(data);
+    updateProgress(1);
+  }
 }
 
 // -----------------------------------------------------------------------------
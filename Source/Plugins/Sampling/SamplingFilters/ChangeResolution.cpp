@@ -46,6 +46,8 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "DREAM3DLib/Utilities/CellReindexer.hpp"
+
 #include "Sampling/SamplingConstants.h"
 #include "Sampling/SamplingVersion.h"
 
@@ -348,7 +350,7 @@ void ChangeResolution::execute()
   size_t index = 0;
   size_t index_old = 0;
   size_t progressInt = 0;
-  std::vector<size_t> newindicies(totalPoints);
+  std::vector<int64_t> newindicies(totalPoints);
   FloatVec3Type res = {0.0f, 0.0f, 0.0f};
   m->getGeometryAs<ImageGeom>()->getSpacing(res);
 
@@ -373,10 +375,14 @@ void ChangeResolution::execute()
         plane = size_t(z / res[2]);
         index_old = (plane * dims[1] * dims[0]) + (row * dims[0]) + col;
         index = (i * m_XP * m_YP) + (j * m_XP) + k;
-        newindicies[index] = index_old;
+        newindicies[index] = static_cast<int64_t>(index_old);
       }
     }
   }
+  if(getCancel())
+  {
+    return;
+  }
 
   QString ss = QObject::tr("Copying Data...");
   notifyStatusMessage(ss);
@@ -385,30 +391,11 @@ void ChangeResolution::execute()
   tDims[0] = m_XP;
   tDims[1] = m_YP;
   tDims[2] = m_ZP;
-  AttributeMatrix::Pointer newCellAttrMat = AttributeMatrix::New(tDims, cellAttrMat->getName(), cellAttrMat->getType());
-
-  QList<QString> voxelArrayNames = cellAttrMat->getAttributeArrayNames();
-  for(QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
+  CellReindexer reindexer(std::move(newindicies), m_XP * m_YP);
+  AttributeMatrix::Pointer newCellAttrMat = reindexer.reindexAttributeMatrix(this, cellAttrMat, tDims);
+  if(nullptr == newCellAttrMat.get())
   {
-    IDataArray::Pointer p = cellAttrMat->getAttributeArray(*iter);
-    // Make a copy of the 'p' array that has the same name. When placed into
-    // the data container this will over write the current array with
-    // the same name. At least in theory.
-    IDataArray::Pointer data = p->createNewArray(p->getNumberOfTuples(), p->getComponentDimensions(), p->getName());
-    data->resizeTuples(totalPoints);
-    void* source = nullptr;
-    void* destination = nullptr;
-    size_t newIndicies_I = 0;
-    int32_t nComp = data->getNumberOfComponents();
-    for(size_t i = 0; i < static_cast<size_t>(totalPoints); i++)
-    {
-      newIndicies_I = newindicies[i];
-      source = p->getVoidPointer((nComp * newIndicies_I));
-      destination = data->getVoidPointer((data->getNumberOfComponents() * i));
-      ::memcpy(destination, source, p->getTypeSize() * data->getNumberOfComponents());
-    }
-    cellAttrMat->removeAttributeArray(*iter);
-    newCellAttrMat->insertOrAssign(data);
+    return;
   }
   m->getGeometryAs<ImageGeom>()->setSpacing(std::make_tuple(m_Spacing[0], m_Spacing[1], m_Spacing[2]));
   m->getGeometryAs<ImageGeom>()->setDimensions(std::make_tuple(m_XP, m_YP, m_ZP));
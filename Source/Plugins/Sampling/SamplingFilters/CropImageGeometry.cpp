@@ -43,12 +43,15 @@
 #include "SIMPLib/FilterParameters/DataContainerCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/IntFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
+#include "SIMPLib/FilterParameters/MultiDataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/PreflightUpdatedValueFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Math/SIMPLibRandom.h"
 
+#include "DREAM3DLib/Utilities/CellReindexer.hpp"
+
 #include "Sampling/SamplingConstants.h"
 #include "Sampling/SamplingVersion.h"
 
@@ -73,6 +76,7 @@ CropImageGeometry::CropImageGeometry()
 , m_RenumberFeatures(false)
 , m_SaveAsNewDataContainer(false)
 , m_UpdateOrigin(true)
+, m_CropSelectedArraysOnly(false)
 , m_FeatureIdsArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::FeatureIds)
 {
   m_OldDimensions[0] = 0, m_OldDimensions[1] = 0;
@@ -113,16 +117,25 @@ void CropImageGeometry::setupFilterParameters()
   parameters.push_back(param);
   
   QStringList linkedProps;
-  linkedProps << "NewDataContainerName";
+  linkedProps << "NewDataContainerName"
+              << "CropSelectedArraysOnly";
   parameters.push_back(SIMPL_NEW_BOOL_FP("Update Origin", UpdateOrigin, FilterParameter::Parameter, CropImageGeometry));
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Save As New Data Container", SaveAsNewDataContainer, FilterParameter::Parameter, CropImageGeometry, linkedProps));
   parameters.push_back(SIMPL_NEW_DC_CREATION_FP("Data Container", NewDataContainerName, FilterParameter::CreatedArray, CropImageGeometry));
+  linkedProps.clear();
+  linkedProps << "SelectedCellArrayPaths";
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Crop Selected Arrays Only", CropSelectedArraysOnly, FilterParameter::Parameter, CropImageGeometry, linkedProps));
 
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::RequiredArray));
   {
     AttributeMatrixSelectionFilterParameter::RequirementType req = AttributeMatrixSelectionFilterParameter::CreateRequirement(AttributeMatrix::Type::Cell, IGeometry::Type::Image);
     parameters.push_back(SIMPL_NEW_AM_SELECTION_FP("Cell Attribute Matrix", CellAttributeMatrixPath, FilterParameter::RequiredArray, CropImageGeometry, req));
   }
+  {
+    MultiDataArraySelectionFilterParameter::RequirementType req =
+        MultiDataArraySelectionFilterParameter::CreateRequirement(SIMPL::Defaults::AnyPrimitive, SIMPL::Defaults::AnyComponentSize, AttributeMatrix::Type::Cell, IGeometry::Type::Image);
+    parameters.push_back(SIMPL_NEW_MDA_SELECTION_FP("Cell Arrays to Crop", SelectedCellArrayPaths, FilterParameter::RequiredArray, CropImageGeometry, req));
+  }
 
   parameters.push_back(SeparatorFilterParameter::New("Renumber Features Parameters", FilterParameter::RequiredArray));
   linkedProps.clear();
@@ -160,6 +173,8 @@ void CropImageGeometry::readFilterParameters(AbstractFilterParametersReader* rea
   setRenumberFeatures(reader->readValue("RenumberFeatures", getRenumberFeatures()));
   setSaveAsNewDataContainer(reader->readValue("SaveAsNewDataContainer", getSaveAsNewDataContainer()));
   setUpdateOrigin(reader->readValue("UpdateOrigin", getUpdateOrigin()));
+  setCropSelectedArraysOnly(reader->readValue("CropSelectedArraysOnly", getCropSelectedArraysOnly()));
+  setSelectedCellArrayPaths(reader->readDataArrayPathVector("SelectedCellArrayPaths", getSelectedCellArrayPaths()));
   reader->closeFilterGroup();
 }
 
@@ -212,6 +227,26 @@ void CropImageGeometry::dataCheck()
     IGeometry::Pointer imageCopy = image->deepCopy();
     destCellDataContainer->setGeometry(imageCopy);
 
+    if(m_CropSelectedArraysOnly)
+    {
+      if(m_SelectedCellArrayPaths.isEmpty())
+      {
+        QString ss = QObject::tr("At least one Cell array must be selected when only the selected arrays are cropped into the new Data Container");
+        setErrorCondition(-5551, ss);
+        return;
+      }
+      for(const auto& path : m_SelectedCellArrayPaths)
+      {
+        if(path.getDataContainerName() != getCellAttributeMatrixPath().getDataContainerName() || path.getAttributeMatrixName() != getCellAttributeMatrixPath().getAttributeMatrixName() ||
+           !srcCellAttrMat->doesAttributeArrayExist(path.getDataArrayName()))
+        {
+          QString ss = QObject::tr("The selected array '%1' is not an array of the Cell Attribute Matrix '%2'").arg(path.serialize("/")).arg(getCellAttributeMatrixPath().serialize("/"));
+          setErrorCondition(-5552, ss);
+          return;
+        }
+      }
+    }
+
     destCellAttrMat = srcCellAttrMat->deepCopy(getInPreflight());
     destCellDataContainer->addOrReplaceAttributeMatrix(destCellAttrMat);
   }
@@ -329,7 +364,7 @@ void CropImageGeometry::dataCheck()
   }
   AttributeMatrix::Pointer newCellAttrMat = AttributeMatrix::New(tDims, destCellAttrMat->getName(), destCellAttrMat->getType());
 
-  QList<QString> voxelArrayNames = destCellAttrMat->getAttributeArrayNames();
+  QList<QString> voxelArrayNames = getCroppedArrayNames(destCellAttrMat);
   for(QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
   {
     IDataArray::Pointer p = destCellAttrMat->getAttributeArray(*iter);
@@ -416,10 +451,7 @@ void CropImageGeometry::execute()
 
     destCellDataContainer->getGeometryAs<ImageGeom>()->setOrigin(o);
     destCellDataContainer->getGeometryAs<ImageGeom>()->setSpacing(r);
-
-    AttributeMatrix::Pointer cellAttrMatCopy = cellAttrMat->deepCopy(false);
-    destCellDataContainer->addOrReplaceAttributeMatrix(cellAttrMatCopy);
-    cellAttrMat = destCellDataContainer->getAttributeMatrix(getCellAttributeMatrixPath().getAttributeMatrixName());
+    // The cell arrays are copied straight into the new DataContainer by the crop below
   }
 
   if(nullptr == destCellDataContainer.get() || nullptr == cellAttrMat.get() || getErrorCode() < 0)
@@ -440,6 +472,16 @@ void CropImageGeometry::execute()
   // Check to see if the dims have actually changed.
   if(dims[0] == (m_XMax - m_XMin) && dims[1] == (m_YMax - m_YMin) && dims[2] == (m_ZMax - m_ZMin))
   {
+    if(m_SaveAsNewDataContainer)
+    {
+      AttributeMatrix::Pointer copiedCellAttrMat = AttributeMatrix::New(cellAttrMat->getTupleDimensions(), cellAttrMat->getName(), cellAttrMat->getType());
+      QList<QString> arrayNames = getCroppedArrayNames(cellAttrMat);
+      for(const auto& arrayName : arrayNames)
+      {
+        copiedCellAttrMat->insertOrAssign(cellAttrMat->getAttributeArray(arrayName)->deepCopy());
+      }
+      destCellDataContainer->addOrReplaceAttributeMatrix(copiedCellAttrMat);
+    }
     return;
   }
 
@@ -482,50 +524,42 @@ void CropImageGeometry::execute()
   int64_t YP = ((m_YMax - m_YMin) + 1);
   int64_t ZP = ((m_ZMax - m_ZMin) + 1);
 
-  int64_t col = 0, row = 0, plane = 0;
-  int64_t colold = 0, rowold = 0, planeold = 0;
-  int64_t index = 0;
-  int64_t index_old = 0;
-  QList<QString> voxelArrayNames = cellAttrMat->getAttributeArrayNames();
+  // Each destination row is one contiguous run of the source row, so the whole crop is done
+  // with one memcpy per row and array
+  std::vector<int64_t> newToOld(static_cast<size_t>(XP * YP * ZP));
   for(int64_t i = 0; i < ZP; i++)
   {
-    if(getCancel())
-    {
-      break;
-    }
-    QString ss = QObject::tr("Cropping Volume || Slice %1 of %2 Complete").arg(i).arg(ZP);
-    notifyStatusMessage(ss);
-    planeold = (i + m_ZMin) * (srcCellDataContainer->getGeometryAs<ImageGeom>()->getXPoints() * srcCellDataContainer->getGeometryAs<ImageGeom>()->getYPoints());
-    plane = (i * XP * YP);
+    int64_t planeold = (i + m_ZMin) * dims[0] * dims[1];
+    int64_t plane = i * XP * YP;
     for(int64_t j = 0; j < YP; j++)
     {
-      rowold = (j + m_YMin) * srcCellDataContainer->getGeometryAs<ImageGeom>()->getXPoints();
-      row = (j * XP);
+      int64_t rowold = (j + m_YMin) * dims[0];
+      int64_t row = j * XP;
       for(int64_t k = 0; k < XP; k++)
       {
-        colold = (k + m_XMin);
-        col = k;
-        index_old = planeold + rowold + colold;
-        index = plane + row + col;
-        for(const auto& arrayName : voxelArrayNames)
-        {
-          IDataArray::Pointer p = cellAttrMat->getAttributeArray(arrayName);
-          p->copyTuple(index_old, index);
-        }
+        newToOld[plane + row + k] = planeold + rowold + k + m_XMin;
       }
     }
   }
-  if(getCancel())
+
+  QString ss = QObject::tr("Cropping Volume...");
+  notifyStatusMessage(ss);
+  QVector<size_t> tDims(3, 0);
+  tDims[0] = XP;
+  tDims[1] = YP;
+  tDims[2] = ZP;
+  CellReindexer reindexer(std::move(newToOld), static_cast<size_t>(XP * YP));
+  // When a new Data Container is created only the arrays it needs are materialized, and the
+  // source arrays are left in place
+  AttributeMatrix::Pointer croppedCellAttrMat = reindexer.reindexAttributeMatrix(this, cellAttrMat, getCroppedArrayNames(cellAttrMat), tDims, !m_SaveAsNewDataContainer);
+  if(nullptr == croppedCellAttrMat.get())
   {
     return;
   }
+  destCellDataContainer->addOrReplaceAttributeMatrix(croppedCellAttrMat);
+  cellAttrMat = croppedCellAttrMat;
   destCellDataContainer->getGeometryAs<ImageGeom>()->setDimensions(static_cast<size_t>(XP), static_cast<size_t>(YP), static_cast<size_t>(ZP));
   totalPoints = destCellDataContainer->getGeometryAs<ImageGeom>()->getNumberOfElements();
-  QVector<size_t> tDims(3, 0);
-  tDims[0] = XP;
-  tDims[1] = YP;
-  tDims[2] = ZP;
-  cellAttrMat->setTupleDimensions(tDims); // THIS WILL CAUSE A RESIZE of all the underlying data arrays.
 
   if(m_RenumberFeatures)
   {
@@ -604,6 +638,32 @@ void CropImageGeometry::execute()
 
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QList<QString> CropImageGeometry::getCroppedArrayNames(const AttributeMatrix::Pointer& cellAttrMat) const
+{
+  if(!m_SaveAsNewDataContainer || !m_CropSelectedArraysOnly)
+  {
+    return cellAttrMat->getAttributeArrayNames();
+  }
+
+  QList<QString> arrayNames;
+  for(const auto& path : m_SelectedCellArrayPaths)
+  {
+    if(!arrayNames.contains(path.getDataArrayName()))
+    {
+      arrayNames.push_back(path.getDataArrayName());
+    }
+  }
+  // Renumbering the Features needs the cropped Feature Ids in the new Data Container
+  if(m_RenumberFeatures && !arrayNames.contains(m_FeatureIdsArrayPath.getDataArrayName()))
+  {
+    arrayNames.push_back(m_FeatureIdsArrayPath.getDataArrayName());
+  }
+  return arrayNames;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -62,6 +62,8 @@ class Sampling_EXPORT CropImageGeometry : public AbstractFilter
     PYB11_PROPERTY(bool RenumberFeatures READ getRenumberFeatures WRITE setRenumberFeatures)
     PYB11_PROPERTY(bool SaveAsNewDataContainer READ getSaveAsNewDataContainer WRITE setSaveAsNewDataContainer)
     PYB11_PROPERTY(bool UpdateOrigin READ getUpdateOrigin WRITE setUpdateOrigin)
+    PYB11_PROPERTY(bool CropSelectedArraysOnly READ getCropSelectedArraysOnly WRITE setCropSelectedArraysOnly)
+    PYB11_PROPERTY(QVector<DataArrayPath> SelectedCellArrayPaths READ getSelectedCellArrayPaths WRITE setSelectedCellArrayPaths)
     PYB11_PROPERTY(DataArrayPath FeatureIdsArrayPath READ getFeatureIdsArrayPath WRITE setFeatureIdsArrayPath)
 public:
   SIMPL_SHARED_POINTERS(CropImageGeometry)
@@ -112,6 +114,12 @@ public:
   SIMPL_FILTER_PARAMETER(bool, UpdateOrigin)
   Q_PROPERTY(bool UpdateOrigin READ getUpdateOrigin WRITE setUpdateOrigin)
 
+  SIMPL_FILTER_PARAMETER(bool, CropSelectedArraysOnly)
+  Q_PROPERTY(bool CropSelectedArraysOnly READ getCropSelectedArraysOnly WRITE setCropSelectedArraysOnly)
+
+  SIMPL_FILTER_PARAMETER(QVector<DataArrayPath>, SelectedCellArrayPaths)
+  Q_PROPERTY(QVector<DataArrayPath> SelectedCellArrayPaths READ getSelectedCellArrayPaths WRITE setSelectedCellArrayPaths)
+
   SIMPL_FILTER_PARAMETER(DataArrayPath, FeatureIdsArrayPath)
   Q_PROPERTY(DataArrayPath FeatureIdsArrayPath READ getFeatureIdsArrayPath WRITE setFeatureIdsArrayPath)
 
@@ -222,6 +230,15 @@ protected:
    */
   void initialize();
 
+  /**
+   * @brief getCroppedArrayNames Returns the names of the Cell arrays that end up in the cropped
+   * volume: every array of the Cell Attribute Matrix, unless a new Data Container is created from
+   * the selected arrays only
+   * @param cellAttrMat Source Cell Attribute Matrix
+   * @return Names of the arrays to crop
+   */
+  QList<QString> getCroppedArrayNames(const AttributeMatrix::Pointer& cellAttrMat) const;
+
 private:
   DEFINE_DATAARRAY_VARIABLE(int32_t, FeatureIds)
 
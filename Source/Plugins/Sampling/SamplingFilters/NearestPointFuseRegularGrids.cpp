@@ -42,6 +42,8 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "DREAM3DLib/Utilities/CellReindexer.hpp"
+
 #include "Sampling/SamplingConstants.h"
 #include "Sampling/SamplingVersion.h"
 
@@ -252,17 +254,8 @@ void NearestPointFuseRegularGrids::execute()
   int64_t sampleIndex = 0;
   int64_t planeComp = 0, rowComp = 0;
 
-  // Create arrays on the reference grid to hold data present on the sampling grid
-  QList<QString> voxelArrayNames = sampleAttrMat->getAttributeArrayNames();
-  for(QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
-  {
-    IDataArray::Pointer p = sampleAttrMat->getAttributeArray(*iter);
-    // Make a copy of the 'p' array that has the same name. When placed into
-    // the data container this will over write the current array with
-    // the same name. At least in theory
-    IDataArray::Pointer data = p->createNewArray(numRefTuples, p->getComponentDimensions(), p->getName());
-    refAttrMat->insertOrAssign(data);
-  }
+  // Reference cells that fall outside of the sampling grid have no source and are zero filled
+  std::vector<int64_t> refToSample(static_cast<size_t>(numRefTuples), -1);
 
   bool outside = false;
   for(int64_t i = 0; i < refDims[2]; i++)
@@ -309,26 +302,31 @@ void NearestPointFuseRegularGrids::execute()
         {
           sampleIndex = (plane * sampleDims[0] * sampleDims[1]) + (row * sampleDims[0]) + col;
           refIndex = planeComp + rowComp + k;
-          for(QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
-          {
-            IDataArray::Pointer p = sampleAttrMat->getAttributeArray(*iter);
-            // Make a copy of the 'p' array that has the same name. When placed into
-            // the data container this will over write the current array with
-            // the same name. At least in theory
-            IDataArray::Pointer data = refAttrMat->getAttributeArray(*iter);
-            void* source = nullptr;
-            void* destination = nullptr;
-            int nComp = data->getNumberOfComponents();
-
-            source = p->getVoidPointer((nComp * sampleIndex));
-            destination = data->getVoidPointer((nComp * refIndex));
-            ::memcpy(destination, source, p->getTypeSize() * nComp);
-          }
+          refToSample[refIndex] = sampleIndex;
         }
       }
     }
   }
 
+  // Create arrays on the reference grid to hold data present on the sampling grid
+  CellReindexer reindexer(std::move(refToSample), static_cast<size_t>(refDims[0] * refDims[1]));
+  QList<QString> voxelArrayNames = sampleAttrMat->getAttributeArrayNames();
+  for(const auto& arrayName : voxelArrayNames)
+  {
+    if(getCancel())
+    {
+      return;
+    }
+    IDataArray::Pointer data = reindexer.reindexArray(sampleAttrMat->getAttributeArray(arrayName));
+    if(nullptr == data.get())
+    {
+      QString ss = QObject::tr("The array '%1' could not be copied to the reference grid").arg(arrayName);
+      setErrorCondition(-5556, ss);
+      return;
+    }
+    refAttrMat->insertOrAssign(data);
+  }
+
 }
 
 // -----------------------------------------------------------------------------
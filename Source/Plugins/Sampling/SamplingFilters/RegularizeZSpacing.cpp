@@ -45,6 +45,8 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "DREAM3DLib/Utilities/CellReindexer.hpp"
+
 #include "Sampling/SamplingConstants.h"
 #include "Sampling/SamplingVersion.h"
 
@@ -213,7 +215,7 @@ void RegularizeZSpacing::execute()
 
   size_t index = 0, oldindex = 0;
   size_t plane = 0;
-  std::vector<size_t> newindicies(totalPoints, 0);
+  std::vector<int64_t> newindicies(totalPoints, 0);
   for(size_t i = 0; i < m_ZP; i++)
   {
     plane = 0;
@@ -230,7 +232,7 @@ void RegularizeZSpacing::execute()
       {
         oldindex = (plane * dims[0] * dims[1]) + (j * dims[0]) + k;
         index = (i * dims[0] * dims[1]) + (j * dims[0]) + k;
-        newindicies[index] = oldindex;
+        newindicies[index] = static_cast<int64_t>(oldindex);
       }
     }
   }
@@ -240,31 +242,12 @@ void RegularizeZSpacing::execute()
   tDims[0] = m_XP;
   tDims[1] = m_YP;
   tDims[2] = m_ZP;
-  AttributeMatrix::Pointer newCellAttrMat = AttributeMatrix::New(tDims, cellAttrMat->getName(), cellAttrMat->getType());
-
-  QList<QString> voxelArrayNames = cellAttrMat->getAttributeArrayNames();
-  for(QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
+  // Every new plane copies a whole old plane, which the reindexer turns into a single memcpy
+  CellReindexer reindexer(std::move(newindicies), m_XP * m_YP);
+  AttributeMatrix::Pointer newCellAttrMat = reindexer.reindexAttributeMatrix(this, cellAttrMat, tDims);
+  if(nullptr == newCellAttrMat.get())
   {
-    IDataArray::Pointer p = cellAttrMat->getAttributeArray(*iter);
-    // Make a copy of the 'p' array that has the same name. When placed into
-    // the data container this will over write the current array with
-    // the same name. At least in theory
-    IDataArray::Pointer data = p->createNewArray(p->getNumberOfTuples(), p->getComponentDimensions(), p->getName());
-    data->resizeTuples(totalPoints);
-    void* source = nullptr;
-    void* destination = nullptr;
-    size_t newIndicies_I = 0;
-    int nComp = data->getNumberOfComponents();
-    for(size_t i = 0; i < static_cast<size_t>(totalPoints); i++)
-    {
-      newIndicies_I = newindicies[i];
-
-      source = p->getVoidPointer((nComp * newIndicies_I));
-      destination = data->getVoidPointer((data->getNumberOfComponents() * i));
-      ::memcpy(destination, source, p->getTypeSize() * data->getNumberOfComponents());
-    }
-    cellAttrMat->removeAttributeArray(*iter);
-    newCellAttrMat->insertOrAssign(data);
+    return;
   }
   m->getGeometryAs<ImageGeom>()->setSpacing(std::make_tuple(xRes, yRes, m_NewZRes));
   m->getGeometryAs<ImageGeom>()->setDimensions(std::make_tuple(m_XP, m_YP, m_ZP));
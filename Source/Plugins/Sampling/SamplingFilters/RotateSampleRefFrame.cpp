@@ -53,6 +53,8 @@
 
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 
+#include "DREAM3DLib/Utilities/CellReindexer.hpp"
+
 #include "Sampling/SamplingConstants.h"
 #include "Sampling/SamplingVersion.h"
 
@@ -83,14 +85,14 @@ typedef struct
 class RotateSampleRefFrameImpl
 {
 
-  DataArray<int64_t>::Pointer newIndicesPtr;
+  int64_t* m_NewIndicies;
   float rotMatrixInv[3][3];
   bool m_SliceBySlice;
   RotateSampleRefFrameImplArg_t* m_params;
 
 public:
-  RotateSampleRefFrameImpl(DataArray<int64_t>::Pointer newindices, RotateSampleRefFrameImplArg_t* args, float rotMat[3][3], bool sliceBySlice)
-  : newIndicesPtr(newindices)
+  RotateSampleRefFrameImpl(int64_t* newindices, RotateSampleRefFrameImplArg_t* args, float rotMat[3][3], bool sliceBySlice)
+  : m_NewIndicies(newindices)
   , m_SliceBySlice(sliceBySlice)
   , m_params(args)
   {
@@ -110,7 +112,7 @@ public:
   void convert(int64_t zStart, int64_t zEnd, int64_t yStart, int64_t yEnd, int64_t xStart, int64_t xEnd) const
   {
 
-    int64_t* newindicies = newIndicesPtr->getPointer(0);
+    int64_t* newindicies = m_NewIndicies;
     int64_t index = 0;
     int64_t ktot = 0, jtot = 0;
     //      float rotMatrixInv[3][3];
@@ -581,85 +583,39 @@ void RotateSampleRefFrame::execute()
 
   int64_t newNumCellTuples = params.xpNew * params.ypNew * params.zpNew;
 
-  DataArray<int64_t>::Pointer newIndiciesPtr = DataArray<int64_t>::CreateArray(newNumCellTuples, "_INTERNAL_USE_ONLY_RotateSampleRef_NewIndicies");
-  newIndiciesPtr->initializeWithValue(-1);
-  int64_t* newindicies = newIndiciesPtr->getPointer(0);
+  std::vector<int64_t> newindicies(newNumCellTuples, -1);
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
   tbb::task_scheduler_init init;
-  bool doParallel = false;
+  bool doParallel = true;
 #endif
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
   if(doParallel)
   {
-    tbb::parallel_for(tbb::blocked_range3d<int64_t, int64_t, int64_t>(0, params.zpNew, 0, params.ypNew, 0, params.xpNew), RotateSampleRefFrameImpl(newIndiciesPtr, &params, rotMat, m_SliceBySlice),
+    tbb::parallel_for(tbb::blocked_range3d<int64_t, int64_t, int64_t>(0, params.zpNew, 0, params.ypNew, 0, params.xpNew), RotateSampleRefFrameImpl(newindicies.data(), &params, rotMat, m_SliceBySlice),
                       tbb::auto_partitioner());
   }
   else
 #endif
   {
-    RotateSampleRefFrameImpl serial(newIndiciesPtr, &params, rotMat, m_SliceBySlice);
+    RotateSampleRefFrameImpl serial(newindicies.data(), &params, rotMat, m_SliceBySlice);
     serial.convert(0, params.zpNew, 0, params.ypNew, 0, params.xpNew);
   }
 
-  // This could technically be parallelized also where each thread takes an array to adjust. Except
-  // that the DataContainer is NOT thread safe or re-entrant so that would actually be a BAD idea.
+  // One map is applied to every cell array; each new array is built from the untouched old one
   QString attrMatName = getCellAttributeMatrixPath().getAttributeMatrixName();
-  QList<QString> voxelArrayNames = m->getAttributeMatrix(attrMatName)->getAttributeArrayNames();
-
-  // resize attribute matrix
   QVector<size_t> tDims(3);
   tDims[0] = params.xpNew;
   tDims[1] = params.ypNew;
   tDims[2] = params.zpNew;
-  m->getAttributeMatrix(attrMatName)->resizeAttributeArrays(tDims);
-
-  for(const auto& attrArrayName : voxelArrayNames)
+  CellReindexer reindexer(std::move(newindicies), static_cast<size_t>(params.xpNew * params.ypNew));
+  AttributeMatrix::Pointer newCellAttrMat = reindexer.reindexAttributeMatrix(this, m->getAttributeMatrix(attrMatName), tDims);
+  if(nullptr == newCellAttrMat.get())
   {
-    IDataArray::Pointer p = m->getAttributeMatrix(attrMatName)->getAttributeArray(attrArrayName);
-    // Make a copy of the 'p' array that has the same name. When placed into
-    // the data container this will over write the current array with
-    // the same name.
-    IDataArray::Pointer data = p->createNewArray(newNumCellTuples, p->getComponentDimensions(), p->getName());
-    //    void* source = nullptr;
-    //    void* destination = nullptr;
-    int64_t newIndicies_I = 0;
-    //   int32_t nComp = data->getNumberOfComponents();
-    for(size_t i = 0; i < static_cast<size_t>(newNumCellTuples); i++)
-    {
-      newIndicies_I = newindicies[i];
-      if(newIndicies_I >= 0)
-      {
-        //        source = p->getVoidPointer((nComp * newIndicies_I));
-        //        if(nullptr == source)
-        //        {
-        //          QString ss = QObject::tr("The index is outside the bounds of the source array");
-        //          setErrorCondition(-11004);
-        //          notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
-        //          return;
-        //        }
-        //        destination = data->getVoidPointer((data->getNumberOfComponents() * i));
-        //        ::memcpy(destination, source, p->getTypeSize() * data->getNumberOfComponents());
-
-        if(!data->copyFromArray(i, p, newIndicies_I, 1))
-        {
-          QString ss = QObject::tr("copyFromArray Failed: ");
-          QTextStream out(&ss);
-          out << "Source Array Name: " << p->getName() << " Source Tuple Index: " << newIndicies_I << "\n";
-          out << "Dest Array Name: " << data->getName() << "  Dest. Tuple Index: " << i << "\n";
-          setErrorCondition(-11004, ss);
-          return;
-        }
-      }
-      else
-      {
-        int var = 0;
-        data->initializeTuple(i, &var);
-      }
-    }
-    m->getAttributeMatrix(attrMatName)->insertOrAssign(data);
+    return;
   }
+  m->addOrReplaceAttributeMatrix(newCellAttrMat);
   m->getGeometryAs<ImageGeom>()->setSpacing(FloatVec3Type(params.xResNew, params.yResNew, params.zResNew));
   m->getGeometryAs<ImageGeom>()->setDimensions(params.xpNew, params.ypNew, params.zpNew);
   m->getGeometryAs<ImageGeom>()->setOrigin(FloatVec3Type(xMin, yMin, zMin));
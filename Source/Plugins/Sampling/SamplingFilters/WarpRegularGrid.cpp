@@ -48,6 +48,8 @@
 #include "SIMPLib/FilterParameters/ThirdOrderPolynomialFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "DREAM3DLib/Utilities/CellReindexer.hpp"
+
 #include "Sampling/SamplingConstants.h"
 #include "Sampling/SamplingVersion.h"
 
@@ -236,7 +238,6 @@ void WarpRegularGrid::execute()
   }
 
   AttributeMatrix::Pointer cellAttrMat = m->getAttributeMatrix(getCellAttributeMatrixPath().getAttributeMatrixName());
-  AttributeMatrix::Pointer newCellAttrMat = cellAttrMat->deepCopy(false);
 
   size_t dims[3] = {0, 0, 0};
   std::tie(dims[0], dims[1], dims[2]) = m->getGeometryAs<ImageGeom>()->getDimensions();
@@ -249,8 +250,7 @@ void WarpRegularGrid::execute()
   int col = 0.0f, row = 0.0f, plane = 0.0f;
   size_t index;
   size_t index_old;
-  std::vector<size_t> newindicies(totalPoints);
-  std::vector<bool> goodPoint(totalPoints, true);
+  std::vector<int64_t> newindicies(totalPoints);
 
   for(size_t i = 0; i < dims[2]; i++)
   {
@@ -271,50 +271,24 @@ void WarpRegularGrid::execute()
         plane = i;
 
         index_old = (plane * dims[0] * dims[1]) + (row * dims[0]) + col;
-        newindicies[index] = index_old;
+        // Points warped outside of the grid have no source and are zero filled
         if(col > 0 && col < dims[0] && row > 0 && row < dims[1])
         {
-          goodPoint[index] = true;
+          newindicies[index] = static_cast<int64_t>(index_old);
         }
         else
         {
-          goodPoint[index] = false;
+          newindicies[index] = -1;
         }
       }
     }
   }
 
-  QList<QString> voxelArrayNames = cellAttrMat->getAttributeArrayNames();
-  for(QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
+  CellReindexer reindexer(std::move(newindicies), dims[0] * dims[1]);
+  AttributeMatrix::Pointer newCellAttrMat = reindexer.reindexAttributeMatrix(this, cellAttrMat, cellAttrMat->getTupleDimensions());
+  if(nullptr == newCellAttrMat.get())
   {
-    IDataArray::Pointer p = cellAttrMat->getAttributeArray(*iter);
-    // Make a copy of the 'p' array that has the same name. When placed into
-    // the data container this will over write the current array with
-    // the same name. At least in theory
-    IDataArray::Pointer data = p->createNewArray(p->getNumberOfTuples(), p->getComponentDimensions(), p->getName());
-    data->resizeTuples(totalPoints);
-    void* source = nullptr;
-    void* destination = nullptr;
-    size_t newIndicies_I = 0;
-    int nComp = data->getNumberOfComponents();
-    for(size_t i = 0; i < static_cast<size_t>(totalPoints); i++)
-    {
-      newIndicies_I = newindicies[i];
-
-      if(goodPoint[i])
-      {
-        source = p->getVoidPointer((nComp * newIndicies_I));
-        destination = data->getVoidPointer((data->getNumberOfComponents() * i));
-        ::memcpy(destination, source, p->getTypeSize() * data->getNumberOfComponents());
-      }
-      else
-      {
-        int var = 0;
-        data->initializeTuple(i, &var);
-      }
-    }
-    cellAttrMat->removeAttributeArray(*iter);
-    newCellAttrMat->insertOrAssign(data);
+    return;
   }
   m->removeAttributeMatrix(getCellAttributeMatrixPath().getAttributeMatrixName());
   m->addOrReplaceAttributeMatrix(newCellAttrMat);
@@ -0,0 +1,291 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/StringDataArray.h"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "DREAM3DLib/Utilities/CellReindexer.hpp"
+
+#include "SamplingTestFileLocations.h"
+
+class CellReindexerTest
+{
+public:
+  CellReindexerTest() = default;
+  ~CellReindexerTest() = default;
+
+  SIMPL_TYPE_MACRO(CellReindexerTest)
+  CellReindexerTest(const CellReindexerTest&) = delete;            // Copy Constructor Not Implemented
+  CellReindexerTest(CellReindexerTest&&) = delete;                 // Move Constructor Not Implemented
+  CellReindexerTest& operator=(const CellReindexerTest&) = delete; // Copy Assignment Not Implemented
+  CellReindexerTest& operator=(CellReindexerTest&&) = delete;      // Move Assignment Not Implemented
+
+  // Dimensions of the source volume
+  const int64_t m_XDim = 37;
+  const int64_t m_YDim = 23;
+  const int64_t m_ZDim = 11;
+
+  enum class MapType
+  {
+    Crop,
+    Rotate,
+    Shift,
+    Scattered
+  };
+
+  // -----------------------------------------------------------------------------
+  // Builds the new to old map of one of the resampling operations the filters perform.
+  // The destination dimensions are returned in newDims.
+  // -----------------------------------------------------------------------------
+  std::vector<int64_t> createMap(MapType type, int64_t newDims[3])
+  {
+    std::vector<int64_t> newToOld;
+    switch(type)
+    {
+    case MapType::Crop:
+      // A sub volume, as CropImageGeometry extracts it
+      newDims[0] = 20;
+      newDims[1] = 15;
+      newDims[2] = 7;
+      for(int64_t z = 0; z < newDims[2]; z++)
+      {
+        for(int64_t y = 0; y < newDims[1]; y++)
+        {
+          for(int64_t x = 0; x < newDims[0]; x++)
+          {
+            newToOld.push_back(((z + 2) * m_YDim + y + 3) * m_XDim + x + 5);
+          }
+        }
+      }
+      break;
+    case MapType::Rotate:
+      // A 90 degree rotation about Z, as RotateSampleRefFrame builds it, so every row of the
+      // destination walks a column of the source
+      newDims[0] = m_YDim;
+      newDims[1] = m_XDim;
+      newDims[2] = m_ZDim;
+      for(int64_t z = 0; z < newDims[2]; z++)
+      {
+        for(int64_t y = 0; y < newDims[1]; y++)
+        {
+          for(int64_t x = 0; x < newDims[0]; x++)
+          {
+            newToOld.push_back((z * m_YDim + (m_YDim - 1 - x)) * m_XDim + y);
+          }
+        }
+      }
+      break;
+    case MapType::Shift:
+      // An in plane shift of every slice, as AlignSections applies it. Cells shifted in
+      // from outside the volume have no source and must be zero filled
+      newDims[0] = m_XDim;
+      newDims[1] = m_YDim;
+      newDims[2] = m_ZDim;
+      for(int64_t z = 0; z < newDims[2]; z++)
+      {
+        int64_t xShift = (z % 5) - 2;
+        int64_t yShift = (z % 3) - 1;
+        for(int64_t y = 0; y < newDims[1]; y++)
+        {
+          for(int64_t x = 0; x < newDims[0]; x++)
+          {
+            int64_t oldX = x + xShift;
+            int64_t oldY = y + yShift;
+            if(oldX < 0 || oldX >= m_XDim || oldY < 0 || oldY >= m_YDim)
+            {
+              newToOld.push_back(-1);
+            }
+            else
+            {
+              newToOld.push_back((z * m_YDim + oldY) * m_XDim + oldX);
+            }
+          }
+        }
+      }
+      break;
+    case MapType::Scattered:
+      // A map without runs, as a resolution change or warp produces, which takes the gather path
+      newDims[0] = 19;
+      newDims[1] = 17;
+      newDims[2] = 13;
+      for(int64_t t = 0; t < newDims[0] * newDims[1] * newDims[2]; t++)
+      {
+        newToOld.push_back(t % 9 == 0 ? -1 : (t * 7919) % (m_XDim * m_YDim * m_ZDim));
+      }
+      break;
+    }
+    return newToOld;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T> typename DataArray<T>::Pointer createArray(const QString& name, const QVector<size_t>& cDims)
+  {
+    size_t numTuples = static_cast<size_t>(m_XDim * m_YDim * m_ZDim);
+    typename DataArray<T>::Pointer data = DataArray<T>::CreateArray(numTuples, cDims, name);
+    for(size_t i = 0; i < data->getSize(); i++)
+    {
+      data->setValue(i, static_cast<T>((i * 31 + 7) % 251));
+    }
+    return data;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T> int checkArray(const typename DataArray<T>::Pointer& source, const IDataArray::Pointer& result, const std::vector<int64_t>& newToOld)
+  {
+    typename DataArray<T>::Pointer dest = std::dynamic_pointer_cast<DataArray<T>>(result);
+    DREAM3D_REQUIRE_VALID_POINTER(dest.get())
+    DREAM3D_REQUIRE_EQUAL(dest->getNumberOfTuples(), newToOld.size())
+    DREAM3D_REQUIRE_EQUAL(dest->getNumberOfComponents(), source->getNumberOfComponents())
+    size_t numComps = static_cast<size_t>(source->getNumberOfComponents());
+    for(size_t t = 0; t < newToOld.size(); t++)
+    {
+      for(size_t c = 0; c < numComps; c++)
+      {
+        T expected = newToOld[t] < 0 ? static_cast<T>(0) : source->getComponent(static_cast<size_t>(newToOld[t]), static_cast<int>(c));
+        DREAM3D_REQUIRE_EQUAL(dest->getComponent(t, static_cast<int>(c)), expected)
+      }
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestReindexAttributeMatrix(MapType type)
+  {
+    int64_t newDims[3] = {0, 0, 0};
+    std::vector<int64_t> newToOld = createMap(type, newDims);
+    CellReindexer reindexer(newToOld, static_cast<size_t>(newDims[0] * newDims[1]));
+    DREAM3D_REQUIRE_EQUAL(reindexer.getNumberOfTuples(), newToOld.size())
+
+    QVector<size_t> tDims = {static_cast<size_t>(m_XDim), static_cast<size_t>(m_YDim), static_cast<size_t>(m_ZDim)};
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+
+    FloatArrayType::Pointer floats = createArray<float>("Floats", QVector<size_t>(1, 3));
+    Int32ArrayType::Pointer ints = createArray<int32_t>("Ints", QVector<size_t>(1, 1));
+    DoubleArrayType::Pointer doubles = createArray<double>("Doubles", QVector<size_t>{2, 3});
+    UInt8ArrayType::Pointer bytes = createArray<uint8_t>("Bytes", QVector<size_t>(1, 4));
+    Int16ArrayType::Pointer shorts = createArray<int16_t>("Shorts", QVector<size_t>(1, 1));
+    StringDataArray::Pointer strings = StringDataArray::CreateArray(cellAttrMat->getNumberOfTuples(), "Strings");
+    for(size_t t = 0; t < strings->getNumberOfTuples(); t++)
+    {
+      strings->setValue(t, QString::number(t));
+    }
+    cellAttrMat->insertOrAssign(floats);
+    cellAttrMat->insertOrAssign(ints);
+    cellAttrMat->insertOrAssign(doubles);
+    cellAttrMat->insertOrAssign(bytes);
+    cellAttrMat->insertOrAssign(shorts);
+    cellAttrMat->insertOrAssign(strings);
+
+    QString filtName = "CropImageGeometry";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName(filtName);
+    DREAM3D_REQUIRE(factory.get() != nullptr)
+    AbstractFilter::Pointer filter = factory->create();
+    DREAM3D_REQUIRE(filter.get() != nullptr)
+
+    QVector<size_t> newTDims = {static_cast<size_t>(newDims[0]), static_cast<size_t>(newDims[1]), static_cast<size_t>(newDims[2])};
+
+    // Copying only some arrays and keeping the sources must leave the source matrix intact
+    QList<QString> someNames = {"Floats", "Strings"};
+    AttributeMatrix::Pointer partial = reindexer.reindexAttributeMatrix(filter.get(), cellAttrMat, someNames, newTDims, false);
+    DREAM3D_REQUIRE_VALID_POINTER(partial.get())
+    DREAM3D_REQUIRE_EQUAL(partial->getNumAttributeArrays(), 2)
+    DREAM3D_REQUIRE_EQUAL(cellAttrMat->getNumAttributeArrays(), 6)
+    DREAM3D_REQUIRE_EQUAL(checkArray<float>(floats, partial->getAttributeArray("Floats"), newToOld), EXIT_SUCCESS)
+
+    // A name that is not in the source matrix is an error, not a crash
+    QList<QString> missingNames = {"Floats", "Missing"};
+    AttributeMatrix::Pointer missing = reindexer.reindexAttributeMatrix(filter.get(), cellAttrMat, missingNames, newTDims, false);
+    DREAM3D_REQUIRE(nullptr == missing.get())
+    DREAM3D_REQUIRE(filter->getErrorCode() < 0)
+    DREAM3D_REQUIRE_EQUAL(cellAttrMat->getNumAttributeArrays(), 6)
+    filter->clearErrorCode();
+
+    AttributeMatrix::Pointer reindexed = reindexer.reindexAttributeMatrix(filter.get(), cellAttrMat, newTDims);
+    DREAM3D_REQUIRE_VALID_POINTER(reindexed.get())
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0)
+    DREAM3D_REQUIRE_EQUAL(cellAttrMat->getNumAttributeArrays(), 0)
+    DREAM3D_REQUIRE_EQUAL(reindexed->getNumAttributeArrays(), 6)
+    DREAM3D_REQUIRE_EQUAL(reindexed->getNumberOfTuples(), newToOld.size())
+    DREAM3D_REQUIRE(reindexed->getType() == AttributeMatrix::Type::Cell)
+
+    DREAM3D_REQUIRE_EQUAL(checkArray<float>(floats, reindexed->getAttributeArray("Floats"), newToOld), EXIT_SUCCESS)
+    DREAM3D_REQUIRE_EQUAL(checkArray<int32_t>(ints, reindexed->getAttributeArray("Ints"), newToOld), EXIT_SUCCESS)
+    DREAM3D_REQUIRE_EQUAL(checkArray<double>(doubles, reindexed->getAttributeArray("Doubles"), newToOld), EXIT_SUCCESS)
+    DREAM3D_REQUIRE_EQUAL(checkArray<uint8_t>(bytes, reindexed->getAttributeArray("Bytes"), newToOld), EXIT_SUCCESS)
+    DREAM3D_REQUIRE_EQUAL(checkArray<int16_t>(shorts, reindexed->getAttributeArray("Shorts"), newToOld), EXIT_SUCCESS)
+
+    // Strings are not plain numeric data and go through the per tuple copy
+    StringDataArray::Pointer newStrings = reindexed->getAttributeArrayAs<StringDataArray>("Strings");
+    DREAM3D_REQUIRE_VALID_POINTER(newStrings.get())
+    for(size_t t = 0; t < newToOld.size(); t++)
+    {
+      QString expected = newToOld[t] < 0 ? QString() : QString::number(newToOld[t]);
+      DREAM3D_REQUIRE(newStrings->getValue(t) == expected)
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "---- " << getNameOfClass().toStdString() << " ----" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestReindexAttributeMatrix(MapType::Crop))
+    DREAM3D_REGISTER_TEST(TestReindexAttributeMatrix(MapType::Rotate))
+    DREAM3D_REGISTER_TEST(TestReindexAttributeMatrix(MapType::Shift))
+    DREAM3D_REGISTER_TEST(TestReindexAttributeMatrix(MapType::Scattered))
+  }
+};
@@ -976,6 +976,74 @@ public:
     checkRenumber<int32_t, int32_t>(data, s_CroppedX, s_CroppedY, s_CroppedZ);
   }
 
+  // -----------------------------------------------------------------------------
+  // Crop only a selection of the cell arrays into a new DataContainer. The cropped arrays
+  // must match the full crop, and the source arrays must be left as they were.
+  // -----------------------------------------------------------------------------
+  void TestCropVolume_5()
+  {
+    // Setup Data Structure
+    bool renumberGrains = true;
+    bool createNewDataContainer = true;
+    AbstractFilter::Pointer cropVolume = CreateCropVolumeFilter(s_CroppedX, s_CroppedY, s_CroppedZ, renumberGrains, createNewDataContainer);
+
+    QVariant var;
+    var.setValue(true);
+    bool propWasSet = cropVolume->setProperty("CropSelectedArraysOnly", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true);
+
+    // Selecting nothing is an error
+    var.setValue(QVector<DataArrayPath>());
+    propWasSet = cropVolume->setProperty("SelectedCellArrayPaths", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true);
+    cropVolume->preflight();
+    DREAM3D_REQUIRE_EQUAL(cropVolume->getErrorCode(), -5551)
+    resetTest(cropVolume, s_OriginalX, s_OriginalY, s_OriginalZ, 1);
+
+    QVector<DataArrayPath> selectedPaths(1, DataArrayPath(k_DataContainerName, k_CellAttributeMatrixName, k_4CompDataArrayName));
+    var.setValue(selectedPaths);
+    propWasSet = cropVolume->setProperty("SelectedCellArrayPaths", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true);
+
+    int err = 0;
+    cropVolume->preflight();
+    err = cropVolume->getErrorCode();
+    require_equal<int, int>(err, "err", 0, "Value", __FILE__, __LINE__);
+
+    resetTest(cropVolume, s_OriginalX, s_OriginalY, s_OriginalZ, 1);
+    cropVolume->execute();
+    err = cropVolume->getErrorCode();
+    require_greater_than<int, int>(err, "err", -1, "Value");
+
+    // The selected array is cropped exactly as a full crop would
+    DataArrayPath dap(k_NewDataContainerName, k_CellAttributeMatrixName, k_4CompDataArrayName);
+    UInt8ArrayType::Pointer four = cropVolume->getDataContainerArray()->getPrereqIDataArrayFromPath<UInt8ArrayType>(cropVolume.get(), dap);
+    DREAM3D_REQUIRE_VALID_POINTER(four.get());
+    checkCrop<uint8_t, uint8_t>(four, s_CroppedX, s_CroppedY, s_CroppedZ);
+
+    // The Feature Ids are added because the Features are renumbered
+    dap.setDataArrayName(k_FeatureIdsName);
+    Int32ArrayType::Pointer data = cropVolume->getDataContainerArray()->getPrereqIDataArrayFromPath<Int32ArrayType>(cropVolume.get(), dap);
+    DREAM3D_REQUIRE_VALID_POINTER(data.get());
+    checkRenumber<int32_t, int32_t>(data, s_CroppedX, s_CroppedY, s_CroppedZ);
+
+    // The unselected array is not copied into the new DataContainer
+    AttributeMatrix::Pointer newCellAttrMat = cropVolume->getDataContainerArray()->getDataContainer(k_NewDataContainerName)->getAttributeMatrix(k_CellAttributeMatrixName);
+    DREAM3D_REQUIRE_VALID_POINTER(newCellAttrMat.get());
+    DREAM3D_REQUIRE_EQUAL(newCellAttrMat->doesAttributeArrayExist(k_DataArrayName), false)
+    DREAM3D_REQUIRE_EQUAL(newCellAttrMat->getNumAttributeArrays(), 2)
+
+    // The source volume keeps every array at its original size
+    AttributeMatrix::Pointer srcCellAttrMat = cropVolume->getDataContainerArray()->getDataContainer(k_DataContainerName)->getAttributeMatrix(k_CellAttributeMatrixName);
+    DREAM3D_REQUIRE_VALID_POINTER(srcCellAttrMat.get());
+    size_t numOriginalTuples = static_cast<size_t>(s_OriginalX.getMax() * s_OriginalY.getMax() * s_OriginalZ.getMax());
+    DREAM3D_REQUIRE_EQUAL(srcCellAttrMat->getNumAttributeArrays(), 3)
+    for(const QString& name : srcCellAttrMat->getAttributeArrayNames())
+    {
+      DREAM3D_REQUIRE_EQUAL(srcCellAttrMat->getAttributeArray(name)->getNumberOfTuples(), numOriginalTuples)
+    }
+  }
+
   /**
 * @brief
 */
@@ -987,6 +1055,7 @@ public:
     DREAM3D_REGISTER_TEST(TestCropVolume_2());
     DREAM3D_REGISTER_TEST(TestCropVolume_3());
     DREAM3D_REGISTER_TEST(TestCropVolume_4());
+    DREAM3D_REGISTER_TEST(TestCropVolume_5());
   }
 
 private:
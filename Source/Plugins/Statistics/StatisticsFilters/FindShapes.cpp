@@ -45,6 +45,8 @@
 
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 
+#include "DREAM3DLib/Utilities/FeatureMoments.hpp"
+
 #include "Statistics/StatisticsConstants.h"
 #include "Statistics/StatisticsVersion.h"
 
@@ -235,7 +237,6 @@ void FindShapes::find_moments()
   float u110 = 0.0f;
   float u011 = 0.0f;
   float u101 = 0.0f;
-  float xx = 0.0f, yy = 0.0f, zz = 0.0f, xy = 0.0f, xz = 0.0f, yz = 0.0f;
 
   size_t xPoints = imageGeom->getXPoints();
   size_t yPoints = imageGeom->getYPoints();
@@ -258,89 +259,38 @@ void FindShapes::find_moments()
 
   size_t numfeatures = m_CentroidsPtr.lock()->getNumberOfTuples();
 
+  size_t dims[3] = {xPoints, yPoints, zPoints};
+  double origin[3] = {xOrigin, yOrigin, zOrigin};
+  double spacing[3] = {xRes, yRes, zRes};
+  FeatureMoments moments;
+  moments.compute(m_FeatureIds, numfeatures, dims, origin, spacing, FeatureMoments::Order::SecondMoments);
+
+  // Each voxel is broken into 8 smaller voxels offset by a quarter of the (scaled) resolution from
+  // its corner point. Summed over the 8 sub voxels the cross terms of the offsets cancel, so the
+  // moments about the supplied centroid follow from the centered moments of the Feature, the
+  // distance between its mean and the centroid, and a constant per voxel for the offsets
+  double scale = m_ScaleFactor;
+  double scale2 = scale * scale;
+  double hx2 = static_cast<double>(modXRes / 4.0f) * static_cast<double>(modXRes / 4.0f);
+  double hy2 = static_cast<double>(modYRes / 4.0f) * static_cast<double>(modYRes / 4.0f);
+  double hz2 = static_cast<double>(modZRes / 4.0f) * static_cast<double>(modZRes / 4.0f);
   for(size_t i = 0; i < numfeatures; i++)
   {
-    m_FeatureMoments[6 * i + 0] = 0.0;
-    m_FeatureMoments[6 * i + 1] = 0.0;
-    m_FeatureMoments[6 * i + 2] = 0.0;
-    m_FeatureMoments[6 * i + 3] = 0.0;
-    m_FeatureMoments[6 * i + 4] = 0.0;
-    m_FeatureMoments[6 * i + 5] = 0.0;
-  }
-
-  float x = 0.0f, y = 0.0f, z = 0.0f, x1 = 0.0f, x2 = 0.0f, y1 = 0.0f, y2 = 0.0f, z1 = 0.0f, z2 = 0.0f;
-  float xdist1 = 0.0f, xdist2 = 0.0f, xdist3 = 0.0f, xdist4 = 0.0f, xdist5 = 0.0f, xdist6 = 0.0f, xdist7 = 0.0f, xdist8 = 0.0f;
-  float ydist1 = 0.0f, ydist2 = 0.0f, ydist3 = 0.0f, ydist4 = 0.0f, ydist5 = 0.0f, ydist6 = 0.0f, ydist7 = 0.0f, ydist8 = 0.0f;
-  float zdist1 = 0.0f, zdist2 = 0.0f, zdist3 = 0.0f, zdist4 = 0.0f, zdist5 = 0.0f, zdist6 = 0.0f, zdist7 = 0.0f, zdist8 = 0.0f;
-  size_t zStride = 0, yStride = 0;
-  for(size_t i = 0; i < zPoints; i++)
-  {
-    zStride = i * xPoints * yPoints;
-    for(size_t j = 0; j < yPoints; j++)
-    {
-      yStride = j * xPoints;
-      for(size_t k = 0; k < xPoints; k++)
-      {
-        int32_t gnum = m_FeatureIds[zStride + yStride + k];
-        x = float(k * modXRes) + (xOrigin * static_cast<float>(m_ScaleFactor));
-        y = float(j * modYRes) + (yOrigin * static_cast<float>(m_ScaleFactor));
-        z = float(i * modZRes) + (zOrigin * static_cast<float>(m_ScaleFactor));
-        x1 = x + (modXRes / 4.0f);
-        x2 = x - (modXRes / 4.0f);
-        y1 = y + (modYRes / 4.0f);
-        y2 = y - (modYRes / 4.0f);
-        z1 = z + (modZRes / 4.0f);
-        z2 = z - (modZRes / 4.0f);
-        xdist1 = (x1 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-        ydist1 = (y1 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-        zdist1 = (z1 - (m_Centroids[gnum * 3 + 2] * static_cast<float>(m_ScaleFactor)));
-        xdist2 = (x1 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-        ydist2 = (y1 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-        zdist2 = (z2 - (m_Centroids[gnum * 3 + 2] * static_cast<float>(m_ScaleFactor)));
-        xdist3 = (x1 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-        ydist3 = (y2 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-        zdist3 = (z1 - (m_Centroids[gnum * 3 + 2] * static_cast<float>(m_ScaleFactor)));
-        xdist4 = (x1 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-        ydist4 = (y2 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-        zdist4 = (z2 - (m_Centroids[gnum * 3 + 2] * static_cast<float>(m_ScaleFactor)));
-        xdist5 = (x2 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-        ydist5 = (y1 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-        zdist5 = (z1 - (m_Centroids[gnum * 3 + 2] * static_cast<float>(m_ScaleFactor)));
-        xdist6 = (x2 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-        ydist6 = (y1 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-        zdist6 = (z2 - (m_Centroids[gnum * 3 + 2] * static_cast<float>(m_ScaleFactor)));
-        xdist7 = (x2 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-        ydist7 = (y2 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-        zdist7 = (z1 - (m_Centroids[gnum * 3 + 2] * static_cast<float>(m_ScaleFactor)));
-        xdist8 = (x2 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-        ydist8 = (y2 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-        zdist8 = (z2 - (m_Centroids[gnum * 3 + 2] * static_cast<float>(m_ScaleFactor)));
-
-        xx = ((ydist1) * (ydist1)) + ((zdist1) * (zdist1)) + ((ydist2) * (ydist2)) + ((zdist2) * (zdist2)) + ((ydist3) * (ydist3)) + ((zdist3) * (zdist3)) + ((ydist4) * (ydist4)) +
-             ((zdist4) * (zdist4)) + ((ydist5) * (ydist5)) + ((zdist5) * (zdist5)) + ((ydist6) * (ydist6)) + ((zdist6) * (zdist6)) + ((ydist7) * (ydist7)) + ((zdist7) * (zdist7)) +
-             ((ydist8) * (ydist8)) + ((zdist8) * (zdist8));
-        yy = ((xdist1) * (xdist1)) + ((zdist1) * (zdist1)) + ((xdist2) * (xdist2)) + ((zdist2) * (zdist2)) + ((xdist3) * (xdist3)) + ((zdist3) * (zdist3)) + ((xdist4) * (xdist4)) +
-             ((zdist4) * (zdist4)) + ((xdist5) * (xdist5)) + ((zdist5) * (zdist5)) + ((xdist6) * (xdist6)) + ((zdist6) * (zdist6)) + ((xdist7) * (xdist7)) + ((zdist7) * (zdist7)) +
-             ((xdist8) * (xdist8)) + ((zdist8) * (zdist8));
-        zz = ((xdist1) * (xdist1)) + ((ydist1) * (ydist1)) + ((xdist2) * (xdist2)) + ((ydist2) * (ydist2)) + ((xdist3) * (xdist3)) + ((ydist3) * (ydist3)) + ((xdist4) * (xdist4)) +
-             ((ydist4) * (ydist4)) + ((xdist5) * (xdist5)) + ((ydist5) * (ydist5)) + ((xdist6) * (xdist6)) + ((ydist6) * (ydist6)) + ((xdist7) * (xdist7)) + ((ydist7) * (ydist7)) +
-             ((xdist8) * (xdist8)) + ((ydist8) * (ydist8));
-        xy = ((xdist1) * (ydist1)) + ((xdist2) * (ydist2)) + ((xdist3) * (ydist3)) + ((xdist4) * (ydist4)) + ((xdist5) * (ydist5)) + ((xdist6) * (ydist6)) + ((xdist7) * (ydist7)) +
-             ((xdist8) * (ydist8));
-        yz = ((ydist1) * (zdist1)) + ((ydist2) * (zdist2)) + ((ydist3) * (zdist3)) + ((ydist4) * (zdist4)) + ((ydist5) * (zdist5)) + ((ydist6) * (zdist6)) + ((ydist7) * (zdist7)) +
-             ((ydist8) * (zdist8));
-        xz = ((xdist1) * (zdist1)) + ((xdist2) * (zdist2)) + ((xdist3) * (zdist3)) + ((xdist4) * (zdist4)) + ((xdist5) * (zdist5)) + ((xdist6) * (zdist6)) + ((xdist7) * (zdist7)) +
-             ((xdist8) * (zdist8));
-
-        m_FeatureMoments[gnum * 6 + 0] = m_FeatureMoments[gnum * 6 + 0] + static_cast<double>(xx);
-        m_FeatureMoments[gnum * 6 + 1] = m_FeatureMoments[gnum * 6 + 1] + static_cast<double>(yy);
-        m_FeatureMoments[gnum * 6 + 2] = m_FeatureMoments[gnum * 6 + 2] + static_cast<double>(zz);
-        m_FeatureMoments[gnum * 6 + 3] = m_FeatureMoments[gnum * 6 + 3] + static_cast<double>(xy);
-        m_FeatureMoments[gnum * 6 + 4] = m_FeatureMoments[gnum * 6 + 4] + static_cast<double>(yz);
-        m_FeatureMoments[gnum * 6 + 5] = m_FeatureMoments[gnum * 6 + 5] + static_cast<double>(xz);
-        m_Volumes[gnum] = m_Volumes[gnum] + 1.0;
-      }
-    }
+    const FeatureMoments::Accumulator& feature = moments.getFeature(i);
+    double count = static_cast<double>(feature.count);
+    double ex = (feature.mean[0] - static_cast<double>(m_Centroids[3 * i + 0])) * scale;
+    double ey = (feature.mean[1] - static_cast<double>(m_Centroids[3 * i + 1])) * scale;
+    double ez = (feature.mean[2] - static_cast<double>(m_Centroids[3 * i + 2])) * scale;
+    double sxx = scale2 * feature.m2[0] + count * ex * ex;
+    double syy = scale2 * feature.m2[1] + count * ey * ey;
+    double szz = scale2 * feature.m2[2] + count * ez * ez;
+    m_FeatureMoments[6 * i + 0] = 8.0 * (syy + szz + count * (hy2 + hz2));
+    m_FeatureMoments[6 * i + 1] = 8.0 * (sxx + szz + count * (hx2 + hz2));
+    m_FeatureMoments[6 * i + 2] = 8.0 * (sxx + syy + count * (hx2 + hy2));
+    m_FeatureMoments[6 * i + 3] = 8.0 * (scale2 * feature.m2[3] + count * ex * ey);
+    m_FeatureMoments[6 * i + 4] = 8.0 * (scale2 * feature.m2[4] + count * ey * ez);
+    m_FeatureMoments[6 * i + 5] = 8.0 * (scale2 * feature.m2[5] + count * ex * ez);
+    m_Volumes[i] = m_Volumes[i] + static_cast<float>(feature.count);
   }
   double sphere = (2000.0 * M_PI * M_PI) / 9.0;
   // constant for moments because voxels are broken into smaller voxels
@@ -44,6 +44,8 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
 
+#include "DREAM3DLib/Utilities/FeatureMoments.hpp"
+
 #include "Statistics/StatisticsConstants.h"
 #include "Statistics/StatisticsVersion.h"
 
@@ -203,22 +205,18 @@ void FindSizes::preflight()
 // -----------------------------------------------------------------------------
 void FindSizes::findSizesImage(ImageGeom::Pointer image)
 {
-  size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   size_t numfeatures = m_VolumesPtr.lock()->getNumberOfTuples();
 
-  DataArray<uint64_t>::Pointer m_FeatureCounts = DataArray<uint64_t>::CreateArray(numfeatures, "_INTERNAL_USE_ONLY_FeatureCounts");
-  m_FeatureCounts->initializeWithZeros();
-  uint64_t* featurecounts = m_FeatureCounts->getPointer(0);
+  size_t dims[3] = {image->getXPoints(), image->getYPoints(), image->getZPoints()};
+  double origin[3] = {0.0, 0.0, 0.0};
+  double spacing[3] = {1.0, 1.0, 1.0};
+  FeatureMoments moments;
+  moments.compute(m_FeatureIds, numfeatures, dims, origin, spacing, FeatureMoments::Order::Counts);
 
   float rad = 0.0f;
   float diameter = 0.0f;
   float res_scalar = 0.0f;
 
-  for(size_t j = 0; j < totalPoints; j++)
-  {
-    int32_t gnum = m_FeatureIds[j];
-    featurecounts[gnum]++;
-  }
   float xRes = 0.0f;
   float yRes = 0.0f;
   float zRes = 0.0f;
@@ -241,14 +239,14 @@ void FindSizes::findSizesImage(ImageGeom::Pointer image)
 
     for(size_t i = 1; i < numfeatures; i++)
     {
-      m_NumElements[i] = static_cast<int32_t>(featurecounts[i]);
-      if(featurecounts[i] > 9007199254740992ULL)
+      m_NumElements[i] = static_cast<int32_t>(moments.getCount(i));
+      if(moments.getCount(i) > 9007199254740992ULL)
       {
-        QString ss = QObject::tr("Number of voxels belonging to feature %1 (%2) is greater than 9007199254740992").arg(i).arg(featurecounts[i]);
+        QString ss = QObject::tr("Number of voxels belonging to feature %1 (%2) is greater than 9007199254740992").arg(i).arg(moments.getCount(i));
         setErrorCondition(-78231, ss);
         return;
       }
-      m_Volumes[i] = (static_cast<double>(featurecounts[i]) * static_cast<double>(res_scalar));
+      m_Volumes[i] = (static_cast<double>(moments.getCount(i)) * static_cast<double>(res_scalar));
 
       rad = m_Volumes[i] / SIMPLib::Constants::k_Pi;
       diameter = (2 * sqrtf(rad));
@@ -261,15 +259,15 @@ void FindSizes::findSizesImage(ImageGeom::Pointer image)
     float vol_term = (4.0f / 3.0f) * SIMPLib::Constants::k_Pi;
     for(size_t i = 1; i < numfeatures; i++)
     {
-      m_NumElements[i] = static_cast<int32_t>(featurecounts[i]);
-      if(featurecounts[i] > 9007199254740992ULL)
+      m_NumElements[i] = static_cast<int32_t>(moments.getCount(i));
+      if(moments.getCount(i) > 9007199254740992ULL)
       {
-        QString ss = QObject::tr("Number of voxels belonging to feature %1 (%2) is greater than 9007199254740992").arg(i).arg(featurecounts[i]);
+        QString ss = QObject::tr("Number of voxels belonging to feature %1 (%2) is greater than 9007199254740992").arg(i).arg(moments.getCount(i));
         setErrorCondition(-78231, ss);
         return;
       }
 
-      m_Volumes[i] = (static_cast<double>(featurecounts[i]) * static_cast<double>(res_scalar));
+      m_Volumes[i] = (static_cast<double>(moments.getCount(i)) * static_cast<double>(res_scalar));
 
       rad = m_Volumes[i] / vol_term;
       diameter = 2.0f * powf(rad, 0.3333333333f);
@@ -35,6 +35,9 @@
 
 #include "GenerateEnsembleStatistics.h"
 
+#include <algorithm>
+#include <functional>
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/Common/PhaseType.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
@@ -62,6 +65,206 @@
 
 #include "EbsdLib/EbsdConstants.h"
 
+#include "Statistics/StatisticsFilters/util/FeatureBinIndex.h"
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+namespace
+{
+const size_t k_FeatureBlockSize = 4096;
+
+/**
+ * @brief The PhaseKeysImpl class assigns every unbiased Feature to its phase and sums the
+ * volume of each phase over a contiguous block of Features
+ */
+class PhaseKeysImpl
+{
+public:
+  PhaseKeysImpl(size_t numFeatures, size_t numEnsembles, int32_t* featurePhases, bool* biasedFeatures, float* equivalentDiameters, std::vector<int32_t>& phaseKeys, std::vector<double>& blockVolumes)
+  : m_NumFeatures(numFeatures)
+  , m_NumEnsembles(numEnsembles)
+  , m_FeaturePhases(featurePhases)
+  , m_BiasedFeatures(biasedFeatures)
+  , m_EquivalentDiameters(equivalentDiameters)
+  , m_PhaseKeys(phaseKeys)
+  , m_BlockVolumes(blockVolumes)
+  {
+  }
+  virtual ~PhaseKeysImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t block = start; block < end; block++)
+    {
+      double* volumes = m_BlockVolumes.data() + block * m_NumEnsembles;
+      size_t first = block * k_FeatureBlockSize;
+      size_t last = std::min(first + k_FeatureBlockSize, m_NumFeatures);
+      for(size_t i = std::max(first, size_t(1)); i < last; i++)
+      {
+        if(!m_BiasedFeatures[i])
+        {
+          m_PhaseKeys[i] = m_FeaturePhases[i];
+        }
+        float vol = (1.0f / 6.0f) * SIMPLib::Constants::k_Pi * m_EquivalentDiameters[i] * m_EquivalentDiameters[i] * m_EquivalentDiameters[i];
+        volumes[m_FeaturePhases[i]] += vol;
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  size_t m_NumFeatures;
+  size_t m_NumEnsembles;
+  int32_t* m_FeaturePhases;
+  bool* m_BiasedFeatures;
+  float* m_EquivalentDiameters;
+  std::vector<int32_t>& m_PhaseKeys;
+  std::vector<double>& m_BlockVolumes;
+};
+
+/**
+ * @brief The SizeBinKeysImpl class assigns every unbiased Feature of a phase that carries
+ * size correlated statistics to its (phase, size bin) key
+ */
+class SizeBinKeysImpl
+{
+public:
+  SizeBinKeysImpl(int32_t* featurePhases, bool* biasedFeatures, float* equivalentDiameters, const std::vector<int32_t>& binOffsets, const std::vector<int32_t>& numBins,
+                  const std::vector<float>& mindiams, const std::vector<float>& binsteps, std::vector<int32_t>& binKeys)
+  : m_FeaturePhases(featurePhases)
+  , m_BiasedFeatures(biasedFeatures)
+  , m_EquivalentDiameters(equivalentDiameters)
+  , m_BinOffsets(binOffsets)
+  , m_NumBins(numBins)
+  , m_Mindiams(mindiams)
+  , m_Binsteps(binsteps)
+  , m_BinKeys(binKeys)
+  {
+  }
+  virtual ~SizeBinKeysImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      int32_t phase = m_FeaturePhases[i];
+      if(m_BiasedFeatures[i] || m_NumBins[phase] == 0)
+      {
+        continue;
+      }
+      // Diameters outside the binned range are clamped into the first or last bin
+      float binf = (m_EquivalentDiameters[i] - m_Mindiams[phase]) / m_Binsteps[phase];
+      int32_t bin = binf > 0.0f ? static_cast<int32_t>(binf) : 0;
+      bin = std::min(bin, m_NumBins[phase] - 1);
+      m_BinKeys[i] = m_BinOffsets[phase] + bin;
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  int32_t* m_FeaturePhases;
+  bool* m_BiasedFeatures;
+  float* m_EquivalentDiameters;
+  const std::vector<int32_t>& m_BinOffsets;
+  const std::vector<int32_t>& m_NumBins;
+  const std::vector<float>& m_Mindiams;
+  const std::vector<float>& m_Binsteps;
+  std::vector<int32_t>& m_BinKeys;
+};
+
+/**
+ * @brief The DistributionFit struct describes one distribution fit: the Feature values of a
+ * consecutive run of bins are fitted into the given correlated distribution arrays
+ */
+struct DistributionFit
+{
+  const FeatureBinIndex* index = nullptr;
+  size_t firstBin = 0;
+  size_t numBins = 0;
+  std::function<float(size_t)> value;
+  DistributionAnalysisOps::Pointer ops;
+  VectorOfFloatArray outputs;
+};
+
+/**
+ * @brief The DistributionFitsImpl class gathers the values for and runs a range of
+ * independent distribution fits
+ */
+class DistributionFitsImpl
+{
+public:
+  DistributionFitsImpl(std::vector<DistributionFit>& fits)
+  : m_Fits(fits)
+  {
+  }
+  virtual ~DistributionFitsImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t f = start; f < end; f++)
+    {
+      DistributionFit& fit = m_Fits[f];
+      std::vector<std::vector<float>> values(fit.numBins);
+      for(size_t b = 0; b < fit.numBins; b++)
+      {
+        fit.index->gather(fit.firstBin + b, fit.value, values[b]);
+      }
+      fit.ops->calculateCorrelatedParameters(values, fit.outputs);
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  std::vector<DistributionFit>& m_Fits;
+};
+
+/**
+ * @brief runDistributionFits Runs all of the distribution fits, concurrently when possible
+ */
+void runDistributionFits(std::vector<DistributionFit>& fits)
+{
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, fits.size(), 1), DistributionFitsImpl(fits), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    DistributionFitsImpl serial(fits);
+    serial.convert(0, fits.size());
+  }
+}
+} // namespace
+
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
 enum createdPathID : RenameDataPath::DataID_t
 {
@@ -675,79 +878,115 @@ void GenerateEnsembleStatistics::gatherSizeStats()
 
   float maxdiam = 0.0f;
   float mindiam = 0.0f;
-  float totalUnbiasedVolume = 0.0f;
-  QVector<VectorOfFloatArray> sizedist;
-  std::vector<std::vector<std::vector<float>>> values;
-
   FloatArrayType::Pointer binnumbers;
   size_t numfeatures = m_EquivalentDiametersPtr.lock()->getNumberOfTuples();
   size_t numensembles = m_PhaseTypesPtr.lock()->getNumberOfTuples();
+  size_t numBlocks = (numfeatures + k_FeatureBlockSize - 1) / k_FeatureBlockSize;
 
-  std::vector<float> fractions(numensembles, 0.0f);
-  sizedist.resize(numensembles);
-  values.resize(numensembles);
+  // One pass over the Features groups the unbiased Features by phase and sums the
+  // volume of every phase
+  std::vector<int32_t> phaseKeys(numfeatures, FeatureBinIndex::k_Unbinned);
+  std::vector<double> blockVolumes(numBlocks * numensembles, 0.0);
 
-  for(size_t i = 1; i < numensembles; i++)
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
   {
-    sizedist[i] = statsDataArray[i]->CreateCorrelatedDistributionArrays(m_SizeDistributionFitType, 1);
-    values[i].resize(1);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numBlocks), PhaseKeysImpl(numfeatures, numensembles, m_FeaturePhases, m_BiasedFeatures, m_EquivalentDiameters, phaseKeys, blockVolumes),
+                      tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    PhaseKeysImpl serial(numfeatures, numensembles, m_FeaturePhases, m_BiasedFeatures, m_EquivalentDiameters, phaseKeys, blockVolumes);
+    serial.convert(0, numBlocks);
   }
 
-  float vol = 0.0f;
-  for(size_t i = 1; i < numfeatures; i++)
+  // Combine the per block volumes in block order so the result does not depend on the thread count.
+  // As before, the volume of the Features of phase 0 is part of the total the fractions are taken of
+  std::vector<double> fractions(numensembles, 0.0);
+  double totalUnbiasedVolume = 0.0;
+  for(size_t block = 0; block < numBlocks; block++)
   {
-    if(!m_BiasedFeatures[i])
+    for(size_t i = 0; i < numensembles; i++)
     {
-      values[m_FeaturePhases[i]][0].push_back(m_EquivalentDiameters[i]);
+      fractions[i] += blockVolumes[block * numensembles + i];
+      totalUnbiasedVolume += blockVolumes[block * numensembles + i];
     }
-    vol = (1.0f / 6.0f) * SIMPLib::Constants::k_Pi * m_EquivalentDiameters[i] * m_EquivalentDiameters[i] * m_EquivalentDiameters[i];
-    fractions[m_FeaturePhases[i]] = fractions[m_FeaturePhases[i]] + vol;
-    totalUnbiasedVolume = totalUnbiasedVolume + vol;
   }
+
+  FeatureBinIndex phaseIndex;
+  phaseIndex.build(phaseKeys, numensembles);
+
+  float* equivalentDiameters = m_EquivalentDiameters;
+  std::vector<DistributionFit> fits;
+  QVector<VectorOfFloatArray> sizedist(numensembles);
   for(size_t i = 1; i < numensembles; i++)
   {
+    sizedist[i] = statsDataArray[i]->CreateCorrelatedDistributionArrays(m_SizeDistributionFitType, 1);
+    if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary) || m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate) ||
+       m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
+    {
+      DistributionFit fit;
+      fit.index = &phaseIndex;
+      fit.firstBin = i;
+      fit.numBins = 1;
+      fit.value = [equivalentDiameters](size_t featureId) { return equivalentDiameters[featureId]; };
+      fit.ops = m_DistributionAnalysis[m_SizeDistributionFitType];
+      fit.outputs = sizedist[i];
+      fits.push_back(fit);
+    }
+  }
+  runDistributionFits(fits);
+
+  std::vector<float> values;
+  for(size_t i = 1; i < numensembles; i++)
+  {
+    float phaseFraction = static_cast<float>(fractions[i] / totalUnbiasedVolume);
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Matrix))
     {
       MatrixStatsData::Pointer pp = std::dynamic_pointer_cast<MatrixStatsData>(statsDataArray[i]);
-      pp->setPhaseFraction((fractions[i] / totalUnbiasedVolume));
+      pp->setPhaseFraction(phaseFraction);
+      continue;
     }
+    if(m_PhaseTypes[i] != static_cast<PhaseType::EnumType>(PhaseType::Type::Primary) && m_PhaseTypes[i] != static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate) &&
+       m_PhaseTypes[i] != static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
+    {
+      continue;
+    }
+
+    phaseIndex.gather(i, [equivalentDiameters](size_t featureId) { return equivalentDiameters[featureId]; }, values);
+    DistributionAnalysisOps::determineMaxAndMinValues(values, maxdiam, mindiam);
+    int32_t numbins = int32_t(maxdiam / m_SizeCorrelationResolution) + 1;
+    binnumbers = FloatArrayType::CreateArray(numbins, SIMPL::StringConstants::BinNumber);
+    DistributionAnalysisOps::determineBinNumbers(maxdiam, mindiam, m_SizeCorrelationResolution, binnumbers);
+
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary))
     {
       PrimaryStatsData::Pointer pp = std::dynamic_pointer_cast<PrimaryStatsData>(statsDataArray[i]);
-      pp->setPhaseFraction((fractions[i] / totalUnbiasedVolume));
-      m_DistributionAnalysis[m_SizeDistributionFitType]->calculateCorrelatedParameters(values[i], sizedist[i]);
+      pp->setPhaseFraction(phaseFraction);
       pp->setFeatureSizeDistribution(sizedist[i]);
-      DistributionAnalysisOps::determineMaxAndMinValues(values[i][0], maxdiam, mindiam);
-      int32_t numbins = int32_t(maxdiam / m_SizeCorrelationResolution) + 1;
       pp->setFeatureDiameterInfo(m_SizeCorrelationResolution, maxdiam, mindiam);
-      binnumbers = FloatArrayType::CreateArray(numbins, SIMPL::StringConstants::BinNumber);
-      DistributionAnalysisOps::determineBinNumbers(maxdiam, mindiam, m_SizeCorrelationResolution, binnumbers);
       pp->setBinNumbers(binnumbers);
     }
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate))
     {
       PrecipitateStatsData::Pointer pp = std::dynamic_pointer_cast<PrecipitateStatsData>(statsDataArray[i]);
-      pp->setPhaseFraction((fractions[i] / totalUnbiasedVolume));
-      m_DistributionAnalysis[m_SizeDistributionFitType]->calculateCorrelatedParameters(values[i], sizedist[i]);
+      pp->setPhaseFraction(phaseFraction);
       pp->setFeatureSizeDistribution(sizedist[i]);
-      DistributionAnalysisOps::determineMaxAndMinValues(values[i][0], maxdiam, mindiam);
-      int32_t numbins = int32_t(maxdiam / m_SizeCorrelationResolution) + 1;
       pp->setFeatureDiameterInfo(m_SizeCorrelationResolution, maxdiam, mindiam);
-      binnumbers = FloatArrayType::CreateArray(numbins, SIMPL::StringConstants::BinNumber);
-      DistributionAnalysisOps::determineBinNumbers(maxdiam, mindiam, m_SizeCorrelationResolution, binnumbers);
       pp->setBinNumbers(binnumbers);
     }
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
     {
       TransformationStatsData::Pointer tp = std::dynamic_pointer_cast<TransformationStatsData>(statsDataArray[i]);
-      tp->setPhaseFraction((fractions[i] / totalUnbiasedVolume));
-      m_DistributionAnalysis[m_SizeDistributionFitType]->calculateCorrelatedParameters(values[i], sizedist[i]);
+      tp->setPhaseFraction(phaseFraction);
       tp->setFeatureSizeDistribution(sizedist[i]);
-      DistributionAnalysisOps::determineMaxAndMinValues(values[i][0], maxdiam, mindiam);
-      int numbins = int(maxdiam / m_SizeCorrelationResolution) + 1;
       tp->setFeatureDiameterInfo(m_SizeCorrelationResolution, maxdiam, mindiam);
-      binnumbers = FloatArrayType::CreateArray(numbins, SIMPL::StringConstants::BinNumber);
-      DistributionAnalysisOps::determineBinNumbers(maxdiam, mindiam, m_SizeCorrelationResolution, binnumbers);
       tp->setBinNumbers(binnumbers);
     }
   }
@@ -756,260 +995,171 @@ void GenerateEnsembleStatistics::gatherSizeStats()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void GenerateEnsembleStatistics::gatherAspectRatioStats()
+void GenerateEnsembleStatistics::gatherSizeCorrelatedStats()
 {
   StatsDataArray& statsDataArray = *(m_StatsDataArray);
 
-  size_t bin = 0;
-  QVector<VectorOfFloatArray> boveras;
-  QVector<VectorOfFloatArray> coveras;
-  std::vector<std::vector<std::vector<float>>> bvalues;
-  std::vector<std::vector<std::vector<float>>> cvalues;
-  std::vector<float> mindiams;
-  std::vector<float> binsteps;
-  size_t numfeatures = m_AspectRatiosPtr.lock()->getNumberOfTuples();
+  size_t numfeatures = m_EquivalentDiametersPtr.lock()->getNumberOfTuples();
   size_t numensembles = m_PhaseTypesPtr.lock()->getNumberOfTuples();
 
-  boveras.resize(numensembles);
-  coveras.resize(numensembles);
-  bvalues.resize(numensembles);
-  cvalues.resize(numensembles);
-  mindiams.resize(numensembles);
-  binsteps.resize(numensembles);
+  // Every (phase, size bin) pair gets its own bin in a single FeatureBinIndex
+  std::vector<int32_t> binOffsets(numensembles, 0);
+  std::vector<int32_t> numBins(numensembles, 0);
+  std::vector<float> mindiams(numensembles, 0.0f);
+  std::vector<float> binsteps(numensembles, 1.0f);
+  int32_t totalBins = 0;
   for(size_t i = 1; i < numensembles; i++)
   {
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary))
     {
       PrimaryStatsData::Pointer pp = std::dynamic_pointer_cast<PrimaryStatsData>(statsDataArray[i]);
-      boveras[i] = pp->CreateCorrelatedDistributionArrays(m_AspectRatioDistributionFitType, pp->getBinNumbers()->getSize());
-      coveras[i] = pp->CreateCorrelatedDistributionArrays(m_AspectRatioDistributionFitType, pp->getBinNumbers()->getSize());
-      bvalues[i].resize(pp->getBinNumbers()->getSize());
-      cvalues[i].resize(pp->getBinNumbers()->getSize());
+      numBins[i] = static_cast<int32_t>(pp->getBinNumbers()->getSize());
       mindiams[i] = pp->getMinFeatureDiameter();
       binsteps[i] = pp->getBinStepSize();
     }
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate))
     {
       PrecipitateStatsData::Pointer pp = std::dynamic_pointer_cast<PrecipitateStatsData>(statsDataArray[i]);
-      boveras[i] = pp->CreateCorrelatedDistributionArrays(m_AspectRatioDistributionFitType, pp->getBinNumbers()->getSize());
-      coveras[i] = pp->CreateCorrelatedDistributionArrays(m_AspectRatioDistributionFitType, pp->getBinNumbers()->getSize());
-      bvalues[i].resize(pp->getBinNumbers()->getSize());
-      cvalues[i].resize(pp->getBinNumbers()->getSize());
+      numBins[i] = static_cast<int32_t>(pp->getBinNumbers()->getSize());
       mindiams[i] = pp->getMinFeatureDiameter();
       binsteps[i] = pp->getBinStepSize();
     }
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
     {
       TransformationStatsData::Pointer tp = std::dynamic_pointer_cast<TransformationStatsData>(statsDataArray[i]);
-      boveras[i] = tp->CreateCorrelatedDistributionArrays(m_AspectRatioDistributionFitType, tp->getBinNumbers()->getSize());
-      coveras[i] = tp->CreateCorrelatedDistributionArrays(m_AspectRatioDistributionFitType, tp->getBinNumbers()->getSize());
-      bvalues[i].resize(tp->getBinNumbers()->getSize());
-      cvalues[i].resize(tp->getBinNumbers()->getSize());
+      numBins[i] = static_cast<int32_t>(tp->getBinNumbers()->getSize());
       mindiams[i] = tp->getMinFeatureDiameter();
       binsteps[i] = tp->getBinStepSize();
     }
+    binOffsets[i] = totalBins;
+    totalBins += numBins[i];
   }
-  for(size_t i = 1; i < numfeatures; i++)
-  {
-    if (m_PhaseTypes[m_FeaturePhases[i]] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary) || m_PhaseTypes[m_FeaturePhases[i]] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate) ||
-      m_PhaseTypes[m_FeaturePhases[i]] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
-    {
-      if(!m_BiasedFeatures[i])
-      {
-        bin = size_t((m_EquivalentDiameters[i] - mindiams[m_FeaturePhases[i]]) / binsteps[m_FeaturePhases[i]]);
-        bvalues[m_FeaturePhases[i]][bin].push_back(m_AspectRatios[2 * i]);
-        cvalues[m_FeaturePhases[i]][bin].push_back(m_AspectRatios[2 * i + 1]);
-      }
-    }
-  }
-  for(size_t i = 1; i < numensembles; i++)
-  {
-    if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary))
-    {
-      PrimaryStatsData::Pointer pp = std::dynamic_pointer_cast<PrimaryStatsData>(statsDataArray[i]);
-      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(bvalues[i], boveras[i]);
-      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(cvalues[i], coveras[i]);
-      pp->setFeatureSize_BOverA(boveras[i]);
-      pp->setFeatureSize_COverA(coveras[i]);
-    }
-    if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate))
-    {
-      PrecipitateStatsData::Pointer pp = std::dynamic_pointer_cast<PrecipitateStatsData>(statsDataArray[i]);
-      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(bvalues[i], boveras[i]);
-      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(cvalues[i], coveras[i]);
-      pp->setFeatureSize_BOverA(boveras[i]);
-      pp->setFeatureSize_COverA(coveras[i]);
-    }
-    if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
-    {
-      TransformationStatsData::Pointer tp = std::dynamic_pointer_cast<TransformationStatsData>(statsDataArray[i]);
-      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(bvalues[i], boveras[i]);
-      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(cvalues[i], coveras[i]);
-      tp->setFeatureSize_BOverA(boveras[i]);
-      tp->setFeatureSize_COverA(coveras[i]);
-    }
-  }
-}
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void GenerateEnsembleStatistics::gatherOmega3Stats()
-{
-  StatsDataArray& statsDataArray = *(m_StatsDataArray);
+  std::vector<int32_t> binKeys(numfeatures, FeatureBinIndex::k_Unbinned);
 
-  size_t bin = 0;
-  QVector<VectorOfFloatArray> omega3s;
-  std::vector<std::vector<std::vector<float>>> values;
-  QVector<float> mindiams;
-  QVector<float> binsteps;
-  size_t numfeatures = m_Omega3sPtr.lock()->getNumberOfTuples();
-  size_t numensembles = m_PhaseTypesPtr.lock()->getNumberOfTuples();
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
 
-  omega3s.resize(numensembles);
-  values.resize(numensembles);
-  mindiams.resize(numensembles);
-  binsteps.resize(numensembles);
-  for(size_t i = 1; i < numensembles; i++)
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
   {
-    if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary))
-    {
-      PrimaryStatsData::Pointer pp = std::dynamic_pointer_cast<PrimaryStatsData>(statsDataArray[i]);
-      omega3s[i] = pp->CreateCorrelatedDistributionArrays(m_Omega3DistributionFitType, pp->getBinNumbers()->getSize());
-      values[i].resize(pp->getBinNumbers()->getSize());
-      mindiams[i] = pp->getMinFeatureDiameter();
-      binsteps[i] = pp->getBinStepSize();
-    }
-    if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate))
-    {
-      PrecipitateStatsData::Pointer pp = std::dynamic_pointer_cast<PrecipitateStatsData>(statsDataArray[i]);
-      omega3s[i] = pp->CreateCorrelatedDistributionArrays(m_Omega3DistributionFitType, pp->getBinNumbers()->getSize());
-      values[i].resize(pp->getBinNumbers()->getSize());
-      mindiams[i] = pp->getMinFeatureDiameter();
-      binsteps[i] = pp->getBinStepSize();
-    }
-    if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
-    {
-      TransformationStatsData::Pointer tp = std::dynamic_pointer_cast<TransformationStatsData>(statsDataArray[i]);
-      omega3s[i] = tp->CreateCorrelatedDistributionArrays(m_Omega3DistributionFitType, tp->getBinNumbers()->getSize());
-      values[i].resize(tp->getBinNumbers()->getSize());
-      mindiams[i] = tp->getMinFeatureDiameter();
-      binsteps[i] = tp->getBinStepSize();
-    }
+    tbb::parallel_for(tbb::blocked_range<size_t>(1, numfeatures), SizeBinKeysImpl(m_FeaturePhases, m_BiasedFeatures, m_EquivalentDiameters, binOffsets, numBins, mindiams, binsteps, binKeys),
+                      tbb::auto_partitioner());
   }
-  for(size_t i = 1; i < numfeatures; i++)
-  {
-    if (m_PhaseTypes[m_FeaturePhases[i]] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary) || m_PhaseTypes[m_FeaturePhases[i]] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate) ||
-      m_PhaseTypes[m_FeaturePhases[i]] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
-    {
-      if(!m_BiasedFeatures[i])
-      {
-        bin = size_t((m_EquivalentDiameters[i] - mindiams[m_FeaturePhases[i]]) / binsteps[m_FeaturePhases[i]]);
-        values[m_FeaturePhases[i]][bin].push_back(m_Omega3s[i]);
-      }
-    }
-  }
-  for(size_t i = 1; i < numensembles; i++)
+  else
+#endif
   {
-    if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary))
-    {
-      PrimaryStatsData::Pointer pp = std::dynamic_pointer_cast<PrimaryStatsData>(statsDataArray[i]);
-      m_DistributionAnalysis[m_Omega3DistributionFitType]->calculateCorrelatedParameters(values[i], omega3s[i]);
-      pp->setFeatureSize_Omegas(omega3s[i]);
-    }
-    if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate))
-    {
-      PrecipitateStatsData::Pointer pp = std::dynamic_pointer_cast<PrecipitateStatsData>(statsDataArray[i]);
-      m_DistributionAnalysis[m_Omega3DistributionFitType]->calculateCorrelatedParameters(values[i], omega3s[i]);
-      pp->setFeatureSize_Omegas(omega3s[i]);
-    }
-    if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
-    {
-      TransformationStatsData::Pointer tp = std::dynamic_pointer_cast<TransformationStatsData>(statsDataArray[i]);
-      m_DistributionAnalysis[m_Omega3DistributionFitType]->calculateCorrelatedParameters(values[i], omega3s[i]);
-      tp->setFeatureSize_Omegas(omega3s[i]);
-    }
+    SizeBinKeysImpl serial(m_FeaturePhases, m_BiasedFeatures, m_EquivalentDiameters, binOffsets, numBins, mindiams, binsteps, binKeys);
+    serial.convert(1, numfeatures);
   }
-}
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void GenerateEnsembleStatistics::gatherNeighborhoodStats()
-{
-  StatsDataArray& statsDataArray = *(m_StatsDataArray);
+  FeatureBinIndex sizeBinIndex;
+  sizeBinIndex.build(binKeys, static_cast<size_t>(totalBins));
 
-  size_t bin = 0;
-  QVector<VectorOfFloatArray> neighborhoods;
-  std::vector<std::vector<std::vector<float>>> values;
-  std::vector<float> mindiams;
-  std::vector<float> binsteps;
-  size_t numfeatures = m_NeighborhoodsPtr.lock()->getNumberOfTuples();
-  size_t numensembles = m_PhaseTypesPtr.lock()->getNumberOfTuples();
-
-  neighborhoods.resize(numensembles);
-  values.resize(numensembles);
-  mindiams.resize(numensembles);
-  binsteps.resize(numensembles);
+  // Queue every requested fit for every phase, then run them all concurrently
+  QVector<VectorOfFloatArray> boveras(numensembles);
+  QVector<VectorOfFloatArray> coveras(numensembles);
+  QVector<VectorOfFloatArray> omega3s(numensembles);
+  QVector<VectorOfFloatArray> neighborhoods(numensembles);
+  float* aspectRatios = m_AspectRatios;
+  float* omega3Values = m_Omega3s;
+  int32_t* neighborhoodValues = m_Neighborhoods;
+  std::vector<DistributionFit> fits;
   for(size_t i = 1; i < numensembles; i++)
   {
-    if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary))
+    if(numBins[i] == 0)
     {
-      PrimaryStatsData::Pointer pp = std::dynamic_pointer_cast<PrimaryStatsData>(statsDataArray[i]);
-      neighborhoods[i] = pp->CreateCorrelatedDistributionArrays(m_NeighborhoodDistributionFitType, pp->getBinNumbers()->getSize());
-      values[i].resize(pp->getBinNumbers()->getSize());
-      mindiams[i] = pp->getMinFeatureDiameter();
-      binsteps[i] = pp->getBinStepSize();
+      continue;
     }
-    if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate))
+    DistributionFit fit;
+    fit.index = &sizeBinIndex;
+    fit.firstBin = static_cast<size_t>(binOffsets[i]);
+    fit.numBins = static_cast<size_t>(numBins[i]);
+    if(m_ComputeAspectRatioDistribution)
     {
-      PrecipitateStatsData::Pointer pp = std::dynamic_pointer_cast<PrecipitateStatsData>(statsDataArray[i]);
-      neighborhoods[i] = pp->CreateCorrelatedDistributionArrays(m_NeighborhoodDistributionFitType, pp->getBinNumbers()->getSize());
-      values[i].resize(pp->getBinNumbers()->getSize());
-      mindiams[i] = pp->getMinFeatureDiameter();
-      binsteps[i] = pp->getBinStepSize();
+      boveras[i] = statsDataArray[i]->CreateCorrelatedDistributionArrays(m_AspectRatioDistributionFitType, numBins[i]);
+      coveras[i] = statsDataArray[i]->CreateCorrelatedDistributionArrays(m_AspectRatioDistributionFitType, numBins[i]);
+      fit.ops = m_DistributionAnalysis[m_AspectRatioDistributionFitType];
+      fit.value = [aspectRatios](size_t featureId) { return aspectRatios[2 * featureId]; };
+      fit.outputs = boveras[i];
+      fits.push_back(fit);
+      fit.value = [aspectRatios](size_t featureId) { return aspectRatios[2 * featureId + 1]; };
+      fit.outputs = coveras[i];
+      fits.push_back(fit);
     }
-    if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
+    if(m_ComputeOmega3Distribution)
     {
-      TransformationStatsData::Pointer tp = std::dynamic_pointer_cast<TransformationStatsData>(statsDataArray[i]);
-      neighborhoods[i] = tp->CreateCorrelatedDistributionArrays(m_NeighborhoodDistributionFitType, tp->getBinNumbers()->getSize());
-      values[i].resize(tp->getBinNumbers()->getSize());
-      mindiams[i] = tp->getMinFeatureDiameter();
-      binsteps[i] = tp->getBinStepSize();
+      omega3s[i] = statsDataArray[i]->CreateCorrelatedDistributionArrays(m_Omega3DistributionFitType, numBins[i]);
+      fit.ops = m_DistributionAnalysis[m_Omega3DistributionFitType];
+      fit.value = [omega3Values](size_t featureId) { return omega3Values[featureId]; };
+      fit.outputs = omega3s[i];
+      fits.push_back(fit);
     }
-  }
-
-  for(size_t i = 1; i < numfeatures; i++)
-  {
-    if (m_PhaseTypes[m_FeaturePhases[i]] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary) || m_PhaseTypes[m_FeaturePhases[i]] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate) ||
-      m_PhaseTypes[m_FeaturePhases[i]] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
+    if(m_ComputeNeighborhoodDistribution)
     {
-      if(!m_BiasedFeatures[i])
-      {
-        bin = size_t((m_EquivalentDiameters[i] - mindiams[m_FeaturePhases[i]]) / binsteps[m_FeaturePhases[i]]);
-        values[m_FeaturePhases[i]][bin].push_back(static_cast<float>(m_Neighborhoods[i]));
-      }
+      neighborhoods[i] = statsDataArray[i]->CreateCorrelatedDistributionArrays(m_NeighborhoodDistributionFitType, numBins[i]);
+      fit.ops = m_DistributionAnalysis[m_NeighborhoodDistributionFitType];
+      fit.value = [neighborhoodValues](size_t featureId) { return static_cast<float>(neighborhoodValues[featureId]); };
+      fit.outputs = neighborhoods[i];
+      fits.push_back(fit);
     }
   }
+  runDistributionFits(fits);
+
   for(size_t i = 1; i < numensembles; i++)
   {
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary))
     {
       PrimaryStatsData::Pointer pp = std::dynamic_pointer_cast<PrimaryStatsData>(statsDataArray[i]);
-      m_DistributionAnalysis[m_NeighborhoodDistributionFitType]->calculateCorrelatedParameters(values[i], neighborhoods[i]);
-      pp->setFeatureSize_Neighbors(neighborhoods[i]);
+      if(m_ComputeAspectRatioDistribution)
+      {
+        pp->setFeatureSize_BOverA(boveras[i]);
+        pp->setFeatureSize_COverA(coveras[i]);
+      }
+      if(m_ComputeOmega3Distribution)
+      {
+        pp->setFeatureSize_Omegas(omega3s[i]);
+      }
+      if(m_ComputeNeighborhoodDistribution)
+      {
+        pp->setFeatureSize_Neighbors(neighborhoods[i]);
+      }
     }
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate))
     {
       PrecipitateStatsData::Pointer pp = std::dynamic_pointer_cast<PrecipitateStatsData>(statsDataArray[i]);
-      m_DistributionAnalysis[m_NeighborhoodDistributionFitType]->calculateCorrelatedParameters(values[i], neighborhoods[i]);
-      pp->setFeatureSize_Clustering(neighborhoods[i]);
+      if(m_ComputeAspectRatioDistribution)
+      {
+        pp->setFeatureSize_BOverA(boveras[i]);
+        pp->setFeatureSize_COverA(coveras[i]);
+      }
+      if(m_ComputeOmega3Distribution)
+      {
+        pp->setFeatureSize_Omegas(omega3s[i]);
+      }
+      if(m_ComputeNeighborhoodDistribution)
+      {
+        pp->setFeatureSize_Clustering(neighborhoods[i]);
+      }
     }
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
     {
       TransformationStatsData::Pointer tp = std::dynamic_pointer_cast<TransformationStatsData>(statsDataArray[i]);
-      m_DistributionAnalysis[m_NeighborhoodDistributionFitType]->calculateCorrelatedParameters(values[i], neighborhoods[i]);
-      tp->setFeatureSize_Neighbors(neighborhoods[i]);
+      if(m_ComputeAspectRatioDistribution)
+      {
+        tp->setFeatureSize_BOverA(boveras[i]);
+        tp->setFeatureSize_COverA(coveras[i]);
+      }
+      if(m_ComputeOmega3Distribution)
+      {
+        tp->setFeatureSize_Omegas(omega3s[i]);
+      }
+      if(m_ComputeNeighborhoodDistribution)
+      {
+        tp->setFeatureSize_Neighbors(neighborhoods[i]);
+      }
     }
   }
 }
@@ -1429,17 +1579,9 @@ void GenerateEnsembleStatistics::execute()
   {
     gatherSizeStats();
   }
-  if(m_ComputeAspectRatioDistribution)
-  {
-    gatherAspectRatioStats();
-  }
-  if(m_ComputeOmega3Distribution)
-  {
-    gatherOmega3Stats();
-  }
-  if(m_ComputeNeighborhoodDistribution)
+  if(m_ComputeAspectRatioDistribution || m_ComputeOmega3Distribution || m_ComputeNeighborhoodDistribution)
   {
-    gatherNeighborhoodStats();
+    gatherSizeCorrelatedStats();
   }
   if(m_CalculateODF)
   {
@@ -327,19 +327,10 @@ protected:
   void gatherSizeStats();
 
   /**
-   * @brief gatherAspectRatioStats Consolidates Feature aspect ratio statistics
+   * @brief gatherSizeCorrelatedStats Consolidates the size binned Feature aspect ratio, Omega3 and
+   * neighborhood statistics, running every requested fit for every phase concurrently
    */
-  void gatherAspectRatioStats();
-
-  /**
-   * @brief gatherOmega3Stats Consolidates Feature Omega3 statistics
-   */
-  void gatherOmega3Stats();
-
-  /**
-   * @brief gatherNeighborhoodStats Consolidates Feature neighborhood statistics
-   */
-  void gatherNeighborhoodStats();
+  void gatherSizeCorrelatedStats();
 
   /**
    * @brief gatherMDFStats Consolidates Feature MDF statistics
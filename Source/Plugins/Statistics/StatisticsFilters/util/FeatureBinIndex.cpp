@@ -0,0 +1,237 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include "FeatureBinIndex.h"
+
+#include <algorithm>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+namespace
+{
+// Features are counted and scattered in contiguous blocks of this many Features so that
+// each block can be processed independently while keeping the bins in Feature Id order
+const size_t k_BlockSize = 65536;
+} // namespace
+
+/**
+ * @brief The CountBinsImpl class counts the number of Features of each bin in a set of blocks.
+ */
+class CountBinsImpl
+{
+public:
+  CountBinsImpl(const std::vector<int32_t>& binKeys, size_t numBins, std::vector<size_t>& blockCounts)
+  : m_BinKeys(binKeys)
+  , m_NumBins(numBins)
+  , m_BlockCounts(blockCounts)
+  {
+  }
+
+  void convert(size_t startBlock, size_t endBlock) const
+  {
+    for(size_t block = startBlock; block < endBlock; block++)
+    {
+      size_t* counts = m_BlockCounts.data() + block * m_NumBins;
+      size_t end = std::min(m_BinKeys.size(), (block + 1) * k_BlockSize);
+      for(size_t i = block * k_BlockSize; i < end; i++)
+      {
+        if(m_BinKeys[i] != FeatureBinIndex::k_Unbinned)
+        {
+          counts[m_BinKeys[i]]++;
+        }
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const std::vector<int32_t>& m_BinKeys;
+  size_t m_NumBins;
+  std::vector<size_t>& m_BlockCounts;
+};
+
+/**
+ * @brief The ScatterBinsImpl class writes the Feature Ids of a set of blocks into their bins, starting
+ * each (block, bin) pair at the offset found by the prefix sum of the block counts.
+ */
+class ScatterBinsImpl
+{
+public:
+  ScatterBinsImpl(const std::vector<int32_t>& binKeys, size_t numBins, std::vector<size_t>& blockOffsets, std::vector<size_t>& featureIds)
+  : m_BinKeys(binKeys)
+  , m_NumBins(numBins)
+  , m_BlockOffsets(blockOffsets)
+  , m_FeatureIds(featureIds)
+  {
+  }
+
+  void convert(size_t startBlock, size_t endBlock) const
+  {
+    for(size_t block = startBlock; block < endBlock; block++)
+    {
+      size_t* offsets = m_BlockOffsets.data() + block * m_NumBins;
+      size_t end = std::min(m_BinKeys.size(), (block + 1) * k_BlockSize);
+      for(size_t i = block * k_BlockSize; i < end; i++)
+      {
+        if(m_BinKeys[i] != FeatureBinIndex::k_Unbinned)
+        {
+          m_FeatureIds[offsets[m_BinKeys[i]]++] = i;
+        }
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const std::vector<int32_t>& m_BinKeys;
+  size_t m_NumBins;
+  std::vector<size_t>& m_BlockOffsets;
+  std::vector<size_t>& m_FeatureIds;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FeatureBinIndex::FeatureBinIndex() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FeatureBinIndex::~FeatureBinIndex() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureBinIndex::build(const std::vector<int32_t>& binKeys, size_t numBins)
+{
+  size_t numBlocks = (binKeys.size() + k_BlockSize - 1) / k_BlockSize;
+  std::vector<size_t> blockCounts(numBlocks * numBins, 0);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numBlocks), CountBinsImpl(binKeys, numBins, blockCounts), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    CountBinsImpl serial(binKeys, numBins, blockCounts);
+    serial.convert(0, numBlocks);
+  }
+
+  // Exclusive prefix sum in (bin, block) order turns the counts into the starting offset
+  // of every block within every bin, which keeps each bin sorted by Feature Id
+  m_BinOffsets.assign(numBins + 1, 0);
+  size_t total = 0;
+  for(size_t bin = 0; bin < numBins; bin++)
+  {
+    m_BinOffsets[bin] = total;
+    for(size_t block = 0; block < numBlocks; block++)
+    {
+      size_t count = blockCounts[block * numBins + bin];
+      blockCounts[block * numBins + bin] = total;
+      total += count;
+    }
+  }
+  m_BinOffsets[numBins] = total;
+  m_FeatureIds.resize(total);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numBlocks), ScatterBinsImpl(binKeys, numBins, blockCounts, m_FeatureIds), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    ScatterBinsImpl serial(binKeys, numBins, blockCounts, m_FeatureIds);
+    serial.convert(0, numBlocks);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t FeatureBinIndex::getNumberOfBins() const
+{
+  return m_BinOffsets.empty() ? 0 : m_BinOffsets.size() - 1;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t FeatureBinIndex::getBinSize(size_t bin) const
+{
+  return m_BinOffsets[bin + 1] - m_BinOffsets[bin];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const size_t* FeatureBinIndex::binBegin(size_t bin) const
+{
+  return m_FeatureIds.data() + m_BinOffsets[bin];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const size_t* FeatureBinIndex::binEnd(size_t bin) const
+{
+  return m_FeatureIds.data() + m_BinOffsets[bin + 1];
+}
@@ -0,0 +1,111 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+
+/**
+ * @brief The FeatureBinIndex class groups Feature Ids by an integer bin key (for example a
+ * (phase, size bin) pair) in compressed sparse row form. The grouping is stable: the Features
+ * of each bin are listed in increasing Id order, exactly as if they had been appended to a
+ * per-bin vector by a serial loop over the Features. The counting and scattering passes run
+ * in parallel over contiguous blocks of Features.
+ */
+class FeatureBinIndex
+{
+public:
+  static const int32_t k_Unbinned = -1;
+
+  FeatureBinIndex();
+  virtual ~FeatureBinIndex();
+
+  /**
+   * @brief build Groups the Features by their bin keys
+   * @param binKeys Bin key for each Feature, or k_Unbinned if the Feature belongs to no bin
+   * @param numBins Total number of bins; every key must be less than this value
+   */
+  void build(const std::vector<int32_t>& binKeys, size_t numBins);
+
+  /**
+   * @brief getNumberOfBins Returns the number of bins
+   */
+  size_t getNumberOfBins() const;
+
+  /**
+   * @brief getBinSize Returns the number of Features in a bin
+   */
+  size_t getBinSize(size_t bin) const;
+
+  /**
+   * @brief binBegin Returns a pointer to the first Feature Id in a bin
+   */
+  const size_t* binBegin(size_t bin) const;
+
+  /**
+   * @brief binEnd Returns a pointer one past the last Feature Id in a bin
+   */
+  const size_t* binEnd(size_t bin) const;
+
+  /**
+   * @brief gather Copies a value for every Feature in a bin, in Feature Id order
+   * @param bin Bin to gather
+   * @param func Functor returning the value for a Feature Id
+   * @param values Output values; any previous contents are replaced
+   */
+  template <typename T, typename Func> void gather(size_t bin, Func func, std::vector<T>& values) const
+  {
+    values.resize(getBinSize(bin));
+    const size_t* featureIds = binBegin(bin);
+    for(size_t i = 0; i < values.size(); i++)
+    {
+      values[i] = func(featureIds[i]);
+    }
+  }
+
+private:
+  std::vector<size_t> m_BinOffsets;
+  std::vector<size_t> m_FeatureIds;
+
+public:
+  FeatureBinIndex(const FeatureBinIndex&) = delete;            // Copy Constructor Not Implemented
+  FeatureBinIndex(FeatureBinIndex&&) = delete;                 // Move Constructor Not Implemented
+  FeatureBinIndex& operator=(const FeatureBinIndex&) = delete; // Copy Assignment Not Implemented
+  FeatureBinIndex& operator=(FeatureBinIndex&&) = delete;      // Move Assignment Not Implemented
+};
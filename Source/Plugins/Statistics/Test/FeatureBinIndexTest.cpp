@@ -0,0 +1,152 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <random>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "StatisticsTestFileLocations.h"
+
+// Directly include the .cpp file instead of the header because of the way the unit
+// tests are compiled.
+#include "StatisticsFilters/util/FeatureBinIndex.cpp"
+
+class FeatureBinIndexTest
+{
+
+public:
+  FeatureBinIndexTest() = default;
+  virtual ~FeatureBinIndexTest() = default;
+
+  SIMPL_TYPE_MACRO(FeatureBinIndexTest)
+
+  FeatureBinIndexTest(const FeatureBinIndexTest&) = delete;            // Copy Constructor Not Implemented
+  FeatureBinIndexTest(FeatureBinIndexTest&&) = delete;                 // Move Constructor Not Implemented
+  FeatureBinIndexTest& operator=(const FeatureBinIndexTest&) = delete; // Copy Assignment Not Implemented
+  FeatureBinIndexTest& operator=(FeatureBinIndexTest&&) = delete;      // Move Assignment Not Implemented
+
+  // -----------------------------------------------------------------------------
+  // Builds the index for random bin keys and compares every bin against the per-bin
+  // vectors that GenerateEnsembleStatistics used to append to in a serial loop.
+  // -----------------------------------------------------------------------------
+  void CompareWithSerialBins(size_t numFeatures, size_t numBins)
+  {
+    std::mt19937_64 generator(static_cast<uint64_t>(numFeatures * 31 + numBins));
+    std::uniform_int_distribution<int32_t> keyDist(FeatureBinIndex::k_Unbinned, static_cast<int32_t>(numBins) - 1);
+    std::vector<int32_t> binKeys(numFeatures);
+    for(size_t i = 0; i < numFeatures; i++)
+    {
+      binKeys[i] = keyDist(generator);
+    }
+
+    std::vector<std::vector<size_t>> serialBins(numBins);
+    for(size_t i = 0; i < numFeatures; i++)
+    {
+      if(binKeys[i] != FeatureBinIndex::k_Unbinned)
+      {
+        serialBins[binKeys[i]].push_back(i);
+      }
+    }
+
+    FeatureBinIndex index;
+    index.build(binKeys, numBins);
+    DREAM3D_REQUIRE_EQUAL(index.getNumberOfBins(), numBins)
+
+    std::vector<float> values;
+    for(size_t bin = 0; bin < numBins; bin++)
+    {
+      DREAM3D_REQUIRE_EQUAL(index.getBinSize(bin), serialBins[bin].size())
+      std::vector<size_t> featureIds(index.binBegin(bin), index.binEnd(bin));
+      DREAM3D_REQUIRE(featureIds == serialBins[bin])
+
+      index.gather(bin, [](size_t featureId) { return 0.5f * static_cast<float>(featureId); }, values);
+      DREAM3D_REQUIRE_EQUAL(values.size(), serialBins[bin].size())
+      for(size_t i = 0; i < values.size(); i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(values[i], 0.5f * static_cast<float>(serialBins[bin][i]))
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestSmallIndex()
+  {
+    CompareWithSerialBins(100, 7);
+  }
+
+  // -----------------------------------------------------------------------------
+  // Spans several counting blocks, so the per-block offsets must stitch the bins together
+  // -----------------------------------------------------------------------------
+  void TestMultiBlockIndex()
+  {
+    CompareWithSerialBins(300001, 37);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestEmptyIndex()
+  {
+    CompareWithSerialBins(0, 4);
+
+    std::vector<int32_t> unbinned(1000, FeatureBinIndex::k_Unbinned);
+    FeatureBinIndex index;
+    index.build(unbinned, 3);
+    for(size_t bin = 0; bin < 3; bin++)
+    {
+      DREAM3D_REQUIRE_EQUAL(index.getBinSize(bin), 0)
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "---- " << getNameOfClass().toStdString() << " ----" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestSmallIndex())
+    DREAM3D_REGISTER_TEST(TestMultiBlockIndex())
+    DREAM3D_REGISTER_TEST(TestEmptyIndex())
+  }
+};
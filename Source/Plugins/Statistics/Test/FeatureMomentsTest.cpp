@@ -0,0 +1,197 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "DREAM3DLib/Utilities/FeatureMoments.hpp"
+
+#include "StatisticsTestFileLocations.h"
+
+class FeatureMomentsTest
+{
+
+public:
+  FeatureMomentsTest() = default;
+  virtual ~FeatureMomentsTest() = default;
+
+  SIMPL_TYPE_MACRO(FeatureMomentsTest)
+
+  FeatureMomentsTest(const FeatureMomentsTest&) = delete;            // Copy Constructor Not Implemented
+  FeatureMomentsTest(FeatureMomentsTest&&) = delete;                 // Move Constructor Not Implemented
+  FeatureMomentsTest& operator=(const FeatureMomentsTest&) = delete; // Copy Assignment Not Implemented
+  FeatureMomentsTest& operator=(FeatureMomentsTest&&) = delete;      // Move Assignment Not Implemented
+
+  // -----------------------------------------------------------------------------
+  // Fills a volume with blocky Features and a few unassigned (-1) cells, accumulates it for every
+  // order and compares the results with sums over each Feature's cells in two serial passes.
+  // -----------------------------------------------------------------------------
+  void CompareWithTwoPassSums(size_t numFeatures)
+  {
+    const size_t dims[3] = {97, 83, 61};
+    const double origin[3] = {1000.5, -3.0, 20.0};
+    const double spacing[3] = {0.5, 0.25, 1.5};
+    size_t numCells = dims[0] * dims[1] * dims[2];
+
+    std::mt19937_64 generator(static_cast<uint64_t>(numFeatures));
+    std::uniform_int_distribution<int32_t> noiseDist(0, 49);
+    std::vector<int32_t> featureIds(numCells);
+    for(size_t c = 0; c < numCells; c++)
+    {
+      size_t i = c % dims[0];
+      size_t j = (c / dims[0]) % dims[1];
+      size_t k = c / (dims[0] * dims[1]);
+      featureIds[c] = static_cast<int32_t>(((i / 3) * 7919 + (j / 2) * 104729 + (k / 2) * 1299709) % numFeatures);
+      if(noiseDist(generator) == 0)
+      {
+        featureIds[c] = -1;
+      }
+    }
+
+    std::vector<uint64_t> counts(numFeatures, 0);
+    std::vector<double> sums(numFeatures * 3, 0.0);
+    std::vector<double> m2(numFeatures * 6, 0.0);
+    std::vector<size_t> minIndex(numFeatures * 3, std::numeric_limits<size_t>::max());
+    std::vector<size_t> maxIndex(numFeatures * 3, 0);
+    for(int32_t pass = 0; pass < 2; pass++)
+    {
+      for(size_t c = 0; c < numCells; c++)
+      {
+        if(featureIds[c] < 0)
+        {
+          continue;
+        }
+        size_t f = static_cast<size_t>(featureIds[c]);
+        size_t index[3] = {c % dims[0], (c / dims[0]) % dims[1], c / (dims[0] * dims[1])};
+        double coords[3] = {0.0, 0.0, 0.0};
+        for(size_t d = 0; d < 3; d++)
+        {
+          coords[d] = origin[d] + static_cast<double>(index[d]) * spacing[d];
+        }
+        if(pass == 0)
+        {
+          counts[f]++;
+          for(size_t d = 0; d < 3; d++)
+          {
+            sums[f * 3 + d] += coords[d];
+            minIndex[f * 3 + d] = std::min(minIndex[f * 3 + d], index[d]);
+            maxIndex[f * 3 + d] = std::max(maxIndex[f * 3 + d], index[d]);
+          }
+          continue;
+        }
+        double dev[3] = {0.0, 0.0, 0.0};
+        for(size_t d = 0; d < 3; d++)
+        {
+          dev[d] = coords[d] - sums[f * 3 + d] / static_cast<double>(counts[f]);
+        }
+        m2[f * 6 + 0] += dev[0] * dev[0];
+        m2[f * 6 + 1] += dev[1] * dev[1];
+        m2[f * 6 + 2] += dev[2] * dev[2];
+        m2[f * 6 + 3] += dev[0] * dev[1];
+        m2[f * 6 + 4] += dev[1] * dev[2];
+        m2[f * 6 + 5] += dev[0] * dev[2];
+      }
+    }
+
+    for(int32_t order = 0; order <= 2; order++)
+    {
+      FeatureMoments moments;
+      moments.compute(featureIds.data(), numFeatures, dims, origin, spacing, static_cast<FeatureMoments::Order>(order));
+      DREAM3D_REQUIRE_EQUAL(moments.getNumberOfFeatures(), numFeatures)
+      for(size_t f = 0; f < numFeatures; f++)
+      {
+        DREAM3D_REQUIRE_EQUAL(moments.getCount(f), counts[f])
+        if(order == 0 || counts[f] == 0)
+        {
+          continue;
+        }
+        const FeatureMoments::Accumulator& feature = moments.getFeature(f);
+        for(size_t d = 0; d < 3; d++)
+        {
+          DREAM3D_REQUIRE_EQUAL(feature.min[d], minIndex[f * 3 + d])
+          DREAM3D_REQUIRE_EQUAL(feature.max[d], maxIndex[f * 3 + d])
+          DREAM3D_REQUIRE(std::fabs(feature.mean[d] - sums[f * 3 + d] / static_cast<double>(counts[f])) < 1.0e-9)
+        }
+        if(order == 2)
+        {
+          for(size_t m = 0; m < 6; m++)
+          {
+            DREAM3D_REQUIRE(std::fabs(feature.m2[m] - m2[f * 6 + m]) < 1.0e-9 * (1.0 + std::fabs(m2[f * 6 + m])))
+          }
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // Few Features: every slab gets dense accumulators indexed by Feature Id
+  // -----------------------------------------------------------------------------
+  void TestFewFeatures()
+  {
+    CompareWithTwoPassSums(50);
+  }
+
+  // -----------------------------------------------------------------------------
+  // Many Features: the dense slab accumulators would exceed their budget, so every slab only keeps
+  // the Features it contains
+  // -----------------------------------------------------------------------------
+  void TestManyFeatures()
+  {
+    CompareWithTwoPassSums(30000);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "---- " << getNameOfClass().toStdString() << " ----" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestFewFeatures())
+    DREAM3D_REGISTER_TEST(TestManyFeatures())
+  }
+};
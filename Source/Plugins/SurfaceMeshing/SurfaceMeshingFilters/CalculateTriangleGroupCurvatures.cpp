@@ -33,30 +33,207 @@
 *
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
+
 #include "CalculateTriangleGroupCurvatures.h"
 
-#include <QtCore/QtGlobal>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-#include <tbb/task.h>
-#include <tbb/task_group.h>
-#include <tbb/task_scheduler_init.h>
-#endif
+#include <QtCore/QtGlobal>
 
 #include <Eigen/Dense>
 
 #include "SIMPLib/Geometry/TriangleGeom.h"
 #include "SIMPLib/Math/MatrixMath.h"
-#include "SurfaceMeshing/SurfaceMeshingFilters/FindNRingNeighbors.h"
+
+namespace
+{
+/**
+ * @brief The StampedTriangleSet class is the set of triangle ids of one N-ring patch. Membership is
+ * tested with a small open addressing table whose slots are tagged with a generation number, so
+ * starting a new patch only bumps the generation instead of clearing the table. The members are also
+ * kept in insertion order, which is breadth first order when the set is grown ring by ring.
+ */
+class StampedTriangleSet
+{
+public:
+  StampedTriangleSet()
+  {
+    resize(k_InitialCapacity);
+  }
+
+  void clear()
+  {
+    m_Members.clear();
+    m_Generation++;
+    if(m_Generation == 0)
+    {
+      std::fill(m_Stamps.begin(), m_Stamps.end(), 0);
+      m_Generation = 1;
+    }
+  }
+
+  bool insert(int64_t id)
+  {
+    if((m_Members.size() + 1) * 2 > m_Keys.size())
+    {
+      resize(m_Keys.size() * 2);
+    }
+    size_t slot = hash(id);
+    while(m_Stamps[slot] == m_Generation)
+    {
+      if(m_Keys[slot] == id)
+      {
+        return false;
+      }
+      slot = (slot + 1) & m_Mask;
+    }
+    m_Stamps[slot] = m_Generation;
+    m_Keys[slot] = id;
+    m_Members.push_back(id);
+    return true;
+  }
+
+  std::vector<int64_t>& members()
+  {
+    return m_Members;
+  }
+
+private:
+  static const size_t k_InitialCapacity = 256;
+
+  size_t hash(int64_t id) const
+  {
+    uint64_t h = static_cast<uint64_t>(id) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<size_t>(h ^ (h >> 32)) & m_Mask;
+  }
+
+  void resize(size_t capacity)
+  {
+    m_Keys.assign(capacity, 0);
+    m_Stamps.assign(capacity, 0);
+    m_Mask = capacity - 1;
+    m_Generation = 1;
+    for(const int64_t& id : m_Members)
+    {
+      size_t slot = hash(id);
+      while(m_Stamps[slot] == m_Generation)
+      {
+        slot = (slot + 1) & m_Mask;
+      }
+      m_Stamps[slot] = m_Generation;
+      m_Keys[slot] = id;
+    }
+  }
+
+  std::vector<int64_t> m_Keys;
+  std::vector<uint32_t> m_Stamps;
+  std::vector<int64_t> m_Members;
+  uint32_t m_Generation = 1;
+  size_t m_Mask = 0;
+};
+
+/**
+ * @brief FillDesignRow Fills one row of the quadratic least squares system
+ */
+inline void FillDesignRow(Eigen::Matrix<double, 3, 1>& row, double x, double y)
+{
+  row(0) = 0.5 * x * x; // 1/2 x^2
+  row(1) = x * y;       // x*y
+  row(2) = 0.5 * y * y; // 1/2 y^2
+}
+
+/**
+ * @brief FillDesignRow Fills one row of the cubic least squares system
+ */
+inline void FillDesignRow(Eigen::Matrix<double, 7, 1>& row, double x, double y)
+{
+  row(0) = 0.5 * x * x; // 1/2 x^2
+  row(1) = x * y;       // x*y
+  row(2) = 0.5 * y * y; // 1/2 y^2
+  row(3) = x * x * x;
+  row(4) = x * x * y;
+  row(5) = x * y * y;
+  row(6) = y * y * y;
+}
+
+/**
+ * @brief FitWeingartenMatrix Solves the least squares fit of z = 1/2 A x^2 + B xy + 1/2 C y^2 (plus the cubic
+ * terms D x^3 + E x^2 y + F x y^2 + G y^3 when Cols is 7) to the local patch coordinates. The design matrix
+ * itself is factored, never its normal equations: every row is rotated into a fixed size upper triangular
+ * factor R with Givens rotations, which is the R of a QR factorization of the design matrix. The reduced
+ * Cols x Cols system is then solved with a column pivoting QR just like the full system was, so rank
+ * deficient patches still get the basic solution, and nothing is allocated on the heap regardless of the
+ * size of the patch.
+ * @param coords Local x, y, z coordinates of the patch centroids
+ * @param count Number of centroids
+ * @return The symmetric 2x2 Weingarten matrix [A B; B C]
+ */
+template <int Cols>
+Eigen::Matrix2d FitWeingartenMatrix(const double* coords, size_t count)
+{
+  typedef Eigen::Matrix<double, Cols, Cols> SquareMatrix;
+  typedef Eigen::Matrix<double, Cols, 1> ColVector;
+
+  SquareMatrix R = SquareMatrix::Zero();
+  ColVector qtb = ColVector::Zero();
+  ColVector row;
+  for(size_t m = 0; m < count; ++m)
+  {
+    double z = coords[m * 3 + 2];
+    FillDesignRow(row, coords[m * 3], coords[m * 3 + 1]);
+    for(int k = 0; k < Cols; ++k)
+    {
+      if(row(k) == 0.0)
+      {
+        continue;
+      }
+      double r = std::hypot(R(k, k), row(k));
+      double c = R(k, k) / r;
+      double s = row(k) / r;
+      R(k, k) = r;
+      row(k) = 0.0;
+      for(int j = k + 1; j < Cols; ++j)
+      {
+        double rkj = R(k, j);
+        R(k, j) = c * rkj + s * row(j);
+        row(j) = c * row(j) - s * rkj;
+      }
+      double qk = qtb(k);
+      qtb(k) = c * qk + s * z;
+      z = c * z - s * qk;
+    }
+  }
+
+  // The columns of R have the norms of the columns of the design matrix. Equilibrate them so the
+  // rank decision of the pivoting QR does not depend on the size of the patch.
+  ColVector scale;
+  for(int c = 0; c < Cols; ++c)
+  {
+    double norm = R.col(c).norm();
+    scale(c) = norm > 0.0 ? 1.0 / norm : 1.0;
+  }
+  R = R * scale.asDiagonal();
+
+  ColVector sln1 = Eigen::ColPivHouseholderQR<SquareMatrix>(R).solve(qtb);
+  sln1 = scale.cwiseProduct(sln1);
+
+  Eigen::Matrix2d M;
+  M << sln1(0), sln1(1), sln1(1), sln1(2);
+  return M;
+}
+} // namespace
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-CalculateTriangleGroupCurvatures::CalculateTriangleGroupCurvatures(int64_t nring, std::vector<int64_t> triangleIds, bool useNormalsForCurveFitting, DoubleArrayType::Pointer principleCurvature1,
-                                                                   DoubleArrayType::Pointer principleCurvature2, DoubleArrayType::Pointer principleDirection1,
-                                                                   DoubleArrayType::Pointer principleDirection2, DoubleArrayType::Pointer gaussianCurvature, DoubleArrayType::Pointer meanCurvature,
-                                                                   TriangleGeom::Pointer trianglesGeom, DataArray<int32_t>::Pointer surfaceMeshFaceLabels,
-                                                                   DataArray<double>::Pointer surfaceMeshFaceNormals, DataArray<double>::Pointer surfaceMeshTriangleCentroids, AbstractFilter* parent)
+CalculateTriangleGroupCurvatures::CalculateTriangleGroupCurvatures(int64_t nring, const std::vector<int64_t>& triangleIds, bool useNormalsForCurveFitting,
+                                                                   DoubleArrayType::Pointer principleCurvature1, DoubleArrayType::Pointer principleCurvature2,
+                                                                   DoubleArrayType::Pointer principleDirection1, DoubleArrayType::Pointer principleDirection2,
+                                                                   DoubleArrayType::Pointer gaussianCurvature, DoubleArrayType::Pointer meanCurvature, TriangleGeom::Pointer trianglesGeom,
+                                                                   DataArray<int32_t>::Pointer surfaceMeshFaceLabels, DataArray<double>::Pointer surfaceMeshFaceNormals,
+                                                                   DataArray<double>::Pointer surfaceMeshTriangleCentroids, AbstractFilter* parent)
 : m_NRing(nring)
 , m_TriangleIds(triangleIds)
 , m_UseNormalsForCurveFitting(useNormalsForCurveFitting)
@@ -82,84 +259,82 @@ CalculateTriangleGroupCurvatures::~CalculateTriangleGroupCurvatures() = default;
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void subtractVector3d(DataArray<double>::Pointer data, double* v)
+void CalculateTriangleGroupCurvatures::convert(size_t start, size_t end) const
 {
-  size_t count = data->getNumberOfTuples();
-  for(size_t i = 0; i < count; ++i)
-  {
-    double* ptr = data->getPointer(i * 3);
-    ptr[0] = ptr[0] - v[0];
-    ptr[1] = ptr[1] - v[1];
-    ptr[2] = ptr[2] - v[2];
-  }
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void CalculateTriangleGroupCurvatures::operator()() const
-{
-  int32_t err = 0;
-
-  if(m_TriangleIds.size() == 0)
-  {
-    return;
-  }
-
-  // Instantiate a FindNRingNeighbors class to use during the loop
-  FindNRingNeighbors::Pointer nRingNeighborAlg = FindNRingNeighbors::New();
+  ElementDynamicList::Pointer node2TrianglePtr = m_TrianglesPtr->getElementsContainingVert();
+  Q_ASSERT(node2TrianglePtr.get() != nullptr);
 
+  int64_t* triangles = m_TrianglesPtr->getTriPointer(0);
   int32_t* faceLabels = m_SurfaceMeshFaceLabels->getPointer(0);
-
-  int32_t* fl = faceLabels + m_TriangleIds[0] * 2;
-  int32_t feature0 = 0;
-  int32_t feature1 = 0;
-  if(fl[0] < fl[1])
-  {
-    feature0 = fl[0];
-    feature1 = fl[1];
-  }
-  else
-  {
-    feature0 = fl[1];
-    feature1 = fl[0];
-  }
+  double* centroids = m_SurfaceMeshTriangleCentroids->getPointer(0);
+  double* normals = m_SurfaceMeshFaceNormals->getPointer(0);
 
   bool computeGaussian = (m_GaussianCurvature.get() != nullptr);
   bool computeMean = (m_MeanCurvature.get() != nullptr);
   bool computeDirection = (m_PrincipleDirection1.get() != nullptr);
 
-  std::vector<int64_t>::size_type tCount = m_TriangleIds.size();
-  // For each triangle in the group
-  for(std::vector<int64_t>::size_type i = 0; i < tCount; ++i)
+  StampedTriangleSet triPatch;
+  std::vector<double> patchCoords;
+
+  for(size_t i = start; i < end; ++i)
   {
-    if(m_ParentFilter->getCancel() == true)
+    if(((i - start) & 0xFF) == 0 && m_ParentFilter->getCancel())
     {
       return;
     }
     int64_t triId = m_TriangleIds[i];
-    nRingNeighborAlg->setTriangleId(triId);
-    nRingNeighborAlg->setRegionId0(feature0);
-    nRingNeighborAlg->setRegionId1(feature1);
-    nRingNeighborAlg->setRing(m_NRing);
-    err = nRingNeighborAlg->generate(m_TrianglesPtr, faceLabels);
-    Q_ASSERT(err >= 0);
-
-    UniqueFaceIds_t triPatch = nRingNeighborAlg->getNRingTriangles();
-    Q_ASSERT(triPatch.size() > 1);
-
-    DataArray<double>::Pointer patchCentroids = extractPatchData(triId, triPatch, m_SurfaceMeshTriangleCentroids->getPointer(0), QString("_INTERNAL_USE_ONLY_Patch_Centroids"));
-    DataArray<double>::Pointer patchNormals = extractPatchData(triId, triPatch, m_SurfaceMeshFaceNormals->getPointer(0), QString("_INTERNAL_USE_ONLY_Patch_Normals"));
-
-    // Translate the patch to the 0,0,0 origin
-    double sub[3] = {patchCentroids->getComponent(0, 0), patchCentroids->getComponent(0, 1), patchCentroids->getComponent(0, 2)};
-    subtractVector3d(patchCentroids, sub);
+    int32_t feature0 = faceLabels[triId * 2];
+    int32_t feature1 = faceLabels[triId * 2 + 1];
+
+    // Grow the N-ring patch one ring at a time; only the triangles added by the previous ring
+    // need to be expanded.
+    triPatch.clear();
+    triPatch.insert(triId);
+    std::vector<int64_t>& members = triPatch.members();
+    size_t ringStart = 0;
+    for(int64_t ring = 0; ring < m_NRing; ++ring)
+    {
+      size_t ringEnd = members.size();
+      for(size_t p = ringStart; p < ringEnd; ++p)
+      {
+        int64_t triangleIdx = members[p];
+        for(int32_t v = 0; v < 3; ++v)
+        {
+          int64_t vert = triangles[triangleIdx * 3 + v];
+          uint16_t tCount = node2TrianglePtr->getNumberOfElements(vert);
+          int64_t* data = node2TrianglePtr->getElementListPointer(vert);
+          for(uint16_t t = 0; t < tCount; ++t)
+          {
+            int64_t tid = data[t];
+            bool check0 = faceLabels[tid * 2] == feature0 && faceLabels[tid * 2 + 1] == feature1;
+            bool check1 = faceLabels[tid * 2 + 1] == feature0 && faceLabels[tid * 2] == feature1;
+            if(check0 || check1)
+            {
+              triPatch.insert(tid);
+            }
+          }
+        }
+      }
+      ringStart = ringEnd;
+      if(ringStart == members.size())
+      {
+        break;
+      }
+    }
 
-    double np[3] = {patchNormals->getComponent(0, 0), patchNormals->getComponent(0, 1), patchNormals->getComponent(0, 2)};
+    // A lone triangle has no neighborhood to fit
+    if(members.size() < 2)
+    {
+      continue;
+    }
 
-    double seedCentroid[3] = {patchCentroids->getComponent(0, 0), patchCentroids->getComponent(0, 1), patchCentroids->getComponent(0, 2)};
-    double firstCentroid[3] = {patchCentroids->getComponent(1, 0), patchCentroids->getComponent(1, 1), patchCentroids->getComponent(1, 2)};
+    // The seed triangle comes first, followed by the rest of the patch in ascending id order. The
+    // second triangle defines the local coordinate frame.
+    std::sort(members.begin() + 1, members.end());
 
+    double* seedCentroid = centroids + triId * 3;
+    double* firstCentroid = centroids + members[1] * 3;
+    double np[3] = {normals[triId * 3], normals[triId * 3 + 1], normals[triId * 3 + 2]};
     double temp[3] = {firstCentroid[0] - seedCentroid[0], firstCentroid[1] - seedCentroid[1], firstCentroid[2] - seedCentroid[2]};
     double vp[3] = {0.0, 0.0, 0.0};
 
@@ -172,111 +347,66 @@ void CalculateTriangleGroupCurvatures::operator()() const
     double up[3] = {0.0, 0.0, 0.0};
     MatrixMath::CrossProduct(vp, np, up);
 
-    // this constitutes a rotation matrix to a local coordinate system
-    double rot[3][3] = {{up[0], up[1], up[2]}, {vp[0], vp[1], vp[2]}, {np[0], np[1], np[2]}};
-    double out[3] = {0.0, 0.0, 0.0};
-    // Transform all centroids and normals to new coordinate system
-    for(size_t m = 0; m < patchCentroids->getNumberOfTuples(); ++m)
+    // Translate the patch to the 0,0,0 origin and rotate it into the local coordinate system
+    // whose rows are up, vp and np
+    size_t count = members.size();
+    patchCoords.resize(count * 3);
+    for(size_t m = 0; m < count; ++m)
     {
-      ::memcpy(out, patchCentroids->getPointer(m * 3), 3 * sizeof(double));
-      MatrixMath::Multiply3x3with3x1(rot, patchCentroids->getPointer(m * 3), out);
-      ::memcpy(patchCentroids->getPointer(m * 3), out, 3 * sizeof(double));
-
-      ::memcpy(out, patchNormals->getPointer(m * 3), 3 * sizeof(double));
-      MatrixMath::Multiply3x3with3x1(rot, patchNormals->getPointer(m * 3), out);
-      ::memcpy(patchNormals->getPointer(m * 3), out, 3 * sizeof(double));
-
-      // We rotate the normals now but we dont use them yet. If we start using part 3 of Goldfeathers paper then we
-      // will need the normals.
+      double* c = centroids + members[m] * 3;
+      double d[3] = {c[0] - seedCentroid[0], c[1] - seedCentroid[1], c[2] - seedCentroid[2]};
+      patchCoords[m * 3] = up[0] * d[0] + up[1] * d[1] + up[2] * d[2];
+      patchCoords[m * 3 + 1] = vp[0] * d[0] + vp[1] * d[1] + vp[2] * d[2];
+      patchCoords[m * 3 + 2] = np[0] * d[0] + np[1] * d[1] + np[2] * d[2];
     }
 
+    // Solve the Least Squares fit. Now that we have the A, B, C (and D, E, F & G) constants we can
+    // solve the Eigen value/vector problem to get the principal curvatures and pricipal directions.
+    Eigen::Matrix2d M;
+    if(m_UseNormalsForCurveFitting)
     {
-      // Solve the Least Squares fit
-      static const uint32_t NO_NORMALS = 3;
-      static const uint32_t USE_NORMALS = 7;
-      uint32_t cols = NO_NORMALS;
-      if(m_UseNormalsForCurveFitting == true)
-      {
-        cols = USE_NORMALS;
-      }
-      size_t rows = patchCentroids->getNumberOfTuples();
-      Eigen::MatrixXd A(rows, cols);
-      Eigen::VectorXd b(rows);
-      double x = 0.0, y = 0.0, z = 0.0;
-      for(size_t m = 0; m < rows; ++m)
-      {
-        x = patchCentroids->getComponent(m, 0);
-        y = patchCentroids->getComponent(m, 1);
-        z = patchCentroids->getComponent(m, 2);
-
-        A(m) = 0.5 * x * x;            // 1/2 x^2
-        A(m + rows) = x * y;           // x*y
-        A(m + rows * 2) = 0.5 * y * y; // 1/2 y^2
-        if(m_UseNormalsForCurveFitting == true)
-        {
-          A(m + rows * 3) = x * x * x;
-          A(m + rows * 4) = x * x * y;
-          A(m + rows * 5) = x * y * y;
-          A(m + rows * 6) = y * y * y;
-        }
-        b[m] = z; // The Z Values
-      }
-
-      Eigen::Matrix2d M;
-
-      if(false == m_UseNormalsForCurveFitting)
-      {
-        typedef Eigen::Matrix<double, NO_NORMALS, 1> Vector3d;
-        Vector3d sln1 = A.colPivHouseholderQr().solve(b);
-        // Now that we have the A, B, C constants we can solve the Eigen value/vector problem
-        // to get the principal curvatures and pricipal directions.
-        M << sln1(0), sln1(1), sln1(1), sln1(2);
-      }
-      else
-      {
-        typedef Eigen::Matrix<double, USE_NORMALS, 1> Vector7d;
-        Vector7d sln1 = A.colPivHouseholderQr().solve(b);
-        // Now that we have the A, B, C, D, E, F & G constants we can solve the Eigen value/vector problem
-        // to get the principal curvatures and pricipal directions.
-        M << sln1(0), sln1(1), sln1(1), sln1(2);
-      }
+      M = FitWeingartenMatrix<7>(patchCoords.data(), count);
+    }
+    else
+    {
+      M = FitWeingartenMatrix<3>(patchCoords.data(), count);
+    }
 
-      Eigen::SelfAdjointEigenSolver<Eigen::Matrix2d> eig(M);
-      Eigen::SelfAdjointEigenSolver<Eigen::Matrix2d>::RealVectorType eValues = eig.eigenvalues();
-      Eigen::SelfAdjointEigenSolver<Eigen::Matrix2d>::MatrixType eVectors = eig.eigenvectors();
+    Eigen::SelfAdjointEigenSolver<Eigen::Matrix2d> eig(M);
+    Eigen::SelfAdjointEigenSolver<Eigen::Matrix2d>::RealVectorType eValues = eig.eigenvalues();
+    Eigen::SelfAdjointEigenSolver<Eigen::Matrix2d>::MatrixType eVectors = eig.eigenvectors();
 
-      // Kappa1 >= Kappa2
-      double kappa1 = eValues(0) * -1; // Kappa 1
-      double kappa2 = eValues(1) * -1; // kappa 2
-      Q_ASSERT(kappa1 >= kappa2);
-      m_PrincipleCurvature1->setValue(triId, kappa1);
-      m_PrincipleCurvature2->setValue(triId, kappa2);
+    // Kappa1 >= Kappa2
+    double kappa1 = eValues(0) * -1; // Kappa 1
+    double kappa2 = eValues(1) * -1; // kappa 2
+    Q_ASSERT(kappa1 >= kappa2);
+    m_PrincipleCurvature1->setValue(triId, kappa1);
+    m_PrincipleCurvature2->setValue(triId, kappa2);
 
-      if(computeGaussian == true)
-      {
-        m_GaussianCurvature->setValue(triId, kappa1 * kappa2);
-      }
-      if(computeMean == true)
-      {
-        m_MeanCurvature->setValue(triId, (kappa1 + kappa2) / 2.0);
-      }
+    if(computeGaussian)
+    {
+      m_GaussianCurvature->setValue(triId, kappa1 * kappa2);
+    }
+    if(computeMean)
+    {
+      m_MeanCurvature->setValue(triId, (kappa1 + kappa2) / 2.0);
+    }
 
-      if(computeDirection == true)
-      {
-        Eigen::Matrix3d e_rot_T;
-        e_rot_T.row(0) = Eigen::Vector3d(up[0], vp[0], np[0]);
-        e_rot_T.row(1) = Eigen::Vector3d(up[1], vp[1], np[1]);
-        e_rot_T.row(2) = Eigen::Vector3d(up[2], vp[2], np[2]);
-
-        // Rotate our principal directions back into the original coordinate system
-        Eigen::Vector3d dir1(eVectors.col(0)(0), eVectors.col(0)(1), 0.0);
-        dir1 = e_rot_T * dir1;
-        ::memcpy(m_PrincipleDirection1->getPointer(triId * 3), dir1.data(), 3 * sizeof(double));
-
-        Eigen::Vector3d dir2(eVectors.col(1)(0), eVectors.col(1)(1), 0.0);
-        dir2 = e_rot_T * dir2;
-        ::memcpy(m_PrincipleDirection2->getPointer(triId * 3), dir2.data(), 3 * sizeof(double));
-      }
+    if(computeDirection)
+    {
+      Eigen::Matrix3d e_rot_T;
+      e_rot_T.row(0) = Eigen::Vector3d(up[0], vp[0], np[0]);
+      e_rot_T.row(1) = Eigen::Vector3d(up[1], vp[1], np[1]);
+      e_rot_T.row(2) = Eigen::Vector3d(up[2], vp[2], np[2]);
+
+      // Rotate our principal directions back into the original coordinate system
+      Eigen::Vector3d dir1(eVectors.col(0)(0), eVectors.col(0)(1), 0.0);
+      dir1 = e_rot_T * dir1;
+      ::memcpy(m_PrincipleDirection1->getPointer(triId * 3), dir1.data(), 3 * sizeof(double));
+
+      Eigen::Vector3d dir2(eVectors.col(1)(0), eVectors.col(1)(1), 0.0);
+      dir2 = e_rot_T * dir2;
+      ::memcpy(m_PrincipleDirection2->getPointer(triId * 3), dir2.data(), 3 * sizeof(double));
     }
   } // End Loop over this triangle
 }
@@ -284,28 +414,17 @@ void CalculateTriangleGroupCurvatures::operator()() const
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-DataArray<double>::Pointer CalculateTriangleGroupCurvatures::extractPatchData(int64_t triId, UniqueFaceIds_t& triPatch, double* data, const QString& name) const
+void CalculateTriangleGroupCurvatures::operator()() const
 {
-  QVector<size_t> cDims(1, 3);
-  DataArray<double>::Pointer extractedData = DataArray<double>::CreateArray(triPatch.size(), cDims, name);
-  // This little chunk makes sure the current seed triangles centroid and normal data appear
-  // first in the returned arrays which makes the next steps a tad easier.
-  int32_t i = 0;
-  extractedData->setComponent(i, 0, data[triId * 3]);
-  extractedData->setComponent(i, 1, data[triId * 3 + 1]);
-  extractedData->setComponent(i, 2, data[triId * 3 + 2]);
-  ++i;
-  triPatch.erase(triId);
-
-  for(UniqueFaceIds_t::iterator iter = triPatch.begin(); iter != triPatch.end(); ++iter)
-  {
-    int64_t t = *iter;
-    extractedData->setComponent(i, 0, data[t * 3]);
-    extractedData->setComponent(i, 1, data[t * 3 + 1]);
-    extractedData->setComponent(i, 2, data[t * 3 + 2]);
-    ++i;
-  }
-  triPatch.insert(triId);
+  convert(0, m_TriangleIds.size());
+}
 
-  return extractedData;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CalculateTriangleGroupCurvatures::operator()(const tbb::blocked_range<size_t>& r) const
+{
+  convert(r.begin(), r.end());
 }
+#endif
@@ -33,23 +33,35 @@
 *
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
+
 #pragma once
 
-#include <set>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#endif
 
 #include "SIMPLib/DataArrays/DataArray.hpp"
 #include "SIMPLib/Filtering/AbstractFilter.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
-#include "SIMPLib/SIMPLib.h"
+
 /**
  * @brief The CalculateTriangleGroupCurvatures class calculates the curvature values for a group of triangles
  * where each triangle in the group will have the 2 Principal Curvature values computed and optionally
  * the 2 Principal Directions and optionally the Mean and Gaussian Curvature computed.
+ *
+ * Every triangle is independent of the others, so the work is split at triangle granularity: the class
+ * can be handed to tbb::parallel_for over any sub-range of the triangle list. The N-ring patch of each
+ * triangle is only grown over triangles that share the same pair of Face Labels as the seed triangle.
+ * The vertex to triangle connectivity of the TriangleGeom must exist before the class is used.
  */
 class CalculateTriangleGroupCurvatures
 {
 public:
-  CalculateTriangleGroupCurvatures(int64_t nring, std::vector<int64_t> triangleIds, bool useNormalsForCurveFitting, DoubleArrayType::Pointer principleCurvature1,
+  CalculateTriangleGroupCurvatures(int64_t nring, const std::vector<int64_t>& triangleIds, bool useNormalsForCurveFitting, DoubleArrayType::Pointer principleCurvature1,
                                    DoubleArrayType::Pointer principleCurvature2, DoubleArrayType::Pointer principleDirection1, DoubleArrayType::Pointer principleDirection2,
                                    DoubleArrayType::Pointer gaussianCurvature, DoubleArrayType::Pointer meanCurvature, TriangleGeom::Pointer trianglesGeom,
                                    DataArray<int32_t>::Pointer surfaceMeshFaceLabels, DataArray<double>::Pointer surfaceMeshFaceNormals, DataArray<double>::Pointer surfaceMeshTriangleCentroids,
@@ -57,26 +69,28 @@ public:
 
   virtual ~CalculateTriangleGroupCurvatures();
 
+  /**
+   * @brief convert Computes the curvatures of the triangles at positions [start, end) of the triangle list
+   * @param start First position in the triangle list
+   * @param end One past the last position in the triangle list
+   */
+  void convert(size_t start, size_t end) const;
+
+  /**
+   * @brief operator () Computes the curvatures of every triangle in the triangle list
+   */
   void operator()() const;
 
-  typedef std::set<int64_t> UniqueFaceIds_t;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const;
+#endif
 
 protected:
   CalculateTriangleGroupCurvatures();
 
-  /**
-   * @brief extractPatchData Extracts out the needed data values from the global arrays
-   * @param triId The seed triangle Id
-   * @param triPatch The group of triangles being used
-   * @param data The data to extract from
-   * @param name The name of the data array being used
-   * @return Shared pointer to the extracted data
-   */
-  DataArray<double>::Pointer extractPatchData(int64_t triId, UniqueFaceIds_t& triPatch, double* data, const QString& name) const;
-
 private:
   int64_t m_NRing;
-  std::vector<int64_t> m_TriangleIds;
+  const std::vector<int64_t>& m_TriangleIds;
   bool m_UseNormalsForCurveFitting;
   DoubleArrayType::Pointer m_PrincipleCurvature1;
   DoubleArrayType::Pointer m_PrincipleCurvature2;
@@ -90,4 +104,3 @@ private:
   DataArray<double>::Pointer m_SurfaceMeshTriangleCentroids;
   AbstractFilter* m_ParentFilter;
 };
-
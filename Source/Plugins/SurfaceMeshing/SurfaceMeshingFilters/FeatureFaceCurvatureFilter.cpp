@@ -34,9 +34,12 @@
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "FeatureFaceCurvatureFilter.h"
 
+#include <algorithm>
+
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-#include <tbb/task.h>
-#include <tbb/task_group.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
 #include <tbb/task_scheduler_init.h>
 #endif
 
@@ -49,6 +52,9 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
 
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/GeometryConnectivity.h"
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/SharedFeatureFaceIndex.hpp"
+
 #include "CalculateTriangleGroupCurvatures.h"
 
 // -----------------------------------------------------------------------------
@@ -362,45 +368,20 @@ void FeatureFaceCurvatureFilter::execute()
 
   // Make sure the Face Connectivity is created because the FindNRing algorithm needs this and will
   // assert if the data is NOT in the SurfaceMesh Data Container
-  ElementDynamicList::Pointer vertLinks = triangleGeom->getElementsContainingVert();
-  if(nullptr == vertLinks.get())
-  {
-    triangleGeom->findElementsContainingVert();
-  }
-
-  // get the QMap from the SharedFeatureFaces filter
-  SharedFeatureFaces_t sharedFeatureFaces;
-
-  int32_t maxFaceId = 0;
-  for(int64_t t = 0; t < numTriangles; ++t)
+  if(nullptr == triangleGeom->getElementsContainingVert().get() && GeometryConnectivity::findElementsContainingVert(triangleGeom) < 0)
   {
-    if(m_SurfaceMeshFeatureFaceIds[t] > maxFaceId)
-    {
-      maxFaceId = m_SurfaceMeshFeatureFaceIds[t];
-    }
-  }
-  std::vector<int32_t> faceSizes(maxFaceId + 1, 0);
-  // Loop through all the Triangles and assign each one to a unique Feature Face Id.
-  for(int64_t t = 0; t < numTriangles; ++t)
-  {
-    faceSizes[m_SurfaceMeshFeatureFaceIds[t]]++;
-  }
-
-  // Allocate all the vectors that we need
-  for(size_t iter = 0; iter < faceSizes.size(); ++iter)
-  {
-    FaceIds_t v;
-    v.reserve(faceSizes[iter]);
-    sharedFeatureFaces[iter] = v;
+    QString ss = QObject::tr("Error generating vertex element list for Geometry type %1").arg(triangleGeom->getGeometryTypeAsString());
+    setErrorCondition(-400, ss);
+    return;
   }
 
-  // Loop through all the Triangles and assign each one to a unique Feature Face Id.
-  for(int64_t t = 0; t < numTriangles; ++t)
-  {
-    sharedFeatureFaces[m_SurfaceMeshFeatureFaceIds[t]].push_back(t);
-  }
+  // Take the triangles grouped by Feature Face Id so that the triangles handed to each thread
+  // share their N-ring patches and stay in cache.
+  SharedFeatureFaceIndex faceIndex;
+  faceIndex.buildFromFaceIds(m_SurfaceMeshFeatureFaceIds, static_cast<size_t>(numTriangles));
+  const FaceIds_t& triangleIds = faceIndex.getTriangles();
 
-  m_TotalFeatureFaces = sharedFeatureFaces.size();
+  m_TotalFeatureFaces = static_cast<int32_t>(faceIndex.getNumberOfFaces());
   m_CompletedFeatureFaces = 0;
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
@@ -408,46 +389,36 @@ void FeatureFaceCurvatureFilter::execute()
   bool doParallel = true;
 #endif
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  std::shared_ptr<tbb::task_group> g(new tbb::task_group);
-#else
-
-#endif
-  // typedef here for conveneince
-  typedef SharedFeatureFaces_t::iterator SharedFeatureFaceIterator_t;
+  // Every triangle is an independent unit of work, so a few very large Feature Faces no longer
+  // serialize the filter. The triangles are processed in batches to report progress.
+  CalculateTriangleGroupCurvatures curvature(m_NRing, triangleIds, m_UseNormalsForCurveFitting, m_SurfaceMeshPrincipalCurvature1sPtr.lock(), m_SurfaceMeshPrincipalCurvature2sPtr.lock(),
+                                             m_SurfaceMeshPrincipalDirection1sPtr.lock(), m_SurfaceMeshPrincipalDirection2sPtr.lock(), m_SurfaceMeshGaussianCurvaturesPtr.lock(),
+                                             m_SurfaceMeshMeanCurvaturesPtr.lock(), triangleGeom, m_SurfaceMeshFaceLabelsPtr.lock(), m_SurfaceMeshFaceNormalsPtr.lock(),
+                                             m_SurfaceMeshTriangleCentroidsPtr.lock(), this);
 
-  for(SharedFeatureFaceIterator_t iter = sharedFeatureFaces.begin(); iter != sharedFeatureFaces.end(); ++iter)
+  const size_t batchSize = 65536;
+  size_t totalTriangles = static_cast<size_t>(numTriangles);
+  for(size_t start = 0; start < totalTriangles; start += batchSize)
   {
-    QString ss = QObject::tr("Working on Face Id %1/%2").arg((*iter).first).arg(maxFaceId);
-    notifyStatusMessage(ss);
-
-    FaceIds_t& triangleIds = (*iter).second;
+    size_t end = std::min(start + batchSize, totalTriangles);
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    if(doParallel == true)
+    if(doParallel)
     {
-      g->run(CalculateTriangleGroupCurvatures(m_NRing, triangleIds, m_UseNormalsForCurveFitting, m_SurfaceMeshPrincipalCurvature1sPtr.lock(), m_SurfaceMeshPrincipalCurvature2sPtr.lock(),
-                                              m_SurfaceMeshPrincipalDirection1sPtr.lock(), m_SurfaceMeshPrincipalDirection2sPtr.lock(), m_SurfaceMeshGaussianCurvaturesPtr.lock(),
-                                              m_SurfaceMeshMeanCurvaturesPtr.lock(), triangleGeom, m_SurfaceMeshFaceLabelsPtr.lock(), m_SurfaceMeshFaceNormalsPtr.lock(),
-                                              m_SurfaceMeshTriangleCentroidsPtr.lock(), this));
+      tbb::parallel_for(tbb::blocked_range<size_t>(start, end, 64), curvature, tbb::auto_partitioner());
     }
     else
 #endif
     {
-      CalculateTriangleGroupCurvatures curvature(m_NRing, triangleIds, m_UseNormalsForCurveFitting, m_SurfaceMeshPrincipalCurvature1sPtr.lock(), m_SurfaceMeshPrincipalCurvature2sPtr.lock(),
-                                                 m_SurfaceMeshPrincipalDirection1sPtr.lock(), m_SurfaceMeshPrincipalDirection2sPtr.lock(), m_SurfaceMeshGaussianCurvaturesPtr.lock(),
-                                                 m_SurfaceMeshMeanCurvaturesPtr.lock(), triangleGeom, m_SurfaceMeshFaceLabelsPtr.lock(), m_SurfaceMeshFaceNormalsPtr.lock(),
-                                                 m_SurfaceMeshTriangleCentroidsPtr.lock(), this);
-      curvature();
+      curvature.convert(start, end);
     }
-  }
-// *********************** END END END END END END  ********************************************************************
-
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  g->wait(); // Wait for all the threads to complete before moving on.
-  
-#endif
-
 
+    if(getCancel())
+    {
+      return;
+    }
+    QString ss = QObject::tr("%1/%2 Triangles Complete").arg(end).arg(totalTriangles);
+    notifyStatusMessage(ss);
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -36,6 +36,8 @@
 
 #include "FindNRingNeighbors.h"
 
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/GeometryConnectivity.h"
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -86,7 +88,7 @@ int32_t FindNRingNeighbors::generate(TriangleGeom::Pointer triangleGeom, int32_t
   ElementDynamicList::Pointer node2TrianglePtr = triangleGeom->getElementsContainingVert();
   if(node2TrianglePtr.get() == nullptr)
   {
-    err = triangleGeom->findElementsContainingVert();
+    err = GeometryConnectivity::findElementsContainingVert(triangleGeom);
     if(err < 0)
     {
       return err;
@@ -35,6 +35,8 @@
 
 #include "FindTriangleGeomShapes.h"
 
+#include <vector>
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AttributeMatrixSelectionFilterParameter.h"
@@ -48,6 +50,7 @@
 
 #include "SurfaceMeshing/SurfaceMeshingConstants.h"
 #include "SurfaceMeshing/SurfaceMeshingVersion.h"
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/TriangleMetrics.h"
 
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
 enum createdPathID : RenameDataPath::DataID_t
@@ -214,111 +217,6 @@ void FindTriangleGeomShapes::preflight()
   setInPreflight(false);
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void FindTriangleGeomShapes::findTetrahedronInfo(int64_t vertIds[3], float* vertPtr, float centroid[3], float tetInfo[32])
-{
-	double coords[30];
-	coords[0] = vertPtr[3 * vertIds[0] + 0];
-	coords[1] = vertPtr[3 * vertIds[0] + 1];
-	coords[2] = vertPtr[3 * vertIds[0] + 2];
-	coords[3] = vertPtr[3 * vertIds[1] + 0];
-	coords[4] = vertPtr[3 * vertIds[1] + 1];
-	coords[5] = vertPtr[3 * vertIds[1] + 2];
-	coords[6] = vertPtr[3 * vertIds[2] + 0];
-	coords[7] = vertPtr[3 * vertIds[2] + 1];
-	coords[8] = vertPtr[3 * vertIds[2] + 2];
-	coords[9] = centroid[0];
-	coords[10] = centroid[1];
-	coords[11] = centroid[2];
-	coords[12] = 0.5 * (vertPtr[3 * vertIds[0] + 0] + centroid[0]);
-	coords[13] = 0.5 * (vertPtr[3 * vertIds[0] + 1] + centroid[1]);
-	coords[14] = 0.5 * (vertPtr[3 * vertIds[0] + 2] + centroid[2]);
-	coords[15] = 0.5 * (vertPtr[3 * vertIds[1] + 0] + centroid[0]);
-	coords[16] = 0.5 * (vertPtr[3 * vertIds[1] + 1] + centroid[1]);
-	coords[17] = 0.5 * (vertPtr[3 * vertIds[1] + 2] + centroid[2]);
-	coords[18] = 0.5 * (vertPtr[3 * vertIds[2] + 0] + centroid[0]);
-	coords[19] = 0.5 * (vertPtr[3 * vertIds[2] + 1] + centroid[1]);
-	coords[20] = 0.5 * (vertPtr[3 * vertIds[2] + 2] + centroid[2]);
-	coords[21] = 0.5 * (vertPtr[3 * vertIds[0] + 0] + vertPtr[3 * vertIds[1] + 0]);
-	coords[22] = 0.5 * (vertPtr[3 * vertIds[0] + 1] + vertPtr[3 * vertIds[1] + 1]);
-	coords[23] = 0.5 * (vertPtr[3 * vertIds[0] + 2] + vertPtr[3 * vertIds[1] + 2]);
-	coords[24] = 0.5 * (vertPtr[3 * vertIds[1] + 0] + vertPtr[3 * vertIds[2] + 0]);
-	coords[25] = 0.5 * (vertPtr[3 * vertIds[1] + 1] + vertPtr[3 * vertIds[2] + 1]);
-	coords[26] = 0.5 * (vertPtr[3 * vertIds[1] + 2] + vertPtr[3 * vertIds[2] + 2]);
-	coords[27] = 0.5 * (vertPtr[3 * vertIds[2] + 0] + vertPtr[3 * vertIds[0] + 0]);
-	coords[28] = 0.5 * (vertPtr[3 * vertIds[2] + 1] + vertPtr[3 * vertIds[0] + 1]);
-	coords[29] = 0.5 * (vertPtr[3 * vertIds[2] + 2] + vertPtr[3 * vertIds[0] + 2]);
-
-	int32_t tets[32];
-	tets[0] = 4;
-	tets[1] = 5;
-	tets[2] = 6;
-	tets[3] = 3;
-
-	tets[4] = 0;
-	tets[5] = 7;
-	tets[6] = 9;
-	tets[7] = 4;
-
-	tets[8] = 1;
-	tets[9] = 8;
-	tets[10] = 7;
-	tets[11] = 5;
-
-	tets[12] = 2;
-	tets[13] = 9;
-	tets[14] = 8;
-	tets[15] = 6;
-
-	tets[16] = 7;
-	tets[17] = 5;
-	tets[18] = 6;
-	tets[19] = 4;
-
-	tets[20] = 6;
-	tets[21] = 9;
-	tets[22] = 7;
-	tets[23] = 4;
-
-	tets[24] = 6;
-	tets[25] = 5;
-	tets[26] = 7;
-	tets[27] = 8;
-
-	tets[28] = 7;
-	tets[29] = 9;
-	tets[30] = 6;
-	tets[31] = 8;
-
-	for (size_t iter = 0; iter < 8; iter++)
-	{
-		float ax = coords[3 * tets[4 * iter + 0] + 0];
-		float ay = coords[3 * tets[4 * iter + 0] + 1];
-		float az = coords[3 * tets[4 * iter + 0] + 2];
-		float bx = coords[3 * tets[4 * iter + 1] + 0];
-		float by = coords[3 * tets[4 * iter + 1] + 1];
-		float bz = coords[3 * tets[4 * iter + 1] + 2];
-		float cx = coords[3 * tets[4 * iter + 2] + 0];
-		float cy = coords[3 * tets[4 * iter + 2] + 1];
-		float cz = coords[3 * tets[4 * iter + 2] + 2];
-		float dx = coords[3 * tets[4 * iter + 3] + 0];
-		float dy = coords[3 * tets[4 * iter + 3] + 1];
-		float dz = coords[3 * tets[4 * iter + 3] + 2];
-
-		float vertMatrix[3][3] = { { bx - ax, cx - ax, dx - ax },
-								   { by - ay, cy - ay, dy - ay },
-								   { bz - az, cz - az, dz - az } };
-
-		tetInfo[4 * iter + 0] = (MatrixMath::Determinant3x3(vertMatrix) / 6.0f);
-		tetInfo[4 * iter + 1] = 0.25 * (ax + bx + cx + dx);
-		tetInfo[4 * iter + 2] = 0.25 * (ay + by + cy + dy);
-		tetInfo[4 * iter + 3] = 0.25 * (az + bz + cz + dz);
-	}
-
-}
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -337,7 +235,6 @@ void FindTriangleGeomShapes::find_moments()
   float u110 = 0.0f;
   float u011 = 0.0f;
   float u101 = 0.0f;
-  float xx = 0.0f, yy = 0.0f, zz = 0.0f, xy = 0.0f, xz = 0.0f, yz = 0.0f;
   size_t numfeatures = m_CentroidsPtr.lock()->getNumberOfTuples();
   m_FeatureMoments->resizeTuples(numfeatures * 6);
   featuremoments = m_FeatureMoments->getPointer(0);
@@ -352,48 +249,26 @@ void FindTriangleGeomShapes::find_moments()
     featuremoments[6 * i + 5] = 0.0f;
   }
 
-  float centroid[3];
-  float tetInfo[32];
-  int64_t vertIds[3];
-  double xdist = 0.0f;
-  double ydist = 0.0f;
-  double zdist = 0.0f;
+  // Each side of a triangle closes a tetrahedron with the centroid of its Feature; the moments
+  // of all those tetrahedra are computed in one sweep and then summed per Feature
+  std::vector<double> triangleMoments(numFaces * 12);
+  TriangleMetrics::Outputs outputs;
+  outputs.featureMoments = triangleMoments.data();
+  TriangleMetrics::compute(vertPtr, triangles->getTriPointer(0), numFaces, outputs, m_FaceLabels, m_Centroids);
 
-  for (size_t i = 0; i < numFaces; i++)
+  for(size_t i = 0; i < numFaces; i++)
   {
-	  triangles->getVertsAtTri(i, vertIds);
-	  for (size_t j = 0; j < 2; j++)
-	  {
-		  if (j == 1) { std::swap(vertIds[2], vertIds[1]); }
-		  int32_t gnum = m_FaceLabels[2 * i + j];
-		  if (gnum > 0)
-		  {
-			  centroid[0] = m_Centroids[3 * gnum + 0];
-			  centroid[1] = m_Centroids[3 * gnum + 1];
-			  centroid[2] = m_Centroids[3 * gnum + 2];
-			  findTetrahedronInfo(vertIds, vertPtr, centroid, tetInfo);
-			  for (size_t iter = 0; iter < 8; iter++)
-			  {
-				  xdist = (tetInfo[4 * iter + 1] - m_Centroids[gnum * 3 + 0]);
-				  ydist = (tetInfo[4 * iter + 2] - m_Centroids[gnum * 3 + 1]);
-				  zdist = (tetInfo[4 * iter + 3] - m_Centroids[gnum * 3 + 2]);
-
-				  xx = ((ydist)* (ydist)) + ((zdist)* (zdist));
-				  yy = ((xdist)* (xdist)) + ((zdist)* (zdist));
-				  zz = ((xdist)* (xdist)) + ((ydist)* (ydist));
-				  xy = ((xdist)* (ydist));
-				  yz = ((ydist)* (zdist));
-				  xz = ((xdist)* (zdist));
-
-				  featuremoments[gnum * 6 + 0] = featuremoments[gnum * 6 + 0] + (xx * tetInfo[4 * iter + 0]);
-				  featuremoments[gnum * 6 + 1] = featuremoments[gnum * 6 + 1] + (yy * tetInfo[4 * iter + 0]);
-				  featuremoments[gnum * 6 + 2] = featuremoments[gnum * 6 + 2] + (zz * tetInfo[4 * iter + 0]);
-				  featuremoments[gnum * 6 + 3] = featuremoments[gnum * 6 + 3] + (xy * tetInfo[4 * iter + 0]);
-				  featuremoments[gnum * 6 + 4] = featuremoments[gnum * 6 + 4] + (yz * tetInfo[4 * iter + 0]);
-				  featuremoments[gnum * 6 + 5] = featuremoments[gnum * 6 + 5] + (xz * tetInfo[4 * iter + 0]);
-			  }
-		  }
-	  }
+    for(size_t j = 0; j < 2; j++)
+    {
+      int32_t gnum = m_FaceLabels[2 * i + j];
+      if(gnum > 0)
+      {
+        for(size_t k = 0; k < 6; k++)
+        {
+          featuremoments[gnum * 6 + k] += triangleMoments[i * 12 + j * 6 + k];
+        }
+      }
+    }
   }
   double sphere = (2000.0 * M_PI * M_PI) / 9.0;
   double o3 = 0.0, vol5 = 0.0, omega3 = 0.0;
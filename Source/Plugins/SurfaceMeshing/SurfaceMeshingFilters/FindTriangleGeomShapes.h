@@ -185,17 +185,6 @@ protected:
    */
   void initialize();
 
-  /**
-   * @brief findTetrahedronInfo Creates a tetrahedron using the given vertex ids as the base
-   * and the given centroid as the fourth element; the tetrahedron is then subdivided into
-   * 8 smaller tetrahedra, and for each tetrahedron the volume is computed
-   * @param vertIds Base triangle vertices
-   * @param vertPtr Vertex coordinates pointer
-   * @param centroid Fourth vertex (centroid of feature)
-   * @param tetInfo Array to store information about subdivided tetrahedra
-   */
-  void findTetrahedronInfo(int64_t vertIds[3], float* vertPtr, float centroid[3], float tetInfo[32]);
-
   /**
    * @brief find_moments Determines the second order moments for each Feature
    */
@@ -36,6 +36,7 @@
 #include "FindTriangleGeomSizes.h"
 
 #include <set>
+#include <vector>
 
 #include "SIMPLib/Common/Constants.h"
 
@@ -44,10 +45,10 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
-#include "SIMPLib/Math/MatrixMath.h"
 
 #include "SurfaceMeshing/SurfaceMeshingConstants.h"
 #include "SurfaceMeshing/SurfaceMeshingVersion.h"
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/TriangleMetrics.h"
 
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
 enum createdPathID : RenameDataPath::DataID_t
@@ -158,25 +159,6 @@ void FindTriangleGeomSizes::preflight()
   setInPreflight(false); // Inform the system this filter is NOT in preflight mode anymore.
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-float FindTriangleGeomSizes::findTetrahedronVolume(int64_t vertIds[3], float* vertPtr)
-{
-  float vertMatrix[3][3] = { { vertPtr[3 * vertIds[1] + 0] - vertPtr[3 * vertIds[0] + 0],
-                               vertPtr[3 * vertIds[2] + 0] - vertPtr[3 * vertIds[0] + 0],
-                                                      0.0f - vertPtr[3 * vertIds[0] + 0] },
-                             { vertPtr[3 * vertIds[1] + 1] - vertPtr[3 * vertIds[0] + 1],
-                               vertPtr[3 * vertIds[2] + 1] - vertPtr[3 * vertIds[0] + 1],
-                                                      0.0f - vertPtr[3 * vertIds[0] + 1] },
-                             { vertPtr[3 * vertIds[1] + 2] - vertPtr[3 * vertIds[0] + 2],
-                               vertPtr[3 * vertIds[2] + 2] - vertPtr[3 * vertIds[0] + 2],
-                                                      0.0f - vertPtr[3 * vertIds[0] + 2] }
-                           };
-
-  return (MatrixMath::Determinant3x3(vertMatrix) / 6.0f);
-}
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -206,28 +188,29 @@ void FindTriangleGeomSizes::execute()
   featAttrMat->resizeAttributeArrays(tDims);
   m_Volumes = m_VolumesPtr.lock()->getPointer(0);
 
-  int64_t vertsAtTri[3] = {0, 0, 0};
+  // Each triangle closes a tetrahedron with the origin; its signed volume counts positively for
+  // the Feature on the first side of the triangle and negatively for the one on the second side
+  std::vector<double> signedVolumes(numTriangles);
+  TriangleMetrics::Outputs outputs;
+  outputs.signedVolumes = signedVolumes.data();
+  TriangleMetrics::compute(vertPtr, triangles->getTriPointer(0), numTriangles, outputs);
 
+  std::vector<double> volumes(tDims[0], 0.0);
   for(int64_t i = 0; i < numTriangles; i++)
   {
-    triangles->getVertsAtTri(i, vertsAtTri);
-    if(m_FaceLabels[2 * i + 0] == -1)
+    if(m_FaceLabels[2 * i + 0] != -1)
     {
-      std::swap(vertsAtTri[2], vertsAtTri[1]);
-      m_Volumes[m_FaceLabels[2 * i + 1]] += findTetrahedronVolume(vertsAtTri, vertPtr);
+      volumes[m_FaceLabels[2 * i + 0]] += signedVolumes[i];
     }
-    else if(m_FaceLabels[2 * i + 1] == -1)
+    if(m_FaceLabels[2 * i + 1] != -1)
     {
-      m_Volumes[m_FaceLabels[2 * i + 0]] += findTetrahedronVolume(vertsAtTri, vertPtr);
-    }
-    else
-    {
-      m_Volumes[m_FaceLabels[2 * i + 0]] += findTetrahedronVolume(vertsAtTri, vertPtr);
-      std::swap(vertsAtTri[2], vertsAtTri[1]);
-      m_Volumes[m_FaceLabels[2 * i + 1]] += findTetrahedronVolume(vertsAtTri, vertPtr);
+      volumes[m_FaceLabels[2 * i + 1]] -= signedVolumes[i];
     }
   }
-
+  for(size_t i = 0; i < volumes.size(); i++)
+  {
+    m_Volumes[i] = static_cast<float>(volumes[i]);
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -41,6 +41,7 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 
 #include "SurfaceMeshing/SurfaceMeshingConstants.h"
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/GeometryConnectivity.h"
 #include "SurfaceMeshing/SurfaceMeshingVersion.h"
 
 // -----------------------------------------------------------------------------
@@ -133,7 +134,7 @@ void GenerateGeometryConnectivity::execute()
   if(m_GenerateVertexTriangleLists || m_GenerateTriangleNeighbors)
   {
     notifyStatusMessage("Generating Vertex Element List");
-    int err = geom->findElementsContainingVert();
+    int err = GeometryConnectivity::findElementsContainingVert(geom);
     if(err < 0)
     {
       QString ss = QObject::tr("Error generating vertex element list for Geometry type %1").arg(geom->getGeometryTypeAsString());
@@ -143,7 +144,7 @@ void GenerateGeometryConnectivity::execute()
   if(m_GenerateTriangleNeighbors)
   {
     notifyStatusMessage("Generating Element Neighbors List");
-    int err = geom->findElementNeighbors();
+    int err = GeometryConnectivity::findElementNeighbors(geom);
     if(err < 0)
     {
       QString ss = QObject::tr("Error generating element neighbor list for Geometry type %1").arg(geom->getGeometryTypeAsString());
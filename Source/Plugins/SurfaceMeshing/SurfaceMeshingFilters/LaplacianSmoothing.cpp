@@ -35,8 +35,11 @@
 
 #include "LaplacianSmoothing.h"
 
+#include <algorithm>
 #include <cstdio>
+#include <limits>
 #include <sstream>
+#include <vector>
 
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
@@ -50,6 +53,258 @@
 #include "SurfaceMeshing/SurfaceMeshingConstants.h"
 #include "SurfaceMeshing/SurfaceMeshingVersion.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+namespace
+{
+/**
+ * @brief mortonSpread Spreads the lower 21 bits of a value so that there are two zero bits
+ * between each of them
+ */
+uint64_t mortonSpread(uint64_t v)
+{
+  v &= 0x1fffff;
+  v = (v | v << 32) & 0x1f00000000ffffULL;
+  v = (v | v << 16) & 0x1f0000ff0000ffULL;
+  v = (v | v << 8) & 0x100f00f00f00f00fULL;
+  v = (v | v << 4) & 0x10c30c30c30c30c3ULL;
+  v = (v | v << 2) & 0x1249249249249249ULL;
+  return v;
+}
+
+/**
+ * @brief The LaplacianGatherImpl class moves a range of vertices by the average of the
+ * difference vectors to their neighbors, scaled by their lambda value. Each vertex only reads
+ * the old positions and writes its own new position, so the vertices can be processed in any
+ * order and in parallel.
+ */
+template <typename IndexType> class LaplacianGatherImpl
+{
+public:
+  LaplacianGatherImpl(const int64_t* offsets, const IndexType* neighbors, const float* lambda, float factor, const float* src, float* dst)
+  : m_Offsets(offsets)
+  , m_Neighbors(neighbors)
+  , m_Lambda(lambda)
+  , m_Factor(factor)
+  , m_Src(src)
+  , m_Dst(dst)
+  {
+  }
+  virtual ~LaplacianGatherImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t v = start; v < end; v++)
+    {
+      const float* p = m_Src + 3 * v;
+      int64_t first = m_Offsets[v];
+      int64_t last = m_Offsets[v + 1];
+      if(first == last)
+      {
+        m_Dst[3 * v + 0] = p[0];
+        m_Dst[3 * v + 1] = p[1];
+        m_Dst[3 * v + 2] = p[2];
+        continue;
+      }
+      double delta[3] = {0.0, 0.0, 0.0};
+      for(int64_t n = first; n < last; n++)
+      {
+        const float* q = m_Src + 3 * static_cast<size_t>(m_Neighbors[n]);
+        delta[0] += q[0] - p[0];
+        delta[1] += q[1] - p[1];
+        delta[2] += q[2] - p[2];
+      }
+      double ncon = static_cast<double>(last - first);
+      float ll = m_Lambda[v] * m_Factor;
+      m_Dst[3 * v + 0] = static_cast<float>(p[0] + ll * (delta[0] / ncon));
+      m_Dst[3 * v + 1] = static_cast<float>(p[1] + ll * (delta[1] / ncon));
+      m_Dst[3 * v + 2] = static_cast<float>(p[2] + ll * (delta[2] / ncon));
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const int64_t* m_Offsets;
+  const IndexType* m_Neighbors;
+  const float* m_Lambda;
+  float m_Factor;
+  const float* m_Src;
+  float* m_Dst;
+};
+
+/**
+ * @brief The LaplacianKernel class holds the vertices of a mesh renumbered along a Morton
+ * (Z order) curve together with their compressed sparse row adjacency. Neighbors are stored
+ * in the order of the shared edge list, so every vertex sums its difference vectors in the
+ * same order as the edge based scatter did.
+ */
+template <typename IndexType> class LaplacianKernel
+{
+public:
+  LaplacianKernel(const float* verts, const float* lambda, size_t nvert, const int64_t* uedges, size_t nedges)
+  : m_NumVerts(nvert)
+  {
+    // Morton order of the vertices inside their bounding box
+    float minCoord[3] = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+    float maxCoord[3] = {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()};
+    for(size_t i = 0; i < nvert; i++)
+    {
+      for(size_t j = 0; j < 3; j++)
+      {
+        minCoord[j] = std::min(minCoord[j], verts[3 * i + j]);
+        maxCoord[j] = std::max(maxCoord[j], verts[3 * i + j]);
+      }
+    }
+    double scale[3] = {0.0, 0.0, 0.0};
+    for(size_t j = 0; j < 3; j++)
+    {
+      double range = static_cast<double>(maxCoord[j]) - static_cast<double>(minCoord[j]);
+      scale[j] = range > 0.0 ? 2097151.0 / range : 0.0;
+    }
+    std::vector<std::pair<uint64_t, IndexType>> codes(nvert);
+    for(size_t i = 0; i < nvert; i++)
+    {
+      uint64_t cx = static_cast<uint64_t>((verts[3 * i + 0] - minCoord[0]) * scale[0]);
+      uint64_t cy = static_cast<uint64_t>((verts[3 * i + 1] - minCoord[1]) * scale[1]);
+      uint64_t cz = static_cast<uint64_t>((verts[3 * i + 2] - minCoord[2]) * scale[2]);
+      codes[i] = std::make_pair(mortonSpread(cx) | (mortonSpread(cy) << 1) | (mortonSpread(cz) << 2), static_cast<IndexType>(i));
+    }
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    tbb::parallel_sort(codes.begin(), codes.end());
+#else
+    std::sort(codes.begin(), codes.end());
+#endif
+
+    m_Order.resize(nvert);
+    std::vector<IndexType> rank(nvert);
+    m_Positions.resize(3 * nvert);
+    m_Scratch.resize(3 * nvert);
+    m_Lambda.resize(nvert);
+    for(size_t v = 0; v < nvert; v++)
+    {
+      IndexType old = codes[v].second;
+      m_Order[v] = old;
+      rank[old] = static_cast<IndexType>(v);
+      m_Positions[3 * v + 0] = verts[3 * old + 0];
+      m_Positions[3 * v + 1] = verts[3 * old + 1];
+      m_Positions[3 * v + 2] = verts[3 * old + 2];
+      m_Lambda[v] = lambda[old];
+    }
+    codes.clear();
+    codes.shrink_to_fit();
+
+    // Compressed sparse row adjacency in the new numbering
+    m_Offsets.assign(nvert + 1, 0);
+    for(size_t e = 0; e < nedges; e++)
+    {
+      m_Offsets[rank[uedges[2 * e]] + 1]++;
+      m_Offsets[rank[uedges[2 * e + 1]] + 1]++;
+    }
+    for(size_t v = 0; v < nvert; v++)
+    {
+      m_Offsets[v + 1] += m_Offsets[v];
+    }
+    m_Neighbors.resize(2 * nedges);
+    std::vector<int64_t> cursor(m_Offsets.begin(), m_Offsets.end() - 1);
+    for(size_t e = 0; e < nedges; e++)
+    {
+      IndexType v1 = rank[uedges[2 * e]];
+      IndexType v2 = rank[uedges[2 * e + 1]];
+      m_Neighbors[cursor[v1]++] = v2;
+      m_Neighbors[cursor[v2]++] = v1;
+    }
+  }
+  virtual ~LaplacianKernel() = default;
+
+  /**
+   * @brief smooth Runs one smoothing pass with every lambda multiplied by factor
+   */
+  void smooth(float factor)
+  {
+    LaplacianGatherImpl<IndexType> body(m_Offsets.data(), m_Neighbors.data(), m_Lambda.data(), factor, m_Positions.data(), m_Scratch.data());
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    tbb::task_scheduler_init init;
+    bool doParallel = true;
+    if(doParallel)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, m_NumVerts, 4096), body, tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      body.convert(0, m_NumVerts);
+    }
+    m_Positions.swap(m_Scratch);
+  }
+
+  /**
+   * @brief copyPositions Writes the smoothed positions back in the original vertex order
+   */
+  void copyPositions(float* verts) const
+  {
+    for(size_t v = 0; v < m_NumVerts; v++)
+    {
+      IndexType old = m_Order[v];
+      verts[3 * old + 0] = m_Positions[3 * v + 0];
+      verts[3 * old + 1] = m_Positions[3 * v + 1];
+      verts[3 * old + 2] = m_Positions[3 * v + 2];
+    }
+  }
+
+private:
+  size_t m_NumVerts;
+  std::vector<IndexType> m_Order;
+  std::vector<int64_t> m_Offsets;
+  std::vector<IndexType> m_Neighbors;
+  std::vector<float> m_Lambda;
+  std::vector<float> m_Positions;
+  std::vector<float> m_Scratch;
+};
+/**
+ * @brief runLaplacianSmoothing Runs all of the smoothing iterations on the gather kernel
+ * @return 0 on success, -1 if the filter was canceled
+ */
+template <typename IndexType>
+int32_t runLaplacianSmoothing(LaplacianSmoothing* filter, float* verts, const float* lambda, size_t nvert, const int64_t* uedges, size_t nedges)
+{
+  LaplacianKernel<IndexType> kernel(verts, lambda, nvert, uedges, nedges);
+  int32_t iterationSteps = filter->getIterationSteps();
+  for(int32_t q = 0; q < iterationSteps; q++)
+  {
+    if(filter->getCancel())
+    {
+      kernel.copyPositions(verts);
+      return -1;
+    }
+    QString ss = QObject::tr("Iteration %1 of %2").arg(q).arg(iterationSteps);
+    filter->notifyStatusMessage(ss);
+    kernel.smooth(1.0f);
+
+    // Now optionally apply a negative lambda based on the mu Factor value.
+    // This is from Taubin's paper on smoothing without shrinkage. This effectively
+    // runs a low pass filter on the data
+    if(filter->getUseTaubinSmoothing())
+    {
+      kernel.smooth(filter->getMuFactor());
+    }
+  }
+  kernel.copyPositions(verts);
+  return 0;
+}
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -298,104 +553,15 @@ int32_t LaplacianSmoothing::edgeBasedSmoothing()
   int64_t* uedges = surfaceMesh->getEdgePointer(0);
   int64_t nedges = surfaceMesh->getNumberOfEdges();
 
-  DataArray<int32_t>::Pointer numConnections = DataArray<int32_t>::CreateArray(nvert, "_INTERNAL_USE_ONLY_Laplacian_Smoothing_NumberConnections_Array");
-  numConnections->initializeWithZeros();
-  int32_t* ncon = numConnections->getPointer(0);
-
-  QVector<size_t> cDims(1, 3);
-  DataArray<double>::Pointer deltaArray = DataArray<double>::CreateArray(nvert, cDims, "_INTERNAL_USE_ONLY_Laplacian_Smoothing_Delta_Array");
-  deltaArray->initializeWithZeros();
-  double* delta = deltaArray->getPointer(0);
-
-  double dlta = 0.0;
-  for(int32_t q = 0; q < m_IterationSteps; q++)
+  // Vertices are gathered from a CSR adjacency built once, so 32 bit neighbor indices are
+  // used whenever the mesh is small enough to halve the memory traffic of each iteration
+  if(nvert <= static_cast<int64_t>(std::numeric_limits<int32_t>::max()))
   {
-    if(getCancel())
-    {
-      return -1;
-    }
-    QString ss = QObject::tr("Iteration %1 of %2").arg(q).arg(m_IterationSteps);
-    notifyStatusMessage(ss);
-    // Compute the Deltas for each point
-    for(int64_t i = 0; i < nedges; i++)
-    {
-      int64_t in1 = uedges[2 * i];     // row of the first vertex
-      int64_t in2 = uedges[2 * i + 1]; // row the second vertex
-
-      for(int32_t j = 0; j < 3; j++)
-      {
-        Q_ASSERT(static_cast<size_t>(3 * in1 + j) < static_cast<size_t>(nvert * 3));
-        Q_ASSERT(static_cast<size_t>(3 * in2 + j) < static_cast<size_t>(nvert * 3));
-        dlta = verts[3 * in2 + j] - verts[3 * in1 + j];
-        delta[3 * in1 + j] += dlta;
-        delta[3 * in2 + j] += -1.0 * dlta;
-      }
-      ncon[in1] += 1;
-      ncon[in2] += 1;
-    }
-
-    // Move each point
-    float ll = 0.0f;
-    for(int64_t i = 0; i < nvert; i++)
-    {
-      for(int32_t j = 0; j < 3; j++)
-      {
-        int64_t in0 = 3 * i + j;
-        dlta = delta[in0] / ncon[i];
-
-        ll = lambda[i];
-        verts[3 * i + j] += ll * dlta;
-        delta[in0] = 0.0; // reset for next iteration
-      }
-      ncon[i] = 0; // reset for next iteration
-    }
-
-    // Now optionally apply a negative lambda based on the mu Factor value.
-    // This is from Taubin's paper on smoothing without shrinkage. This effectively
-    // runs a low pass filter on the data
-    if(m_UseTaubinSmoothing)
-    {
-
-      if(getCancel())
-      {
-        return -1;
-      }
-      QString ss = QObject::tr("Iteration %1 of %2").arg(q).arg(m_IterationSteps);
-      notifyStatusMessage(ss);
-      // Compute the Delta's
-      for(int64_t i = 0; i < nedges; i++)
-      {
-        int64_t in1 = uedges[2 * i];     // row of the first vertex
-        int64_t in2 = uedges[2 * i + 1]; // row the second vertex
-
-        for(int32_t j = 0; j < 3; j++)
-        {
-          Q_ASSERT(static_cast<size_t>(3 * in1 + j) < static_cast<size_t>(nvert * 3));
-          Q_ASSERT(static_cast<size_t>(3 * in2 + j) < static_cast<size_t>(nvert * 3));
-          dlta = verts[3 * in2 + j] - verts[3 * in1 + j];
-          delta[3 * in1 + j] += dlta;
-          delta[3 * in2 + j] += -1.0 * dlta;
-        }
-        ncon[in1] += 1;
-        ncon[in2] += 1;
-      }
-
-      // MOve the points
-      float ll = 0.0f;
-      for(int64_t i = 0; i < nvert; i++)
-      {
-        for(int32_t j = 0; j < 3; j++)
-        {
-          int64_t in0 = 3 * i + j;
-          dlta = delta[in0] / ncon[i];
-
-          ll = lambda[i] * m_MuFactor;
-          verts[3 * i + j] += ll * dlta;
-          delta[in0] = 0.0; // reset for next iteration
-        }
-        ncon[i] = 0; // reset for next iteration
-      }
-    }
+    err = runLaplacianSmoothing<int32_t>(this, verts, lambda, static_cast<size_t>(nvert), uedges, static_cast<size_t>(nedges));
+  }
+  else
+  {
+    err = runLaplacianSmoothing<int64_t>(this, verts, lambda, static_cast<size_t>(nvert), uedges, static_cast<size_t>(nedges));
   }
 
   return err;
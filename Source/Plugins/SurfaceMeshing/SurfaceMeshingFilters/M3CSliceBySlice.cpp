@@ -45,28 +45,32 @@
 #include <string.h>
 
 //-- C++ STL
+#include <limits>
 #include <queue>
 #include <sstream>
 #include <vector>
 
+#include <QtCore/QDebug>
 #include <QtCore/QDir>
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
-#include <QtCore/QMap>
 
 #include "SIMPLib/Common/PipelineMessage.h"
-#include "SIMPLib/Common/ScopedFileMonitor.hpp"
+#include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
+#include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/DataContainerCreationFilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
+#include "SIMPLib/FilterParameters/OutputFileFilterParameter.h"
+#include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Geometry/MeshStructs.h"
 #include "SurfaceMeshing/SurfaceMeshingFilters/BinaryNodesTrianglesReader.h"
 
-#define WRITE_BINARY_TEMP_FILES 1
-
 namespace Detail
 {
 
-static int triangleResizeCount = 0;
-static size_t triangleResize = 1000;
-
 const QString NodesFile("Nodes.bin");
 const QString TrianglesFile("Triangles.bin");
 
@@ -132,183 +136,104 @@ private:
   void operator=(const SMTempFile&); // Operator '=' Not Implemented
 };
 
-class FeatureChecker
+/**
+ * @brief The SliceMeshStore class holds the nodes and triangles files open for the whole run. Each
+ * slice is appended through a large write buffer and flushed once the slice is complete, so
+ * nothing but the two working slices stays in memory no matter how deep the volume is.
+ */
+class SliceMeshStore
 {
 public:
-  SIMPL_SHARED_POINTERS(FeatureChecker)
-  SIMPL_STATIC_NEW_MACRO(FeatureChecker)
-  virtual ~FeatureChecker()
+  SIMPL_SHARED_POINTERS(SliceMeshStore)
+  SIMPL_STATIC_NEW_MACRO(SliceMeshStore)
+  virtual ~SliceMeshStore()
   {
+    close();
   }
-  typedef QMap<int, int> MapType;
 
-  template <typename T> static void TripletSort(T a, T b, T c, T* sorted)
+  /**
+   * @brief open Creates (or truncates) both files
+   * @return false if either file could not be created
+   */
+  bool open(const QString& nodesFile, const QString& trianglesFile)
   {
-    if(a > b && a > c)
-    {
-      sorted[2] = a;
-      if(b > c)
-      {
-        sorted[1] = b;
-        sorted[0] = c;
-      }
-      else
-      {
-        sorted[1] = c;
-        sorted[0] = b;
-      }
-    }
-    else if(b > a && b > c)
-    {
-      sorted[2] = b;
-      if(a > c)
-      {
-        sorted[1] = a;
-        sorted[0] = c;
-      }
-      else
-      {
-        sorted[1] = c;
-        sorted[0] = a;
-      }
-    }
-    else if(a > b)
-    {
-      sorted[1] = a;
-      sorted[0] = b;
-      sorted[2] = c;
-    }
-    else if(a >= c && b >= c)
+    close();
+    m_NodesFile = fopen(nodesFile.toLatin1().data(), "wb");
+    m_TrianglesFile = fopen(trianglesFile.toLatin1().data(), "wb");
+    if(nullptr == m_NodesFile || nullptr == m_TrianglesFile)
     {
-      sorted[0] = c;
-      sorted[1] = a;
-      sorted[2] = b;
-    }
-    else
-    {
-      sorted[0] = a;
-      sorted[1] = b;
-      sorted[2] = c;
+      close();
+      return false;
     }
+    setvbuf(m_NodesFile, nullptr, _IOFBF, k_BufferSize);
+    setvbuf(m_TrianglesFile, nullptr, _IOFBF, k_BufferSize);
+    return true;
   }
 
-  // -----------------------------------------------------------------------------
-  //
-  // -----------------------------------------------------------------------------
-  void addData(int numTriangles, int ctid, StructArray<SurfaceMesh::M3C::Face>::Pointer cTriangle, VertexArray::Vert_t* cVertex)
+  FILE* getNodesFile()
   {
-#if 0
-      int n1, n2, n3;
-      int gid;
-      int size;
-      for (int i = 0; i < numTriangles; ++i)
-      {
-        gid = cTriangle[i]->nSpin[0];
-        size = static_cast<int>(featureMaps.size());
-        if (gid >= size)
-        {
-          featureMaps.resize(gid + 1);
-          tCounts.resize(gid + 1);
-        }
-        if (gid > 0)
-        {
-          // Get a reference to the map for this feature
-          MapType& vertMap = featureMaps[gid];
-          MapType& triMap = tCounts[gid];
-
-          n1 = cTriangle[i].node_id[0];
-          n2 = cTriangle[i].node_id[1];
-          n3 = cTriangle[i].node_id[2];
-          n1 = cVertex[n1].NodeID;
-          n2 = cVertex[n2].NodeID;
-          n3 = cVertex[n3].NodeID;
-
-          vertMap[n1] = 0;
-          vertMap[n2] = 0;
-          vertMap[n3] = 0;
-          triMap[ctid] = 0;
-        }
+    return m_NodesFile;
+  }
 
-        gid = cTriangle[i]->nSpin[1];
-        size = static_cast<int>(featureMaps.size());
-        if (gid >= size)
-        {
-          featureMaps.resize(gid + 1);
-          tCounts.resize(gid + 1);
-        }
-        if (gid > 0)
-        {
-          // Get a reference to the map for this feature
-          MapType& vertMap = featureMaps[gid];
-          MapType& triMap = tCounts[gid];
-
-          n1 = cTriangle[i].node_id[0];
-          n2 = cTriangle[i].node_id[1];
-          n3 = cTriangle[i].node_id[2];
-          n1 = cVertex[n1].NodeID;
-          n2 = cVertex[n2].NodeID;
-          n3 = cVertex[n3].NodeID;
-
-          vertMap[n1] = 0;
-          vertMap[n2] = 0;
-          vertMap[n3] = 0;
-          triMap[ctid] = 0;
-        }
-        //
-        ++ctid;
-      }
-#endif
+  FILE* getTrianglesFile()
+  {
+    return m_TrianglesFile;
   }
 
-  // -----------------------------------------------------------------------------
-  //
-  // -----------------------------------------------------------------------------
-  void analyzeFeatures()
-  {
-    size_t size = tCounts.size();
-    size_t vCount = 0;
-    size_t tCount = 0;
-    for(size_t i = 1; i < size; ++i)
-    {
-      MapType& t = tCounts[i];
-      tCount = t.size();
-      MapType& m = featureMaps[i];
-      vCount = m.size();
-      if(tCount + 4 != vCount * 2)
-      {
-        qDebug() << "Feature ID: " << i << " Does not satisfy equation T=2V-4    "
-                 << "  tCount: " << tCount << "   "
-                 << "  vCount: " << vCount << "\n";
-      }
-    }
+  /**
+   * @brief flush Pushes the records of the finished slice to disk
+   */
+  bool flush()
+  {
+    return fflush(m_NodesFile) == 0 && fflush(m_TrianglesFile) == 0;
   }
 
-protected:
-  FeatureChecker()
+  /**
+   * @brief close Closes both files
+   * @return false if buffered records could not be written
+   */
+  bool close()
   {
+    bool ok = true;
+    if(nullptr != m_NodesFile)
+    {
+      ok = (fclose(m_NodesFile) == 0) && ok;
+      m_NodesFile = nullptr;
+    }
+    if(nullptr != m_TrianglesFile)
+    {
+      ok = (fclose(m_TrianglesFile) == 0) && ok;
+      m_TrianglesFile = nullptr;
+    }
+    return ok;
   }
 
+protected:
+  SliceMeshStore() = default;
+
 private:
-  QVector<MapType> featureMaps;
-  QVector<MapType> tCounts;
+  static const size_t k_BufferSize = 4 * 1024 * 1024;
+
+  FILE* m_NodesFile = nullptr;
+  FILE* m_TrianglesFile = nullptr;
 
-  FeatureChecker(const FeatureChecker&); // Copy Constructor Not Implemented
-  void operator=(const FeatureChecker&); // Operator '=' Not Implemented
+  SliceMeshStore(const SliceMeshStore&);  // Copy Constructor Not Implemented
+  void operator=(const SliceMeshStore&); // Operator '=' Not Implemented
 };
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 M3CSliceBySlice::M3CSliceBySlice()
-: m_SurfaceDataContainerName(SIMPL::Defaults::DataContainerName)
+: m_SurfaceDataContainerName(SIMPL::Defaults::TriangleDataContainerName)
 , m_VertexAttributeMatrixName(SIMPL::Defaults::VertexAttributeMatrixName)
 , m_FaceAttributeMatrixName(SIMPL::Defaults::FaceAttributeMatrixName)
 , m_FaceLabelsArrayName(SIMPL::FaceData::SurfaceMeshFaceLabels)
 , m_SurfaceMeshNodeTypesArrayName(SIMPL::VertexData::SurfaceMeshNodeType)
 , m_DeleteTempFiles(true)
+, m_StreamMeshToDisk(false)
+, m_OutputFilePrefix("")
 , m_FeatureIdsArrayPath(SIMPL::Defaults::DataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::FeatureIds)
-, m_FeatureIdsArrayName(SIMPL::CellData::FeatureIds)
-, m_FeatureIds(nullptr)
 {
 }
 
@@ -324,9 +249,14 @@ void M3CSliceBySlice::setupFilterParameters()
 {
   FilterParameterVectorType parameters;
   parameters.push_back(SIMPL_NEW_BOOL_FP("Delete Temp Files", DeleteTempFiles, FilterParameter::Uncategorized, M3CSliceBySlice));
+  QStringList linkedProps("OutputFilePrefix");
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Stream Mesh To Disk", StreamMeshToDisk, FilterParameter::Uncategorized, M3CSliceBySlice, linkedProps));
+  parameters.push_back(SIMPL_NEW_OUTPUT_FILE_FP("Output File Prefix", OutputFilePrefix, FilterParameter::Uncategorized, M3CSliceBySlice));
   parameters.push_back(SeparatorFilterParameter::New("Required Information", FilterParameter::Uncategorized));
-  parameters.push_back(DataArraySelectionFilterParameter::New("FeatureIds", "FeatureIdsArrayPath", getFeatureIdsArrayPath(), FilterParameter::Uncategorized,
-                                                              SIMPL_BIND_SETTER(M3CSliceBySlice, this, FeatureIdsArrayPath), SIMPL_BIND_GETTER(M3CSliceBySlice, this, FeatureIdsArrayPath)));
+  {
+    DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Int32, 1, AttributeMatrix::Type::Cell, IGeometry::Type::Image);
+    parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Feature Ids", FeatureIdsArrayPath, FilterParameter::Uncategorized, M3CSliceBySlice, req));
+  }
   parameters.push_back(SeparatorFilterParameter::New("Created Information", FilterParameter::Uncategorized));
   parameters.push_back(SIMPL_NEW_DC_CREATION_FP("Surface Data Container", SurfaceDataContainerName, FilterParameter::Uncategorized, M3CSliceBySlice));
   parameters.push_back(SIMPL_NEW_STRING_FP("Vertex Attribute Matrix", VertexAttributeMatrixName, FilterParameter::Uncategorized, M3CSliceBySlice));
@@ -349,6 +279,8 @@ void M3CSliceBySlice::readFilterParameters(AbstractFilterParametersReader* reade
   setFaceLabelsArrayName(reader->readString("FaceLabelsArrayName", getFaceLabelsArrayName()));
   setFeatureIdsArrayPath(reader->readDataArrayPath("FeatureIdsArrayPath", getFeatureIdsArrayPath()));
   setDeleteTempFiles(reader->readValue("DeleteTempFiles", getDeleteTempFiles()));
+  setStreamMeshToDisk(reader->readValue("StreamMeshToDisk", getStreamMeshToDisk()));
+  setOutputFilePrefix(reader->readString("OutputFilePrefix", getOutputFilePrefix()));
   reader->closeFilterGroup();
 }
 
@@ -364,10 +296,11 @@ void M3CSliceBySlice::initialize()
 // -----------------------------------------------------------------------------
 void M3CSliceBySlice::dataCheck()
 {
-  DataArrayPath tempPath;
   clearErrorCode();
   clearWarningCode();
 
+  getDataContainerArray()->getPrereqGeometryFromDataContainer<ImageGeom, AbstractFilter>(this, getFeatureIdsArrayPath().getDataContainerName());
+
   QVector<size_t> dims(1, 1);
   m_FeatureIdsPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<int32_t>, AbstractFilter>(this, getFeatureIdsArrayPath(),
                                                                                                         dims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
@@ -375,6 +308,11 @@ void M3CSliceBySlice::dataCheck()
   {
     m_FeatureIds = m_FeatureIdsPtr.lock()->getPointer(0);
   } /* Now assign the raw pointer to data from the DataArray<T> object */
+
+  if(m_StreamMeshToDisk && m_OutputFilePrefix.isEmpty())
+  {
+    setErrorCondition(-790, "The Output File Prefix must be set to stream the mesh to disk");
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -388,12 +326,19 @@ void M3CSliceBySlice::preflight()
   dataCheck();
   emit preflightExecuted();
 
-  QString nodesFile = QDir::tempPath() + Detail::NodesFile;
+  // When streaming, the mesh stays on disk and nothing is added to the Data Container Array
+  if(m_StreamMeshToDisk)
+  {
+    setInPreflight(false);
+    return;
+  }
+
+  QString nodesFile = QDir::tempPath() + "/" + Detail::NodesFile;
   SMTempFile::Pointer nodesTempFile = SMTempFile::New();
   nodesTempFile->setFilePath(nodesFile);
   nodesTempFile->setAutoDelete(this->m_DeleteTempFiles);
 
-  QString trianglesFile = QDir::tempPath() + Detail::TrianglesFile;
+  QString trianglesFile = QDir::tempPath() + "/" + Detail::TrianglesFile;
   SMTempFile::Pointer trianglesTempFile = SMTempFile::New();
   trianglesTempFile->setFilePath(trianglesFile);
   trianglesTempFile->setAutoDelete(this->m_DeleteTempFiles);
@@ -403,15 +348,15 @@ void M3CSliceBySlice::preflight()
   binaryReader->setBinaryNodesFile(nodesFile);
   binaryReader->setBinaryTrianglesFile(trianglesFile);
   binaryReader->setDataContainerArray(getDataContainerArray());
-  binaryReader->setSurfaceDataContainerName(getSurfaceDataContainerName());
+  binaryReader->setSurfaceDataContainerName(getSurfaceDataContainerName().getDataContainerName());
   binaryReader->setVertexAttributeMatrixName(getVertexAttributeMatrixName());
   binaryReader->setFaceAttributeMatrixName(getFaceAttributeMatrixName());
   binaryReader->setFaceLabelsArrayName(getFaceLabelsArrayName());
   binaryReader->setSurfaceMeshNodeTypesArrayName(getSurfaceMeshNodeTypesArrayName());
   binaryReader->preflight();
-  if(binaryReader->getErrorCondition() < 0)
+  if(binaryReader->getErrorCode() < 0)
   {
-    setErrorCondition(binaryReader->getErrorCondition(), "Binary Reader failed its preflight.");
+    setErrorCondition(binaryReader->getErrorCode(), "Binary Reader failed its preflight.");
   }
   setInPreflight(false);
 }
@@ -425,24 +370,30 @@ void M3CSliceBySlice::execute()
   clearErrorCode();
   clearWarningCode();
   dataCheck();
-  if(getErrorCondition() < 0)
+  if(getErrorCode() < 0)
   {
     return;
   }
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
 
-  /* FIXME: ImageGeom */ m->getGeometryAs<ImageGeom>()->getOrigin(m_OriginX, m_OriginY, m_OriginZ);
+  // The nodes and triangles files are temporary unless the mesh is streamed to disk, in which
+  // case they are the output of the filter
+  QString nodesFile = QDir::tempPath() + "/" + Detail::NodesFile;
+  QString trianglesFile = QDir::tempPath() + "/" + Detail::TrianglesFile;
+  if(m_StreamMeshToDisk)
+  {
+    nodesFile = m_OutputFilePrefix + "_" + Detail::NodesFile;
+    trianglesFile = m_OutputFilePrefix + "_" + Detail::TrianglesFile;
+  }
 
-  QString nodesFile = QDir::tempPath() + Detail::NodesFile;
   SMTempFile::Pointer nodesTempFile = SMTempFile::New();
   nodesTempFile->setFilePath(nodesFile);
-  nodesTempFile->setAutoDelete(this->m_DeleteTempFiles);
+  nodesTempFile->setAutoDelete(this->m_DeleteTempFiles && !m_StreamMeshToDisk);
 
-  QString trianglesFile = QDir::tempPath() + Detail::TrianglesFile;
   SMTempFile::Pointer trianglesTempFile = SMTempFile::New();
   trianglesTempFile->setFilePath(trianglesFile);
-  trianglesTempFile->setAutoDelete(this->m_DeleteTempFiles);
+  trianglesTempFile->setAutoDelete(this->m_DeleteTempFiles && !m_StreamMeshToDisk);
 
   if(m_DeleteTempFiles == false)
   {
@@ -450,6 +401,14 @@ void M3CSliceBySlice::execute()
     qDebug() << trianglesFile << "\n";
   }
 
+  SliceMeshStore::Pointer meshStore = SliceMeshStore::New();
+  if(!meshStore->open(nodesFile, trianglesFile))
+  {
+    QString ss = QObject::tr("Error creating the Nodes file '%1' or the Triangles file '%2'").arg(nodesFile).arg(trianglesFile);
+    setErrorCondition(-791, ss);
+    return;
+  }
+
   int cNodeID = 0;
   int cTriID = 0;
   int cEdgeID = 0;
@@ -457,15 +416,17 @@ void M3CSliceBySlice::execute()
   int nEdge = 0;     // number of edges...
   int nNodes = 0;    // number of total Nodes used...
 
-  //  FeatureChecker::Pointer m_FeatureChecker = FeatureChecker::New();
-
   size_t dims[3];
   float res[3];
   float origin[3];
 
-  /* FIXME: ImageGeom */ std::tie(dims[0], dims[1], dims[2]) = m->getGeometryAs<ImageGeom>()->getDimensions();
-  /* FIXME: ImageGeom */ m->getGeometryAs<ImageGeom>()->getResolution(res);
-  /* FIXME: ImageGeom */ m->getGeometryAs<ImageGeom>()->getOrigin(origin);
+  ImageGeom::Pointer image = m->getGeometryAs<ImageGeom>();
+  std::tie(dims[0], dims[1], dims[2]) = image->getDimensions();
+  image->getSpacing(res);
+  image->getOrigin(origin);
+  m_OriginX = origin[0];
+  m_OriginY = origin[1];
+  m_OriginZ = origin[2];
 
   int wrappedDims[3] = {static_cast<int>(dims[0]), static_cast<int>(dims[1]), static_cast<int>(dims[2])};
 
@@ -485,33 +446,15 @@ void M3CSliceBySlice::execute()
   int NS = wrappedDims[0] * wrappedDims[1] * wrappedDims[2];
   int NSP = wrappedDims[0] * wrappedDims[1];
 
-  DataArray<int32_t>::Pointer voxelsPtr = DataArray<int32_t>::CreateArray(2 * NSP + 1, "M3CSliceBySlice_Working_Voxels");
-  voxelsPtr->initializeWithValue(-3);
-  int32_t* voxels = voxelsPtr->getPointer(0);
-
-  StructArray<SurfaceMesh::M3C::Neighbor>::Pointer neighborsPtr = StructArray<SurfaceMesh::M3C::Neighbor>::CreateArray(2 * NSP + 1, "M3CSliceBySlice_SurfaceMesh::M3C::Neighbor_Array");
-  neighborsPtr->initializeWithZeros();
-
-  DataArray<int32_t>::Pointer neighCSiteIdPtr = DataArray<int32_t>::CreateArray(2 * NSP + 1, "M3CSliceBySlice_SurfaceMesh::M3C::Neighbor_CSiteId_Array");
-  neighCSiteIdPtr->initializeWithZeros();
-
-  StructArray<SurfaceMesh::M3C::Face>::Pointer cSquarePtr = StructArray<SurfaceMesh::M3C::Face>::CreateArray(3 * 2 * NSP, "M3CSliceBySlice_SurfaceMesh::M3C::Face_Array");
-  cSquarePtr->initializeWithZeros();
-
-  VertexArray::Pointer cVertexPtr = VertexArray::CreateArray(2 * 7 * NSP, "M3CSliceBySlice_Node_Array");
-  cVertexPtr->initializeWithZeros();
-
-  DataArray<int32_t>::Pointer cVertexNodeIdPtr = DataArray<int32_t>::CreateArray(2 * 7 * NSP, "M3CSliceBySlice_Node_NodeId_Array");
-  cVertexNodeIdPtr->initializeWithZeros();
-
-  DataArray<int8_t>::Pointer cVertexNodeTypePtr = DataArray<int8_t>::CreateArray(2 * 7 * NSP, "M3CSliceBySlice_Node_NodeKind_Array");
-  cVertexNodeTypePtr->initializeWithValue(SIMPL::SurfaceMesh::NodeType::Unused);
-
-  StructArray<SurfaceMesh::M3C::Patch>::Pointer cTrianglePtr = StructArray<SurfaceMesh::M3C::Patch>::CreateArray(0, "M3CSliceBySlice_Triangle_Array");
-  cTrianglePtr->initializeWithZeros();
-
-  StructArray<SurfaceMesh::M3C::Segment>::Pointer cEdgePtr = StructArray<SurfaceMesh::M3C::Segment>::CreateArray(0, "M3CSliceBySlice_SurfaceMesh::M3C::Segment_Array");
-  cEdgePtr->initializeWithZeros();
+  // Everything below is sized by the two working slices; nothing grows with the number of slices
+  std::vector<int32_t> voxels(2 * NSP + 1, -3);
+  std::vector<Neighbor> neigh(2 * NSP + 1, Neighbor());
+  std::vector<Face> cSquare(3 * 2 * NSP, Face());
+  std::vector<Vertex> cVertex(2 * 7 * NSP, Vertex());
+  std::vector<int32_t> nodeID(2 * 7 * NSP, 0);
+  std::vector<int8_t> nodeType(2 * 7 * NSP, SIMPL::SurfaceMesh::NodeType::Unused);
+  std::vector<Patch> cTriangle;
+  std::vector<Segment> cEdge;
 
   // Prime the working voxels (2 layers worth) with -3 values indicating border voxels if the
   // volume does NOT have a ghost layer
@@ -543,11 +486,19 @@ void M3CSliceBySlice::execute()
 
       ss = QObject::tr("Cancelling filter");
       setErrorCondition(-1, ss);
-      break;
+      return;
+    }
+
+    // Node and triangle ids are written as 32 bit integers, stop before they would wrap around
+    if(static_cast<int64_t>(cNodeID) + 7 * 2 * static_cast<int64_t>(NSP) > std::numeric_limits<int32_t>::max())
+    {
+      ss = QObject::tr("The mesh has more nodes than the Nodes file can index (slice %1 of %2)").arg(i).arg(sliceCount);
+      setErrorCondition(-792, ss);
+      return;
     }
 
     // Copy the Voxels from layer 2 to Layer 1;
-    ::memcpy(&(voxels[1]), &(voxels[1 + NSP]), NSP * sizeof(int));
+    ::memcpy(&(voxels[1]), &(voxels[1 + NSP]), NSP * sizeof(int32_t));
 
     // Either interleave the voxels of just a straight copy depending if a ghost
     // layer was already present
@@ -574,7 +525,7 @@ void M3CSliceBySlice::execute()
     }
     else
     {
-      copyBulkSliceIntoWorkingArray(i, wrappedDims, dims, voxels);
+      copyBulkSliceIntoWorkingArray(i, wrappedDims, dims, voxels.data());
     }
 
     // If we are on the last slice then we need both layers to be ghost cells with
@@ -582,29 +533,35 @@ void M3CSliceBySlice::execute()
     // ghost cells
 
     // This starts the actual M3C Algorithm codes
-    get_neighbor_list(NSP, NS, wrappedDims, neighborsPtr, neighCSiteIdPtr);
-    initialize_nodes(NSP, i, wrappedDims, res, cVertexPtr, voxelsPtr, cVertexNodeIdPtr, cVertexNodeTypePtr);
-    initialize_squares(i, NSP, cSquarePtr, neighborsPtr);
+    get_neighbor_list(NSP, NS, wrappedDims, neigh);
+    initialize_nodes(NSP, i, wrappedDims, res, cVertex, voxels, nodeID, nodeType);
+    initialize_squares(i, NSP, cSquare, neigh);
 
-    // find SurfaceMesh::M3C::Face edges of each square of marching cubes in each layer...
-    nEdge = get_nodes_Edges(NSP, i, wrappedDims, cSquarePtr, voxelsPtr, cEdgePtr, cVertexNodeTypePtr, neighborsPtr);
+    // find Face edges of each square of marching cubes in each layer...
+    nEdge = get_nodes_Edges(NSP, i, wrappedDims, cSquare, voxels, cEdge, nodeType, neigh);
 
     // find triangles and arrange the spins across each triangle...
-    nTriangle = get_triangles(NSP, wrappedDims, cSquarePtr, voxelsPtr, cVertexNodeTypePtr, cEdgePtr, cTrianglePtr);
+    nTriangle = get_triangles(NSP, wrappedDims, cSquare, voxels, nodeType, cEdge, cTriangle);
+    if(static_cast<int64_t>(cTriID) + nTriangle > std::numeric_limits<int32_t>::max())
+    {
+      ss = QObject::tr("The mesh has more triangles than the Triangles file can index (slice %1 of %2)").arg(i).arg(sliceCount);
+      setErrorCondition(-792, ss);
+      return;
+    }
     /* $$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$ */
     // THERE IS A SUBTLE BUG IN THIS NEXT FUNCTION WHERE SOMETIMES THE LABELS ARE NOT ARRANGED CORRECTLY. FOR NOW THE
     // WORK AROUND IS TO JUST PUT THEM BACK TO THEIR ORIGINAL VALUES INSTEAD OF LEAVING THE -1 VALUE THAT IS PLACED
     // IN THERE DURING THE EXECUTION OF THE ALGORITHM. AT SOME POINT THIS REALLY NEEDS TO BE FIXED PROPERLY BY
     // SOME ONE WHO UNDERSTANDS THE CODE. THE SMALL_IN100 DATA SET CAN USUALLY TRIGGER THIS BUG.
-    arrange_featurenames(nTriangle, i, NSP, wrappedDims, res, cTrianglePtr, cVertexPtr, voxelsPtr, neighborsPtr);
+    arrange_featurenames(nTriangle, i, NSP, wrappedDims, res, cTriangle, cVertex, voxels, neigh);
     /* $$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$ */
 
     // assign new, cumulative Node id...
-    nNodes = assign_nodeID(cNodeID, NSP, cVertexNodeIdPtr, cVertexNodeTypePtr);
-    update_node_edge_kind(nTriangle, cTrianglePtr, cVertexNodeTypePtr, cEdgePtr);
+    nNodes = assign_nodeID(cNodeID, NSP, nodeID, nodeType);
+    update_node_edge_kind(nTriangle, cTriangle, nodeType);
 
     // Output Nodes and triangles...
-    err = writeNodesFile(i, cNodeID, NSP, nodesFile, cVertexPtr, cVertexNodeIdPtr, cVertexNodeTypePtr);
+    err = writeNodesFile(cNodeID, NSP, meshStore->getNodesFile(), cVertex, nodeID, nodeType);
     if(err < 0)
     {
 
@@ -613,7 +570,7 @@ void M3CSliceBySlice::execute()
       return;
     }
 
-    err = writeTrianglesFile(i, cTriID, trianglesFile, nTriangle, cTrianglePtr, cVertexNodeIdPtr, renumberFeatureValue);
+    err = writeTrianglesFile(cTriID, meshStore->getTrianglesFile(), nTriangle, cTriangle, nodeID, renumberFeatureValue);
     if(err < 0)
     {
 
@@ -621,25 +578,47 @@ void M3CSliceBySlice::execute()
       setErrorCondition(-1, ss);
       return;
     }
+
+    // Everything this slice produced is final, so it can leave memory now
+    if(!meshStore->flush())
+    {
+      ss = QObject::tr("Error flushing the Nodes file '%1' or the Triangles file '%2'").arg(nodesFile).arg(trianglesFile);
+      setErrorCondition(-793, ss);
+      return;
+    }
     cNodeID = nNodes;
     cTriID = cTriID + nTriangle;
     cEdgeID = cEdgeID + nEdge;
-    if(nTriangle > 0)
-    {
-      cTrianglePtr->resize(0);
-    }
+    cTriangle.clear();
   }
 
   // Clear out all the memory that we have used:
-  voxelsPtr = DataArray<int32_t>::NullPointer();
-  neighborsPtr = StructArray<SurfaceMesh::M3C::Neighbor>::NullPointer();
-  neighCSiteIdPtr = DataArray<int32_t>::NullPointer();
-  cSquarePtr = StructArray<SurfaceMesh::M3C::Face>::NullPointer();
-  cVertexPtr = VertexArray::NullPointer();
-  cVertexNodeIdPtr = DataArray<int32_t>::NullPointer();
-  cVertexNodeTypePtr = DataArray<int8_t>::NullPointer();
-  cTrianglePtr = StructArray<SurfaceMesh::M3C::Patch>::NullPointer();
-  cEdgePtr = StructArray<SurfaceMesh::M3C::Segment>::NullPointer();
+  std::vector<int32_t>().swap(voxels);
+  std::vector<Neighbor>().swap(neigh);
+  std::vector<Face>().swap(cSquare);
+  std::vector<Vertex>().swap(cVertex);
+  std::vector<int32_t>().swap(nodeID);
+  std::vector<int8_t>().swap(nodeType);
+  std::vector<Patch>().swap(cTriangle);
+  std::vector<Segment>().swap(cEdge);
+
+  if(!meshStore->close())
+  {
+    QString ss = QObject::tr("Error closing the Nodes file '%1' or the Triangles file '%2'").arg(nodesFile).arg(trianglesFile);
+    setErrorCondition(-793, ss);
+    return;
+  }
+
+  if(m_StreamMeshToDisk)
+  {
+    if(renumberFeatureValue != 0)
+    {
+      renumberVoxelFeatureIds(renumberFeatureValue);
+    }
+    QString ss = QObject::tr("Surface mesh with %1 nodes and %2 triangles written to '%3' and '%4'").arg(cNodeID).arg(cTriID).arg(nodesFile).arg(trianglesFile);
+    notifyStatusMessage(ss);
+    return;
+  }
 
   // This will read the mesh from the temp file and store it in the SurfaceMesh Data container
   BinaryNodesTrianglesReader::Pointer binaryReader = BinaryNodesTrianglesReader::New();
@@ -649,15 +628,15 @@ void M3CSliceBySlice::execute()
   binaryReader->setBinaryNodesFile(nodesFile);
   binaryReader->setBinaryTrianglesFile(trianglesFile);
   binaryReader->setDataContainerArray(getDataContainerArray());
-  binaryReader->setSurfaceDataContainerName(getSurfaceDataContainerName());
+  binaryReader->setSurfaceDataContainerName(getSurfaceDataContainerName().getDataContainerName());
   binaryReader->setVertexAttributeMatrixName(getVertexAttributeMatrixName());
   binaryReader->setFaceAttributeMatrixName(getFaceAttributeMatrixName());
   binaryReader->setFaceLabelsArrayName(getFaceLabelsArrayName());
   binaryReader->setSurfaceMeshNodeTypesArrayName(getSurfaceMeshNodeTypesArrayName());
   binaryReader->execute();
-  if(binaryReader->getErrorCondition() < 0)
+  if(binaryReader->getErrorCode() < 0)
   {
-    setErrorCondition(binaryReader->getErrorCondition(), "Binary Reader failed during execution.");
+    setErrorCondition(binaryReader->getErrorCode(), "Binary Reader failed during execution.");
   }
 
   // This will possibly delete the triangles and Nodes file depending on the
@@ -729,7 +708,7 @@ int32_t M3CSliceBySlice::volumeHasFeatureValuesOfZero()
 {
   size_t fileDim[3];
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
-  /* FIXME: ImageGeom */ std::tie(fileDim[0], fileDim[1], fileDim[2]) = m->getGeometryAs<ImageGeom>()->getDimensions();
+  std::tie(fileDim[0], fileDim[1], fileDim[2]) = m->getGeometryAs<ImageGeom>()->getDimensions();
 
   int32_t count = m_FeatureIdsPtr.lock()->getNumberOfTuples();
 
@@ -775,7 +754,7 @@ void M3CSliceBySlice::renumberVoxelFeatureIds(int32_t gid)
 {
   size_t fileDim[3];
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
-  /* FIXME: ImageGeom */ std::tie(fileDim[0], fileDim[1], fileDim[2]) = m->getGeometryAs<ImageGeom>()->getDimensions();
+  std::tie(fileDim[0], fileDim[1], fileDim[2]) = m->getGeometryAs<ImageGeom>()->getDimensions();
 
   int32_t count = m_FeatureIdsPtr.lock()->getNumberOfTuples();
 
@@ -823,7 +802,7 @@ void M3CSliceBySlice::copyBulkSliceIntoWorkingArray(int i, int* wrappedDims, siz
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void M3CSliceBySlice::get_neighbor_list(int NSP, int NS, int wrappedDims[], StructArray<SurfaceMesh::M3C::Neighbor>::Pointer neighborsPtr, DataArray<int32_t>::Pointer neighborCSiteIdPtr)
+void M3CSliceBySlice::get_neighbor_list(int NSP, int NS, int wrappedDims[], std::vector<Neighbor>& neigh)
 {
   // NSP = number of sites in a plane of xDim by yDim...
   // neigh[][] = 2 dimeNSional array storing its site number and Neighbors...
@@ -840,14 +819,11 @@ void M3CSliceBySlice::get_neighbor_list(int NSP, int NS, int wrappedDims[], Stru
   int i, j, k, r; // position indices...
   int site_id;    // id number for each site...
 
-  SurfaceMesh::M3C::Neighbor* neigh = neighborsPtr->getPointer(0);
-  int32_t* csiteid = neighborCSiteIdPtr->getPointer(0);
   int xDim = wrappedDims[0];
 
   for(ii = 1; ii <= 2 * NSP; ii++)
   {
     site_id = ii;
-    csiteid[ii] = site_id;
     k = (site_id - 1) / NSP;
     k = k * NSP;
     r = (site_id - 1) % NSP;
@@ -920,8 +896,8 @@ float M3CSliceBySlice::find_zcoord(int index, int xDim, int yDim, float zRes)
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void M3CSliceBySlice::initialize_nodes(int NSP, int zID, int* wrappedDims, float* res, VertexArray::Pointer cVertexPtr, DataArray<int32_t>::Pointer voxelsPtr,
-                                       DataArray<int32_t>::Pointer cVertexNodeIdPtr, DataArray<int8_t>::Pointer cVertexNodeTypePtr)
+void M3CSliceBySlice::initialize_nodes(int NSP, int zID, int* wrappedDims, float* res, std::vector<Vertex>& cVertex, std::vector<int32_t>& voxels,
+                                       std::vector<int32_t>& nodeID, std::vector<int8_t>& nodeKind)
 {
 
   // Finds the coordinates of Nodes...
@@ -940,10 +916,6 @@ void M3CSliceBySlice::initialize_nodes(int NSP, int zID, int* wrappedDims, float
   float yRes = res[1];
   float zRes = res[2];
 
-  VertexArray::Vert_t* cVertex = cVertexPtr->getPointer(0);
-  int32_t* voxels = voxelsPtr->getPointer(0);
-  int8_t* nodeKind = cVertexNodeTypePtr->getPointer(0);
-  int32_t* nodeID = cVertexNodeIdPtr->getPointer(0);
 
   // Node id starts with 0....
   if(zID > 0)
@@ -1015,15 +987,13 @@ void M3CSliceBySlice::initialize_nodes(int NSP, int zID, int* wrappedDims, float
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void M3CSliceBySlice::initialize_squares(int zID, int NSP, StructArray<SurfaceMesh::M3C::Face>::Pointer cSquarePtr, StructArray<SurfaceMesh::M3C::Neighbor>::Pointer neighborsPtr)
+void M3CSliceBySlice::initialize_squares(int zID, int NSP, std::vector<Face>& cSquare, std::vector<Neighbor>& neigh)
 {
 
   // Gather initial information on each square...
   int id;
   int csite;
 
-  SurfaceMesh::M3C::Face* cSquare = cSquarePtr->getPointer(0);
-  SurfaceMesh::M3C::Neighbor* neigh = neighborsPtr->getPointer(0);
 
   // square id starts with 0....
   // notice that point at the surface will have the wrong values of Node at the other end...
@@ -1065,9 +1035,9 @@ void M3CSliceBySlice::initialize_squares(int zID, int NSP, StructArray<SurfaceMe
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-size_t M3CSliceBySlice::get_nodes_Edges(int NSP, int zID, int* wrappedDims, StructArray<SurfaceMesh::M3C::Face>::Pointer cSquarePtr, DataArray<int32_t>::Pointer voxelsPtr,
-                                        StructArray<SurfaceMesh::M3C::Segment>::Pointer cEdgePtr, DataArray<int8_t>::Pointer cVertexNodeTypePtr,
-                                        StructArray<SurfaceMesh::M3C::Neighbor>::Pointer neighborsPtr)
+size_t M3CSliceBySlice::get_nodes_Edges(int NSP, int zID, int* wrappedDims, std::vector<Face>& cSquare, std::vector<int32_t>& voxels,
+                                        std::vector<Segment>& cEdge, std::vector<int8_t>& nodeType,
+                                        std::vector<Neighbor>& neigh)
 {
   int j, k, m, ii;
   int tsite;
@@ -1090,12 +1060,6 @@ size_t M3CSliceBySlice::get_nodes_Edges(int NSP, int zID, int* wrappedDims, Stru
   int NodeID[2];
   int pixfeaturename[2];
 
-  size_t edgeResize = 1000;
-  int edgeResizeCount = 0;
-
-  SurfaceMesh::M3C::Face* cSquare = cSquarePtr->getPointer(0);
-  int32_t* voxels = voxelsPtr->getPointer(0);
-  int8_t* nodeType = cVertexNodeTypePtr->getPointer(0);
 
   for(k = 0; k < 3 * 2 * NSP; k++)
   {
@@ -1132,7 +1096,7 @@ size_t M3CSliceBySlice::get_nodes_Edges(int NSP, int zID, int* wrappedDims, Stru
         sqIndex = get_square_index(tnSpin);
         if(sqIndex == 15)
         {
-          anFlag = treat_anomaly(tNSite, zID, voxelsPtr, neighborsPtr);
+          anFlag = treat_anomaly(tNSite, zID, voxels, neigh);
           sqIndex = sqIndex + anFlag;
         }
         if(sqIndex != 0)
@@ -1146,24 +1110,13 @@ size_t M3CSliceBySlice::get_nodes_Edges(int NSP, int zID, int* wrappedDims, Stru
               pixIndex[0] = Detail::nsTable_2d[sqIndex][j];
               pixIndex[1] = Detail::nsTable_2d[sqIndex][j + 1];
               get_nodes(cubeOrigin, sqOrder, NodeIndex, NodeID, NSP, wrappedDims);
-              get_featurenames(cubeOrigin, sqOrder, pixIndex, pixfeaturename, NSP, wrappedDims, voxelsPtr);
+              get_featurenames(cubeOrigin, sqOrder, pixIndex, pixfeaturename, NSP, wrappedDims, voxels);
               if(pixfeaturename[0] > 0 || pixfeaturename[1] > 0)
               {
-                size_t currentEdgeArraySize = cEdgePtr->getNumberOfTuples();
-                if(currentEdgeArraySize < eid + 1)
+                if(cEdge.size() < eid + 1)
                 {
-                  edgeResizeCount++;
-                  if(edgeResizeCount == 10)
-                  {
-                    edgeResizeCount = 0;
-                    edgeResize *= 10; // Increment the resize factor by an order of magnitude
-                  }
-                  cEdgePtr->resize(currentEdgeArraySize + edgeResize); // Allocate Edges in 100,000 packs
-                  currentEdgeArraySize = cEdgePtr->getNumberOfTuples();
-                  // qDebug() << "cEdgePtr->Resize(" <<currentEdgeArraySize << ")" << "\n";
+                  cEdge.resize(eid + 1);
                 }
-
-                SurfaceMesh::M3C::Segment* cEdge = cEdgePtr->getPointer(0);
                 cEdge[eid].node_id[0] = NodeID[0]; // actual Node ids for each edge...
                 cEdge[eid].node_id[1] = NodeID[1];
                 cEdge[eid].nSpin[0] = pixfeaturename[0];
@@ -1216,7 +1169,7 @@ size_t M3CSliceBySlice::get_nodes_Edges(int NSP, int zID, int* wrappedDims, Stru
       cSquare[k].nEdge = edgeCount;
     }
   }
-  cEdgePtr->resize(eid);
+  cEdge.resize(eid);
   return eid;
 }
 
@@ -1293,7 +1246,7 @@ int M3CSliceBySlice::get_square_index(int tNS[4])
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int M3CSliceBySlice::treat_anomaly(int tNSt[4], int zID1, DataArray<int32_t>::Pointer voxelsPtr, StructArray<SurfaceMesh::M3C::Neighbor>::Pointer neighborsPtr)
+int M3CSliceBySlice::treat_anomaly(int tNSt[4], int zID1, std::vector<int32_t>& voxels, std::vector<Neighbor>& neigh)
 {
   int i, j, k, ii;
   int csite, cfeaturename;
@@ -1305,8 +1258,6 @@ int M3CSliceBySlice::treat_anomaly(int tNSt[4], int zID1, DataArray<int32_t>::Po
   min = 1000;
   minid = -1;
 
-  int32_t* voxels = voxelsPtr->getPointer(0);
-  SurfaceMesh::M3C::Neighbor* neigh = neighborsPtr->getPointer(0);
 
   for(k = 0; k < 4; k++)
   {
@@ -1430,11 +1381,10 @@ void M3CSliceBySlice::get_nodes(int cst, int ord, int nidx[2], int* nid, int NSP
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void M3CSliceBySlice::get_featurenames(int cst, int ord, int pID[2], int* pfeaturename, int NSP, int* wrappedDims, DataArray<int32_t>::Pointer voxelsPtr)
+void M3CSliceBySlice::get_featurenames(int cst, int ord, int pID[2], int* pfeaturename, int NSP, int* wrappedDims, std::vector<int32_t>& voxels)
 {
   int i;
   int pixTemp, tempfeaturename;
-  int32_t* voxels = voxelsPtr->getPointer(0);
   for(i = 0; i < 2; i++)
   {
     pixTemp = pID[i];
@@ -1510,15 +1460,15 @@ void M3CSliceBySlice::get_featurenames(int cst, int ord, int pID[2], int* pfeatu
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int M3CSliceBySlice::get_triangles(int NSP, int* wrappedDims, StructArray<SurfaceMesh::M3C::Face>::Pointer cSquarePtr, DataArray<int32_t>::Pointer voxelsPtr,
-                                   DataArray<int8_t>::Pointer cVertexNodeTypePtr, StructArray<SurfaceMesh::M3C::Segment>::Pointer cEdgePtr, StructArray<SurfaceMesh::M3C::Patch>::Pointer cTrianglePtr)
+int M3CSliceBySlice::get_triangles(int NSP, int* wrappedDims, std::vector<Face>& cSquare, std::vector<int32_t>& voxels,
+                                   std::vector<int8_t>& nodeType, std::vector<Segment>& cEdge, std::vector<Patch>& cTriangle)
 {
   int i, ii, i1, i2;
   int sqID[6];
   int tsq;      // current sq id...
   int tnE;      // temp number of edges...
   int nFC;      // number of FC turned on...
-  int nE;       // number of SurfaceMesh::M3C::Face edges...
+  int nE;       // number of Face edges...
   int eff;      // all the squares effective?...
   int cubeFlag; // if 1, we can do marching cube; if 0, useless...
   int BCnode;   // cube center Node...
@@ -1535,12 +1485,6 @@ int M3CSliceBySlice::get_triangles(int NSP, int* wrappedDims, StructArray<Surfac
   int tidIn, tidOut;
   int arrayFC[6];
 
-  SurfaceMesh::M3C::Face* cSquare = cSquarePtr->getPointer(0);
-  int32_t* voxels = voxelsPtr->getPointer(0);
-  int8_t* nodeType = cVertexNodeTypePtr->getPointer(0);
-  // Reset these variables each time into this loop.
-  Detail::triangleResize = 1000;
-  Detail::triangleResizeCount = 0;
 
   tidIn = 0;
   for(i = 1; i <= NSP; i++)
@@ -1557,12 +1501,12 @@ int M3CSliceBySlice::get_triangles(int NSP, int* wrappedDims, StructArray<Surfac
     nFC = 0;
     nE = 0;
     eff = 0;
-    // initialize SurfaceMesh::M3C::Face center array...
+    // initialize Face center array...
     for(ii = 0; ii < 6; ii++)
     {
       arrayFC[ii] = -1;
     }
-    // Count the number of SurfaceMesh::M3C::Face center turned on and SurfaceMesh::M3C::Face edges...
+    // Count the number of Face center turned on and Face edges...
     fcid = 0;
     ii = 0;
     for(ii = 0; ii < 6; ii++)
@@ -1584,7 +1528,7 @@ int M3CSliceBySlice::get_triangles(int NSP, int* wrappedDims, StructArray<Surfac
     }
     if(nFC >= 3)
     {
-      // If number of SurfaceMesh::M3C::Face centers turned on is more than 2...
+      // If number of Face centers turned on is more than 2...
       // let's update the NodeKind of body center Node...
       tsqid1 = sqID[0];
       tsqid2 = sqID[5];
@@ -1645,15 +1589,15 @@ int M3CSliceBySlice::get_triangles(int NSP, int* wrappedDims, StructArray<Surfac
     }
     // Checking the number of edges for loops in the cube...
     // if the current marching cube is a collection of 6 effective squares...and
-    // the number of SurfaceMesh::M3C::Face edges at least 3...
+    // the number of Face edges at least 3...
     // when nE==2, it doen't happen
     // when nE==1, the edge will contribute for the Neighboring marching cube...
     // when nE==0, it meaNS the cube is inside a feature...
     if(cubeFlag == 1 && nE > 2)
     {
       // Make edge array for each marching cube...
-      arrayE = new int[nE];
-      boost::shared_array<int> arrayEPtr(arrayE);
+      std::vector<int> arrayEVec(nE);
+      arrayE = arrayEVec.data();
       tindex = 0;
       for(i1 = 0; i1 < 6; i1++)
       {
@@ -1671,58 +1615,53 @@ int M3CSliceBySlice::get_triangles(int NSP, int* wrappedDims, StructArray<Surfac
       // Consider each case as Z. Wu's paper...
       if(nFC == 0)
       {
-        // when there's no SurfaceMesh::M3C::Face center
-        get_case0_triangles(i, arrayE, nE, tidIn, &tidOut, cEdgePtr, cTrianglePtr);
+        // when there's no Face center
+        get_case0_triangles(i, arrayE, nE, tidIn, &tidOut, cEdge, cTriangle);
         tidIn = tidOut;
       }
       else if(nFC == 2)
       {
-        get_case2_triangles(i, arrayE, nE, arrayFC, nFC, tidIn, &tidOut, cEdgePtr, cTrianglePtr);
+        get_case2_triangles(i, arrayE, nE, arrayFC, nFC, tidIn, &tidOut, cEdge, cTriangle);
         tidIn = tidOut;
       }
       else if(nFC > 2 && nFC <= 6)
       {
-        get_caseM_triangles(i, arrayE, nE, arrayFC, nFC, tidIn, &tidOut, BCnode, cEdgePtr, cTrianglePtr);
+        get_caseM_triangles(i, arrayE, nE, arrayFC, nFC, tidIn, &tidOut, BCnode, cEdge, cTriangle);
         tidIn = tidOut;
       }
     }
   }
 
-  //  qDebug() << "cTrianglePtr->Resize(" << tidIn << ")" << "\n";
-  cTrianglePtr->resize(tidIn);
+  cTriangle.resize(tidIn);
 
-  //  qDebug() << "cEdgePtr numTuples: " << cEdgePtr->getNumberOfTuples() << " - Clearing Array" << "\n";
-  cEdgePtr->resize(0);
+  // The edges only live for one slice; clear() keeps their storage for the next one
+  cEdge.clear();
 
-  return cTrianglePtr->getNumberOfTuples();
+  return static_cast<int>(cTriangle.size());
 }
 
-#define ADD_TRIANGLE(cTrianglePtr, ctid, n0, n1, n2, label0, label1)                                                                                                                                   \
-  {                                                                                                                                                                                                    \
-    size_t current_##cTrianglePtr##_size = cTrianglePtr->getNumberOfTuples();                                                                                                                          \
-    if(current_##cTrianglePtr##_size < static_cast<size_t>(ctid + 1))                                                                                                                                  \
-    {                                                                                                                                                                                                  \
-      Detail::triangleResizeCount++;                                                                                                                                                                   \
-      if(Detail::triangleResizeCount == 10)                                                                                                                                                            \
-      {                                                                                                                                                                                                \
-        Detail::triangleResizeCount = 0;                                                                                                                                                               \
-        Detail::triangleResize *= 10;                                                                                                                                                                  \
-      }                                                                                                                                                                                                \
-      cTrianglePtr->resize(current_##cTrianglePtr##_size + Detail::triangleResize);                                                                                                                    \
-    }                                                                                                                                                                                                  \
-    StructArray<SurfaceMesh::M3C::Triangle>& cTriangle = *(cTrianglePtr.get());                                                                                                                        \
-    cTriangle[ctid].node_id[0] = n0;                                                                                                                                                                   \
-    cTriangle[ctid].node_id[1] = n1;                                                                                                                                                                   \
-    cTriangle[ctid].node_id[2] = n2;                                                                                                                                                                   \
-    cTriangle[ctid].nSpin[0] = label0;                                                                                                                                                                 \
-    cTriangle[ctid].nSpin[1] = label1;                                                                                                                                                                 \
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void M3CSliceBySlice::add_triangle(std::vector<Patch>& cTriangle, size_t ctid, int n0, int n1, int n2, int label0, int label1)
+{
+  if(cTriangle.size() < ctid + 1)
+  {
+    cTriangle.resize(ctid + 1);
   }
+  Patch& patch = cTriangle[ctid];
+  patch.node_id[0] = n0;
+  patch.node_id[1] = n1;
+  patch.node_id[2] = n2;
+  patch.nSpin[0] = label0;
+  patch.nSpin[1] = label1;
+}
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void M3CSliceBySlice::get_case0_triangles(int site, int* ae, int nedge, int tin, int* tout, StructArray<SurfaceMesh::M3C::Segment>::Pointer cEdgePtr,
-                                          StructArray<SurfaceMesh::M3C::Patch>::Pointer cTrianglePtr)
+void M3CSliceBySlice::get_case0_triangles(int site, int* ae, int nedge, int tin, int* tout, std::vector<Segment>& cEdge,
+                                          std::vector<Patch>& cTriangle)
 {
   int ii, i, j, jj, k, kk, k1, mm;
   int loopID;
@@ -1745,17 +1684,15 @@ void M3CSliceBySlice::get_case0_triangles(int site, int* ae, int nedge, int tin,
   int te0, te1, te2, tv0, tcVertex, tv2;
   int numT, cnumT, new_node0;
 
-  typedef boost::shared_array<int> SharedIntArray_t;
 
-  SharedIntArray_t burntPtr(new int[nedge]);
-  burnt = burntPtr.get();
+  std::vector<int> burntVec(nedge);
+  burnt = burntVec.data();
 
-  SharedIntArray_t burnt_list_ptr(new int[nedge]);
-  burnt_list = burnt_list_ptr.get();
+  std::vector<int> burntListVec(nedge);
+  burnt_list = burntListVec.data();
 
-  SurfaceMesh::M3C::Segment* cEdge = cEdgePtr->getPointer(0);
 
-  // initialize burn flags for SurfaceMesh::M3C::Face edges...
+  // initialize burn flags for Face edges...
   for(ii = 0; ii < nedge; ii++)
   {
     burnt[ii] = 0;
@@ -1791,7 +1728,7 @@ void M3CSliceBySlice::get_case0_triangles(int site, int* ae, int nedge, int tin,
             nSpin2 = cEdge[ne].nSpin[1];
             nnode1 = cEdge[ne].node_id[0];
             nnode2 = cEdge[ne].node_id[1];
-            // checking if SurfaceMesh::M3C::Neighbor edge has same Neighboring featurenames...
+            // checking if Neighbor edge has same Neighboring featurenames...
             if(((cfeaturename1 == nSpin1) && (cfeaturename2 == nSpin2)) || ((cfeaturename1 == nSpin2) && (cfeaturename2 == nSpin1)))
             {
               featurenameFlag = 1;
@@ -1846,8 +1783,8 @@ void M3CSliceBySlice::get_case0_triangles(int site, int* ae, int nedge, int tin,
       }
     }
   }
-  SharedIntArray_t countPtr(new int[loopID]);
-  count = countPtr.get();
+  std::vector<int> countVec(loopID);
+  count = countVec.data();
   for(k1 = 1; k1 < loopID; k1++)
   {
     count[k1] = 0;
@@ -1870,8 +1807,8 @@ void M3CSliceBySlice::get_case0_triangles(int site, int* ae, int nedge, int tin,
     numN = count[jj];
     sumN = sumN + numN;
     from = sumN - numN;
-    SharedIntArray_t loopPtr(new int[numN]);
-    loop = loopPtr.get();
+    std::vector<int> loopVec(numN);
+    loop = loopVec.data();
     for(mm = 0; mm < numN; mm++)
     {
       loop[mm] = burnt_list[from + mm];
@@ -1881,7 +1818,7 @@ void M3CSliceBySlice::get_case0_triangles(int site, int* ae, int nedge, int tin,
       te0 = loop[0];
       te1 = loop[1];
       te2 = loop[2];
-      ADD_TRIANGLE(cTrianglePtr, ctid, cEdge[te0].node_id[0], cEdge[te1].node_id[0], cEdge[te2].node_id[0], cEdge[te0].nSpin[0], cEdge[te0].nSpin[1]);
+      add_triangle(cTriangle, ctid, cEdge[te0].node_id[0], cEdge[te1].node_id[0], cEdge[te2].node_id[0], cEdge[te0].nSpin[0], cEdge[te0].nSpin[1]);
       ctid++;
     }
     else if(numN > 3)
@@ -1896,7 +1833,7 @@ void M3CSliceBySlice::get_case0_triangles(int site, int* ae, int nedge, int tin,
       tcVertex = cEdge[te0].node_id[1];
       tv2 = cEdge[te1].node_id[0];
       {
-        ADD_TRIANGLE(cTrianglePtr, ctid, tv0, tcVertex, tv2, cEdge[te0].nSpin[0], cEdge[te0].nSpin[1])
+        add_triangle(cTriangle, ctid, tv0, tcVertex, tv2, cEdge[te0].nSpin[0], cEdge[te0].nSpin[1]);
       }
       new_node0 = tv2;
       //  new_node1 = tcVertex;
@@ -1911,7 +1848,7 @@ void M3CSliceBySlice::get_case0_triangles(int site, int* ae, int nedge, int tin,
           tv0 = cEdge[ce].node_id[0];
           tcVertex = cEdge[ce].node_id[1];
           tv2 = new_node0;
-          ADD_TRIANGLE(cTrianglePtr, ctid, tv0, tcVertex, tv2, cEdge[ce].nSpin[0], cEdge[ce].nSpin[1])
+          add_triangle(cTriangle, ctid, tv0, tcVertex, tv2, cEdge[ce].nSpin[0], cEdge[ce].nSpin[1]);
 
           new_node0 = tcVertex;
           cnumT++;
@@ -1924,7 +1861,7 @@ void M3CSliceBySlice::get_case0_triangles(int site, int* ae, int nedge, int tin,
           tv0 = cEdge[ce].node_id[0];
           tcVertex = cEdge[ce].node_id[1];
           tv2 = new_node0;
-          ADD_TRIANGLE(cTrianglePtr, ctid, tv0, tcVertex, tv2, cEdge[ce].nSpin[0], cEdge[ce].nSpin[1])
+          add_triangle(cTriangle, ctid, tv0, tcVertex, tv2, cEdge[ce].nSpin[0], cEdge[ce].nSpin[1]);
 
           new_node0 = tv0;
           cnumT++;
@@ -1939,7 +1876,7 @@ void M3CSliceBySlice::get_case0_triangles(int site, int* ae, int nedge, int tin,
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void M3CSliceBySlice::get_case_triangles_helper(int nedge, int* burnt, int* burnt_list, int& loopID, int* ae, StructArray<SurfaceMesh::M3C::Segment>::Pointer cEdgePtr, QVector<int>& countVec)
+void M3CSliceBySlice::get_case_triangles_helper(int nedge, int* burnt, int* burnt_list, int& loopID, int* ae, std::vector<Segment>& cEdge, std::vector<int>& countVec)
 {
   int nSpin1, nSpin2, nnode1, nnode2;
   int bflag, nbflag;
@@ -1950,9 +1887,8 @@ void M3CSliceBySlice::get_case_triangles_helper(int nedge, int* burnt, int* burn
   int chaser;
   int cnode1, cnode2;
   int ce;
-  SurfaceMesh::M3C::Segment* cEdge = cEdgePtr->getPointer(0);
 
-  // initialize burn flags for SurfaceMesh::M3C::Face edges...
+  // initialize burn flags for Face edges...
   for(int ii = 0; ii < nedge; ii++)
   {
     burnt[ii] = 0;
@@ -1989,7 +1925,7 @@ void M3CSliceBySlice::get_case_triangles_helper(int nedge, int* burnt, int* burn
             nSpin2 = cEdge[ne].nSpin[1];
             nnode1 = cEdge[ne].node_id[0];
             nnode2 = cEdge[ne].node_id[1];
-            // checking if SurfaceMesh::M3C::Neighbor edge has same Neighboring featurenames...
+            // checking if Neighbor edge has same Neighboring featurenames...
             if(((cfeaturename1 == nSpin1) && (cfeaturename2 == nSpin2)) || ((cfeaturename1 == nSpin2) && (cfeaturename2 == nSpin1)))
             {
               featurenameFlag = 1;
@@ -2063,8 +1999,8 @@ void M3CSliceBySlice::get_case_triangles_helper(int nedge, int* burnt, int* burn
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void M3CSliceBySlice::get_case_triangles_helper_2(int* burnt_loop, int* burnt_list, int from, int to, int numN, int& ctid, StructArray<SurfaceMesh::M3C::Segment>::Pointer cEdgePtr,
-                                                  StructArray<SurfaceMesh::M3C::Patch>::Pointer cTrianglePtr)
+void M3CSliceBySlice::get_case_triangles_helper_2(int* burnt_loop, int* burnt_list, int from, int to, int numN, int& ctid, std::vector<Segment>& cEdge,
+                                                  std::vector<Patch>& cTriangle)
 {
   int front, back;
   int te0, te1, te2, tv0, tcVertex, tv2;
@@ -2074,7 +2010,6 @@ void M3CSliceBySlice::get_case_triangles_helper_2(int* burnt_loop, int* burnt_li
   int tnode;
   int tfeaturename;
 
-  SurfaceMesh::M3C::Segment* cEdge = cEdgePtr->getPointer(0);
 
   int startEdge = burnt_list[from];
   burnt_loop[0] = startEdge;
@@ -2114,7 +2049,7 @@ void M3CSliceBySlice::get_case_triangles_helper_2(int* burnt_loop, int* burnt_li
     te0 = burnt_loop[0];
     te1 = burnt_loop[1];
     te2 = burnt_loop[2];
-    ADD_TRIANGLE(cTrianglePtr, ctid, cEdge[te0].node_id[0], cEdge[te1].node_id[0], cEdge[te2].node_id[0], cEdge[te0].nSpin[0], cEdge[te0].nSpin[1])
+    add_triangle(cTriangle, ctid, cEdge[te0].node_id[0], cEdge[te1].node_id[0], cEdge[te2].node_id[0], cEdge[te0].nSpin[0], cEdge[te0].nSpin[1]);
 
     ctid++;
   }
@@ -2130,7 +2065,7 @@ void M3CSliceBySlice::get_case_triangles_helper_2(int* burnt_loop, int* burnt_li
     tcVertex = cEdge[te0].node_id[1];
     tv2 = cEdge[te1].node_id[0];
     {
-      ADD_TRIANGLE(cTrianglePtr, ctid, tv0, tcVertex, tv2, cEdge[te0].nSpin[0], cEdge[te0].nSpin[1])
+      add_triangle(cTriangle, ctid, tv0, tcVertex, tv2, cEdge[te0].nSpin[0], cEdge[te0].nSpin[1]);
     }
     new_node0 = tv2;
     //  new_node1 = tcVertex;
@@ -2145,7 +2080,7 @@ void M3CSliceBySlice::get_case_triangles_helper_2(int* burnt_loop, int* burnt_li
         tv0 = cEdge[ce].node_id[0];
         tcVertex = cEdge[ce].node_id[1];
         tv2 = new_node0;
-        ADD_TRIANGLE(cTrianglePtr, ctid, tv0, tcVertex, tv2, cEdge[ce].nSpin[0], cEdge[ce].nSpin[1])
+        add_triangle(cTriangle, ctid, tv0, tcVertex, tv2, cEdge[ce].nSpin[0], cEdge[ce].nSpin[1]);
 
         new_node0 = tcVertex;
         cnumT++;
@@ -2158,7 +2093,7 @@ void M3CSliceBySlice::get_case_triangles_helper_2(int* burnt_loop, int* burnt_li
         tv0 = cEdge[ce].node_id[0];
         tcVertex = cEdge[ce].node_id[1];
         tv2 = new_node0;
-        ADD_TRIANGLE(cTrianglePtr, ctid, tv0, tcVertex, tv2, cEdge[ce].nSpin[0], cEdge[ce].nSpin[1])
+        add_triangle(cTriangle, ctid, tv0, tcVertex, tv2, cEdge[ce].nSpin[0], cEdge[ce].nSpin[1]);
 
         new_node0 = tv0;
         cnumT++;
@@ -2171,8 +2106,8 @@ void M3CSliceBySlice::get_case_triangles_helper_2(int* burnt_loop, int* burnt_li
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void M3CSliceBySlice::get_case2_triangles(int site, int* ae, int nedge, int* afc, int nfctr, int tin, int* tout, StructArray<SurfaceMesh::M3C::Segment>::Pointer cEdgePtr,
-                                          StructArray<SurfaceMesh::M3C::Patch>::Pointer cTrianglePtr)
+void M3CSliceBySlice::get_case2_triangles(int site, int* ae, int nedge, int* afc, int nfctr, int tin, int* tout, std::vector<Segment>& cEdge,
+                                          std::vector<Patch>& cTriangle)
 {
 
   int n, i1;
@@ -2188,7 +2123,7 @@ void M3CSliceBySlice::get_case2_triangles(int site, int* ae, int nedge, int* afc
   int* burnt = nullptr;
   int* burnt_list = nullptr;
   int* count = nullptr;
-  QVector<int> countVec;
+  std::vector<int> countVec;
   int numN;
   int* burnt_loop = nullptr;
   int openL; // if a loop is an open loop, it's 1; if closed, it's 0...
@@ -2199,17 +2134,15 @@ void M3CSliceBySlice::get_case2_triangles(int site, int* ae, int nedge, int* afc
   int te0, te1, tv0, tcVertex, tv2;
   int numT, cnumT, new_node0;
 
-  typedef boost::shared_array<int> SharedIntArray_t;
 
-  SharedIntArray_t burntPtr(new int[nedge]);
-  burnt = burntPtr.get();
+  std::vector<int> burntVec(nedge);
+  burnt = burntVec.data();
 
-  SharedIntArray_t burnt_list_ptr(new int[nedge]);
-  burnt_list = burnt_list_ptr.get();
+  std::vector<int> burntListVec(nedge);
+  burnt_list = burntListVec.data();
 
-  SurfaceMesh::M3C::Segment* cEdge = cEdgePtr->getPointer(0);
 
-  get_case_triangles_helper(nedge, burnt, burnt_list, loopID, ae, cEdgePtr, countVec);
+  get_case_triangles_helper(nedge, burnt, burnt_list, loopID, ae, cEdge, countVec);
   count = &(countVec.front());
 
   // Let's make complete loops...
@@ -2229,8 +2162,8 @@ void M3CSliceBySlice::get_case2_triangles(int site, int* ae, int nedge, int* afc
     numN = count[j1];
     to = to + numN;
     from = to - numN;
-    SharedIntArray_t burnt_loop_ptr(new int[numN]);
-    burnt_loop = burnt_loop_ptr.get();
+    std::vector<int> burntLoopVec(numN);
+    burnt_loop = burntLoopVec.data();
     for(i1 = from; i1 < to; i1++)
     {
       ce = burnt_list[i1];
@@ -2302,7 +2235,7 @@ void M3CSliceBySlice::get_case2_triangles(int site, int* ae, int nedge, int* afc
         int tn1 = cEdge[te1].node_id[1];
         int ts0 = cEdge[te0].nSpin[0];
         int ts1 = cEdge[te0].nSpin[1];
-        ADD_TRIANGLE(cTrianglePtr, ctid, ccn, tn0, tn1, ts0, ts1)
+        add_triangle(cTriangle, ctid, ccn, tn0, tn1, ts0, ts1);
         ctid++;
       }
       else if(numN > 2)
@@ -2317,7 +2250,7 @@ void M3CSliceBySlice::get_case2_triangles(int site, int* ae, int nedge, int* afc
         tcVertex = cEdge[te0].node_id[1];
         tv2 = cEdge[te1].node_id[1];
         {
-          ADD_TRIANGLE(cTrianglePtr, ctid, tv0, tcVertex, tv2, cEdge[te0].nSpin[0], cEdge[te0].nSpin[1])
+          add_triangle(cTriangle, ctid, tv0, tcVertex, tv2, cEdge[te0].nSpin[0], cEdge[te0].nSpin[1]);
         }
         new_node0 = tv2;
         //    new_node1 = tcVertex;
@@ -2332,7 +2265,7 @@ void M3CSliceBySlice::get_case2_triangles(int site, int* ae, int nedge, int* afc
             tv0 = cEdge[ce].node_id[0];
             tcVertex = cEdge[ce].node_id[1];
             tv2 = new_node0;
-            ADD_TRIANGLE(cTrianglePtr, ctid, tv0, tcVertex, tv2, cEdge[ce].nSpin[0], cEdge[ce].nSpin[1])
+            add_triangle(cTriangle, ctid, tv0, tcVertex, tv2, cEdge[ce].nSpin[0], cEdge[ce].nSpin[1]);
 
             new_node0 = tcVertex;
             cnumT++;
@@ -2345,7 +2278,7 @@ void M3CSliceBySlice::get_case2_triangles(int site, int* ae, int nedge, int* afc
             tv0 = cEdge[ce].node_id[0];
             tcVertex = cEdge[ce].node_id[1];
             tv2 = new_node0;
-            ADD_TRIANGLE(cTrianglePtr, ctid, tv0, tcVertex, tv2, cEdge[ce].nSpin[0], cEdge[ce].nSpin[1])
+            add_triangle(cTriangle, ctid, tv0, tcVertex, tv2, cEdge[ce].nSpin[0], cEdge[ce].nSpin[1]);
 
             new_node0 = tv0;
             cnumT++;
@@ -2357,7 +2290,7 @@ void M3CSliceBySlice::get_case2_triangles(int site, int* ae, int nedge, int* afc
     else
     {
       // if current loop is a closed one....i.e., openL = 0...
-      get_case_triangles_helper_2(burnt_loop, burnt_list, from, to, numN, ctid, cEdgePtr, cTrianglePtr);
+      get_case_triangles_helper_2(burnt_loop, burnt_list, from, to, numN, ctid, cEdge, cTriangle);
     }
   }
   *tout = ctid;
@@ -2366,8 +2299,8 @@ void M3CSliceBySlice::get_case2_triangles(int site, int* ae, int nedge, int* afc
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void M3CSliceBySlice::get_caseM_triangles(int site, int* ae, int nedge, int* afc, int nfctr, int tin, int* tout, int ccn, StructArray<SurfaceMesh::M3C::Segment>::Pointer cEdgePtr,
-                                          StructArray<SurfaceMesh::M3C::Patch>::Pointer cTrianglePtr)
+void M3CSliceBySlice::get_caseM_triangles(int site, int* ae, int nedge, int* afc, int nfctr, int tin, int* tout, int ccn, std::vector<Segment>& cEdge,
+                                          std::vector<Patch>& cTriangle)
 {
   int n, i1;
   int n1, iii;
@@ -2382,7 +2315,7 @@ void M3CSliceBySlice::get_caseM_triangles(int site, int* ae, int nedge, int* afc
   int* burnt;
   int* burnt_list;
   int* count;
-  QVector<int> countVec;
+  std::vector<int> countVec;
   int numN; //, numTri;
   int tn0, tn1;
   int* burnt_loop;
@@ -2393,17 +2326,15 @@ void M3CSliceBySlice::get_caseM_triangles(int site, int* ae, int nedge, int* afc
   int ctid;
   int ts0, ts1;
 
-  typedef boost::shared_array<int> SharedIntArray_t;
 
-  SharedIntArray_t burntPtr(new int[nedge]);
-  burnt = burntPtr.get();
+  std::vector<int> burntVec(nedge);
+  burnt = burntVec.data();
 
-  SharedIntArray_t burnt_list_ptr(new int[nedge]);
-  burnt_list = burnt_list_ptr.get();
+  std::vector<int> burntListVec(nedge);
+  burnt_list = burntListVec.data();
 
-  SurfaceMesh::M3C::Segment* cEdge = cEdgePtr->getPointer(0);
 
-  get_case_triangles_helper(nedge, burnt, burnt_list, loopID, ae, cEdgePtr, countVec);
+  get_case_triangles_helper(nedge, burnt, burnt_list, loopID, ae, cEdge, countVec);
   count = &(countVec.front());
 
   // Let's make complete loops...
@@ -2418,8 +2349,8 @@ void M3CSliceBySlice::get_caseM_triangles(int site, int* ae, int nedge, int* afc
     numN = count[j1];
     to = to + numN;
     from = to - numN;
-    SharedIntArray_t burnt_loop_ptr(new int[numN]);
-    burnt_loop = burnt_loop_ptr.get();
+    std::vector<int> burntLoopVec(numN);
+    burnt_loop = burntLoopVec.data();
     for(i1 = from; i1 < to; i1++)
     {
       ce = burnt_list[i1];
@@ -2494,14 +2425,14 @@ void M3CSliceBySlice::get_caseM_triangles(int site, int* ae, int nedge, int* afc
         tn1 = cEdge[ce].node_id[1];
         ts0 = cEdge[ce].nSpin[0];
         ts1 = cEdge[ce].nSpin[1];
-        ADD_TRIANGLE(cTrianglePtr, ctid, ccn, tn0, tn1, ts0, ts1)
+        add_triangle(cTriangle, ctid, ccn, tn0, tn1, ts0, ts1);
         ctid++;
       }
     }
     else
     {
       // if current loop is a closed one....i.e., openL = 0...
-      get_case_triangles_helper_2(burnt_loop, burnt_list, from, to, numN, ctid, cEdgePtr, cTrianglePtr);
+      get_case_triangles_helper_2(burnt_loop, burnt_list, from, to, numN, ctid, cEdge, cTriangle);
     }
   }
   *tout = ctid;
@@ -2510,8 +2441,8 @@ void M3CSliceBySlice::get_caseM_triangles(int site, int* ae, int nedge, int* afc
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void M3CSliceBySlice::arrange_featurenames(int numT, int zID, int NSP, int* wrappedDims, float* res, StructArray<SurfaceMesh::M3C::Patch>::Pointer cTrianglePtr, VertexArray::Pointer cVertexPtr,
-                                           DataArray<int32_t>::Pointer voxelsPtr, StructArray<SurfaceMesh::M3C::Neighbor>::Pointer neighborsPtr)
+void M3CSliceBySlice::arrange_featurenames(int numT, int zID, int NSP, int* wrappedDims, float* res, std::vector<Patch>& cTriangle, std::vector<Vertex>& cVertex,
+                                           std::vector<int32_t>& voxels, std::vector<Neighbor>& neigh)
 {
   // int i, j;
   int cnode;
@@ -2530,10 +2461,6 @@ void M3CSliceBySlice::arrange_featurenames(int numT, int zID, int NSP, int* wrap
   int shift = (zID * NSP);
   int locale;
 
-  SurfaceMesh::M3C::Patch* cTriangle = cTrianglePtr->getPointer(0);
-  VertexArray::Vert_t* cVertex = cVertexPtr->getPointer(0);
-  int32_t* voxels = voxelsPtr->getPointer(0);
-  SurfaceMesh::M3C::Neighbor* neigh = neighborsPtr->getPointer(0);
 
   int nSpin1 = 0;
   int nSpin2 = 0;
@@ -2618,7 +2545,7 @@ void M3CSliceBySlice::arrange_featurenames(int numT, int zID, int NSP, int* wrap
     {
       c = 0.0;
     }
-    // update SurfaceMesh::M3C::Patch info...
+    // update Patch info...
     //    cTriangle[i]->normal[0] = a;
     //    cTriangle[i]->normal[1] = b;
     //    cTriangle[i]->normal[2] = c;
@@ -2649,27 +2576,24 @@ void M3CSliceBySlice::arrange_featurenames(int numT, int zID, int NSP, int* wrap
     int k = 0;
     int index = 0;
     int testtsite = 0;
-    // int sidechecked = 1;
+    bool flipped = false;
     int xDim = wrappedDims[0];
     int yDim = wrappedDims[1];
 
+    // The first 3 passes test along the normal, the last 3 against it. Nodes without a
+    // site are skipped; k only indexes tsite1 modulo 3 so it never reads past the array.
     while(cTriangle[i].nSpin[0] == -1 && k < 6)
     {
-      while(tsite1[k] == -1)
-      {
-        k++;
-      }
-      if(k == 3)
+      if(k >= 3 && !flipped)
       {
         a = -a, b = -b, c = -c;
+        flipped = true;
       }
-      if(k < 3)
+      index = k % 3;
+      if(tsite1[index] == -1)
       {
-        index = k;
-      }
-      if(k >= 3)
-      {
-        index = k - 3;
+        k++;
+        continue;
       }
       if(a != 0 && (tsite1[index] % xDim + a) >= 0 && (tsite1[index] % xDim + a) < xDim)
       {
@@ -2728,14 +2652,12 @@ void M3CSliceBySlice::arrange_featurenames(int numT, int zID, int NSP, int* wrap
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int M3CSliceBySlice::assign_nodeID(int nN, int NSP, DataArray<int32_t>::Pointer cVertexNodeIdPtr, DataArray<int8_t>::Pointer cVertexNodeTypePtr)
+int M3CSliceBySlice::assign_nodeID(int nN, int NSP, std::vector<int32_t>& nodeID, std::vector<int8_t>& nodeType)
 {
   int nid = 0;
   //  int nkind = 0;
   //  int cnid = 0;
 
-  int8_t* nodeType = cVertexNodeTypePtr->getPointer(0);
-  int32_t* nodeID = cVertexNodeIdPtr->getPointer(0);
   nid = nN;
   for(int i = 0; i < (7 * 2 * NSP); i++)
   {
@@ -2754,55 +2676,28 @@ int M3CSliceBySlice::assign_nodeID(int nN, int NSP, DataArray<int32_t>::Pointer
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void M3CSliceBySlice::update_node_edge_kind(int nT, StructArray<SurfaceMesh::M3C::Patch>::Pointer cTrianglePtr, DataArray<int8_t>::Pointer cVertexNodeTypePtr,
-                                            StructArray<SurfaceMesh::M3C::Segment>::Pointer cEdgePtr)
+void M3CSliceBySlice::update_node_edge_kind(int nT, std::vector<Patch>& cTriangle, std::vector<int8_t>& nodeType)
 {
   int tn = 0;
-  // int te;
   int triangleNodeType;
-  //  int tekind;
   int tspin1, tspin2;
 
-  SurfaceMesh::M3C::Triangle* t = cTrianglePtr->getPointer(0);
-  int8_t* nodeType = cVertexNodeTypePtr->getPointer(0);
-  //  SurfaceMesh::M3C::Segment* fe = cEdgePtr->getPointer(0);
-  //  int nfedge = cEdgePtr->getNumberOfTuples();
   for(int j = 0; j < nT; j++)
   {
-    tspin1 = t[j].nSpin[0];
-    tspin2 = t[j].nSpin[1];
+    tspin1 = cTriangle[j].nSpin[0];
+    tspin2 = cTriangle[j].nSpin[1];
     if(tspin1 * tspin2 < 0)
     {
       // if the triangle is the surface of whole microstructure...
-      // increase edge and node kind by 10...
+      // increase node kind by 10...
       for(int i = 0; i < 3; i++)
       {
-        // nodeKind...
-        tn = t[j].node_id[i];
+        tn = cTriangle[j].node_id[i];
         triangleNodeType = nodeType[tn];
         if(triangleNodeType < 10)
         {
           nodeType[tn] = triangleNodeType + 10;
         }
-        // edgeKind...
-        //        te = t[j].e_id[i];
-        //        if(te < nfedge)
-        //        {
-        //          tekind = fe[te].edgeKind;
-        //          if(tekind < 10)
-        //          {
-        //            fe[te].edgeKind = tekind + 10;
-        //          }
-        //        }
-        //        else
-        //        {
-        //          te = te - nfedge;
-        //          tekind = ie[te].edgeKind;
-        //          if(tekind < 10)
-        //          {
-        //            ie[te].edgeKind = tekind + 10;
-        //          }
-        //        }
       }
     }
   }
@@ -2811,47 +2706,18 @@ void M3CSliceBySlice::update_node_edge_kind(int nT, StructArray<SurfaceMesh::M3C
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int M3CSliceBySlice::writeNodesFile(int zID, int cNodeID, int NSP, const QString& nodesFile, VertexArray::Pointer cVertexPtr, DataArray<int32_t>::Pointer cVertexNodeIdPtr,
-                                    DataArray<int8_t>::Pointer cVertexNodeTypePtr)
+int M3CSliceBySlice::writeNodesFile(int cNodeID, int NSP, FILE* f, std::vector<Vertex>& cVertex, std::vector<int32_t>& nodeID, std::vector<int8_t>& nodeKind)
 {
-
-#if 0
-  static const size_t BYTE_COUNT = 20;
-  unsigned char data[BYTE_COUNT];
-  int* tId = (int*)(&data[0]);
-  int* nk = (int*)(&data[4]);
-  float* vec3f = (float*)(&data[8]);
-#endif
   const size_t BYTE_COUNT = sizeof(SurfaceMesh::NodesFile::NodesFileRecord_t);
   SurfaceMesh::NodesFile::NodesFileRecord_t record;
 
   size_t totalWritten = 0;
-  FILE* f = nullptr;
-
-  // qDebug() << "M3CSliceBySlice writing Nodes file " << cNodeID << "\n";
-
-  // Create a new file if this is our first slice
-  if(zID == 0)
+  if(nullptr == f)
   {
-    f = fopen(nodesFile.toLatin1().data(), "wb");
-    if(nullptr == f)
-    {
-      return -1;
-    }
-  }
-  // Append to existing file if we are on z>0 slice
-  if(zID > 0)
-  {
-    f = fopen(nodesFile.toLatin1().data(), "ab");
-    if(nullptr == f)
-    {
-      return -1;
-    }
+    return -1;
   }
+
   int total = (7 * 2 * NSP);
-  int32_t* nodeID = cVertexNodeIdPtr->getPointer(0);
-  int8_t* nodeKind = cVertexNodeTypePtr->getPointer(0);
-  VertexArray::Vert_t* cVertex = cVertexPtr->getPointer(0);
 
   for(int k = 0; k < total; k++)
   {
@@ -2878,65 +2744,33 @@ int M3CSliceBySlice::writeNodesFile(int zID, int cNodeID, int NSP, const QString
       //      }
     }
   }
-  fclose(f);
   return 0;
 }
 
 // -----------------------------------------------------------------------------
 //  Write a BINARY file which is only TEMP during the surface meshing
 // -----------------------------------------------------------------------------
-int M3CSliceBySlice::writeTrianglesFile(int zID, int ctid, const QString& trianglesFile, int nt, StructArray<SurfaceMesh::M3C::Patch>::Pointer cTrianglePtr,
-                                        DataArray<int32_t>::Pointer cVertexNodeIdPtr, int32_t featureIdZeroMappingValue)
+int M3CSliceBySlice::writeTrianglesFile(int ctid, FILE* f, int nt, std::vector<Patch>& cTriangle, std::vector<int32_t>& nodeID,
+                                        int32_t featureIdZeroMappingValue)
 {
-
-#if 0
-  static const size_t DATA_COUNT = 9;
-  int data[DATA_COUNT];
-  data[0] = ctid;
-#endif
-
   const size_t BYTE_COUNT = SurfaceMesh::TrianglesFile::ByteCount;
   SurfaceMesh::TrianglesFile::TrianglesFileRecord_t record;
   record.triId = ctid;
-  //  qDebug() << "Writing Triangles Starting at " << record.triId << "\n";
-  // int tag;
   int end = nt;
   int n1, n2, n3;
 
-  FILE* f = nullptr;
-
-  int32_t* nodeID = cVertexNodeIdPtr->getPointer(0);
-  SurfaceMesh::M3C::Patch* cTriangle = cTrianglePtr->getPointer(0);
-
-  // Create a new file if this is our first slice
-  if(zID == 0)
+  if(nullptr == f)
   {
-    f = fopen(trianglesFile.toLatin1().data(), "wb");
-    if(nullptr == f)
-    {
-      return -1;
-    }
-#if(WRITE_BINARY_TEMP_FILES == 0)
-    fprintf(f, "XXXXXXXXXXXX\n"); // This should get over written at some point with the actual number of triangles
-#endif
+    return -1;
   }
-  // Append to existing file if we are on z>0 slice
-  if(zID > 0)
-  {
-    f = fopen(trianglesFile.toLatin1().data(), "ab");
-    if(nullptr == f)
-    {
-      return -1;
-    }
-  }
-  ScopedFileMonitor monitor(f);
+
 
   size_t totalWritten = 0;
 
   //  outFile << nt <<endl;
   for(int i = 0; i < end; i++)
   {
-    SurfaceMesh::M3C::Patch& patch = cTriangle[i];
+    Patch& patch = cTriangle[i];
     n1 = patch.node_id[0];
     n2 = patch.node_id[1];
     n3 = patch.node_id[2];
@@ -2958,8 +2792,6 @@ int M3CSliceBySlice::writeTrianglesFile(int zID, int ctid, const QString& triang
     record.triId = record.triId + 1;
   }
 
-  // The ScopedFileMonitor Will make sure the FILE object is closed when we exit.
-
   return 0;
 }
 
@@ -2992,7 +2824,7 @@ void M3CSliceBySlice::analyzeWinding()
     int currentLabel = cLabel->first;
     //  if (currentLabel != 1) { continue; }
     masterTriangleIndex = cLabel->second;
-    SurfaceMesh::M3C::Patch::Pointer t = cTriangle[masterTriangleIndex];
+    Patch::Pointer t = cTriangle[masterTriangleIndex];
 
     if ( (progressIndex / total * 100.0f) > (curPercent) )
     {
@@ -3015,7 +2847,7 @@ void M3CSliceBySlice::analyzeWinding()
 
     while (triangleDeque.empty() == false)
     {
-      SurfaceMesh::M3C::Patch::Pointer currentTri = cTriangle[triangleDeque.front()];
+      Patch::Pointer currentTri = cTriangle[triangleDeque.front()];
       //    qDebug() << "tIndex = " << t->tIndex;
       localVisited.insert(currentTri->tIndex);
       QVector<int> adjTris = findAdjacentTriangles(currentTri, currentLabel);
@@ -3025,7 +2857,7 @@ void M3CSliceBySlice::analyzeWinding()
         if (masterVisited[*adjTri] == false)
         {
           //   qDebug() << "   * Checking Winding: " << (*adjTri)->tIndex;
-          SurfaceMesh::M3C::Patch::Pointer triToVerify = cTriangle[*adjTri];
+          Patch::Pointer triToVerify = cTriangle[*adjTri];
           currentTri->verifyWinding( triToVerify.get(), currentLabel);
         }
 
@@ -3051,7 +2883,7 @@ void M3CSliceBySlice::analyzeWinding()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-QVector<int> M3CSliceBySlice::findAdjacentTriangles(SurfaceMesh::M3C::Triangle* triangle, int label)
+QVector<int> M3CSliceBySlice::findAdjacentTriangles(Triangle* triangle, int label)
 {
   QVector<int> adjacentTris;
   typedef SharedEdge::Pointer EdgeType;
@@ -3068,7 +2900,7 @@ QVector<int> M3CSliceBySlice::findAdjacentTriangles(SurfaceMesh::M3C::Triangle*
     // Iterate over the indices to find triangles that match the label and are NOT the current triangle index
     for (QSet<int>::iterator iter = tIndices.begin(); iter != tIndices.end(); ++iter )
     {
-      SurfaceMesh::M3C::Patch::Pointer t = cTriangle.at(*iter);
+      Patch::Pointer t = cTriangle.at(*iter);
       if ( (t->nSpin[0] == label || t->nSpin[1] == label)
            && (t->tIndex != triangle->tIndex) )
       {
@@ -35,13 +35,13 @@
 
 #pragma once
 
+#include <cstdio>
+#include <vector>
+
 #include <QtCore/QString>
 
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
-#include "SIMPLib/DataArrays/StructArray.hpp"
 #include "SIMPLib/Filtering/AbstractFilter.h"
-#include "SIMPLib/Geometry/MeshStructs.h"
-#include "SIMPLib/Math/SIMPLibMath.h"
 #include "SIMPLib/SIMPLib.h"
 
 #include "SurfaceMeshing/SurfaceMeshingConstants.h"
@@ -59,9 +59,10 @@
  * generated triangle array and node array are read into memory. This version trades
  * off mush lower memory footprint during execution of the filter for some speed.
  * The increase in time to mesh a volume is due to the File I/O of the algorithm. File
- * writes are done in pure binary so to make them as quick as possible. An adaptive
- * memory allocation routine is also employeed to be able to scale the speed of the
- * algorithm from small voxel volumes to very large voxel volumes.
+ * writes are done in pure binary so to make them as quick as possible. @n
+ * When StreamMeshToDisk is enabled the final read back is skipped: the nodes and
+ * triangles files are kept at OutputFilePrefix and become the output of the filter, so
+ * the memory used does not depend on the number of slices.
  *
  * Multiple material marching cubes algorithm, Ziji Wu1, John M. Sullivan Jr2, International Journal for Numerical Methods in Engineering
  * Special Issue: Trends in Unstructured Mesh Generation, Volume 58, Issue 2, pages 189
@@ -72,14 +73,16 @@
 class SurfaceMeshing_EXPORT M3CSliceBySlice : public AbstractFilter
 {
   Q_OBJECT
-  //  PYB11_CREATE_BINDINGS(M3CSliceBySlice SUPERCLASS AbstractFilter)
-  // PYB11_PROPERTY(DataArrayPath SurfaceDataContainerName READ getSurfaceDataContainerName WRITE setSurfaceDataContainerName)
-  // PYB11_PROPERTY(QString VertexAttributeMatrixName READ getVertexAttributeMatrixName WRITE setVertexAttributeMatrixName)
-  // PYB11_PROPERTY(QString FaceAttributeMatrixName READ getFaceAttributeMatrixName WRITE setFaceAttributeMatrixName)
-  // PYB11_PROPERTY(QString FaceLabelsArrayName READ getFaceLabelsArrayName WRITE setFaceLabelsArrayName)
-  // PYB11_PROPERTY(QString SurfaceMeshNodeTypesArrayName READ getSurfaceMeshNodeTypesArrayName WRITE setSurfaceMeshNodeTypesArrayName)
-  // PYB11_PROPERTY(bool DeleteTempFiles READ getDeleteTempFiles WRITE setDeleteTempFiles)
-  // PYB11_PROPERTY(DataArrayPath FeatureIdsArrayPath READ getFeatureIdsArrayPath WRITE setFeatureIdsArrayPath)
+  PYB11_CREATE_BINDINGS(M3CSliceBySlice SUPERCLASS AbstractFilter)
+  PYB11_PROPERTY(DataArrayPath SurfaceDataContainerName READ getSurfaceDataContainerName WRITE setSurfaceDataContainerName)
+  PYB11_PROPERTY(QString VertexAttributeMatrixName READ getVertexAttributeMatrixName WRITE setVertexAttributeMatrixName)
+  PYB11_PROPERTY(QString FaceAttributeMatrixName READ getFaceAttributeMatrixName WRITE setFaceAttributeMatrixName)
+  PYB11_PROPERTY(QString FaceLabelsArrayName READ getFaceLabelsArrayName WRITE setFaceLabelsArrayName)
+  PYB11_PROPERTY(QString SurfaceMeshNodeTypesArrayName READ getSurfaceMeshNodeTypesArrayName WRITE setSurfaceMeshNodeTypesArrayName)
+  PYB11_PROPERTY(bool DeleteTempFiles READ getDeleteTempFiles WRITE setDeleteTempFiles)
+  PYB11_PROPERTY(bool StreamMeshToDisk READ getStreamMeshToDisk WRITE setStreamMeshToDisk)
+  PYB11_PROPERTY(QString OutputFilePrefix READ getOutputFilePrefix WRITE setOutputFilePrefix)
+  PYB11_PROPERTY(DataArrayPath FeatureIdsArrayPath READ getFeatureIdsArrayPath WRITE setFeatureIdsArrayPath)
 public:
   SIMPL_SHARED_POINTERS(M3CSliceBySlice)
   SIMPL_FILTER_NEW_MACRO(M3CSliceBySlice)
@@ -101,14 +104,47 @@ public:
   SIMPL_FILTER_PARAMETER(bool, DeleteTempFiles)
   Q_PROPERTY(bool DeleteTempFiles READ getDeleteTempFiles WRITE setDeleteTempFiles)
 
-  void preflight() override;
+  SIMPL_FILTER_PARAMETER(bool, StreamMeshToDisk)
+  Q_PROPERTY(bool StreamMeshToDisk READ getStreamMeshToDisk WRITE setStreamMeshToDisk)
+
+  SIMPL_FILTER_PARAMETER(QString, OutputFilePrefix)
+  Q_PROPERTY(QString OutputFilePrefix READ getOutputFilePrefix WRITE setOutputFilePrefix)
 
   SIMPL_FILTER_PARAMETER(DataArrayPath, FeatureIdsArrayPath)
   Q_PROPERTY(DataArrayPath FeatureIdsArrayPath READ getFeatureIdsArrayPath WRITE setFeatureIdsArrayPath)
 
+  /**
+   * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
+   */
   const QString getCompiledLibraryName() const override;
+
+  /**
+   * @brief getBrandingString Returns the branding string for the filter, which is a tag
+   * used to denote the filter's association with specific plugins
+   * @return Branding string
+   */
+  const QString getBrandingString() const override;
+
+  /**
+   * @brief getFilterVersion Returns a version string for this filter. Default
+   * value is an empty string.
+   * @return
+   */
+  const QString getFilterVersion() const override;
+
+  /**
+   * @brief newFilterInstance Reimplemented from @see AbstractFilter class
+   */
   AbstractFilter::Pointer newFilterInstance(bool copyFilterParameters) const override;
+
+  /**
+   * @brief getGroupName Reimplemented from @see AbstractFilter class
+   */
   const QString getGroupName() const override;
+
+  /**
+   * @brief getSubGroupName Reimplemented from @see AbstractFilter class
+   */
   const QString getSubGroupName() const override;
 
   /**
@@ -116,15 +152,31 @@ public:
    * @return A QUuid object.
    */
   const QUuid getUuid() override;
+
+  /**
+   * @brief getHumanLabel Reimplemented from @see AbstractFilter class
+   */
   const QString getHumanLabel() const override;
 
-  void setupFilterParameters() override; /**
-                                          *@brief This method will read the options from a file
-                                          *@param reader The reader that is used to read the options from a file
-                                          */
+  /**
+   * @brief setupFilterParameters Reimplemented from @see AbstractFilter class
+   */
+  void setupFilterParameters() override;
+
+  /**
+   * @brief readFilterParameters Reimplemented from @see AbstractFilter class
+   */
   void readFilterParameters(AbstractFilterParametersReader* reader, int index) override;
 
-  void execute();
+  /**
+   * @brief execute Reimplemented from @see AbstractFilter class
+   */
+  void execute() override;
+
+  /**
+   * @brief preflight Reimplemented from @see AbstractFilter class
+   */
+  void preflight() override;
 
 signals:
   void updateFilterParameters(AbstractFilter* filter);
@@ -135,15 +187,71 @@ signals:
 protected:
   M3CSliceBySlice();
 
+  /**
+   * @brief dataCheck Checks for the appropriate parameter values and availability of arrays
+   */
+  void dataCheck();
+
+  /**
+   * @brief Initializes all the private instance variables.
+   */
+  void initialize();
+
+  /**
+   * @brief The 26 neighbors of a site in the two working slices (index 0 is unused)
+   */
+  struct Neighbor
+  {
+    int neigh_id[27];
+  };
+
+  /**
+   * @brief One of the 3 squares owned by each site of the working slices
+   */
+  struct Face
+  {
+    int site_id[4];
+    int edge_id[4];
+    int nEdge;
+    int FCnode;
+    int effect;
+  };
+
+  /**
+   * @brief A face edge between two nodes along with the feature ids on either side
+   */
+  struct Segment
+  {
+    int node_id[2];
+    int nSpin[2];
+    int edgeKind;
+  };
+
+  /**
+   * @brief A triangle of the current slice along with the feature ids on either side
+   */
+  struct Patch
+  {
+    int node_id[3];
+    int nSpin[2];
+  };
+
+  /**
+   * @brief The position of one of the 7 nodes owned by each site of the working slices
+   */
+  struct Vertex
+  {
+    float pos[3];
+  };
+
   /**
    * @brief get_neighbor_list
    * @param NSP
    * @param NS
    * @param wrappedDims
-   * @param neighborsPtr
-   * @param neighborCSiteIdPtr
+   * @param neigh
    */
-  void get_neighbor_list(int NSP, int NS, int wrappedDims[], StructArray<SurfaceMesh::M3C::Neighbor>::Pointer neighborsPtr, DataArray<int32_t>::Pointer neighborCSiteIdPtr);
+  void get_neighbor_list(int NSP, int NS, int wrappedDims[], std::vector<Neighbor>& neigh);
 
   /**
    * @brief initialize_nodes
@@ -151,50 +259,48 @@ protected:
    * @param zID
    * @param wrappedDims
    * @param res
-   * @param cVertexPtr
-   * @param voxelsPtr
-   * @param cVertexNodeIdPtr
-   * @param cVertexNodeTypePtr
+   * @param cVertex
+   * @param voxels
+   * @param nodeID
+   * @param nodeKind
    */
-  void initialize_nodes(int NSP, int zID, int* wrappedDims, float* res, VertexArray::Pointer cVertexPtr, DataArray<int32_t>::Pointer voxelsPtr, DataArray<int32_t>::Pointer cVertexNodeIdPtr,
-                        DataArray<int8_t>::Pointer cVertexNodeTypePtr);
+  void initialize_nodes(int NSP, int zID, int* wrappedDims, float* res, std::vector<Vertex>& cVertex, std::vector<int32_t>& voxels, std::vector<int32_t>& nodeID, std::vector<int8_t>& nodeKind);
 
   /**
    * @brief initialize_squares
    * @param zID
    * @param NSP
-   * @param cSquarePtr
-   * @param neighborsPtr
+   * @param cSquare
+   * @param neigh
    */
-  void initialize_squares(int zID, int NSP, StructArray<SurfaceMesh::M3C::Face>::Pointer cSquarePtr, StructArray<SurfaceMesh::M3C::Neighbor>::Pointer neighborsPtr);
+  void initialize_squares(int zID, int NSP, std::vector<Face>& cSquare, std::vector<Neighbor>& neigh);
 
   /**
    * @brief get_nodes_Edges
    * @param NSP
    * @param zID
    * @param wrappedDims
-   * @param cSquarePtr
-   * @param voxelsPtr
-   * @param cEdgePtr
-   * @param cVertexNodeTypePtr
-   * @param neighborsPtr
+   * @param cSquare
+   * @param voxels
+   * @param cEdge
+   * @param nodeType
+   * @param neigh
    * @return
    */
-  size_t get_nodes_Edges(int NSP, int zID, int* wrappedDims, StructArray<SurfaceMesh::M3C::Face>::Pointer cSquarePtr, DataArray<int32_t>::Pointer voxelsPtr,
-                         StructArray<SurfaceMesh::M3C::Segment>::Pointer cEdgePtr, DataArray<int8_t>::Pointer cVertexNodeTypePtr, StructArray<SurfaceMesh::M3C::Neighbor>::Pointer neighborsPtr);
+  size_t get_nodes_Edges(int NSP, int zID, int* wrappedDims, std::vector<Face>& cSquare, std::vector<int32_t>& voxels, std::vector<Segment>& cEdge, std::vector<int8_t>& nodeType,
+                         std::vector<Neighbor>& neigh);
   /**
    * @brief get_triangles
    * @param NSP
    * @param wrappedDims
-   * @param cSquarePtr
-   * @param voxelsPtr
-   * @param cVertexNodeTypePtr
-   * @param cEdgePtr
-   * @param cTrianglePtr
+   * @param cSquare
+   * @param voxels
+   * @param nodeType
+   * @param cEdge
+   * @param cTriangle
    * @return
    */
-  int get_triangles(int NSP, int* wrappedDims, StructArray<SurfaceMesh::M3C::Face>::Pointer cSquarePtr, DataArray<int32_t>::Pointer voxelsPtr, DataArray<int8_t>::Pointer cVertexNodeTypePtr,
-                    StructArray<SurfaceMesh::M3C::Segment>::Pointer cEdgePtr, StructArray<SurfaceMesh::M3C::Patch>::Pointer cTrianglePtr);
+  int get_triangles(int NSP, int* wrappedDims, std::vector<Face>& cSquare, std::vector<int32_t>& voxels, std::vector<int8_t>& nodeType, std::vector<Segment>& cEdge, std::vector<Patch>& cTriangle);
 
   /**
    * @brief arrange_featurenames
@@ -202,14 +308,14 @@ protected:
    * @param zID
    * @param NSP
    * @param wrappedDims
-   * @param cTrianglePtr
-   * @param cVertexPtr
-   * @param voxelsPtr
-   * @param cVertexNodeIdPtr
-   * @param neighborsPtr
+   * @param res
+   * @param cTriangle
+   * @param cVertex
+   * @param voxels
+   * @param neigh
    */
-  void arrange_featurenames(int numT, int zID, int NSP, int* wrappedDims, float* res, StructArray<SurfaceMesh::M3C::Patch>::Pointer cTrianglePtr, VertexArray::Pointer cVertexPtr,
-                            DataArray<int32_t>::Pointer voxelsPtr, StructArray<SurfaceMesh::M3C::Neighbor>::Pointer neighborsPtr);
+  void arrange_featurenames(int numT, int zID, int NSP, int* wrappedDims, float* res, std::vector<Patch>& cTriangle, std::vector<Vertex>& cVertex, std::vector<int32_t>& voxels,
+                            std::vector<Neighbor>& neigh);
 
   /**
    * @brief find_xcoord
@@ -242,11 +348,11 @@ protected:
    * @brief treat_anomaly
    * @param tNSt
    * @param zID1
-   * @param voxelsPtr
-   * @param neighborsPtr
+   * @param voxels
+   * @param neigh
    * @return
    */
-  int treat_anomaly(int tNSt[4], int zID1, DataArray<int32_t>::Pointer voxelsPtr, StructArray<SurfaceMesh::M3C::Neighbor>::Pointer neighborsPtr);
+  int treat_anomaly(int tNSt[4], int zID1, std::vector<int32_t>& voxels, std::vector<Neighbor>& neigh);
 
   /**
    * @brief get_nodes
@@ -267,30 +373,39 @@ protected:
    * @param pfeaturename
    * @param NSP
    * @param wrappedDims
-   * @param voxelsPtr
+   * @param voxels
    */
-  void get_featurenames(int cst, int ord, int pID[2], int* pfeaturename, int NSP, int* wrappedDims, DataArray<int32_t>::Pointer voxelsPtr);
+  void get_featurenames(int cst, int ord, int pID[2], int* pfeaturename, int NSP, int* wrappedDims, std::vector<int32_t>& voxels);
 
-  void get_case0_triangles(int site, int* ae, int nedge, int tin, int* tout, StructArray<SurfaceMesh::M3C::Segment>::Pointer cEdgePtr, StructArray<SurfaceMesh::M3C::Patch>::Pointer cTrianglePtr);
-  void get_case2_triangles(int site, int* ae, int nedge, int* afc, int nfctr, int tin, int* tout, StructArray<SurfaceMesh::M3C::Segment>::Pointer cEdgePtr,
-                           StructArray<SurfaceMesh::M3C::Patch>::Pointer cTrianglePtr);
-  void get_caseM_triangles(int site, int* afe, int nfedge, int* afc, int nfctr, int tin, int* tout, int ccn, StructArray<SurfaceMesh::M3C::Segment>::Pointer cEdgePtr,
-                           StructArray<SurfaceMesh::M3C::Patch>::Pointer cTrianglePtr);
+  void get_case0_triangles(int site, int* ae, int nedge, int tin, int* tout, std::vector<Segment>& cEdge, std::vector<Patch>& cTriangle);
+  void get_case2_triangles(int site, int* ae, int nedge, int* afc, int nfctr, int tin, int* tout, std::vector<Segment>& cEdge, std::vector<Patch>& cTriangle);
+  void get_caseM_triangles(int site, int* afe, int nfedge, int* afc, int nfctr, int tin, int* tout, int ccn, std::vector<Segment>& cEdge, std::vector<Patch>& cTriangle);
 
-  void get_case_triangles_helper(int nedge, int* burnt, int* burnt_list, int& loopID, int* ae, StructArray<SurfaceMesh::M3C::Segment>::Pointer cEdgePtr, QVector<int>& countVec);
+  void get_case_triangles_helper(int nedge, int* burnt, int* burnt_list, int& loopID, int* ae, std::vector<Segment>& cEdge, std::vector<int>& countVec);
 
-  void get_case_triangles_helper_2(int* burnt_loop, int* burnt_list, int from, int to, int numN, int& ctid, StructArray<SurfaceMesh::M3C::Segment>::Pointer cEdgePtr,
-                                   StructArray<SurfaceMesh::M3C::Patch>::Pointer cTrianglePtr);
+  void get_case_triangles_helper_2(int* burnt_loop, int* burnt_list, int from, int to, int numN, int& ctid, std::vector<Segment>& cEdge, std::vector<Patch>& cTriangle);
+
+  /**
+   * @brief add_triangle Stores a triangle at index ctid, growing the triangle array when needed
+   * @param cTriangle
+   * @param ctid
+   * @param n0
+   * @param n1
+   * @param n2
+   * @param label0
+   * @param label1
+   */
+  void add_triangle(std::vector<Patch>& cTriangle, size_t ctid, int n0, int n1, int n2, int label0, int label1);
 
   /**
    * @brief assign_nodeID
    * @param nN
    * @param NSP
-   * @param cVertexNodeIdPtr
-   * @param cVertexNodeTypePtr
+   * @param nodeID
+   * @param nodeType
    * @return
    */
-  int assign_nodeID(int nN, int NSP, DataArray<int32_t>::Pointer cVertexNodeIdPtr, DataArray<int8_t>::Pointer cVertexNodeTypePtr);
+  int assign_nodeID(int nN, int NSP, std::vector<int32_t>& nodeID, std::vector<int8_t>& nodeType);
   /**
    * @brief get_square_index
    * @param tns
@@ -299,37 +414,28 @@ protected:
   int get_square_index(int tns[4]);
 
   /**
-   * @brief update_current_triangles
-   * @param nT
-   */
-  void update_current_triangles(int nT);
-
-  /**
-   * @brief writeNodesFile
-   * @param zID
+   * @brief writeNodesFile Appends the nodes that were created by the current slice to the nodes file
    * @param cNodeID
    * @param NSP
-   * @param nodesFile
-   * @param cVertexPtr
-   * @param cVertexNodeIdPtr
-   * @param cVertexNodeTypePtr
+   * @param f Open nodes file
+   * @param cVertex
+   * @param nodeID
+   * @param nodeKind
    * @return
    */
-  int writeNodesFile(int zID, int cNodeID, int NSP, const QString& nodesFile, VertexArray::Pointer cVertexPtr, DataArray<int32_t>::Pointer cVertexNodeIdPtr,
-                     DataArray<int8_t>::Pointer cVertexNodeTypePtr);
+  int writeNodesFile(int cNodeID, int NSP, FILE* f, std::vector<Vertex>& cVertex, std::vector<int32_t>& nodeID, std::vector<int8_t>& nodeKind);
 
   /**
-   * @brief writeTrianglesFile
-   * @param zID
+   * @brief writeTrianglesFile Appends the triangles of the current slice to the triangles file
    * @param ctid
-   * @param trianglesFile
+   * @param f Open triangles file
    * @param nt
-   * @param cTrianglePtr
-   * @param cVertexNodeIdPtr
+   * @param cTriangle
+   * @param nodeID
+   * @param featureIdZeroMappingValue
    * @return
    */
-  int writeTrianglesFile(int zID, int ctid, const QString& trianglesFile, int nt, StructArray<SurfaceMesh::M3C::Patch>::Pointer cTrianglePtr, DataArray<int32_t>::Pointer cVertexNodeIdPtr,
-                         int32_t featureIdZeroMappingValue);
+  int writeTrianglesFile(int ctid, FILE* f, int nt, std::vector<Patch>& cTriangle, std::vector<int32_t>& nodeID, int32_t featureIdZeroMappingValue);
 
   /**
    * @brief volumeHasGhostLayer
@@ -337,16 +443,11 @@ protected:
    */
   bool volumeHasGhostLayer();
   void copyBulkSliceIntoWorkingArray(int i, int* wrappedDims, size_t* dims, int32_t* voxels);
-  void update_node_edge_kind(int nT, StructArray<SurfaceMesh::M3C::Patch>::Pointer cTrianglePtr, DataArray<int8_t>::Pointer cVertexNodeTypePtr,
-                             StructArray<SurfaceMesh::M3C::Segment>::Pointer cEdgePtr);
+  void update_node_edge_kind(int nT, std::vector<Patch>& cTriangle, std::vector<int8_t>& nodeType);
 
   int32_t volumeHasFeatureValuesOfZero();
   void renumberVoxelFeatureIds(int32_t gid);
 
-  // The next two methods are for analyzing the winding
-  // void analyzeWinding();
-  // QVector<int> findAdjacentTriangles(Triangle *triangle, int label);
-
 private:
   DEFINE_DATAARRAY_VARIABLE(int32_t, FeatureIds)
 
@@ -354,12 +455,9 @@ private:
 
   float m_OriginX, m_OriginY, m_OriginZ;
 
-  void dataCheck();
-
 public:
   M3CSliceBySlice(const M3CSliceBySlice&) = delete; // Copy Constructor Not Implemented
   M3CSliceBySlice(M3CSliceBySlice&&) = delete;      // Move Constructor Not Implemented
   M3CSliceBySlice& operator=(const M3CSliceBySlice&) = delete; // Copy Assignment Not Implemented
-  M3CSliceBySlice& operator=(M3CSliceBySlice&&) = delete;
+  M3CSliceBySlice& operator=(M3CSliceBySlice&&) = delete;      // Move Assignment Not Implemented
 };
-
@@ -51,81 +51,365 @@
 // Michael A. Jackson as part of SAIC Prime contract N00173-07-C-2068
 #include "MovingFiniteElementSmoothing.h"
 
-#include <iomanip>
+#include <algorithm>
+#include <cmath>
 #include <limits>
+#include <vector>
 
 #include "SIMPLib/Common/Constants.h"
-#include "SIMPLib/DataArrays/StructArray.hpp"
-#include "SIMPLib/Geometry/MeshStructs.h"
+#include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
+#include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/DoubleFilterParameter.h"
+#include "SIMPLib/FilterParameters/IntFilterParameter.h"
+#include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
 
+#include "SurfaceMeshing/SurfaceMeshingConstants.h"
 #include "SurfaceMeshing/SurfaceMeshingFilters/MeshFunctions.h"
 #include "SurfaceMeshing/SurfaceMeshingFilters/MeshLinearAlgebra.h"
+#include "SurfaceMeshing/SurfaceMeshingVersion.h"
 
-#define ENABLE_MFE_SMOOTHING_RESTART_FILE 0
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-class pvector
+namespace
+{
+/**
+ * @brief The MFENode struct is the double precision copy of a vertex the smoothing works on
+ */
+struct MFENode
+{
+  double pos[3];
+};
+
+typedef NodeFunctions<MFENode, double> MFENodeFunctionsType;
+typedef TriangleFunctions<MFENode, double> MFETriangleFunctionsType;
+
+/**
+ * @brief The MFETriangleTerms struct holds what one update step needs from a triangle: its unit
+ * normal, its area and the finite difference force on each coordinate of each of its corners
+ */
+struct MFETriangleTerms
+{
+  double normal[3];
+  double area;
+  double force[9];
+};
+
+/**
+ * @brief The MFETriangleTermsImpl class computes the triangle terms, the quality and the minimum
+ * dihedral angle of a range of triangles. The finite difference perturbations are applied to
+ * local copies of the corner nodes so triangles sharing a node can be processed concurrently.
+ */
+class MFETriangleTermsImpl
 {
 public:
-  double coefft[3];
+  MFETriangleTermsImpl(MFENode* nodes, const int64_t* triangles, const int64_t* tripleNeighbors, double aScale, double qScale, double tjScale, std::vector<MFETriangleTerms>& terms,
+                       std::vector<double>& qualities, std::vector<double>& dihedrals)
+  : m_Nodes(nodes)
+  , m_Triangles(triangles)
+  , m_TripleNeighbors(tripleNeighbors)
+  , m_AScale(aScale)
+  , m_QScale(qScale)
+  , m_TJScale(tjScale)
+  , m_Terms(terms)
+  , m_Qualities(qualities)
+  , m_Dihedrals(dihedrals)
+  {
+  }
+  virtual ~MFETriangleTermsImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    const double small = 1.0e-12;
+    for(size_t t = start; t < end; t++)
+    {
+      const int64_t* verts = m_Triangles + 3 * t;
+      MFENode corners[3] = {m_Nodes[verts[0]], m_Nodes[verts[1]], m_Nodes[verts[2]]};
+      MFETriangleTerms& terms = m_Terms[t];
+
+      MFE::Vector<double> n = MFETriangleFunctionsType::normal(corners[0], corners[1], corners[2]);
+      terms.normal[0] = n[0];
+      terms.normal[1] = n[1];
+      terms.normal[2] = n[2];
+      double A = MFETriangleFunctionsType::area(corners[0], corners[1], corners[2]);
+      double Q = MFETriangleFunctionsType::circularity(corners[0], corners[1], corners[2], A);
+      terms.area = A;
+      m_Qualities[t] = Q;
+      m_Dihedrals[t] = MFETriangleFunctionsType::MinDihedral(corners[0], corners[1], corners[2]);
+
+      for(int n0 = 0; n0 < 3; n0++)
+      {
+        // Nodes on a triple line are also pulled by the change in length of the line through them
+        const int64_t* tripleNeighbors = m_TripleNeighbors + 2 * verts[n0];
+        bool tripleNode = (tripleNeighbors[0] >= 0 && tripleNeighbors[1] >= 0);
+        double LDistance = 0.0;
+        if(tripleNode)
+        {
+          LDistance = MFENodeFunctionsType::Distance(corners[n0], m_Nodes[tripleNeighbors[0]]) + MFENodeFunctionsType::Distance(m_Nodes[tripleNeighbors[1]], corners[n0]);
+        }
+        for(int j = 0; j < 3; j++)
+        {
+          double saved = corners[n0].pos[j];
+          corners[n0].pos[j] += small;
+          double Anew = MFETriangleFunctionsType::area(corners[0], corners[1], corners[2]);
+          double Qnew = MFETriangleFunctionsType::circularity(corners[0], corners[1], corners[2], Anew);
+          double force = (m_AScale * (Anew - A) + m_QScale * (Qnew - Q) * A) / small;
+          if(tripleNode)
+          {
+            double deltaLDistance =
+                MFENodeFunctionsType::Distance(corners[n0], m_Nodes[tripleNeighbors[0]]) + MFENodeFunctionsType::Distance(m_Nodes[tripleNeighbors[1]], corners[n0]) - LDistance;
+            force += m_TJScale * deltaLDistance;
+          }
+          corners[n0].pos[j] = saved;
+          terms.force[3 * n0 + j] = force;
+        }
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  MFENode* m_Nodes;
+  const int64_t* m_Triangles;
+  const int64_t* m_TripleNeighbors;
+  double m_AScale;
+  double m_QScale;
+  double m_TJScale;
+  std::vector<MFETriangleTerms>& m_Terms;
+  std::vector<double>& m_Qualities;
+  std::vector<double>& m_Dihedrals;
 };
 
-typedef struct
+/**
+ * @brief The MFENodeForcesImpl class gathers, through the node to triangle incidence, the force
+ * and the stiffness diagonal of a range of nodes from the triangle terms
+ */
+class MFENodeForcesImpl
 {
-  int triplenn1;
-  int triplenn2;
-} TripleNN;
+public:
+  MFENodeForcesImpl(const std::vector<int64_t>& offsets, const std::vector<int64_t>& incidence, const std::vector<MFETriangleTerms>& terms, double epsilon, MFE::Vector<double>& F,
+                    std::vector<double>& diagonal)
+  : m_Offsets(offsets)
+  , m_Incidence(incidence)
+  , m_Terms(terms)
+  , m_Epsilon(epsilon)
+  , m_F(F)
+  , m_Diagonal(diagonal)
+  {
+  }
+  virtual ~MFENodeForcesImpl() = default;
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-inline int delta(int i, int j)
+  void convert(size_t start, size_t end) const
+  {
+    const double one12th = 1.0 / 12.0;
+    for(size_t r = start; r < end; r++)
+    {
+      double force[3] = {0.0, 0.0, 0.0};
+      double diagonal[3] = {m_Epsilon, m_Epsilon, m_Epsilon};
+      for(int64_t e = m_Offsets[r]; e < m_Offsets[r + 1]; e++)
+      {
+        const MFETriangleTerms& terms = m_Terms[m_Incidence[e] / 3];
+        int64_t corner = m_Incidence[e] % 3;
+        for(int j = 0; j < 3; j++)
+        {
+          force[j] -= terms.force[3 * corner + j];
+          diagonal[j] += one12th * 2.0 * terms.normal[j] * terms.normal[j] * terms.area;
+        }
+      }
+      for(int j = 0; j < 3; j++)
+      {
+        m_F[static_cast<int>(3 * r + j)] = force[j];
+        m_Diagonal[3 * r + j] = diagonal[j];
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const std::vector<int64_t>& m_Offsets;
+  const std::vector<int64_t>& m_Incidence;
+  const std::vector<MFETriangleTerms>& m_Terms;
+  double m_Epsilon;
+  MFE::Vector<double>& m_F;
+  std::vector<double>& m_Diagonal;
+};
+
+/**
+ * @brief The MFETriangleDotsImpl class computes, for a range of triangles, the dot product of the
+ * triangle normal with the sum of the vectors of its three corners
+ */
+class MFETriangleDotsImpl
 {
-  return (i == j);
-}
+public:
+  MFETriangleDotsImpl(const int64_t* triangles, const std::vector<MFETriangleTerms>& terms, const MFE::Vector<double>& x, std::vector<double>& dots)
+  : m_Triangles(triangles)
+  , m_Terms(terms)
+  , m_X(x)
+  , m_Dots(dots)
+  {
+  }
+  virtual ~MFETriangleDotsImpl() = default;
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-template <typename Node, typename T> void LineCurvatureDirection(pvector& v, Node& n0, Node& n1, Node& n2)
-//  returns vector along which curvature points at node n1
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t t = start; t < end; t++)
+    {
+      const MFETriangleTerms& terms = m_Terms[t];
+      double dot = 0.0;
+      for(int c = 0; c < 3; c++)
+      {
+        int i = static_cast<int>(m_Triangles[3 * t + c]);
+        dot += terms.normal[0] * m_X[3 * i] + terms.normal[1] * m_X[3 * i + 1] + terms.normal[2] * m_X[3 * i + 2];
+      }
+      m_Dots[t] = dot;
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const int64_t* m_Triangles;
+  const std::vector<MFETriangleTerms>& m_Terms;
+  const MFE::Vector<double>& m_X;
+  std::vector<double>& m_Dots;
+};
+
+/**
+ * @brief The MFEStiffnessProductImpl class computes the stiffness matrix times a vector for a
+ * range of nodes, gathering the contributions of the triangles around each node
+ */
+class MFEStiffnessProductImpl
 {
-  v.coefft[0] = (2. * n1.pos[0]) - n2.pos[0] - n0.pos[0];
-  v.coefft[1] = (2. * n1.pos[1]) - n2.pos[1] - n0.pos[1];
-  v.coefft[2] = (2. * n1.pos[2]) - n2.pos[2] - n0.pos[2];
-  return;
-}
+public:
+  MFEStiffnessProductImpl(const std::vector<int64_t>& offsets, const std::vector<int64_t>& incidence, const std::vector<MFETriangleTerms>& terms, const std::vector<double>& dots,
+                          const std::vector<double>& diagonalShift, double epsilon, const MFE::Vector<double>& x, MFE::Vector<double>& y)
+  : m_Offsets(offsets)
+  , m_Incidence(incidence)
+  , m_Terms(terms)
+  , m_Dots(dots)
+  , m_DiagonalShift(diagonalShift)
+  , m_Epsilon(epsilon)
+  , m_X(x)
+  , m_Y(y)
+  {
+  }
+  virtual ~MFEStiffnessProductImpl() = default;
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-template <typename Node, typename T> double AngleLineCurvature(Node& n0, Node& n1, Node& n2)
-//  returns angle approx. to curvature at node n1
+  void convert(size_t start, size_t end) const
+  {
+    const double one12th = 1.0 / 12.0;
+    for(size_t h = start; h < end; h++)
+    {
+      int row = static_cast<int>(3 * h);
+      double xh[3] = {m_X[row], m_X[row + 1], m_X[row + 2]};
+      double y[3] = {m_Epsilon * xh[0], m_Epsilon * xh[1], m_Epsilon * xh[2]};
+      for(int64_t e = m_Offsets[h]; e < m_Offsets[h + 1]; e++)
+      {
+        int64_t t = m_Incidence[e] / 3;
+        const MFETriangleTerms& terms = m_Terms[t];
+        double s = one12th * terms.area * (m_Dots[t] + terms.normal[0] * xh[0] + terms.normal[1] * xh[1] + terms.normal[2] * xh[2]);
+        y[0] += s * terms.normal[0];
+        y[1] += s * terms.normal[1];
+        y[2] += s * terms.normal[2];
+      }
+      for(int k = 0; k < 3; k++)
+      {
+        m_Y[row + k] = y[k] + m_DiagonalShift[row + k] * xh[k];
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const std::vector<int64_t>& m_Offsets;
+  const std::vector<int64_t>& m_Incidence;
+  const std::vector<MFETriangleTerms>& m_Terms;
+  const std::vector<double>& m_Dots;
+  const std::vector<double>& m_DiagonalShift;
+  double m_Epsilon;
+  const MFE::Vector<double>& m_X;
+  MFE::Vector<double>& m_Y;
+};
+
+/**
+ * @brief The MFEStiffnessOperator class applies the stiffness matrix of the current update step
+ * without assembling it. For a node h the matrix assembled by the triangles t around it is
+ * sum_t (A_t / 12) n_t n_t^T (x_a + x_b + x_c + x_h), plus epsilon on the diagonal; constrained
+ * coordinates have their diagonal replaced by a large value through diagonalShift.
+ */
+class MFEStiffnessOperator
 {
-  T v1[3], v2[3];
-  v1[0] = n0.pos[0] - n1.pos[0];
-  v1[1] = n0.pos[1] - n1.pos[1];
-  v1[2] = n0.pos[2] - n1.pos[2];
-  v2[0] = n1.pos[0] - n2.pos[0];
-  v2[1] = n1.pos[1] - n2.pos[1];
-  v2[2] = n1.pos[2] - n2.pos[2];
-  T d1 = NodeFunctions<Node, T>::Distance(n0, n1);
-  T d2 = NodeFunctions<Node, T>::Distance(n1, n2);
-  T product = sqrt((v1[0] * v2[0] + v1[1] * v2[1] + v1[2] * v2[2]) / d1 / d2);
-  if(product > 1.)
+public:
+  MFEStiffnessOperator(const int64_t* triangles, size_t numberNodes, const std::vector<int64_t>& offsets, const std::vector<int64_t>& incidence, const std::vector<MFETriangleTerms>& terms,
+                       const std::vector<double>& diagonalShift, double epsilon)
+  : m_Triangles(triangles)
+  , m_NumberNodes(numberNodes)
+  , m_Offsets(offsets)
+  , m_Incidence(incidence)
+  , m_Terms(terms)
+  , m_DiagonalShift(diagonalShift)
+  , m_Epsilon(epsilon)
+  , m_Dots(terms.size(), 0.0)
   {
-    product = 1.;
   }
-  if(product < -1.)
+  virtual ~MFEStiffnessOperator() = default;
+
+  MFE::Vector<double> operator*(const MFE::Vector<double>& x) const
   {
-    product = -1.;
+    MFE::Vector<double> y(x.dimension());
+    MFETriangleDotsImpl dots(m_Triangles, m_Terms, x, m_Dots);
+    MFEStiffnessProductImpl product(m_Offsets, m_Incidence, m_Terms, m_Dots, m_DiagonalShift, m_Epsilon, x, y);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, m_Terms.size()), dots, tbb::auto_partitioner());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, m_NumberNodes), product, tbb::auto_partitioner());
+#else
+    dots.convert(0, m_Terms.size());
+    product.convert(0, m_NumberNodes);
+#endif
+    return y;
   }
-  T angle = acos(product);
-  return 2. * angle / (d1 + d2);
-}
+
+private:
+  const int64_t* m_Triangles;
+  size_t m_NumberNodes;
+  const std::vector<int64_t>& m_Offsets;
+  const std::vector<int64_t>& m_Incidence;
+  const std::vector<MFETriangleTerms>& m_Terms;
+  const std::vector<double>& m_DiagonalShift;
+  double m_Epsilon;
+  mutable std::vector<double> m_Dots;
+};
+} // namespace
 
 // -----------------------------------------------------------------------------
 //
@@ -136,9 +420,8 @@ MovingFiniteElementSmoothing::MovingFiniteElementSmoothing()
 , m_ConstrainSurfaceNodes(true)
 , m_ConstrainQuadPoints(true)
 , m_SmoothTripleLines(true)
-, m_SurfaceMeshNodeTypeArrayPath(SIMPL::Defaults::DataContainerName, SIMPL::Defaults::VertexAttributeMatrixName, SIMPL::VertexData::SurfaceMeshNodeType)
-, m_SurfaceMeshNodeTypeArrayName(SIMPL::VertexData::SurfaceMeshNodeType)
-, m_SurfaceMeshNodeType(nullptr)
+, m_ConvergenceTolerance(0.0)
+, m_SurfaceMeshNodeTypeArrayPath(SIMPL::Defaults::TriangleDataContainerName, SIMPL::Defaults::VertexAttributeMatrixName, SIMPL::VertexData::SurfaceMeshNodeType)
 {
 }
 
@@ -154,15 +437,18 @@ void MovingFiniteElementSmoothing::setupFilterParameters()
 {
   SurfaceMeshFilter::setupFilterParameters();
   FilterParameterVectorType parameters;
-  parameters.push_back(SIMPL_NEW_INTEGER_FP("Iteration Steps", IterationSteps, FilterParameter::Uncategorized, MovingFiniteElementSmoothing));
-  parameters.push_back(SIMPL_NEW_BOOL_FP("Apply Node Contraints", NodeConstraints, FilterParameter::Uncategorized, MovingFiniteElementSmoothing));
-  parameters.push_back(SIMPL_NEW_BOOL_FP("Constrain Surface Nodes", ConstrainSurfaceNodes, FilterParameter::Uncategorized, MovingFiniteElementSmoothing));
-  parameters.push_back(SIMPL_NEW_BOOL_FP("Constrain Quad Points", ConstrainQuadPoints, FilterParameter::Uncategorized, MovingFiniteElementSmoothing));
-  parameters.push_back(SIMPL_NEW_BOOL_FP("Smooth Triple Lines", SmoothTripleLines, FilterParameter::Uncategorized, MovingFiniteElementSmoothing));
-  parameters.push_back(SeparatorFilterParameter::New("Required Information", FilterParameter::Uncategorized));
-  parameters.push_back(DataArraySelectionFilterParameter::New("SurfaceMeshNodeType", "SurfaceMeshNodeTypeArrayPath", getSurfaceMeshNodeTypeArrayPath(), FilterParameter::Uncategorized,
-                                                              SIMPL_BIND_SETTER(MovingFiniteElementSmoothing, this, SurfaceMeshNodeTypeArrayPath),
-                                                              SIMPL_BIND_GETTER(MovingFiniteElementSmoothing, this, SurfaceMeshNodeTypeArrayPath)));
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Iteration Steps", IterationSteps, FilterParameter::Parameter, MovingFiniteElementSmoothing));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Apply Node Contraints", NodeConstraints, FilterParameter::Parameter, MovingFiniteElementSmoothing));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Constrain Surface Nodes", ConstrainSurfaceNodes, FilterParameter::Parameter, MovingFiniteElementSmoothing));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Constrain Quad Points", ConstrainQuadPoints, FilterParameter::Parameter, MovingFiniteElementSmoothing));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Smooth Triple Lines", SmoothTripleLines, FilterParameter::Parameter, MovingFiniteElementSmoothing));
+  parameters.push_back(SIMPL_NEW_DOUBLE_FP("Convergence Tolerance", ConvergenceTolerance, FilterParameter::Parameter, MovingFiniteElementSmoothing));
+  parameters.push_back(SeparatorFilterParameter::New("Vertex Data", FilterParameter::RequiredArray));
+  {
+    DataArraySelectionFilterParameter::RequirementType req =
+        DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Int8, 1, AttributeMatrix::Type::Vertex, IGeometry::Type::Triangle);
+    parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Node Type", SurfaceMeshNodeTypeArrayPath, FilterParameter::RequiredArray, MovingFiniteElementSmoothing, req));
+  }
   setFilterParameters(parameters);
 }
 
@@ -174,10 +460,11 @@ void MovingFiniteElementSmoothing::readFilterParameters(AbstractFilterParameters
   reader->openFilterGroup(this, index);
   setSurfaceMeshNodeTypeArrayPath(reader->readDataArrayPath("SurfaceMeshNodeTypeArrayPath", getSurfaceMeshNodeTypeArrayPath()));
   setIterationSteps(reader->readValue("IterationSteps", getIterationSteps()));
-  setNodeConstraints(reader->readValue("NodeConstraints", false));
-  setConstrainSurfaceNodes(reader->readValue("ConstrainSurfaceNodes", false));
-  setConstrainQuadPoints(reader->readValue("ConstrainQuadPoints", false));
-  setSmoothTripleLines(reader->readValue("SmoothTripleLines", false));
+  setNodeConstraints(reader->readValue("NodeConstraints", getNodeConstraints()));
+  setConstrainSurfaceNodes(reader->readValue("ConstrainSurfaceNodes", getConstrainSurfaceNodes()));
+  setConstrainQuadPoints(reader->readValue("ConstrainQuadPoints", getConstrainQuadPoints()));
+  setSmoothTripleLines(reader->readValue("SmoothTripleLines", getSmoothTripleLines()));
+  setConvergenceTolerance(reader->readValue("ConvergenceTolerance", getConvergenceTolerance()));
   reader->closeFilterGroup();
 }
 
@@ -196,44 +483,37 @@ void MovingFiniteElementSmoothing::dataCheck()
   clearErrorCode();
   clearWarningCode();
 
-  DataContainer::Pointer sm = getDataContainerArray()->getPrereqDataContainer(this, getSurfaceMeshNodeTypeArrayPath().getDataContainerName(), false);
-  if(getErrorCondition() < 0)
+  if(getIterationSteps() < 1)
   {
-    return;
+    setErrorCondition(-384, "The number of iteration steps must be at least 1");
   }
-
-  // We MUST have Nodes
-  if(sm->getVertices().get() == nullptr)
+  if(getConvergenceTolerance() < 0.0)
   {
-    setErrorCondition(-384, "SurfaceMesh DataContainer missing Nodes");
+    setErrorCondition(-385, "The convergence tolerance must not be negative");
   }
 
-  // We MUST have Triangles defined also.
-  if(sm->getFaces().get() == nullptr)
-  {
-    setErrorCondition(-385, "SurfaceMesh DataContainer missing Triangles");
-  }
+  TriangleGeom::Pointer triangles = getDataContainerArray()->getPrereqGeometryFromDataContainer<TriangleGeom, AbstractFilter>(this, getSurfaceMeshNodeTypeArrayPath().getDataContainerName());
+
+  QVector<IDataArray::Pointer> nodeDataArrays;
 
-  if(getErrorCondition() >= 0)
+  if(getErrorCode() >= 0)
   {
-    // Check for Node Type Array
-    // int size = sm->getVertices()->getNumberOfTuples();
-    QVector<size_t> dims(1, 1);
-    m_SurfaceMeshNodeTypePtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<int8_t>, AbstractFilter>(this, getSurfaceMeshNodeTypeArrayPath(),
-                                                                                                                  dims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
-    if(nullptr != m_SurfaceMeshNodeTypePtr.lock()) /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
-    {
-      m_SurfaceMeshNodeType = m_SurfaceMeshNodeTypePtr.lock()->getPointer(0);
-    } /* Now assign the raw pointer to data from the DataArray<T> object */
+    nodeDataArrays.push_back(triangles->getVertices());
   }
 
-  if(getConstrainQuadPoints() == true || getSmoothTripleLines() == true)
+  QVector<size_t> cDims(1, 1);
+  m_SurfaceMeshNodeTypePtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<int8_t>, AbstractFilter>(this, getSurfaceMeshNodeTypeArrayPath(),
+                                                                                                                cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+  if(nullptr != m_SurfaceMeshNodeTypePtr.lock()) /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
   {
-    if(sm->getEdges().get() == nullptr)
-    {
-      setErrorCondition(-385, "Constraining Quad Points or Triples lines requires Edges array");
-    }
+    m_SurfaceMeshNodeType = m_SurfaceMeshNodeTypePtr.lock()->getPointer(0);
+  } /* Now assign the raw pointer to data from the DataArray<T> object */
+  if(getErrorCode() >= 0)
+  {
+    nodeDataArrays.push_back(m_SurfaceMeshNodeTypePtr.lock());
   }
+
+  getDataContainerArray()->validateNumberOfTuples<AbstractFilter>(this, nodeDataArrays);
 }
 
 // -----------------------------------------------------------------------------
@@ -247,11 +527,6 @@ void MovingFiniteElementSmoothing::preflight()
   dataCheck();
   emit preflightExecuted();
   setInPreflight(false);
-
-  /* *** THIS FILTER NEEDS TO BE CHECKED *** */
-  QString ss = QObject::tr("Filter is NOT updated for IGeometry Redesign. A Programmer needs to check this filter. Please report this to the DREAM3D developers.");
-  setErrorCondition(0xABABABAB, ss);
-  /* *** THIS FILTER NEEDS TO BE CHECKED *** */
 }
 
 // -----------------------------------------------------------------------------
@@ -262,404 +537,165 @@ void MovingFiniteElementSmoothing::execute()
   clearErrorCode();
   clearWarningCode();
   dataCheck();
-  if(getErrorCondition() < 0)
+  if(getErrorCode() < 0)
   {
     return;
   }
 
-  DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(getSurfaceMeshNodeTypeArrayPath().getDataContainerName());
-
-  VertexArray::Pointer floatNodesPtr = sm->getVertices();
-  FaceArray::Pointer trianglesPtr = sm->getFaces();
-
-  clearErrorCode();
-  clearWarningCode();
-  /* Place all your code to execute your filter here. */
-  VertexArray::Vert_t* nodesF = floatNodesPtr->getPointer(0); // Get the pointer to the from of the array so we can use [] notation
-  FaceArray::Face_t* triangles = trianglesPtr->getPointer(0); // Get the pointer to the from of the array so we can use [] notation
-
-  // Data variables
-  int numberNodes = floatNodesPtr->getNumberOfTuples();
-  int ntri = trianglesPtr->getNumberOfTuples();
+  TriangleGeom::Pointer triangleGeom = getDataContainerArray()->getDataContainer(getSurfaceMeshNodeTypeArrayPath().getDataContainerName())->getGeometryAs<TriangleGeom>();
+  float* nodesF = triangleGeom->getVertexPointer(0);
+  const int64_t* triangles = triangleGeom->getTriPointer(0);
 
-  StructArray<VertexArray::VertD_t>::Pointer nodesDPtr = StructArray<VertexArray::VertD_t>::CreateArray(numberNodes, "MFE_Double_Nodes");
-  nodesDPtr->initializeWithZeros();
-  VertexArray::VertD_t* nodes = nodesDPtr->getPointer(0);
+  int numberNodes = static_cast<int>(triangleGeom->getNumberOfVertices());
+  int ntri = static_cast<int>(triangleGeom->getNumberOfTris());
 
-  // Copy the nodes from the 32 bit floating point to the 64 bit floating point
+  // Work on a 64 bit copy of the 32 bit vertex positions
+  std::vector<MFENode> nodes(numberNodes);
   for(int n = 0; n < numberNodes; ++n)
   {
-    nodes[n].pos[0] = nodesF[n].pos[0];
-    nodes[n].pos[1] = nodesF[n].pos[1];
-    nodes[n].pos[2] = nodesF[n].pos[2];
-  }
-
-  bool isVerbose = true;
-
-  // We need a few more arrays to support the code from CMU:
-  StructArray<TripleNN>::Pointer triplennPtr = StructArray<TripleNN>::CreateArray(numberNodes, "TripleLine_Neighbors_Or_IDS");
-  triplennPtr->initializeWithZeros();
-  TripleNN* triplenn = triplennPtr->getPointer(0);
-
-//  QVector<QString> data;
-#if 0
-  // read in nodes/triangles
-  std::ifstream input1(nodesFile.toLatin1().data());
-  std::ifstream input2(triangleFile.toLatin1().data());
-  std::ofstream velocities;
-#endif
-  QString outputNodesFile("/tmp/outputNodesFile.txt");
-
-  if(isVerbose)
-  {
-    qDebug() << "Number of nodes: " << numberNodes << "\n";
-    qDebug() << "Number of triangles: " << ntri << "\n";
-    qDebug() << "\n";
+    nodes[n].pos[0] = nodesF[3 * n + 0];
+    nodes[n].pos[1] = nodesF[3 * n + 1];
+    nodes[n].pos[2] = nodesF[3 * n + 2];
   }
 
-  QVector<int> tid(ntri);
-  QVector<int> nodeConstraint(numberNodes); //  0=unconstrained, 1=constrained in X, 2= in Y, 4= in Z
-
-// Read the nodes
-#if 0
-  int nodeType;
-  if (isVerbose) { qDebug() << "reading nodes " << "\n"; }
-  for (int i = 0; i < nnod; i++)
+  // Entry e of the incidence holds 3 * triangle + corner for the triangles around a node
+  std::vector<int64_t> incidenceOffsets(numberNodes + 1, 0);
+  std::vector<int64_t> incidence(3 * static_cast<size_t>(ntri), 0);
+  for(int t = 0; t < ntri; t++)
   {
-    input1 >> id(nodes[i]) >> nodeType >> nodes[i][0] >> nodes[i][1] >> nodes[i][2];
-    //  added a junk entry, 25 vi 09; changed to keep node type, 30 xii 09
-    triplenn1(nodes[i]) = 0;
-    triplenn2(nodes[i]) = 0;
-    type(nodes[i]) = nodeType;// duplicating info for now
-  }
-  if (isVerbose) { qDebug() << "end reading nodes" << "\n"; }
-  input1.close();
-#endif
-
-  if(getCancel())
-  {
-    return;
+    for(int c = 0; c < 3; c++)
+    {
+      incidenceOffsets[triangles[3 * t + c] + 1]++;
+    }
   }
-
-#if 1
-#if __APPLE__
-#warning Smoothing Triple Lines are NOT working because the code needs updated.
-#endif
-  if(m_SmoothTripleLines == true)
+  for(int r = 0; r < numberNodes; r++)
   {
-    m_SmoothTripleLines = false;
+    incidenceOffsets[r + 1] += incidenceOffsets[r];
   }
-#else
-
-  if(m_SmoothTripleLines == true)
   {
-    IDataArray::Pointer edgesDataArray = m->getPointData(SIMPL::CellData::SurfaceMeshEdges);
-    IDataArray::Pointer iEdgesDataArray = m->getPointData(SIMPL::CellData::SurfaceMeshInternalEdges);
-    if((edgesDataArray.get() == nullptr || iEdgesDataArray.get() == nullptr) && m_SmoothTripleLines == true)
-    {
-      setErrorCondition(-596, "Either the Edges or Internal Edges array was nullptr which means those arrays have not been created and you have selected to smooth triple lines. Disable the smoothing of triple lines.");
-      return;
-    }
-
-    StructArray<EdgeArray::Edge_t>* edgesStructArray = StructArray<EdgeArray::Edge_t>::SafePointerDownCast(edgesDataArray.get());
-    EdgeArray::Edge_t* edges = edgesStructArray->getPointer(0);
-
-    StructArray<EdgeArray::Edge_t>* internalEdgesStructArray = StructArray<EdgeArray::Edge_t>::SafePointerDownCast(iEdgesDataArray.get());
-    EdgeArray::Edge_t* iEdges = internalEdgesStructArray->getPointer(0);
-
-//  Read the edges, if we are going to smooth them explicitly
-#if 0
-    if (isVerbose) { qDebug() << "reading edges " << "\n"; }
-    std::ifstream input3(edgesFile.toLatin1().data());
-    if (input3.is_open() == false)
+    std::vector<int64_t> cursor(incidenceOffsets.begin(), incidenceOffsets.end() - 1);
+    for(int t = 0; t < ntri; t++)
     {
-      if (isVerbose)
+      for(int c = 0; c < 3; c++)
       {
-        qDebug() << "You have asked to Smooth Triple Lines but have not provided an Edges file." << "\n";
+        incidence[cursor[triangles[3 * t + c]]++] = 3 * static_cast<int64_t>(t) + c;
       }
-      return -1;
-    }
-#endif
-    int edgeCount = edgesStructArray->getNumberOfTuples();
-    int iEdgeCount = internalEdgesStructArray->getNumberOfTuples();
-    int nedges = edgeCount + iEdgeCount;
-    //  input3 >> nedges;
-    //  don't actually need the structure. just the information
-    if(isVerbose)
-    {
-      qDebug() << "Number of edges = " << nedges << "\n";
     }
+  }
 
-    int tedges = 0; // triple line edge count
-
-    for(int i = 0; i < nedges; i++)
+  // A triple line edge is shared by three or more triangles. Triple line nodes that have exactly
+  // two such edges get the two nodes at their other ends as line neighbors; every other node keeps -1.
+  std::vector<int64_t> tripleNeighbors(2 * static_cast<size_t>(numberNodes), -1);
+  if(m_SmoothTripleLines)
+  {
+    std::vector<int64_t> neighbors;
+    for(int i = 0; i < numberNodes; i++)
     {
-      int nid[2] = {-1, -1}, ekind = -1;
-      if(i < edgeCount) // Grab from the 'Segment' array
+      if(m_SurfaceMeshNodeType[i] != SIMPL::SurfaceMesh::NodeType::TriplePoint && m_SurfaceMeshNodeType[i] != SIMPL::SurfaceMesh::NodeType::SurfaceTriplePoint)
       {
-        ekind = edges[i].edgeKind;
-        nid[0] = edges[i].verts[0];
-        nid[1] = edges[i].verts[1];
+        continue;
       }
-      else // Grab from the 'ISegment' Array
-      {
-        ekind = iEdges[i - edgeCount].edgeKind;
-        nid[0] = edges[i - edgeCount].verts[0];
-        nid[1] = edges[i - edgeCount].verts[1];
-      }
-
-      // input3 >> junk >> nid[0] >> nid[1] >> ekind >> spin1 >> spin2 >> spin3 >> spin4;
-      if(ekind == 3)
+      neighbors.clear();
+      for(int64_t e = incidenceOffsets[i]; e < incidenceOffsets[i + 1]; e++)
       {
-        // qDebug() << "\n" << "edge#  ID1  ID2  " << i << " " << nid[0] << " " << nid[1] << "\n" ;
-        tedges++;
-        //  now to assign NN nodes at any node on a TJ, but not quads
-        if(m_SurfaceMeshNodeType[nid[0]] == 3 || m_SurfaceMeshNodeType[nid[0]] == 13)
+        const int64_t* verts = triangles + 3 * (incidence[e] / 3);
+        for(int c = 0; c < 3; c++)
         {
-          if(triplenn[nid[0]].triplenn1 == 0)
+          if(verts[c] != i)
           {
-            triplenn[nid[0]].triplenn1 = nid[1];
-          }
-          else
-          {
-            if(triplenn[nid[1]].triplenn2 != 0)
-            {
-              if(isVerbose)
-              {
-                qDebug() << "triplenn[nid[1]].triplenn2 != 0 was TRUE. This is bad"
-                         << "\n";
-                setErrorCondition(-666, "triplenn[nid[1]].triplenn2 != 0 was TRUE. This is bad");
-              }
-              return;
-            }
-            else
-            {
-              triplenn[nid[0]].triplenn2 = nid[1];
-            }
+            neighbors.push_back(verts[c]);
           }
         }
-        //      if ( nodes[nid[0]] == 0 ) ;
-        if(m_SurfaceMeshNodeType[nid[1]] == 3 || m_SurfaceMeshNodeType[nid[1]] == 13)
+      }
+      std::sort(neighbors.begin(), neighbors.end());
+      int64_t lineNeighbors[2] = {-1, -1};
+      int numLineNeighbors = 0;
+      for(size_t first = 0; first < neighbors.size();)
+      {
+        size_t last = first;
+        while(last < neighbors.size() && neighbors[last] == neighbors[first])
         {
-          if(triplenn[nid[1]].triplenn1 == 0)
-          {
-            triplenn[nid[1]].triplenn1 = nid[0];
-          }
-          else
+          last++;
+        }
+        if(last - first >= 3)
+        {
+          if(numLineNeighbors < 2)
           {
-            if(triplenn[nid[1]].triplenn2 != 0)
-            {
-              if(isVerbose)
-              {
-                qDebug() << "triplenn[nid[1]].triplenn2 != 0 was TRUE. This is bad"
-                         << "\n";
-                setErrorCondition(-666, "triplenn[nid[1]].triplenn2 != 0 was TRUE. This is bad");
-              }
-              return;
-            }
-            else
-            {
-              triplenn[nid[1]].triplenn2 = nid[0];
-            }
+            lineNeighbors[numLineNeighbors] = neighbors[first];
           }
+          numLineNeighbors++;
         }
+        first = last;
       }
-    }
-    if(isVerbose)
-    {
-      qDebug() << "... completed 1st reading edges"
-               << "\n";
-    }
-    //  destroy(edges) ;
-    // input3.close();
-    //  now let's check the entries
-    /*
-     for ( int i = 0 ; i < nnod ; i++ ) {
-     if ( type(nodes[i]) == 3 ||  type(nodes[i]) == 13 ) {
-     qDebug() << "node ID, NN1, NN2: " << id(nodes[i]) << " " << triplenn1(nodes[i])
-     << " " << triplenn2(nodes[i]) << "\n" ;
-     }
-     }  */
-  }
-#endif
-
-  if(getCancel())
-  {
-    return;
-  }
-
-  int final = m_IterationSteps;
-  int begin = 1;
-//  for time stepping
-
-#if ENABLE_MFE_SMOOTHING_RESTART_FILE
-  int nnodRe, nnTriRe, stepsRe;
-  if(restartFile.isEmpty() == false)
-  {
-    //  we have a requested re-start - node positions will be read from the INP file
-    std::ifstream restartInput(restartFile.toLatin1().data());
-
-    restartInput >> nnodRe >> nnTriRe;
-    if(isVerbose)
-    {
-      qDebug() << "Check number of nodes, triangles in .inp: " << nnodRe << ", " << nnTriRe << "\n";
-    }
-    if(nnodRe != nnod)
-    {
-      if(isVerbose)
+      if(numLineNeighbors == 2)
       {
-        qDebug() << "Discrepancy in the number of nodes, must stop! "
-                 << "\n";
+        tripleNeighbors[2 * i] = lineNeighbors[0];
+        tripleNeighbors[2 * i + 1] = lineNeighbors[1];
       }
-      return -1;
-    }
-    else
-    {
-      // we are OK to read in
-      if(isVerbose)
-      {
-        qDebug() << "reading nodes from restart INP "
-                 << "\n";
-      }
-      for(int i = 0; i < nnod; i++)
-      {
-        input1 >> id(nodes[i]) >> nodes[i][0] >> nodes[i][1] >> nodes[i][2];
-      }
-      if(isVerbose)
-      {
-        qDebug() << "end reading nodes from restart INP "
-                 << "\n";
-      }
-    }
-    restartInput.close();
-    if(isVerbose)
-    {
-      qDebug() << "What step are we re-starting at? "
-               << "\n";
-    }
-    std::cin >> stepsRe;
-    if(stepsRe >= final)
-    {
-      if(isVerbose)
-      {
-        qDebug() << "Final time less than re-start time, must stop! "
-                 << "\n";
-      }
-      return -1;
-    }
-    else
-    {
-      begin = stepsRe;
     }
   }
-#endif
 
   if(getCancel())
   {
     return;
   }
 
-#if 0
-  //Read the triangles
-  if (isVerbose) { qDebug() << "reading triangles: " << "\n"; }
-  for (int i = 0; i < ntri; i++)
-  {
-    //  char type[3];
-    int nid[3];
-    //  int reg1, reg2;
-    input2 >> tid[i] >> nid[0] >> nid[1] >> nid[2] >> junk >> junk >> junk >> triangles[i].region1 >> triangles[i].region2;
-
-    triangles[i](0) = &nodes[nid[0]];
-    triangles[i](1) = &nodes[nid[1]];
-    triangles[i](2) = &nodes[nid[2]];
-    //  bool ok[3] = {false,false,false};
-    //  for (int j=0; j<nnod; j++) {
-    // //     if (id[j]==nid[0]) {triangles[i](0) = &nodes[j]; triangles[i].nids[0]= nid[0]; ok[0] = true;}
-    // //     else if (id[j]==nid[1]) {triangles[i](1) = &nodes[j]; triangles[i].nids[1]= nid[1];ok[1] = true;}
-    // //     else if (id[j]==nid[2]) {triangles[i](2) = &nodes[j]; triangles[i].nids[2]= nid[2];ok[2] = true;}
-    //    if (id(nodes[j])==nid[0]) {triangles[i](0) = &nodes[j];  ok[0] = true;}
-    //    else if (id(nodes[j])==nid[1]) {triangles[i](1) = &nodes[j]; ok[1] = true;}
-    //    else if (id(nodes[j])==nid[2]) {triangles[i](2) = &nodes[j]; ok[2] = true;}
-    //    if (ok[0] && ok[1] && ok[2]) break;
-    //  }
-  }
-  if (isVerbose) { qDebug() << "end reading triangles" << "\n"; }
-  input2.close();
-
-  if (getCancel() == true)
-  {
-    return;
-  }
-#endif
-
   // Find the minimum and maximum dimension of the data
   double min[3] = {std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<double>::max()};
-  double max[3] = {std::numeric_limits<double>::min(), std::numeric_limits<double>::min(), std::numeric_limits<double>::min()};
-
+  double max[3] = {std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest()};
   for(int i = 0; i < numberNodes; i++)
   {
     for(int j = 0; j < 3; j++)
     {
-      if(nodes[i].pos[j] < min[j])
-      {
-        min[j] = nodes[i].pos[j];
-      }
-      if(nodes[i].pos[j] > max[j])
-      {
-        max[j] = nodes[i].pos[j];
-      }
+      min[j] = std::min(min[j], nodes[i].pos[j]);
+      max[j] = std::max(max[j], nodes[i].pos[j]);
     }
   }
-  if(isVerbose)
-  {
-    qDebug() << "Model Dimensions as Min, Max: "
-             << "\n";
 
-    //  for(int i=0; i<3; i++)
-    qDebug() << "X (0): " << min[0] << " " << max[0] << "\n";
-    qDebug() << "Y (1): " << min[1] << " " << max[1] << "\n";
-    qDebug() << "Z (2): " << min[2] << " " << max[2] << "\n";
-  }
-  // Allocate vectors and matricies
+  // Allocate vectors. The stiffness matrix is never assembled; it is applied through the
+  // triangle terms of the current update step, gathered per node through the node to
+  // triangle incidence so no two threads ever write the same entry.
   int n_size = 3 * numberNodes;
   MFE::Vector<double> x(n_size), F(n_size);
-  MFE::SMatrix<double> K(n_size, n_size);
+  std::vector<double> diagonal(n_size, 0.0);
+  std::vector<double> diagonalShift(n_size, 0.0);
+  std::vector<MFETriangleTerms> triangleTerms(ntri);
+  std::vector<double> qualities(ntri, 0.0);
+  std::vector<double> dihedrals(ntri, 0.0);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  // The model extent normalizes the displacement residual used for the convergence test
+  double extent = std::max(max[0] - min[0], std::max(max[1] - min[1], max[2] - min[2]));
+  if(extent <= 0.0)
+  {
+    extent = 1.0;
+  }
 
   // Allocate constants for solving linear equations
   const double epsilon = 1.0; // change this if quality force too
   // high, low
   const double dt = (40.0e-6) * (10 / max[1]);
   // time step, change if mesh moves too much, little
-  const double small = 1.0e-12;
   const double large = 1.0e+50;
-  const double one12th = 1.0 / 12.0;
   const double tolerance = 1.0e-5;
   // Tolerance for nodes that are
   // near the RVE boundary
 
-  double A_scale, Q_scale, TJ_scale;
   // Prefactors for quality, curvature and triple line forces
   //   don't make these two values too far different
   //  larger values should increase velocities
+  const double TJ_scale = 19000.0; //  arbitrary choice for triple line smoothing !
+  const double A_scale = 4000.0;
 
-  // Variables for logging of quality progress
-  double Q_max, Q_sum, Q_ave, Q_max_ave;
-  double A, Q;
-  int hist_count = 10;
-
-  QVector<double> Q_max_hist(hist_count);
-
-  Q_ave = 2.9;
-  Q_max_ave = 10;
-
-  double Dihedral, Dihedral_min, Dihedral_max, Dihedral_sum, Dihedral_ave;
-  //  for measuring dihedral angles, Mar 2010
-
-  //  now we determine constraints
+  //  now we determine constraints: 0=unconstrained, 1=constrained in X, 2= in Y, 4= in Z
+  std::vector<int32_t> nodeConstraint(numberNodes, 0);
   for(int r = 0; r < numberNodes; r++)
   {
-    nodeConstraint[r] = 0;
-    if(m_NodeConstraints == true)
+    if(m_NodeConstraints)
     {
       // only do this if we want the constraint on surfaces
       if(fabs(nodes[r].pos[0] - max[0]) < tolerance || fabs(nodes[r].pos[0] - min[0]) < tolerance)
@@ -674,285 +710,91 @@ void MovingFiniteElementSmoothing::execute()
       {
         nodeConstraint[r] += 4;
       }
-      // debug
-      if(m_SurfaceMeshNodeType[r] > 10 && nodeConstraint[r] == 0)
-      {
-        if(isVerbose)
-        {
-          qDebug() << "ID " << r << " Coords: " << nodes[r].pos[0] << " " << nodes[r].pos[1] << " " << nodes[r].pos[2] << "\n";
-          qDebug() << " Coord. Diffs. for X: " << fabs(nodes[r].pos[0] - max[0]) << " " << fabs(nodes[r].pos[0] - min[0]) << "\n";
-          qDebug() << " Coord. Diffs. for Y: " << fabs(nodes[r].pos[1] - max[1]) << " " << fabs(nodes[r].pos[1] - min[1]) << "\n";
-          qDebug() << " Coord. Diffs. for Z: " << fabs(nodes[r].pos[2] - max[2]) << " " << fabs(nodes[r].pos[2] - min[2]) << "\n";
-          qDebug() << "Type, Constraint: " << m_SurfaceMeshNodeType[r] << " " << nodeConstraint[r] << "\n";
-          qDebug() << "Check whether there is a problem with applying constraints ... "
-                   << "\n";
-        }
-      }
-      //  constraint for surface nodes
-      if(m_ConstrainSurfaceNodes == true && nodeConstraint[r] != 0)
+      //  totally constrain a surface node (temporary fix for connectivity issues in bounded box meshes)
+      if(m_ConstrainSurfaceNodes && nodeConstraint[r] != 0)
       {
         nodeConstraint[r] = 7;
       }
-      //  totally constrain a surface node (temporary fix for connectivity issues in bounded box meshes)
     }
-    if(m_SurfaceMeshNodeType[r] == SIMPL::SurfaceMesh::NodeType::QuadPoint && m_ConstrainQuadPoints == true)
+    //  constraint for quad point nodes is in all 3 coords.
+    if(m_SurfaceMeshNodeType[r] == SIMPL::SurfaceMesh::NodeType::QuadPoint && m_ConstrainQuadPoints)
     {
       nodeConstraint[r] = 7;
     }
-    //  constraint for quad point nodes is in all 3 coords.
   }
 
   // update loop
-  for(size_t updates = begin; updates <= static_cast<size_t>(final); ++updates)
+  for(int updates = 1; updates <= m_IterationSteps; ++updates)
   {
     if(getCancel())
     {
       return;
     }
 
-    // changed arg index
-    if(isVerbose)
-    {
-      qDebug() << "Update loop: " << updates << "\n";
-    }
-    QString ss = QObject::tr("Iteration: %1").arg(updates);
-    notifyStatusMessage(ss);
-
-    Dihedral_min = 180.;
-    Dihedral_max = 0.;
-    Dihedral_ave = 0.;
-
-    TJ_scale = 19000.0; //  arbitrary choice for triple line smoothing !
-    A_scale = 4000.0;
     //  designed to ramp up the weight attached to the Quality forces
-    Q_scale = 500.0 + 50.0 * (double)updates / (double)final;
-    //    WAS:  Q_scale = 1000;
     //  14 may 10: discovered that ramping up the quality forces so high
     //    leads to UNsmoothing of the mesh!
+    double Q_scale = 500.0 + 50.0 * static_cast<double>(updates) / static_cast<double>(m_IterationSteps);
 
-    // compute triangle contributions to K and F
-    ntri = trianglesPtr->getNumberOfTuples();
-    Q_max = 0.;
-    Q_sum = 0.;
-    Dihedral_sum = 0.;
-    Dihedral_min = 180.;
-    Dihedral_max = -1.; //  added may 10, ADR
-    double LDistance, deltaLDistance;
-
-    typedef NodeFunctions<VertexArray::VertD_t, double> NodeFunctionsType;
-    typedef TriangleFunctions<VertexArray::VertD_t, double> TriangleFunctionsType;
-    // Loop through each of the triangles
-    for(int t = 0; t < ntri; t++)
+    // compute the triangle terms, then gather them per node into F and the stiffness diagonal
+    MFETriangleTermsImpl termsImpl(nodes.data(), triangles, tripleNeighbors.data(), A_scale, Q_scale, TJ_scale, triangleTerms, qualities, dihedrals);
+    MFENodeForcesImpl forcesImpl(incidenceOffsets, incidence, triangleTerms, epsilon, F, diagonal);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel)
     {
-      FaceArray::Face_t& rtri = triangles[t];
-      MFE::Vector<double> n(3);
-      n = TriangleFunctionsType::normal(nodes[rtri.verts[0]], nodes[rtri.verts[1]], nodes[rtri.verts[2]]);
-      A = TriangleFunctionsType::area(nodes[rtri.verts[0]], nodes[rtri.verts[1]], nodes[rtri.verts[2]]);           //  current Area
-      Q = TriangleFunctionsType::circularity(nodes[rtri.verts[0]], nodes[rtri.verts[1]], nodes[rtri.verts[2]], A); //  current quality
-      if(Q > 100.)
-      {
-        if(isVerbose)
-        {
-          qDebug() << "Warning, tri no. " << t << " has Q= " << Q << "\n";
-        }
-      }
-      Q_sum += Q;
-      if(Q > Q_max)
-      {
-        Q_max = Q;
-      }
-
-      Dihedral = TriangleFunctionsType::MinDihedral(nodes[rtri.verts[0]], nodes[rtri.verts[1]], nodes[rtri.verts[2]]);
-      // debug
-      //      qDebug() << "triangle, min dihedral: " << t << ", " << Dihedral*180/PI << "\n";
-      Dihedral_sum += Dihedral;
-      if(Dihedral < Dihedral_min)
-      {
-        Dihedral_min = Dihedral;
-      }
-      if(Dihedral > Dihedral_max)
-      {
-        Dihedral_max = Dihedral;
-      }
-
-      for(int n0 = 0; n0 < 3; n0++)
-      {
-        // for each of 3 nodes on the t^th triangle
-        int i = rtri.verts[n0];
-        VertexArray::VertD_t& node_i = nodes[i];
-        for(int j = 0; j < 3; j++)
-        {
-          //  for each of the three coordinates of the node
-          if(m_SmoothTripleLines == true && (m_SurfaceMeshNodeType[i] == 3 || m_SurfaceMeshNodeType[i] == 13))
-          {
-            //  if we are smoothing triple lines, and we have a TJ node
-            LDistance = NodeFunctionsType::Distance(node_i, nodes[triplenn[i].triplenn1]) + NodeFunctionsType::Distance(nodes[triplenn[i].triplenn2], nodes[i]);
-          }
-          node_i.pos[j] += small;
-          double Anew = TriangleFunctionsType::area(nodes[rtri.verts[0]], nodes[rtri.verts[1]], nodes[rtri.verts[2]]); //  current Area
-          double Qnew = TriangleFunctionsType::circularity(nodes[rtri.verts[0]], nodes[rtri.verts[1]], nodes[rtri.verts[2]], Anew);
-          if(m_SmoothTripleLines == true && (m_SurfaceMeshNodeType[i] == 3 || m_SurfaceMeshNodeType[i] == 13))
-          {
-            //  if we are smoothing triple lines, and we have a TJ node
-            deltaLDistance =
-                NodeFunctionsType::Distance(node_i, nodes[triplenn[i].triplenn1]) + NodeFunctionsType::Distance(nodes[triplenn[i].triplenn2], nodes[i]) - LDistance; // change in line length
-            F[3 * i + j] -= TJ_scale * deltaLDistance;
-          }
-          node_i.pos[j] -= small;
-          double arg = (A_scale * (Anew - A) + Q_scale * (Qnew - Q) * A) / small;
-          F[3 * i + j] -= arg;
-        }
-        for(int n1 = 0; n1 < 3; n1++)
-        {
-          //  for each of 3 nodes
-          int h = rtri.verts[n1];
-          for(int k = 0; k < 3; k++)
-          {
-            for(int j = 0; j < 3; j++)
-            {
-              K[3 * h + k][3 * i + j] += one12th * (1.0 + delta(i, h)) * n[j] * n[k] * A;
-            }
-          }
-        }
-      }
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, ntri), termsImpl, tbb::auto_partitioner());
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numberNodes), forcesImpl, tbb::auto_partitioner());
     }
-    // add epsilon to the diagonal
-    for(int r = 0; r < numberNodes; r++)
+    else
+#endif
     {
-      for(int s = 0; s < 3; s++)
-      {
-        K[3 * r + s][3 * r + s] += epsilon;
-      }
+      termsImpl.convert(0, ntri);
+      forcesImpl.convert(0, numberNodes);
     }
 
-    // apply boundary conditions
-    for(int r = 0; r < numberNodes; r++)
+    double Q_max = 0.0;
+    double Dihedral_min = 180.0;
+    for(int t = 0; t < ntri; t++)
+    {
+      Q_max = std::max(Q_max, qualities[t]);
+      Dihedral_min = std::min(Dihedral_min, dihedrals[t]);
+    }
+
+    // apply boundary conditions by replacing the diagonal of the constrained coordinates
+    std::fill(diagonalShift.begin(), diagonalShift.end(), 0.0);
+    if(m_NodeConstraints || m_ConstrainQuadPoints)
     {
-      if(m_NodeConstraints == true || m_ConstrainQuadPoints == true)
+      for(int r = 0; r < numberNodes; r++)
       {
-        // only do this if we want the constraint
         if(nodeConstraint[r] % 2 != 0)
         {
-          K[3 * r][3 * r] = large;
+          diagonalShift[3 * r] = large - diagonal[3 * r];
         } // X
         if((nodeConstraint[r] / 2) % 2 != 0)
         {
-          K[3 * r + 1][3 * r + 1] = large;
+          diagonalShift[3 * r + 1] = large - diagonal[3 * r + 1];
         } // Y
         if(nodeConstraint[r] / 4 != 0)
         {
-          K[3 * r + 2][3 * r + 2] = large;
+          diagonalShift[3 * r + 2] = large - diagonal[3 * r + 2];
         } // Z
-        //  changed  12 v 10, ADR
       }
     }
 
-    // solve for node velocities
-    int iterations = MFE::CR(K, x, F, 4000, 1.0e-5);
-    if(isVerbose)
-    {
-      qDebug() << iterations << " iterations ... "
-               << "\n";
-    }
-
-    // Update the quality information
-    if(updates - 1 < Q_max_hist.size())
-    {
-      Q_max_hist[updates - 1] = Q_max;
-    }
-    else
-    {
-      // Update the history of Q_max
-      for(size_t i = 0; i < Q_max_hist.size() - 1; i++)
-      {
-        //    qDebug() << i << " "<< Q_max_hist[i] << " " << Q_max_hist[i+1] << "\n";
-        Q_max_hist[i] = Q_max_hist[i + 1];
-      }
-
-      Q_max_hist[Q_max_hist.size() - 1] = Q_max;
-
-      // Compute the rolling average of the Q_max
-      Q_max_ave = 0;
-      for(size_t i = 0; i < Q_max_hist.size(); i++)
-      {
-        Q_max_ave += Q_max_hist[i];
-      }
-      Q_max_ave /= Q_max_hist.size();
-    }
-    Q_ave = Q_sum / ntri;
-
-    //  for(int i=0; i<Q_max_hist.size(); i++)
-    //    std::cout<<"Q_Max history ... "<<Q_max_hist[i]<<std::endl;
-    if(isVerbose)
-    {
-      qDebug() << "Maximum circularity quality ... " << Q_max << "   - high is bad, low is good"
-               << "\n";
-      qDebug() << "Rolling Average circularity quality ... " << Q_max_ave << "\n";
-      qDebug() << "Average circularity quality ... " << Q_ave << "\n";
-    }
-    Dihedral_ave = Dihedral_sum / (float)ntri;
-    if(isVerbose)
-    {
-      qDebug() << "Smallest min. dihedral angle ... " << Dihedral_min * 180. / M_PI << "   - low is bad, high is good"
-               << "\n";
-      qDebug() << "Average min. dihedral angle ... " << Dihedral_ave * 180. / M_PI << "\n";
-      qDebug() << "Largest min. dihedral angle ... " << Dihedral_max * 180. / M_PI << "\n";
-
-      qDebug() << "\n";
-    }
-#if 0
-    //Output velocities for examination
-    std::ostringstream iter_stream;
-    QString iter_string;
-
-    // write the iteration to a string
-    iter_stream << updates;
-    iter_string = iter_stream;
-
-    // extract the basename from the provided filename
-    QString infile = outputNodesFile;
-    QVector<QString> tokens;
-    QString delimiters = "."; // Only a period
-    QString basename;
-    tokenize(infile, tokens, delimiters);
-
-    if(tokens.size() > 2)
-    {
-      if(isVerbose) { qDebug() << "WARNING: multiple \".\" in file name: " << infile << "\n"; }
-      if(isVerbose) { qDebug() << "\t Using: ." << tokens.front() << "As basename" << "\n"; }
-      basename = tokens.front();
-    }
-    else if(tokens.size() <= 2)
-    {
-      basename = tokens.front();
-    }
-
-    // put it all back together
-    QString iterFileName;
-    if(updates < 9)
-    {
-      iterFileName = basename + "_0" + iter_string + ".inp";
-    }
-    else
-    {
-      iterFileName = basename + "_" + iter_string + ".inp";
-    }
-#endif
+    // solve for node velocities, starting from the velocities of the previous update
+    MFEStiffnessOperator K(triangles, numberNodes, incidenceOffsets, incidence, triangleTerms, diagonalShift, epsilon);
+    MFE::CR(K, x, F, 4000, 1.0e-5);
 
     // update node positions
+    double maxDisplacement = 0.0;
     for(int r = 0; r < numberNodes; r++)
     {
-      //    velocityfile << r << " ";
       for(int s = 0; s < 3; s++)
       {
         double bc_dt = dt;
-        if(m_NodeConstraints == true)
+        if(m_NodeConstraints)
         {
           // only do this if we want the constraint
-          /*
-           if( (fabs(nodes[r][s] - max[s]) < tolerance)
-           || (fabs(nodes[r][s] - min[s]) < tolerance)) bc_dt = 0.0 ;
-           */
           if(s == 0 && nodeConstraint[r] % 2 != 0)
           {
             bc_dt = 0.0;
@@ -965,115 +807,42 @@ void MovingFiniteElementSmoothing::execute()
           {
             bc_dt = 0.0;
           } // Z
-          //  changed  12 v 10, ADR
         }
 
-        if(fabs(dt * x[3 * r + s]) > 1.0)
-        {
-          nodes[r].pos[s] += 0.0;
-        }
-        else if(fabs(dt * x[3 * r + s]) < 1.0)
+        // a node that would move further than one unit in one step is left in place
+        if(fabs(dt * x[3 * r + s]) < 1.0)
         {
           nodes[r].pos[s] += bc_dt * x[3 * r + s];
+          maxDisplacement = std::max(maxDisplacement, fabs(bc_dt * x[3 * r + s]));
         }
-        //    velocityfile  << std::scientific << QSetw(4)
-        //        << QSetprecision(4) << F[3*r+s] << "\t"<< x[3*r+s] <<"\t";
       }
-      //    velocityfile << "\n";
     }
-//  velocityfile.close();
 
-#if 0
-    if(!((updates) % 10))
+    // stop early once the largest node displacement relative to the model extent is small enough
+    double residual = maxDisplacement / extent;
+    QString ss = QObject::tr("Iteration %1 of %2: Residual %3, Max Circularity %4, Min Dihedral Angle %5")
+                     .arg(updates)
+                     .arg(m_IterationSteps)
+                     .arg(residual)
+                     .arg(Q_max)
+                     .arg(Dihedral_min * SIMPLib::Constants::k_180OverPi);
+    notifyStatusMessage(ss);
+    if(m_ConvergenceTolerance > 0.0 && residual < m_ConvergenceTolerance)
     {
-      // Open the outputfile
-      std::ofstream inpfile;
-      inpfile.open(iterFileName.toLatin1().data());
-      if(!inpfile)
-      {
-        if(isVerbose) { qDebug() << "Failed to open: " << iterFileName << "\n"; }
-        return;
-      }
-
-      //      inpfile << nnod <<" "<< ntri <<" 0 2 0"<< "\n" ;
-      inpfile << nnod << " " << ntri << " 2 2 0" << "\n"; //  now that we have NODE properties
-      for (int i = 0; i < nnod; i++)
-      {
-        inpfile << i << " " << nodes[i].pos[0] << " " << nodes[i].pos[1] << " " << nodes[i].pos[2] << "\n";
-      }
-
-      for (int i = 0; i < ntri; i++)
-      {
-        //    inpfile<<i<<" "<<triangles[i].region1>>triangles[i].region2<<" tri ";
-        inpfile << i << " 0 tri ";
-        inpfile << triangles[i].verts[0] << " ";
-        inpfile << triangles[i].verts[1] << " ";
-        inpfile << triangles[i].verts[2] << "\n";
-        //inpfile<<triangles[i].region1<<" ";
-        //inpfile<<triangles[i].region2<<std::endl;
-      }
-
-      //  information on nodes
-      inpfile << "2 1 1" << "\n";
-      inpfile << "Node_Type, none" << "\n";
-      inpfile << "Node_Constraint, none" << "\n";
-      for (int i = 0; i < nnod; i++)
-      {
-        inpfile << i << " " << nodes[i].nodeKind << " " << nodeConstraint[i] << "\n";
-      }
-
-      //  information on elements (triangles)
-      inpfile << "2 1 1" << "\n";
-      inpfile << "minID, none" << "\n";
-      inpfile << "maxID, none" << "\n";
-      for (int i = 0; i < ntri; i++) // ADR  25 jun 09
-      {
-        inpfile << i << " " << triangles[i].nSpin[0] << " " << triangles[i].nSpin[1] << "\n";
-      }
-      inpfile.close();
+      break;
     }
-#endif
-  }
-
-#if 0
-  std::ofstream inpfile;
-  inpfile.open(outputNodesFile.toLatin1().data());
-  if(!inpfile)
-  {
-    if(isVerbose) { qDebug() << "Failed to open nodes output: " << outputNodesFile << "\n"; }
-    return;
-  }
-
-  //   std::ofstream output(argv[2]);
-  inpfile << nnod << "\n";
-  for (int i = 0; i < nnod; i++)
-  {
-    inpfile << QSetw(6) << std::fixed << "\t" << i << "\t" << nodes[i].nodeKind << "\t" << nodes[i].pos[0] << "\t" << nodes[i].pos[1] << "\t"
-            << nodes[i].pos[2] << "\n";
-  }
-  inpfile.close();
-#endif
-
-  if(isVerbose)
-  {
-    qDebug() << "Finished the smoothing "
-             << "\n";
-    qDebug() << "You can combine the nodes and triangles to do further analysis or smoothing"
-             << "\n";
-    // qDebug() << "Look for " << outputNodesFile << "\n";
   }
 
   // Copy the nodes from the 64 bit floating point to the 32 bit floating point
   for(int n = 0; n < numberNodes; ++n)
   {
-    nodesF[n].pos[0] = nodes[n].pos[0];
-    nodesF[n].pos[1] = nodes[n].pos[1];
-    nodesF[n].pos[2] = nodes[n].pos[2];
+    nodesF[3 * n + 0] = static_cast<float>(nodes[n].pos[0]);
+    nodesF[3 * n + 1] = static_cast<float>(nodes[n].pos[1]);
+    nodesF[3 * n + 2] = static_cast<float>(nodes[n].pos[2]);
   }
-
-
 }
 
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
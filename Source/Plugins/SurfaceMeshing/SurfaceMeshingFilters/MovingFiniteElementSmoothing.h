@@ -41,9 +41,6 @@
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
 #include "SurfaceMeshing/SurfaceMeshingFilters/SurfaceMeshFilter.h"
 
-#include "SurfaceMeshing/SurfaceMeshingConstants.h"
-#include "SurfaceMeshing/SurfaceMeshingVersion.h"
-
 #include "SurfaceMeshing/SurfaceMeshingDLLExport.h"
 
 /**
@@ -61,14 +58,15 @@
  */
 class SurfaceMeshing_EXPORT MovingFiniteElementSmoothing : public SurfaceMeshFilter
 {
-    Q_OBJECT
-    // PYB11_CREATE_BINDINGS(MovingFiniteElementSmoothing SUPERCLASS SurfaceMeshFilter)
-    // PYB11_PROPERTY(int IterationSteps READ getIterationSteps WRITE setIterationSteps)
-    // PYB11_PROPERTY(bool NodeConstraints READ getNodeConstraints WRITE setNodeConstraints)
-    // PYB11_PROPERTY(bool ConstrainSurfaceNodes READ getConstrainSurfaceNodes WRITE setConstrainSurfaceNodes)
-    // PYB11_PROPERTY(bool ConstrainQuadPoints READ getConstrainQuadPoints WRITE setConstrainQuadPoints)
-    // PYB11_PROPERTY(bool SmoothTripleLines READ getSmoothTripleLines WRITE setSmoothTripleLines)
-    // PYB11_PROPERTY(DataArrayPath SurfaceMeshNodeTypeArrayPath READ getSurfaceMeshNodeTypeArrayPath WRITE setSurfaceMeshNodeTypeArrayPath)
+  Q_OBJECT
+    PYB11_CREATE_BINDINGS(MovingFiniteElementSmoothing SUPERCLASS SurfaceMeshFilter)
+    PYB11_PROPERTY(int IterationSteps READ getIterationSteps WRITE setIterationSteps)
+    PYB11_PROPERTY(bool NodeConstraints READ getNodeConstraints WRITE setNodeConstraints)
+    PYB11_PROPERTY(bool ConstrainSurfaceNodes READ getConstrainSurfaceNodes WRITE setConstrainSurfaceNodes)
+    PYB11_PROPERTY(bool ConstrainQuadPoints READ getConstrainQuadPoints WRITE setConstrainQuadPoints)
+    PYB11_PROPERTY(bool SmoothTripleLines READ getSmoothTripleLines WRITE setSmoothTripleLines)
+    PYB11_PROPERTY(double ConvergenceTolerance READ getConvergenceTolerance WRITE setConvergenceTolerance)
+    PYB11_PROPERTY(DataArrayPath SurfaceMeshNodeTypeArrayPath READ getSurfaceMeshNodeTypeArrayPath WRITE setSurfaceMeshNodeTypeArrayPath)
   public:
     SIMPL_SHARED_POINTERS(MovingFiniteElementSmoothing)
     SIMPL_FILTER_NEW_MACRO(MovingFiniteElementSmoothing)
@@ -76,7 +74,6 @@ class SurfaceMeshing_EXPORT MovingFiniteElementSmoothing : public SurfaceMeshFil
 
      ~MovingFiniteElementSmoothing() override;
 
-     /* Place your input parameters here. You can use some of the DREAM3D Macros if you want to */
      SIMPL_FILTER_PARAMETER(int, IterationSteps)
      Q_PROPERTY(int IterationSteps READ getIterationSteps WRITE setIterationSteps)
      SIMPL_FILTER_PARAMETER(bool, NodeConstraints)
@@ -87,18 +84,44 @@ class SurfaceMeshing_EXPORT MovingFiniteElementSmoothing : public SurfaceMeshFil
      Q_PROPERTY(bool ConstrainQuadPoints READ getConstrainQuadPoints WRITE setConstrainQuadPoints)
      SIMPL_FILTER_PARAMETER(bool, SmoothTripleLines)
      Q_PROPERTY(bool SmoothTripleLines READ getSmoothTripleLines WRITE setSmoothTripleLines)
+     SIMPL_FILTER_PARAMETER(double, ConvergenceTolerance)
+     Q_PROPERTY(double ConvergenceTolerance READ getConvergenceTolerance WRITE setConvergenceTolerance)
 
-     /**
-      * @brief This returns the group that the filter belonds to. You can select
-      * a different group if you want. The string returned here will be displayed
-      * in the GUI for the filter
-      */
      SIMPL_FILTER_PARAMETER(DataArrayPath, SurfaceMeshNodeTypeArrayPath)
      Q_PROPERTY(DataArrayPath SurfaceMeshNodeTypeArrayPath READ getSurfaceMeshNodeTypeArrayPath WRITE setSurfaceMeshNodeTypeArrayPath)
 
+     /**
+      * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
+      */
      const QString getCompiledLibraryName() const override;
+
+     /**
+      * @brief getBrandingString Returns the branding string for the filter, which is a tag
+      * used to denote the filter's association with specific plugins
+      * @return Branding string
+      */
+     const QString getBrandingString() const override;
+
+     /**
+      * @brief getFilterVersion Returns a version string for this filter. Default
+      * value is an empty string.
+      * @return
+      */
+     const QString getFilterVersion() const override;
+
+     /**
+      * @brief newFilterInstance Reimplemented from @see AbstractFilter class
+      */
      AbstractFilter::Pointer newFilterInstance(bool copyFilterParameters) const override;
+
+     /**
+      * @brief getGroupName Reimplemented from @see AbstractFilter class
+      */
      const QString getGroupName() const override;
+
+     /**
+      * @brief getSubGroupName Reimplemented from @see AbstractFilter class
+      */
      const QString getSubGroupName() const override;
 
      /**
@@ -108,31 +131,27 @@ class SurfaceMeshing_EXPORT MovingFiniteElementSmoothing : public SurfaceMeshFil
      const QUuid getUuid() override;
 
      /**
-      * @brief This returns a string that is displayed in the GUI. It should be readable
-      * and understandable by humans.
+      * @brief getHumanLabel Reimplemented from @see AbstractFilter class
       */
      const QString getHumanLabel() const override;
 
      /**
-      * @brief This method will instantiate all the end user settable options/parameters
-      * for this filter
+      * @brief setupFilterParameters Reimplemented from @see AbstractFilter class
       */
      void setupFilterParameters() override;
 
      /**
-      * @brief This method will read the options from a file
-      * @param reader The reader that is used to read the options from a file
+      * @brief readFilterParameters Reimplemented from @see AbstractFilter class
       */
      void readFilterParameters(AbstractFilterParametersReader* reader, int index) override;
 
      /**
-      * @brief Reimplemented from @see AbstractFilter class
+      * @brief execute Reimplemented from @see AbstractFilter class
       */
      void execute() override;
 
      /**
-      * @brief This function runs some sanity checks on the DataContainer and inputs
-      * in an attempt to ensure the filter can process the inputs.
+      * @brief preflight Reimplemented from @see AbstractFilter class
       */
      void preflight() override;
 
@@ -164,9 +183,3 @@ class SurfaceMeshing_EXPORT MovingFiniteElementSmoothing : public SurfaceMeshFil
      MovingFiniteElementSmoothing& operator=(const MovingFiniteElementSmoothing&) = delete; // Copy Assignment Not Implemented
      MovingFiniteElementSmoothing& operator=(MovingFiniteElementSmoothing&&) = delete;      // Move Assignment Not Implemented
 };
-
-
-
-
-
-
@@ -42,6 +42,7 @@
 #include "SIMPLib/Geometry/TriangleGeom.h"
 
 #include "SurfaceMeshing/SurfaceMeshingConstants.h"
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/SharedFeatureFaceIndex.hpp"
 #include "SurfaceMeshing/SurfaceMeshingVersion.h"
 
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
@@ -202,72 +203,37 @@ void SharedFeatureFaceFilter::execute()
   TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
   int64_t totalPoints = triangleGeom->getNumberOfTris();
 
-  QMap<uint64_t, int32_t> faceSizeMap;
-  QMap<uint64_t, int32_t> faceIdMap; // This maps a unique 64 bit integer to an increasing 32 bit integer
-  int32_t index = 1;
-  struct
-  {
-    int g;
-    int r;
-  } faceId;
-  uint64_t* faceId_64 = reinterpret_cast<uint64_t*>(&faceId);
-  int32_t fl0 = -1;
-  int32_t fl1 = -1;
-
-  std::vector<std::pair<int32_t, int32_t>> faceLabelMap;
-  faceLabelMap.push_back(std::pair<int32_t, int32_t>(0, 0));
-
-  // Loop through all the Triangles and figure out how many triangles we have in each one.
-  for(int64_t t = 0; t < totalPoints; ++t)
-  {
-    fl0 = m_SurfaceMeshFaceLabels[t * 2];
-    fl1 = m_SurfaceMeshFaceLabels[t * 2 + 1];
-    if(fl0 < fl1)
-    {
-      faceId.g = fl0;
-      faceId.r = fl1;
-    }
-    else
-    {
-      faceId.g = fl1;
-      faceId.r = fl0;
-    }
-
-    QMap<uint64_t, int32_t>::iterator iter = faceSizeMap.find(*faceId_64);
-    if(iter == faceSizeMap.end())
-    {
-      faceSizeMap[*faceId_64] = 1;
-      faceIdMap[*faceId_64] = index;
-      m_SurfaceMeshFeatureFaceIds[t] = index;
-      faceLabelMap.push_back(std::pair<int32_t, int32_t>(faceId.g, faceId.r));
-      ++index;
-    }
-    else
-    {
-      iter.value()++;
-      m_SurfaceMeshFeatureFaceIds[t] = faceIdMap[*faceId_64];
-    }
-  }
+  // Group the triangles by their (sorted) pair of Face Labels. Feature Face Ids are handed out
+  // starting at 1 in the order in which each pair of Face Labels first appears.
+  SharedFeatureFaceIndex faceIndex;
+  faceIndex.buildFromFaceLabels(m_SurfaceMeshFaceLabels, static_cast<size_t>(totalPoints), m_SurfaceMeshFeatureFaceIds);
+  size_t numFaces = faceIndex.getNumberOfFaces();
 
   // resize + update pointers
-  QVector<size_t> tDims(1, index);
+  QVector<size_t> tDims(1, numFaces);
   faceFeatureAttrMat->resizeAttributeArrays(tDims);
   m_SurfaceMeshFeatureFaceLabels = m_SurfaceMeshFeatureFaceLabelsPtr.lock()->getPointer(0);
   m_SurfaceMeshFeatureFaceNumTriangles = m_SurfaceMeshFeatureFaceNumTrianglesPtr.lock()->getPointer(0);
 
-  for(int32_t i = 0; i < index; i++)
+  // Feature Face 0 carries the labels (0, 0). Its triangle count is the count of any Feature Face
+  // whose labels are also (0, 0), which is how the face counts have always been reported.
+  m_SurfaceMeshFeatureFaceLabels[0] = 0;
+  m_SurfaceMeshFeatureFaceLabels[1] = 0;
+  m_SurfaceMeshFeatureFaceNumTriangles[0] = 0;
+  for(size_t i = 1; i < numFaces; i++)
   {
     // get feature face labels
-    m_SurfaceMeshFeatureFaceLabels[2 * i + 0] = faceLabelMap[i].first;
-    m_SurfaceMeshFeatureFaceLabels[2 * i + 1] = faceLabelMap[i].second;
+    const std::pair<int32_t, int32_t>& labels = faceIndex.getLabels(i);
+    m_SurfaceMeshFeatureFaceLabels[2 * i + 0] = labels.first;
+    m_SurfaceMeshFeatureFaceLabels[2 * i + 1] = labels.second;
 
     // get feature triangle count
-    faceId.g = faceLabelMap[i].first;
-    faceId.r = faceLabelMap[i].second;
-    m_SurfaceMeshFeatureFaceNumTriangles[i] = faceSizeMap[*faceId_64];
+    m_SurfaceMeshFeatureFaceNumTriangles[i] = static_cast<int32_t>(faceIndex.getNumberOfTriangles(i));
+    if(labels.first == 0 && labels.second == 0)
+    {
+      m_SurfaceMeshFeatureFaceNumTriangles[0] = m_SurfaceMeshFeatureFaceNumTriangles[i];
+    }
   }
-
-
 }
 
 // -----------------------------------------------------------------------------
@@ -23,12 +23,15 @@ set(_PublicFilters
   FindTriangleGeomShapes
   FindTriangleGeomSizes
   LaplacianSmoothing
+  M3CSliceBySlice
+  MovingFiniteElementSmoothing
   QuickSurfaceMesh
   ReverseTriangleWinding
   SharedFeatureFaceFilter
   TriangleAreaFilter
   TriangleCentroidFilter
   TriangleDihedralAngleFilter
+  TriangleMetricsFilter
   TriangleNormalFilter
   GenerateGeometryConnectivity
 )
@@ -58,12 +61,7 @@ endforeach()
 # This is the list of Private Filters. These filters are available from other filters but the user will not
 # be able to use them from the DREAM3D user interface.
 set(_PrivateFilters
-
-  
-  # These filters require extensive updates to comply with the IGeometry design
-  #M3CSliceBySlice
-  #MovingFiniteElementSmoothing
-  #VerifyTriangleWinding
+  VerifyTriangleWinding
 )
 
 #-----------------
@@ -98,6 +96,14 @@ ADD_SIMPL_SUPPORT_SOURCE(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} util/P
 ADD_SIMPL_SUPPORT_HEADER(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} util/TriangleOps.h)
 ADD_SIMPL_SUPPORT_SOURCE(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} util/TriangleOps.cpp)
 
+ADD_SIMPL_SUPPORT_HEADER(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} util/GeometryConnectivity.h)
+ADD_SIMPL_SUPPORT_SOURCE(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} util/GeometryConnectivity.cpp)
+
+ADD_SIMPL_SUPPORT_HEADER(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} util/SharedFeatureFaceIndex.hpp)
+
+ADD_SIMPL_SUPPORT_HEADER(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} util/TriangleMetrics.h)
+ADD_SIMPL_SUPPORT_SOURCE(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} util/TriangleMetrics.cpp)
+
 #ADD_SIMPL_SUPPORT_HEADER(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} util/Exception.h)
 #ADD_SIMPL_SUPPORT_HEADER(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} util/InvalidParameterException.h)
 
@@ -35,21 +35,14 @@
 
 #include "TriangleAreaFilter.h"
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-#include <tbb/blocked_range.h>
-#include <tbb/parallel_for.h>
-#include <tbb/partitioner.h>
-#include <tbb/task_scheduler_init.h>
-#endif
-
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArrayCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
-#include "SIMPLib/Math/MatrixMath.h"
 
 #include "SurfaceMeshing/SurfaceMeshingConstants.h"
 #include "SurfaceMeshing/SurfaceMeshingVersion.h"
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/TriangleMetrics.h"
 
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
 enum createdPathID : RenameDataPath::DataID_t
@@ -58,59 +51,6 @@ enum createdPathID : RenameDataPath::DataID_t
   DataArrayID31 = 31,
 };
 
-#define SQR(value) (value) * (value)
-
-/**
- * @brief The CalculateAreasImpl class implements a threaded algorithm that computes the area of each
- * triangle for a set of triangles
- */
-class CalculateAreasImpl
-{
-  SharedVertexList::Pointer m_Nodes;
-  SharedTriList::Pointer m_Triangles;
-  double* m_Areas;
-
-public:
-  CalculateAreasImpl(SharedVertexList::Pointer nodes, SharedTriList::Pointer triangles, double* Areas)
-  : m_Nodes(nodes)
-  , m_Triangles(triangles)
-  , m_Areas(Areas)
-  {
-  }
-  virtual ~CalculateAreasImpl() = default;
-
-  void generate(size_t start, size_t end) const
-  {
-    int64_t* triangles = m_Triangles->getPointer(0);
-    int64_t nIdx0 = 0, nIdx1 = 0, nIdx2 = 0;
-    float vecA[3] = {0.0f, 0.0f, 0.0f};
-    float vecB[3] = {0.0f, 0.0f, 0.0f};
-    float cross[3] = {0.0f, 0.0f, 0.0f};
-    for(size_t i = start; i < end; i++)
-    {
-      nIdx0 = triangles[i * 3];
-      nIdx1 = triangles[i * 3 + 1];
-      nIdx2 = triangles[i * 3 + 2];
-      float* A = m_Nodes->getPointer(nIdx0 * 3);
-      float* B = m_Nodes->getPointer(nIdx1 * 3);
-      float* C = m_Nodes->getPointer(nIdx2 * 3);
-
-      MatrixMath::Subtract3x1s(A, B, vecA);
-      MatrixMath::Subtract3x1s(A, C, vecB);
-      MatrixMath::CrossProduct(vecA, vecB, cross);
-      float area = 0.5f * MatrixMath::Magnitude3x1(cross);
-      m_Areas[i] = area;
-    }
-  }
-
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  void operator()(const tbb::blocked_range<size_t>& r) const
-  {
-    generate(r.begin(), r.end());
-  }
-#endif
-};
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -216,27 +156,11 @@ void TriangleAreaFilter::execute()
 
   DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(getSurfaceMeshTriangleAreasArrayPath().getDataContainerName());
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
-  bool doParallel = true;
-#endif
-
   TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  if(doParallel)
-  {
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, triangleGeom->getNumberOfTris()), CalculateAreasImpl(triangleGeom->getVertices(), triangleGeom->getTriangles(), m_SurfaceMeshTriangleAreas),
-                      tbb::auto_partitioner());
-  }
-  else
-#endif
-  {
-    CalculateAreasImpl serial(triangleGeom->getVertices(), triangleGeom->getTriangles(), m_SurfaceMeshTriangleAreas);
-    serial.generate(0, triangleGeom->getNumberOfTris());
-  }
-
-
+  TriangleMetrics::Outputs outputs;
+  outputs.areas = m_SurfaceMeshTriangleAreas;
+  TriangleMetrics::compute(triangleGeom->getVertexPointer(0), triangleGeom->getTriPointer(0), triangleGeom->getNumberOfTris(), outputs);
 }
 // -----------------------------------------------------------------------------
 //
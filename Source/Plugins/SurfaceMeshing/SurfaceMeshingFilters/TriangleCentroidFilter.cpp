@@ -35,13 +35,6 @@
 
 #include "TriangleCentroidFilter.h"
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-#include <tbb/blocked_range.h>
-#include <tbb/parallel_for.h>
-#include <tbb/partitioner.h>
-#include <tbb/task_scheduler_init.h>
-#endif
-
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArrayCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
@@ -49,6 +42,7 @@
 
 #include "SurfaceMeshing/SurfaceMeshingConstants.h"
 #include "SurfaceMeshing/SurfaceMeshingVersion.h"
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/TriangleMetrics.h"
 
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
 enum createdPathID : RenameDataPath::DataID_t
@@ -57,46 +51,6 @@ enum createdPathID : RenameDataPath::DataID_t
   DataArrayID31 = 31,
 };
 
-/**
- * @brief The CalculateCentroidsImpl class implements a threaded algorithm that computes the centroids of
- * each triangle in a set of triangles
- */
-class CalculateCentroidsImpl
-{
-  SharedVertexList::Pointer m_Nodes;
-  SharedTriList::Pointer m_Triangles;
-  double* m_Centroids;
-
-public:
-  CalculateCentroidsImpl(SharedVertexList::Pointer nodes, SharedTriList::Pointer triangles, double* centroids)
-  : m_Nodes(nodes)
-  , m_Triangles(triangles)
-  , m_Centroids(centroids)
-  {
-  }
-  virtual ~CalculateCentroidsImpl() = default;
-
-  void generate(size_t start, size_t end) const
-  {
-    float* nodes = m_Nodes->getPointer(0);
-    int64_t* triangles = m_Triangles->getPointer(0);
-
-    for(size_t i = start; i < end; i++)
-    {
-      m_Centroids[i * 3] = (nodes[triangles[i * 3] * 3 + 0] + nodes[triangles[i * 3 + 1] * 3 + 0] + nodes[triangles[i * 3 + 2] * 3 + 0]) / 3.0;
-      m_Centroids[i * 3 + 1] = (nodes[triangles[i * 3] * 3 + 1] + nodes[triangles[i * 3 + 1] * 3 + 1] + nodes[triangles[i * 3 + 2] * 3 + 1]) / 3.0;
-      m_Centroids[i * 3 + 2] = (nodes[triangles[i * 3] * 3 + 2] + nodes[triangles[i * 3 + 1] * 3 + 2] + nodes[triangles[i * 3 + 2] * 3 + 2]) / 3.0;
-    }
-  }
-
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  void operator()(const tbb::blocked_range<size_t>& r) const
-  {
-    generate(r.begin(), r.end());
-  }
-#endif
-};
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -202,28 +156,12 @@ void TriangleCentroidFilter::execute()
 
   DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(getSurfaceMeshTriangleCentroidsArrayPath().getDataContainerName());
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
-  bool doParallel = true;
-#endif
-
   // No check because datacheck() made sure we can do the next line.
   TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  if(doParallel)
-  {
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, triangleGeom->getNumberOfTris()), CalculateCentroidsImpl(triangleGeom->getVertices(), triangleGeom->getTriangles(), m_SurfaceMeshTriangleCentroids),
-                      tbb::auto_partitioner());
-  }
-  else
-#endif
-  {
-    CalculateCentroidsImpl serial(triangleGeom->getVertices(), triangleGeom->getTriangles(), m_SurfaceMeshTriangleCentroids);
-    serial.generate(0, triangleGeom->getNumberOfTris());
-  }
-
-
+  TriangleMetrics::Outputs outputs;
+  outputs.centroids = m_SurfaceMeshTriangleCentroids;
+  TriangleMetrics::compute(triangleGeom->getVertexPointer(0), triangleGeom->getTriPointer(0), triangleGeom->getNumberOfTris(), outputs);
 }
 // -----------------------------------------------------------------------------
 //
@@ -35,21 +35,14 @@
 
 #include "TriangleDihedralAngleFilter.h"
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-#include <tbb/blocked_range.h>
-#include <tbb/parallel_for.h>
-#include <tbb/partitioner.h>
-#include <tbb/task_scheduler_init.h>
-#endif
-
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArrayCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
-#include "SIMPLib/Math/SIMPLibMath.h"
 
 #include "SurfaceMeshing/SurfaceMeshingConstants.h"
 #include "SurfaceMeshing/SurfaceMeshingVersion.h"
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/TriangleMetrics.h"
 
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
 enum createdPathID : RenameDataPath::DataID_t
@@ -58,79 +51,6 @@ enum createdPathID : RenameDataPath::DataID_t
   DataArrayID31 = 31,
 };
 
-/**
- * @brief The CalculateDihedralAnglesImpl class implements a threaded algorithm that computes the minimum dihedral angle
- * for each triangle in a set of triangles
- */
-class CalculateDihedralAnglesImpl
-{
-  SharedVertexList::Pointer m_Nodes;
-  SharedTriList::Pointer m_Triangles;
-  double* m_DihedralAngles;
-
-public:
-  CalculateDihedralAnglesImpl(SharedVertexList::Pointer nodes, SharedTriList::Pointer triangles, double* DihedralAngles)
-  : m_Nodes(nodes)
-  , m_Triangles(triangles)
-  , m_DihedralAngles(DihedralAngles)
-  {
-  }
-  virtual ~CalculateDihedralAnglesImpl() = default;
-
-  void generate(size_t start, size_t end) const
-  {
-    float* nodes = m_Nodes->getPointer(0);
-    int64_t* triangles = m_Triangles->getPointer(0);
-
-    float radToDeg = 180.0f / SIMPLib::Constants::k_Pi;
-
-    float ABx = 0.0f, ABy = 0.0f, ABz = 0.0f, ACx = 0.0f, ACy = 0.0f, ACz = 0.0f, BCx = 0.0f, BCy = 0.0f, BCz = 0.0f;
-    float magAB = 0.0f, magAC = 0.0f, magBC = 0.0f;
-    float dihedralAngle1 = 0.0f, dihedralAngle2 = 0.0f, dihedralAngle3 = 0.0f, minDihedralAngle = 0.0f;
-    for(size_t i = start; i < end; i++)
-    {
-      minDihedralAngle = 180.0f;
-
-      ABx = nodes[triangles[i * 3] * 3 + 0] - nodes[triangles[i * 3 + 1] * 3 + 0];
-      ABy = nodes[triangles[i * 3] * 3 + 1] - nodes[triangles[i * 3 + 1] * 3 + 1];
-      ABz = nodes[triangles[i * 3] * 3 + 2] - nodes[triangles[i * 3 + 1] * 3 + 2];
-      magAB = sqrtf(ABx * ABx + ABy * ABy + ABz * ABz);
-
-      ACx = nodes[triangles[i * 3] * 3 + 0] - nodes[triangles[i * 3 + 2] * 3 + 0];
-      ACy = nodes[triangles[i * 3] * 3 + 1] - nodes[triangles[i * 3 + 2] * 3 + 1];
-      ACz = nodes[triangles[i * 3] * 3 + 2] - nodes[triangles[i * 3 + 2] * 3 + 2];
-      magAC = sqrtf(ACx * ACx + ACy * ACy + ACz * ACz);
-
-      BCx = nodes[triangles[i * 3 + 1] * 3 + 0] - nodes[triangles[i * 3 + 2] * 3 + 0];
-      BCy = nodes[triangles[i * 3 + 1] * 3 + 1] - nodes[triangles[i * 3 + 2] * 3 + 1];
-      BCz = nodes[triangles[i * 3 + 1] * 3 + 2] - nodes[triangles[i * 3 + 2] * 3 + 2];
-      magBC = sqrtf(BCx * BCx + BCy * BCy + BCz * BCz);
-
-      dihedralAngle1 = radToDeg * acos(((ABx * ACx) + (ABy * ACy) + (ABz * ACz)) / (magAB * magAC));
-      // 180 - angle because AB points out of vertex and BC points into vertex, so angle is actually angle outside of triangle
-      dihedralAngle2 = 180.0f - (radToDeg * acos(((ABx * BCx) + (ABy * BCy) + (ABz * BCz)) / (magAB * magBC)));
-      dihedralAngle3 = radToDeg * acos(((BCx * ACx) + (BCy * ACy) + (BCz * ACz)) / (magBC * magAC));
-      minDihedralAngle = dihedralAngle1;
-      if(dihedralAngle2 < minDihedralAngle)
-      {
-        minDihedralAngle = dihedralAngle2;
-      }
-      if(dihedralAngle3 < minDihedralAngle)
-      {
-        minDihedralAngle = dihedralAngle3;
-      }
-      m_DihedralAngles[i] = minDihedralAngle;
-    }
-  }
-
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  void operator()(const tbb::blocked_range<size_t>& r) const
-  {
-    generate(r.begin(), r.end());
-  }
-#endif
-};
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -237,27 +157,11 @@ void TriangleDihedralAngleFilter::execute()
 
   DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(getSurfaceMeshTriangleDihedralAnglesArrayPath().getDataContainerName());
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
-  bool doParallel = true;
-#endif
-
   TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  if(doParallel)
-  {
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, triangleGeom->getNumberOfTris()),
-                      CalculateDihedralAnglesImpl(triangleGeom->getVertices(), triangleGeom->getTriangles(), m_SurfaceMeshTriangleDihedralAngles), tbb::auto_partitioner());
-  }
-  else
-#endif
-  {
-    CalculateDihedralAnglesImpl serial(triangleGeom->getVertices(), triangleGeom->getTriangles(), m_SurfaceMeshTriangleDihedralAngles);
-    serial.generate(0, triangleGeom->getNumberOfTris());
-  }
-
-
+  TriangleMetrics::Outputs outputs;
+  outputs.minDihedralAngles = m_SurfaceMeshTriangleDihedralAngles;
+  TriangleMetrics::compute(triangleGeom->getVertexPointer(0), triangleGeom->getTriPointer(0), triangleGeom->getNumberOfTris(), outputs);
 }
 // -----------------------------------------------------------------------------
 //
@@ -0,0 +1,367 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include "TriangleMetricsFilter.h"
+
+#include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/DataArrayCreationFilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
+#include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+
+#include "SurfaceMeshing/SurfaceMeshingConstants.h"
+#include "SurfaceMeshing/SurfaceMeshingVersion.h"
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/TriangleMetrics.h"
+
+/* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
+enum createdPathID : RenameDataPath::DataID_t
+{
+  DataArrayID30 = 30,
+  DataArrayID31 = 31,
+  DataArrayID32 = 32,
+  DataArrayID33 = 33,
+  DataArrayID34 = 34,
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+TriangleMetricsFilter::TriangleMetricsFilter()
+: m_ComputeAreas(true)
+, m_SurfaceMeshTriangleAreasArrayPath(SIMPL::Defaults::TriangleDataContainerName, SIMPL::Defaults::FaceAttributeMatrixName, SIMPL::FaceData::SurfaceMeshFaceAreas)
+, m_ComputeNormals(true)
+, m_SurfaceMeshTriangleNormalsArrayPath(SIMPL::Defaults::TriangleDataContainerName, SIMPL::Defaults::FaceAttributeMatrixName, SIMPL::FaceData::SurfaceMeshFaceNormals)
+, m_ComputeCentroids(true)
+, m_SurfaceMeshTriangleCentroidsArrayPath(SIMPL::Defaults::TriangleDataContainerName, SIMPL::Defaults::FaceAttributeMatrixName, SIMPL::FaceData::SurfaceMeshFaceCentroids)
+, m_ComputeDihedralAngles(true)
+, m_SurfaceMeshTriangleDihedralAnglesArrayPath(SIMPL::Defaults::TriangleDataContainerName, SIMPL::Defaults::FaceAttributeMatrixName, SIMPL::FaceData::SurfaceMeshFaceDihedralAngles)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+TriangleMetricsFilter::~TriangleMetricsFilter() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TriangleMetricsFilter::setupFilterParameters()
+{
+  SurfaceMeshFilter::setupFilterParameters();
+  FilterParameterVectorType parameters;
+  QStringList linkedProps("SurfaceMeshTriangleAreasArrayPath");
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Compute Areas", ComputeAreas, FilterParameter::Parameter, TriangleMetricsFilter, linkedProps));
+  linkedProps.clear();
+  linkedProps << "SurfaceMeshTriangleNormalsArrayPath";
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Compute Normals", ComputeNormals, FilterParameter::Parameter, TriangleMetricsFilter, linkedProps));
+  linkedProps.clear();
+  linkedProps << "SurfaceMeshTriangleCentroidsArrayPath";
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Compute Centroids", ComputeCentroids, FilterParameter::Parameter, TriangleMetricsFilter, linkedProps));
+  linkedProps.clear();
+  linkedProps << "SurfaceMeshTriangleDihedralAnglesArrayPath";
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Compute Minimum Dihedral Angles", ComputeDihedralAngles, FilterParameter::Parameter, TriangleMetricsFilter, linkedProps));
+  parameters.push_back(SeparatorFilterParameter::New("Face Data", FilterParameter::CreatedArray));
+  {
+    DataArrayCreationFilterParameter::RequirementType req = DataArrayCreationFilterParameter::CreateRequirement(AttributeMatrix::Type::Face, IGeometry::Type::Triangle);
+    parameters.push_back(SIMPL_NEW_DA_CREATION_FP("Face Areas", SurfaceMeshTriangleAreasArrayPath, FilterParameter::CreatedArray, TriangleMetricsFilter, req));
+    parameters.push_back(SIMPL_NEW_DA_CREATION_FP("Face Normals", SurfaceMeshTriangleNormalsArrayPath, FilterParameter::CreatedArray, TriangleMetricsFilter, req));
+    parameters.push_back(SIMPL_NEW_DA_CREATION_FP("Face Centroids", SurfaceMeshTriangleCentroidsArrayPath, FilterParameter::CreatedArray, TriangleMetricsFilter, req));
+    parameters.push_back(SIMPL_NEW_DA_CREATION_FP("Face Dihedral Angles", SurfaceMeshTriangleDihedralAnglesArrayPath, FilterParameter::CreatedArray, TriangleMetricsFilter, req));
+  }
+  setFilterParameters(parameters);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TriangleMetricsFilter::readFilterParameters(AbstractFilterParametersReader* reader, int index)
+{
+  reader->openFilterGroup(this, index);
+  setComputeAreas(reader->readValue("ComputeAreas", getComputeAreas()));
+  setSurfaceMeshTriangleAreasArrayPath(reader->readDataArrayPath("SurfaceMeshTriangleAreasArrayPath", getSurfaceMeshTriangleAreasArrayPath()));
+  setComputeNormals(reader->readValue("ComputeNormals", getComputeNormals()));
+  setSurfaceMeshTriangleNormalsArrayPath(reader->readDataArrayPath("SurfaceMeshTriangleNormalsArrayPath", getSurfaceMeshTriangleNormalsArrayPath()));
+  setComputeCentroids(reader->readValue("ComputeCentroids", getComputeCentroids()));
+  setSurfaceMeshTriangleCentroidsArrayPath(reader->readDataArrayPath("SurfaceMeshTriangleCentroidsArrayPath", getSurfaceMeshTriangleCentroidsArrayPath()));
+  setComputeDihedralAngles(reader->readValue("ComputeDihedralAngles", getComputeDihedralAngles()));
+  setSurfaceMeshTriangleDihedralAnglesArrayPath(reader->readDataArrayPath("SurfaceMeshTriangleDihedralAnglesArrayPath", getSurfaceMeshTriangleDihedralAnglesArrayPath()));
+  reader->closeFilterGroup();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TriangleMetricsFilter::initialize()
+{
+  m_SurfaceMeshTriangleAreas = nullptr;
+  m_SurfaceMeshTriangleNormals = nullptr;
+  m_SurfaceMeshTriangleCentroids = nullptr;
+  m_SurfaceMeshTriangleDihedralAngles = nullptr;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<DataArrayPath> TriangleMetricsFilter::getSelectedArrayPaths() const
+{
+  QVector<DataArrayPath> paths;
+  if(m_ComputeAreas)
+  {
+    paths.push_back(getSurfaceMeshTriangleAreasArrayPath());
+  }
+  if(m_ComputeNormals)
+  {
+    paths.push_back(getSurfaceMeshTriangleNormalsArrayPath());
+  }
+  if(m_ComputeCentroids)
+  {
+    paths.push_back(getSurfaceMeshTriangleCentroidsArrayPath());
+  }
+  if(m_ComputeDihedralAngles)
+  {
+    paths.push_back(getSurfaceMeshTriangleDihedralAnglesArrayPath());
+  }
+  return paths;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TriangleMetricsFilter::dataCheck()
+{
+  clearErrorCode();
+  clearWarningCode();
+  initialize();
+
+  QVector<DataArrayPath> paths = getSelectedArrayPaths();
+  if(paths.isEmpty())
+  {
+    setErrorCondition(-11000, "At least one Triangle metric must be selected");
+    return;
+  }
+  // All the outputs come from one sweep over one Triangle Geometry
+  for(const DataArrayPath& path : paths)
+  {
+    if(path.getDataContainerName() != paths[0].getDataContainerName())
+    {
+      QString ss = QObject::tr("All created Face arrays must be in the same Data Container; '%1' is not in '%2'").arg(path.serialize("/")).arg(paths[0].getDataContainerName());
+      setErrorCondition(-11001, ss);
+      return;
+    }
+  }
+
+  TriangleGeom::Pointer triangles = getDataContainerArray()->getPrereqGeometryFromDataContainer<TriangleGeom, AbstractFilter>(this, paths[0].getDataContainerName());
+
+  QVector<IDataArray::Pointer> dataArrays;
+
+  if(getErrorCode() >= 0)
+  {
+    dataArrays.push_back(triangles->getTriangles());
+  }
+
+  QVector<size_t> cDims(1, 1);
+  if(m_ComputeAreas)
+  {
+    cDims[0] = 1;
+    m_SurfaceMeshTriangleAreasPtr =
+        getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<double>, AbstractFilter, double>(this, getSurfaceMeshTriangleAreasArrayPath(), 0, cDims, "", DataArrayID31);
+    if(nullptr != m_SurfaceMeshTriangleAreasPtr.lock()) /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
+    {
+      m_SurfaceMeshTriangleAreas = m_SurfaceMeshTriangleAreasPtr.lock()->getPointer(0);
+    } /* Now assign the raw pointer to data from the DataArray<T> object */
+    if(getErrorCode() >= 0)
+    {
+      dataArrays.push_back(m_SurfaceMeshTriangleAreasPtr.lock());
+    }
+  }
+
+  if(m_ComputeNormals)
+  {
+    cDims[0] = 3;
+    m_SurfaceMeshTriangleNormalsPtr =
+        getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<double>, AbstractFilter, double>(this, getSurfaceMeshTriangleNormalsArrayPath(), 0, cDims, "", DataArrayID32);
+    if(nullptr != m_SurfaceMeshTriangleNormalsPtr.lock()) /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
+    {
+      m_SurfaceMeshTriangleNormals = m_SurfaceMeshTriangleNormalsPtr.lock()->getPointer(0);
+    } /* Now assign the raw pointer to data from the DataArray<T> object */
+    if(getErrorCode() >= 0)
+    {
+      dataArrays.push_back(m_SurfaceMeshTriangleNormalsPtr.lock());
+    }
+  }
+
+  if(m_ComputeCentroids)
+  {
+    cDims[0] = 3;
+    m_SurfaceMeshTriangleCentroidsPtr =
+        getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<double>, AbstractFilter, double>(this, getSurfaceMeshTriangleCentroidsArrayPath(), 0, cDims, "", DataArrayID33);
+    if(nullptr != m_SurfaceMeshTriangleCentroidsPtr.lock()) /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
+    {
+      m_SurfaceMeshTriangleCentroids = m_SurfaceMeshTriangleCentroidsPtr.lock()->getPointer(0);
+    } /* Now assign the raw pointer to data from the DataArray<T> object */
+    if(getErrorCode() >= 0)
+    {
+      dataArrays.push_back(m_SurfaceMeshTriangleCentroidsPtr.lock());
+    }
+  }
+
+  if(m_ComputeDihedralAngles)
+  {
+    cDims[0] = 1;
+    m_SurfaceMeshTriangleDihedralAnglesPtr =
+        getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<double>, AbstractFilter, double>(this, getSurfaceMeshTriangleDihedralAnglesArrayPath(), 0, cDims, "", DataArrayID34);
+    if(nullptr != m_SurfaceMeshTriangleDihedralAnglesPtr.lock()) /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
+    {
+      m_SurfaceMeshTriangleDihedralAngles = m_SurfaceMeshTriangleDihedralAnglesPtr.lock()->getPointer(0);
+    } /* Now assign the raw pointer to data from the DataArray<T> object */
+    if(getErrorCode() >= 0)
+    {
+      dataArrays.push_back(m_SurfaceMeshTriangleDihedralAnglesPtr.lock());
+    }
+  }
+
+  getDataContainerArray()->validateNumberOfTuples<AbstractFilter>(this, dataArrays);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TriangleMetricsFilter::preflight()
+{
+  setInPreflight(true);
+  emit preflightAboutToExecute();
+  emit updateFilterParameters(this);
+  dataCheck();
+  emit preflightExecuted();
+  setInPreflight(false);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TriangleMetricsFilter::execute()
+{
+  clearErrorCode();
+  clearWarningCode();
+  dataCheck();
+  if(getErrorCode() < 0)
+  {
+    return;
+  }
+
+  DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(getSelectedArrayPaths()[0].getDataContainerName());
+  TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
+
+  // The arrays that were not selected are left as nullptr and are skipped by the sweep
+  TriangleMetrics::Outputs outputs;
+  outputs.areas = m_SurfaceMeshTriangleAreas;
+  outputs.normals = m_SurfaceMeshTriangleNormals;
+  outputs.centroids = m_SurfaceMeshTriangleCentroids;
+  outputs.minDihedralAngles = m_SurfaceMeshTriangleDihedralAngles;
+  TriangleMetrics::compute(triangleGeom->getVertexPointer(0), triangleGeom->getTriPointer(0), triangleGeom->getNumberOfTris(), outputs);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AbstractFilter::Pointer TriangleMetricsFilter::newFilterInstance(bool copyFilterParameters) const
+{
+  TriangleMetricsFilter::Pointer filter = TriangleMetricsFilter::New();
+  if(copyFilterParameters)
+  {
+    copyFilterParameterInstanceVariables(filter.get());
+  }
+  return filter;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString TriangleMetricsFilter::getCompiledLibraryName() const
+{
+  return SurfaceMeshingConstants::SurfaceMeshingBaseName;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString TriangleMetricsFilter::getBrandingString() const
+{
+  return "SurfaceMeshing";
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString TriangleMetricsFilter::getFilterVersion() const
+{
+  QString version;
+  QTextStream vStream(&version);
+  vStream << SurfaceMeshing::Version::Major() << "." << SurfaceMeshing::Version::Minor() << "." << SurfaceMeshing::Version::Patch();
+  return version;
+}
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString TriangleMetricsFilter::getGroupName() const
+{
+  return SIMPL::FilterGroups::SurfaceMeshingFilters;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QUuid TriangleMetricsFilter::getUuid()
+{
+  return QUuid("{61bb999d-aac6-4099-9e30-d623a1f54446}");
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString TriangleMetricsFilter::getSubGroupName() const
+{
+  return SIMPL::FilterSubGroups::MiscFilters;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString TriangleMetricsFilter::getHumanLabel() const
+{
+  return "Generate Triangle Metrics";
+}
@@ -0,0 +1,187 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#pragma once
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+#include "SIMPLib/SIMPLib.h"
+
+#include "SurfaceMeshing/SurfaceMeshingFilters/SurfaceMeshFilter.h"
+
+#include "SurfaceMeshing/SurfaceMeshingDLLExport.h"
+
+/**
+ * @brief The TriangleMetricsFilter class computes any combination of the Triangle areas, normals,
+ * centroids and minimum dihedral angles in a single sweep over the mesh. See [Filter documentation](@ref trianglemetricsfilter) for details.
+ */
+class SurfaceMeshing_EXPORT TriangleMetricsFilter : public SurfaceMeshFilter
+{
+  Q_OBJECT
+    PYB11_CREATE_BINDINGS(TriangleMetricsFilter SUPERCLASS SurfaceMeshFilter)
+    PYB11_PROPERTY(bool ComputeAreas READ getComputeAreas WRITE setComputeAreas)
+    PYB11_PROPERTY(DataArrayPath SurfaceMeshTriangleAreasArrayPath READ getSurfaceMeshTriangleAreasArrayPath WRITE setSurfaceMeshTriangleAreasArrayPath)
+    PYB11_PROPERTY(bool ComputeNormals READ getComputeNormals WRITE setComputeNormals)
+    PYB11_PROPERTY(DataArrayPath SurfaceMeshTriangleNormalsArrayPath READ getSurfaceMeshTriangleNormalsArrayPath WRITE setSurfaceMeshTriangleNormalsArrayPath)
+    PYB11_PROPERTY(bool ComputeCentroids READ getComputeCentroids WRITE setComputeCentroids)
+    PYB11_PROPERTY(DataArrayPath SurfaceMeshTriangleCentroidsArrayPath READ getSurfaceMeshTriangleCentroidsArrayPath WRITE setSurfaceMeshTriangleCentroidsArrayPath)
+    PYB11_PROPERTY(bool ComputeDihedralAngles READ getComputeDihedralAngles WRITE setComputeDihedralAngles)
+    PYB11_PROPERTY(DataArrayPath SurfaceMeshTriangleDihedralAnglesArrayPath READ getSurfaceMeshTriangleDihedralAnglesArrayPath WRITE setSurfaceMeshTriangleDihedralAnglesArrayPath)
+public:
+  SIMPL_SHARED_POINTERS(TriangleMetricsFilter)
+  SIMPL_FILTER_NEW_MACRO(TriangleMetricsFilter)
+  SIMPL_TYPE_MACRO_SUPER_OVERRIDE(TriangleMetricsFilter, SurfaceMeshFilter)
+
+  ~TriangleMetricsFilter() override;
+
+  SIMPL_FILTER_PARAMETER(bool, ComputeAreas)
+  Q_PROPERTY(bool ComputeAreas READ getComputeAreas WRITE setComputeAreas)
+
+  SIMPL_FILTER_PARAMETER(DataArrayPath, SurfaceMeshTriangleAreasArrayPath)
+  Q_PROPERTY(DataArrayPath SurfaceMeshTriangleAreasArrayPath READ getSurfaceMeshTriangleAreasArrayPath WRITE setSurfaceMeshTriangleAreasArrayPath)
+
+  SIMPL_FILTER_PARAMETER(bool, ComputeNormals)
+  Q_PROPERTY(bool ComputeNormals READ getComputeNormals WRITE setComputeNormals)
+
+  SIMPL_FILTER_PARAMETER(DataArrayPath, SurfaceMeshTriangleNormalsArrayPath)
+  Q_PROPERTY(DataArrayPath SurfaceMeshTriangleNormalsArrayPath READ getSurfaceMeshTriangleNormalsArrayPath WRITE setSurfaceMeshTriangleNormalsArrayPath)
+
+  SIMPL_FILTER_PARAMETER(bool, ComputeCentroids)
+  Q_PROPERTY(bool ComputeCentroids READ getComputeCentroids WRITE setComputeCentroids)
+
+  SIMPL_FILTER_PARAMETER(DataArrayPath, SurfaceMeshTriangleCentroidsArrayPath)
+  Q_PROPERTY(DataArrayPath SurfaceMeshTriangleCentroidsArrayPath READ getSurfaceMeshTriangleCentroidsArrayPath WRITE setSurfaceMeshTriangleCentroidsArrayPath)
+
+  SIMPL_FILTER_PARAMETER(bool, ComputeDihedralAngles)
+  Q_PROPERTY(bool ComputeDihedralAngles READ getComputeDihedralAngles WRITE setComputeDihedralAngles)
+
+  SIMPL_FILTER_PARAMETER(DataArrayPath, SurfaceMeshTriangleDihedralAnglesArrayPath)
+  Q_PROPERTY(DataArrayPath SurfaceMeshTriangleDihedralAnglesArrayPath READ getSurfaceMeshTriangleDihedralAnglesArrayPath WRITE setSurfaceMeshTriangleDihedralAnglesArrayPath)
+
+  /**
+   * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
+   */
+  const QString getCompiledLibraryName() const override;
+
+  /**
+   * @brief getBrandingString Returns the branding string for the filter, which is a tag
+   * used to denote the filter's association with specific plugins
+   * @return Branding string
+  */
+  const QString getBrandingString() const override;
+
+  /**
+   * @brief getFilterVersion Returns a version string for this filter. Default
+   * value is an empty string.
+   * @return
+   */
+  const QString getFilterVersion() const override;
+
+  /**
+   * @brief newFilterInstance Reimplemented from @see AbstractFilter class
+   */
+  AbstractFilter::Pointer newFilterInstance(bool copyFilterParameters) const override;
+
+  /**
+   * @brief getGroupName Reimplemented from @see AbstractFilter class
+   */
+  const QString getGroupName() const override;
+
+  /**
+   * @brief getSubGroupName Reimplemented from @see AbstractFilter class
+   */
+  const QString getSubGroupName() const override;
+
+  /**
+   * @brief getUuid Return the unique identifier for this filter.
+   * @return A QUuid object.
+   */
+  const QUuid getUuid() override;
+
+  /**
+   * @brief getHumanLabel Reimplemented from @see AbstractFilter class
+   */
+  const QString getHumanLabel() const override;
+
+  /**
+   * @brief setupFilterParameters Reimplemented from @see AbstractFilter class
+   */
+  void setupFilterParameters() override;
+
+  /**
+   * @brief readFilterParameters Reimplemented from @see AbstractFilter class
+   */
+  void readFilterParameters(AbstractFilterParametersReader* reader, int index) override;
+
+  /**
+   * @brief execute Reimplemented from @see AbstractFilter class
+   */
+  void execute() override;
+
+  /**
+  * @brief preflight Reimplemented from @see AbstractFilter class
+  */
+  void preflight() override;
+
+protected:
+  TriangleMetricsFilter();
+  /**
+   * @brief dataCheck Checks for the appropriate parameter values and availability of arrays
+   */
+  void dataCheck();
+
+  /**
+   * @brief Initializes all the private instance variables.
+   */
+  void initialize();
+
+  /**
+   * @brief getSelectedArrayPaths Returns the paths of the Face arrays that are selected for computing
+   */
+  QVector<DataArrayPath> getSelectedArrayPaths() const;
+
+private:
+  DEFINE_DATAARRAY_VARIABLE(double, SurfaceMeshTriangleAreas)
+  DEFINE_DATAARRAY_VARIABLE(double, SurfaceMeshTriangleNormals)
+  DEFINE_DATAARRAY_VARIABLE(double, SurfaceMeshTriangleCentroids)
+  DEFINE_DATAARRAY_VARIABLE(double, SurfaceMeshTriangleDihedralAngles)
+
+public:
+  TriangleMetricsFilter(const TriangleMetricsFilter&) = delete;            // Copy Constructor Not Implemented
+  TriangleMetricsFilter(TriangleMetricsFilter&&) = delete;                 // Move Constructor Not Implemented
+  TriangleMetricsFilter& operator=(const TriangleMetricsFilter&) = delete; // Copy Assignment Not Implemented
+  TriangleMetricsFilter& operator=(TriangleMetricsFilter&&) = delete;      // Move Assignment Not Implemented
+};
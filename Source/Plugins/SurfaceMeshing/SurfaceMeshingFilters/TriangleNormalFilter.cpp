@@ -40,16 +40,9 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
 
-#include "SurfaceMeshing/SurfaceMeshingFilters/util/TriangleOps.h"
-
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-#include <tbb/blocked_range.h>
-#include <tbb/parallel_for.h>
-#include <tbb/partitioner.h>
-#endif
-
 #include "SurfaceMeshing/SurfaceMeshingConstants.h"
 #include "SurfaceMeshing/SurfaceMeshingVersion.h"
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/TriangleMetrics.h"
 
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
 enum createdPathID : RenameDataPath::DataID_t
@@ -58,58 +51,6 @@ enum createdPathID : RenameDataPath::DataID_t
   DataArrayID31 = 31,
 };
 
-/**
- * @brief The CalculateNormalsImpl class implements a threaded algorithm that computes the normal for
- * each triangle in a set of triangles
- */
-class CalculateNormalsImpl
-{
-  SharedVertexList::Pointer m_Nodes;
-  SharedTriList::Pointer m_Triangles;
-  double* m_Normals;
-
-public:
-  CalculateNormalsImpl(SharedVertexList::Pointer nodes, SharedTriList::Pointer triangles, double* normals)
-  : m_Nodes(nodes)
-  , m_Triangles(triangles)
-  , m_Normals(normals)
-  {
-  }
-  virtual ~CalculateNormalsImpl() = default;
-
-  void generate(size_t start, size_t end) const
-  {
-    float* nodes = m_Nodes->getPointer(0);
-    int64_t* triangles = m_Triangles->getPointer(0);
-    int64_t nIdx0 = 0, nIdx1 = 0, nIdx2 = 0;
-    for(size_t i = start; i < end; i++)
-    {
-      nIdx0 = triangles[i * 3] * 3;
-      nIdx1 = triangles[i * 3 + 1] * 3;
-      nIdx2 = triangles[i * 3 + 2] * 3;
-      float* n0 = &(nodes[nIdx0]);
-      float* n1 = &(nodes[nIdx1]);
-      float* n2 = &(nodes[nIdx2]);
-
-      VectorType normal = TriangleOps::computeNormal(n0, n1, n2);
-      m_Normals[i * 3 + 0] = normal.x;
-      m_Normals[i * 3 + 1] = normal.y;
-      m_Normals[i * 3 + 2] = normal.z;
-    }
-  }
-
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  /**
-   * @brief operator () This is called from the TBB stye of code
-   * @param r The range to compute the values
-   */
-  void operator()(const tbb::blocked_range<size_t>& r) const
-  {
-    generate(r.begin(), r.end());
-  }
-#endif
-};
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -217,24 +158,9 @@ void TriangleNormalFilter::execute()
 
   TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  bool doParallel = true;
-#endif
-
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  if(doParallel)
-  {
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, triangleGeom->getNumberOfTris()), CalculateNormalsImpl(triangleGeom->getVertices(), triangleGeom->getTriangles(), m_SurfaceMeshTriangleNormals),
-                      tbb::auto_partitioner());
-  }
-  else
-#endif
-  {
-    CalculateNormalsImpl serial(triangleGeom->getVertices(), triangleGeom->getTriangles(), m_SurfaceMeshTriangleNormals);
-    serial.generate(0, triangleGeom->getNumberOfTris());
-  }
-
-
+  TriangleMetrics::Outputs outputs;
+  outputs.normals = m_SurfaceMeshTriangleNormals;
+  TriangleMetrics::compute(triangleGeom->getVertexPointer(0), triangleGeom->getTriPointer(0), triangleGeom->getNumberOfTris(), outputs);
 }
 // -----------------------------------------------------------------------------
 //
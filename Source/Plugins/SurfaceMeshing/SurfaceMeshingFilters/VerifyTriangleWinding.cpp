@@ -35,211 +35,281 @@
 
 #include "VerifyTriangleWinding.h"
 
-#include <QtCore/QString>
-#include <deque>
-#include <iostream>
+#include <algorithm>
 #include <limits>
-#include <queue>
-
-#ifdef _MSC_VER
-#include <hash_set>
-// using namespace stdext;
-#define STDEXT stdext
-#else
-#include <ext/hash_set>
-// using namespace __gnu_cxx;
-#define STDEXT __gnu_cxx
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
 #endif
 
+#include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
-#include "SIMPLib/Math/MatrixMath.h"
-#include "SurfaceMeshing/SurfaceMeshingFilters/ReverseTriangleWinding.h"
-#include "SurfaceMeshing/SurfaceMeshingFilters/util/Plane.h"
-#include "SurfaceMeshing/SurfaceMeshingFilters/util/TriangleOps.h"
-#include "SurfaceMeshing/SurfaceMeshingFilters/util/Vector3.h"
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-class Mesh
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/GeometryConnectivity.h"
+
+namespace
 {
-public:
-  SIMPL_SHARED_POINTERS(Mesh)
-  SIMPL_STATIC_NEW_MACRO(Mesh)
-  virtual ~Mesh()
-  {
-  }
-  int getMaxLabel()
-  {
-    return -1;
-  }
-  int getMinLabel()
-  {
-    return -1;
-  }
-  void setMaxLabel(int32_t l)
+/**
+ * @brief Each triangle has two sides, one for each of its Face Labels. The side of triangle t that
+ * faces label labels[2t + k] is stored at index 2t + k of the flat per side arrays, so every entry
+ * is owned by exactly one label and the labels can be visited concurrently without locking.
+ */
+const uint8_t k_Visited = 0x01;
+const uint8_t k_Flipped = 0x02;
+
+/**
+ * @brief findSharedEdge Finds the edge shared by two triangles
+ * @return false if the triangles share less than two vertices
+ */
+inline bool findSharedEdge(const int64_t* tri, const int64_t* other, int64_t edge[2])
+{
+  int32_t count = 0;
+  for(int32_t i = 0; i < 3 && count < 2; i++)
   {
-    m_MaxLabel = l;
+    if(tri[i] == other[0] || tri[i] == other[1] || tri[i] == other[2])
+    {
+      edge[count++] = tri[i];
+    }
   }
-  void setMinLabel(int32_t l)
+  return count == 2;
+}
+
+/**
+ * @brief followsInWinding Returns 1 if vertex b directly follows vertex a in the winding of the triangle
+ */
+inline uint8_t followsInWinding(const int64_t* tri, int64_t a, int64_t b)
+{
+  for(int32_t i = 0; i < 3; i++)
   {
-    m_MinLabel = l;
+    if(tri[i] == a)
+    {
+      return tri[(i + 1) % 3] == b ? 1 : 0;
+    }
   }
-  void incrementMaxLabel()
-  {
-    m_MaxLabel++;
+  return 0;
+}
+
+/**
+ * @brief The LabelFloodImpl class floods the triangles of a range of labels. Starting from a seed,
+ * every triangle reached across an edge of the same label is marked with whether it has to be
+ * flipped to wind consistently with the seed; each connected patch of a label gets its own local
+ * component number. Triangles reached twice with different answers are counted as conflicts.
+ */
+class LabelFloodImpl
+{
+public:
+  LabelFloodImpl(const int64_t* triangles, const int32_t* faceLabels, ElementDynamicList::Pointer neighbors, int32_t minLabel, const std::vector<size_t>& labelOffsets,
+                 const std::vector<int64_t>& labelSides, std::vector<uint8_t>& sideState, std::vector<int32_t>& sideComponent, std::vector<int32_t>& componentCounts,
+                 std::vector<int32_t>& conflictCounts)
+  : m_Triangles(triangles)
+  , m_FaceLabels(faceLabels)
+  , m_Neighbors(neighbors)
+  , m_MinLabel(minLabel)
+  , m_LabelOffsets(labelOffsets)
+  , m_LabelSides(labelSides)
+  , m_SideState(sideState)
+  , m_SideComponent(sideComponent)
+  , m_ComponentCounts(componentCounts)
+  , m_ConflictCounts(conflictCounts)
+  {
+  }
+  virtual ~LabelFloodImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    std::vector<int64_t> frontier;
+    for(size_t l = start; l < end; l++)
+    {
+      int32_t label = m_MinLabel + static_cast<int32_t>(l);
+      int32_t components = 0;
+      int32_t conflicts = 0;
+      for(size_t i = m_LabelOffsets[l]; i < m_LabelOffsets[l + 1]; i++)
+      {
+        int64_t seed = m_LabelSides[i];
+        if((m_SideState[seed] & k_Visited) != 0)
+        {
+          continue;
+        }
+        int32_t component = components++;
+        m_SideState[seed] = k_Visited;
+        m_SideComponent[seed] = component;
+        frontier.assign(1, seed);
+        while(!frontier.empty())
+        {
+          int64_t side = frontier.back();
+          frontier.pop_back();
+          int64_t t = side / 2;
+          const int64_t* tri = m_Triangles + t * 3;
+          // Direction in which this side walks the shared edge: stored winding, reversed for the
+          // second label and for a pending flip
+          uint8_t sideBits = static_cast<uint8_t>(side & 1) ^ ((m_SideState[side] & k_Flipped) != 0 ? 1 : 0);
+
+          uint16_t numNeighbors = m_Neighbors->getNumberOfElements(t);
+          int64_t* neighbors = m_Neighbors->getElementListPointer(t);
+          for(uint16_t n = 0; n < numNeighbors; n++)
+          {
+            int64_t other = neighbors[n];
+            const int32_t* otherLabels = m_FaceLabels + other * 2;
+            if(otherLabels[0] == otherLabels[1])
+            {
+              continue;
+            }
+            int64_t otherSide = 0;
+            if(otherLabels[0] == label)
+            {
+              otherSide = other * 2;
+            }
+            else if(otherLabels[1] == label)
+            {
+              otherSide = other * 2 + 1;
+            }
+            else
+            {
+              continue;
+            }
+            const int64_t* otherTri = m_Triangles + other * 3;
+            int64_t edge[2] = {0, 0};
+            if(!findSharedEdge(tri, otherTri, edge))
+            {
+              continue;
+            }
+            // The two sides have to walk their shared edge in opposite directions
+            uint8_t forward = followsInWinding(tri, edge[0], edge[1]) ^ sideBits;
+            uint8_t otherForward = followsInWinding(otherTri, edge[0], edge[1]) ^ static_cast<uint8_t>(otherSide & 1);
+            uint8_t flip = otherForward ^ forward ^ 1;
+            if((m_SideState[otherSide] & k_Visited) != 0)
+            {
+              if(((m_SideState[otherSide] & k_Flipped) != 0 ? 1 : 0) != flip)
+              {
+                conflicts++;
+              }
+              continue;
+            }
+            m_SideState[otherSide] = static_cast<uint8_t>(k_Visited | (flip != 0 ? k_Flipped : 0));
+            m_SideComponent[otherSide] = component;
+            frontier.push_back(otherSide);
+          }
+        }
+      }
+      m_ComponentCounts[l] = components;
+      m_ConflictCounts[l] = conflicts;
+    }
   }
 
-protected:
-  Mesh()
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
   {
+    convert(r.begin(), r.end());
   }
+#endif
 
 private:
+  const int64_t* m_Triangles;
+  const int32_t* m_FaceLabels;
+  ElementDynamicList::Pointer m_Neighbors;
   int32_t m_MinLabel;
-  int32_t m_MaxLabel;
-
-  Mesh(const Mesh&);           // Copy Constructor Not Implemented
-  void operator=(const Mesh&); // Operator '=' Not Implemented
+  const std::vector<size_t>& m_LabelOffsets;
+  const std::vector<int64_t>& m_LabelSides;
+  std::vector<uint8_t>& m_SideState;
+  std::vector<int32_t>& m_SideComponent;
+  std::vector<int32_t>& m_ComponentCounts;
+  std::vector<int32_t>& m_ConflictCounts;
 };
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-class LabelVisitorInfo
+/**
+ * @brief The ApplyWindingImpl class flips every triangle whose first side ended up flipped once
+ * the orientation of its component is taken into account
+ */
+class ApplyWindingImpl
 {
 public:
-  //   typedef Mesh<int32_t>::Pointer                MeshPtrType;
-  typedef FaceArray::Face_t FaceType;
-  typedef QVector<int32_t> FaceListType;
-
-  SIMPL_SHARED_POINTERS(LabelVisitorInfo)
-  static Pointer New(int32_t label, size_t tIndex)
+  ApplyWindingImpl(int64_t* triangles, const int32_t* faceLabels, int32_t minLabel, const std::vector<int32_t>& componentOffsets, const std::vector<uint8_t>& sideState,
+                   const std::vector<int32_t>& sideComponent, const std::vector<uint8_t>& componentFlips)
+  : m_Triangles(triangles)
+  , m_FaceLabels(faceLabels)
+  , m_MinLabel(minLabel)
+  , m_ComponentOffsets(componentOffsets)
+  , m_SideState(sideState)
+  , m_SideComponent(sideComponent)
+  , m_ComponentFlips(componentFlips)
   {
-    Pointer sharedPtr(new LabelVisitorInfo(label, tIndex));
-    return sharedPtr;
   }
+  virtual ~ApplyWindingImpl() = default;
 
-  virtual ~LabelVisitorInfo()
+  void convert(size_t start, size_t end) const
   {
-  }
-
-private:
-  int32_t m_Label;
-
-public:
-  int32_t getLabel()
-  {
-    if(m_Relabeled)
+    for(size_t t = start; t < end; t++)
     {
-      return m_NewLabel;
-    }
-    return m_Label;
-  }
-
-  SIMPL_INSTANCE_PROPERTY(size_t, StartIndex)
-  SIMPL_INSTANCE_PROPERTY(bool, Primed)
-  SIMPL_INSTANCE_PROPERTY(int32_t, NewLabel)
-  SIMPL_INSTANCE_PROPERTY(bool, Relabeled)
-
-  QSet<int32_t> m_Faces;
-  QSet<int32_t> m_OriginalFaceList;
-
-  /**
-  *
-  * @param mesh
-  * @param masterVisited
-  * @return
-  */
-  Pointer relabelFaces(Mesh::Pointer mesh, DataArray<int32_t>::Pointer masterFaceListPtr, const QVector<bool>& masterVisited)
-  {
-    size_t triangleIndex = *(m_Faces.begin());
-    int32_t newLabel = mesh->getMaxLabel() + 1;
-    mesh->incrementMaxLabel();
-    int32_t* masterFaceList = masterFaceListPtr->getPointer(0);
-    LabelVisitorInfo::Pointer p = LabelVisitorInfo::New(m_Label, triangleIndex);
-
-    p->setPrimed(false);
-    p->setNewLabel(newLabel);
-    p->setRelabeled(true);
-    p->m_Faces = m_Faces;            // This will make a copy of the current set of triangles
-    p->m_OriginalFaceList = m_Faces; // Make a copy that does NOT get updated
-    bool seedIsSet = false;
-    for(QSet<int32_t>::iterator triIter = p->m_Faces.begin(); triIter != p->m_Faces.end(); ++triIter)
-    {
-      if(masterFaceList[(*triIter) * 2] == m_Label)
-      {
-        masterFaceList[(*triIter) * 2] = newLabel;
-      }
-      if(masterFaceList[(*triIter) * 2 + 1] == m_Label)
+      size_t side = t * 2;
+      if((m_SideState[side] & k_Visited) == 0)
       {
-        masterFaceList[(*triIter) * 2 + 1] = newLabel;
+        continue;
       }
-      if(masterVisited[*triIter])
+      size_t l = static_cast<size_t>(m_FaceLabels[side] - m_MinLabel);
+      uint8_t flip = ((m_SideState[side] & k_Flipped) != 0 ? 1 : 0) ^ m_ComponentFlips[m_ComponentOffsets[l] + m_SideComponent[side]];
+      if(flip != 0)
       {
-        p->setStartIndex(*triIter);
-        seedIsSet = true;
-      }
-    }
-    if(seedIsSet)
-    {
-      p->setPrimed(true);
-    }
-
-    return p;
-  }
-
-  /**
-   *
-   * @param mesh
-   */
-  void revertFaceLabels(DataArray<int32_t>::Pointer masterFaceListPtr)
-  {
-    int32_t* masterFaceList = masterFaceListPtr->getPointer(0);
-
-    if(m_Relabeled == true)
-    {
-      //  qDebug() << "    Reverting Label " << m_NewLabel << " To " << m_Label << "\n";
-      for(QSet<int32_t>::iterator triIter = m_OriginalFaceList.begin(); triIter != m_OriginalFaceList.end(); ++triIter)
-      {
-        if(masterFaceList[(*triIter) * 2] == m_NewLabel)
-        {
-          masterFaceList[(*triIter) * 2] = m_Label;
-        }
-        if(masterFaceList[(*triIter) * 2 + 1] == m_NewLabel)
-        {
-          masterFaceList[(*triIter) * 2 + 1] = m_Label;
-        }
+        int64_t* tri = m_Triangles + t * 3;
+        std::swap(tri[0], tri[2]);
       }
-      m_Relabeled = false;
-      m_NewLabel = m_Label;
-      m_Primed = false;
     }
   }
 
-protected:
-  LabelVisitorInfo(int32_t label, size_t tIndex)
-  : m_Label(label)
-  , m_StartIndex(tIndex)
-  , m_Primed(false)
-  , m_NewLabel(label)
-  , m_Relabeled(false)
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
   {
+    convert(r.begin(), r.end());
   }
+#endif
 
 private:
-  LabelVisitorInfo(const LabelVisitorInfo&); // Copy Constructor Not Implemented
-  void operator=(const LabelVisitorInfo&);   // Operator '=' Not Implemented
+  int64_t* m_Triangles;
+  const int32_t* m_FaceLabels;
+  int32_t m_MinLabel;
+  const std::vector<int32_t>& m_ComponentOffsets;
+  const std::vector<uint8_t>& m_SideState;
+  const std::vector<int32_t>& m_SideComponent;
+  const std::vector<uint8_t>& m_ComponentFlips;
 };
 
+/**
+ * @brief findComponentRoot Returns the root of a component in the union find forest, together with
+ * the parity of the component relative to that root, compressing the path on the way
+ */
+int32_t findComponentRoot(std::vector<int32_t>& parents, std::vector<uint8_t>& parities, int32_t c, uint8_t& parity)
+{
+  int32_t root = c;
+  parity = 0;
+  while(parents[root] != root)
+  {
+    parity ^= parities[root];
+    root = parents[root];
+  }
+  uint8_t remaining = parity;
+  while(parents[c] != root && c != root)
+  {
+    int32_t next = parents[c];
+    uint8_t step = parities[c];
+    parents[c] = root;
+    parities[c] = remaining;
+    remaining ^= step;
+    c = next;
+  }
+  return root;
+}
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 VerifyTriangleWinding::VerifyTriangleWinding()
-: m_SurfaceDataContainerName(SIMPL::Defaults::DataContainerName)
-, m_SurfaceMeshNodeFacesArrayName(SIMPL::VertexData::SurfaceMeshNodeFaces)
-, m_SurfaceMeshFaceLabelsArrayPath(SIMPL::Defaults::DataContainerName, SIMPL::Defaults::FaceAttributeMatrixName, SIMPL::FaceData::SurfaceMeshFaceLabels)
-, m_SurfaceMeshFaceLabelsArrayName(SIMPL::FaceData::SurfaceMeshFaceLabels)
+: m_SurfaceMeshFaceLabelsArrayPath(SIMPL::Defaults::TriangleDataContainerName, SIMPL::Defaults::FaceAttributeMatrixName, SIMPL::FaceData::SurfaceMeshFaceLabels)
 , m_SurfaceMeshFaceLabels(nullptr)
 {
 }
@@ -257,10 +327,12 @@ void VerifyTriangleWinding::setupFilterParameters()
   SurfaceMeshFilter::setupFilterParameters();
   FilterParameterVectorType parameters;
 
-  parameters.push_back(SeparatorFilterParameter::New("Required Information", FilterParameter::Uncategorized));
-  parameters.push_back(DataArraySelectionFilterParameter::New("SurfaceMeshFaceLabels", "SurfaceMeshFaceLabelsArrayPath", getSurfaceMeshFaceLabelsArrayPath(), FilterParameter::Uncategorized,
-                                                              SIMPL_BIND_SETTER(VerifyTriangleWinding, this, SurfaceMeshFaceLabelsArrayPath),
-                                                              SIMPL_BIND_GETTER(VerifyTriangleWinding, this, SurfaceMeshFaceLabelsArrayPath)));
+  parameters.push_back(SeparatorFilterParameter::New("Face Data", FilterParameter::RequiredArray));
+  {
+    DataArraySelectionFilterParameter::RequirementType req =
+        DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Int32, 2, AttributeMatrix::Type::Face, IGeometry::Type::Triangle);
+    parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Face Labels", SurfaceMeshFaceLabelsArrayPath, FilterParameter::RequiredArray, VerifyTriangleWinding, req));
+  }
   setFilterParameters(parameters);
 }
 
@@ -287,7 +359,7 @@ void VerifyTriangleWinding::initialize()
 void VerifyTriangleWinding::dataCheck()
 {
   DataContainer::Pointer sm = getDataContainerArray()->getPrereqDataContainer(this, getSurfaceMeshFaceLabelsArrayPath().getDataContainerName(), false);
-  if(getErrorCondition() < 0)
+  if(getErrorCode() < 0)
   {
     return;
   }
@@ -341,11 +413,6 @@ void VerifyTriangleWinding::preflight()
   dataCheck();
   emit preflightExecuted();
   setInPreflight(false);
-
-  /* *** THIS FILTER NEEDS TO BE CHECKED *** */
-  QString ss = QObject::tr("Filter is NOT updated for IGeometry Redesign. A Programmer needs to check this filter. Please report this to the DREAM3D developers.");
-  setErrorCondition(0xABABABAB, ss);
-  /* *** THIS FILTER NEEDS TO BE CHECKED *** */
 }
 
 // -----------------------------------------------------------------------------
@@ -356,447 +423,244 @@ void VerifyTriangleWinding::execute()
   clearErrorCode();
   clearWarningCode();
   dataCheck();
-  if(getErrorCondition() < 0)
+  if(getErrorCode() < 0)
   {
     return;
   }
 
   DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(getSurfaceMeshFaceLabelsArrayPath().getDataContainerName());
+  TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
 
-  FaceArray::Pointer facesPtr = sm->getFaces();
-
-  notifyStatusMessage("Generating Face List for each Node");
-  // Make sure the Face Connectivity is created because the FindNRing algorithm needs this and will
-  // assert if the data is NOT in the SurfaceMesh Data Container
-  if(nullptr == facesPtr->getFacesContainingVert())
-  {
-    facesPtr->findFacesContainingVert();
-  }
-  if(getCancel())
+  notifyStatusMessage("Generating Face Neighbor Lists");
+  // The neighbor lists are the edge to triangle adjacency shared by the flood of every label
+  if(nullptr == triangleGeom->getElementNeighbors().get() && GeometryConnectivity::findElementNeighbors(triangleGeom) < 0)
   {
+    QString ss = QObject::tr("Error generating the triangle neighbor lists for Geometry type %1").arg(triangleGeom->getGeometryTypeAsString());
+    setErrorCondition(-388, ss);
     return;
   }
-  if(nullptr == facesPtr->getFaceNeighbors())
-  {
-    facesPtr->findFaceNeighbors();
-  }
   if(getCancel())
   {
     return;
   }
-  if(facesPtr->getUniqueEdges() == nullptr)
-  {
-    facesPtr->generateUniqueEdgeIds();
-  }
 
   // Execute the actual verification step.
   notifyStatusMessage("Generating Connectivity Complete. Starting Analysis");
   verifyTriangleWinding();
-
-
 }
 
 // -----------------------------------------------------------------------------
-// Groups the triangles according to which Feature they are a part of
+//
 // -----------------------------------------------------------------------------
-void VerifyTriangleWinding::getLabelTriangelMap(LabelFaceMap_t& trianglesToLabelMap)
+int VerifyTriangleWinding::verifyTriangleWinding()
 {
   DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(getSurfaceMeshFaceLabelsArrayPath().getDataContainerName());
-  FaceArray::Pointer masterFaceList = sm->getFaces();
-  if(nullptr == masterFaceList.get())
+  TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
+  int64_t* triangles = triangleGeom->getTriPointer(0);
+  size_t numTris = triangleGeom->getNumberOfTris();
+  ElementDynamicList::Pointer neighbors = triangleGeom->getElementNeighbors();
+  if(numTris == 0)
   {
-    setErrorCondition(-556, "The SurfaceMesh DataContainer Does NOT contain Faces");
-    return;
+    return 0;
   }
 
-  int ntri = masterFaceList->getNumberOfTuples();
-  // FaceArray::Face_t* triangles = masterFaceList->getPointer(0);
-
-  // Loop over all the triangles and group them according to which feature/region they are a part of
-  for(int t = 0; t < ntri; ++t)
+  // Group the sides of the triangles by label with a counting sort. Triangles that carry the same
+  // label on both sides do not separate anything and are left alone.
+  int32_t minLabel = std::numeric_limits<int32_t>::max();
+  int32_t maxLabel = std::numeric_limits<int32_t>::lowest();
+  for(size_t i = 0; i < numTris * 2; i++)
   {
-    int32_t* label = m_SurfaceMeshFaceLabels + t * 2;
-    trianglesToLabelMap[label[0]].insert(t);
-    trianglesToLabelMap[label[1]].insert(t);
+    minLabel = std::min(minLabel, m_SurfaceMeshFaceLabels[i]);
+    maxLabel = std::max(maxLabel, m_SurfaceMeshFaceLabels[i]);
   }
-}
+  size_t numLabels = static_cast<size_t>(static_cast<int64_t>(maxLabel) - minLabel + 1);
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-int32_t VerifyTriangleWinding::getSeedTriangle(int32_t label, QSet<int32_t>& triangleIndices)
-{
-  DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(getSurfaceMeshFaceLabelsArrayPath().getDataContainerName());
-
-  VertexArray::Vert_t* verts = sm->getVertices()->getPointer(0);
-  FaceArray::Face_t* triangles = sm->getFaces()->getPointer(0);
-
-  float xMax = std::numeric_limits<float>::min();
-  float avgX = 0.0f;
-  int32_t seedFaceIdx = 0;
-
-  for(QSet<int32_t>::iterator iter = triangleIndices.begin(); iter != triangleIndices.end(); ++iter)
+  std::vector<size_t> labelOffsets(numLabels + 1, 0);
+  for(size_t t = 0; t < numTris; t++)
   {
-    int32_t i = *iter;
-    avgX = (verts[triangles[i].verts[0]].pos[0] + verts[triangles[i].verts[1]].pos[0] + verts[triangles[i].verts[2]].pos[0]) / 3.0;
-    if(avgX > xMax)
+    const int32_t* labels = m_SurfaceMeshFaceLabels + t * 2;
+    if(labels[0] != labels[1])
     {
-      xMax = avgX;
-      seedFaceIdx = i;
+      labelOffsets[labels[0] - minLabel + 1]++;
+      labelOffsets[labels[1] - minLabel + 1]++;
     }
   }
-  // Now we have the "right most" triangle based on x component of the centroid of the triangles for this label.
-  // Lets now figure out if the normal points generally in the positive or negative X direction.
-
-  int32_t* faceLabel = m_SurfaceMeshFaceLabels + seedFaceIdx * 2;
-  VectorType normal;
-  if(faceLabel[0] == label)
+  for(size_t l = 0; l < numLabels; l++)
   {
-    normal = TriangleOps::computeNormal(verts[triangles[seedFaceIdx].verts[0]], verts[triangles[seedFaceIdx].verts[1]], verts[triangles[seedFaceIdx].verts[2]]);
+    labelOffsets[l + 1] += labelOffsets[l];
   }
-  else
+  std::vector<int64_t> labelSides(labelOffsets[numLabels]);
   {
-    normal = TriangleOps::computeNormal(verts[triangles[seedFaceIdx].verts[2]], verts[triangles[seedFaceIdx].verts[1]], verts[triangles[seedFaceIdx].verts[0]]);
+    std::vector<size_t> cursor(labelOffsets.begin(), labelOffsets.end() - 1);
+    for(size_t t = 0; t < numTris; t++)
+    {
+      const int32_t* labels = m_SurfaceMeshFaceLabels + t * 2;
+      if(labels[0] != labels[1])
+      {
+        labelSides[cursor[labels[0] - minLabel]++] = static_cast<int64_t>(t * 2);
+        labelSides[cursor[labels[1] - minLabel]++] = static_cast<int64_t>(t * 2 + 1);
+      }
+    }
   }
 
-  if(normal.x < 0.0f)
+  // Flood every label on its own; each task only touches the sides of its own labels
+  notifyStatusMessage("Checking the winding of each Feature");
+  std::vector<uint8_t> sideState(numTris * 2, 0);
+  std::vector<int32_t> sideComponent(numTris * 2, 0);
+  std::vector<int32_t> componentCounts(numLabels, 0);
+  std::vector<int32_t> conflictCounts(numLabels, 0);
   {
-    ReverseTriangleWinding::Pointer reverse = ReverseTriangleWinding::New();
-    reverse->setDataContainerArray(getDataContainerArray());
-    connect(reverse.get(), SIGNAL(filterGeneratedMessage(const PipelineMessage&)), this, SLOT(broadcastPipelineMessage(const PipelineMessage&)));
-    reverse->setMessagePrefix(getMessagePrefix());
-    reverse->execute();
-    if(reverse->getErrorCondition() < 0)
-    {
-      setErrorCondition(reverse->getErrorCondition(), "Error Reversing the Face Winding");
-      return -1;
-    }
-    if(faceLabel[0] == label)
+    LabelFloodImpl body(triangles, m_SurfaceMeshFaceLabels, neighbors, minLabel, labelOffsets, labelSides, sideState, sideComponent, componentCounts, conflictCounts);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    tbb::task_scheduler_init init;
+    bool doParallel = true;
+    if(doParallel)
     {
-      normal = TriangleOps::computeNormal(verts[triangles[seedFaceIdx].verts[0]], verts[triangles[seedFaceIdx].verts[1]], verts[triangles[seedFaceIdx].verts[2]]);
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numLabels), body, tbb::auto_partitioner());
     }
     else
+#endif
     {
-      normal = TriangleOps::computeNormal(verts[triangles[seedFaceIdx].verts[2]], verts[triangles[seedFaceIdx].verts[1]], verts[triangles[seedFaceIdx].verts[0]]);
-    }
-    if(normal.x < 0.0f)
-    {
-      setErrorCondition(-802, "Error After attempted triangle winding reversal. Face normal is still oriented in wrong direction.");
-      seedFaceIdx = -1;
+      body.convert(0, numLabels);
     }
   }
-
-  return seedFaceIdx;
-}
-
-#define PRINT_FACE(index, triangles)                                                                                                                                                                   \
-  qDebug() << " " << triangles[index].verts[0] << " " << triangles[index].verts[1] << " " << triangles[index].verts[2] << "\n";                                                                        \
-  qDebug() << "Face ID: " << index << "\n";                                                                                                                                                            \
-  qDebug() << "Face.labels[0] " << triangles[index].labels[0] << "\n";                                                                                                                                 \
-  qDebug() << "Face.labels[1] " << triangles[index].labels[1] << "\n";
-
-#define PRINT_VERT(index) qDebug() << index << " " << verts[index].pos[0] << " " << verts[index].pos[1] << " " << verts[index].pos[2] << "\n";
-
-#define PRINT_NORMAL(i, nodes, triangles)                                                                                                                                                              \
-  {                                                                                                                                                                                                    \
-    VectorType normal = TriangleOps::computeNormal(nodes[triangles[i].verts[0]], nodes[triangles[i].verts[1]], nodes[triangles[i].verts[2]]);                                                          \
-    qDebug() << normal.x << " " << normal.y << " " << normal.z << "\n";                                                                                                                                \
+  if(getCancel())
+  {
+    return -1;
   }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-int VerifyTriangleWinding::verifyTriangleWinding()
-{
-  int err = 0;
-  //  qDebug() << "--------------------------------------------------------------" << "\n";
-  //  FaceListType& masterFaceList = *(mesh->triangles());  // Create a reference variable for better syntax
-  //  NodeVector&       masterNodeList = *(mesh->nodes());
-
-  DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(getSurfaceMeshFaceLabelsArrayPath().getDataContainerName());
-  // get the triangle definitions - use the pointer to the start of the Struct Array
-  FaceArray::Pointer masterFaceList = sm->getFaces();
-  if(nullptr == masterFaceList.get())
+  std::vector<int32_t> componentOffsets(numLabels + 1, 0);
+  int64_t numConflicts = 0;
+  for(size_t l = 0; l < numLabels; l++)
   {
-    setErrorCondition(-556, "The SurfaceMesh DataContainer Does NOT contain Faces");
-    return getErrorCondition();
+    componentOffsets[l + 1] = componentOffsets[l] + componentCounts[l];
+    numConflicts += conflictCounts[l];
   }
-  FaceArray::Face_t* triangles = masterFaceList->getPointer(0);
-
-  int numFaces = masterFaceList->getNumberOfTuples();
+  int32_t numComponents = componentOffsets[numLabels];
 
-  VertexArray::Pointer masterNodeListPtr = sm->getVertices();
-  if(nullptr == masterNodeListPtr.get())
+  // Both sides of a triangle have to agree on whether it is flipped, which ties the orientation of
+  // the two components it joins together. Collect these ties with a union find that keeps the
+  // parity of every component relative to its root.
+  notifyStatusMessage("Reconciling the winding between Features");
+  std::vector<int32_t> parents(numComponents);
+  std::vector<uint8_t> parities(numComponents, 0);
+  for(int32_t c = 0; c < numComponents; c++)
   {
-    setErrorCondition(-555, "The SurfaceMesh DataContainer Does NOT contain Nodes");
-    return getErrorCondition();
+    parents[c] = c;
   }
-
-  Mesh::Pointer mesh = Mesh::New();
-  int min = std::numeric_limits<int32_t>::max();
-  int max = std::numeric_limits<int32_t>::min();
-  // Set the min and Max labels in the Mesh class;
-  for(int n = 0; n < numFaces; ++n)
+  for(size_t t = 0; t < numTris; t++)
   {
-    int l = m_SurfaceMeshFaceLabels[n * 2];
-    if(l < min)
-    {
-      min = l;
-    }
-    if(l > max)
+    const int32_t* labels = m_SurfaceMeshFaceLabels + t * 2;
+    if(labels[0] == labels[1])
     {
-      max = l;
+      continue;
     }
-    l = m_SurfaceMeshFaceLabels[n * 2 + 1];
-    if(l < min)
+    int32_t c0 = componentOffsets[labels[0] - minLabel] + sideComponent[t * 2];
+    int32_t c1 = componentOffsets[labels[1] - minLabel] + sideComponent[t * 2 + 1];
+    uint8_t tie = ((sideState[t * 2] ^ sideState[t * 2 + 1]) & k_Flipped) != 0 ? 1 : 0;
+    uint8_t p0 = 0;
+    uint8_t p1 = 0;
+    int32_t r0 = findComponentRoot(parents, parities, c0, p0);
+    int32_t r1 = findComponentRoot(parents, parities, c1, p1);
+    if(r0 == r1)
     {
-      min = l;
-    }
-    if(l > max)
-    {
-      max = l;
-    }
-  }
-  mesh->setMaxLabel(max);
-  mesh->setMinLabel(min);
-
-  // Get a grouping of triangles by feature ID
-  LabelFaceMap_t trianglesToLabelMap;
-  getLabelTriangelMap(trianglesToLabelMap);
-  //  for(LabelFaceMap_t::iterator iter = trianglesToLabelMap.begin(); iter != trianglesToLabelMap.end(); ++iter)
-  //  {
-  //    qDebug() << "Feature: " << iter.key() << "   Face Count: " << iter.value().size() << "\n";
-  //  }
-
-  int32_t currentLabel = 0;
-
-  // Find the first Non Zero Feature Id (Label). This is going to be our starting feature.
-  for(LabelFaceMap_t::iterator iter = trianglesToLabelMap.begin(); iter != trianglesToLabelMap.end(); ++iter)
-  {
-    if(iter.key() > 0)
-    {
-      currentLabel = iter.key();
-      break;
+      if((p0 ^ p1) != tie)
+      {
+        numConflicts++;
+      }
+      continue;
     }
+    parents[r1] = r0;
+    parities[r1] = p0 ^ p1 ^ tie;
   }
-
-  std::deque<LabelVisitorInfo::Pointer> labelObjectsToVisit;
-
-  // Keeps a list of all the triangles that have been visited.
-  QVector<bool> masterVisited(masterFaceList->getNumberOfTuples(), false);
-
-  STDEXT::hash_set<int32_t> labelsVisitedSet;
-  STDEXT::hash_set<int32_t> labelsToVisitSet;
-  int32_t triIndex = 0;
-
-  bool firstLabel = false;
-
-  // Get the first triangle in the list
-  // FaceArray::Face_t& triangle = triangles[triIndex];
-
-  // Now that we have the starting Feature, lets try and get a seed triangle that is oriented in the proper direction.
-  /* Make sure the winding is correct on the first triangle of the first label that will be checked. */
-  triIndex = getSeedTriangle(currentLabel, trianglesToLabelMap[currentLabel]);
-  if(getErrorCondition() < 0 || triIndex < 0)
+  if(getCancel())
   {
     return -1;
   }
 
-  LabelVisitorInfo::Pointer ldo = LabelVisitorInfo::New(currentLabel, triIndex);
-  labelObjectsToVisit.push_back(ldo);
-  LabelVisitorInfo::Pointer curLdo = LabelVisitorInfo::NullPointer();
-  labelsToVisitSet.insert(currentLabel);
-
-  float total = (float)(trianglesToLabelMap.size());
-  float curPercent = 0.0;
-  int progressIndex = 0;
-
-  // Start looping on all the Face Labels (Feature Ids) values
-  while(labelObjectsToVisit.empty() == false)
+  // Every connected set of components is oriented by its component with the lowest positive label:
+  // the triangle of that component with the right most centroid must have a normal pointing in the
+  // positive X direction, as seen from the label.
+  const uint8_t k_Unset = 2;
+  std::vector<uint8_t> rootFlips(numComponents, k_Unset);
+  std::vector<float> bestX;
+  std::vector<int64_t> bestSide;
+  for(size_t l = 0; l < numLabels; l++)
   {
-    if(getCancel())
+    int32_t label = minLabel + static_cast<int32_t>(l);
+    if(label <= 0 || componentCounts[l] == 0)
     {
-      return -1;
+      continue;
     }
-    if((progressIndex / total * 100.0f) > (curPercent))
+    bestX.assign(componentCounts[l], std::numeric_limits<float>::lowest());
+    bestSide.assign(componentCounts[l], -1);
+    for(size_t i = labelOffsets[l]; i < labelOffsets[l + 1]; i++)
     {
-      QString ss = QObject::tr("%1% Complete").arg(static_cast<int>(progressIndex / total * 100.0f));
-      notifyStatusMessage(ss);
-      curPercent += 5.0f;
-    }
-    ++progressIndex;
-
-    QMap<int32_t, int32_t> neighborlabels;
-
-    curLdo = labelObjectsToVisit.front();
-    labelObjectsToVisit.pop_front();
-    currentLabel = curLdo->getLabel();
-    labelsToVisitSet.erase(currentLabel);
-    labelsVisitedSet.insert(currentLabel);
-    if(curLdo->getPrimed() == false && curLdo->getRelabeled() == false)
-    {
-      curLdo->m_Faces = trianglesToLabelMap[currentLabel];
-      curLdo->setPrimed(true);
-    }
-    else if(curLdo->getPrimed() == false && curLdo->getRelabeled() == true)
-    {
-      //    qDebug() << "    Reint32_ting could not find a starting index. Using first index in triangle set" << "\n";
-      curLdo->setStartIndex(*(curLdo->m_Faces.begin()));
-      curLdo->setPrimed(true);
-    }
-
-    if(firstLabel == true)
-    {
-      triIndex = 0;
-      firstLabel = false;
-    }
-    else
-    {
-      triIndex = curLdo->getStartIndex();
-    }
-    // Get the number of triangles remaining to be visited for the current label
-    QSet<int32_t>::size_type nLabelTriStart = curLdo->m_Faces.size();
-
-    STDEXT::hash_set<int> localVisited;
-    std::deque<int> triangleDeque;
-    // FaceArray::Face_t& triangle = triangles[triIndex];
-    triangleDeque.push_back(triIndex);
-
-    while(triangleDeque.empty() == false)
-    {
-      int32_t triangleIndex = triangleDeque.front();
-      FaceArray::Face_t& triangle = triangles[triangleIndex];
-      int32_t* faceLabel = m_SurfaceMeshFaceLabels + (triangleIndex * 2); // Here we are getting a new pointer offset from the start of the labels array
-
-      //   qDebug() << " $ tIndex: " << triangleIndex << "\n";
-      FaceArray::Pointer facesPtr = sm->getFaces();
-      if(facesPtr == nullptr)
+      int64_t side = labelSides[i];
+      int64_t* tri = triangles + (side / 2) * 3;
+      float avgX = (triangleGeom->getVertexPointer(tri[0])[0] + triangleGeom->getVertexPointer(tri[1])[0] + triangleGeom->getVertexPointer(tri[2])[0]) / 3.0f;
+      int32_t component = sideComponent[side];
+      if(avgX > bestX[component])
       {
-        break;
+        bestX[component] = avgX;
+        bestSide[component] = side;
       }
-      // FaceArray::Face_t* faces = facesPtr->getPointer(0);
-
-      QVector<int32_t> adjTris = TriangleOps::findAdjacentTriangles(facesPtr, triangleIndex, m_SurfaceMeshFaceLabelsPtr.lock(), currentLabel);
-
-      for(FaceList_t::iterator adjTri = adjTris.begin(); adjTri != adjTris.end(); ++adjTri)
-      {
-        // qDebug() << "  ^ AdjTri index: " << *adjTri << "\n";
-        if(masterVisited[*adjTri] == false)
-        {
-          //    qDebug() << "   * Checking Winding: " << *adjTri << "\n";
-          if(TriangleOps::verifyWinding(triangle, triangles[*adjTri], faceLabel, m_SurfaceMeshFaceLabels + (*adjTri * 2), currentLabel) == true)
-          {
-            //   qDebug() << "Face winding flipped for triangle id = " << *adjTri << " Feature Id: " << currentLabel << "\n";
-          }
-        }
-
-        if(localVisited.find(*adjTri) == localVisited.end() && find(triangleDeque.begin(), triangleDeque.end(), *adjTri) == triangleDeque.end())
-        {
-          // qDebug() << "   # Adding to Deque: " << *adjTri << "\n";
-          triangleDeque.push_back(*adjTri);
-          localVisited.insert(*adjTri);
-          masterVisited[*adjTri] = true;
-        }
-      }
-
-      // Just add the neighbor label to a set so we end up with a list of unique
-      // labels that are neighbors to the current label
-      if(currentLabel != faceLabel[0])
-      {
-        neighborlabels.insert(faceLabel[0], triangleIndex);
-      }
-      if(currentLabel != faceLabel[1])
-      {
-        neighborlabels.insert(faceLabel[1], triangleIndex);
-      }
-
-      localVisited.insert(triangleIndex);
-      masterVisited[triangleIndex] = true;
-      curLdo->m_Faces.remove(triangleIndex);
-      triangleDeque.pop_front();
-    } // End of loop to visit all triangles in the 'currentLabel'
-
-    // Find the Next label to push onto the end of the labels List, but ONLY if it is NOT
-    // currently on the list and NOT currently on the label visited list.
-    for(QMap<int32_t, int32_t>::iterator neigh = neighborlabels.begin(); neigh != neighborlabels.end(); ++neigh)
+    }
+    for(int32_t component = 0; component < componentCounts[l]; component++)
     {
-      int32_t triangleIndex = neigh.value();
-      int32_t* triangleLabel = m_SurfaceMeshFaceLabels + triangleIndex * 2;
-
-      if(labelsToVisitSet.find(triangleLabel[0]) == labelsToVisitSet.end() && (labelsVisitedSet.find(triangleLabel[0]) == labelsVisitedSet.end()))
+      uint8_t parity = 0;
+      int32_t root = findComponentRoot(parents, parities, componentOffsets[l] + component, parity);
+      if(rootFlips[root] != k_Unset)
       {
-        // Push the int32_t value into the "set"
-        labelsToVisitSet.insert(triangleLabel[0]);
-        LabelVisitorInfo::Pointer l = LabelVisitorInfo::New(triangleLabel[0], triangleIndex);
-        labelObjectsToVisit.push_back(l);
-        // qDebug() << "    Adding Label " << triangle.labels[0] << " to visit starting at tIndex " << triangleIndex << "\n";
+        continue;
       }
-      if(labelsToVisitSet.find(triangleLabel[1]) == labelsToVisitSet.end() && (labelsVisitedSet.find(triangleLabel[1]) == labelsVisitedSet.end()))
+      int64_t side = bestSide[component];
+      int64_t* tri = triangles + (side / 2) * 3;
+      float* v0 = triangleGeom->getVertexPointer(tri[0]);
+      float* v1 = triangleGeom->getVertexPointer(tri[1]);
+      float* v2 = triangleGeom->getVertexPointer(tri[2]);
+      // X component of (v1 - v0) x (v2 - v0), the normal of the stored winding
+      double normalX = static_cast<double>(v1[1] - v0[1]) * (v2[2] - v0[2]) - static_cast<double>(v1[2] - v0[2]) * (v2[1] - v0[1]);
+      uint8_t reversed = static_cast<uint8_t>(side & 1) ^ ((sideState[side] & k_Flipped) != 0 ? 1 : 0);
+      if(reversed != 0)
       {
-        // Push the int32_t value into the "set"
-        labelsToVisitSet.insert(triangleLabel[1]);
-        LabelVisitorInfo::Pointer l = LabelVisitorInfo::New(triangleLabel[1], triangleIndex);
-        labelObjectsToVisit.push_back(l);
-        //  qDebug() << "    Adding Label " << triangle.labels[1] << " to visit starting at tIndex " << triangleIndex << "\n";
+        normalX = -normalX;
       }
+      rootFlips[root] = (normalX < 0.0 ? 1 : 0) ^ parity;
     }
+  }
 
-    QSet<int32_t>::size_type nLabelTriEnd = curLdo->m_Faces.size();
-    if(nLabelTriStart == nLabelTriEnd)
-    {
-      // qDebug() << "    !--!++! No new triangles visited for int32_t " << currentLabel << "\n";
-    }
-    else if(nLabelTriEnd == 0)
+  std::vector<uint8_t> componentFlips(numComponents, 0);
+  for(int32_t c = 0; c < numComponents; c++)
+  {
+    uint8_t parity = 0;
+    int32_t root = findComponentRoot(parents, parities, c, parity);
+    componentFlips[c] = (rootFlips[root] == k_Unset ? 0 : rootFlips[root]) ^ parity;
+  }
+
+  notifyStatusMessage("Updating the triangle winding");
+  {
+    ApplyWindingImpl body(triangles, m_SurfaceMeshFaceLabels, minLabel, componentOffsets, sideState, sideComponent, componentFlips);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    tbb::task_scheduler_init init;
+    bool doParallel = true;
+    if(doParallel)
     {
-      //  qDebug() << "    No Faces remain to be visited for label " << "\n";
-      // If this currentLabel was the result of a "relabeling" then revert back to the original
-      // label for those triangles.
-      curLdo->revertFaceLabels(m_SurfaceMeshFaceLabelsPtr.lock());
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numTris), body, tbb::auto_partitioner());
     }
     else
+#endif
     {
-      // qDebug() << "    Not all triangles visited for label"  << "\n";
-      // qDebug() << "    " << nLabelTriEnd << " Faces Remaining to be visited" << "\n";
-      // At this point relabel the remaining triangles
-      //      if (currentLabel == 28) {
-      //        qDebug() << "break" << "\n";
-      //      }
-      LabelVisitorInfo::Pointer p = curLdo->relabelFaces(mesh, m_SurfaceMeshFaceLabelsPtr.lock(), masterVisited);
-      labelObjectsToVisit.push_back(p);
-      labelsToVisitSet.insert(p->getLabel());
-      // Revert the current labelVisitorObject to its original label
-      curLdo->revertFaceLabels(m_SurfaceMeshFaceLabelsPtr.lock());
-      // qDebug() << "    New label " << mesh->getMaxLabel() << " added to visit" << "\n";
-    }
-
-  } // End of Loop over each int32_t
-
-  // qDebug() << "Total: "<< total << "\n";
-  // qDebug() << "labelsToVisitSet.size() :" << labelsToVisitSet.size() << "\n";
-  if(labelsToVisitSet.size() != 0)
-  {
-    // qDebug() << " labelsToVisitSet:" << "\n";
-    for(STDEXT::hash_set<int32_t>::iterator iter = labelsToVisitSet.begin(); iter != labelsToVisitSet.end(); ++iter)
-    {
-      // qDebug() << "  int32_t: " << *iter << "\n";
+      body.convert(0, numTris);
     }
   }
-  // qDebug() << "labelsVisited.size() :" << labelsVisitedSet.size() << "\n";
-
-  QSet<int32_t> thelabels = TriangleOps::generateUniqueLabels(m_SurfaceMeshFaceLabelsPtr.lock());
-  for(STDEXT::hash_set<int32_t>::iterator iter = labelsVisitedSet.begin(); iter != labelsVisitedSet.end(); ++iter)
-  {
-    thelabels.remove(*iter);
-  }
 
-  // qDebug() << "labels NOT visited:" << "\n";
-  for(QSet<int32_t>::iterator iter = thelabels.begin(); iter != thelabels.end(); ++iter)
+  if(numConflicts > 0)
   {
-    // qDebug() << "  int32_t: " << *iter << "\n";
+    QString ss = QObject::tr("%1 triangle pairs could not be wound consistently. The surface mesh may be non-manifold or contain disconnected Features that share a Feature Id").arg(numConflicts);
+    setWarningCondition(-389, ss);
   }
-
-  // qDebug() << "--------------------------------------------------------------" << "\n";
-  return err;
+  return 0;
 }
 
 // -----------------------------------------------------------------------------
@@ -805,7 +669,7 @@ int VerifyTriangleWinding::verifyTriangleWinding()
 AbstractFilter::Pointer VerifyTriangleWinding::newFilterInstance(bool copyFilterParameters) const
 {
   VerifyTriangleWinding::Pointer filter = VerifyTriangleWinding::New();
-  if(true == copyFilterParameters)
+  if(copyFilterParameters)
   {
     copyFilterParameterInstanceVariables(filter.get());
   }
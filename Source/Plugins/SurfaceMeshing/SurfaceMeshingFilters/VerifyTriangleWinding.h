@@ -49,40 +49,42 @@
 
 /**
  * @class VerifyTriangleWinding VerifyTriangleWinding.h /SurfaceMeshFilters/VerifyTriangleWinding.h
- * @brief
- * @author
- * @date
- * @version 1.0
+ * @brief The VerifyTriangleWinding class makes the winding of the triangles of a surface mesh
+ * consistent. The triangles of each Feature are visited in parallel, one Feature per task, and the
+ * orientations found for the Features are then reconciled across the triangles they share.
+ * See [Filter documentation](@ref verifytrianglewinding) for details.
  */
 class SurfaceMeshing_EXPORT VerifyTriangleWinding : public SurfaceMeshFilter
 {
     Q_OBJECT
-  //  PYB11_CREATE_BINDINGS(VerifyTriangleWinding SUPERCLASS SurfaceMeshFilter)
-  //  PYB11_PROPERTY(DataArrayPath SurfaceMeshFaceLabelsArrayPath READ getSurfaceMeshFaceLabelsArrayPath WRITE setSurfaceMeshFaceLabelsArrayPath)
   public:
     SIMPL_SHARED_POINTERS(VerifyTriangleWinding)
     SIMPL_FILTER_NEW_MACRO(VerifyTriangleWinding)
     SIMPL_TYPE_MACRO_SUPER_OVERRIDE(VerifyTriangleWinding, SurfaceMeshFilter)
 
     ~VerifyTriangleWinding() override;
-    SIMPL_INSTANCE_STRING_PROPERTY(SurfaceDataContainerName)
 
-    SIMPL_INSTANCE_STRING_PROPERTY(SurfaceMeshNodeFacesArrayName)
-
-    typedef QMap<int, QSet<int> >                      LabelFaceMap_t;
-    typedef QVector<int32_t>                               FaceList_t;
-
-    /**
-    * @brief This returns the group that the filter belonds to. You can select
-    * a different group if you want. The string returned here will be displayed
-    * in the GUI for the filter
-    */
     SIMPL_FILTER_PARAMETER(DataArrayPath, SurfaceMeshFaceLabelsArrayPath)
     Q_PROPERTY(DataArrayPath SurfaceMeshFaceLabelsArrayPath READ getSurfaceMeshFaceLabelsArrayPath WRITE setSurfaceMeshFaceLabelsArrayPath)
 
+    /**
+     * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
+     */
     const QString getCompiledLibraryName() const override;
+
+    /**
+     * @brief newFilterInstance Reimplemented from @see AbstractFilter class
+     */
     AbstractFilter::Pointer newFilterInstance(bool copyFilterParameters) const override;
+
+    /**
+     * @brief getGroupName Reimplemented from @see AbstractFilter class
+     */
     const QString getGroupName() const override;
+
+    /**
+     * @brief getSubGroupName Reimplemented from @see AbstractFilter class
+     */
     const QString getSubGroupName() const override;
 
     /**
@@ -139,40 +141,18 @@ class SurfaceMeshing_EXPORT VerifyTriangleWinding : public SurfaceMeshFilter
      */
     void initialize();
 
-
-    /**
-     * @brief This method generates a mapping between a "Label" (Feature Id) and the set of triangles that belong to that
-     * lable value.
-     * @param trianglesToLabelMap
-     */
-    void getLabelTriangelMap(LabelFaceMap_t& trianglesToLabelMap);
-
     /**
      * @brief This method verifies the winding of all the triangles and makes them consistent
-     * @return
+     * @return Negative value on error or cancel
      */
     int verifyTriangleWinding();
 
-    /**
-     * @brief VerifyTriangleWinding::getSeedTriangle
-     * @param label
-     * @param triangleIndices
-     * @return
-     */
-    int32_t getSeedTriangle(int32_t label, QSet<int32_t>& triangleIndices);
-
   private:
     DEFINE_DATAARRAY_VARIABLE(int32_t, SurfaceMeshFaceLabels)
 
-    bool m_DoNodeFaceConnectivityFilter;
-
   public:
     VerifyTriangleWinding(const VerifyTriangleWinding&) = delete; // Copy Constructor Not Implemented
     VerifyTriangleWinding(VerifyTriangleWinding&&) = delete;      // Move Constructor Not Implemented
     VerifyTriangleWinding& operator=(const VerifyTriangleWinding&) = delete; // Copy Assignment Not Implemented
     VerifyTriangleWinding& operator=(VerifyTriangleWinding&&) = delete;      // Move Assignment Not Implemented
 };
-
-
-
-
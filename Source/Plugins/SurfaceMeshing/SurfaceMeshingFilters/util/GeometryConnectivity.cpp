@@ -0,0 +1,452 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include "GeometryConnectivity.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include "SIMPLib/Geometry/HexahedralGeom.h"
+#include "SIMPLib/Geometry/QuadGeom.h"
+#include "SIMPLib/Geometry/TetrahedralGeom.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+
+namespace
+{
+/**
+ * @brief The ElementArray struct is a flat view of the element list of a geometry
+ */
+struct ElementArray
+{
+  int64_t* elements = nullptr;
+  size_t numElements = 0;
+  size_t vertsPerElement = 0;
+  size_t numVertices = 0;
+  size_t numSharedVerts = 0;
+};
+
+/**
+ * @brief GetElementArray Fills the element view of a supported geometry
+ * @return false if the geometry type is not supported
+ */
+bool GetElementArray(const IGeometry::Pointer& geom, ElementArray& array)
+{
+  if(nullptr == geom.get())
+  {
+    return false;
+  }
+  switch(geom->getGeometryType())
+  {
+  case IGeometry::Type::Triangle:
+  {
+    TriangleGeom::Pointer tris = std::dynamic_pointer_cast<TriangleGeom>(geom);
+    array.elements = tris->getTriPointer(0);
+    array.numElements = static_cast<size_t>(tris->getNumberOfTris());
+    array.vertsPerElement = 3;
+    array.numVertices = static_cast<size_t>(tris->getNumberOfVertices());
+    array.numSharedVerts = 2;
+    return true;
+  }
+  case IGeometry::Type::Quad:
+  {
+    QuadGeom::Pointer quads = std::dynamic_pointer_cast<QuadGeom>(geom);
+    array.elements = quads->getQuadPointer(0);
+    array.numElements = static_cast<size_t>(quads->getNumberOfQuads());
+    array.vertsPerElement = 4;
+    array.numVertices = static_cast<size_t>(quads->getNumberOfVertices());
+    array.numSharedVerts = 2;
+    return true;
+  }
+  case IGeometry::Type::Tetrahedral:
+  {
+    TetrahedralGeom::Pointer tets = std::dynamic_pointer_cast<TetrahedralGeom>(geom);
+    array.elements = tets->getTetPointer(0);
+    array.numElements = static_cast<size_t>(tets->getNumberOfTets());
+    array.vertsPerElement = 4;
+    array.numVertices = static_cast<size_t>(tets->getNumberOfVertices());
+    array.numSharedVerts = 3;
+    return true;
+  }
+  case IGeometry::Type::Hexahedral:
+  {
+    HexahedralGeom::Pointer hexas = std::dynamic_pointer_cast<HexahedralGeom>(geom);
+    array.elements = hexas->getHexPointer(0);
+    array.numElements = static_cast<size_t>(hexas->getNumberOfHexas());
+    array.vertsPerElement = 8;
+    array.numVertices = static_cast<size_t>(hexas->getNumberOfVertices());
+    array.numSharedVerts = 4;
+    return true;
+  }
+  default:
+    return false;
+  }
+}
+
+/**
+ * @brief RunParallel Runs a body over [0, count) in parallel when it is available
+ */
+template <typename Body>
+void RunParallel(const Body& body, size_t count, size_t grain)
+{
+  if(count == 0)
+  {
+    return;
+  }
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  if(doParallel && count > grain)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, count, grain), body, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    body.convert(0, count);
+  }
+}
+
+/**
+ * @brief The CountIncidencesImpl class counts the elements that use each vertex
+ */
+class CountIncidencesImpl
+{
+public:
+  CountIncidencesImpl(const ElementArray& array, std::vector<std::atomic<uint32_t>>& counts)
+  : m_Array(array)
+  , m_Counts(counts)
+  {
+  }
+  virtual ~CountIncidencesImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t i = start * m_Array.vertsPerElement; i < end * m_Array.vertsPerElement; i++)
+    {
+      m_Counts[m_Array.elements[i]].fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const ElementArray& m_Array;
+  std::vector<std::atomic<uint32_t>>& m_Counts;
+};
+
+/**
+ * @brief The FillIncidencesImpl class writes each element into the lists of its vertices. The slot
+ * inside a list is claimed atomically, so the lists are sorted afterwards.
+ */
+class FillIncidencesImpl
+{
+public:
+  FillIncidencesImpl(const ElementArray& array, std::vector<std::atomic<uint32_t>>& cursors, ElementDynamicList* lists)
+  : m_Array(array)
+  , m_Cursors(cursors)
+  , m_Lists(lists)
+  {
+  }
+  virtual ~FillIncidencesImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t e = start; e < end; e++)
+    {
+      const int64_t* elem = m_Array.elements + e * m_Array.vertsPerElement;
+      for(size_t v = 0; v < m_Array.vertsPerElement; v++)
+      {
+        uint32_t slot = m_Cursors[elem[v]].fetch_add(1, std::memory_order_relaxed);
+        m_Lists->getElementListPointer(elem[v])[slot] = static_cast<int64_t>(e);
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const ElementArray& m_Array;
+  std::vector<std::atomic<uint32_t>>& m_Cursors;
+  ElementDynamicList* m_Lists;
+};
+
+/**
+ * @brief The SortListsImpl class puts every list in ascending element order
+ */
+class SortListsImpl
+{
+public:
+  SortListsImpl(ElementDynamicList* lists)
+  : m_Lists(lists)
+  {
+  }
+  virtual ~SortListsImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      int64_t* list = m_Lists->getElementListPointer(i);
+      std::sort(list, list + m_Lists->getNumberOfElements(i));
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  ElementDynamicList* m_Lists;
+};
+
+/**
+ * @brief The ElementNeighborsImpl class finds the neighbors of each element by visiting the elements
+ * that share one of its vertices, in vertex order and then in ascending element order, and keeping
+ * the ones that share at least numSharedVerts vertices. With the counts pointer set it only counts
+ * the neighbors; otherwise it writes them into the already allocated neighbor lists.
+ */
+class ElementNeighborsImpl
+{
+public:
+  ElementNeighborsImpl(const ElementArray& array, ElementDynamicList* vertLists, std::vector<uint16_t>* counts, ElementDynamicList* neighborLists)
+  : m_Array(array)
+  , m_VertLists(vertLists)
+  , m_Counts(counts)
+  , m_NeighborLists(neighborLists)
+  {
+  }
+  virtual ~ElementNeighborsImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    std::vector<int64_t> neighbors;
+    std::vector<int64_t> rejected;
+    size_t numVerts = m_Array.vertsPerElement;
+    for(size_t e = start; e < end; e++)
+    {
+      neighbors.clear();
+      rejected.clear();
+      const int64_t* elem = m_Array.elements + e * numVerts;
+      for(size_t v = 0; v < numVerts; v++)
+      {
+        uint16_t count = m_VertLists->getNumberOfElements(elem[v]);
+        const int64_t* candidates = m_VertLists->getElementListPointer(elem[v]);
+        for(uint16_t c = 0; c < count; c++)
+        {
+          int64_t other = candidates[c];
+          if(other == static_cast<int64_t>(e) || std::find(neighbors.begin(), neighbors.end(), other) != neighbors.end() ||
+             std::find(rejected.begin(), rejected.end(), other) != rejected.end())
+          {
+            continue;
+          }
+          const int64_t* otherElem = m_Array.elements + other * numVerts;
+          size_t shared = 0;
+          for(size_t i = 0; i < numVerts; i++)
+          {
+            for(size_t j = 0; j < numVerts; j++)
+            {
+              if(otherElem[i] == elem[j])
+              {
+                shared++;
+                break;
+              }
+            }
+          }
+          if(shared >= m_Array.numSharedVerts)
+          {
+            neighbors.push_back(other);
+          }
+          else
+          {
+            rejected.push_back(other);
+          }
+        }
+      }
+
+      if(nullptr != m_Counts)
+      {
+        (*m_Counts)[e] = static_cast<uint16_t>(std::min(neighbors.size(), size_t(std::numeric_limits<uint16_t>::max())));
+      }
+      else
+      {
+        std::copy(neighbors.begin(), neighbors.begin() + m_NeighborLists->getNumberOfElements(e), m_NeighborLists->getElementListPointer(e));
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const ElementArray& m_Array;
+  ElementDynamicList* m_VertLists;
+  std::vector<uint16_t>* m_Counts;
+  ElementDynamicList* m_NeighborLists;
+};
+
+/**
+ * @brief BuildElementsContainingVert Builds the vertex to element lists of a geometry
+ */
+int32_t BuildElementsContainingVert(const IGeometry::Pointer& geom, const ElementArray& array)
+{
+  std::vector<std::atomic<uint32_t>> counts(array.numVertices);
+  for(std::atomic<uint32_t>& count : counts)
+  {
+    count.store(0, std::memory_order_relaxed);
+  }
+  CountIncidencesImpl countBody(array, counts);
+  RunParallel(countBody, array.numElements, 4096);
+
+  // The lists store their sizes as 16 bit values
+  std::vector<uint16_t> linkCount(array.numVertices, 0);
+  for(size_t v = 0; v < array.numVertices; v++)
+  {
+    uint32_t count = counts[v].load(std::memory_order_relaxed);
+    if(count > std::numeric_limits<uint16_t>::max())
+    {
+      return -1;
+    }
+    linkCount[v] = static_cast<uint16_t>(count);
+    counts[v].store(0, std::memory_order_relaxed);
+  }
+
+  ElementDynamicList::Pointer lists = ElementDynamicList::New();
+  lists->allocateLists(linkCount);
+
+  FillIncidencesImpl fillBody(array, counts, lists.get());
+  RunParallel(fillBody, array.numElements, 4096);
+  SortListsImpl sortBody(lists.get());
+  RunParallel(sortBody, array.numVertices, 4096);
+
+  geom->setElementsContainingVert(lists);
+  return 1;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+GeometryConnectivity::GeometryConnectivity() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+GeometryConnectivity::~GeometryConnectivity() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool GeometryConnectivity::isSupported(const IGeometry::Pointer& geom)
+{
+  ElementArray array;
+  return GetElementArray(geom, array);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t GeometryConnectivity::findElementsContainingVert(const IGeometry::Pointer& geom)
+{
+  ElementArray array;
+  if(!GetElementArray(geom, array))
+  {
+    return (nullptr == geom.get()) ? -1 : geom->findElementsContainingVert();
+  }
+
+  return BuildElementsContainingVert(geom, array);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t GeometryConnectivity::findElementNeighbors(const IGeometry::Pointer& geom)
+{
+  ElementArray array;
+  if(!GetElementArray(geom, array))
+  {
+    return (nullptr == geom.get()) ? -1 : geom->findElementNeighbors();
+  }
+
+  ElementDynamicList::Pointer vertLists = geom->getElementsContainingVert();
+  if(nullptr == vertLists.get())
+  {
+    int32_t err = BuildElementsContainingVert(geom, array);
+    if(err < 0)
+    {
+      return err;
+    }
+    vertLists = geom->getElementsContainingVert();
+  }
+
+  std::vector<uint16_t> linkCount(array.numElements, 0);
+  ElementNeighborsImpl countBody(array, vertLists.get(), &linkCount, nullptr);
+  RunParallel(countBody, array.numElements, 1024);
+
+  ElementDynamicList::Pointer neighbors = ElementDynamicList::New();
+  neighbors->allocateLists(linkCount);
+
+  ElementNeighborsImpl fillBody(array, vertLists.get(), nullptr, neighbors.get());
+  RunParallel(fillBody, array.numElements, 1024);
+
+  geom->setElementNeighbors(neighbors);
+  return 1;
+}
@@ -0,0 +1,87 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#pragma once
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Geometry/IGeometry.h"
+
+/**
+ * @brief The GeometryConnectivity class builds the vertex to element lists and the element neighbor
+ * lists of Triangle, Quad, Tetrahedral and Hexahedral geometries in parallel and stores them on the
+ * geometry. Two elements are neighbors when they share an edge (Triangle, Quad) or a face
+ * (Tetrahedral, Hexahedral); the lists hold the same elements, in the same order, as the ones the
+ * geometries build themselves.
+ * Other geometry types are passed through to the geometry's own methods.
+ *
+ * Like the methods of the geometries, every call rebuilds the lists it is asked for. Callers that
+ * can reuse lists already stored on the geometry check for them first.
+ */
+class GeometryConnectivity
+{
+  public:
+    virtual ~GeometryConnectivity();
+
+    /**
+     * @brief isSupported Returns true if the lists of the geometry are built by this class
+     * @param geom The geometry
+     */
+    static bool isSupported(const IGeometry::Pointer& geom);
+
+    /**
+     * @brief findElementsContainingVert Builds the vertex to element lists and stores them on the geometry
+     * @param geom The geometry
+     * @return Negative value on error
+     */
+    static int32_t findElementsContainingVert(const IGeometry::Pointer& geom);
+
+    /**
+     * @brief findElementNeighbors Builds the element neighbor lists and stores them on the geometry. The
+     * vertex to element lists are built first if the geometry does not hold any.
+     * @param geom The geometry
+     * @return Negative value on error
+     */
+    static int32_t findElementNeighbors(const IGeometry::Pointer& geom);
+
+  protected:
+    GeometryConnectivity();
+
+  public:
+    GeometryConnectivity(const GeometryConnectivity&) = delete;            // Copy Constructor Not Implemented
+    GeometryConnectivity(GeometryConnectivity&&) = delete;                 // Move Constructor Not Implemented
+    GeometryConnectivity& operator=(const GeometryConnectivity&) = delete; // Copy Assignment Not Implemented
+    GeometryConnectivity& operator=(GeometryConnectivity&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,521 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+/**
+ * @brief The SharedFeatureFaceIndex class groups the triangles of a surface mesh into Feature Faces,
+ * the sets of triangles that share the same unordered pair of Face Labels. The triangles are sorted
+ * by a packed 64 bit key with a parallel, stable LSD radix sort and the Feature Faces are the runs of
+ * equal keys. Feature Face Ids start at 1 and are handed out in order of the first triangle of each
+ * Feature Face, so the numbering does not depend on the number of threads. Feature Face 0 is
+ * reserved and never holds any triangles.
+ *
+ * The triangles of every Feature Face are stored in CSR form: the triangles of Feature Face f are
+ * getTriangles()[getOffsets()[f]] up to getTriangles()[getOffsets()[f + 1]], in ascending order.
+ */
+class SharedFeatureFaceIndex
+{
+public:
+  SharedFeatureFaceIndex() = default;
+  virtual ~SharedFeatureFaceIndex() = default;
+
+  /**
+   * @brief buildFromFaceLabels Finds the Feature Faces of a mesh from its Face Labels
+   * @param faceLabels The 2 Face Labels of every triangle
+   * @param numTriangles Number of triangles
+   * @param faceIds If not null, receives the Feature Face Id of every triangle
+   */
+  void buildFromFaceLabels(const int32_t* faceLabels, size_t numTriangles, int32_t* faceIds)
+  {
+    std::vector<uint64_t> keys(numTriangles);
+    KeyImpl keyBody(faceLabels, keys.data());
+    std::vector<int64_t> order;
+    sortByKey(keyBody, numTriangles, keys, order);
+
+    // Each run of equal keys is one Feature Face; a stable sort leaves the lowest triangle
+    // id at the start of every run
+    std::vector<int64_t> runStarts;
+    for(size_t i = 0; i < numTriangles; i++)
+    {
+      if(i == 0 || keys[i] != keys[i - 1])
+      {
+        runStarts.push_back(static_cast<int64_t>(i));
+      }
+    }
+    size_t numRuns = runStarts.size();
+    runStarts.push_back(static_cast<int64_t>(numTriangles));
+
+    std::vector<size_t> runsByFirstTriangle(numRuns);
+    for(size_t r = 0; r < numRuns; r++)
+    {
+      runsByFirstTriangle[r] = r;
+    }
+    std::sort(runsByFirstTriangle.begin(), runsByFirstTriangle.end(), [&](size_t a, size_t b) { return order[runStarts[a]] < order[runStarts[b]]; });
+
+    m_Offsets.assign(numRuns + 2, 0);
+    m_Labels.assign(numRuns + 1, std::pair<int32_t, int32_t>(0, 0));
+    std::vector<int64_t> runSources(numRuns + 1, 0);
+    for(size_t f = 1; f <= numRuns; f++)
+    {
+      size_t r = runsByFirstTriangle[f - 1];
+      runSources[f] = runStarts[r];
+      m_Offsets[f + 1] = m_Offsets[f] + (runStarts[r + 1] - runStarts[r]);
+      m_Labels[f] = UnpackKey(keys[runStarts[r]]);
+    }
+
+    m_Triangles.resize(numTriangles);
+    ScatterImpl scatterBody(order.data(), runSources.data(), m_Offsets.data(), m_Triangles.data(), faceIds);
+    run(scatterBody, 1, numRuns + 1, 1);
+  }
+
+  /**
+   * @brief buildFromFaceIds Builds the CSR lists of an existing set of Feature Face Ids
+   * @param faceIds The Feature Face Id of every triangle; none may be negative
+   * @param numTriangles Number of triangles
+   */
+  void buildFromFaceIds(const int32_t* faceIds, size_t numTriangles)
+  {
+    std::vector<uint64_t> keys(numTriangles);
+    IdKeyImpl keyBody(faceIds, keys.data());
+    std::vector<int64_t> order;
+    sortByKey(keyBody, numTriangles, keys, order);
+
+    uint64_t maxId = numTriangles > 0 ? keys.back() : 0;
+    m_Offsets.assign(maxId + 2, 0);
+    for(size_t i = 0; i < numTriangles; i++)
+    {
+      m_Offsets[keys[i] + 1]++;
+    }
+    for(size_t f = 1; f < m_Offsets.size(); f++)
+    {
+      m_Offsets[f] += m_Offsets[f - 1];
+    }
+    m_Labels.clear();
+    m_Triangles.swap(order);
+  }
+
+  /**
+   * @brief getNumberOfFaces Returns the number of Feature Faces, including Feature Face 0
+   */
+  size_t getNumberOfFaces() const
+  {
+    return m_Offsets.empty() ? 0 : m_Offsets.size() - 1;
+  }
+
+  /**
+   * @brief getNumberOfTriangles Returns the number of triangles in a Feature Face
+   */
+  int64_t getNumberOfTriangles(size_t face) const
+  {
+    return m_Offsets[face + 1] - m_Offsets[face];
+  }
+
+  /**
+   * @brief getOffsets Returns the start of every Feature Face in the triangle list, plus the total
+   */
+  const std::vector<int64_t>& getOffsets() const
+  {
+    return m_Offsets;
+  }
+
+  /**
+   * @brief getTriangles Returns the triangle ids grouped by Feature Face
+   */
+  const std::vector<int64_t>& getTriangles() const
+  {
+    return m_Triangles;
+  }
+
+  /**
+   * @brief getLabels Returns the ordered (lower, higher) Face Label pair of a Feature Face; only
+   * valid after buildFromFaceLabels()
+   */
+  const std::pair<int32_t, int32_t>& getLabels(size_t face) const
+  {
+    return m_Labels[face];
+  }
+
+  /**
+   * @brief PackKey Packs an unordered pair of Face Labels into a single key
+   */
+  static uint64_t PackKey(int32_t label0, int32_t label1)
+  {
+    if(label1 < label0)
+    {
+      std::swap(label0, label1);
+    }
+    return (static_cast<uint64_t>(static_cast<uint32_t>(label0)) << 32) | static_cast<uint64_t>(static_cast<uint32_t>(label1));
+  }
+
+  /**
+   * @brief UnpackKey Returns the ordered pair of Face Labels of a key
+   */
+  static std::pair<int32_t, int32_t> UnpackKey(uint64_t key)
+  {
+    return std::pair<int32_t, int32_t>(static_cast<int32_t>(static_cast<uint32_t>(key >> 32)), static_cast<int32_t>(static_cast<uint32_t>(key)));
+  }
+
+private:
+  static const size_t k_RadixBits = 16;
+  static const size_t k_NumBuckets = size_t(1) << k_RadixBits;
+  static const size_t k_MinTrianglesPerChunk = 65536;
+
+  std::vector<int64_t> m_Offsets;
+  std::vector<int64_t> m_Triangles;
+  std::vector<std::pair<int32_t, int32_t>> m_Labels;
+
+  /**
+   * @brief run Runs a body over [start, end) in parallel when it is available
+   */
+  template <typename Body>
+  static void run(const Body& body, size_t start, size_t end, size_t grain)
+  {
+    if(start >= end)
+    {
+      return;
+    }
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    tbb::task_scheduler_init init;
+    bool doParallel = true;
+    if(doParallel && end - start > grain)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(start, end, grain), body, tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      body.convert(start, end);
+    }
+  }
+
+  /**
+   * @brief sortByKey Fills the keys with the key body, then stably sorts the keys and the triangle
+   * ids together. Only the 16 bit digits that differ between the keys are sorted on.
+   */
+  template <typename KeyBody>
+  static void sortByKey(const KeyBody& keyBody, size_t numTriangles, std::vector<uint64_t>& keys, std::vector<int64_t>& order)
+  {
+    order.resize(numTriangles);
+    run(keyBody, 0, numTriangles, 4096);
+    for(size_t i = 0; i < numTriangles; i++)
+    {
+      order[i] = static_cast<int64_t>(i);
+    }
+    if(numTriangles < 2)
+    {
+      return;
+    }
+
+    uint64_t varyingBits = 0;
+    for(size_t i = 1; i < numTriangles; i++)
+    {
+      varyingBits |= keys[i] ^ keys[0];
+    }
+
+    size_t numChunks = 1;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    numChunks = static_cast<size_t>(tbb::task_scheduler_init::default_num_threads());
+#endif
+    numChunks = std::max(size_t(1), std::min(numChunks, numTriangles / k_MinTrianglesPerChunk));
+
+    std::vector<uint64_t> keysOut(numTriangles);
+    std::vector<int64_t> orderOut(numTriangles);
+    std::vector<std::vector<size_t>> buckets(numChunks);
+    for(size_t shift = 0; shift < 64; shift += k_RadixBits)
+    {
+      if(((varyingBits >> shift) & (k_NumBuckets - 1)) == 0)
+      {
+        continue;
+      }
+      HistogramImpl histogramBody(keys.data(), numTriangles, numChunks, shift, buckets);
+      run(histogramBody, 0, numChunks, 1);
+
+      // Exclusive prefix sum over (bucket, chunk) so that every chunk scatters into its own
+      // slice of every bucket, which keeps the sort stable
+      size_t total = 0;
+      for(size_t b = 0; b < k_NumBuckets; b++)
+      {
+        for(size_t c = 0; c < numChunks; c++)
+        {
+          size_t count = buckets[c][b];
+          buckets[c][b] = total;
+          total += count;
+        }
+      }
+
+      ScatterKeysImpl scatterBody(keys.data(), order.data(), keysOut.data(), orderOut.data(), numTriangles, numChunks, shift, buckets);
+      run(scatterBody, 0, numChunks, 1);
+      keys.swap(keysOut);
+      order.swap(orderOut);
+    }
+  }
+
+  /**
+   * @brief The KeyImpl class packs the Face Labels of every triangle into a key
+   */
+  class KeyImpl
+  {
+  public:
+    KeyImpl(const int32_t* faceLabels, uint64_t* keys)
+    : m_FaceLabels(faceLabels)
+    , m_Keys(keys)
+    {
+    }
+    virtual ~KeyImpl() = default;
+
+    void convert(size_t start, size_t end) const
+    {
+      for(size_t t = start; t < end; t++)
+      {
+        m_Keys[t] = PackKey(m_FaceLabels[t * 2], m_FaceLabels[t * 2 + 1]);
+      }
+    }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    const int32_t* m_FaceLabels;
+    uint64_t* m_Keys;
+  };
+
+  /**
+   * @brief The IdKeyImpl class uses the Feature Face Id of every triangle as its key
+   */
+  class IdKeyImpl
+  {
+  public:
+    IdKeyImpl(const int32_t* faceIds, uint64_t* keys)
+    : m_FaceIds(faceIds)
+    , m_Keys(keys)
+    {
+    }
+    virtual ~IdKeyImpl() = default;
+
+    void convert(size_t start, size_t end) const
+    {
+      for(size_t t = start; t < end; t++)
+      {
+        m_Keys[t] = static_cast<uint64_t>(m_FaceIds[t]);
+      }
+    }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    const int32_t* m_FaceIds;
+    uint64_t* m_Keys;
+  };
+
+  /**
+   * @brief The HistogramImpl class counts the digits of each contiguous chunk of keys
+   */
+  class HistogramImpl
+  {
+  public:
+    HistogramImpl(const uint64_t* keys, size_t numKeys, size_t numChunks, size_t shift, std::vector<std::vector<size_t>>& buckets)
+    : m_Keys(keys)
+    , m_NumKeys(numKeys)
+    , m_NumChunks(numChunks)
+    , m_Shift(shift)
+    , m_Buckets(buckets)
+    {
+    }
+    virtual ~HistogramImpl() = default;
+
+    void convert(size_t start, size_t end) const
+    {
+      for(size_t c = start; c < end; c++)
+      {
+        std::vector<size_t>& counts = m_Buckets[c];
+        counts.assign(k_NumBuckets, 0);
+        size_t first = m_NumKeys * c / m_NumChunks;
+        size_t last = m_NumKeys * (c + 1) / m_NumChunks;
+        for(size_t i = first; i < last; i++)
+        {
+          counts[(m_Keys[i] >> m_Shift) & (k_NumBuckets - 1)]++;
+        }
+      }
+    }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    const uint64_t* m_Keys;
+    size_t m_NumKeys;
+    size_t m_NumChunks;
+    size_t m_Shift;
+    std::vector<std::vector<size_t>>& m_Buckets;
+  };
+
+  /**
+   * @brief The ScatterKeysImpl class moves each chunk of keys and triangle ids to their sorted position
+   */
+  class ScatterKeysImpl
+  {
+  public:
+    ScatterKeysImpl(const uint64_t* keys, const int64_t* order, uint64_t* keysOut, int64_t* orderOut, size_t numKeys, size_t numChunks, size_t shift,
+                    std::vector<std::vector<size_t>>& buckets)
+    : m_Keys(keys)
+    , m_Order(order)
+    , m_KeysOut(keysOut)
+    , m_OrderOut(orderOut)
+    , m_NumKeys(numKeys)
+    , m_NumChunks(numChunks)
+    , m_Shift(shift)
+    , m_Buckets(buckets)
+    {
+    }
+    virtual ~ScatterKeysImpl() = default;
+
+    void convert(size_t start, size_t end) const
+    {
+      for(size_t c = start; c < end; c++)
+      {
+        std::vector<size_t>& offsets = m_Buckets[c];
+        size_t first = m_NumKeys * c / m_NumChunks;
+        size_t last = m_NumKeys * (c + 1) / m_NumChunks;
+        for(size_t i = first; i < last; i++)
+        {
+          size_t dest = offsets[(m_Keys[i] >> m_Shift) & (k_NumBuckets - 1)]++;
+          m_KeysOut[dest] = m_Keys[i];
+          m_OrderOut[dest] = m_Order[i];
+        }
+      }
+    }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    const uint64_t* m_Keys;
+    const int64_t* m_Order;
+    uint64_t* m_KeysOut;
+    int64_t* m_OrderOut;
+    size_t m_NumKeys;
+    size_t m_NumChunks;
+    size_t m_Shift;
+    std::vector<std::vector<size_t>>& m_Buckets;
+  };
+
+  /**
+   * @brief The ScatterImpl class copies the triangles of each Feature Face into the CSR list and
+   * optionally writes their Feature Face Id
+   */
+  class ScatterImpl
+  {
+  public:
+    ScatterImpl(const int64_t* order, const int64_t* runSources, const int64_t* offsets, int64_t* triangles, int32_t* faceIds)
+    : m_Order(order)
+    , m_RunSources(runSources)
+    , m_Offsets(offsets)
+    , m_Triangles(triangles)
+    , m_FaceIds(faceIds)
+    {
+    }
+    virtual ~ScatterImpl() = default;
+
+    void convert(size_t start, size_t end) const
+    {
+      for(size_t f = start; f < end; f++)
+      {
+        const int64_t* source = m_Order + m_RunSources[f];
+        int64_t count = m_Offsets[f + 1] - m_Offsets[f];
+        std::copy(source, source + count, m_Triangles + m_Offsets[f]);
+        if(nullptr != m_FaceIds)
+        {
+          for(int64_t i = 0; i < count; i++)
+          {
+            m_FaceIds[source[i]] = static_cast<int32_t>(f);
+          }
+        }
+      }
+    }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    const int64_t* m_Order;
+    const int64_t* m_RunSources;
+    const int64_t* m_Offsets;
+    int64_t* m_Triangles;
+    int32_t* m_FaceIds;
+  };
+
+public:
+  SharedFeatureFaceIndex(const SharedFeatureFaceIndex&) = delete;            // Copy Constructor Not Implemented
+  SharedFeatureFaceIndex(SharedFeatureFaceIndex&&) = delete;                 // Move Constructor Not Implemented
+  SharedFeatureFaceIndex& operator=(const SharedFeatureFaceIndex&) = delete; // Copy Assignment Not Implemented
+  SharedFeatureFaceIndex& operator=(SharedFeatureFaceIndex&&) = delete;      // Move Assignment Not Implemented
+};
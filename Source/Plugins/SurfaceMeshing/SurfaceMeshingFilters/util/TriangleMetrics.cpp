@@ -0,0 +1,372 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include "TriangleMetrics.h"
+
+#include <algorithm>
+#include <cmath>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include "SIMPLib/Math/SIMPLibMath.h"
+
+namespace
+{
+static const size_t k_BatchSize = 256;
+
+/**
+ * @brief The TriangleBatch struct holds the corner coordinates of a batch of triangles, one
+ * contiguous array per corner and axis
+ */
+struct TriangleBatch
+{
+  double x0[k_BatchSize];
+  double y0[k_BatchSize];
+  double z0[k_BatchSize];
+  double x1[k_BatchSize];
+  double y1[k_BatchSize];
+  double z1[k_BatchSize];
+  double x2[k_BatchSize];
+  double y2[k_BatchSize];
+  double z2[k_BatchSize];
+  int64_t ids[k_BatchSize];
+};
+
+/**
+ * @brief The TriangleMetricsImpl class gathers batches of triangles and computes the requested
+ * quantities for each batch
+ */
+class TriangleMetricsImpl
+{
+public:
+  TriangleMetricsImpl(const float* vertices, const int64_t* triangles, size_t numTris, const TriangleMetrics::Outputs& outputs, const int32_t* faceLabels,
+                      const float* featureCentroids)
+  : m_Vertices(vertices)
+  , m_Triangles(triangles)
+  , m_NumTris(numTris)
+  , m_Outputs(outputs)
+  , m_FaceLabels(faceLabels)
+  , m_FeatureCentroids(featureCentroids)
+  {
+  }
+  virtual ~TriangleMetricsImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    TriangleBatch batch;
+    for(size_t first = start * k_BatchSize; first < end * k_BatchSize && first < m_NumTris; first += k_BatchSize)
+    {
+      size_t count = std::min(k_BatchSize, m_NumTris - first);
+      gather(first, count, batch);
+      if(nullptr != m_Outputs.areas || nullptr != m_Outputs.normals)
+      {
+        computeCrossProducts(count, batch);
+      }
+      if(nullptr != m_Outputs.centroids)
+      {
+        computeCentroids(count, batch);
+      }
+      if(nullptr != m_Outputs.minDihedralAngles)
+      {
+        computeMinDihedralAngles(count, batch);
+      }
+      if(nullptr != m_Outputs.signedVolumes)
+      {
+        computeSignedVolumes(count, batch);
+      }
+      if(nullptr != m_Outputs.featureMoments)
+      {
+        computeFeatureMoments(count, batch);
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const float* m_Vertices;
+  const int64_t* m_Triangles;
+  size_t m_NumTris;
+  TriangleMetrics::Outputs m_Outputs;
+  const int32_t* m_FaceLabels;
+  const float* m_FeatureCentroids;
+
+  void gather(size_t first, size_t count, TriangleBatch& batch) const
+  {
+    for(size_t b = 0; b < count; b++)
+    {
+      int64_t t = static_cast<int64_t>(first + b);
+      batch.ids[b] = t;
+      const float* v0 = m_Vertices + m_Triangles[t * 3] * 3;
+      const float* v1 = m_Vertices + m_Triangles[t * 3 + 1] * 3;
+      const float* v2 = m_Vertices + m_Triangles[t * 3 + 2] * 3;
+      batch.x0[b] = v0[0];
+      batch.y0[b] = v0[1];
+      batch.z0[b] = v0[2];
+      batch.x1[b] = v1[0];
+      batch.y1[b] = v1[1];
+      batch.z1[b] = v1[2];
+      batch.x2[b] = v2[0];
+      batch.y2[b] = v2[1];
+      batch.z2[b] = v2[2];
+    }
+  }
+
+  /**
+   * @brief computeCrossProducts Areas and unit normals both come from (v1 - v0) x (v2 - v0); a
+   * degenerate triangle gets a zero normal
+   */
+  void computeCrossProducts(size_t count, const TriangleBatch& batch) const
+  {
+    double cx[k_BatchSize];
+    double cy[k_BatchSize];
+    double cz[k_BatchSize];
+    double mag[k_BatchSize];
+    for(size_t b = 0; b < count; b++)
+    {
+      double ux = batch.x1[b] - batch.x0[b];
+      double uy = batch.y1[b] - batch.y0[b];
+      double uz = batch.z1[b] - batch.z0[b];
+      double wx = batch.x2[b] - batch.x0[b];
+      double wy = batch.y2[b] - batch.y0[b];
+      double wz = batch.z2[b] - batch.z0[b];
+      cx[b] = uy * wz - uz * wy;
+      cy[b] = uz * wx - ux * wz;
+      cz[b] = ux * wy - uy * wx;
+      mag[b] = std::sqrt(cx[b] * cx[b] + cy[b] * cy[b] + cz[b] * cz[b]);
+    }
+    if(nullptr != m_Outputs.areas)
+    {
+      for(size_t b = 0; b < count; b++)
+      {
+        m_Outputs.areas[batch.ids[b]] = 0.5 * mag[b];
+      }
+    }
+    if(nullptr != m_Outputs.normals)
+    {
+      for(size_t b = 0; b < count; b++)
+      {
+        double inv = (mag[b] > 0.0) ? 1.0 / mag[b] : 0.0;
+        double* normal = m_Outputs.normals + batch.ids[b] * 3;
+        normal[0] = cx[b] * inv;
+        normal[1] = cy[b] * inv;
+        normal[2] = cz[b] * inv;
+      }
+    }
+  }
+
+  void computeCentroids(size_t count, const TriangleBatch& batch) const
+  {
+    const double third = 1.0 / 3.0;
+    for(size_t b = 0; b < count; b++)
+    {
+      double* centroid = m_Outputs.centroids + batch.ids[b] * 3;
+      centroid[0] = (batch.x0[b] + batch.x1[b] + batch.x2[b]) * third;
+      centroid[1] = (batch.y0[b] + batch.y1[b] + batch.y2[b]) * third;
+      centroid[2] = (batch.z0[b] + batch.z1[b] + batch.z2[b]) * third;
+    }
+  }
+
+  /**
+   * @brief computeMinDihedralAngles The smallest interior angle is the one opposite the shortest
+   * edge, so only that angle is evaluated, with the law of cosines
+   */
+  void computeMinDihedralAngles(size_t count, const TriangleBatch& batch) const
+  {
+    const double radToDeg = 180.0 / SIMPLib::Constants::k_Pi;
+    double cosine[k_BatchSize];
+    for(size_t b = 0; b < count; b++)
+    {
+      double ax = batch.x1[b] - batch.x2[b];
+      double ay = batch.y1[b] - batch.y2[b];
+      double az = batch.z1[b] - batch.z2[b];
+      double bx = batch.x2[b] - batch.x0[b];
+      double by = batch.y2[b] - batch.y0[b];
+      double bz = batch.z2[b] - batch.z0[b];
+      double cx = batch.x0[b] - batch.x1[b];
+      double cy = batch.y0[b] - batch.y1[b];
+      double cz = batch.z0[b] - batch.z1[b];
+      double a2 = ax * ax + ay * ay + az * az;
+      double b2 = bx * bx + by * by + bz * bz;
+      double c2 = cx * cx + cy * cy + cz * cz;
+      double shortest = std::min(a2, std::min(b2, c2));
+      double product = (a2 == shortest) ? b2 * c2 : ((b2 == shortest) ? a2 * c2 : a2 * b2);
+      double others = a2 + b2 + c2 - shortest;
+      double denominator = 2.0 * std::sqrt(product);
+      double value = (denominator > 0.0) ? (others - shortest) / denominator : 1.0;
+      cosine[b] = std::max(-1.0, std::min(1.0, value));
+    }
+    for(size_t b = 0; b < count; b++)
+    {
+      m_Outputs.minDihedralAngles[batch.ids[b]] = radToDeg * std::acos(cosine[b]);
+    }
+  }
+
+  /**
+   * @brief computeSignedVolumes Volume of the tetrahedron with the triangle as base and the origin
+   * as apex, det([v1 - v0, v2 - v0, -v0]) / 6
+   */
+  void computeSignedVolumes(size_t count, const TriangleBatch& batch) const
+  {
+    for(size_t b = 0; b < count; b++)
+    {
+      double ux = batch.x1[b] - batch.x0[b];
+      double uy = batch.y1[b] - batch.y0[b];
+      double uz = batch.z1[b] - batch.z0[b];
+      double wx = batch.x2[b] - batch.x0[b];
+      double wy = batch.y2[b] - batch.y0[b];
+      double wz = batch.z2[b] - batch.z0[b];
+      double det = ux * (wy * -batch.z0[b] - wz * -batch.y0[b]) - wx * (uy * -batch.z0[b] - uz * -batch.y0[b]) + -batch.x0[b] * (uy * wz - uz * wy);
+      m_Outputs.signedVolumes[batch.ids[b]] = det / 6.0;
+    }
+  }
+
+  /**
+   * @brief computeFeatureMoments The tetrahedron spanned by a triangle and a Feature centroid is
+   * split at its edge midpoints into 8 smaller tetrahedra, and each of them contributes its volume
+   * times the moment arm of its own centroid
+   */
+  void computeFeatureMoments(size_t count, const TriangleBatch& batch) const
+  {
+    // Corners of the sub tetrahedra: the 3 triangle vertices, the centroid, the midpoints between
+    // the centroid and each vertex, then the midpoints of the triangle edges 01, 12 and 20
+    static const int32_t k_Tets[8][4] = {{4, 5, 6, 3}, {0, 7, 9, 4}, {1, 8, 7, 5}, {2, 9, 8, 6}, {7, 5, 6, 4}, {6, 9, 7, 4}, {6, 5, 7, 8}, {7, 9, 6, 8}};
+    for(size_t b = 0; b < count; b++)
+    {
+      const int64_t id = batch.ids[b];
+      for(size_t side = 0; side < 2; side++)
+      {
+        double* moments = m_Outputs.featureMoments + id * 12 + side * 6;
+        std::fill(moments, moments + 6, 0.0);
+        int32_t feature = m_FaceLabels[id * 2 + side];
+        if(feature <= 0)
+        {
+          continue;
+        }
+        // Work relative to the centroid, which puts it at the origin
+        const float* centroid = m_FeatureCentroids + feature * 3;
+        const double tri[3][3] = {{batch.x0[b] - centroid[0], batch.y0[b] - centroid[1], batch.z0[b] - centroid[2]},
+                                  {batch.x1[b] - centroid[0], batch.y1[b] - centroid[1], batch.z1[b] - centroid[2]},
+                                  {batch.x2[b] - centroid[0], batch.y2[b] - centroid[1], batch.z2[b] - centroid[2]}};
+        const size_t v1 = (side == 0) ? 1 : 2;
+        const size_t v2 = (side == 0) ? 2 : 1;
+        double coords[10][3];
+        for(size_t d = 0; d < 3; d++)
+        {
+          coords[0][d] = tri[0][d];
+          coords[1][d] = tri[v1][d];
+          coords[2][d] = tri[v2][d];
+          coords[3][d] = 0.0;
+          coords[4][d] = 0.5 * coords[0][d];
+          coords[5][d] = 0.5 * coords[1][d];
+          coords[6][d] = 0.5 * coords[2][d];
+          coords[7][d] = 0.5 * (coords[0][d] + coords[1][d]);
+          coords[8][d] = 0.5 * (coords[1][d] + coords[2][d]);
+          coords[9][d] = 0.5 * (coords[2][d] + coords[0][d]);
+        }
+        for(size_t t = 0; t < 8; t++)
+        {
+          const double* p0 = coords[k_Tets[t][0]];
+          const double* p1 = coords[k_Tets[t][1]];
+          const double* p2 = coords[k_Tets[t][2]];
+          const double* p3 = coords[k_Tets[t][3]];
+          double ux = p1[0] - p0[0];
+          double uy = p1[1] - p0[1];
+          double uz = p1[2] - p0[2];
+          double vx = p2[0] - p0[0];
+          double vy = p2[1] - p0[1];
+          double vz = p2[2] - p0[2];
+          double wx = p3[0] - p0[0];
+          double wy = p3[1] - p0[1];
+          double wz = p3[2] - p0[2];
+          double volume = (ux * (vy * wz - vz * wy) - vx * (uy * wz - uz * wy) + wx * (uy * vz - uz * vy)) / 6.0;
+          double x = 0.25 * (p0[0] + p1[0] + p2[0] + p3[0]);
+          double y = 0.25 * (p0[1] + p1[1] + p2[1] + p3[1]);
+          double z = 0.25 * (p0[2] + p1[2] + p2[2] + p3[2]);
+          moments[0] += (y * y + z * z) * volume;
+          moments[1] += (x * x + z * z) * volume;
+          moments[2] += (x * x + y * y) * volume;
+          moments[3] += x * y * volume;
+          moments[4] += y * z * volume;
+          moments[5] += x * z * volume;
+        }
+      }
+    }
+  }
+};
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+TriangleMetrics::TriangleMetrics() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+TriangleMetrics::~TriangleMetrics() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TriangleMetrics::compute(const float* vertices, const int64_t* triangles, size_t numTris, const Outputs& outputs, const int32_t* faceLabels, const float* featureCentroids)
+{
+  size_t numBatches = (numTris + k_BatchSize - 1) / k_BatchSize;
+  TriangleMetricsImpl body(vertices, triangles, numTris, outputs, faceLabels, featureCentroids);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numBatches), body, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    body.convert(0, numBatches);
+  }
+}
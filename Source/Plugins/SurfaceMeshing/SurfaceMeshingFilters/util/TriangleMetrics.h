@@ -0,0 +1,95 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#include "SIMPLib/SIMPLib.h"
+
+/**
+ * @brief The TriangleMetrics class computes per triangle quantities of a triangle mesh in a single
+ * parallel sweep. The vertices are gathered a batch of triangles at a time into contiguous
+ * coordinate arrays and every requested output is computed from the same batch, so asking for
+ * several outputs costs about one pass over the mesh. Only the outputs that are given an array
+ * are computed, in double precision.
+ */
+class TriangleMetrics
+{
+  public:
+    /**
+     * @brief The Outputs struct holds the arrays to fill; a nullptr array is not computed
+     */
+    struct Outputs
+    {
+      double* areas = nullptr;             //!< 1 value per triangle
+      double* normals = nullptr;           //!< 3 values per triangle, unit length, following the winding
+      double* centroids = nullptr;         //!< 3 values per triangle
+      double* minDihedralAngles = nullptr; //!< 1 value per triangle, smallest interior angle in degrees
+      double* signedVolumes = nullptr;     //!< 1 value per triangle, volume of the tetrahedron spanned with the origin
+      double* featureMoments = nullptr;    //!< 12 values per triangle, the second moments of the tetrahedra spanned with the Feature centroids
+    };
+
+    virtual ~TriangleMetrics();
+
+    /**
+     * @brief compute Fills the requested outputs
+     * @param vertices Shared vertex list, 3 floats per vertex
+     * @param triangles Triangle list, 3 vertex ids per triangle
+     * @param numTris Number of triangles
+     * @param outputs Arrays to fill
+     * @param faceLabels 2 Feature ids per triangle, only needed for the feature moments
+     * @param featureCentroids 3 values per Feature, only needed for the feature moments
+     *
+     * The feature moments of a triangle are 6 values for each side: the integrals of y^2 + z^2,
+     * x^2 + z^2, x^2 + y^2, xy, yz and xz, relative to the centroid of the Feature on that side,
+     * over the tetrahedron the triangle spans with that centroid. The triangle is taken with its
+     * winding for the first side and reversed for the second, and a side whose label is not
+     * positive gets zeros.
+     */
+    static void compute(const float* vertices, const int64_t* triangles, size_t numTris, const Outputs& outputs, const int32_t* faceLabels = nullptr,
+                        const float* featureCentroids = nullptr);
+
+  protected:
+    TriangleMetrics();
+
+  public:
+    TriangleMetrics(const TriangleMetrics&) = delete;            // Copy Constructor Not Implemented
+    TriangleMetrics(TriangleMetrics&&) = delete;                 // Move Constructor Not Implemented
+    TriangleMetrics& operator=(const TriangleMetrics&) = delete; // Copy Assignment Not Implemented
+    TriangleMetrics& operator=(TriangleMetrics&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,292 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "SurfaceMeshingTestFileLocations.h"
+
+class FeatureFaceCurvatureFilterTest
+{
+
+public:
+  FeatureFaceCurvatureFilterTest() = default;
+  ~FeatureFaceCurvatureFilterTest() = default;
+
+  SIMPL_TYPE_MACRO(FeatureFaceCurvatureFilterTest)
+  FeatureFaceCurvatureFilterTest(const FeatureFaceCurvatureFilterTest&) = delete;            // Copy Constructor Not Implemented
+  FeatureFaceCurvatureFilterTest(FeatureFaceCurvatureFilterTest&&) = delete;                 // Move Constructor Not Implemented
+  FeatureFaceCurvatureFilterTest& operator=(const FeatureFaceCurvatureFilterTest&) = delete; // Copy Assignment Not Implemented
+  FeatureFaceCurvatureFilterTest& operator=(FeatureFaceCurvatureFilterTest&&) = delete;      // Move Assignment Not Implemented
+
+  enum class Surface
+  {
+    Cylinder,
+    Sphere
+  };
+
+  // Number of vertices around the circumference of the surface
+  const size_t k_NumColumns = 96;
+  // Rows of triangles next to the open edges of the surface whose N-ring patches are one sided
+  const size_t k_BorderRows = 4;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the FeatureFaceCurvatureFilter Filter from the FilterManager
+    QString filtName = "FeatureFaceCurvatureFilter";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The SurfaceMeshing Requires the use of the " << filtName.toStdString() << " filter which is found in the SurfaceMeshing Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Triangulates a closed band around the z axis: the side of a cylinder of the given radius, or
+  // the band of a sphere of the given radius between latitudes of +/- 45 degrees. The vertex rows
+  // are as far apart as the columns and every triangle is wound so its normal points outwards.
+  // All triangles belong to the single Feature Face between Features 1 and 2.
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createSurface(Surface surface, double radius, size_t numRows)
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer tdc = DataContainer::New(SIMPL::Defaults::TriangleDataContainerName);
+    dca->addOrReplaceDataContainer(tdc);
+
+    size_t numVerts = numRows * k_NumColumns;
+    size_t numTris = 2 * (numRows - 1) * k_NumColumns;
+    SharedVertexList::Pointer vertex = TriangleGeom::CreateSharedVertexList(numVerts);
+    TriangleGeom::Pointer triangle = TriangleGeom::CreateGeometry(numTris, vertex, SIMPL::Geometry::TriangleGeometry);
+    tdc->setGeometry(triangle);
+    float* vertices = triangle->getVertexPointer(0);
+    int64_t* tris = triangle->getTriPointer(0);
+
+    double step = SIMPLib::Constants::k_2Pi / static_cast<double>(k_NumColumns);
+    for(size_t j = 0; j < numRows; j++)
+    {
+      for(size_t i = 0; i < k_NumColumns; i++)
+      {
+        double theta = static_cast<double>(i) * step;
+        double height = static_cast<double>(j) * step * radius;
+        double ringRadius = radius;
+        if(surface == Surface::Sphere)
+        {
+          double phi = (static_cast<double>(j) - 0.5 * static_cast<double>(numRows - 1)) * step;
+          height = radius * std::sin(phi);
+          ringRadius = radius * std::cos(phi);
+        }
+        size_t v = j * k_NumColumns + i;
+        vertices[3 * v + 0] = static_cast<float>(ringRadius * std::cos(theta));
+        vertices[3 * v + 1] = static_cast<float>(ringRadius * std::sin(theta));
+        vertices[3 * v + 2] = static_cast<float>(height);
+      }
+    }
+
+    size_t t = 0;
+    for(size_t j = 0; j < numRows - 1; j++)
+    {
+      for(size_t i = 0; i < k_NumColumns; i++)
+      {
+        int64_t v0 = static_cast<int64_t>(j * k_NumColumns + i);
+        int64_t v1 = static_cast<int64_t>(j * k_NumColumns + (i + 1) % k_NumColumns);
+        int64_t v2 = v0 + static_cast<int64_t>(k_NumColumns);
+        int64_t v3 = v1 + static_cast<int64_t>(k_NumColumns);
+        tris[3 * t + 0] = v0;
+        tris[3 * t + 1] = v1;
+        tris[3 * t + 2] = v3;
+        t++;
+        tris[3 * t + 0] = v0;
+        tris[3 * t + 1] = v3;
+        tris[3 * t + 2] = v2;
+        t++;
+      }
+    }
+
+    QVector<size_t> tDims(1, numTris);
+    AttributeMatrix::Pointer faceAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::FaceAttributeMatrixName, AttributeMatrix::Type::Face);
+    tdc->addOrReplaceAttributeMatrix(faceAttrMat);
+    QVector<size_t> cDims(1, 2);
+    Int32ArrayType::Pointer faceLabels = Int32ArrayType::CreateArray(numTris, cDims, SIMPL::FaceData::SurfaceMeshFaceLabels);
+    faceAttrMat->insertOrAssign(faceLabels);
+    cDims[0] = 1;
+    Int32ArrayType::Pointer featureFaceIds = Int32ArrayType::CreateArray(numTris, cDims, SIMPL::FaceData::SurfaceMeshFeatureFaceId);
+    faceAttrMat->insertOrAssign(featureFaceIds);
+    cDims[0] = 3;
+    DoubleArrayType::Pointer normals = DoubleArrayType::CreateArray(numTris, cDims, SIMPL::FaceData::SurfaceMeshFaceNormals);
+    faceAttrMat->insertOrAssign(normals);
+    DoubleArrayType::Pointer centroids = DoubleArrayType::CreateArray(numTris, cDims, SIMPL::FaceData::SurfaceMeshFaceCentroids);
+    faceAttrMat->insertOrAssign(centroids);
+
+    for(size_t i = 0; i < numTris; i++)
+    {
+      faceLabels->setComponent(i, 0, 1);
+      faceLabels->setComponent(i, 1, 2);
+      featureFaceIds->setValue(i, 1);
+
+      float* p0 = vertices + 3 * tris[3 * i + 0];
+      float* p1 = vertices + 3 * tris[3 * i + 1];
+      float* p2 = vertices + 3 * tris[3 * i + 2];
+      double a[3] = {0.0, 0.0, 0.0};
+      double b[3] = {0.0, 0.0, 0.0};
+      for(size_t d = 0; d < 3; d++)
+      {
+        centroids->setComponent(i, d, (static_cast<double>(p0[d]) + p1[d] + p2[d]) / 3.0);
+        a[d] = static_cast<double>(p1[d]) - p0[d];
+        b[d] = static_cast<double>(p2[d]) - p0[d];
+      }
+      double n[3] = {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]};
+      double length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+      for(size_t d = 0; d < 3; d++)
+      {
+        normals->setComponent(i, d, n[d] / length);
+      }
+    }
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  // A cylinder of radius R has principal curvatures 1/R and 0, a sphere 1/R and 1/R. The fit uses
+  // the triangle centroids, which lie slightly inside the surface, so the computed values are held
+  // to 5% of 1/R. The tolerance is relative, so the same meshes scaled from sub micron to
+  // kilometer sizes must pass, which they only do when the least squares fit is well conditioned.
+  // -----------------------------------------------------------------------------
+  int TestKnownCurvatures(Surface surface, double radius, bool useNormalsForCurveFitting)
+  {
+    size_t numRows = (surface == Surface::Cylinder) ? 40 : 25;
+    DataContainerArray::Pointer dca = createSurface(surface, radius, numRows);
+
+    QString filtName = "FeatureFaceCurvatureFilter";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName(filtName);
+    DREAM3D_REQUIRE(factory.get() != nullptr)
+
+    AbstractFilter::Pointer filter = factory->create();
+    DREAM3D_REQUIRE(filter.get() != nullptr)
+    filter->setDataContainerArray(dca);
+
+    bool propWasSet = filter->setProperty("NRing", 3);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    propWasSet = filter->setProperty("ComputePrincipalDirectionVectors", true);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    propWasSet = filter->setProperty("ComputeMeanCurvature", true);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    propWasSet = filter->setProperty("ComputeGaussianCurvature", true);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    propWasSet = filter->setProperty("UseNormalsForCurveFitting", useNormalsForCurveFitting);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+
+    AttributeMatrix::Pointer faceAttrMat = dca->getDataContainer(SIMPL::Defaults::TriangleDataContainerName)->getAttributeMatrix(SIMPL::Defaults::FaceAttributeMatrixName);
+    DoubleArrayType::Pointer kappa1 = faceAttrMat->getAttributeArrayAs<DoubleArrayType>(SIMPL::FaceData::SurfaceMeshPrincipalCurvature1);
+    DoubleArrayType::Pointer kappa2 = faceAttrMat->getAttributeArrayAs<DoubleArrayType>(SIMPL::FaceData::SurfaceMeshPrincipalCurvature2);
+    DoubleArrayType::Pointer direction1 = faceAttrMat->getAttributeArrayAs<DoubleArrayType>(SIMPL::FaceData::SurfaceMeshPrincipalDirection1);
+    DoubleArrayType::Pointer gaussian = faceAttrMat->getAttributeArrayAs<DoubleArrayType>(SIMPL::FaceData::SurfaceMeshGaussianCurvatures);
+    DoubleArrayType::Pointer mean = faceAttrMat->getAttributeArrayAs<DoubleArrayType>(SIMPL::FaceData::SurfaceMeshMeanCurvatures);
+    DREAM3D_REQUIRE_VALID_POINTER(kappa1.get())
+    DREAM3D_REQUIRE_VALID_POINTER(kappa2.get())
+    DREAM3D_REQUIRE_VALID_POINTER(direction1.get())
+    DREAM3D_REQUIRE_VALID_POINTER(gaussian.get())
+    DREAM3D_REQUIRE_VALID_POINTER(mean.get())
+
+    double expected1 = 1.0 / radius;
+    double expected2 = (surface == Surface::Cylinder) ? 0.0 : 1.0 / radius;
+    double tolerance = 0.05 / radius;
+    size_t trisPerRow = 2 * k_NumColumns;
+    size_t numTris = kappa1->getNumberOfTuples();
+    for(size_t t = k_BorderRows * trisPerRow; t < numTris - k_BorderRows * trisPerRow; t++)
+    {
+      double k1 = kappa1->getValue(t);
+      double k2 = kappa2->getValue(t);
+      DREAM3D_REQUIRE(k1 >= k2)
+      DREAM3D_REQUIRE(std::fabs(k1 - expected1) < tolerance)
+      DREAM3D_REQUIRE(std::fabs(k2 - expected2) < tolerance)
+      DREAM3D_REQUIRE(std::fabs(gaussian->getValue(t) - k1 * k2) <= 1.0E-12 * expected1 * expected1)
+      DREAM3D_REQUIRE(std::fabs(mean->getValue(t) - 0.5 * (k1 + k2)) <= 1.0E-12 * expected1)
+
+      // The direction of maximum curvature of a cylinder runs around its axis
+      if(surface == Surface::Cylinder)
+      {
+        DREAM3D_REQUIRE(std::fabs(direction1->getComponent(t, 2)) < 0.02)
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "---- " << getNameOfClass().toStdString() << " ----" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    for(double radius : {5.0E-4, 5.0, 5.0E4})
+    {
+      for(bool useNormals : {false, true})
+      {
+        DREAM3D_REGISTER_TEST(TestKnownCurvatures(Surface::Cylinder, radius, useNormals))
+        DREAM3D_REGISTER_TEST(TestKnownCurvatures(Surface::Sphere, radius, useNormals))
+      }
+    }
+  }
+};
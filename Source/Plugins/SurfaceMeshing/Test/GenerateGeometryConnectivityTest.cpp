@@ -0,0 +1,431 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/HexahedralGeom.h"
+#include "SIMPLib/Geometry/QuadGeom.h"
+#include "SIMPLib/Geometry/TetrahedralGeom.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "SurfaceMeshingTestFileLocations.h"
+
+class GenerateGeometryConnectivityTest
+{
+
+public:
+  GenerateGeometryConnectivityTest() = default;
+  ~GenerateGeometryConnectivityTest() = default;
+
+  SIMPL_TYPE_MACRO(GenerateGeometryConnectivityTest)
+  GenerateGeometryConnectivityTest(const GenerateGeometryConnectivityTest&) = delete;            // Copy Constructor Not Implemented
+  GenerateGeometryConnectivityTest(GenerateGeometryConnectivityTest&&) = delete;                 // Move Constructor Not Implemented
+  GenerateGeometryConnectivityTest& operator=(const GenerateGeometryConnectivityTest&) = delete; // Copy Assignment Not Implemented
+  GenerateGeometryConnectivityTest& operator=(GenerateGeometryConnectivityTest&&) = delete;      // Move Assignment Not Implemented
+
+  typedef std::vector<std::vector<int64_t>> Lists_t;
+
+  // Number of cells along each side of the test grids
+  const int64_t k_GridSize = 12;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the GenerateGeometryConnectivity Filter from the FilterManager
+    QString filtName = "GenerateGeometryConnectivity";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The SurfaceMeshing Requires the use of the " << filtName.toStdString() << " filter which is found in the SurfaceMeshing Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int64_t vertexId(int64_t i, int64_t j, int64_t k)
+  {
+    return (k * (k_GridSize + 1) + j) * (k_GridSize + 1) + i;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Returns the element list of a grid of the given geometry type: two triangles or one quad
+  // per square of a flat grid, or one hexahedron or five tetrahedra per cube of a block.
+  // -----------------------------------------------------------------------------
+  std::vector<int64_t> createElements(IGeometry::Type type, size_t& numVerts)
+  {
+    std::vector<int64_t> elements;
+    if(type == IGeometry::Type::Triangle || type == IGeometry::Type::Quad)
+    {
+      numVerts = static_cast<size_t>((k_GridSize + 1) * (k_GridSize + 1));
+      for(int64_t j = 0; j < k_GridSize; j++)
+      {
+        for(int64_t i = 0; i < k_GridSize; i++)
+        {
+          int64_t v0 = vertexId(i, j, 0);
+          int64_t v1 = vertexId(i + 1, j, 0);
+          int64_t v2 = vertexId(i + 1, j + 1, 0);
+          int64_t v3 = vertexId(i, j + 1, 0);
+          if(type == IGeometry::Type::Triangle)
+          {
+            elements.insert(elements.end(), {v0, v1, v2, v0, v2, v3});
+          }
+          else
+          {
+            elements.insert(elements.end(), {v0, v1, v2, v3});
+          }
+        }
+      }
+      return elements;
+    }
+
+    numVerts = static_cast<size_t>((k_GridSize + 1) * (k_GridSize + 1) * (k_GridSize + 1));
+    const int64_t tetCorners[5][4] = {{0, 1, 3, 4}, {1, 2, 3, 6}, {1, 3, 4, 6}, {3, 4, 6, 7}, {1, 4, 5, 6}};
+    for(int64_t k = 0; k < k_GridSize; k++)
+    {
+      for(int64_t j = 0; j < k_GridSize; j++)
+      {
+        for(int64_t i = 0; i < k_GridSize; i++)
+        {
+          int64_t corners[8] = {vertexId(i, j, k),         vertexId(i + 1, j, k),         vertexId(i + 1, j + 1, k),     vertexId(i, j + 1, k),
+                                vertexId(i, j, k + 1),     vertexId(i + 1, j, k + 1),     vertexId(i + 1, j + 1, k + 1), vertexId(i, j + 1, k + 1)};
+          if(type == IGeometry::Type::Hexahedral)
+          {
+            elements.insert(elements.end(), corners, corners + 8);
+          }
+          else
+          {
+            for(size_t t = 0; t < 5; t++)
+            {
+              for(size_t c = 0; c < 4; c++)
+              {
+                elements.push_back(corners[tetCorners[t][c]]);
+              }
+            }
+          }
+        }
+      }
+    }
+    return elements;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  size_t verticesPerElement(IGeometry::Type type)
+  {
+    switch(type)
+    {
+    case IGeometry::Type::Triangle:
+      return 3;
+    case IGeometry::Type::Hexahedral:
+      return 8;
+    default:
+      return 4;
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  size_t sharedVerticesOfNeighbors(IGeometry::Type type)
+  {
+    switch(type)
+    {
+    case IGeometry::Type::Tetrahedral:
+      return 3;
+    case IGeometry::Type::Hexahedral:
+      return 4;
+    default:
+      return 2;
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  IGeometry::Pointer createGeometry(IGeometry::Type type, const std::vector<int64_t>& elements, size_t numVerts)
+  {
+    size_t numElements = elements.size() / verticesPerElement(type);
+    SharedVertexList::Pointer vertices = TriangleGeom::CreateSharedVertexList(static_cast<int64_t>(numVerts));
+    vertices->initializeWithZeros();
+    IGeometry::Pointer geom;
+    int64_t* elementPtr = nullptr;
+    switch(type)
+    {
+    case IGeometry::Type::Triangle:
+    {
+      TriangleGeom::Pointer tris = TriangleGeom::CreateGeometry(static_cast<int64_t>(numElements), vertices, SIMPL::Geometry::TriangleGeometry);
+      elementPtr = tris->getTriPointer(0);
+      geom = tris;
+      break;
+    }
+    case IGeometry::Type::Quad:
+    {
+      QuadGeom::Pointer quads = QuadGeom::CreateGeometry(static_cast<int64_t>(numElements), vertices, SIMPL::Geometry::QuadGeometry);
+      elementPtr = quads->getQuadPointer(0);
+      geom = quads;
+      break;
+    }
+    case IGeometry::Type::Tetrahedral:
+    {
+      TetrahedralGeom::Pointer tets = TetrahedralGeom::CreateGeometry(static_cast<int64_t>(numElements), vertices, SIMPL::Geometry::TetrahedralGeometry);
+      elementPtr = tets->getTetPointer(0);
+      geom = tets;
+      break;
+    }
+    default:
+    {
+      HexahedralGeom::Pointer hexas = HexahedralGeom::CreateGeometry(static_cast<int64_t>(numElements), vertices, SIMPL::Geometry::HexahedralGeometry);
+      elementPtr = hexas->getHexPointer(0);
+      geom = hexas;
+      break;
+    }
+    }
+    std::copy(elements.begin(), elements.end(), elementPtr);
+    return geom;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The serial definition of the lists: every vertex lists its elements in ascending order,
+  // and every element lists the elements sharing at least numShared of its vertices in the
+  // order they are first met walking its vertices and their element lists.
+  // -----------------------------------------------------------------------------
+  void findReferenceLists(const std::vector<int64_t>& elements, size_t vertsPerElem, size_t numShared, size_t numVerts, Lists_t& vertLists, Lists_t& neighborLists)
+  {
+    size_t numElements = elements.size() / vertsPerElem;
+    vertLists.assign(numVerts, std::vector<int64_t>());
+    for(size_t e = 0; e < numElements; e++)
+    {
+      for(size_t v = 0; v < vertsPerElem; v++)
+      {
+        vertLists[elements[e * vertsPerElem + v]].push_back(static_cast<int64_t>(e));
+      }
+    }
+
+    neighborLists.assign(numElements, std::vector<int64_t>());
+    for(size_t e = 0; e < numElements; e++)
+    {
+      std::vector<int64_t> visited;
+      for(size_t v = 0; v < vertsPerElem; v++)
+      {
+        for(int64_t other : vertLists[elements[e * vertsPerElem + v]])
+        {
+          if(other == static_cast<int64_t>(e) || std::find(visited.begin(), visited.end(), other) != visited.end())
+          {
+            continue;
+          }
+          visited.push_back(other);
+          size_t shared = 0;
+          for(size_t i = 0; i < vertsPerElem; i++)
+          {
+            const int64_t* elem = elements.data() + e * vertsPerElem;
+            if(std::find(elem, elem + vertsPerElem, elements[other * vertsPerElem + i]) != elem + vertsPerElem)
+            {
+              shared++;
+            }
+          }
+          if(shared >= numShared)
+          {
+            neighborLists[e].push_back(other);
+          }
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int CompareLists(const ElementDynamicList::Pointer& lists, const Lists_t& expected)
+  {
+    DREAM3D_REQUIRE_VALID_POINTER(lists.get())
+    DREAM3D_REQUIRE_EQUAL(lists->size(), expected.size())
+    for(size_t i = 0; i < expected.size(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(static_cast<size_t>(lists->getNumberOfElements(i)), expected[i].size())
+      DREAM3D_REQUIRE(std::equal(expected[i].begin(), expected[i].end(), lists->getElementListPointer(i)))
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int RunFilter(DataContainerArray::Pointer dca, const QString& dcName)
+  {
+    QString filtName = "GenerateGeometryConnectivity";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName(filtName);
+    DREAM3D_REQUIRE(factory.get() != nullptr)
+
+    AbstractFilter::Pointer filter = factory->create();
+    DREAM3D_REQUIRE(filter.get() != nullptr)
+    filter->setDataContainerArray(dca);
+
+    QVariant var;
+    var.setValue(DataArrayPath(dcName, "", ""));
+    bool propWasSet = filter->setProperty("SurfaceDataContainerName", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    propWasSet = filter->setProperty("GenerateVertexTriangleLists", true);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    propWasSet = filter->setProperty("GenerateTriangleNeighbors", true);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestMatchesSerialLists(IGeometry::Type type)
+  {
+    size_t numVerts = 0;
+    std::vector<int64_t> elements = createElements(type, numVerts);
+    IGeometry::Pointer geom = createGeometry(type, elements, numVerts);
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New("Mesh");
+    dc->setGeometry(geom);
+    dca->addOrReplaceDataContainer(dc);
+
+    int err = RunFilter(dca, "Mesh");
+    DREAM3D_REQUIRE_EQUAL(err, EXIT_SUCCESS)
+
+    Lists_t vertLists;
+    Lists_t neighborLists;
+    findReferenceLists(elements, verticesPerElement(type), sharedVerticesOfNeighbors(type), numVerts, vertLists, neighborLists);
+    err = CompareLists(geom->getElementsContainingVert(), vertLists);
+    DREAM3D_REQUIRE_EQUAL(err, EXIT_SUCCESS)
+    err = CompareLists(geom->getElementNeighbors(), neighborLists);
+    DREAM3D_REQUIRE_EQUAL(err, EXIT_SUCCESS)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Two meshes with identical topology each get their own lists, and running the filter
+  // again after the triangles of one mesh changed must rebuild its lists. The change flips
+  // the diagonal of every square in one row, so the number of triangles, the vertices they
+  // use and the sum of all vertex ids stay the same.
+  // -----------------------------------------------------------------------------
+  int TestRebuildsChangedTopology()
+  {
+    size_t numVerts = 0;
+    std::vector<int64_t> elements = createElements(IGeometry::Type::Triangle, numVerts);
+    IGeometry::Pointer geom0 = createGeometry(IGeometry::Type::Triangle, elements, numVerts);
+    IGeometry::Pointer geom1 = createGeometry(IGeometry::Type::Triangle, elements, numVerts);
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc0 = DataContainer::New("Mesh0");
+    dc0->setGeometry(geom0);
+    dca->addOrReplaceDataContainer(dc0);
+    DataContainer::Pointer dc1 = DataContainer::New("Mesh1");
+    dc1->setGeometry(geom1);
+    dca->addOrReplaceDataContainer(dc1);
+
+    int err = RunFilter(dca, "Mesh0");
+    DREAM3D_REQUIRE_EQUAL(err, EXIT_SUCCESS)
+    err = RunFilter(dca, "Mesh1");
+    DREAM3D_REQUIRE_EQUAL(err, EXIT_SUCCESS)
+    DREAM3D_REQUIRE(geom0->getElementsContainingVert() != geom1->getElementsContainingVert())
+    DREAM3D_REQUIRE(geom0->getElementNeighbors() != geom1->getElementNeighbors())
+
+    // (v0, v1, v2), (v0, v2, v3) becomes (v0, v1, v3), (v1, v2, v3)
+    int64_t* tris = std::dynamic_pointer_cast<TriangleGeom>(geom0)->getTriPointer(0);
+    for(int64_t i = 0; i < k_GridSize; i++)
+    {
+      int64_t* t = tris + 6 * i;
+      int64_t v0 = t[0];
+      int64_t v1 = t[1];
+      int64_t v2 = t[2];
+      int64_t v3 = t[5];
+      int64_t flipped[6] = {v0, v1, v3, v1, v2, v3};
+      std::copy(flipped, flipped + 6, t);
+      std::copy(flipped, flipped + 6, elements.begin() + 6 * i);
+    }
+
+    err = RunFilter(dca, "Mesh0");
+    DREAM3D_REQUIRE_EQUAL(err, EXIT_SUCCESS)
+
+    Lists_t vertLists;
+    Lists_t neighborLists;
+    findReferenceLists(elements, 3, 2, numVerts, vertLists, neighborLists);
+    err = CompareLists(geom0->getElementsContainingVert(), vertLists);
+    DREAM3D_REQUIRE_EQUAL(err, EXIT_SUCCESS)
+    err = CompareLists(geom0->getElementNeighbors(), neighborLists);
+    DREAM3D_REQUIRE_EQUAL(err, EXIT_SUCCESS)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "---- " << getNameOfClass().toStdString() << " ----" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestMatchesSerialLists(IGeometry::Type::Triangle))
+    DREAM3D_REGISTER_TEST(TestMatchesSerialLists(IGeometry::Type::Quad))
+    DREAM3D_REGISTER_TEST(TestMatchesSerialLists(IGeometry::Type::Tetrahedral))
+    DREAM3D_REGISTER_TEST(TestMatchesSerialLists(IGeometry::Type::Hexahedral))
+    DREAM3D_REGISTER_TEST(TestRebuildsChangedTopology())
+  }
+};
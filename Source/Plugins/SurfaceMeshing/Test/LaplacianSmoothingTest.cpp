@@ -0,0 +1,317 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "SurfaceMeshingTestFileLocations.h"
+
+class LaplacianSmoothingTest
+{
+
+public:
+  LaplacianSmoothingTest() = default;
+  ~LaplacianSmoothingTest() = default;
+
+  SIMPL_TYPE_MACRO(LaplacianSmoothingTest)
+  LaplacianSmoothingTest(const LaplacianSmoothingTest&) = delete;            // Copy Constructor Not Implemented
+  LaplacianSmoothingTest(LaplacianSmoothingTest&&) = delete;                 // Move Constructor Not Implemented
+  LaplacianSmoothingTest& operator=(const LaplacianSmoothingTest&) = delete; // Copy Assignment Not Implemented
+  LaplacianSmoothingTest& operator=(LaplacianSmoothingTest&&) = delete;      // Move Assignment Not Implemented
+
+  const size_t k_GridSize = 24;
+  const float k_Lambda = 0.2f;
+  const float k_TripleLineLambda = 0.1f;
+  const float k_QuadPointLambda = 0.05f;
+  const float k_SurfacePointLambda = 0.15f;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the LaplacianSmoothing Filter from the FilterManager
+    QString filtName = "LaplacianSmoothing";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The SurfaceMeshing Requires the use of the " << filtName.toStdString() << " filter which is found in the SurfaceMeshing Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Builds a bumpy, triangulated square sheet. The border vertices are marked as
+  // surface points and a pattern of interior vertices as triple lines and quad points
+  // so every lambda of the filter is exercised.
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createSheet()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer tdc = DataContainer::New(SIMPL::Defaults::TriangleDataContainerName);
+    dca->addOrReplaceDataContainer(tdc);
+
+    size_t numVerts = k_GridSize * k_GridSize;
+    size_t numTris = 2 * (k_GridSize - 1) * (k_GridSize - 1);
+    SharedVertexList::Pointer vertex = TriangleGeom::CreateSharedVertexList(numVerts);
+    TriangleGeom::Pointer triangle = TriangleGeom::CreateGeometry(numTris, vertex, SIMPL::Geometry::TriangleGeometry);
+    tdc->setGeometry(triangle);
+    float* vertices = triangle->getVertexPointer(0);
+    int64_t* tris = triangle->getTriPointer(0);
+
+    QVector<size_t> tDims(1, numVerts);
+    AttributeMatrix::Pointer vertAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::VertexAttributeMatrixName, AttributeMatrix::Type::Vertex);
+    tdc->addOrReplaceAttributeMatrix(vertAttrMat);
+    QVector<size_t> cDims(1, 1);
+    Int8ArrayType::Pointer nodeTypes = Int8ArrayType::CreateArray(numVerts, cDims, SIMPL::VertexData::SurfaceMeshNodeType);
+    vertAttrMat->insertOrAssign(nodeTypes);
+
+    for(size_t j = 0; j < k_GridSize; j++)
+    {
+      for(size_t i = 0; i < k_GridSize; i++)
+      {
+        size_t v = j * k_GridSize + i;
+        vertices[3 * v + 0] = static_cast<float>(i) + 0.2f * std::sin(1.3f * j);
+        vertices[3 * v + 1] = static_cast<float>(j) + 0.2f * std::cos(0.7f * i);
+        vertices[3 * v + 2] = 0.5f * std::sin(1.7f * i) * std::cos(2.3f * j) + 0.1f * static_cast<float>((7 * i + 13 * j) % 5);
+
+        int8_t type = SIMPL::SurfaceMesh::NodeType::Default;
+        if(i == 0 || j == 0 || i == k_GridSize - 1 || j == k_GridSize - 1)
+        {
+          type = SIMPL::SurfaceMesh::NodeType::SurfaceDefault;
+        }
+        else if((i + j) % 7 == 0)
+        {
+          type = SIMPL::SurfaceMesh::NodeType::TriplePoint;
+        }
+        else if((i * j) % 11 == 0)
+        {
+          type = SIMPL::SurfaceMesh::NodeType::QuadPoint;
+        }
+        nodeTypes->setValue(v, type);
+      }
+    }
+
+    size_t t = 0;
+    for(size_t j = 0; j < k_GridSize - 1; j++)
+    {
+      for(size_t i = 0; i < k_GridSize - 1; i++)
+      {
+        int64_t v0 = static_cast<int64_t>(j * k_GridSize + i);
+        int64_t v1 = v0 + 1;
+        int64_t v2 = v0 + static_cast<int64_t>(k_GridSize);
+        int64_t v3 = v2 + 1;
+        tris[3 * t + 0] = v0;
+        tris[3 * t + 1] = v1;
+        tris[3 * t + 2] = v3;
+        t++;
+        tris[3 * t + 0] = v0;
+        tris[3 * t + 1] = v3;
+        tris[3 * t + 2] = v2;
+        t++;
+      }
+    }
+
+    tDims[0] = numTris;
+    AttributeMatrix::Pointer faceAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::FaceAttributeMatrixName, AttributeMatrix::Type::Face);
+    tdc->addOrReplaceAttributeMatrix(faceAttrMat);
+    cDims[0] = 2;
+    Int32ArrayType::Pointer faceLabels = Int32ArrayType::CreateArray(numTris, cDims, SIMPL::FaceData::SurfaceMeshFaceLabels);
+    faceAttrMat->insertOrAssign(faceLabels);
+    for(size_t i = 0; i < numTris; i++)
+    {
+      faceLabels->setComponent(i, 0, 1);
+      faceLabels->setComponent(i, 1, 2);
+    }
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The edge scatter the filter used before the CSR gather kernel. Each pass adds the
+  // difference vector of every shared edge to both of its vertices, then moves every
+  // vertex by its lambda times the average difference.
+  // -----------------------------------------------------------------------------
+  void scatterSmoothing(std::vector<float>& verts, const std::vector<float>& lambda, const int64_t* uedges, size_t nedges, int32_t iterationSteps, bool useTaubin, float muFactor)
+  {
+    size_t nvert = lambda.size();
+    std::vector<int32_t> ncon(nvert, 0);
+    std::vector<double> delta(3 * nvert, 0.0);
+
+    int32_t numPasses = useTaubin ? 2 : 1;
+    for(int32_t q = 0; q < iterationSteps; q++)
+    {
+      for(int32_t pass = 0; pass < numPasses; pass++)
+      {
+        for(size_t i = 0; i < nedges; i++)
+        {
+          int64_t in1 = uedges[2 * i];
+          int64_t in2 = uedges[2 * i + 1];
+          for(int32_t j = 0; j < 3; j++)
+          {
+            double dlta = verts[3 * in2 + j] - verts[3 * in1 + j];
+            delta[3 * in1 + j] += dlta;
+            delta[3 * in2 + j] += -1.0 * dlta;
+          }
+          ncon[in1] += 1;
+          ncon[in2] += 1;
+        }
+
+        for(size_t i = 0; i < nvert; i++)
+        {
+          for(int32_t j = 0; j < 3; j++)
+          {
+            size_t in0 = 3 * i + j;
+            double dlta = delta[in0] / ncon[i];
+            float ll = (pass == 0) ? lambda[i] : lambda[i] * muFactor;
+            verts[3 * i + j] += ll * dlta;
+            delta[in0] = 0.0;
+          }
+          ncon[i] = 0;
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestMatchesEdgeScatter(bool useTaubin)
+  {
+    DataContainerArray::Pointer dca = createSheet();
+    DataContainer::Pointer tdc = dca->getDataContainer(SIMPL::Defaults::TriangleDataContainerName);
+    TriangleGeom::Pointer triangle = tdc->getGeometryAs<TriangleGeom>();
+    size_t numVerts = triangle->getNumberOfVertices();
+
+    std::vector<float> expected(triangle->getVertexPointer(0), triangle->getVertexPointer(0) + 3 * numVerts);
+    Int8ArrayType::Pointer nodeTypes = tdc->getAttributeMatrix(SIMPL::Defaults::VertexAttributeMatrixName)->getAttributeArrayAs<Int8ArrayType>(SIMPL::VertexData::SurfaceMeshNodeType);
+    std::vector<float> lambda(numVerts, 0.0f);
+    for(size_t i = 0; i < numVerts; i++)
+    {
+      switch(nodeTypes->getValue(i))
+      {
+      case SIMPL::SurfaceMesh::NodeType::Default:
+        lambda[i] = k_Lambda;
+        break;
+      case SIMPL::SurfaceMesh::NodeType::TriplePoint:
+        lambda[i] = k_TripleLineLambda;
+        break;
+      case SIMPL::SurfaceMesh::NodeType::QuadPoint:
+        lambda[i] = k_QuadPointLambda;
+        break;
+      case SIMPL::SurfaceMesh::NodeType::SurfaceDefault:
+        lambda[i] = k_SurfacePointLambda;
+        break;
+      default:
+        break;
+      }
+    }
+
+    QString filtName = "LaplacianSmoothing";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName(filtName);
+    DREAM3D_REQUIRE(factory.get() != nullptr)
+
+    AbstractFilter::Pointer filter = factory->create();
+    DREAM3D_REQUIRE(filter.get() != nullptr)
+    filter->setDataContainerArray(dca);
+
+    const int32_t iterationSteps = 7;
+    const float muFactor = -1.03f;
+    bool propWasSet = filter->setProperty("IterationSteps", iterationSteps);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    propWasSet = filter->setProperty("Lambda", k_Lambda);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    propWasSet = filter->setProperty("TripleLineLambda", k_TripleLineLambda);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    propWasSet = filter->setProperty("QuadPointLambda", k_QuadPointLambda);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    propWasSet = filter->setProperty("SurfacePointLambda", k_SurfacePointLambda);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    propWasSet = filter->setProperty("UseTaubinSmoothing", useTaubin);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    propWasSet = filter->setProperty("MuFactor", muFactor);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+
+    // The filter generated the shared edge list, so the reference walks exactly the same edges
+    DREAM3D_REQUIRE(triangle->getEdges().get() != nullptr)
+    scatterSmoothing(expected, lambda, triangle->getEdgePointer(0), triangle->getNumberOfEdges(), iterationSteps, useTaubin, muFactor);
+
+    float* smoothed = triangle->getVertexPointer(0);
+    float maxDiff = 0.0f;
+    for(size_t i = 0; i < 3 * numVerts; i++)
+    {
+      maxDiff = std::max(maxDiff, std::fabs(smoothed[i] - expected[i]));
+    }
+    DREAM3D_REQUIRE(maxDiff < 1.0E-5f)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "---- " << getNameOfClass().toStdString() << " ----" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestMatchesEdgeScatter(false))
+    DREAM3D_REGISTER_TEST(TestMatchesEdgeScatter(true))
+  }
+};
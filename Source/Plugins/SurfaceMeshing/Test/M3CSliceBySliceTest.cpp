@@ -0,0 +1,351 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Geometry/MeshStructs.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "SurfaceMeshingTestFileLocations.h"
+
+class M3CSliceBySliceTest
+{
+
+public:
+  M3CSliceBySliceTest() = default;
+  ~M3CSliceBySliceTest() = default;
+
+  SIMPL_TYPE_MACRO(M3CSliceBySliceTest)
+  M3CSliceBySliceTest(const M3CSliceBySliceTest&) = delete;            // Copy Constructor Not Implemented
+  M3CSliceBySliceTest(M3CSliceBySliceTest&&) = delete;                 // Move Constructor Not Implemented
+  M3CSliceBySliceTest& operator=(const M3CSliceBySliceTest&) = delete; // Copy Assignment Not Implemented
+  M3CSliceBySliceTest& operator=(M3CSliceBySliceTest&&) = delete;      // Move Assignment Not Implemented
+
+  const size_t k_XSize = 6;
+  const size_t k_YSize = 5;
+  const size_t k_ZSize = 4;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+    QFile::remove(UnitTest::M3CSliceBySliceTest::NodesFile);
+    QFile::remove(UnitTest::M3CSliceBySliceTest::TrianglesFile);
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the M3CSliceBySlice Filter from the FilterManager
+    QString filtName = "M3CSliceBySlice";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The SurfaceMeshing Requires the use of the " << filtName.toStdString() << " filter which is found in the SurfaceMeshing Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Three features split the volume, feature 4 is a single voxel inside feature 3 and a corner
+  // of the top slice holds feature 0, which the filter renumbers while it meshes
+  // -----------------------------------------------------------------------------
+  std::vector<int32_t> createFeatureIds()
+  {
+    std::vector<int32_t> featureIds(k_XSize * k_YSize * k_ZSize, 0);
+    for(size_t z = 0; z < k_ZSize; z++)
+    {
+      for(size_t y = 0; y < k_YSize; y++)
+      {
+        for(size_t x = 0; x < k_XSize; x++)
+        {
+          int32_t value = (x < 3) ? 1 : ((y < 2) ? 2 : 3);
+          if(z == 3 && x < 2)
+          {
+            value = 0;
+          }
+          if(x == 4 && y == 3 && z == 1)
+          {
+            value = 4;
+          }
+          featureIds[(z * k_YSize + y) * k_XSize + x] = value;
+        }
+      }
+    }
+    return featureIds;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createDataContainerArray(const std::vector<int32_t>& featureIds)
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer m = DataContainer::New(SIMPL::Defaults::DataContainerName);
+    dca->addOrReplaceDataContainer(m);
+
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image->setDimensions(k_XSize, k_YSize, k_ZSize);
+    image->setOrigin(FloatVec3Type(1.0f, 2.0f, 3.0f));
+    image->setSpacing(FloatVec3Type(0.5f, 1.0f, 2.0f));
+    m->setGeometry(image);
+
+    QVector<size_t> tDims = {k_XSize, k_YSize, k_ZSize};
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    m->addOrReplaceAttributeMatrix(cellAttrMat);
+    QVector<size_t> cDims(1, 1);
+    Int32ArrayType::Pointer featureIdsArray = Int32ArrayType::CreateArray(featureIds.size(), cDims, SIMPL::CellData::FeatureIds);
+    cellAttrMat->insertOrAssign(featureIdsArray);
+    std::copy(featureIds.begin(), featureIds.end(), featureIdsArray->getPointer(0));
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  AbstractFilter::Pointer createFilter(const DataContainerArray::Pointer& dca, bool streamMeshToDisk, const QString& outputFilePrefix)
+  {
+    QString filtName = "M3CSliceBySlice";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName(filtName);
+    DREAM3D_REQUIRE(factory.get() != nullptr)
+
+    AbstractFilter::Pointer filter = factory->create();
+    DREAM3D_REQUIRE(filter.get() != nullptr)
+    filter->setDataContainerArray(dca);
+
+    bool propWasSet = filter->setProperty("StreamMeshToDisk", streamMeshToDisk);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    propWasSet = filter->setProperty("OutputFilePrefix", outputFilePrefix);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    return filter;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Every triangle separates two different labels and is seen from each of them with opposite
+  // winding, so for every label each directed edge must be matched by its reverse: the surface
+  // of each feature is closed and consistently oriented
+  // -----------------------------------------------------------------------------
+  void checkMesh(size_t numVerts, const std::vector<int64_t>& tris, const std::vector<int32_t>& labels)
+  {
+    std::map<int32_t, std::map<std::pair<int64_t, int64_t>, int32_t>> directedEdges;
+    size_t numTris = tris.size() / 3;
+    for(size_t t = 0; t < numTris; t++)
+    {
+      const int64_t* tri = tris.data() + 3 * t;
+      for(size_t k = 0; k < 3; k++)
+      {
+        DREAM3D_REQUIRE(tri[k] >= 0 && tri[k] < static_cast<int64_t>(numVerts))
+      }
+      DREAM3D_REQUIRE(labels[2 * t] != labels[2 * t + 1])
+      for(size_t k = 0; k < 3; k++)
+      {
+        directedEdges[labels[2 * t]][std::make_pair(tri[k], tri[(k + 1) % 3])]++;
+        directedEdges[labels[2 * t + 1]][std::make_pair(tri[(k + 1) % 3], tri[k])]++;
+      }
+    }
+
+    for(const auto& label : directedEdges)
+    {
+      for(const auto& edge : label.second)
+      {
+        auto reverse = label.second.find(std::make_pair(edge.first.second, edge.first.first));
+        DREAM3D_REQUIRE(reverse != label.second.end())
+        DREAM3D_REQUIRE_EQUAL(reverse->second, edge.second)
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestInMemoryMesh()
+  {
+    std::vector<int32_t> featureIds = createFeatureIds();
+    DataContainerArray::Pointer dca = createDataContainerArray(featureIds);
+    AbstractFilter::Pointer filter = createFilter(dca, false, QString(""));
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+
+    DataContainer::Pointer sm = dca->getDataContainer(SIMPL::Defaults::TriangleDataContainerName);
+    DREAM3D_REQUIRE_VALID_POINTER(sm.get())
+    TriangleGeom::Pointer triangle = sm->getGeometryAs<TriangleGeom>();
+    DREAM3D_REQUIRE_VALID_POINTER(triangle.get())
+    size_t numVerts = triangle->getNumberOfVertices();
+    size_t numTris = triangle->getNumberOfTris();
+    DREAM3D_REQUIRE(numTris > 0)
+
+    Int32ArrayType::Pointer faceLabels = sm->getAttributeMatrix(SIMPL::Defaults::FaceAttributeMatrixName)->getAttributeArrayAs<Int32ArrayType>(SIMPL::FaceData::SurfaceMeshFaceLabels);
+    DREAM3D_REQUIRE_VALID_POINTER(faceLabels.get())
+    DREAM3D_REQUIRE_EQUAL(faceLabels->getNumberOfTuples(), numTris)
+    Int8ArrayType::Pointer nodeTypes = sm->getAttributeMatrix(SIMPL::Defaults::VertexAttributeMatrixName)->getAttributeArrayAs<Int8ArrayType>(SIMPL::VertexData::SurfaceMeshNodeType);
+    DREAM3D_REQUIRE_VALID_POINTER(nodeTypes.get())
+    DREAM3D_REQUIRE_EQUAL(nodeTypes->getNumberOfTuples(), numVerts)
+
+    std::vector<int64_t> tris(triangle->getTriPointer(0), triangle->getTriPointer(0) + 3 * numTris);
+    std::vector<int32_t> labels(faceLabels->getPointer(0), faceLabels->getPointer(0) + 2 * numTris);
+    checkMesh(numVerts, tris, labels);
+
+    // The feature that was 0 is meshed under its renumbered value and restored afterwards
+    Int32ArrayType::Pointer featureIdsArray =
+        dca->getDataContainer(SIMPL::Defaults::DataContainerName)->getAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName)->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::FeatureIds);
+    DREAM3D_REQUIRE(std::equal(featureIds.begin(), featureIds.end(), featureIdsArray->getPointer(0)))
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Streaming writes the same nodes and triangles, in the same order, straight to the output
+  // files and adds nothing to the Data Container Array
+  // -----------------------------------------------------------------------------
+  int TestStreamMeshToDisk()
+  {
+    std::vector<int32_t> featureIds = createFeatureIds();
+    DataContainerArray::Pointer dca = createDataContainerArray(featureIds);
+    AbstractFilter::Pointer filter = createFilter(dca, false, QString(""));
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+    DataContainer::Pointer sm = dca->getDataContainer(SIMPL::Defaults::TriangleDataContainerName);
+    TriangleGeom::Pointer triangle = sm->getGeometryAs<TriangleGeom>();
+    Int32ArrayType::Pointer faceLabels = sm->getAttributeMatrix(SIMPL::Defaults::FaceAttributeMatrixName)->getAttributeArrayAs<Int32ArrayType>(SIMPL::FaceData::SurfaceMeshFaceLabels);
+
+    DataContainerArray::Pointer streamDca = createDataContainerArray(featureIds);
+    filter = createFilter(streamDca, true, UnitTest::M3CSliceBySliceTest::OutputFilePrefix);
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+    DREAM3D_REQUIRE_EQUAL(streamDca->doesDataContainerExist(SIMPL::Defaults::TriangleDataContainerName), false)
+
+    QFile nodesFile(UnitTest::M3CSliceBySliceTest::NodesFile);
+    DREAM3D_REQUIRE_EQUAL(nodesFile.open(QIODevice::ReadOnly), true)
+    QByteArray nodesBytes = nodesFile.readAll();
+    QFile trianglesFile(UnitTest::M3CSliceBySliceTest::TrianglesFile);
+    DREAM3D_REQUIRE_EQUAL(trianglesFile.open(QIODevice::ReadOnly), true)
+    QByteArray trianglesBytes = trianglesFile.readAll();
+
+    size_t numVerts = static_cast<size_t>(nodesBytes.size()) / SurfaceMesh::NodesFile::ByteCount;
+    size_t numTris = static_cast<size_t>(trianglesBytes.size()) / SurfaceMesh::TrianglesFile::ByteCount;
+    DREAM3D_REQUIRE_EQUAL(numVerts, triangle->getNumberOfVertices())
+    DREAM3D_REQUIRE_EQUAL(numTris, triangle->getNumberOfTris())
+
+    std::vector<SurfaceMesh::NodesFile::NodesFileRecord_t> nodes(numVerts);
+    std::copy(nodesBytes.constData(), nodesBytes.constData() + numVerts * SurfaceMesh::NodesFile::ByteCount, reinterpret_cast<char*>(nodes.data()));
+    std::vector<SurfaceMesh::TrianglesFile::TrianglesFileRecord_t> records(numTris);
+    std::copy(trianglesBytes.constData(), trianglesBytes.constData() + numTris * SurfaceMesh::TrianglesFile::ByteCount, reinterpret_cast<char*>(records.data()));
+
+    for(size_t i = 0; i < numVerts; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(nodes[i].nodeId, static_cast<int32_t>(i))
+      float* vert = triangle->getVertexPointer(i);
+      DREAM3D_REQUIRE_EQUAL(nodes[i].x, vert[0])
+      DREAM3D_REQUIRE_EQUAL(nodes[i].y, vert[1])
+      DREAM3D_REQUIRE_EQUAL(nodes[i].z, vert[2])
+    }
+
+    std::vector<int64_t> tris(3 * numTris);
+    std::vector<int32_t> labels(2 * numTris);
+    for(size_t t = 0; t < numTris; t++)
+    {
+      DREAM3D_REQUIRE_EQUAL(records[t].triId, static_cast<int32_t>(t))
+      tris[3 * t] = records[t].nodeId_0;
+      tris[3 * t + 1] = records[t].nodeId_1;
+      tris[3 * t + 2] = records[t].nodeId_2;
+      labels[2 * t] = records[t].label_0;
+      labels[2 * t + 1] = records[t].label_1;
+    }
+    DREAM3D_REQUIRE(std::equal(tris.begin(), tris.end(), triangle->getTriPointer(0)))
+    DREAM3D_REQUIRE(std::equal(labels.begin(), labels.end(), faceLabels->getPointer(0)))
+    checkMesh(numVerts, tris, labels);
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestMissingOutputFilePrefix()
+  {
+    DataContainerArray::Pointer dca = createDataContainerArray(createFeatureIds());
+    AbstractFilter::Pointer filter = createFilter(dca, true, QString(""));
+    filter->preflight();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), -790);
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "---- " << getNameOfClass().toStdString() << " ----" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestInMemoryMesh())
+    DREAM3D_REGISTER_TEST(TestStreamMeshToDisk())
+    DREAM3D_REGISTER_TEST(TestMissingOutputFilePrefix())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+};
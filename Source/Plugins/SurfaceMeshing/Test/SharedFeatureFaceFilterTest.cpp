@@ -0,0 +1,297 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/SharedFeatureFaceIndex.hpp"
+
+#include "SurfaceMeshingTestFileLocations.h"
+
+class SharedFeatureFaceFilterTest
+{
+
+public:
+  SharedFeatureFaceFilterTest() = default;
+  ~SharedFeatureFaceFilterTest() = default;
+
+  SIMPL_TYPE_MACRO(SharedFeatureFaceFilterTest)
+  SharedFeatureFaceFilterTest(const SharedFeatureFaceFilterTest&) = delete;            // Copy Constructor Not Implemented
+  SharedFeatureFaceFilterTest(SharedFeatureFaceFilterTest&&) = delete;                 // Move Constructor Not Implemented
+  SharedFeatureFaceFilterTest& operator=(const SharedFeatureFaceFilterTest&) = delete; // Copy Assignment Not Implemented
+  SharedFeatureFaceFilterTest& operator=(SharedFeatureFaceFilterTest&&) = delete;      // Move Assignment Not Implemented
+
+  const QString k_NumTrianglesArrayName = QString("NumTriangles");
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the SharedFeatureFaceFilter Filter from the FilterManager
+    QString filtName = "SharedFeatureFaceFilter";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The SurfaceMeshing Requires the use of the " << filtName.toStdString() << " filter which is found in the SurfaceMeshing Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Creates a mesh of numTris triangles with pseudo random Face Labels drawn from
+  // [-1, maxLabel]. Every label pair shows up in both orders, and the labels (0, 0) are
+  // included so the special count of Feature Face 0 is exercised. Large maxLabel values
+  // make the keys vary in every 16 bit digit of the radix sort.
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createMesh(size_t numTris, int32_t maxLabel)
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer tdc = DataContainer::New(SIMPL::Defaults::TriangleDataContainerName);
+    dca->addOrReplaceDataContainer(tdc);
+
+    // The filter only looks at the Face Labels, so every triangle can share the same vertices
+    SharedVertexList::Pointer vertex = TriangleGeom::CreateSharedVertexList(3);
+    TriangleGeom::Pointer triangle = TriangleGeom::CreateGeometry(numTris, vertex, SIMPL::Geometry::TriangleGeometry);
+    tdc->setGeometry(triangle);
+    float* vertices = triangle->getVertexPointer(0);
+    const float coords[9] = {0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f};
+    std::copy(coords, coords + 9, vertices);
+    int64_t* tris = triangle->getTriPointer(0);
+    for(size_t t = 0; t < numTris; t++)
+    {
+      tris[3 * t + 0] = 0;
+      tris[3 * t + 1] = 1;
+      tris[3 * t + 2] = 2;
+    }
+
+    QVector<size_t> tDims(1, numTris);
+    AttributeMatrix::Pointer faceAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::FaceAttributeMatrixName, AttributeMatrix::Type::Face);
+    tdc->addOrReplaceAttributeMatrix(faceAttrMat);
+    QVector<size_t> cDims(1, 2);
+    Int32ArrayType::Pointer faceLabels = Int32ArrayType::CreateArray(numTris, cDims, SIMPL::FaceData::SurfaceMeshFaceLabels);
+    faceAttrMat->insertOrAssign(faceLabels);
+
+    uint64_t state = 0x2545F4914F6CDD1DULL + numTris;
+    for(size_t t = 0; t < numTris; t++)
+    {
+      state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+      uint32_t bits = static_cast<uint32_t>(state >> 33);
+      int32_t range = maxLabel + 2;
+      int32_t label0 = static_cast<int32_t>(bits % range) - 1;
+      int32_t label1 = static_cast<int32_t>((bits / range) % 17) + label0 - 8;
+      if(t % 97 == 5)
+      {
+        label0 = 0;
+        label1 = 0;
+      }
+      faceLabels->setComponent(t, 0, label0);
+      faceLabels->setComponent(t, 1, label1);
+    }
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The QMap loop the filter used before the radix sort: Feature Face Ids are handed out
+  // from 1 in the order each pair of Face Labels first appears, face 0 has the labels (0, 0)
+  // and the count of whichever face carries the labels (0, 0).
+  // -----------------------------------------------------------------------------
+  void findFeatureFaces(Int32ArrayType::Pointer faceLabels, std::vector<int32_t>& faceIds, std::vector<std::pair<int32_t, int32_t>>& faceLabelMap, std::vector<int32_t>& numTriangles)
+  {
+    size_t numTris = faceLabels->getNumberOfTuples();
+    std::map<std::pair<int32_t, int32_t>, int32_t> faceSizeMap;
+    std::map<std::pair<int32_t, int32_t>, int32_t> faceIdMap;
+    int32_t index = 1;
+
+    faceIds.assign(numTris, 0);
+    faceLabelMap.assign(1, std::pair<int32_t, int32_t>(0, 0));
+    for(size_t t = 0; t < numTris; t++)
+    {
+      int32_t fl0 = faceLabels->getComponent(t, 0);
+      int32_t fl1 = faceLabels->getComponent(t, 1);
+      std::pair<int32_t, int32_t> faceId = (fl0 < fl1) ? std::make_pair(fl0, fl1) : std::make_pair(fl1, fl0);
+      auto iter = faceSizeMap.find(faceId);
+      if(iter == faceSizeMap.end())
+      {
+        faceSizeMap[faceId] = 1;
+        faceIdMap[faceId] = index;
+        faceIds[t] = index;
+        faceLabelMap.push_back(faceId);
+        ++index;
+      }
+      else
+      {
+        iter->second++;
+        faceIds[t] = faceIdMap[faceId];
+      }
+    }
+
+    numTriangles.assign(index, 0);
+    for(int32_t i = 0; i < index; i++)
+    {
+      numTriangles[i] = faceSizeMap[faceLabelMap[i]];
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestMatchesFaceLabelMap(size_t numTris, int32_t maxLabel)
+  {
+    DataContainerArray::Pointer dca = createMesh(numTris, maxLabel);
+    DataContainer::Pointer tdc = dca->getDataContainer(SIMPL::Defaults::TriangleDataContainerName);
+    Int32ArrayType::Pointer faceLabels = tdc->getAttributeMatrix(SIMPL::Defaults::FaceAttributeMatrixName)->getAttributeArrayAs<Int32ArrayType>(SIMPL::FaceData::SurfaceMeshFaceLabels);
+
+    std::vector<int32_t> expectedIds;
+    std::vector<std::pair<int32_t, int32_t>> expectedLabels;
+    std::vector<int32_t> expectedCounts;
+    findFeatureFaces(faceLabels, expectedIds, expectedLabels, expectedCounts);
+
+    QString filtName = "SharedFeatureFaceFilter";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName(filtName);
+    DREAM3D_REQUIRE(factory.get() != nullptr)
+
+    AbstractFilter::Pointer filter = factory->create();
+    DREAM3D_REQUIRE(filter.get() != nullptr)
+    filter->setDataContainerArray(dca);
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+
+    Int32ArrayType::Pointer faceIds = tdc->getAttributeMatrix(SIMPL::Defaults::FaceAttributeMatrixName)->getAttributeArrayAs<Int32ArrayType>(SIMPL::FaceData::SurfaceMeshFeatureFaceId);
+    AttributeMatrix::Pointer faceFeatureAttrMat = tdc->getAttributeMatrix(SIMPL::Defaults::FaceFeatureAttributeMatrixName);
+    DREAM3D_REQUIRE_VALID_POINTER(faceIds.get())
+    DREAM3D_REQUIRE_VALID_POINTER(faceFeatureAttrMat.get())
+    Int32ArrayType::Pointer featureFaceLabels = faceFeatureAttrMat->getAttributeArrayAs<Int32ArrayType>(SIMPL::FaceData::SurfaceMeshFaceLabels);
+    Int32ArrayType::Pointer numTriangles = faceFeatureAttrMat->getAttributeArrayAs<Int32ArrayType>(k_NumTrianglesArrayName);
+    DREAM3D_REQUIRE_VALID_POINTER(featureFaceLabels.get())
+    DREAM3D_REQUIRE_VALID_POINTER(numTriangles.get())
+
+    for(size_t t = 0; t < numTris; t++)
+    {
+      DREAM3D_REQUIRE_EQUAL(faceIds->getValue(t), expectedIds[t])
+    }
+    DREAM3D_REQUIRE_EQUAL(faceFeatureAttrMat->getNumberOfTuples(), expectedCounts.size())
+    for(size_t f = 0; f < expectedCounts.size(); f++)
+    {
+      DREAM3D_REQUIRE_EQUAL(featureFaceLabels->getComponent(f, 0), expectedLabels[f].first)
+      DREAM3D_REQUIRE_EQUAL(featureFaceLabels->getComponent(f, 1), expectedLabels[f].second)
+      DREAM3D_REQUIRE_EQUAL(numTriangles->getValue(f), expectedCounts[f])
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The CSR lists built from the Face Labels and from the Feature Face Ids must both
+  // hold every triangle exactly once, grouped by Feature Face and in ascending order.
+  // -----------------------------------------------------------------------------
+  int TestFaceTriangleLists(size_t numTris, int32_t maxLabel)
+  {
+    DataContainerArray::Pointer dca = createMesh(numTris, maxLabel);
+    DataContainer::Pointer tdc = dca->getDataContainer(SIMPL::Defaults::TriangleDataContainerName);
+    Int32ArrayType::Pointer faceLabels = tdc->getAttributeMatrix(SIMPL::Defaults::FaceAttributeMatrixName)->getAttributeArrayAs<Int32ArrayType>(SIMPL::FaceData::SurfaceMeshFaceLabels);
+
+    std::vector<int32_t> faceIds(numTris, -1);
+    SharedFeatureFaceIndex labelIndex;
+    labelIndex.buildFromFaceLabels(faceLabels->getPointer(0), numTris, faceIds.data());
+    SharedFeatureFaceIndex idIndex;
+    idIndex.buildFromFaceIds(faceIds.data(), numTris);
+
+    DREAM3D_REQUIRE_EQUAL(labelIndex.getNumberOfFaces(), idIndex.getNumberOfFaces())
+    DREAM3D_REQUIRE_EQUAL(labelIndex.getNumberOfTriangles(0), 0)
+    DREAM3D_REQUIRE(labelIndex.getOffsets() == idIndex.getOffsets())
+    DREAM3D_REQUIRE(labelIndex.getTriangles() == idIndex.getTriangles())
+
+    const std::vector<int64_t>& offsets = labelIndex.getOffsets();
+    const std::vector<int64_t>& triangles = labelIndex.getTriangles();
+    DREAM3D_REQUIRE_EQUAL(offsets.back(), static_cast<int64_t>(numTris))
+    std::vector<int32_t> seen(numTris, 0);
+    for(size_t f = 1; f < labelIndex.getNumberOfFaces(); f++)
+    {
+      DREAM3D_REQUIRE(labelIndex.getNumberOfTriangles(f) > 0)
+      for(int64_t i = offsets[f]; i < offsets[f + 1]; i++)
+      {
+        int64_t t = triangles[i];
+        DREAM3D_REQUIRE_EQUAL(faceIds[t], static_cast<int32_t>(f))
+        DREAM3D_REQUIRE(i == offsets[f] || triangles[i - 1] < t)
+        seen[t]++;
+      }
+    }
+    for(size_t t = 0; t < numTris; t++)
+    {
+      DREAM3D_REQUIRE_EQUAL(seen[t], 1)
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "---- " << getNameOfClass().toStdString() << " ----" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestMatchesFaceLabelMap(1, 10))
+    DREAM3D_REGISTER_TEST(TestMatchesFaceLabelMap(1000, 10))
+    DREAM3D_REGISTER_TEST(TestMatchesFaceLabelMap(300000, 500))
+    DREAM3D_REGISTER_TEST(TestMatchesFaceLabelMap(300000, 2000000))
+    DREAM3D_REGISTER_TEST(TestFaceTriangleLists(1000, 10))
+    DREAM3D_REGISTER_TEST(TestFaceTriangleLists(300000, 2000000))
+  }
+};
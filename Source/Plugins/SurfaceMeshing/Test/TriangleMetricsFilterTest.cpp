@@ -0,0 +1,257 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <cmath>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+#include <QtCore/QVariant>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "SurfaceMeshingTestFileLocations.h"
+
+class TriangleMetricsFilterTest
+{
+
+public:
+  TriangleMetricsFilterTest() = default;
+  ~TriangleMetricsFilterTest() = default;
+
+  SIMPL_TYPE_MACRO(TriangleMetricsFilterTest)
+  TriangleMetricsFilterTest(const TriangleMetricsFilterTest&) = delete;            // Copy Constructor Not Implemented
+  TriangleMetricsFilterTest(TriangleMetricsFilterTest&&) = delete;                 // Move Constructor Not Implemented
+  TriangleMetricsFilterTest& operator=(const TriangleMetricsFilterTest&) = delete; // Copy Assignment Not Implemented
+  TriangleMetricsFilterTest& operator=(TriangleMetricsFilterTest&&) = delete;      // Move Assignment Not Implemented
+
+  // More triangles than one batch of the sweep, so that a partial batch is exercised as well
+  const size_t k_NumX = 24;
+  const size_t k_NumY = 17;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the TriangleMetricsFilter Filter from the FilterManager
+    QString filtName = "TriangleMetricsFilter";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The SurfaceMeshing Requires the use of the " << filtName.toStdString() << " filter which is found in the SurfaceMeshing Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // A wavy height field split into two triangles per grid cell, plus one degenerate triangle
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createDataContainerArray()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer tdc = DataContainer::New(SIMPL::Defaults::TriangleDataContainerName);
+    dca->addOrReplaceDataContainer(tdc);
+
+    size_t numVerts = k_NumX * k_NumY;
+    size_t numTris = 2 * (k_NumX - 1) * (k_NumY - 1) + 1;
+    SharedVertexList::Pointer vertex = TriangleGeom::CreateSharedVertexList(numVerts);
+    TriangleGeom::Pointer triangle = TriangleGeom::CreateGeometry(numTris, vertex, SIMPL::Geometry::TriangleGeometry);
+    tdc->setGeometry(triangle);
+
+    for(size_t j = 0; j < k_NumY; j++)
+    {
+      for(size_t i = 0; i < k_NumX; i++)
+      {
+        float* vert = triangle->getVertexPointer(j * k_NumX + i);
+        vert[0] = 0.5f * static_cast<float>(i) + 0.1f * static_cast<float>(std::sin(1.7 * j));
+        vert[1] = 0.75f * static_cast<float>(j);
+        vert[2] = static_cast<float>(std::sin(0.3 * i) * std::cos(0.4 * j));
+      }
+    }
+    size_t t = 0;
+    for(size_t j = 0; j < k_NumY - 1; j++)
+    {
+      for(size_t i = 0; i < k_NumX - 1; i++)
+      {
+        int64_t v0 = static_cast<int64_t>(j * k_NumX + i);
+        int64_t v1 = v0 + 1;
+        int64_t v2 = v0 + static_cast<int64_t>(k_NumX);
+        int64_t v3 = v2 + 1;
+        int64_t* tri = triangle->getTriPointer(t++);
+        tri[0] = v0;
+        tri[1] = v1;
+        tri[2] = v3;
+        tri = triangle->getTriPointer(t++);
+        tri[0] = v0;
+        tri[1] = v3;
+        tri[2] = v2;
+      }
+    }
+    int64_t* tri = triangle->getTriPointer(t);
+    tri[0] = 0;
+    tri[1] = 0;
+    tri[2] = 1;
+
+    QVector<size_t> tDims(1, numTris);
+    AttributeMatrix::Pointer faceAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::FaceAttributeMatrixName, AttributeMatrix::Type::Face);
+    tdc->addOrReplaceAttributeMatrix(faceAttrMat);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void runFilter(const QString& filtName, const DataContainerArray::Pointer& dca, const QVariantMap& properties, int expectedError)
+  {
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName(filtName);
+    DREAM3D_REQUIRE(factory.get() != nullptr)
+
+    AbstractFilter::Pointer filter = factory->create();
+    DREAM3D_REQUIRE(filter.get() != nullptr)
+    filter->setDataContainerArray(dca);
+    for(QVariantMap::const_iterator iter = properties.begin(); iter != properties.end(); ++iter)
+    {
+      bool propWasSet = filter->setProperty(iter.key().toLatin1().constData(), iter.value());
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    }
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), expectedError);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  DoubleArrayType::Pointer getFaceArray(const DataContainerArray::Pointer& dca, const QString& name)
+  {
+    AttributeMatrix::Pointer faceAttrMat = dca->getDataContainer(SIMPL::Defaults::TriangleDataContainerName)->getAttributeMatrix(SIMPL::Defaults::FaceAttributeMatrixName);
+    return faceAttrMat->getAttributeArrayAs<DoubleArrayType>(name);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void requireSameValues(const DoubleArrayType::Pointer& expected, const DoubleArrayType::Pointer& computed)
+  {
+    DREAM3D_REQUIRE_VALID_POINTER(expected.get())
+    DREAM3D_REQUIRE_VALID_POINTER(computed.get())
+    DREAM3D_REQUIRE_EQUAL(computed->getNumberOfTuples(), expected->getNumberOfTuples())
+    DREAM3D_REQUIRE_EQUAL(computed->getNumberOfComponents(), expected->getNumberOfComponents())
+    for(size_t i = 0; i < expected->getSize(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(computed->getValue(i), expected->getValue(i))
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // The combined sweep must give exactly what the four single output filters give
+  // -----------------------------------------------------------------------------
+  int TestMatchesSingleOutputFilters()
+  {
+    DataContainerArray::Pointer expectedDca = createDataContainerArray();
+    runFilter("TriangleAreaFilter", expectedDca, QVariantMap(), 0);
+    runFilter("TriangleNormalFilter", expectedDca, QVariantMap(), 0);
+    runFilter("TriangleCentroidFilter", expectedDca, QVariantMap(), 0);
+    runFilter("TriangleDihedralAngleFilter", expectedDca, QVariantMap(), 0);
+
+    DataContainerArray::Pointer dca = createDataContainerArray();
+    runFilter("TriangleMetricsFilter", dca, QVariantMap(), 0);
+
+    requireSameValues(getFaceArray(expectedDca, SIMPL::FaceData::SurfaceMeshFaceAreas), getFaceArray(dca, SIMPL::FaceData::SurfaceMeshFaceAreas));
+    requireSameValues(getFaceArray(expectedDca, SIMPL::FaceData::SurfaceMeshFaceNormals), getFaceArray(dca, SIMPL::FaceData::SurfaceMeshFaceNormals));
+    requireSameValues(getFaceArray(expectedDca, SIMPL::FaceData::SurfaceMeshFaceCentroids), getFaceArray(dca, SIMPL::FaceData::SurfaceMeshFaceCentroids));
+    requireSameValues(getFaceArray(expectedDca, SIMPL::FaceData::SurfaceMeshFaceDihedralAngles), getFaceArray(dca, SIMPL::FaceData::SurfaceMeshFaceDihedralAngles));
+
+    // The degenerate triangle has no area and a zero normal
+    size_t last = getFaceArray(dca, SIMPL::FaceData::SurfaceMeshFaceAreas)->getNumberOfTuples() - 1;
+    DREAM3D_REQUIRE_EQUAL(getFaceArray(dca, SIMPL::FaceData::SurfaceMeshFaceAreas)->getValue(last), 0.0)
+    DREAM3D_REQUIRE_EQUAL(getFaceArray(dca, SIMPL::FaceData::SurfaceMeshFaceNormals)->getValue(3 * last), 0.0)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestSelectedOutputsOnly()
+  {
+    DataContainerArray::Pointer dca = createDataContainerArray();
+    QVariantMap properties;
+    properties["ComputeAreas"] = false;
+    properties["ComputeDihedralAngles"] = false;
+    runFilter("TriangleMetricsFilter", dca, properties, 0);
+
+    DREAM3D_REQUIRE(nullptr == getFaceArray(dca, SIMPL::FaceData::SurfaceMeshFaceAreas).get())
+    DREAM3D_REQUIRE(nullptr == getFaceArray(dca, SIMPL::FaceData::SurfaceMeshFaceDihedralAngles).get())
+    DREAM3D_REQUIRE_VALID_POINTER(getFaceArray(dca, SIMPL::FaceData::SurfaceMeshFaceNormals).get())
+    DREAM3D_REQUIRE_VALID_POINTER(getFaceArray(dca, SIMPL::FaceData::SurfaceMeshFaceCentroids).get())
+
+    properties["ComputeNormals"] = false;
+    properties["ComputeCentroids"] = false;
+    runFilter("TriangleMetricsFilter", createDataContainerArray(), properties, -11000);
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "---- " << getNameOfClass().toStdString() << " ----" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestMatchesSingleOutputFilters())
+    DREAM3D_REGISTER_TEST(TestSelectedOutputsOnly())
+  }
+};
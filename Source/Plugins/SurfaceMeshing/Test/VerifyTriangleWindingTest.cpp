@@ -0,0 +1,337 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <algorithm>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "SurfaceMeshingTestFileLocations.h"
+
+class VerifyTriangleWindingTest
+{
+
+public:
+  VerifyTriangleWindingTest() = default;
+  ~VerifyTriangleWindingTest() = default;
+
+  SIMPL_TYPE_MACRO(VerifyTriangleWindingTest)
+  VerifyTriangleWindingTest(const VerifyTriangleWindingTest&) = delete;            // Copy Constructor Not Implemented
+  VerifyTriangleWindingTest(VerifyTriangleWindingTest&&) = delete;                 // Move Constructor Not Implemented
+  VerifyTriangleWindingTest& operator=(const VerifyTriangleWindingTest&) = delete; // Copy Assignment Not Implemented
+  VerifyTriangleWindingTest& operator=(VerifyTriangleWindingTest&&) = delete;      // Move Assignment Not Implemented
+
+  // Number of voxels along each side of the labeled block the test mesh is cut from
+  const int32_t k_GridSize = 10;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the VerifyTriangleWinding Filter from the FilterManager
+    QString filtName = "VerifyTriangleWinding";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The SurfaceMeshing Requires the use of the " << filtName.toStdString() << " filter which is found in the SurfaceMeshing Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Feature of a voxel of the block. Voxels outside of the block are Feature 0, so the
+  // mesh is closed. Features 1 to 16 are boxes and L shapes of different sizes, so the
+  // mesh has triple lines and quadruple points.
+  // -----------------------------------------------------------------------------
+  int32_t voxelLabel(int32_t i, int32_t j, int32_t k)
+  {
+    if(i < 0 || j < 0 || k < 0 || i >= k_GridSize || j >= k_GridSize || k >= k_GridSize)
+    {
+      return 0;
+    }
+    return 1 + (i < 4) + 2 * (j < 3) + 4 * (k < 6) + 8 * (i < 7 && j > 6);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int64_t vertexId(int32_t i, int32_t j, int32_t k)
+  {
+    return (static_cast<int64_t>(k) * (k_GridSize + 1) + j) * (k_GridSize + 1) + i;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Meshes every voxel face between two Features with two triangles. The triangles are
+  // wound so their normals point from the first label to the second, which is the winding
+  // the filter has to produce. The label order of every other triangle (chosen at random)
+  // is swapped together with its winding, which keeps the mesh correctly wound.
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createMesh(std::vector<int64_t>& expected)
+  {
+    std::vector<int64_t> tris;
+    std::vector<int32_t> labels;
+    for(int32_t k = -1; k < k_GridSize; k++)
+    {
+      for(int32_t j = -1; j < k_GridSize; j++)
+      {
+        for(int32_t i = -1; i < k_GridSize; i++)
+        {
+          int32_t label0 = voxelLabel(i, j, k);
+          for(int32_t d = 0; d < 3; d++)
+          {
+            int32_t label1 = voxelLabel(i + (d == 0), j + (d == 1), k + (d == 2));
+            if(label0 == label1)
+            {
+              continue;
+            }
+            // The corners of the face are counter clockwise seen from +d
+            int64_t q[4];
+            if(d == 0)
+            {
+              int64_t face[4] = {vertexId(i + 1, j, k), vertexId(i + 1, j + 1, k), vertexId(i + 1, j + 1, k + 1), vertexId(i + 1, j, k + 1)};
+              std::copy(face, face + 4, q);
+            }
+            else if(d == 1)
+            {
+              int64_t face[4] = {vertexId(i, j + 1, k), vertexId(i, j + 1, k + 1), vertexId(i + 1, j + 1, k + 1), vertexId(i + 1, j + 1, k)};
+              std::copy(face, face + 4, q);
+            }
+            else
+            {
+              int64_t face[4] = {vertexId(i, j, k + 1), vertexId(i + 1, j, k + 1), vertexId(i + 1, j + 1, k + 1), vertexId(i, j + 1, k + 1)};
+              std::copy(face, face + 4, q);
+            }
+            tris.insert(tris.end(), {q[0], q[1], q[2], q[0], q[2], q[3]});
+            labels.insert(labels.end(), {label0, label1, label0, label1});
+          }
+        }
+      }
+    }
+
+    size_t numTris = tris.size() / 3;
+    uint64_t state = 0x2545F4914F6CDD1DULL;
+    for(size_t t = 0; t < numTris; t++)
+    {
+      state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+      if((state >> 40) & 1)
+      {
+        std::swap(labels[2 * t], labels[2 * t + 1]);
+        std::swap(tris[3 * t], tris[3 * t + 2]);
+      }
+    }
+    expected = tris;
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer tdc = DataContainer::New(SIMPL::Defaults::TriangleDataContainerName);
+    dca->addOrReplaceDataContainer(tdc);
+
+    size_t numVerts = static_cast<size_t>((k_GridSize + 1) * (k_GridSize + 1) * (k_GridSize + 1));
+    SharedVertexList::Pointer vertex = TriangleGeom::CreateSharedVertexList(static_cast<int64_t>(numVerts));
+    TriangleGeom::Pointer triangle = TriangleGeom::CreateGeometry(static_cast<int64_t>(numTris), vertex, SIMPL::Geometry::TriangleGeometry);
+    tdc->setGeometry(triangle);
+    float* vertices = triangle->getVertexPointer(0);
+    for(int32_t k = 0; k <= k_GridSize; k++)
+    {
+      for(int32_t j = 0; j <= k_GridSize; j++)
+      {
+        for(int32_t i = 0; i <= k_GridSize; i++)
+        {
+          // Unequal spacings, so no two triangles tie for the right-most centroid by accident
+          float* v = vertices + 3 * vertexId(i, j, k);
+          v[0] = static_cast<float>(i) * 1.5f;
+          v[1] = static_cast<float>(j);
+          v[2] = static_cast<float>(k) * 0.7f;
+        }
+      }
+    }
+    std::copy(tris.begin(), tris.end(), triangle->getTriPointer(0));
+
+    QVector<size_t> tDims(1, numTris);
+    AttributeMatrix::Pointer faceAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::FaceAttributeMatrixName, AttributeMatrix::Type::Face);
+    tdc->addOrReplaceAttributeMatrix(faceAttrMat);
+    QVector<size_t> cDims(1, 2);
+    Int32ArrayType::Pointer faceLabels = Int32ArrayType::CreateArray(numTris, cDims, SIMPL::FaceData::SurfaceMeshFaceLabels);
+    faceAttrMat->insertOrAssign(faceLabels);
+    std::copy(labels.begin(), labels.end(), faceLabels->getPointer(0));
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int64_t* getTriangles(DataContainerArray::Pointer dca)
+  {
+    TriangleGeom::Pointer triangle = dca->getDataContainer(SIMPL::Defaults::TriangleDataContainerName)->getGeometryAs<TriangleGeom>();
+    return triangle->getTriPointer(0);
+  }
+
+  // -----------------------------------------------------------------------------
+  // Counts the triangles that are not wound like the expected triangles. The filter flips
+  // a triangle by swapping its first and last vertex, but any rotation of the expected
+  // vertices is the same winding.
+  // -----------------------------------------------------------------------------
+  size_t countMiswound(const int64_t* tris, const std::vector<int64_t>& expected)
+  {
+    size_t miswound = 0;
+    for(size_t t = 0; t < expected.size() / 3; t++)
+    {
+      const int64_t* a = tris + 3 * t;
+      const int64_t* b = expected.data() + 3 * t;
+      bool same = (a[0] == b[0] && a[1] == b[1] && a[2] == b[2]) || (a[0] == b[1] && a[1] == b[2] && a[2] == b[0]) || (a[0] == b[2] && a[1] == b[0] && a[2] == b[1]);
+      if(!same)
+      {
+        miswound++;
+      }
+    }
+    return miswound;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int RunFilter(DataContainerArray::Pointer dca)
+  {
+    QString filtName = "VerifyTriangleWinding";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName(filtName);
+    DREAM3D_REQUIRE(factory.get() != nullptr)
+
+    AbstractFilter::Pointer filter = factory->create();
+    DREAM3D_REQUIRE(filter.get() != nullptr)
+    filter->setDataContainerArray(dca);
+
+    QVariant var;
+    var.setValue(DataArrayPath(SIMPL::Defaults::TriangleDataContainerName, SIMPL::Defaults::FaceAttributeMatrixName, SIMPL::FaceData::SurfaceMeshFaceLabels));
+    bool propWasSet = filter->setProperty("SurfaceMeshFaceLabelsArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+    // A consistently labeled mesh never has conflicting windings
+    DREAM3D_REQUIRE_EQUAL(filter->getWarningCode(), 0);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // A correctly wound mesh must come out unchanged
+  // -----------------------------------------------------------------------------
+  int TestKeepsCorrectWinding()
+  {
+    std::vector<int64_t> expected;
+    DataContainerArray::Pointer dca = createMesh(expected);
+
+    int err = RunFilter(dca);
+    DREAM3D_REQUIRE_EQUAL(err, EXIT_SUCCESS)
+
+    const int64_t* tris = getTriangles(dca);
+    DREAM3D_REQUIRE(std::equal(expected.begin(), expected.end(), tris))
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Flips a random half of the triangles, which breaks the winding between neighbors
+  // everywhere, and then every triangle, which keeps the neighbors consistent but leaves
+  // every Feature wound inside out. Both must be restored to the expected winding.
+  // -----------------------------------------------------------------------------
+  int TestRepairsFlippedWinding()
+  {
+    std::vector<int64_t> expected;
+    DataContainerArray::Pointer dca = createMesh(expected);
+    int64_t* tris = getTriangles(dca);
+    size_t numTris = expected.size() / 3;
+
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    size_t numFlipped = 0;
+    for(size_t t = 0; t < numTris; t++)
+    {
+      state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+      if((state >> 40) & 1)
+      {
+        std::swap(tris[3 * t], tris[3 * t + 2]);
+        numFlipped++;
+      }
+    }
+    DREAM3D_REQUIRE(numFlipped > 0 && numFlipped < numTris)
+    DREAM3D_REQUIRE_EQUAL(countMiswound(tris, expected), numFlipped)
+
+    int err = RunFilter(dca);
+    DREAM3D_REQUIRE_EQUAL(err, EXIT_SUCCESS)
+    DREAM3D_REQUIRE_EQUAL(countMiswound(tris, expected), 0)
+
+    for(size_t t = 0; t < numTris; t++)
+    {
+      std::swap(tris[3 * t], tris[3 * t + 2]);
+    }
+    DREAM3D_REQUIRE_EQUAL(countMiswound(tris, expected), numTris)
+
+    err = RunFilter(dca);
+    DREAM3D_REQUIRE_EQUAL(err, EXIT_SUCCESS)
+    DREAM3D_REQUIRE_EQUAL(countMiswound(tris, expected), 0)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "---- " << getNameOfClass().toStdString() << " ----" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestKeepsCorrectWinding())
+    DREAM3D_REGISTER_TEST(TestRepairsFlippedWinding())
+  }
+};
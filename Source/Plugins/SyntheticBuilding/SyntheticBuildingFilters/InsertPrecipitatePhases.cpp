@@ -38,6 +38,8 @@
 
 #include "InsertPrecipitatePhases.h"
 
+#include <algorithm>
+#include <deque>
 #include <fstream>
 
 #include <QtCore/QDir>
@@ -61,6 +63,7 @@
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 
 #include "SyntheticBuilding/SyntheticBuildingConstants.h"
+#include "SyntheticBuilding/SyntheticBuildingFilters/util/PrecipitateExclusionZones.h"
 #include "SyntheticBuilding/SyntheticBuildingVersion.h"
 
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
@@ -80,6 +83,12 @@ enum createdPathID : RenameDataPath::DataID_t
 
 const QString PrecipitateSyntheticShapeParametersName("Synthetic Shape Parameters (Precipitate)");
 
+namespace
+{
+// Maximum number of precipitates whose exclusion zones are voxelized concurrently during the initial placement
+const size_t k_PlacementBatchSize = 512;
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -876,9 +885,11 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
   }
 
   // This is the set that we are going to keep updated with the points that are
-  // not in an exclusion zone
-  std::map<size_t, size_t> availablePoints;
-  std::map<size_t, size_t> availablePointsInv;
+  // not in an exclusion zone. availablePoints holds the slot of every packing point
+  // in availablePointsInv (or -1 if the point is not available) and the first
+  // m_AvailablePointsCount entries of availablePointsInv are the available points
+  std::vector<int64_t> availablePoints;
+  std::vector<size_t> availablePointsInv;
 
   // Get a pointer to the Feature Owners that was just initialized in the
   // initialize_packinggrid() method
@@ -1019,12 +1030,14 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
   }
 
   // determine initial set of available points
+  availablePoints.assign(static_cast<size_t>(m_TotalPoints), -1);
+  availablePointsInv.assign(static_cast<size_t>(m_TotalPoints), 0);
   m_AvailablePointsCount = 0;
   for(int64_t i = 0; i < m_TotalPoints; i++)
   {
     if((exclusionZones[i] == 0 && !m_UseMask) || (exclusionZones[i] == 0 && m_UseMask && m_Mask[i]))
     {
-      availablePoints[i] = m_AvailablePointsCount;
+      availablePoints[i] = static_cast<int64_t>(m_AvailablePointsCount);
       availablePointsInv[m_AvailablePointsCount] = i;
       m_AvailablePointsCount++;
     }
@@ -1195,102 +1208,193 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
   //    }
   //  }
 
+  float spacing[3] = {m_XRes, m_YRes, m_ZRes};
+  int64_t points[3] = {m_XPoints, m_YPoints, m_ZPoints};
+  PrecipitateExclusionZones zoneVoxelizer(m_Volumes, m_AxisLengths, m_AxisEulerAngles, m_Omega3s, m_Centroids, m_FeaturePhases, m_ShapeTypes, spacing, points);
+
+  // The exclusion zone radii are found once up front to size the placement cells; this also
+  // rejects undefined shape classes before any precipitate is voxelized on a worker thread
+  float avgExclusionRadius = 0.0f;
+  for(size_t i = size_t(m_FirstPrecipitateFeature); i < numfeatures; i++)
+  {
+    ShapeType::Type shapeclass = static_cast<ShapeType::Type>(m_ShapeTypes[m_FeaturePhases[i]]);
+    if(shapeclass >= ShapeType::Type::ShapeTypeEnd)
+    {
+      QString ss = QObject::tr("Undefined shape class in shape types array with path %1").arg(m_InputShapeTypesArrayPath.serialize());
+      setErrorCondition(-667, ss);
+      return;
+    }
+    avgExclusionRadius += zoneVoxelizer.findRadius(i, m_ShapeOps);
+  }
+  if(numfeatures > size_t(m_FirstPrecipitateFeature))
+  {
+    avgExclusionRadius /= static_cast<float>(numfeatures - m_FirstPrecipitateFeature);
+  }
+
+  // Partition the packing grid into spatial cells about one average exclusion zone
+  // across. Only one precipitate per cell is admitted to each batch, so the members
+  // of a batch rarely interact and their exclusion zones can be voxelized concurrently.
+  int64_t cellDims[3] = {
+      std::max<int64_t>(1, static_cast<int64_t>(2.0f * avgExclusionRadius / m_XRes)),
+      std::max<int64_t>(1, static_cast<int64_t>(2.0f * avgExclusionRadius / m_YRes)),
+      std::max<int64_t>(1, static_cast<int64_t>(2.0f * avgExclusionRadius / m_ZRes)),
+  };
+  int64_t numCells[3] = {(m_XPoints + cellDims[0] - 1) / cellDims[0], (m_YPoints + cellDims[1] - 1) / cellDims[1], (m_ZPoints + cellDims[2] - 1) / cellDims[2]};
+  std::vector<size_t> cellBatchStamps(static_cast<size_t>(numCells[0] * numCells[1] * numCells[2]), 0);
+
+  std::deque<size_t> pendingPrecipitates;
   for(size_t i = size_t(m_FirstPrecipitateFeature); i < numfeatures; i++)
+  {
+    pendingPrecipitates.push_back(i);
+  }
+
+  std::vector<size_t> batch;
+  std::vector<size_t> batchPoints;
+  std::vector<bool> batchFromAvailable;
+  batch.reserve(k_PlacementBatchSize);
+  batchPoints.reserve(k_PlacementBatchSize);
+  batchFromAvailable.reserve(k_PlacementBatchSize);
+  size_t batchId = 0;
+  size_t numPlaced = 0;
+  while(!pendingPrecipitates.empty())
   {
     if(getCancel())
     {
       return;
     }
-    QString ss = QObject::tr("Packing Precipitates || Placing Precipitate #%1").arg(i);
+    QString ss = QObject::tr("Packing Precipitates || Placing Precipitate #%1").arg(numPlaced + m_FirstPrecipitateFeature);
     notifyStatusMessage(ss);
 
-    PrecipitateStatsData::Pointer pp = std::dynamic_pointer_cast<PrecipitateStatsData>(statsDataArray[m_FeaturePhases[i]]);
-    precipboundaryfraction = pp->getPrecipBoundaryFraction();
-    random = static_cast<float>(rg.genrand_res53());
+    batchId++;
+    batch.clear();
+    batchPoints.clear();
+    batchFromAvailable.clear();
 
-    if(boundaryFraction != 0)
+    // Choose the centroids for the next batch from the current set of available points
+    size_t numCandidates = std::min(pendingPrecipitates.size(), k_PlacementBatchSize);
+    for(size_t n = 0; n < numCandidates; n++)
     {
-      if(random <= precipboundaryfraction)
+      size_t i = pendingPrecipitates.front();
+      pendingPrecipitates.pop_front();
+
+      PrecipitateStatsData::Pointer pp = std::dynamic_pointer_cast<PrecipitateStatsData>(statsDataArray[m_FeaturePhases[i]]);
+      precipboundaryfraction = pp->getPrecipBoundaryFraction();
+      random = static_cast<float>(rg.genrand_res53());
+
+      if(boundaryFraction != 0)
       {
-        // figure out if we want this to be a boundary centroid voxel or not for
-        // the proposed precipitate
-        if(m_AvailablePointsCount > 0)
+        if(random <= precipboundaryfraction)
         {
-          key = static_cast<size_t>(rg.genrand_res53() * (m_AvailablePointsCount - 1));
-          featureOwnersIdx = availablePointsInv[key];
-          while(m_BoundaryCells[featureOwnersIdx] == 0)
+          // figure out if we want this to be a boundary centroid voxel or not for
+          // the proposed precipitate
+          if(m_AvailablePointsCount > 0)
           {
             key = static_cast<size_t>(rg.genrand_res53() * (m_AvailablePointsCount - 1));
             featureOwnersIdx = availablePointsInv[key];
+            while(m_BoundaryCells[featureOwnersIdx] == 0)
+            {
+              key = static_cast<size_t>(rg.genrand_res53() * (m_AvailablePointsCount - 1));
+              featureOwnersIdx = availablePointsInv[key];
+            }
+          }
+          else
+          {
+            featureOwnersIdx = static_cast<size_t>(rg.genrand_res53() * m_TotalPoints);
+            while(m_BoundaryCells[featureOwnersIdx] == 0)
+            {
+              featureOwnersIdx = static_cast<size_t>(rg.genrand_res53() * m_TotalPoints);
+            }
           }
         }
-        else
+        else if(random > precipboundaryfraction)
         {
-          featureOwnersIdx = static_cast<size_t>(rg.genrand_res53() * m_TotalPoints);
-          while(m_BoundaryCells[featureOwnersIdx] == 0)
+          if(m_AvailablePointsCount > 0)
+          {
+            key = static_cast<size_t>(rg.genrand_res53() * (m_AvailablePointsCount - 1));
+            featureOwnersIdx = availablePointsInv[key];
+            while(m_BoundaryCells[featureOwnersIdx] != 0)
+            {
+              key = static_cast<size_t>(rg.genrand_res53() * (m_AvailablePointsCount - 1));
+              featureOwnersIdx = availablePointsInv[key];
+            }
+          }
+          else
           {
             featureOwnersIdx = static_cast<size_t>(rg.genrand_res53() * m_TotalPoints);
+            while(m_BoundaryCells[featureOwnersIdx] != 0)
+            {
+              featureOwnersIdx = static_cast<size_t>(rg.genrand_res53() * m_TotalPoints);
+            }
           }
         }
       }
-      else if(random > precipboundaryfraction)
+      else
       {
+
+        if(precipboundaryfraction > 0)
+        {
+          QString msg("There are no Feature boundaries on which to place "
+                      "precipitates and the target statistics precipitate "
+                      "fraction is greater than 0. This Filter will run without "
+                      "trying to match the "
+                      "precipitate fraction");
+          setWarningCondition(-5010, msg);
+        }
+
         if(m_AvailablePointsCount > 0)
         {
           key = static_cast<size_t>(rg.genrand_res53() * (m_AvailablePointsCount - 1));
           featureOwnersIdx = availablePointsInv[key];
-          while(m_BoundaryCells[featureOwnersIdx] != 0)
-          {
-            key = static_cast<size_t>(rg.genrand_res53() * (m_AvailablePointsCount - 1));
-            featureOwnersIdx = availablePointsInv[key];
-          }
         }
         else
         {
           featureOwnersIdx = static_cast<size_t>(rg.genrand_res53() * m_TotalPoints);
-          while(m_BoundaryCells[featureOwnersIdx] != 0)
-          {
-            featureOwnersIdx = static_cast<size_t>(rg.genrand_res53() * m_TotalPoints);
-          }
         }
       }
-    }
-    else
-    {
 
-      if(precipboundaryfraction > 0)
-      {
-        QString msg("There are no Feature boundaries on which to place "
-                    "precipitates and the target statistics precipitate "
-                    "fraction is greater than 0. This Filter will run without "
-                    "trying to match the "
-                    "precipitate fraction");
-        setWarningCondition(-5010, msg);
-      }
+      column = static_cast<int64_t>(featureOwnersIdx % m_XPoints);
+      row = static_cast<int64_t>(featureOwnersIdx / m_XPoints) % m_YPoints;
+      plane = static_cast<int64_t>(featureOwnersIdx / (m_XPoints * m_YPoints));
 
-      if(m_AvailablePointsCount > 0)
+      // Defer this precipitate to a later batch if another member of this batch already claimed the cell
+      size_t cell = static_cast<size_t>((plane / cellDims[2]) * numCells[0] * numCells[1] + (row / cellDims[1]) * numCells[0] + (column / cellDims[0]));
+      if(cellBatchStamps[cell] == batchId)
       {
-        key = static_cast<size_t>(rg.genrand_res53() * (m_AvailablePointsCount - 1));
-        featureOwnersIdx = availablePointsInv[key];
+        pendingPrecipitates.push_back(i);
+        continue;
       }
-      else
+      cellBatchStamps[cell] = batchId;
+
+      xc = static_cast<float>((column * m_XRes) + (m_XRes * 0.5));
+      yc = static_cast<float>((row * m_YRes) + (m_YRes * 0.5));
+      zc = static_cast<float>((plane * m_ZRes) + (m_ZRes * 0.5));
+      m_Centroids[3 * i] = xc;
+      m_Centroids[3 * i + 1] = yc;
+      m_Centroids[3 * i + 2] = zc;
+      batch.push_back(i);
+      batchPoints.push_back(featureOwnersIdx);
+      batchFromAvailable.push_back(m_AvailablePointsCount > 0);
+    }
+
+    zoneVoxelizer.insertBatch(batch, m_ColumnList, m_RowList, m_PlaneList);
+
+    // Commit the batch in order. A centroid that was covered by an exclusion zone committed
+    // earlier in this batch is no longer an available point, so that precipitate is redrawn.
+    for(size_t b = 0; b < batch.size(); b++)
+    {
+      size_t i = batch[b];
+      if(batchFromAvailable[b] && exclusionZones[batchPoints[b]] > 0)
       {
-        featureOwnersIdx = static_cast<size_t>(rg.genrand_res53() * m_TotalPoints);
+        m_ColumnList[i].clear();
+        m_RowList[i].clear();
+        m_PlaneList[i].clear();
+        pendingPrecipitates.push_back(i);
+        continue;
       }
+      update_exclusionZones(static_cast<int32_t>(i), -1000, exclusionZonesPtr);
+      update_availablepoints(availablePoints, availablePointsInv);
+      numPlaced++;
     }
-
-    column = static_cast<int64_t>(featureOwnersIdx % m_XPoints);
-    row = static_cast<int64_t>(featureOwnersIdx / m_XPoints) % m_YPoints;
-    plane = static_cast<int64_t>(featureOwnersIdx / (m_XPoints * m_YPoints));
-    xc = static_cast<float>((column * m_XRes) + (m_XRes * 0.5));
-    yc = static_cast<float>((row * m_YRes) + (m_YRes * 0.5));
-    zc = static_cast<float>((plane * m_ZRes) + (m_ZRes * 0.5));
-    m_Centroids[3 * i] = xc;
-    m_Centroids[3 * i + 1] = yc;
-    m_Centroids[3 * i + 2] = zc;
-    insert_precipitate(i);
-    update_exclusionZones(i, -1000, exclusionZonesPtr);
-    update_availablepoints(availablePoints, availablePointsInv);
   }
 
   notifyStatusMessage("Packing Features - Initial Feature Placement Complete");
@@ -1916,16 +2020,22 @@ void InsertPrecipitatePhases::update_exclusionZones(int32_t gadd, int32_t gremov
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void InsertPrecipitatePhases::update_availablepoints(std::map<size_t, size_t>& availablePoints, std::map<size_t, size_t>& availablePointsInv)
+void InsertPrecipitatePhases::update_availablepoints(std::vector<int64_t>& availablePoints, std::vector<size_t>& availablePointsInv)
 {
   size_t removeSize = m_PointsToRemove.size();
   size_t addSize = m_PointsToAdd.size();
   size_t featureOwnersIdx = 0;
-  size_t key = 0, val = 0;
+  int64_t key = 0;
+  size_t val = 0;
   for(size_t i = 0; i < addSize; i++)
   {
     featureOwnersIdx = m_PointsToAdd[i];
-    availablePoints[featureOwnersIdx] = m_AvailablePointsCount;
+    // Masked out points are never packing points, even when they leave an exclusion zone
+    if(availablePoints[featureOwnersIdx] >= 0 || (m_UseMask && !m_Mask[featureOwnersIdx]))
+    {
+      continue;
+    }
+    availablePoints[featureOwnersIdx] = static_cast<int64_t>(m_AvailablePointsCount);
     availablePointsInv[m_AvailablePointsCount] = featureOwnersIdx;
     m_AvailablePointsCount++;
   }
@@ -1933,14 +2043,15 @@ void InsertPrecipitatePhases::update_availablepoints(std::map<size_t, size_t>& a
   {
     featureOwnersIdx = m_PointsToRemove[i];
     key = availablePoints[featureOwnersIdx];
-    //  availablePoints.erase(featureOwnersIdx);
-    val = availablePointsInv[m_AvailablePointsCount - 1];
-    //  availablePointsInv.erase(availablePointsCount-1);
-    if(key < m_AvailablePointsCount - 1)
+    if(key < 0)
     {
-      availablePointsInv[key] = val;
-      availablePoints[val] = key;
+      continue;
     }
+    // Swap the last available point into the slot being vacated
+    val = availablePointsInv[m_AvailablePointsCount - 1];
+    availablePointsInv[key] = val;
+    availablePoints[val] = key;
+    availablePoints[featureOwnersIdx] = -1;
     m_AvailablePointsCount--;
   }
   m_PointsToRemove.clear();
@@ -2295,127 +2406,6 @@ float InsertPrecipitatePhases::check_sizedisterror(Precip_t* precip)
   return sizedisterror;
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void InsertPrecipitatePhases::insert_precipitate(size_t gnum)
-{
-  SIMPL_RANDOMNG_NEW()
-
-  float inside = -1.0f;
-  int64_t column = 0, row = 0, plane = 0;
-  int64_t centercolumn = 0, centerrow = 0, centerplane = 0;
-  int64_t xmin = 0, xmax = 0, ymin = 0, ymax = 0, zmin = 0, zmax = 0;
-  float xc = 0.0f, yc = 0.0f, zc = 0.0f;
-  float coordsRotated[3] = {0.0f, 0.0f, 0.0f};
-  float coords[3] = {0.0f, 0.0f, 0.0f};
-  float volcur = m_Volumes[gnum];
-  float bovera = m_AxisLengths[3 * gnum + 1];
-  float covera = m_AxisLengths[3 * gnum + 2];
-  float omega3 = m_Omega3s[gnum];
-  float radcur1 = 1.0f;
-  ShapeType::Type shapeclass = static_cast<ShapeType::Type>(m_ShapeTypes[m_FeaturePhases[gnum]]);
-
-  // Bail if the shapeclass is not one of our enumerated types
-  if(shapeclass >= ShapeType::Type::ShapeTypeEnd)
-  {
-    QString ss = QObject::tr("Undefined shape class in shape types array with path %1").arg(m_InputShapeTypesArrayPath.serialize());
-    setErrorCondition(-667, ss);
-    return;
-  }
-
-  // init any values for each of the Shape Ops
-  for(int iter = 0; iter < m_ShapeOps.size(); iter++)
-  {
-    m_ShapeOps[iter]->init();
-  }
-  // Create our Argument Map
-  QMap<ShapeOps::ArgName, float> shapeArgMap;
-  shapeArgMap[ShapeOps::Omega3] = omega3;
-  shapeArgMap[ShapeOps::VolCur] = volcur;
-  shapeArgMap[ShapeOps::B_OverA] = bovera;
-  shapeArgMap[ShapeOps::C_OverA] = covera;
-
-  radcur1 = m_ShapeOps[static_cast<ShapeType::EnumType>(shapeclass)]->radcur1(shapeArgMap);
-
-  // adjust radcur1 to make larger exclusion zone to prevent precipitate overlap
-  radcur1 = radcur1 * 2.0f;
-
-  float radcur2 = (radcur1 * bovera);
-  float radcur3 = (radcur1 * covera);
-  float ga[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
-  FOrientArrayType om(9, 0.0);
-  FOrientTransformsType::eu2om(FOrientArrayType(&(m_AxisEulerAngles[3 * gnum]), 3), om);
-  om.toGMatrix(ga);
-
-  xc = m_Centroids[3 * gnum];
-  yc = m_Centroids[3 * gnum + 1];
-  zc = m_Centroids[3 * gnum + 2];
-  centercolumn = static_cast<int64_t>((xc - (m_XRes / 2)) / m_XRes);
-  centerrow = static_cast<int64_t>((yc - (m_YRes / 2)) / m_YRes);
-  centerplane = static_cast<int64_t>((zc - (m_ZRes / 2)) / m_ZRes);
-  xmin = int64_t(centercolumn - ((radcur1 / m_XRes) + 1));
-  xmax = int64_t(centercolumn + ((radcur1 / m_XRes) + 1));
-  ymin = int64_t(centerrow - ((radcur1 / m_YRes) + 1));
-  ymax = int64_t(centerrow + ((radcur1 / m_YRes) + 1));
-  zmin = int64_t(centerplane - ((radcur1 / m_ZRes) + 1));
-  zmax = int64_t(centerplane + ((radcur1 / m_ZRes) + 1));
-  if(xmin < -m_XPoints)
-  {
-    xmin = -m_XPoints;
-  }
-  if(xmax > 2 * m_XPoints - 1)
-  {
-    xmax = (2 * m_XPoints - 1);
-  }
-  if(ymin < -m_YPoints)
-  {
-    ymin = -m_YPoints;
-  }
-  if(ymax > 2 * m_YPoints - 1)
-  {
-    ymax = (2 * m_YPoints - 1);
-  }
-  if(zmin < -m_ZPoints)
-  {
-    zmin = -m_ZPoints;
-  }
-  if(zmax > 2 * m_ZPoints - 1)
-  {
-    zmax = (2 * m_ZPoints - 1);
-  }
-  for(int64_t iter1 = xmin; iter1 < xmax + 1; iter1++)
-  {
-    for(int64_t iter2 = ymin; iter2 < ymax + 1; iter2++)
-    {
-      for(int64_t iter3 = zmin; iter3 < zmax + 1; iter3++)
-      {
-        column = iter1;
-        row = iter2;
-        plane = iter3;
-        coords[0] = float(column) * m_XRes;
-        coords[1] = float(row) * m_YRes;
-        coords[2] = float(plane) * m_ZRes;
-        inside = -1;
-        coords[0] = coords[0] - xc;
-        coords[1] = coords[1] - yc;
-        coords[2] = coords[2] - zc;
-        MatrixMath::Multiply3x3with3x1(ga, coords, coordsRotated);
-        float axis1comp = coordsRotated[0] / radcur1;
-        float axis2comp = coordsRotated[1] / radcur2;
-        float axis3comp = coordsRotated[2] / radcur3;
-        inside = m_ShapeOps[static_cast<ShapeType::EnumType>(shapeclass)]->inside(axis1comp, axis2comp, axis3comp);
-        if(inside >= 0)
-        {
-          m_ColumnList[gnum].push_back(column);
-          m_RowList[gnum].push_back(row);
-          m_PlaneList[gnum].push_back(plane);
-        }
-      }
-    }
-  }
-}
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
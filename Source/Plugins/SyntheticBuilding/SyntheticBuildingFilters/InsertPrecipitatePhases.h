@@ -319,12 +319,6 @@ protected:
    */
   void transfer_attributes(int32_t gnum, Precip_t* precip);
 
-  /**
-   * @brief insert_precipitate Performs the insertion of a precipitate into the packing volume
-   * @param featureNum Id for the precipitate to be inserted
-   */
-  void insert_precipitate(size_t featureNum);
-
   /**
    * @brief move_precipitate Moves a precipitate to the supplied (x,y,z) centroid coordinate
    * @param featureNum Id for the precipitate to be moved
@@ -358,11 +352,11 @@ protected:
   //    bool check_for_overlap(size_t gNum, Int32ArrayType::Pointer exlusionZonesPtr);
 
   /**
-   * @brief update_availablepoints Updates the maps used to associate packing points with an "available" state
-   * @param availablePoints Map between precipitate owners and number of available points
-   * @param availablePointsInv Inverse associations for the availablePoints map
+   * @brief update_availablepoints Updates the dense arrays used to associate packing points with an "available" state
+   * @param availablePoints Slot of each packing point in availablePointsInv, or -1 if the point is not available
+   * @param availablePointsInv Packing point held in each slot; the first m_AvailablePointsCount slots are in use
    */
-  void update_availablepoints(std::map<size_t, size_t>& availablePoints, std::map<size_t, size_t>& availablePointsInv);
+  void update_availablepoints(std::vector<int64_t>& availablePoints, std::vector<size_t>& availablePointsInv);
 
   /**
    * @brief determine_currentRDF Determines the radial distribution function about a given precipitate
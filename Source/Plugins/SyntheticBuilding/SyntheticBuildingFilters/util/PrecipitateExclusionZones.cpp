@@ -0,0 +1,246 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include "PrecipitateExclusionZones.h"
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include <QtCore/QMap>
+
+#include "SIMPLib/Math/MatrixMath.h"
+
+#include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+
+/**
+ * @brief The InsertExclusionZonesImpl class implements a threaded algorithm that voxelizes the exclusion
+ * zones for a batch of precipitates. Each task creates its own set of ShapeOps.
+ */
+class InsertExclusionZonesImpl
+{
+public:
+  InsertExclusionZonesImpl(const PrecipitateExclusionZones* zones, const std::vector<size_t>& featureIds, std::vector<std::vector<int64_t>>& columnList,
+                           std::vector<std::vector<int64_t>>& rowList, std::vector<std::vector<int64_t>>& planeList)
+  : m_Zones(zones)
+  , m_FeatureIds(featureIds)
+  , m_ColumnList(columnList)
+  , m_RowList(rowList)
+  , m_PlaneList(planeList)
+  {
+  }
+
+  void convert(size_t start, size_t end) const
+  {
+    QVector<ShapeOps::Pointer> shapeOps = ShapeOps::getShapeOpsQVector();
+    for(size_t i = start; i < end; i++)
+    {
+      size_t featureId = m_FeatureIds[i];
+      m_Zones->insert(featureId, shapeOps, m_ColumnList[featureId], m_RowList[featureId], m_PlaneList[featureId]);
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const PrecipitateExclusionZones* m_Zones = nullptr;
+  const std::vector<size_t>& m_FeatureIds;
+  std::vector<std::vector<int64_t>>& m_ColumnList;
+  std::vector<std::vector<int64_t>>& m_RowList;
+  std::vector<std::vector<int64_t>>& m_PlaneList;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PrecipitateExclusionZones::PrecipitateExclusionZones(const float* volumes, const float* axisLengths, const float* axisEulerAngles, const float* omega3s, const float* centroids,
+                                                     const int32_t* featurePhases, const ShapeType::EnumType* shapeTypes, const float spacing[3], const int64_t points[3])
+: m_Volumes(volumes)
+, m_AxisLengths(axisLengths)
+, m_AxisEulerAngles(axisEulerAngles)
+, m_Omega3s(omega3s)
+, m_Centroids(centroids)
+, m_FeaturePhases(featurePhases)
+, m_ShapeTypes(shapeTypes)
+{
+  for(size_t i = 0; i < 3; i++)
+  {
+    m_Spacing[i] = spacing[i];
+    m_Points[i] = points[i];
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PrecipitateExclusionZones::~PrecipitateExclusionZones() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+float PrecipitateExclusionZones::findRadius(size_t featureId, const QVector<ShapeOps::Pointer>& shapeOps) const
+{
+  ShapeType::Type shapeclass = static_cast<ShapeType::Type>(m_ShapeTypes[m_FeaturePhases[featureId]]);
+
+  // init any values for each of the Shape Ops
+  for(int iter = 0; iter < shapeOps.size(); iter++)
+  {
+    shapeOps[iter]->init();
+  }
+  // Create our Argument Map
+  QMap<ShapeOps::ArgName, float> shapeArgMap;
+  shapeArgMap[ShapeOps::Omega3] = m_Omega3s[featureId];
+  shapeArgMap[ShapeOps::VolCur] = m_Volumes[featureId];
+  shapeArgMap[ShapeOps::B_OverA] = m_AxisLengths[3 * featureId + 1];
+  shapeArgMap[ShapeOps::C_OverA] = m_AxisLengths[3 * featureId + 2];
+
+  float radcur1 = shapeOps[static_cast<ShapeType::EnumType>(shapeclass)]->radcur1(shapeArgMap);
+
+  // adjust radcur1 to make larger exclusion zone to prevent precipitate overlap
+  return radcur1 * 2.0f;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PrecipitateExclusionZones::insert(size_t featureId, const QVector<ShapeOps::Pointer>& shapeOps, std::vector<int64_t>& columns, std::vector<int64_t>& rows,
+                                       std::vector<int64_t>& planes) const
+{
+  float coordsRotated[3] = {0.0f, 0.0f, 0.0f};
+  float coords[3] = {0.0f, 0.0f, 0.0f};
+  float bovera = m_AxisLengths[3 * featureId + 1];
+  float covera = m_AxisLengths[3 * featureId + 2];
+  ShapeType::Type shapeclass = static_cast<ShapeType::Type>(m_ShapeTypes[m_FeaturePhases[featureId]]);
+
+  // Prime the ShapeOps with this precipitate's shape parameters right before they are used by inside()
+  float radcur1 = findRadius(featureId, shapeOps);
+  float radcur2 = (radcur1 * bovera);
+  float radcur3 = (radcur1 * covera);
+  float ga[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+  FOrientArrayType om(9, 0.0);
+  FOrientTransformsType::eu2om(FOrientArrayType(const_cast<float*>(m_AxisEulerAngles + 3 * featureId), 3), om);
+  om.toGMatrix(ga);
+
+  float xc = m_Centroids[3 * featureId];
+  float yc = m_Centroids[3 * featureId + 1];
+  float zc = m_Centroids[3 * featureId + 2];
+  int64_t centercolumn = static_cast<int64_t>((xc - (m_Spacing[0] / 2)) / m_Spacing[0]);
+  int64_t centerrow = static_cast<int64_t>((yc - (m_Spacing[1] / 2)) / m_Spacing[1]);
+  int64_t centerplane = static_cast<int64_t>((zc - (m_Spacing[2] / 2)) / m_Spacing[2]);
+  int64_t xmin = int64_t(centercolumn - ((radcur1 / m_Spacing[0]) + 1));
+  int64_t xmax = int64_t(centercolumn + ((radcur1 / m_Spacing[0]) + 1));
+  int64_t ymin = int64_t(centerrow - ((radcur1 / m_Spacing[1]) + 1));
+  int64_t ymax = int64_t(centerrow + ((radcur1 / m_Spacing[1]) + 1));
+  int64_t zmin = int64_t(centerplane - ((radcur1 / m_Spacing[2]) + 1));
+  int64_t zmax = int64_t(centerplane + ((radcur1 / m_Spacing[2]) + 1));
+  if(xmin < -m_Points[0])
+  {
+    xmin = -m_Points[0];
+  }
+  if(xmax > 2 * m_Points[0] - 1)
+  {
+    xmax = (2 * m_Points[0] - 1);
+  }
+  if(ymin < -m_Points[1])
+  {
+    ymin = -m_Points[1];
+  }
+  if(ymax > 2 * m_Points[1] - 1)
+  {
+    ymax = (2 * m_Points[1] - 1);
+  }
+  if(zmin < -m_Points[2])
+  {
+    zmin = -m_Points[2];
+  }
+  if(zmax > 2 * m_Points[2] - 1)
+  {
+    zmax = (2 * m_Points[2] - 1);
+  }
+  ShapeOps* shapeOp = shapeOps[static_cast<ShapeType::EnumType>(shapeclass)].get();
+  for(int64_t column = xmin; column < xmax + 1; column++)
+  {
+    for(int64_t row = ymin; row < ymax + 1; row++)
+    {
+      for(int64_t plane = zmin; plane < zmax + 1; plane++)
+      {
+        coords[0] = float(column) * m_Spacing[0] - xc;
+        coords[1] = float(row) * m_Spacing[1] - yc;
+        coords[2] = float(plane) * m_Spacing[2] - zc;
+        MatrixMath::Multiply3x3with3x1(ga, coords, coordsRotated);
+        float axis1comp = coordsRotated[0] / radcur1;
+        float axis2comp = coordsRotated[1] / radcur2;
+        float axis3comp = coordsRotated[2] / radcur3;
+        float inside = shapeOp->inside(axis1comp, axis2comp, axis3comp);
+        if(inside >= 0)
+        {
+          columns.push_back(column);
+          rows.push_back(row);
+          planes.push_back(plane);
+        }
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PrecipitateExclusionZones::insertBatch(const std::vector<size_t>& featureIds, std::vector<std::vector<int64_t>>& columnList, std::vector<std::vector<int64_t>>& rowList,
+                                            std::vector<std::vector<int64_t>>& planeList) const
+{
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, featureIds.size()), InsertExclusionZonesImpl(this, featureIds, columnList, rowList, planeList), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    InsertExclusionZonesImpl serial(this, featureIds, columnList, rowList, planeList);
+    serial.convert(0, featureIds.size());
+  }
+}
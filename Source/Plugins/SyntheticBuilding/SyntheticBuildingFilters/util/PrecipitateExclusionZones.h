@@ -0,0 +1,120 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <QtCore/QVector>
+
+#include "SIMPLib/Common/ShapeType.h"
+#include "SIMPLib/Geometry/ShapeOps/ShapeOps.h"
+#include "SIMPLib/SIMPLib.h"
+
+/**
+ * @brief The PrecipitateExclusionZones class voxelizes the exclusion zones that InsertPrecipitatePhases
+ * places around each precipitate: the packing points inside a shape twice the size of the precipitate,
+ * centered on its centroid and rotated by its axis Euler angles. The ShapeOps keep the shape parameters
+ * of the precipitate they were last initialized for, so every thread voxelizes with its own set.
+ */
+class PrecipitateExclusionZones
+{
+public:
+  /**
+   * @brief PrecipitateExclusionZones Wraps the Feature level arrays of the precipitates. The arrays are
+   * read each time a zone is voxelized, so Centroids may change between calls.
+   * @param volumes Feature volumes
+   * @param axisLengths Feature axis lengths (1, b/a, c/a)
+   * @param axisEulerAngles Feature axis Euler angles
+   * @param omega3s Feature Omega3 values
+   * @param centroids Feature centroids
+   * @param featurePhases Feature phases
+   * @param shapeTypes Shape type of each Ensemble; every precipitate must use a defined shape type
+   * @param spacing Spacing of the packing grid
+   * @param points Dimensions of the packing grid
+   */
+  PrecipitateExclusionZones(const float* volumes, const float* axisLengths, const float* axisEulerAngles, const float* omega3s, const float* centroids, const int32_t* featurePhases,
+                            const ShapeType::EnumType* shapeTypes, const float spacing[3], const int64_t points[3]);
+  virtual ~PrecipitateExclusionZones();
+
+  /**
+   * @brief findRadius Computes the exclusion zone radius along the major axis of a precipitate and leaves
+   * the supplied ShapeOps initialized with that precipitate's shape parameters
+   * @param featureId Id for the precipitate
+   * @param shapeOps ShapeOps to initialize
+   * @return Float exclusion zone radius
+   */
+  float findRadius(size_t featureId, const QVector<ShapeOps::Pointer>& shapeOps) const;
+
+  /**
+   * @brief insert Appends the packing points inside the exclusion zone of one precipitate
+   * @param featureId Id for the precipitate
+   * @param shapeOps ShapeOps used for the inside test; they are re-initialized for featureId
+   * @param columns Output column indices
+   * @param rows Output row indices
+   * @param planes Output plane indices
+   */
+  void insert(size_t featureId, const QVector<ShapeOps::Pointer>& shapeOps, std::vector<int64_t>& columns, std::vector<int64_t>& rows, std::vector<int64_t>& planes) const;
+
+  /**
+   * @brief insertBatch Voxelizes the exclusion zones of several precipitates concurrently. Each
+   * precipitate's points are appended to its own entry of the point lists, exactly as insert() would.
+   * @param featureIds Ids of the precipitates; each Id may appear only once
+   * @param columnList Per Feature column indices
+   * @param rowList Per Feature row indices
+   * @param planeList Per Feature plane indices
+   */
+  void insertBatch(const std::vector<size_t>& featureIds, std::vector<std::vector<int64_t>>& columnList, std::vector<std::vector<int64_t>>& rowList,
+                   std::vector<std::vector<int64_t>>& planeList) const;
+
+private:
+  const float* m_Volumes = nullptr;
+  const float* m_AxisLengths = nullptr;
+  const float* m_AxisEulerAngles = nullptr;
+  const float* m_Omega3s = nullptr;
+  const float* m_Centroids = nullptr;
+  const int32_t* m_FeaturePhases = nullptr;
+  const ShapeType::EnumType* m_ShapeTypes = nullptr;
+  float m_Spacing[3] = {0.0f, 0.0f, 0.0f};
+  int64_t m_Points[3] = {0, 0, 0};
+
+public:
+  PrecipitateExclusionZones(const PrecipitateExclusionZones&) = delete;            // Copy Constructor Not Implemented
+  PrecipitateExclusionZones(PrecipitateExclusionZones&&) = delete;                 // Move Constructor Not Implemented
+  PrecipitateExclusionZones& operator=(const PrecipitateExclusionZones&) = delete; // Copy Assignment Not Implemented
+  PrecipitateExclusionZones& operator=(PrecipitateExclusionZones&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,170 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <random>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Common/ShapeType.h"
+#include "SIMPLib/Geometry/ShapeOps/ShapeOps.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "SyntheticBuildingTestFileLocations.h"
+
+// Directly include the .cpp file instead of the header because of the way the unit
+// tests are compiled.
+#include "SyntheticBuildingFilters/util/PrecipitateExclusionZones.cpp"
+
+class PrecipitateExclusionZonesTest
+{
+
+public:
+  PrecipitateExclusionZonesTest() = default;
+  virtual ~PrecipitateExclusionZonesTest() = default;
+
+  SIMPL_TYPE_MACRO(PrecipitateExclusionZonesTest)
+
+  PrecipitateExclusionZonesTest(const PrecipitateExclusionZonesTest&) = delete;            // Copy Constructor Not Implemented
+  PrecipitateExclusionZonesTest(PrecipitateExclusionZonesTest&&) = delete;                 // Move Constructor Not Implemented
+  PrecipitateExclusionZonesTest& operator=(const PrecipitateExclusionZonesTest&) = delete; // Copy Assignment Not Implemented
+  PrecipitateExclusionZonesTest& operator=(PrecipitateExclusionZonesTest&&) = delete;      // Move Assignment Not Implemented
+
+  // -----------------------------------------------------------------------------
+  // Voxelizes a batch of precipitates whose shape parameters all differ, once through
+  // insertBatch() and once serially with a single set of ShapeOps re-initialized for
+  // each precipitate, and requires the exclusion zones to be identical.
+  // -----------------------------------------------------------------------------
+  void TestBatchMatchesSerial(ShapeType::Type shapeType)
+  {
+    const size_t numFeatures = 65;
+    const float spacing[3] = {0.5f, 0.5f, 0.5f};
+    const int64_t points[3] = {40, 32, 24};
+
+    // Ensemble 0 is unused and Ensemble 1 holds the precipitates
+    std::vector<ShapeType::EnumType> shapeTypes = {static_cast<ShapeType::EnumType>(ShapeType::Type::Unknown), static_cast<ShapeType::EnumType>(shapeType)};
+    std::vector<int32_t> featurePhases(numFeatures, 1);
+    featurePhases[0] = 0;
+    std::vector<float> volumes(numFeatures, 0.0f);
+    std::vector<float> axisLengths(3 * numFeatures, 1.0f);
+    std::vector<float> axisEulerAngles(3 * numFeatures, 0.0f);
+    std::vector<float> omega3s(numFeatures, 1.0f);
+    std::vector<float> centroids(3 * numFeatures, 0.0f);
+
+    std::mt19937_64 generator(12345);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    for(size_t i = 1; i < numFeatures; i++)
+    {
+      volumes[i] = 0.5f + 4.0f * unit(generator);
+      axisLengths[3 * i + 1] = 0.4f + 0.6f * unit(generator);
+      axisLengths[3 * i + 2] = axisLengths[3 * i + 1] * (0.4f + 0.6f * unit(generator));
+      axisEulerAngles[3 * i] = SIMPLib::Constants::k_2Pi * unit(generator);
+      axisEulerAngles[3 * i + 1] = SIMPLib::Constants::k_Pi * unit(generator);
+      axisEulerAngles[3 * i + 2] = SIMPLib::Constants::k_2Pi * unit(generator);
+      // Spread Omega3 across the range the shape classes map to distinct shape exponents
+      omega3s[i] = 0.35f + 0.65f * static_cast<float>(i) / static_cast<float>(numFeatures);
+      for(size_t d = 0; d < 3; d++)
+      {
+        centroids[3 * i + d] = spacing[d] * (0.5f + static_cast<float>(points[d] - 1) * unit(generator));
+      }
+    }
+
+    PrecipitateExclusionZones zones(volumes.data(), axisLengths.data(), axisEulerAngles.data(), omega3s.data(), centroids.data(), featurePhases.data(), shapeTypes.data(), spacing, points);
+
+    std::vector<size_t> batch;
+    for(size_t i = 1; i < numFeatures; i++)
+    {
+      batch.push_back(i);
+    }
+    std::vector<std::vector<int64_t>> columnList(numFeatures);
+    std::vector<std::vector<int64_t>> rowList(numFeatures);
+    std::vector<std::vector<int64_t>> planeList(numFeatures);
+    zones.insertBatch(batch, columnList, rowList, planeList);
+
+    QVector<ShapeOps::Pointer> shapeOps = ShapeOps::getShapeOpsQVector();
+    size_t distinctSizes = 0;
+    size_t previousSize = 0;
+    for(size_t i = 1; i < numFeatures; i++)
+    {
+      std::vector<int64_t> columns;
+      std::vector<int64_t> rows;
+      std::vector<int64_t> planes;
+      zones.insert(i, shapeOps, columns, rows, planes);
+
+      DREAM3D_REQUIRE(!columns.empty())
+      DREAM3D_REQUIRE(columns == columnList[i])
+      DREAM3D_REQUIRE(rows == rowList[i])
+      DREAM3D_REQUIRE(planes == planeList[i])
+      if(columns.size() != previousSize)
+      {
+        distinctSizes++;
+      }
+      previousSize = columns.size();
+    }
+    // The precipitates must really differ from each other for the comparison to mean anything
+    DREAM3D_REQUIRE(distinctSizes > numFeatures / 2)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestSuperEllipsoidBatch()
+  {
+    TestBatchMatchesSerial(ShapeType::Type::SuperEllipsoid);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestCubeOctahedronBatch()
+  {
+    TestBatchMatchesSerial(ShapeType::Type::CubeOctahedron);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "---- " << getNameOfClass().toStdString() << " ----" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestSuperEllipsoidBatch())
+    DREAM3D_REGISTER_TEST(TestCubeOctahedronBatch())
+  }
+};